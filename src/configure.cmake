@@ -17,3 +17,8 @@ qt_feature("geoservices_nokia" PRIVATE
     LABEL "Provides access to OpenStreetMap geoservices"
     CONDITION FALSE
 )
+
+qt_feature("geoservices_offline" PRIVATE
+    LABEL "Provides geoservices from local data files"
+    CONDITION TRUE
+)
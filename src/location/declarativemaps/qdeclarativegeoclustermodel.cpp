@@ -0,0 +1,457 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qdeclarativegeoclustermodel_p.h"
+#include "qdeclarativegeomap_p.h"
+
+#include <QtCore/QMetaObject>
+#include <QtPositioning/QGeoRectangle>
+
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype ClusterModel
+    \nativetype QDeclarativeGeoClusterModel
+    \inqmlmodule QtLocation
+    \ingroup qml-QtLocation5-maps
+    \since QtLocation 6.9
+
+    \brief The ClusterModel type groups the points of a model into clusters
+    for the current zoom level and viewport of a map.
+
+    Displaying one map item per row of a model with tens or hundreds of
+    thousands of rows is slow, and the items hide each other. The
+    ClusterModel reads the coordinates of the rows of the \l sourceModel and
+    merges the points closer than \l radius pixels from each other into
+    clusters. Its rows are the clusters and single points that are visible
+    in the \l map at its current zoom level, and they are updated as the map
+    is panned and zoomed. The clustering is computed once for every integer
+    zoom level when the source model changes, so that following the camera
+    only requires a lookup.
+
+    The ClusterModel is meant to be used as the model of a \l MapItemView,
+    whose delegate can use the following roles:
+
+    \table
+        \header
+            \li Role
+            \li Description
+        \row
+            \li coordinate
+            \li The \l coordinate of the point, or the weighted center of
+                the cluster.
+        \row
+            \li pointCount
+            \li The number of points in the cluster, 1 for a single point.
+        \row
+            \li isCluster
+            \li Whether the row is a cluster of several points.
+        \row
+            \li sourceIndex
+            \li The row of the point in the \l sourceModel, -1 for a cluster.
+        \row
+            \li clusterId
+            \li A number identifying the cluster or point until the
+                \l sourceModel changes.
+        \row
+            \li expansionZoomLevel
+            \li The zoom level at which the cluster splits up, -1 for a
+                single point.
+    \endtable
+
+    Rows which remain visible keep their delegate when the map moves, so
+    that only the clusters entering or leaving the view are created or
+    destroyed.
+
+    \section2 Example Usage
+
+    \code
+    Map {
+        id: map
+        MapItemView {
+            model: ClusterModel {
+                sourceModel: vehicles
+                coordinateRole: "position"
+                map: map
+            }
+            delegate: MapQuickItem {
+                coordinate: model.coordinate
+                anchorPoint: Qt.point(sourceItem.width / 2, sourceItem.height / 2)
+                sourceItem: Rectangle {
+                    width: model.isCluster ? 32 : 12
+                    height: width
+                    radius: width / 2
+                    color: model.isCluster ? "orange" : "steelblue"
+                    Text {
+                        anchors.centerIn: parent
+                        visible: model.isCluster
+                        text: model.pointCount
+                    }
+                }
+            }
+        }
+    }
+    \endcode
+*/
+
+QDeclarativeGeoClusterModel::QDeclarativeGeoClusterModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoClusterModel::componentComplete()
+{
+    m_complete = true;
+    scheduleRebuild();
+}
+
+/*!
+    \internal
+*/
+int QDeclarativeGeoClusterModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return int(m_clusters.size());
+}
+
+/*!
+    \internal
+*/
+QVariant QDeclarativeGeoClusterModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_clusters.size())
+        return QVariant();
+
+    const QGeoClusterIndex::Cluster &cluster = m_clusters.at(index.row());
+    switch (role) {
+    case CoordinateRole:
+        return QVariant::fromValue(cluster.coordinate);
+    case PointCountRole:
+        return int(cluster.count);
+    case IsClusterRole:
+        return cluster.isCluster();
+    case SourceIndexRole:
+        return cluster.isCluster() ? -1 : int(cluster.id);
+    case ClusterIdRole:
+        return cluster.id;
+    case ExpansionZoomLevelRole:
+        return cluster.isCluster() ? m_index.expansionZoomLevel(cluster.id) : -1;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> QDeclarativeGeoClusterModel::roleNames() const
+{
+    QHash<int, QByteArray> roleNames = QAbstractListModel::roleNames();
+    roleNames.insert(CoordinateRole, "coordinate");
+    roleNames.insert(PointCountRole, "pointCount");
+    roleNames.insert(IsClusterRole, "isCluster");
+    roleNames.insert(SourceIndexRole, "sourceIndex");
+    roleNames.insert(ClusterIdRole, "clusterId");
+    roleNames.insert(ExpansionZoomLevelRole, "expansionZoomLevel");
+    return roleNames;
+}
+
+/*!
+    \qmlproperty QAbstractItemModel QtLocation::ClusterModel::sourceModel
+
+    This property holds the model providing the points to cluster.
+
+    \sa coordinateRole
+*/
+void QDeclarativeGeoClusterModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (m_sourceModel == model)
+        return;
+
+    if (m_sourceModel)
+        disconnect(m_sourceModel, nullptr, this, nullptr);
+    m_sourceModel = model;
+    if (m_sourceModel) {
+        // Any change may move points between clusters at several zoom
+        // levels, the hierarchy is built again
+        connect(m_sourceModel, &QAbstractItemModel::rowsInserted,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QAbstractItemModel::rowsRemoved,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QAbstractItemModel::rowsMoved,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QAbstractItemModel::dataChanged,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QAbstractItemModel::modelReset,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QAbstractItemModel::layoutChanged,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+        connect(m_sourceModel, &QObject::destroyed,
+                this, &QDeclarativeGeoClusterModel::scheduleRebuild);
+    }
+    scheduleRebuild();
+    emit sourceModelChanged();
+}
+
+QAbstractItemModel *QDeclarativeGeoClusterModel::sourceModel() const
+{
+    return m_sourceModel;
+}
+
+/*!
+    \qmlproperty string QtLocation::ClusterModel::coordinateRole
+
+    This property holds the name of the role of the \l sourceModel providing
+    the \l coordinate of each point.
+*/
+void QDeclarativeGeoClusterModel::setCoordinateRole(const QString &role)
+{
+    if (m_coordinateRole == role)
+        return;
+
+    m_coordinateRole = role;
+    scheduleRebuild();
+    emit coordinateRoleChanged();
+}
+
+QString QDeclarativeGeoClusterModel::coordinateRole() const
+{
+    return m_coordinateRole;
+}
+
+/*!
+    \qmlproperty Map QtLocation::ClusterModel::map
+
+    This property holds the map whose zoom level and visible region the
+    clusters are computed for.
+*/
+void QDeclarativeGeoClusterModel::setMap(QDeclarativeGeoMap *map)
+{
+    if (m_map == map)
+        return;
+
+    if (m_map)
+        disconnect(m_map, nullptr, this, nullptr);
+    m_map = map;
+    if (m_map) {
+        connect(m_map, &QDeclarativeGeoMap::visibleRegionChanged,
+                this, &QDeclarativeGeoClusterModel::scheduleUpdate);
+        connect(m_map, &QDeclarativeGeoMap::zoomLevelChanged,
+                this, &QDeclarativeGeoClusterModel::scheduleUpdate);
+        connect(m_map, &QDeclarativeGeoMap::mapReadyChanged,
+                this, &QDeclarativeGeoClusterModel::scheduleUpdate);
+    }
+    scheduleUpdate();
+    emit mapChanged();
+}
+
+QDeclarativeGeoMap *QDeclarativeGeoClusterModel::map() const
+{
+    return m_map;
+}
+
+/*!
+    \qmlproperty real QtLocation::ClusterModel::radius
+
+    This property holds the distance in pixels within which points are
+    merged into a cluster.
+
+    Defaults to 60.
+*/
+void QDeclarativeGeoClusterModel::setRadius(qreal radius)
+{
+    if (m_index.radius() == radius)
+        return;
+
+    m_index.setRadius(radius);
+    scheduleRebuild();
+    emit radiusChanged();
+}
+
+qreal QDeclarativeGeoClusterModel::radius() const
+{
+    return m_index.radius();
+}
+
+/*!
+    \qmlproperty int QtLocation::ClusterModel::maximumZoomLevel
+
+    This property holds the highest zoom level points are clustered at.
+    Above it, every point is a row of its own.
+
+    Defaults to 16.
+*/
+void QDeclarativeGeoClusterModel::setMaximumZoomLevel(int zoomLevel)
+{
+    if (m_index.maximumZoomLevel() == zoomLevel)
+        return;
+
+    m_index.setMaximumZoomLevel(zoomLevel);
+    scheduleRebuild();
+    emit maximumZoomLevelChanged();
+}
+
+int QDeclarativeGeoClusterModel::maximumZoomLevel() const
+{
+    return m_index.maximumZoomLevel();
+}
+
+/*!
+    \qmlproperty int QtLocation::ClusterModel::minimumPoints
+
+    This property holds the smallest number of points forming a cluster.
+
+    Defaults to 2.
+*/
+void QDeclarativeGeoClusterModel::setMinimumPoints(int minimumPoints)
+{
+    if (m_index.minimumPoints() == minimumPoints)
+        return;
+
+    m_index.setMinimumPoints(minimumPoints);
+    scheduleRebuild();
+    emit minimumPointsChanged();
+}
+
+int QDeclarativeGeoClusterModel::minimumPoints() const
+{
+    return m_index.minimumPoints();
+}
+
+/*!
+    \qmlproperty int QtLocation::ClusterModel::count
+
+    This property holds the number of clusters and single points currently
+    visible.
+*/
+int QDeclarativeGeoClusterModel::count() const
+{
+    return int(m_clusters.size());
+}
+
+/*!
+    \qmlmethod list<int> QtLocation::ClusterModel::sourceIndexes(int index)
+
+    Returns the rows of the \l sourceModel holding the points of the cluster
+    at \a index.
+*/
+QList<int> QDeclarativeGeoClusterModel::sourceIndexes(int index) const
+{
+    QList<int> result;
+    if (index < 0 || index >= m_clusters.size())
+        return result;
+
+    const QList<qsizetype> leaves = m_index.leaves(m_clusters.at(index).id);
+    result.reserve(leaves.size());
+    for (qsizetype leaf : leaves)
+        result.append(int(leaf));
+    return result;
+}
+
+void QDeclarativeGeoClusterModel::scheduleRebuild()
+{
+    m_rebuildPending = true;
+    scheduleUpdate();
+}
+
+void QDeclarativeGeoClusterModel::scheduleUpdate()
+{
+    if (!m_complete || m_updatePending)
+        return;
+
+    // Model and camera changes come in bursts, update once per burst
+    m_updatePending = true;
+    QMetaObject::invokeMethod(this, &QDeclarativeGeoClusterModel::update, Qt::QueuedConnection);
+}
+
+void QDeclarativeGeoClusterModel::update()
+{
+    m_updatePending = false;
+
+    const bool rebuilt = m_rebuildPending;
+    if (m_rebuildPending) {
+        m_rebuildPending = false;
+        rebuild();
+    }
+
+    QList<QGeoClusterIndex::Cluster> clusters;
+    if (m_map && m_map->mapReady()) {
+        const QGeoRectangle region = m_map->visibleRegion().boundingGeoRectangle();
+        clusters = m_index.clusters(region, int(std::floor(m_map->zoomLevel())));
+    }
+    applyClusters(std::move(clusters), rebuilt);
+}
+
+void QDeclarativeGeoClusterModel::rebuild()
+{
+    QList<QGeoCoordinate> points;
+    const int role = m_sourceModel
+            ? m_sourceModel->roleNames().key(m_coordinateRole.toUtf8(), -1) : -1;
+    if (role != -1) {
+        const int rows = m_sourceModel->rowCount();
+        points.reserve(rows);
+        for (int row = 0; row < rows; ++row)
+            points.append(m_sourceModel->index(row, 0).data(role).value<QGeoCoordinate>());
+    }
+    m_index.load(points);
+}
+
+// Turns the current rows into clusters with as few row insertions and
+// removals as possible, so that the views keep the delegates of the
+// clusters which remain visible.
+void QDeclarativeGeoClusterModel::applyClusters(QList<QGeoClusterIndex::Cluster> clusters,
+                                                bool rebuilt)
+{
+    const auto lessId = [](const QGeoClusterIndex::Cluster &a, const QGeoClusterIndex::Cluster &b) {
+        return a.id < b.id;
+    };
+    std::sort(clusters.begin(), clusters.end(), lessId);
+    const auto contains = [&clusters, &lessId](const QGeoClusterIndex::Cluster &cluster) {
+        return std::binary_search(clusters.cbegin(), clusters.cend(), cluster, lessId);
+    };
+    const qsizetype oldCount = m_clusters.size();
+
+    for (qsizetype last = m_clusters.size() - 1; last >= 0; ) {
+        if (contains(m_clusters.at(last))) {
+            --last;
+            continue;
+        }
+        qsizetype first = last;
+        while (first > 0 && !contains(m_clusters.at(first - 1)))
+            --first;
+        beginRemoveRows(QModelIndex(), int(first), int(last));
+        m_clusters.remove(first, last - first + 1);
+        endRemoveRows();
+        last = first - 1;
+    }
+
+    // The remaining rows are now a subsequence of clusters
+    for (qsizetype row = 0; row < clusters.size(); ) {
+        if (row < m_clusters.size() && m_clusters.at(row).id == clusters.at(row).id) {
+            if (rebuilt) {
+                // The ids are only stable between rebuilds
+                m_clusters[row] = clusters.at(row);
+                emit dataChanged(index(int(row)), index(int(row)));
+            }
+            ++row;
+            continue;
+        }
+        const qint64 nextId = row < m_clusters.size() ? m_clusters.at(row).id : -1;
+        qsizetype end = row;
+        while (end < clusters.size() && clusters.at(end).id != nextId)
+            ++end;
+        beginInsertRows(QModelIndex(), int(row), int(end - 1));
+        m_clusters.insert(row, end - row, QGeoClusterIndex::Cluster());
+        std::copy(clusters.cbegin() + row, clusters.cbegin() + end, m_clusters.begin() + row);
+        endInsertRows();
+        row = end;
+    }
+
+    if (m_clusters.size() != oldCount)
+        emit countChanged();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,122 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDECLARATIVEGEOCLUSTERMODEL_P_H
+#define QDECLARATIVEGEOCLUSTERMODEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qgeoclusterindex_p.h>
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QPointer>
+#include <QtQml/qqml.h>
+#include <QtQml/QQmlParserStatus>
+
+QT_BEGIN_NAMESPACE
+
+Q_MOC_INCLUDE(<QtLocation/private/qdeclarativegeomap_p.h>)
+
+class QDeclarativeGeoMap;
+
+class Q_LOCATION_EXPORT QDeclarativeGeoClusterModel : public QAbstractListModel, public QQmlParserStatus
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(ClusterModel)
+    QML_ADDED_IN_VERSION(6, 9)
+
+    Q_PROPERTY(QAbstractItemModel *sourceModel READ sourceModel WRITE setSourceModel NOTIFY sourceModelChanged)
+    Q_PROPERTY(QString coordinateRole READ coordinateRole WRITE setCoordinateRole NOTIFY coordinateRoleChanged)
+    Q_PROPERTY(QDeclarativeGeoMap *map READ map WRITE setMap NOTIFY mapChanged)
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
+    Q_PROPERTY(int maximumZoomLevel READ maximumZoomLevel WRITE setMaximumZoomLevel NOTIFY maximumZoomLevelChanged)
+    Q_PROPERTY(int minimumPoints READ minimumPoints WRITE setMinimumPoints NOTIFY minimumPointsChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+    Q_INTERFACES(QQmlParserStatus)
+
+public:
+    enum Roles {
+        CoordinateRole = Qt::UserRole + 500,
+        PointCountRole,
+        IsClusterRole,
+        SourceIndexRole,
+        ClusterIdRole,
+        ExpansionZoomLevelRole
+    };
+
+    explicit QDeclarativeGeoClusterModel(QObject *parent = nullptr);
+
+    // From QQmlParserStatus
+    void classBegin() override {}
+    void componentComplete() override;
+
+    // From QAbstractListModel
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void setSourceModel(QAbstractItemModel *model);
+    QAbstractItemModel *sourceModel() const;
+
+    void setCoordinateRole(const QString &role);
+    QString coordinateRole() const;
+
+    void setMap(QDeclarativeGeoMap *map);
+    QDeclarativeGeoMap *map() const;
+
+    void setRadius(qreal radius);
+    qreal radius() const;
+
+    void setMaximumZoomLevel(int zoomLevel);
+    int maximumZoomLevel() const;
+
+    void setMinimumPoints(int minimumPoints);
+    int minimumPoints() const;
+
+    int count() const;
+
+    Q_INVOKABLE QList<int> sourceIndexes(int index) const;
+
+Q_SIGNALS:
+    void sourceModelChanged();
+    void coordinateRoleChanged();
+    void mapChanged();
+    void radiusChanged();
+    void maximumZoomLevelChanged();
+    void minimumPointsChanged();
+    void countChanged();
+
+private:
+    void scheduleRebuild();
+    void scheduleUpdate();
+    void update();
+    void rebuild();
+    void applyClusters(QList<QGeoClusterIndex::Cluster> clusters, bool rebuilt);
+
+    bool m_complete = false;
+    bool m_rebuildPending = true;
+    bool m_updatePending = false;
+
+    QPointer<QAbstractItemModel> m_sourceModel;
+    QPointer<QDeclarativeGeoMap> m_map;
+    QString m_coordinateRole;
+
+    QGeoClusterIndex m_index;
+    // The clusters of the visible region, sorted by id
+    QList<QGeoClusterIndex::Cluster> m_clusters;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDECLARATIVEGEOCLUSTERMODEL_P_H
@@ -235,6 +235,10 @@ void QDeclarativeGeocodeModel::setPlugin(QDeclarativeGeoServiceProvider *plugin)
         return;
 
     reset(); // reset the model
+    if (plugin_) {
+        disconnect(plugin_, &QDeclarativeGeoServiceProvider::attached,
+                   this, &QDeclarativeGeocodeModel::pluginReady);
+    }
     plugin_ = plugin;
     if (complete_)
         emit pluginChanged();
@@ -242,12 +246,11 @@ void QDeclarativeGeocodeModel::setPlugin(QDeclarativeGeoServiceProvider *plugin)
     if (!plugin)
         return;
 
-    if (plugin_->isAttached()) {
+    // The Plugin attaches again when it moves to another provider
+    connect(plugin_, &QDeclarativeGeoServiceProvider::attached,
+            this, &QDeclarativeGeocodeModel::pluginReady);
+    if (plugin_->isAttached())
         pluginReady();
-    } else {
-        connect(plugin_, &QDeclarativeGeoServiceProvider::attached,
-                this, &QDeclarativeGeocodeModel::pluginReady);
-    }
 }
 
 /*!
@@ -283,11 +286,13 @@ void QDeclarativeGeocodeModel::pluginReady()
     }
 
     connect(geocodingManager, &QGeoCodingManager::finished,
-            this, &QDeclarativeGeocodeModel::geocodeFinished);
+            this, &QDeclarativeGeocodeModel::geocodeFinished, Qt::UniqueConnection);
     connect(geocodingManager, &QGeoCodingManager::errorOccurred,
-            this, &QDeclarativeGeocodeModel::geocodeError);
+            this, &QDeclarativeGeocodeModel::geocodeError, Qt::UniqueConnection);
 
-    if (complete_ && autoUpdate_)
+    // A request still running on the previous provider of the Plugin is
+    // made again on the new one
+    if (complete_ && (autoUpdate_ || reply_))
         update();
 }
 
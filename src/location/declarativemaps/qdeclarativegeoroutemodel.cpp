@@ -115,7 +115,7 @@ void QDeclarativeGeoRouteModel::reset()
         endResetModel();
     }
 
-    emit abortRequested();
+    abortRequest();
     setError(NoError, QString());
     setStatus(QDeclarativeGeoRouteModel::Null);
 }
@@ -128,7 +128,7 @@ void QDeclarativeGeoRouteModel::reset()
 */
 void QDeclarativeGeoRouteModel::cancel()
 {
-    emit abortRequested();
+    abortRequest();
     setError(NoError, QString());
     setStatus(routes_.isEmpty() ? Null : Ready);
 }
@@ -213,6 +213,8 @@ void QDeclarativeGeoRouteModel::setPlugin(QDeclarativeGeoServiceProvider *plugin
     if (plugin_) {
         disconnect(plugin_, &QDeclarativeGeoServiceProvider::localesChanged,
                    this, &QDeclarativeGeoRouteModel::measurementSystemChanged);
+        disconnect(plugin_, &QDeclarativeGeoServiceProvider::attached,
+                   this, &QDeclarativeGeoRouteModel::pluginReady);
     }
     if (plugin) {
         connect(plugin, &QDeclarativeGeoServiceProvider::localesChanged,
@@ -227,12 +229,11 @@ void QDeclarativeGeoRouteModel::setPlugin(QDeclarativeGeoServiceProvider *plugin
     if (!plugin)
         return;
 
-    if (plugin_->isAttached()) {
+    // The Plugin attaches again when it moves to another provider
+    connect(plugin_, &QDeclarativeGeoServiceProvider::attached,
+            this, &QDeclarativeGeoRouteModel::pluginReady);
+    if (plugin_->isAttached())
         pluginReady();
-    } else {
-        connect(plugin_, &QDeclarativeGeoServiceProvider::attached,
-                this, &QDeclarativeGeoRouteModel::pluginReady);
-    }
 }
 
 /*!
@@ -268,9 +269,25 @@ void QDeclarativeGeoRouteModel::pluginReady()
     }
 
     connect(routingManager, &QGeoRoutingManager::finished,
-            this, &QDeclarativeGeoRouteModel::routingFinished);
+            this, &QDeclarativeGeoRouteModel::routingFinished, Qt::UniqueConnection);
     connect(routingManager, &QGeoRoutingManager::errorOccurred,
-            this, &QDeclarativeGeoRouteModel::routingError);
+            this, &QDeclarativeGeoRouteModel::routingError, Qt::UniqueConnection);
+
+    // A calculation still running on the previous provider of the Plugin is
+    // made again on the new one
+    if (reply_)
+        update();
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoRouteModel::abortRequest()
+{
+    // The aborted reply may still report an error or its routes, or even
+    // finish before it is deleted
+    reply_ = nullptr;
+    emit abortRequested();
 }
 
 /*!
@@ -527,7 +544,7 @@ void QDeclarativeGeoRouteModel::update()
         setError(ParseError, tr("Cannot route, valid query not set."));
         return;
     }
-    emit abortRequested(); // Clear previous requests
+    abortRequest(); // Clear previous requests
     QGeoRouteRequest request = routeQuery_->routeRequest();
     if (request.waypoints().count() < 2) {
         setError(ParseError,tr("Not enough waypoints for routing."));
@@ -537,9 +554,11 @@ void QDeclarativeGeoRouteModel::update()
     setError(NoError, QString());
 
     QGeoRouteReply *reply = routingManager->calculateRoute(request);
+    reply_ = reply;
     setStatus(QDeclarativeGeoRouteModel::Loading);
     if (!reply->isFinished()) {
         connect(this, &QDeclarativeGeoRouteModel::abortRequested, reply, &QGeoRouteReply::abort);
+        connect(this, &QDeclarativeGeoRouteModel::abortRequested, reply, &QObject::deleteLater);
     } else {
         if (reply->error() == QGeoRouteReply::NoError) {
             routingFinished(reply);
@@ -554,8 +573,9 @@ void QDeclarativeGeoRouteModel::update()
 */
 void QDeclarativeGeoRouteModel::routingFinished(QGeoRouteReply *reply)
 {
-    if (!reply)
+    if (!reply || reply != reply_)
         return;
+    reply_ = nullptr;
     reply->deleteLater();
     if (reply->error() != QGeoRouteReply::NoError)
         return;
@@ -581,8 +601,9 @@ void QDeclarativeGeoRouteModel::routingError(QGeoRouteReply *reply,
                                                QGeoRouteReply::Error error,
                                                const QString &errorString)
 {
-    if (!reply)
+    if (!reply || reply != reply_)
         return;
+    reply_ = nullptr;
     reply->deleteLater();
     setError(static_cast<QDeclarativeGeoRouteModel::RouteError>(error), errorString);
     setStatus(QDeclarativeGeoRouteModel::Error);
@@ -1199,6 +1220,67 @@ QDateTime QDeclarativeGeoRouteQuery::departureTime() const
     return request_.departureTime();
 }
 
+/*!
+    \qmlproperty int RouteQuery::timeout
+
+    The time in milliseconds that the route calculation may take. If the
+    routes have not arrived by then, the request is aborted and the
+    \l RouteModel reports a \c RouteModel.CommunicationError.
+
+    The default value is 0, meaning the request never times out. Changing the
+    timeout does not cause the RouteModel to update.
+
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoRouteQuery::setTimeout(int msecs)
+{
+    msecs = qMax(0, msecs);
+    if (msecs == request_.timeout())
+        return;
+
+    request_.setTimeout(msecs);
+    if (complete_)
+        emit timeoutChanged();
+}
+
+int QDeclarativeGeoRouteQuery::timeout() const
+{
+    return request_.timeout();
+}
+
+/*!
+    \qmlproperty enumeration RouteQuery::priority
+
+    The priority with which the plugin should send the route calculation
+    to its backend, relative to its other network requests.
+
+    \value RouteQuery.LowPriority
+        The calculation may wait for requests of higher priority.
+    \value RouteQuery.NormalPriority
+        (default) The calculation is sent with the default priority.
+    \value RouteQuery.HighPriority
+        The calculation is sent ahead of requests of lower priority.
+
+    Plugins that do not calculate routes over the network ignore the
+    priority. Changing the priority does not cause the RouteModel to update.
+
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoRouteQuery::setPriority(Priority priority)
+{
+    if (static_cast<QGeoRouteRequest::Priority>(priority) == request_.priority())
+        return;
+
+    request_.setPriority(static_cast<QGeoRouteRequest::Priority>(priority));
+    if (complete_)
+        emit priorityChanged();
+}
+
+QDeclarativeGeoRouteQuery::Priority QDeclarativeGeoRouteQuery::priority() const
+{
+    return static_cast<Priority>(request_.priority());
+}
+
 void QDeclarativeGeoRouteQuery::setRouteOptimizations(QDeclarativeGeoRouteQuery::RouteOptimizations optimization)
 {
     QGeoRouteRequest::RouteOptimizations reqOptimizations;
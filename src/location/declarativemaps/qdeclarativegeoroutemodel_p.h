@@ -17,6 +17,7 @@
 
 #include <QObject>
 #include <QAbstractListModel>
+#include <QPointer>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtPositioning/QGeoRectangle>
 #include <qgeorouterequest.h>
@@ -136,6 +137,7 @@ private Q_SLOTS:
     void pluginReady();
 
 private:
+    void abortRequest();
     void setStatus(Status status);
     void setError(RouteError error, const QString &errorString);
 
@@ -144,6 +146,8 @@ private:
     QDeclarativeGeoServiceProvider *plugin_ = nullptr;
     QDeclarativeGeoRouteQuery *routeQuery_ = nullptr;
 
+    // The reply of the latest update(), the replies it superseded are ignored
+    QPointer<QGeoRouteReply> reply_;
     QList<QGeoRoute> routes_;
     bool autoUpdate_ = false;
     Status status_ = QDeclarativeGeoRouteModel::Null;
@@ -162,6 +166,7 @@ class Q_LOCATION_EXPORT QDeclarativeGeoRouteQuery : public QObject, public QQmlP
     Q_ENUMS(SegmentDetail)
     Q_ENUMS(ManeuverDetail)
     Q_ENUMS(RouteOptimization)
+    Q_ENUMS(Priority)
     Q_FLAGS(RouteOptimizations)
     Q_FLAGS(ManeuverDetails)
     Q_FLAGS(SegmentDetails)
@@ -176,6 +181,8 @@ class Q_LOCATION_EXPORT QDeclarativeGeoRouteQuery : public QObject, public QQmlP
     Q_PROPERTY(QList<QGeoRectangle> excludedAreas READ excludedAreas WRITE setExcludedAreas NOTIFY excludedAreasChanged)
     Q_PROPERTY(QList<int> featureTypes READ featureTypes NOTIFY featureTypesChanged)
     Q_PROPERTY(QDateTime departureTime READ departureTime WRITE setDepartureTime NOTIFY departureTimeChanged REVISION(5, 13))
+    Q_PROPERTY(int timeout READ timeout WRITE setTimeout NOTIFY timeoutChanged REVISION(6, 9))
+    Q_PROPERTY(Priority priority READ priority WRITE setPriority NOTIFY priorityChanged REVISION(6, 9))
     Q_INTERFACES(QQmlParserStatus)
 
 public:
@@ -242,6 +249,12 @@ public:
     };
     Q_DECLARE_FLAGS(ManeuverDetails, ManeuverDetail)
 
+    enum Priority {
+        LowPriority = QGeoRouteRequest::LowPriority,
+        NormalPriority = QGeoRouteRequest::NormalPriority,
+        HighPriority = QGeoRouteRequest::HighPriority
+    };
+
     void setNumberAlternativeRoutes(int numberAlternativeRoutes);
     int numberAlternativeRoutes() const;
 
@@ -286,6 +299,12 @@ public:
     void setDepartureTime(const QDateTime &departureTime);
     QDateTime departureTime() const;
 
+    void setTimeout(int msecs);
+    int timeout() const;
+
+    void setPriority(Priority priority);
+    Priority priority() const;
+
 Q_SIGNALS:
     void numberAlternativeRoutesChanged();
     void travelModesChanged();
@@ -300,6 +319,8 @@ Q_SIGNALS:
 
     void queryDetailsChanged();
     void departureTimeChanged();
+    Q_REVISION(6, 9) void timeoutChanged();
+    Q_REVISION(6, 9) void priorityChanged();
 
 private Q_SLOTS:
     void excludedAreaCoordinateChanged();
@@ -4,10 +4,82 @@
 #include "qdeclarativegeoserviceprovider_p.h"
 #include <QtQml/QQmlInfo>
 #include <QtQml/QQmlEngine>
+#include <QtCore/QMutex>
 #include <QLocale>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// Plugin objects with the same configuration share a geoservice provider,
+// and with it the engines, the tile cache and the network access managers
+struct SharedProviderEntry
+{
+    QString name;
+    QVariantMap parameters;
+    QLocale locale;
+    bool experimental = false;
+    QQmlEngine *engine = nullptr;
+    std::weak_ptr<QGeoServiceProvider> provider;
+
+    bool matches(const QString &otherName, const QVariantMap &otherParameters,
+                 const QLocale &otherLocale, bool otherExperimental,
+                 QQmlEngine *otherEngine) const
+    {
+        return name == otherName && parameters == otherParameters && locale == otherLocale
+                && experimental == otherExperimental && engine == otherEngine;
+    }
+};
+
+Q_GLOBAL_STATIC(QMutex, sharedProvidersMutex)
+Q_GLOBAL_STATIC(QList<SharedProviderEntry>, sharedProviders)
+
+std::shared_ptr<QGeoServiceProvider> acquireSharedProvider(const QString &name,
+                                                           const QVariantMap &parameters,
+                                                           const QLocale &locale,
+                                                           bool experimental,
+                                                           QQmlEngine *engine)
+{
+    QMutexLocker locker(sharedProvidersMutex());
+    QList<SharedProviderEntry> &entries = *sharedProviders();
+    entries.removeIf([](const SharedProviderEntry &entry) {
+        return entry.provider.expired();
+    });
+    for (const SharedProviderEntry &entry : std::as_const(entries)) {
+        if (!entry.matches(name, parameters, locale, experimental, engine))
+            continue;
+        if (std::shared_ptr<QGeoServiceProvider> provider = entry.provider.lock())
+            return provider;
+    }
+
+    std::shared_ptr<QGeoServiceProvider> provider = std::make_shared<QGeoServiceProvider>(name, parameters);
+    provider->setQmlEngine(engine);
+    provider->setLocale(locale);
+    provider->setAllowExperimental(experimental);
+    entries.append({ name, parameters, locale, experimental, engine, provider });
+    return provider;
+}
+
+// Records the new configuration of a provider changed in place
+void updateSharedProvider(const QGeoServiceProvider *provider, const QString &name,
+                          const QVariantMap &parameters, const QLocale &locale,
+                          bool experimental, QQmlEngine *engine)
+{
+    QMutexLocker locker(sharedProvidersMutex());
+    for (SharedProviderEntry &entry : *sharedProviders()) {
+        if (entry.provider.lock().get() == provider) {
+            entry.name = name;
+            entry.parameters = parameters;
+            entry.locale = locale;
+            entry.experimental = experimental;
+            entry.engine = engine;
+            return;
+        }
+    }
+}
+
+} // anonymous namespace
+
 /*!
     \qmltype Plugin
     //! \nativetype QDeclarativeGeoServiceProvider
@@ -101,19 +173,40 @@ void QDeclarativeGeoServiceProvider::tryAttach()
     if (!parametersReady())
         return;
 
-    sharedProvider_.reset();
+    // Users of the previous provider move to the new one on attached(), so
+    // it is kept alive until they have done so
+    const std::shared_ptr<QGeoServiceProvider> previous = std::move(sharedProvider_);
 
     if (name_.isEmpty())
         return;
 
-    sharedProvider_.reset(new QGeoServiceProvider(name_, parameterMap()));
-    sharedProvider_->setQmlEngine(qmlEngine(this));
-    sharedProvider_->setLocale(QLocale(locales_.at(0)));
-    sharedProvider_->setAllowExperimental(experimental_);
+    sharedProvider_ = acquireSharedProvider(name_, parameterMap(), QLocale(locales_.at(0)),
+                                            experimental_, qmlEngine(this));
 
     emit attached();
 }
 
+/*!
+    \internal
+
+    Returns the attached provider, to be reconfigured in place, if no other
+    Plugin shares it. Otherwise this Plugin attaches to a provider with its
+    new configuration, and nullptr is returned. Maps and models using this
+    Plugin then move to the new provider when attached() is emitted.
+*/
+QGeoServiceProvider *QDeclarativeGeoServiceProvider::exclusiveProvider()
+{
+    if (!sharedProvider_)
+        return nullptr;
+    if (sharedProvider_.use_count() > 1) {
+        tryAttach();
+        return nullptr;
+    }
+    updateSharedProvider(sharedProvider_.get(), name_, parameterMap(), QLocale(locales_.at(0)),
+                         experimental_, qmlEngine(this));
+    return sharedProvider_.get();
+}
+
 QString QDeclarativeGeoServiceProvider::name() const
 {
     return name_;
@@ -492,8 +585,8 @@ void QDeclarativeGeoServiceProvider::setAllowExperimental(bool allow)
         return;
 
     experimental_ = allow;
-    if (sharedProvider_)
-        sharedProvider_->setAllowExperimental(allow);
+    if (QGeoServiceProvider *provider = exclusiveProvider())
+        provider->setAllowExperimental(allow);
 
     emit allowExperimentalChanged(allow);
 }
@@ -551,8 +644,8 @@ void QDeclarativeGeoServiceProvider::setLocales(const QStringList &locales)
     if (locales_.isEmpty())
         locales_.append(QLocale().name());
 
-    if (sharedProvider_)
-        sharedProvider_->setLocale(QLocale(locales_.at(0)));
+    if (QGeoServiceProvider *provider = exclusiveProvider())
+        provider->setLocale(QLocale(locales_.at(0)));
 
     emit localesChanged();
 }
@@ -580,8 +673,8 @@ void QDeclarativeGeoServiceProvider::parameter_append(QQmlListProperty<QDeclarat
 {
     QDeclarativeGeoServiceProvider *p = static_cast<QDeclarativeGeoServiceProvider *>(prop->object);
     p->parameters_.append(parameter);
-    if (p->sharedProvider_)
-        p->sharedProvider_->setParameters(p->parameterMap());
+    if (QGeoServiceProvider *provider = p->exclusiveProvider())
+        provider->setParameters(p->parameterMap());
 }
 
 /*!
@@ -607,8 +700,8 @@ void QDeclarativeGeoServiceProvider::parameter_clear(QQmlListProperty<QDeclarati
 {
     QDeclarativeGeoServiceProvider *p = static_cast<QDeclarativeGeoServiceProvider *>(prop->object);
     p->parameters_.clear();
-    if (p->sharedProvider_)
-        p->sharedProvider_->setParameters(p->parameterMap());
+    if (QGeoServiceProvider *provider = p->exclusiveProvider())
+        provider->setParameters(p->parameterMap());
 }
 
 /*!
@@ -176,12 +176,13 @@ Q_SIGNALS:
 private:
     bool parametersReady();
     void tryAttach();
+    QGeoServiceProvider *exclusiveProvider();
     static void parameter_append(QQmlListProperty<QDeclarativePluginParameter> *prop, QDeclarativePluginParameter *mapObject);
     static qsizetype parameter_count(QQmlListProperty<QDeclarativePluginParameter> *prop);
     static QDeclarativePluginParameter *parameter_at(QQmlListProperty<QDeclarativePluginParameter> *prop, qsizetype index);
     static void parameter_clear(QQmlListProperty<QDeclarativePluginParameter> *prop);
 
-    std::unique_ptr<QGeoServiceProvider> sharedProvider_;
+    std::shared_ptr<QGeoServiceProvider> sharedProvider_;
     QString name_;
     QList<QDeclarativePluginParameter *> parameters_;
     std::unique_ptr<QDeclarativeGeoServiceProviderRequirements> required_;
@@ -302,12 +302,12 @@ void QDeclarativeSearchModelBase::initializePlugin(QDeclarativeGeoServiceProvide
     beginResetModel();
     if (plugin != m_plugin) {
         if (m_plugin) {
-            disconnect(m_plugin, &QDeclarativeGeoServiceProvider::nameChanged,
-                       this, &QDeclarativeSearchModelBase::pluginNameChanged);
+            disconnect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
+                       this, &QDeclarativeSearchModelBase::pluginAttached);
         }
         if (plugin) {
-            connect(plugin, &QDeclarativeGeoServiceProvider::nameChanged,
-                    this, &QDeclarativeSearchModelBase::pluginNameChanged);
+            connect(plugin, &QDeclarativeGeoServiceProvider::attached,
+                    this, &QDeclarativeSearchModelBase::pluginAttached);
         }
         m_plugin = plugin;
     }
@@ -335,10 +335,20 @@ void QDeclarativeSearchModelBase::onContentUpdated()
 
 /*!
     \internal
+
+    Called when the Plugin attaches to a provider, which happens again when
+    its name changes, or when it moves to a provider of its own because its
+    configuration changed while other Plugins shared its provider.
 */
-void QDeclarativeSearchModelBase::pluginNameChanged()
+void QDeclarativeSearchModelBase::pluginAttached()
 {
     initializePlugin(m_plugin);
+
+    // A search still running on the previous provider is made again
+    if (m_reply && !m_reply->isFinished()) {
+        cancel();
+        update();
+    }
 }
 
 /*!
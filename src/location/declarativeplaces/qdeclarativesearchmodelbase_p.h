@@ -103,7 +103,7 @@ protected Q_SLOTS:
     virtual void onContentUpdated();
 
 private Q_SLOTS:
-    void pluginNameChanged();
+    void pluginAttached();
 
 protected:
     virtual QPlaceReply *sendQuery(QPlaceManager *manager, const QPlaceSearchRequest &request) = 0;
@@ -251,16 +251,14 @@ void QDeclarativeSupportedCategoriesModel::setPlugin(QDeclarativeGeoServiceProvi
 
     m_plugin = plugin;
 
-    // handle plugin attached changes -> update categories
+    // handle plugin attached changes -> update categories. The plugin attaches
+    // again when it moves to another provider.
     if (m_plugin) {
+        connect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
+                this, &QDeclarativeSupportedCategoriesModel::pluginAttached);
         if (m_plugin->isAttached()) {
             connectNotificationSignals();
             update();
-        } else {
-            connect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
-                    this, &QDeclarativeSupportedCategoriesModel::update);
-            connect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
-                    this, &QDeclarativeSupportedCategoriesModel::connectNotificationSignals);
         }
     }
 
@@ -324,6 +322,24 @@ void QDeclarativeSupportedCategoriesModel::replyFinished()
     }
 }
 
+/*!
+    \internal
+*/
+void QDeclarativeSupportedCategoriesModel::pluginAttached()
+{
+    // A category request still running on the previous provider is dropped
+    // and made again on the new one
+    if (m_response) {
+        disconnect(m_response, nullptr, this, nullptr);
+        m_response->abort();
+        m_response->deleteLater();
+        m_response = nullptr;
+    }
+
+    connectNotificationSignals();
+    update();
+}
+
 /*!
     \internal
 */
@@ -468,13 +484,13 @@ void QDeclarativeSupportedCategoriesModel::connectNotificationSignals()
     // listen for any category notifications so that we can reupdate the categories
     // model.
     connect(placeManager, &QPlaceManager::categoryAdded,
-            this, &QDeclarativeSupportedCategoriesModel::addedCategory);
+            this, &QDeclarativeSupportedCategoriesModel::addedCategory, Qt::UniqueConnection);
     connect(placeManager, &QPlaceManager::categoryUpdated,
-            this, &QDeclarativeSupportedCategoriesModel::updatedCategory);
+            this, &QDeclarativeSupportedCategoriesModel::updatedCategory, Qt::UniqueConnection);
     connect(placeManager, &QPlaceManager::categoryRemoved,
-            this, &QDeclarativeSupportedCategoriesModel::removedCategory);
+            this, &QDeclarativeSupportedCategoriesModel::removedCategory, Qt::UniqueConnection);
     connect(placeManager, &QPlaceManager::dataChanged,
-            this, &QDeclarativeSupportedCategoriesModel::emitDataChanged);
+            this, &QDeclarativeSupportedCategoriesModel::emitDataChanged, Qt::UniqueConnection);
 }
 
 /*!
@@ -102,6 +102,7 @@ private Q_SLOTS:
     void updatedCategory(const QPlaceCategory &category, const QString &parentId);
     void removedCategory(const QString &categoryId, const QString &parentId);
     void connectNotificationSignals();
+    void pluginAttached();
 
 private:
     struct PlaceCategoryNode
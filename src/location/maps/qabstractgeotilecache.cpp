@@ -30,6 +30,87 @@ void QAbstractGeoTileCache::printStats()
 {
 }
 
+// Returns the tile if it is already decoded, without decoding it. Subclasses
+// with a texture cache override this.
+QSharedPointer<QGeoTileTexture> QAbstractGeoTileCache::getTexture(const QGeoTileSpec &spec)
+{
+    Q_UNUSED(spec);
+    return QSharedPointer<QGeoTileTexture>();
+}
+
+// Subclasses with the statistics of their tiers override this
+QGeoTileCacheStatistics QAbstractGeoTileCache::statistics() const
+{
+    QGeoTileCacheStatistics statistics;
+    statistics.texture.usage = textureUsage();
+    statistics.texture.maxUsage = maxTextureUsage();
+    statistics.memory.usage = memoryUsage();
+    statistics.memory.maxUsage = maxMemoryUsage();
+    statistics.disk.usage = diskUsage();
+    statistics.disk.maxUsage = maxDiskUsage();
+    return statistics;
+}
+
+// Gives memory back, e.g. when the system runs short of it. The caches
+// fill up again as tiles are used, up to their maximum usage.
+void QAbstractGeoTileCache::trim(TrimLevel level)
+{
+    Q_UNUSED(level);
+}
+
+void QGeoTileCacheHistogram::add(qint64 microseconds)
+{
+    int bucket = 0;
+    for (qint64 limit = FirstLimit; bucket < BucketCount - 1 && microseconds >= limit; limit *= 2)
+        ++bucket;
+    ++buckets[bucket];
+    total += microseconds;
+}
+
+int QGeoTileCacheHistogram::count() const
+{
+    int count = 0;
+    for (int bucket : buckets)
+        count += bucket;
+    return count;
+}
+
+// The limits are in milliseconds, the last bucket has none
+QVariantMap QGeoTileCacheHistogram::toVariantMap() const
+{
+    QVariantList counts;
+    QVariantList limits;
+    qint64 limit = FirstLimit;
+    for (int i = 0; i < BucketCount; ++i, limit *= 2) {
+        counts.append(buckets[i]);
+        if (i < BucketCount - 1)
+            limits.append(limit / 1000.0);
+    }
+    return QVariantMap{ { QStringLiteral("count"), count() },
+                        { QStringLiteral("total"), total / 1000.0 },
+                        { QStringLiteral("buckets"), counts },
+                        { QStringLiteral("limits"), limits } };
+}
+
+QVariantMap QGeoTileCacheStatistics::Tier::toVariantMap() const
+{
+    return QVariantMap{ { QStringLiteral("hits"), hits },
+                        { QStringLiteral("misses"), misses },
+                        { QStringLiteral("evictions"), evictions },
+                        { QStringLiteral("tiles"), tiles },
+                        { QStringLiteral("usage"), usage },
+                        { QStringLiteral("maxUsage"), maxUsage } };
+}
+
+QVariantMap QGeoTileCacheStatistics::toVariantMap() const
+{
+    return QVariantMap{ { QStringLiteral("texture"), texture.toVariantMap() },
+                        { QStringLiteral("memory"), memory.toVariantMap() },
+                        { QStringLiteral("disk"), disk.toVariantMap() },
+                        { QStringLiteral("decodeTimes"), decodeTimes.toVariantMap() },
+                        { QStringLiteral("diskReadTimes"), diskReadTimes.toVariantMap() } };
+}
+
 void QAbstractGeoTileCache::handleError(const QGeoTileSpec &, const QString &error)
 {
     qWarning() << "tile request error " << error;
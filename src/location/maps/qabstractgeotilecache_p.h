@@ -19,6 +19,7 @@
 #include <QtCore/QSharedPointer>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QVariantMap>
 #include <QtGui/QImage>
 
 #include "qgeotilespec_p.h"
@@ -42,6 +43,46 @@ struct QGeoTileTexture
     bool textureBound = false;
 };
 
+// Counts durations in buckets. The first bucket counts those shorter than
+// 125 µs, each next one those shorter than twice the limit of the previous
+// one, and the last one all the others.
+struct Q_LOCATION_EXPORT QGeoTileCacheHistogram
+{
+    static constexpr int BucketCount = 10;
+    static constexpr qint64 FirstLimit = 125; // µs
+
+    void add(qint64 microseconds);
+    int count() const;
+    QVariantMap toVariantMap() const;
+
+    int buckets[BucketCount] = {};
+    qint64 total = 0; // µs
+};
+
+struct Q_LOCATION_EXPORT QGeoTileCacheStatistics
+{
+    // Usage is in the unit of the cost strategy of the tier
+    struct Tier
+    {
+        int hits = 0;
+        int misses = 0;
+        int evictions = 0;
+        int tiles = 0;
+        int usage = 0;
+        int maxUsage = 0;
+
+        QVariantMap toVariantMap() const;
+    };
+
+    Tier texture;
+    Tier memory;
+    Tier disk;
+    QGeoTileCacheHistogram decodeTimes;
+    QGeoTileCacheHistogram diskReadTimes;
+
+    QVariantMap toVariantMap() const;
+};
+
 class Q_LOCATION_EXPORT QAbstractGeoTileCache : public QObject
 {
     Q_OBJECT
@@ -58,6 +99,12 @@ public:
     };
     Q_DECLARE_FLAGS(CacheAreas, CacheArea)
 
+    // How much memory to give back, see trim()
+    enum TrimLevel {
+        TrimTextures,   // the textures of tiles not shown
+        TrimMemory      // those and the memory cache, leaving the disk cache
+    };
+
     virtual ~QAbstractGeoTileCache();
 
     virtual void setMaxDiskUsage(int diskUsage);
@@ -82,6 +129,7 @@ public:
     virtual CostStrategy costStrategyTexture() const = 0;
 
     virtual QSharedPointer<QGeoTileTexture> get(const QGeoTileSpec &spec) = 0;
+    virtual QSharedPointer<QGeoTileTexture> getTexture(const QGeoTileSpec &spec);
 
     virtual void insert(const QGeoTileSpec &spec,
                 const QByteArray &bytes,
@@ -90,6 +138,9 @@ public:
     virtual void handleError(const QGeoTileSpec &spec, const QString &errorString);
     virtual void init() = 0;
 
+    virtual QGeoTileCacheStatistics statistics() const;
+    virtual void trim(TrimLevel level);
+
     static QString baseCacheDirectory();
     static QString baseLocationCacheDirectory();
 
@@ -119,6 +119,11 @@ public:
     inline void setPromoteAt(int p) { promote_ = p; }
 
     inline int totalCost() const { return q1_->cost + q2_->cost + q3_->cost; }
+    inline int count() const { return q1_->size + q2_->size + q3_->size; }
+
+    inline int hitCount() const { return hitCount_; }
+    inline int missCount() const { return missCount_; }
+    inline int evictionCount() const { return evictionCount_; }
 
     void clear();
     bool insert(const Key &key, QSharedPointer<T> object, int cost = 1);
@@ -138,6 +143,7 @@ public:
 private:
     int maxCost_, minRecent_, maxOldPopular_;
     int hitCount_, missCount_, promote_;
+    int evictionCount_ = 0;
 
     void rebalance();
     void unlink(Node *n);
@@ -350,12 +356,14 @@ void QCache3Q<Key,T,EvPolicy>::rebalance()
             Node *n = q3_->l;
             unlink(n);
             EvPolicy::aboutToBeEvicted(n->k, n->v);
+            ++evictionCount_;
             lookup_.remove(n->k);
             delete n;
         } else if (q1_->cost > minRecent_) {
             Node *n = q1_->l;
             unlink(n);
             EvPolicy::aboutToBeEvicted(n->k, n->v);
+            ++evictionCount_;
             n->v.clear();
             n->cost = 0;
             link_front(n, q1_evicted_);
@@ -366,6 +374,7 @@ void QCache3Q<Key,T,EvPolicy>::rebalance()
                 link_front(n, q3_);
             } else {
                 EvPolicy::aboutToBeEvicted(n->k, n->v);
+                ++evictionCount_;
                 n->v.clear();
                 n->cost = 0;
                 link_front(n, q1_evicted_);
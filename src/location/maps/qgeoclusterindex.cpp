@@ -0,0 +1,399 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoclusterindex_p.h"
+
+#include <QtCore/QVarLengthArray>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// Cluster ids hold the index of the node they originate from, shifted by
+// this many bits, and the zoom level of that node in the remaining bits
+constexpr int ZoomLevelBits = 5;
+constexpr int MaximumZoomLevel = (1 << ZoomLevelBits) - 2;
+
+double mercatorY(double latitude)
+{
+    return qBound(0.0, QWebMercator::coordToMercator(QGeoCoordinate(latitude, 0.0)).y(), 1.0);
+}
+} // anonymous namespace
+
+// Sets the distance in pixels within which points are merged into a cluster
+// to radius. Takes effect at the next call to load().
+void QGeoClusterIndex::setRadius(double radius)
+{
+    m_radius = qMax(0.0, radius);
+}
+
+double QGeoClusterIndex::radius() const
+{
+    return m_radius;
+}
+
+// Sets the lowest zoom level clusters are computed for to zoomLevel.
+// Takes effect at the next call to load().
+void QGeoClusterIndex::setMinimumZoomLevel(int zoomLevel)
+{
+    m_minimumZoomLevel = qBound(0, zoomLevel, MaximumZoomLevel);
+    m_maximumZoomLevel = qMax(m_minimumZoomLevel, m_maximumZoomLevel);
+}
+
+int QGeoClusterIndex::minimumZoomLevel() const
+{
+    return m_minimumZoomLevel;
+}
+
+// Sets the highest zoom level clusters are computed for to zoomLevel.
+// Above it, all points are returned on their own. Takes effect at the next
+// call to load().
+void QGeoClusterIndex::setMaximumZoomLevel(int zoomLevel)
+{
+    m_maximumZoomLevel = qBound(0, zoomLevel, MaximumZoomLevel);
+    m_minimumZoomLevel = qMin(m_minimumZoomLevel, m_maximumZoomLevel);
+}
+
+int QGeoClusterIndex::maximumZoomLevel() const
+{
+    return m_maximumZoomLevel;
+}
+
+// Sets the number of points a cluster must at least gather to
+// minimumPoints. Takes effect at the next call to load().
+void QGeoClusterIndex::setMinimumPoints(int minimumPoints)
+{
+    m_minimumPoints = qMax(2, minimumPoints);
+}
+
+int QGeoClusterIndex::minimumPoints() const
+{
+    return m_minimumPoints;
+}
+
+// Builds the clusters of points for every zoom level. Invalid
+// coordinates are ignored, but keep their index.
+void QGeoClusterIndex::load(const QList<QGeoCoordinate> &points)
+{
+    m_points = points;
+    m_levels.clear();
+    m_levels.resize(m_maximumZoomLevel - m_minimumZoomLevel + 2);
+
+    QList<Node> &nodes = m_levels.last().nodes;
+    nodes.reserve(points.size());
+    for (qsizetype i = 0; i < points.size(); ++i) {
+        const QGeoCoordinate &point = points.at(i);
+        if (!point.isValid())
+            continue;
+        const QDoubleVector2D projected = QWebMercator::coordToMercator(point);
+        nodes.append({ projected.x(), qBound(0.0, projected.y(), 1.0), i, -1, 1, INT_MAX });
+    }
+    sortKd(nodes, 0, nodes.size() - 1, 0);
+
+    for (int zoomLevel = m_maximumZoomLevel; zoomLevel >= m_minimumZoomLevel; --zoomLevel) {
+        Level &current = m_levels[zoomLevel - m_minimumZoomLevel];
+        current.nodes = cluster(m_levels[zoomLevel - m_minimumZoomLevel + 1], zoomLevel);
+        sortKd(current.nodes, 0, current.nodes.size() - 1, 0);
+    }
+}
+
+void QGeoClusterIndex::clear()
+{
+    m_points.clear();
+    m_levels.clear();
+}
+
+qsizetype QGeoClusterIndex::pointCount() const
+{
+    return m_points.size();
+}
+
+// Returns the clusters and single points at zoomLevel within region,
+// including those whose radius overlaps it.
+QList<QGeoClusterIndex::Cluster> QGeoClusterIndex::clusters(const QGeoRectangle &region,
+                                                            int zoomLevel) const
+{
+    QList<Cluster> result;
+    if (m_levels.isEmpty() || !region.isValid())
+        return result;
+
+    zoomLevel = qBound(m_minimumZoomLevel, zoomLevel, m_maximumZoomLevel + 1);
+    const Level &level = m_levels.at(zoomLevel - m_minimumZoomLevel);
+    const double padding = zoomRadius(zoomLevel);
+    const double minY = mercatorY(region.topLeft().latitude()) - padding;
+    const double maxY = mercatorY(region.bottomRight().latitude()) + padding;
+
+    double minX = (region.topLeft().longitude() + 180.0) / 360.0 - padding;
+    double maxX = (region.bottomRight().longitude() + 180.0) / 360.0 + padding;
+    if (region.topLeft().longitude() > region.bottomRight().longitude())
+        maxX += 1.0; // crossing the antimeridian
+
+    QList<qsizetype> found;
+    if (region.width() >= 360.0 || maxX - minX >= 1.0) {
+        found = level.range(0.0, minY, 1.0, maxY);
+    } else {
+        if (minX < 0.0) {
+            minX += 1.0;
+            maxX += 1.0;
+        }
+        found = level.range(minX, minY, qMin(maxX, 1.0), maxY);
+        if (maxX > 1.0)
+            found += level.range(0.0, minY, maxX - 1.0, maxY);
+    }
+
+    result.reserve(found.size());
+    for (qsizetype index : std::as_const(found))
+        result.append(toCluster(level.nodes.at(index)));
+    return result;
+}
+
+// Returns the clusters and points clusterId is made of, at the zoom
+// level above the one it appears at.
+QList<QGeoClusterIndex::Cluster> QGeoClusterIndex::children(qint64 clusterId) const
+{
+    QList<Cluster> result;
+    const qint64 origin = clusterId - m_points.size();
+    if (origin < 0)
+        return result;
+
+    const int originZoomLevel = int(origin % (1 << ZoomLevelBits));
+    const qsizetype originIndex = qsizetype(origin >> ZoomLevelBits);
+    if (originZoomLevel <= m_minimumZoomLevel || originZoomLevel > m_maximumZoomLevel + 1)
+        return result;
+    const Level &level = m_levels.at(originZoomLevel - m_minimumZoomLevel);
+    if (originIndex >= level.nodes.size())
+        return result;
+
+    const Node &originNode = level.nodes.at(originIndex);
+    const QList<qsizetype> neighbours = level.within(originNode.x, originNode.y,
+                                                     zoomRadius(originZoomLevel - 1));
+    for (qsizetype index : neighbours) {
+        const Node &child = level.nodes.at(index);
+        if (child.parentId == clusterId)
+            result.append(toCluster(child));
+    }
+    return result;
+}
+
+// Returns the indexes of all the points clusterId is made of.
+QList<qsizetype> QGeoClusterIndex::leaves(qint64 clusterId) const
+{
+    QList<qsizetype> result;
+    if (clusterId >= 0 && clusterId < m_points.size())
+        result.append(clusterId);
+    else
+        addLeaves(clusterId, &result);
+    return result;
+}
+
+void QGeoClusterIndex::addLeaves(qint64 clusterId, QList<qsizetype> *leaves) const
+{
+    const QList<Cluster> childClusters = children(clusterId);
+    for (const Cluster &child : childClusters) {
+        if (child.isCluster())
+            addLeaves(child.id, leaves);
+        else
+            leaves->append(child.id);
+    }
+}
+
+// Returns the zoom level at which clusterId splits into several
+// clusters or points, or -1 if clusterId is not a cluster.
+int QGeoClusterIndex::expansionZoomLevel(qint64 clusterId) const
+{
+    const qint64 origin = clusterId - m_points.size();
+    if (origin < 0)
+        return -1;
+
+    int zoomLevel = int(origin % (1 << ZoomLevelBits)) - 1;
+    while (zoomLevel <= m_maximumZoomLevel) {
+        const QList<Cluster> childClusters = children(clusterId);
+        ++zoomLevel;
+        if (childClusters.size() != 1)
+            break;
+        clusterId = childClusters.first().id;
+    }
+    return zoomLevel;
+}
+
+QGeoClusterIndex::Cluster QGeoClusterIndex::toCluster(const Node &node) const
+{
+    Cluster cluster;
+    cluster.id = node.id;
+    cluster.count = node.count;
+    if (node.count == 1)
+        cluster.coordinate = m_points.at(node.id);
+    else
+        cluster.coordinate = QWebMercator::mercatorToCoord(QDoubleVector2D(node.x, node.y));
+    return cluster;
+}
+
+// Merges the nodes of level, one zoom level above zoomLevel, which are closer
+// than the radius at zoomLevel, and returns the nodes of zoomLevel.
+QList<QGeoClusterIndex::Node> QGeoClusterIndex::cluster(Level &level, int zoomLevel) const
+{
+    const double radius = zoomRadius(zoomLevel);
+    QList<Node> &nodes = level.nodes;
+    QList<Node> result;
+
+    for (qsizetype i = 0; i < nodes.size(); ++i) {
+        if (nodes.at(i).zoomLevel <= zoomLevel)
+            continue;
+        nodes[i].zoomLevel = zoomLevel;
+
+        const double x = nodes.at(i).x;
+        const double y = nodes.at(i).y;
+        const qsizetype originCount = nodes.at(i).count;
+        const QList<qsizetype> neighbours = level.within(x, y, radius);
+
+        qsizetype count = originCount;
+        for (qsizetype neighbour : neighbours) {
+            if (nodes.at(neighbour).zoomLevel > zoomLevel)
+                count += nodes.at(neighbour).count;
+        }
+
+        if (count > originCount && count >= m_minimumPoints) {
+            const qint64 id = (qint64(i) << ZoomLevelBits) + (zoomLevel + 1) + m_points.size();
+            double weightedX = x * originCount;
+            double weightedY = y * originCount;
+            for (qsizetype neighbour : neighbours) {
+                Node &node = nodes[neighbour];
+                if (node.zoomLevel <= zoomLevel)
+                    continue;
+                node.zoomLevel = zoomLevel;
+                node.parentId = id;
+                weightedX += node.x * node.count;
+                weightedY += node.y * node.count;
+            }
+            nodes[i].parentId = id;
+            result.append({ weightedX / count, weightedY / count, id, -1, count, INT_MAX });
+        } else {
+            // Too few points to form a cluster: they are carried over as they are
+            result.append(nodes.at(i));
+            if (count > 1) {
+                for (qsizetype neighbour : neighbours) {
+                    Node &node = nodes[neighbour];
+                    if (node.zoomLevel <= zoomLevel)
+                        continue;
+                    node.zoomLevel = zoomLevel;
+                    result.append(node);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+double QGeoClusterIndex::zoomRadius(int zoomLevel) const
+{
+    // In the [0, 1] Web Mercator space, the world being TileSize * 2^zoomLevel pixels wide
+    return m_radius / (TileSize * std::ldexp(1.0, zoomLevel));
+}
+
+// Sorts nodes into a k-d tree, alternating the axis at every level, down to
+// leaves of NodeSize nodes which are searched linearly
+void QGeoClusterIndex::sortKd(QList<Node> &nodes, qsizetype left, qsizetype right, int axis)
+{
+    if (right - left <= NodeSize)
+        return;
+
+    const qsizetype middle = (left + right) / 2;
+    const auto begin = nodes.begin();
+    std::nth_element(begin + left, begin + middle, begin + right + 1,
+                     [axis](const Node &a, const Node &b) {
+                         return axis == 0 ? a.x < b.x : a.y < b.y;
+                     });
+    sortKd(nodes, left, middle - 1, 1 - axis);
+    sortKd(nodes, middle + 1, right, 1 - axis);
+}
+
+namespace {
+struct KdSpan
+{
+    qsizetype left;
+    qsizetype right;
+    int axis;
+};
+} // anonymous namespace
+
+QList<qsizetype> QGeoClusterIndex::Level::range(double minX, double minY,
+                                                double maxX, double maxY) const
+{
+    QList<qsizetype> result;
+    if (nodes.isEmpty())
+        return result;
+
+    const auto inside = [&](const Node &node) {
+        return node.x >= minX && node.x <= maxX && node.y >= minY && node.y <= maxY;
+    };
+
+    QVarLengthArray<KdSpan, 64> stack;
+    stack.append({ 0, nodes.size() - 1, 0 });
+    while (!stack.isEmpty()) {
+        const KdSpan span = stack.takeLast();
+        if (span.right - span.left <= NodeSize) {
+            for (qsizetype i = span.left; i <= span.right; ++i) {
+                if (inside(nodes.at(i)))
+                    result.append(i);
+            }
+            continue;
+        }
+
+        const qsizetype middle = (span.left + span.right) / 2;
+        const Node &node = nodes.at(middle);
+        if (inside(node))
+            result.append(middle);
+        const double value = span.axis == 0 ? node.x : node.y;
+        if ((span.axis == 0 ? minX : minY) <= value)
+            stack.append({ span.left, middle - 1, 1 - span.axis });
+        if ((span.axis == 0 ? maxX : maxY) >= value)
+            stack.append({ middle + 1, span.right, 1 - span.axis });
+    }
+    return result;
+}
+
+QList<qsizetype> QGeoClusterIndex::Level::within(double x, double y, double radius) const
+{
+    QList<qsizetype> result;
+    if (nodes.isEmpty())
+        return result;
+
+    const double radiusSquared = radius * radius;
+    const auto inside = [&](const Node &node) {
+        const double dx = node.x - x;
+        const double dy = node.y - y;
+        return dx * dx + dy * dy <= radiusSquared;
+    };
+
+    QVarLengthArray<KdSpan, 64> stack;
+    stack.append({ 0, nodes.size() - 1, 0 });
+    while (!stack.isEmpty()) {
+        const KdSpan span = stack.takeLast();
+        if (span.right - span.left <= NodeSize) {
+            for (qsizetype i = span.left; i <= span.right; ++i) {
+                if (inside(nodes.at(i)))
+                    result.append(i);
+            }
+            continue;
+        }
+
+        const qsizetype middle = (span.left + span.right) / 2;
+        const Node &node = nodes.at(middle);
+        if (inside(node))
+            result.append(middle);
+        const double value = span.axis == 0 ? node.x : node.y;
+        if ((span.axis == 0 ? x : y) - radius <= value)
+            stack.append({ span.left, middle - 1, 1 - span.axis });
+        if ((span.axis == 0 ? x : y) + radius >= value)
+            stack.append({ middle + 1, span.right, 1 - span.axis });
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,113 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCLUSTERINDEX_P_H
+#define QGEOCLUSTERINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+
+#include <QtCore/QList>
+#include <QtPositioning/QGeoCoordinate>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRectangle;
+
+// Hierarchical clustering of points for every integer zoom level, computed
+// once when the points are loaded. Points closer than radius() pixels at a
+// zoom level are merged into a cluster placed at their weighted center, and
+// the clusters of a zoom level are in turn merged for the level below.
+// Every level is stored in a static k-d tree over the Web Mercator
+// coordinates of its clusters, so that the clusters of a region are
+// retrieved without visiting the others.
+class Q_LOCATION_EXPORT QGeoClusterIndex
+{
+public:
+    struct Cluster
+    {
+        QGeoCoordinate coordinate;
+        // The index of the point for a single point, otherwise a number
+        // greater than or equal to pointCount() identifying the cluster
+        qint64 id = -1;
+        qsizetype count = 0;
+
+        bool isCluster() const { return count > 1; }
+    };
+
+    void setRadius(double radius);
+    double radius() const;
+
+    void setMinimumZoomLevel(int zoomLevel);
+    int minimumZoomLevel() const;
+
+    void setMaximumZoomLevel(int zoomLevel);
+    int maximumZoomLevel() const;
+
+    void setMinimumPoints(int minimumPoints);
+    int minimumPoints() const;
+
+    void load(const QList<QGeoCoordinate> &points);
+    void clear();
+    qsizetype pointCount() const;
+
+    QList<Cluster> clusters(const QGeoRectangle &region, int zoomLevel) const;
+    QList<Cluster> children(qint64 clusterId) const;
+    QList<qsizetype> leaves(qint64 clusterId) const;
+    int expansionZoomLevel(qint64 clusterId) const;
+
+private:
+    static constexpr int TileSize = 256;
+    static constexpr qsizetype NodeSize = 64;
+
+    struct Node
+    {
+        double x;
+        double y;
+        qint64 id;
+        qint64 parentId = -1;
+        qsizetype count = 1;
+        int zoomLevel; // the lowest zoom level the node has been merged at
+    };
+
+    // A level of the hierarchy, whose nodes are sorted into a k-d tree
+    struct Level
+    {
+        QList<Node> nodes;
+
+        QList<qsizetype> range(double minX, double minY, double maxX, double maxY) const;
+        QList<qsizetype> within(double x, double y, double radius) const;
+    };
+
+    static void sortKd(QList<Node> &nodes, qsizetype left, qsizetype right, int axis);
+
+    Cluster toCluster(const Node &node) const;
+    QList<Node> cluster(Level &level, int zoomLevel) const;
+    double zoomRadius(int zoomLevel) const;
+    void addLeaves(qint64 clusterId, QList<qsizetype> *leaves) const;
+
+    double m_radius = 60.0;
+    int m_minimumZoomLevel = 0;
+    int m_maximumZoomLevel = 16;
+    int m_minimumPoints = 2;
+    QList<QGeoCoordinate> m_points;
+    // Indexed by zoom level - minimumZoomLevel, up to maximumZoomLevel + 1
+    // holding the points themselves
+    QList<Level> m_levels;
+};
+
+Q_DECLARE_TYPEINFO(QGeoClusterIndex::Cluster, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QGEOCLUSTERINDEX_P_H
@@ -7,6 +7,7 @@
 #include "qgeomappingmanager_p.h"
 
 #include <QDir>
+#include <QElapsedTimer>
 #include <QStandardPaths>
 #include <QMetaType>
 #include <QPixmap>
@@ -14,6 +15,15 @@
 
 QT_BEGIN_NAMESPACE
 
+// Converting it here, once per decoded tile, instead of in each
+// QSGTexture::bind(). The ARGB32 images of decoded PNGs are converted in
+// place, without copying the pixels.
+static void convertForTexture(QImage &image)
+{
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32_Premultiplied)
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+}
+
 class QGeoCachedTileMemory
 {
 public:
@@ -46,7 +56,7 @@ void QCache3QTileEvictionPolicy::aboutToBeEvicted(const QGeoTileSpec &key, QShar
 QGeoCachedTileDisk::~QGeoCachedTileDisk()
 {
     if (cache)
-        cache->evictFromDiskCache(this);
+        cache->removeTileFile(this);
 }
 
 QGeoFileTileCache::QGeoFileTileCache(const QString &directory, QObject *parent)
@@ -194,6 +204,32 @@ QGeoFileTileCache::~QGeoFileTileCache()
 #endif
 }
 
+QGeoTileCacheStatistics QGeoFileTileCache::statistics() const
+{
+    QGeoTileCacheStatistics statistics = QAbstractGeoTileCache::statistics();
+    const auto tierStatistics = [](QGeoTileCacheStatistics::Tier *tier, const auto &cache) {
+        tier->hits = cache.hitCount();
+        tier->misses = cache.missCount();
+        tier->evictions = cache.evictionCount();
+        tier->tiles = cache.count();
+    };
+    tierStatistics(&statistics.texture, textureCache_);
+    tierStatistics(&statistics.memory, memoryCache_);
+    tierStatistics(&statistics.disk, diskCache_);
+    statistics.decodeTimes = decodeTimes_;
+    statistics.diskReadTimes = diskReadTimes_;
+    return statistics;
+}
+
+void QGeoFileTileCache::trim(TrimLevel level)
+{
+    // The textures of the tiles shown are held by the maps, and only
+    // released once they are not shown anymore
+    textureCache_.clear();
+    if (level == TrimMemory)
+        memoryCache_.clear();
+}
+
 void QGeoFileTileCache::printStats()
 {
     textureCache_.printStats();
@@ -341,6 +377,11 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::get(const QGeoTileSpec &spec)
     return getFromDisk(spec);
 }
 
+QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getTexture(const QGeoTileSpec &spec)
+{
+    return textureCache_.object(spec);
+}
+
 void QGeoFileTileCache::insert(const QGeoTileSpec &spec,
                            const QByteArray &bytes,
                            const QString &format,
@@ -433,6 +474,12 @@ void QGeoFileTileCache::evictFromDiskCache(QGeoCachedTileDisk *td)
     QFile::remove(td->filename);
 }
 
+// Called when the tile is evicted from the disk cache, or replaced in it
+void QGeoFileTileCache::removeTileFile(QGeoCachedTileDisk *td)
+{
+    evictFromDiskCache(td);
+}
+
 void QGeoFileTileCache::evictFromMemoryCache(QGeoCachedTileMemory * /* tm  */)
 {
 }
@@ -513,11 +560,12 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromMemory(const QGeoTileS
 
     QSharedPointer<QGeoCachedTileMemory> tm = memoryCache_.object(spec);
     if (tm) {
-        QImage image;
-        if (!image.loadFromData(tm->bytes)) {
+        QImage image = decodeTileImage(spec, tm->bytes, tm->format);
+        if (image.isNull()) {
             handleError(spec, QLatin1String("Problem with tile image"));
             return QSharedPointer<QGeoTileTexture>();
         }
+        convertForTexture(image);
         QSharedPointer<QGeoTileTexture> tt = addToTextureCache(spec, image);
         if (tt)
             return tt;
@@ -530,31 +578,25 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromDisk(const QGeoTileSpe
     QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(spec);
     if (td) {
         const QString format = QFileInfo(td->filename).suffix();
-        QFile file(td->filename);
-        file.open(QIODevice::ReadOnly);
-        QByteArray bytes = file.readAll();
-        file.close();
+        const QByteArray bytes = readTileFile(td->filename);
 
-        QImage image;
         // Some tiles from the servers could be valid images but the tile fetcher
         // might be able to recognize them as tiles that should not be shown.
         // If that's the case, the tile fetcher should write "NoRetry" inside the file.
         if (isTileBogus(bytes)) {
             QSharedPointer<QGeoTileTexture> tt(new QGeoTileTexture);
             tt->spec = spec;
-            tt->image = image;
             return tt;
         }
 
         // This is a truly invalid image. The fetcher should try again.
-        if (!image.loadFromData(bytes)) {
+        QImage image = decodeTileImage(spec, bytes, format);
+        if (image.isNull()) {
             handleError(spec, QLatin1String("Problem with tile image"));
             return QSharedPointer<QGeoTileTexture>();
         }
 
-        // Converting it here, instead of in each QSGTexture::bind()
-        if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32_Premultiplied)
-            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        convertForTexture(image);
 
         addToMemoryCache(spec, bytes, format);
         QSharedPointer<QGeoTileTexture> tt = addToTextureCache(td->spec, image);
@@ -565,6 +607,59 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCache::getFromDisk(const QGeoTileSpe
     return QSharedPointer<QGeoTileTexture>();
 }
 
+// The bytes of a tile in the memory or the disk cache, without decoding them
+QByteArray QGeoFileTileCache::getDataFromCache(const QGeoTileSpec &spec, QString *format)
+{
+    if (QSharedPointer<QGeoCachedTileMemory> tm = memoryCache_.object(spec)) {
+        *format = tm->format;
+        return tm->bytes;
+    }
+
+    QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(spec);
+    if (!td)
+        return QByteArray();
+    const QByteArray bytes = readTileFile(td->filename);
+    if (bytes.isEmpty())
+        return QByteArray();
+    *format = QFileInfo(td->filename).suffix();
+    if (!isTileBogus(bytes))
+        addToMemoryCache(spec, bytes, *format);
+    return bytes;
+}
+
+// Decodes with decodeTile(), recording how long it takes
+QImage QGeoFileTileCache::decodeTileImage(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                          const QString &format)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QImage image = decodeTile(spec, bytes, format);
+    decodeTimes_.add(timer.nsecsElapsed() / 1000);
+    return image;
+}
+
+QByteArray QGeoFileTileCache::readTileFile(const QString &filename)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    const QByteArray bytes = file.readAll();
+    diskReadTimes_.add(timer.nsecsElapsed() / 1000);
+    return bytes;
+}
+
+QImage QGeoFileTileCache::decodeTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                     const QString &format) const
+{
+    Q_UNUSED(spec);
+    Q_UNUSED(format);
+    QImage image;
+    image.loadFromData(bytes);
+    return image;
+}
+
 bool QGeoFileTileCache::isTileBogus(const QByteArray &bytes) const
 {
     if (bytes.size() == 7 && bytes == QByteArrayLiteral("NoRetry"))
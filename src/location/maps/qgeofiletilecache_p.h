@@ -56,6 +56,7 @@ protected:
 class Q_LOCATION_EXPORT QGeoFileTileCache : public QAbstractGeoTileCache
 {
     Q_OBJECT
+    friend class QGeoCachedTileDisk;
 public:
     QGeoFileTileCache(const QString &directory = QString(), QObject *parent = nullptr);
     ~QGeoFileTileCache();
@@ -74,7 +75,7 @@ public:
     int minTextureUsage() const override;
     int textureUsage() const override;
     void clearAll() override;
-    void clearMapId(int mapId);
+    virtual void clearMapId(int mapId);
     void setCostStrategyDisk(CostStrategy costStrategy) override;
     CostStrategy costStrategyDisk() const override;
     void setCostStrategyMemory(CostStrategy costStrategy) override;
@@ -84,6 +85,10 @@ public:
 
 
     QSharedPointer<QGeoTileTexture> get(const QGeoTileSpec &spec) override;
+    QSharedPointer<QGeoTileTexture> getTexture(const QGeoTileSpec &spec) override;
+
+    QGeoTileCacheStatistics statistics() const override;
+    void trim(TrimLevel level) override;
 
     // can be called without a specific tileCache pointer
     static void evictFromDiskCache(QGeoCachedTileDisk *td);
@@ -110,8 +115,16 @@ protected:
     QSharedPointer<QGeoTileTexture> addToTextureCache(const QGeoTileSpec &spec, const QImage &image);
     QSharedPointer<QGeoTileTexture> getFromMemory(const QGeoTileSpec &spec);
     QSharedPointer<QGeoTileTexture> getFromDisk(const QGeoTileSpec &spec);
+    QByteArray getDataFromCache(const QGeoTileSpec &spec, QString *format);
+    QImage decodeTileImage(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format);
+    QByteArray readTileFile(const QString &filename);
 
+    virtual void removeTileFile(QGeoCachedTileDisk *td);
     virtual bool isTileBogus(const QByteArray &bytes) const;
+    // Turns the cached bytes of a tile into its image, a null image when
+    // they can't be decoded
+    virtual QImage decodeTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                              const QString &format) const;
     virtual QString tileSpecToFilename(const QGeoTileSpec &spec, const QString &format, const QString &directory) const;
     virtual QGeoTileSpec filenameToTileSpec(const QString &filename) const;
 
@@ -120,6 +133,8 @@ protected:
     QCache3Q<QGeoTileSpec, QGeoTileTexture> textureCache_;
 
     QString directory_;
+    QGeoTileCacheHistogram decodeTimes_;
+    QGeoTileCacheHistogram diskReadTimes_;
 
     int minTextureUsage_ = 0;
     int extraTextureUsage_ = 0;
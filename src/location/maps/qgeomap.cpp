@@ -188,6 +188,16 @@ void QGeoMap::clearData()
 
 }
 
+void QGeoMap::trimData(QAbstractGeoTileCache::TrimLevel level)
+{
+    Q_UNUSED(level);
+}
+
+QGeoTileCacheStatistics QGeoMap::cacheStatistics() const
+{
+    return QGeoTileCacheStatistics();
+}
+
 QGeoMap::ItemTypes QGeoMap::supportedMapItemTypes() const
 {
     Q_D(const QGeoMap);
@@ -16,6 +16,7 @@
 
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/private/qgeomaptype_p.h>
+#include <QtLocation/private/qabstractgeotilecache_p.h>
 #include <QtCore/QObject>
 #include <QTransform>
 
@@ -95,6 +96,8 @@ public:
 
     virtual void prefetchData();
     virtual void clearData();
+    virtual void trimData(QAbstractGeoTileCache::TrimLevel level);
+    virtual QGeoTileCacheStatistics cacheStatistics() const;
 
     ItemTypes supportedMapItemTypes() const;
 
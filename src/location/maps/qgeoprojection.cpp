@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qgeoprojection_p.h"
+#include "qdeclarativegeomapitemutils_p.h"
 
 #include <QSize>
 #include <QtGui/QMatrix4x4>
@@ -452,6 +453,13 @@ QList<QDoubleVector2D> QGeoProjectionWebMercator::visibleGeometryExpanded() cons
     return m_visibleRegionExpanded;
 }
 
+QRectF QGeoProjectionWebMercator::visibleGeometryBoundingRect() const
+{
+    if (m_visibleRegionDirty)
+        const_cast<QGeoProjectionWebMercator *>(this)->updateVisibleRegion();
+    return m_visibleRegionBoundingRect;
+}
+
 QList<QDoubleVector2D> QGeoProjectionWebMercator::projectableGeometry() const
 {
     if (m_visibleRegionDirty)
@@ -750,6 +758,8 @@ void QGeoProjectionWebMercator::updateVisibleRegion()
     if (res.size())
         m_visibleRegion = res[0]; // Intersection between two convex quadrilaterals should always be a single polygon
 
+    m_visibleRegionBoundingRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(m_visibleRegion);
+
     m_projectableRegion.clear();
     mapRect.clear();
     // The full map rectangle in extended mercator space
@@ -146,6 +146,7 @@ public:
     bool isProjectable(const QDoubleVector2D &wrappedProjection) const;
     QList<QDoubleVector2D> visibleGeometry() const;
     QList<QDoubleVector2D> visibleGeometryExpanded() const;
+    QRectF visibleGeometryBoundingRect() const;
     QList<QDoubleVector2D> projectableGeometry() const;
 
     inline QDoubleVector2D viewportToWrappedMapProjection(const QDoubleVector2D &itemPosition) const;
@@ -236,6 +237,8 @@ protected:
 
     QList<QDoubleVector2D> m_visibleRegion;
     QList<QDoubleVector2D> m_visibleRegionExpanded;
+    // Shared by the map items, which clip and wrap against it on polish
+    QRectF           m_visibleRegionBoundingRect;
     QList<QDoubleVector2D> m_projectableRegion;
     bool             m_visibleRegionDirty;
 
@@ -0,0 +1,239 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutebatchreply.h"
+#include "qgeoroutebatchreply_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QGeoRouteBatchReply
+    \inmodule QtLocation
+    \ingroup QtLocation-routing
+    \since 6.9
+
+    \brief The QGeoRouteBatchReply class manages the calculation of several
+    independent routes started by an instance of QGeoRoutingManager.
+
+    Each request passed to QGeoRoutingManager::calculateRoutes() gets its own
+    result, identified by the index of the request. The routes(),
+    requestError() and requestErrorString() functions return the result of a
+    request once requestFinished() has been emitted for its index.
+
+    A request which fails does not fail the whole batch. The error() of the
+    batch reply itself is only set when the batch could not be processed at
+    all, for example because it was aborted.
+
+    \sa QGeoRoutingManager::calculateRoutes()
+*/
+
+/*!
+    Constructs a batch reply for \a requests with the specified \a parent.
+*/
+QGeoRouteBatchReply::QGeoRouteBatchReply(const QList<QGeoRouteRequest> &requests, QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoRouteBatchReplyPrivate(requests))
+{
+}
+
+/*!
+    Constructs a batch reply with a given \a error and \a errorString and the
+    specified \a parent.
+*/
+QGeoRouteBatchReply::QGeoRouteBatchReply(QGeoRouteReply::Error error, const QString &errorString,
+                                         QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoRouteBatchReplyPrivate(error, errorString))
+{
+}
+
+/*!
+    Destroys this batch reply object.
+*/
+QGeoRouteBatchReply::~QGeoRouteBatchReply()
+{
+    delete d_ptr;
+}
+
+/*!
+    Sets whether or not this reply has finished to \a finished.
+
+    If \a finished is true, this will cause the finished() signal to be
+    emitted.
+*/
+void QGeoRouteBatchReply::setFinished(bool finished)
+{
+    d_ptr->isFinished = finished;
+    if (d_ptr->isFinished)
+        emit this->finished();
+}
+
+/*!
+    Return true if all requests have been processed, or if an error brought
+    the operation to a halt.
+*/
+bool QGeoRouteBatchReply::isFinished() const
+{
+    return d_ptr->isFinished;
+}
+
+/*!
+    Sets the error state of this reply to \a error and the textual
+    representation of the error to \a errorString.
+
+    This will also cause errorOccurred() and finished() signals to be emitted,
+    in that order.
+*/
+void QGeoRouteBatchReply::setError(QGeoRouteReply::Error error, const QString &errorString)
+{
+    d_ptr->error = error;
+    d_ptr->errorString = errorString;
+    emit errorOccurred(error, errorString);
+    setFinished(true);
+}
+
+/*!
+    Returns the error state of this reply.
+*/
+QGeoRouteReply::Error QGeoRouteBatchReply::error() const
+{
+    return d_ptr->error;
+}
+
+/*!
+    Returns the textual representation of the error state of this reply.
+*/
+QString QGeoRouteBatchReply::errorString() const
+{
+    return d_ptr->errorString;
+}
+
+/*!
+    Returns the requests of the batch.
+*/
+QList<QGeoRouteRequest> QGeoRouteBatchReply::requests() const
+{
+    return d_ptr->requests;
+}
+
+/*!
+    Returns the number of requests of the batch.
+*/
+qsizetype QGeoRouteBatchReply::count() const
+{
+    return d_ptr->requests.size();
+}
+
+/*!
+    Returns the routes calculated for the request at \a index.
+*/
+QList<QGeoRoute> QGeoRouteBatchReply::routes(qsizetype index) const
+{
+    return d_ptr->results.value(index).routes;
+}
+
+/*!
+    Returns the error of the request at \a index.
+*/
+QGeoRouteReply::Error QGeoRouteBatchReply::requestError(qsizetype index) const
+{
+    return d_ptr->results.value(index).error;
+}
+
+/*!
+    Returns the textual representation of the error of the request at
+    \a index.
+*/
+QString QGeoRouteBatchReply::requestErrorString(qsizetype index) const
+{
+    return d_ptr->results.value(index).errorString;
+}
+
+/*!
+    Sets the routes calculated for the request at \a index to \a routes and
+    emits requestFinished().
+*/
+void QGeoRouteBatchReply::setRoutes(qsizetype index, const QList<QGeoRoute> &routes)
+{
+    if (index < 0 || index >= d_ptr->results.size())
+        return;
+    d_ptr->results[index].routes = routes;
+    emit requestFinished(index);
+}
+
+/*!
+    Sets the error of the request at \a index to \a error and its textual
+    representation to \a errorString, and emits requestFinished().
+*/
+void QGeoRouteBatchReply::setRequestError(qsizetype index, QGeoRouteReply::Error error,
+                                          const QString &errorString)
+{
+    if (index < 0 || index >= d_ptr->results.size())
+        return;
+    QGeoRouteBatchReplyPrivate::Result &result = d_ptr->results[index];
+    result.error = error;
+    result.errorString = errorString;
+    emit requestFinished(index);
+}
+
+/*!
+    \fn void QGeoRouteBatchReply::requestFinished(qsizetype index)
+
+    This signal is emitted when the request at \a index has been processed,
+    successfully or not. Requests may finish in any order.
+*/
+
+/*!
+    \fn void QGeoRouteBatchReply::aborted()
+
+    This signal is emitted when the operation has been cancelled.
+
+    \sa abort()
+*/
+
+/*!
+    Cancels the operation immediately.
+
+    This will do nothing if the reply is finished.
+*/
+void QGeoRouteBatchReply::abort()
+{
+    emit aborted();
+}
+
+/*!
+    \fn void QGeoRouteBatchReply::finished()
+
+    This signal is emitted when all requests have been processed.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+
+/*!
+    \fn void QGeoRouteBatchReply::errorOccurred(QGeoRouteReply::Error error, const QString &errorString)
+
+    This signal is emitted when an error described by \a error and
+    \a errorString prevented the batch from being processed. The finished()
+    signal will follow.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoRouteBatchReplyPrivate::QGeoRouteBatchReplyPrivate(const QList<QGeoRouteRequest> &requests)
+    : requests(requests),
+      results(requests.size())
+{}
+
+QGeoRouteBatchReplyPrivate::QGeoRouteBatchReplyPrivate(QGeoRouteReply::Error error,
+                                                       const QString &errorString)
+    : error(error),
+      errorString(errorString),
+      isFinished(true)
+{}
+
+QT_END_NAMESPACE
@@ -0,0 +1,62 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEBATCHREPLY_H
+#define QGEOROUTEBATCHREPLY_H
+
+#include <QtLocation/QGeoRoute>
+#include <QtLocation/QGeoRouteReply>
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteRequest;
+class QGeoRouteBatchReplyPrivate;
+
+class Q_LOCATION_EXPORT QGeoRouteBatchReply : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QGeoRouteBatchReply(QGeoRouteReply::Error error, const QString &errorString,
+                                 QObject *parent = nullptr);
+    virtual ~QGeoRouteBatchReply();
+
+    bool isFinished() const;
+    QGeoRouteReply::Error error() const;
+    QString errorString() const;
+
+    QList<QGeoRouteRequest> requests() const;
+    qsizetype count() const;
+
+    QList<QGeoRoute> routes(qsizetype index) const;
+    QGeoRouteReply::Error requestError(qsizetype index) const;
+    QString requestErrorString(qsizetype index) const;
+
+    virtual void abort();
+
+Q_SIGNALS:
+    void requestFinished(qsizetype index);
+    void finished();
+    void aborted();
+    void errorOccurred(QGeoRouteReply::Error error, const QString &errorString = QString());
+
+protected:
+    explicit QGeoRouteBatchReply(const QList<QGeoRouteRequest> &requests,
+                                 QObject *parent = nullptr);
+
+    void setError(QGeoRouteReply::Error error, const QString &errorString);
+    void setFinished(bool finished);
+
+    void setRoutes(qsizetype index, const QList<QGeoRoute> &routes);
+    void setRequestError(qsizetype index, QGeoRouteReply::Error error, const QString &errorString);
+
+private:
+    QGeoRouteBatchReplyPrivate *d_ptr;
+    Q_DISABLE_COPY(QGeoRouteBatchReply)
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEBATCHREPLY_P_H
+#define QGEOROUTEBATCHREPLY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qgeorouterequest.h"
+#include "qgeoroutebatchreply.h"
+
+#include <QList>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteBatchReplyPrivate
+{
+public:
+    struct Result
+    {
+        QList<QGeoRoute> routes;
+        QGeoRouteReply::Error error = QGeoRouteReply::NoError;
+        QString errorString;
+    };
+
+    explicit QGeoRouteBatchReplyPrivate(const QList<QGeoRouteRequest> &requests);
+    QGeoRouteBatchReplyPrivate(QGeoRouteReply::Error error, const QString &errorString);
+
+    QGeoRouteReply::Error error = QGeoRouteReply::NoError;
+    QString errorString;
+    bool isFinished = false;
+
+    QList<QGeoRouteRequest> requests;
+    QList<Result> results;
+
+private:
+    Q_DISABLE_COPY(QGeoRouteBatchReplyPrivate)
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,215 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutematrix.h"
+#include "qgeoroutematrix_p.h"
+
+#include <QtCore/qnumeric.h>
+
+QT_BEGIN_NAMESPACE
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QGeoRouteMatrixPrivate)
+
+/*!
+    \class QGeoRouteMatrix
+    \inmodule QtLocation
+    \ingroup QtLocation-routing
+    \since 6.9
+
+    \brief The QGeoRouteMatrix class holds the travel times and distances
+    between a list of sources and a list of destinations.
+
+    Each row of the matrix belongs to one source and each column to one
+    destination, in the order they were passed to
+    QGeoRoutingManager::calculateRouteMatrix(). The values are stored
+    contiguously, row by row, so that matrices with thousands of entries
+    stay small and cheap to copy.
+
+    A pair of source and destination without a route between them is
+    unreachable. Its travel time is -1 and its distance is NaN.
+
+    \sa QGeoRouteMatrixReply
+*/
+
+/*!
+    Constructs an empty matrix.
+*/
+QGeoRouteMatrix::QGeoRouteMatrix()
+    : d_ptr(new QGeoRouteMatrixPrivate())
+{
+}
+
+/*!
+    Constructs a matrix with \a rows sources and \a columns destinations,
+    in which every destination is unreachable.
+*/
+QGeoRouteMatrix::QGeoRouteMatrix(qsizetype rows, qsizetype columns)
+    : d_ptr(new QGeoRouteMatrixPrivate())
+{
+    if (rows <= 0 || columns <= 0)
+        return;
+    d_ptr->rows = rows;
+    d_ptr->columns = columns;
+    d_ptr->travelTimes.fill(-1, rows * columns);
+    d_ptr->distances.fill(qQNaN(), rows * columns);
+}
+
+/*!
+    Constructs a matrix from the contents of \a other.
+*/
+QGeoRouteMatrix::QGeoRouteMatrix(const QGeoRouteMatrix &other) noexcept = default;
+
+/*!
+    Destroys the matrix.
+*/
+QGeoRouteMatrix::~QGeoRouteMatrix() = default;
+
+/*!
+    Assigns the contents of \a other to this matrix and returns a reference to
+    this matrix.
+*/
+QGeoRouteMatrix &QGeoRouteMatrix::operator=(const QGeoRouteMatrix &other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    d_ptr = other.d_ptr;
+    return *this;
+}
+
+/*!
+    \fn bool QGeoRouteMatrix::operator==(const QGeoRouteMatrix &lhs, const QGeoRouteMatrix &rhs) noexcept
+
+    Returns whether the matrices \a lhs and \a rhs are equal.
+*/
+
+/*!
+    \fn bool QGeoRouteMatrix::operator!=(const QGeoRouteMatrix &lhs, const QGeoRouteMatrix &rhs) noexcept
+
+    Returns whether the matrices \a lhs and \a rhs are not equal.
+*/
+
+bool QGeoRouteMatrix::isEqual(const QGeoRouteMatrix &other) const noexcept
+{
+    return ((d_ptr.constData() == other.d_ptr.constData())
+            || (*d_ptr) == (*other.d_ptr));
+}
+
+/*!
+    Returns whether the matrix has no entries.
+*/
+bool QGeoRouteMatrix::isEmpty() const
+{
+    return d_ptr->travelTimes.isEmpty();
+}
+
+/*!
+    Returns the number of sources of the matrix.
+*/
+qsizetype QGeoRouteMatrix::rowCount() const
+{
+    return d_ptr->rows;
+}
+
+/*!
+    Returns the number of destinations of the matrix.
+*/
+qsizetype QGeoRouteMatrix::columnCount() const
+{
+    return d_ptr->columns;
+}
+
+/*!
+    Sets the travel time from the source at \a row to the destination at
+    \a column to \a secs seconds. A negative value marks the destination as
+    unreachable.
+*/
+void QGeoRouteMatrix::setTravelTime(qsizetype row, qsizetype column, int secs)
+{
+    Q_ASSERT(row >= 0 && row < d_ptr->rows && column >= 0 && column < d_ptr->columns);
+    d_ptr.detach();
+    d_ptr->travelTimes[row * d_ptr->columns + column] = secs < 0 ? -1 : secs;
+}
+
+/*!
+    Returns the travel time in seconds from the source at \a row to the
+    destination at \a column, or -1 if it is unreachable.
+*/
+int QGeoRouteMatrix::travelTime(qsizetype row, qsizetype column) const
+{
+    if (row < 0 || row >= d_ptr->rows || column < 0 || column >= d_ptr->columns)
+        return -1;
+    return d_ptr->travelTimes.at(row * d_ptr->columns + column);
+}
+
+/*!
+    Sets the distance from the source at \a row to the destination at
+    \a column to \a distance meters.
+*/
+void QGeoRouteMatrix::setDistance(qsizetype row, qsizetype column, qreal distance)
+{
+    Q_ASSERT(row >= 0 && row < d_ptr->rows && column >= 0 && column < d_ptr->columns);
+    d_ptr.detach();
+    d_ptr->distances[row * d_ptr->columns + column] = float(distance);
+}
+
+/*!
+    Returns the distance in meters from the source at \a row to the
+    destination at \a column, or NaN if it is unknown.
+
+    Distances are stored with single precision, which is exact to a few
+    meters for routes around the world.
+*/
+qreal QGeoRouteMatrix::distance(qsizetype row, qsizetype column) const
+{
+    if (row < 0 || row >= d_ptr->rows || column < 0 || column >= d_ptr->columns)
+        return qQNaN();
+    return d_ptr->distances.at(row * d_ptr->columns + column);
+}
+
+/*!
+    Returns whether there is a route from the source at \a row to the
+    destination at \a column.
+*/
+bool QGeoRouteMatrix::isReachable(qsizetype row, qsizetype column) const
+{
+    return travelTime(row, column) >= 0;
+}
+
+/*!
+    Returns the travel times of all entries row by row.
+*/
+QList<int> QGeoRouteMatrix::travelTimes() const
+{
+    return d_ptr->travelTimes;
+}
+
+/*!
+    Returns the distances of all entries row by row.
+*/
+QList<qreal> QGeoRouteMatrix::distances() const
+{
+    QList<qreal> result;
+    result.reserve(d_ptr->distances.size());
+    for (float distance : std::as_const(d_ptr->distances))
+        result.append(distance);
+    return result;
+}
+
+/*******************************************************************************
+*******************************************************************************/
+
+bool QGeoRouteMatrixPrivate::operator==(const QGeoRouteMatrixPrivate &other) const
+{
+    if (rows != other.rows || columns != other.columns || travelTimes != other.travelTimes)
+        return false;
+    for (qsizetype i = 0; i < distances.size(); ++i) {
+        const float a = distances.at(i);
+        const float b = other.distances.at(i);
+        if (a != b && !(qIsNaN(a) && qIsNaN(b)))
+            return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
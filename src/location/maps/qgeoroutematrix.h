@@ -0,0 +1,61 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEMATRIX_H
+#define QGEOROUTEMATRIX_H
+
+#include <QtCore/QList>
+#include <QtCore/QExplicitlySharedDataPointer>
+
+#include <QtLocation/qlocationglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteMatrixPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QGeoRouteMatrixPrivate, Q_LOCATION_EXPORT)
+
+class Q_LOCATION_EXPORT QGeoRouteMatrix
+{
+public:
+    QGeoRouteMatrix();
+    QGeoRouteMatrix(qsizetype rows, qsizetype columns);
+    QGeoRouteMatrix(const QGeoRouteMatrix &other) noexcept;
+    QGeoRouteMatrix(QGeoRouteMatrix &&other) noexcept = default;
+    ~QGeoRouteMatrix();
+
+    QGeoRouteMatrix &operator=(const QGeoRouteMatrix &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QGeoRouteMatrix)
+
+    void swap(QGeoRouteMatrix &other) noexcept { d_ptr.swap(other.d_ptr); }
+
+    friend inline bool operator==(const QGeoRouteMatrix &lhs, const QGeoRouteMatrix &rhs) noexcept
+    { return lhs.isEqual(rhs); }
+    friend inline bool operator!=(const QGeoRouteMatrix &lhs, const QGeoRouteMatrix &rhs) noexcept
+    { return !lhs.isEqual(rhs); }
+
+    bool isEmpty() const;
+    qsizetype rowCount() const;
+    qsizetype columnCount() const;
+
+    void setTravelTime(qsizetype row, qsizetype column, int secs);
+    int travelTime(qsizetype row, qsizetype column) const;
+
+    void setDistance(qsizetype row, qsizetype column, qreal distance);
+    qreal distance(qsizetype row, qsizetype column) const;
+
+    bool isReachable(qsizetype row, qsizetype column) const;
+
+    QList<int> travelTimes() const;
+    QList<qreal> distances() const;
+
+private:
+    QExplicitlySharedDataPointer<QGeoRouteMatrixPrivate> d_ptr;
+
+    bool isEqual(const QGeoRouteMatrix &other) const noexcept;
+};
+
+Q_DECLARE_SHARED(QGeoRouteMatrix)
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,39 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEMATRIX_P_H
+#define QGEOROUTEMATRIX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qgeoroutematrix.h"
+
+#include <QList>
+#include <QSharedData>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteMatrixPrivate : public QSharedData
+{
+public:
+    bool operator==(const QGeoRouteMatrixPrivate &other) const;
+
+    qsizetype rows = 0;
+    qsizetype columns = 0;
+    // Row major, one entry per source and destination pair
+    QList<int> travelTimes;
+    QList<float> distances;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,215 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutematrixreply.h"
+#include "qgeoroutematrixreply_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QGeoRouteMatrixReply
+    \inmodule QtLocation
+    \ingroup QtLocation-routing
+    \since 6.9
+
+    \brief The QGeoRouteMatrixReply class manages a travel time matrix
+    calculation started by an instance of QGeoRoutingManager.
+
+    The reply holds the sources and destinations the matrix was requested for
+    and, once finished() has been emitted without an error, the resulting
+    matrix().
+
+    As with QGeoRouteReply, a newly created reply may already be finished,
+    most commonly because an error has occurred, so isFinished() should be
+    checked before connecting to the signals.
+
+    \sa QGeoRoutingManager::calculateRouteMatrix()
+*/
+
+/*!
+    Constructs a matrix reply for the travel times from \a sources to
+    \a destinations, using the options of \a request, with the specified
+    \a parent.
+*/
+QGeoRouteMatrixReply::QGeoRouteMatrixReply(const QList<QGeoCoordinate> &sources,
+                                           const QList<QGeoCoordinate> &destinations,
+                                           const QGeoRouteRequest &request, QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoRouteMatrixReplyPrivate(sources, destinations, request))
+{
+}
+
+/*!
+    Constructs a matrix reply with a given \a error and \a errorString and the
+    specified \a parent.
+*/
+QGeoRouteMatrixReply::QGeoRouteMatrixReply(QGeoRouteReply::Error error, const QString &errorString,
+                                           QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoRouteMatrixReplyPrivate(error, errorString))
+{
+}
+
+/*!
+    Destroys this matrix reply object.
+*/
+QGeoRouteMatrixReply::~QGeoRouteMatrixReply()
+{
+    delete d_ptr;
+}
+
+/*!
+    Sets whether or not this reply has finished to \a finished.
+
+    If \a finished is true, this will cause the finished() signal to be
+    emitted.
+
+    If the operation completed successfully, setMatrix() should be called
+    before this function. If an error occurred, setError() should be used
+    instead.
+*/
+void QGeoRouteMatrixReply::setFinished(bool finished)
+{
+    d_ptr->isFinished = finished;
+    if (d_ptr->isFinished)
+        emit this->finished();
+}
+
+/*!
+    Return true if the operation completed successfully or encountered an
+    error which cause the operation to come to a halt.
+*/
+bool QGeoRouteMatrixReply::isFinished() const
+{
+    return d_ptr->isFinished;
+}
+
+/*!
+    Sets the error state of this reply to \a error and the textual
+    representation of the error to \a errorString.
+
+    This will also cause errorOccurred() and finished() signals to be emitted,
+    in that order.
+*/
+void QGeoRouteMatrixReply::setError(QGeoRouteReply::Error error, const QString &errorString)
+{
+    d_ptr->error = error;
+    d_ptr->errorString = errorString;
+    emit errorOccurred(error, errorString);
+    setFinished(true);
+}
+
+/*!
+    Returns the error state of this reply.
+*/
+QGeoRouteReply::Error QGeoRouteMatrixReply::error() const
+{
+    return d_ptr->error;
+}
+
+/*!
+    Returns the textual representation of the error state of this reply.
+*/
+QString QGeoRouteMatrixReply::errorString() const
+{
+    return d_ptr->errorString;
+}
+
+/*!
+    Returns the sources of the matrix, one per row.
+*/
+QList<QGeoCoordinate> QGeoRouteMatrixReply::sources() const
+{
+    return d_ptr->sources;
+}
+
+/*!
+    Returns the destinations of the matrix, one per column.
+*/
+QList<QGeoCoordinate> QGeoRouteMatrixReply::destinations() const
+{
+    return d_ptr->destinations;
+}
+
+/*!
+    Returns the route request holding the options, such as the travel mode,
+    used for every entry of the matrix.
+*/
+QGeoRouteRequest QGeoRouteMatrixReply::request() const
+{
+    return d_ptr->request;
+}
+
+/*!
+    Returns the calculated matrix.
+*/
+QGeoRouteMatrix QGeoRouteMatrixReply::matrix() const
+{
+    return d_ptr->matrix;
+}
+
+/*!
+    Sets the calculated matrix to \a matrix.
+*/
+void QGeoRouteMatrixReply::setMatrix(const QGeoRouteMatrix &matrix)
+{
+    d_ptr->matrix = matrix;
+}
+
+/*!
+    \fn void QGeoRouteMatrixReply::aborted()
+
+    This signal is emitted when the operation has been cancelled.
+
+    \sa abort()
+*/
+
+/*!
+    Cancels the operation immediately.
+
+    This will do nothing if the reply is finished.
+*/
+void QGeoRouteMatrixReply::abort()
+{
+    emit aborted();
+}
+
+/*!
+    \fn void QGeoRouteMatrixReply::finished()
+
+    This signal is emitted when this reply has finished processing.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+
+/*!
+    \fn void QGeoRouteMatrixReply::errorOccurred(QGeoRouteReply::Error error, const QString &errorString)
+
+    This signal is emitted when an error described by \a error and
+    \a errorString has been detected in the processing of this reply. The
+    finished() signal will follow.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoRouteMatrixReplyPrivate::QGeoRouteMatrixReplyPrivate(const QList<QGeoCoordinate> &sources,
+                                                         const QList<QGeoCoordinate> &destinations,
+                                                         const QGeoRouteRequest &request)
+    : sources(sources),
+      destinations(destinations),
+      request(request)
+{}
+
+QGeoRouteMatrixReplyPrivate::QGeoRouteMatrixReplyPrivate(QGeoRouteReply::Error error,
+                                                         const QString &errorString)
+    : error(error),
+      errorString(errorString),
+      isFinished(true)
+{}
+
+QT_END_NAMESPACE
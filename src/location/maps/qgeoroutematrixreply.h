@@ -0,0 +1,60 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEMATRIXREPLY_H
+#define QGEOROUTEMATRIXREPLY_H
+
+#include <QtLocation/QGeoRouteMatrix>
+#include <QtLocation/QGeoRouteReply>
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCoordinate;
+class QGeoRouteRequest;
+class QGeoRouteMatrixReplyPrivate;
+
+class Q_LOCATION_EXPORT QGeoRouteMatrixReply : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QGeoRouteMatrixReply(QGeoRouteReply::Error error, const QString &errorString,
+                                  QObject *parent = nullptr);
+    virtual ~QGeoRouteMatrixReply();
+
+    bool isFinished() const;
+    QGeoRouteReply::Error error() const;
+    QString errorString() const;
+
+    QList<QGeoCoordinate> sources() const;
+    QList<QGeoCoordinate> destinations() const;
+    QGeoRouteRequest request() const;
+    QGeoRouteMatrix matrix() const;
+
+    virtual void abort();
+
+Q_SIGNALS:
+    void finished();
+    void aborted();
+    void errorOccurred(QGeoRouteReply::Error error, const QString &errorString = QString());
+
+protected:
+    QGeoRouteMatrixReply(const QList<QGeoCoordinate> &sources,
+                         const QList<QGeoCoordinate> &destinations,
+                         const QGeoRouteRequest &request, QObject *parent = nullptr);
+
+    void setError(QGeoRouteReply::Error error, const QString &errorString);
+    void setFinished(bool finished);
+
+    void setMatrix(const QGeoRouteMatrix &matrix);
+
+private:
+    QGeoRouteMatrixReplyPrivate *d_ptr;
+    Q_DISABLE_COPY(QGeoRouteMatrixReply)
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEMATRIXREPLY_P_H
+#define QGEOROUTEMATRIXREPLY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qgeorouterequest.h"
+#include "qgeoroutematrix.h"
+#include "qgeoroutematrixreply.h"
+
+#include <QList>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteMatrixReplyPrivate
+{
+public:
+    QGeoRouteMatrixReplyPrivate(const QList<QGeoCoordinate> &sources,
+                                const QList<QGeoCoordinate> &destinations,
+                                const QGeoRouteRequest &request);
+    QGeoRouteMatrixReplyPrivate(QGeoRouteReply::Error error, const QString &errorString);
+
+    QGeoRouteReply::Error error = QGeoRouteReply::NoError;
+    QString errorString;
+    bool isFinished = false;
+
+    QList<QGeoCoordinate> sources;
+    QList<QGeoCoordinate> destinations;
+    QGeoRouteRequest request;
+    QGeoRouteMatrix matrix;
+
+private:
+    Q_DISABLE_COPY(QGeoRouteMatrixReplyPrivate)
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -28,6 +28,27 @@ QGeoRouteParserPrivate::~QGeoRouteParserPrivate()
 {
 }
 
+QGeoRouteReply::Error QGeoRouteParserPrivate::parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                                               const QByteArray &reply) const
+{
+    Q_UNUSED(matrix);
+    Q_UNUSED(reply);
+    errorString = QStringLiteral("Route matrices are not supported by this service.");
+    return QGeoRouteReply::UnsupportedOptionError;
+}
+
+QUrl QGeoRouteParserPrivate::matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                                              const QList<QGeoCoordinate> &destinations,
+                                              const QGeoRouteRequest &request,
+                                              const QString &prefix) const
+{
+    Q_UNUSED(sources);
+    Q_UNUSED(destinations);
+    Q_UNUSED(request);
+    Q_UNUSED(prefix);
+    return QUrl();
+}
+
 /*
     Public class implementations
 */
@@ -54,6 +75,22 @@ QUrl QGeoRouteParser::requestUrl(const QGeoRouteRequest &request, const QString
     return d->requestUrl(request, prefix);
 }
 
+QGeoRouteReply::Error QGeoRouteParser::parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                                        const QByteArray &reply) const
+{
+    Q_D(const QGeoRouteParser);
+    return d->parseMatrixReply(matrix, errorString, reply);
+}
+
+// Returns an invalid url if the service has no matrix endpoint
+QUrl QGeoRouteParser::matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                                       const QList<QGeoCoordinate> &destinations,
+                                       const QGeoRouteRequest &request, const QString &prefix) const
+{
+    Q_D(const QGeoRouteParser);
+    return d->matrixRequestUrl(sources, destinations, request, prefix);
+}
+
 QGeoRouteParser::TrafficSide QGeoRouteParser::trafficSide() const
 {
     Q_D(const QGeoRouteParser);
@@ -23,6 +23,7 @@ QT_BEGIN_NAMESPACE
 class QByteArray;
 class QUrl;
 class QGeoRouteRequest;
+class QGeoRouteMatrix;
 class QGeoRouteParserPrivate;
 class Q_LOCATION_EXPORT QGeoRouteParser : public QObject
 {
@@ -38,6 +39,11 @@ public:
     virtual ~QGeoRouteParser();
     QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const;
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const;
+    QGeoRouteReply::Error parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                           const QByteArray &reply) const;
+    QUrl matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                          const QList<QGeoCoordinate> &destinations,
+                          const QGeoRouteRequest &request, const QString &prefix) const;
 
     TrafficSide trafficSide() const;
 
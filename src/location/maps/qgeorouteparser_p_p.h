@@ -19,6 +19,7 @@
 #include <QtCore/QUrl>
 #include <QtLocation/qgeoroutereply.h>
 #include <QtLocation/qgeorouterequest.h>
+#include <QtLocation/qgeoroutematrix.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -32,6 +33,13 @@ public:
     virtual QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const = 0;
     virtual QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const = 0;
 
+    // Parsers of services without a matrix endpoint keep these defaults
+    virtual QGeoRouteReply::Error parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                                   const QByteArray &reply) const;
+    virtual QUrl matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                                  const QList<QGeoCoordinate> &destinations,
+                                  const QGeoRouteRequest &request, const QString &prefix) const;
+
     QGeoRouteParser::TrafficSide trafficSide = QGeoRouteParser::RightHandTraffic;
 };
 
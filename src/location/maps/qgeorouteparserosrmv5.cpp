@@ -784,6 +784,11 @@ public:
 
     QGeoRouteReply::Error parseReply(QList<QGeoRoute> &routes, QString &errorString, const QByteArray &reply) const override;
     QUrl requestUrl(const QGeoRouteRequest &request, const QString &prefix) const override;
+    QGeoRouteReply::Error parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                           const QByteArray &reply) const override;
+    QUrl matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                          const QList<QGeoCoordinate> &destinations,
+                          const QGeoRouteRequest &request, const QString &prefix) const override;
 
     QVariantMap m_vendorParams;
     const QGeoRouteParserOsrmV5Extension *m_extension = nullptr;
@@ -1013,6 +1018,88 @@ QUrl QGeoRouteParserOsrmV5Private::requestUrl(const QGeoRouteRequest &request, c
     return url;
 }
 
+QGeoRouteReply::Error QGeoRouteParserOsrmV5Private::parseMatrixReply(QGeoRouteMatrix &matrix, QString &errorString,
+                                                                     const QByteArray &reply) const
+{
+    // OSRM table service: https://project-osrm.org/docs/v5.24.0/api/#table-service
+    // Mapbox Matrix API: https://docs.mapbox.com/api/navigation/matrix/
+    QJsonDocument document = QJsonDocument::fromJson(reply);
+    if (!document.isObject()) {
+        errorString = QLatin1String("Couldn't parse json.");
+        return QGeoRouteReply::ParseError;
+    }
+    QJsonObject object = document.object();
+
+    QString status = object.value(QLatin1String("code")).toString();
+    if (status != QLatin1String("Ok")) {
+        errorString = status;
+        return QGeoRouteReply::UnknownError;
+    }
+    if (!object.value(QLatin1String("durations")).isArray()) {
+        errorString = QLatin1String("No durations found");
+        return QGeoRouteReply::ParseError;
+    }
+
+    const QJsonArray durations = object.value(QLatin1String("durations")).toArray();
+    const QJsonArray distances = object.value(QLatin1String("distances")).toArray();
+    const qsizetype rows = durations.size();
+    const qsizetype columns = rows > 0 ? durations.at(0).toArray().size() : 0;
+
+    QGeoRouteMatrix result(rows, columns);
+    for (qsizetype row = 0; row < rows; ++row) {
+        const QJsonArray durationRow = durations.at(row).toArray();
+        const QJsonArray distanceRow = distances.at(row).toArray();
+        for (qsizetype column = 0; column < columns && column < durationRow.size(); ++column) {
+            // Unreachable pairs are null
+            const QJsonValue duration = durationRow.at(column);
+            if (!duration.isDouble())
+                continue;
+            result.setTravelTime(row, column, qRound(duration.toDouble()));
+            const QJsonValue distance = distanceRow.at(column);
+            if (distance.isDouble())
+                result.setDistance(row, column, distance.toDouble());
+        }
+    }
+    matrix = result;
+    return QGeoRouteReply::NoError;
+}
+
+QUrl QGeoRouteParserOsrmV5Private::matrixRequestUrl(const QList<QGeoCoordinate> &sources,
+                                                    const QList<QGeoCoordinate> &destinations,
+                                                    const QGeoRouteRequest &request,
+                                                    const QString &prefix) const
+{
+    Q_UNUSED(request);
+    QString tableUrl = prefix;
+    QString sourceIndexes;
+    QString destinationIndexes;
+    qsizetype index = 0;
+    for (const QGeoCoordinate &c : sources) {
+        if (index)
+            tableUrl.append(QLatin1Char(';'));
+        tableUrl.append(QString::number(c.longitude(), 'f', 7)).append(QLatin1Char(',')).append(QString::number(c.latitude(), 'f', 7));
+        if (!sourceIndexes.isEmpty())
+            sourceIndexes.append(QLatin1Char(';'));
+        sourceIndexes.append(QString::number(index++));
+    }
+    for (const QGeoCoordinate &c : destinations) {
+        if (index)
+            tableUrl.append(QLatin1Char(';'));
+        tableUrl.append(QString::number(c.longitude(), 'f', 7)).append(QLatin1Char(',')).append(QString::number(c.latitude(), 'f', 7));
+        if (!destinationIndexes.isEmpty())
+            destinationIndexes.append(QLatin1Char(';'));
+        destinationIndexes.append(QString::number(index++));
+    }
+
+    QUrl url(tableUrl);
+    QUrlQuery query;
+    query.addQueryItem(QLatin1String("sources"), sourceIndexes);
+    query.addQueryItem(QLatin1String("destinations"), destinationIndexes);
+    query.addQueryItem(QLatin1String("annotations"), QLatin1String("duration,distance"));
+    url.setQuery(query);
+    return url;
+}
+
 QGeoRouteParserOsrmV5::QGeoRouteParserOsrmV5(QObject *parent)
     : QGeoRouteParser(*new QGeoRouteParserOsrmV5Private(), parent)
 {
@@ -0,0 +1,229 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutepipeline_p.h"
+#include "qgeoroutingmanagerengine.h"
+#include "qgeoroutingmanagerengine_p.h"
+
+#include <QtCore/QMetaObject>
+
+QT_BEGIN_NAMESPACE
+
+QGeoRoutePipeline::QGeoRoutePipeline(QGeoRoutingManagerEngine *engine,
+                                     const QList<QGeoRouteRequest> &requests, QObject *parent)
+    : QObject(parent), m_engine(engine), m_requests(requests)
+{
+}
+
+QGeoRoutePipeline::~QGeoRoutePipeline()
+{
+    abort();
+}
+
+void QGeoRoutePipeline::start()
+{
+    issue();
+}
+
+void QGeoRoutePipeline::abort()
+{
+    m_aborted = true;
+    const QList<QGeoRouteReply *> replies = m_inFlight.keys();
+    m_inFlight.clear();
+    for (QGeoRouteReply *reply : replies) {
+        disconnect(reply, nullptr, this, nullptr);
+        if (!reply->isFinished())
+            reply->abort();
+        release(reply);
+    }
+}
+
+void QGeoRoutePipeline::issue()
+{
+    // Replies which are finished as soon as they are created are handled
+    // from within this loop, which must not be entered again.
+    if (m_issuing)
+        return;
+    m_issuing = true;
+
+    while (!m_aborted && m_inFlight.size() < MaximumInFlight && m_next < m_requests.size()) {
+        const qsizetype index = m_next++;
+        QGeoRouteReply *reply = m_engine ? m_engine->calculateRoute(m_requests.at(index)) : nullptr;
+        if (!reply) {
+            QGeoRouteReply failed(QGeoRouteReply::EngineNotSetError,
+                                  QStringLiteral("The routing engine was destroyed."));
+            emit routeFinished(index, &failed);
+            continue;
+        }
+
+        m_inFlight.insert(reply, index);
+        QGeoRoutingManagerEnginePrivate::get(m_engine)->pipelinedReplies.insert(reply);
+        if (reply->isFinished()) {
+            replyFinished(reply);
+            continue;
+        }
+        connect(reply, &QGeoRouteReply::finished, this, [this, reply]() {
+            replyFinished(reply);
+        });
+        // The replies belong to the engine and are destroyed along with it
+        connect(reply, &QObject::destroyed, this, [this, reply]() {
+            m_inFlight.remove(reply);
+        });
+    }
+
+    m_issuing = false;
+    if (!m_aborted && m_inFlight.isEmpty() && m_next == m_requests.size())
+        emit allFinished();
+}
+
+void QGeoRoutePipeline::replyFinished(QGeoRouteReply *reply)
+{
+    const auto it = m_inFlight.constFind(reply);
+    if (it == m_inFlight.cend())
+        return;
+    const qsizetype index = it.value();
+    m_inFlight.erase(it);
+    disconnect(reply, nullptr, this, nullptr);
+
+    emit routeFinished(index, reply);
+    release(reply);
+    issue();
+}
+
+void QGeoRoutePipeline::release(QGeoRouteReply *reply)
+{
+    if (m_engine)
+        QGeoRoutingManagerEnginePrivate::get(m_engine)->pipelinedReplies.remove(reply);
+    reply->deleteLater();
+}
+
+/*******************************************************************************
+*******************************************************************************/
+
+// QGeoRouteRequest shares its data between copies even when modified, so
+// the options are copied into a new request
+static QGeoRouteRequest pairRequest(const QGeoRouteRequest &request,
+                                    const QGeoCoordinate &source,
+                                    const QGeoCoordinate &destination)
+{
+    QGeoRouteRequest pair(source, destination);
+    pair.setNumberAlternativeRoutes(request.numberAlternativeRoutes());
+    pair.setExcludeAreas(request.excludeAreas());
+    pair.setTravelModes(request.travelModes());
+    const QList<QGeoRouteRequest::FeatureType> featureTypes = request.featureTypes();
+    for (QGeoRouteRequest::FeatureType featureType : featureTypes)
+        pair.setFeatureWeight(featureType, request.featureWeight(featureType));
+    pair.setRouteOptimization(request.routeOptimization());
+    pair.setSegmentDetail(request.segmentDetail());
+    pair.setManeuverDetail(request.maneuverDetail());
+    pair.setDepartureTime(request.departureTime());
+    pair.setTimeout(request.timeout());
+    pair.setPriority(request.priority());
+    return pair;
+}
+
+QGeoRouteMatrixReplyPipelined::QGeoRouteMatrixReplyPipelined(QGeoRoutingManagerEngine *engine,
+                                                             const QList<QGeoCoordinate> &sources,
+                                                             const QList<QGeoCoordinate> &destinations,
+                                                             const QGeoRouteRequest &request,
+                                                             QObject *parent)
+    : QGeoRouteMatrixReply(sources, destinations, request, parent),
+      m_matrix(sources.size(), destinations.size())
+{
+    QList<QGeoRouteRequest> requests;
+    for (qsizetype row = 0; row < sources.size(); ++row) {
+        for (qsizetype column = 0; column < destinations.size(); ++column) {
+            const QGeoCoordinate &source = sources.at(row);
+            const QGeoCoordinate &destination = destinations.at(column);
+            if (source == destination) {
+                m_matrix.setTravelTime(row, column, 0);
+                m_matrix.setDistance(row, column, 0.0);
+                continue;
+            }
+
+            requests.append(pairRequest(request, source, destination));
+            m_cells.append(row * destinations.size() + column);
+        }
+    }
+
+    m_pipeline = new QGeoRoutePipeline(engine, requests, this);
+    connect(m_pipeline, &QGeoRoutePipeline::routeFinished,
+            this, &QGeoRouteMatrixReplyPipelined::routeFinished);
+    connect(m_pipeline, &QGeoRoutePipeline::allFinished,
+            this, &QGeoRouteMatrixReplyPipelined::allFinished);
+    // Started from the event loop, so that the caller can connect to the
+    // signals of this reply first.
+    QMetaObject::invokeMethod(m_pipeline, &QGeoRoutePipeline::start, Qt::QueuedConnection);
+}
+
+void QGeoRouteMatrixReplyPipelined::abort()
+{
+    m_pipeline->abort();
+    QGeoRouteMatrixReply::abort();
+}
+
+void QGeoRouteMatrixReplyPipelined::routeFinished(qsizetype index, QGeoRouteReply *reply)
+{
+    const qsizetype row = m_cells.at(index) / m_matrix.columnCount();
+    const qsizetype column = m_cells.at(index) % m_matrix.columnCount();
+
+    if (reply->error() != QGeoRouteReply::NoError) {
+        if (m_firstError == QGeoRouteReply::NoError) {
+            m_firstError = reply->error();
+            m_firstErrorString = reply->errorString();
+        }
+        return;
+    }
+
+    const QList<QGeoRoute> routes = reply->routes();
+    if (routes.isEmpty())
+        return;
+    m_matrix.setTravelTime(row, column, routes.first().travelTime());
+    m_matrix.setDistance(row, column, routes.first().distance());
+    m_reachable = true;
+}
+
+void QGeoRouteMatrixReplyPipelined::allFinished()
+{
+    // A failed pair is only unreachable, unless no route was found at all
+    // and the failure is likely to be the service rather than the roads.
+    if (!m_reachable && m_firstError != QGeoRouteReply::NoError) {
+        setError(m_firstError, m_firstErrorString);
+        return;
+    }
+    setMatrix(m_matrix);
+    setFinished(true);
+}
+
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoRouteBatchReplyPipelined::QGeoRouteBatchReplyPipelined(QGeoRoutingManagerEngine *engine,
+                                                           const QList<QGeoRouteRequest> &requests,
+                                                           QObject *parent)
+    : QGeoRouteBatchReply(requests, parent)
+{
+    m_pipeline = new QGeoRoutePipeline(engine, requests, this);
+    connect(m_pipeline, &QGeoRoutePipeline::routeFinished,
+            this, &QGeoRouteBatchReplyPipelined::routeFinished);
+    connect(m_pipeline, &QGeoRoutePipeline::allFinished, this, [this]() {
+        setFinished(true);
+    });
+    QMetaObject::invokeMethod(m_pipeline, &QGeoRoutePipeline::start, Qt::QueuedConnection);
+}
+
+void QGeoRouteBatchReplyPipelined::abort()
+{
+    m_pipeline->abort();
+    QGeoRouteBatchReply::abort();
+}
+
+void QGeoRouteBatchReplyPipelined::routeFinished(qsizetype index, QGeoRouteReply *reply)
+{
+    if (reply->error() != QGeoRouteReply::NoError)
+        setRequestError(index, reply->error(), reply->errorString());
+    else
+        setRoutes(index, reply->routes());
+}
+
+QT_END_NAMESPACE
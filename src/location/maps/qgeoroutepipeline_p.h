@@ -0,0 +1,108 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEPIPELINE_P_H
+#define QGEOROUTEPIPELINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/QGeoRouteBatchReply>
+#include <QtLocation/QGeoRouteMatrixReply>
+#include <QtLocation/QGeoRouteRequest>
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRoutingManagerEngine;
+
+// Runs a list of route requests through QGeoRoutingManagerEngine::calculateRoute(),
+// keeping a bounded number of them in flight and issuing the next request as
+// soon as one finishes.
+class Q_LOCATION_EXPORT QGeoRoutePipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Matches the number of connections QNetworkAccessManager opens per host
+    static constexpr qsizetype MaximumInFlight = 6;
+
+    QGeoRoutePipeline(QGeoRoutingManagerEngine *engine, const QList<QGeoRouteRequest> &requests,
+                      QObject *parent = nullptr);
+    ~QGeoRoutePipeline();
+
+    void start();
+    void abort();
+
+Q_SIGNALS:
+    void routeFinished(qsizetype index, QGeoRouteReply *reply);
+    void allFinished();
+
+private:
+    void issue();
+    void replyFinished(QGeoRouteReply *reply);
+    void release(QGeoRouteReply *reply);
+
+    QPointer<QGeoRoutingManagerEngine> m_engine;
+    QList<QGeoRouteRequest> m_requests;
+    QHash<QGeoRouteReply *, qsizetype> m_inFlight;
+    qsizetype m_next = 0;
+    bool m_issuing = false;
+    bool m_aborted = false;
+};
+
+class Q_LOCATION_EXPORT QGeoRouteMatrixReplyPipelined : public QGeoRouteMatrixReply
+{
+    Q_OBJECT
+
+public:
+    QGeoRouteMatrixReplyPipelined(QGeoRoutingManagerEngine *engine,
+                                  const QList<QGeoCoordinate> &sources,
+                                  const QList<QGeoCoordinate> &destinations,
+                                  const QGeoRouteRequest &request, QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    void routeFinished(qsizetype index, QGeoRouteReply *reply);
+    void allFinished();
+
+    QGeoRoutePipeline *m_pipeline = nullptr;
+    QGeoRouteMatrix m_matrix;
+    QList<qsizetype> m_cells;
+    bool m_reachable = false;
+    QGeoRouteReply::Error m_firstError = QGeoRouteReply::NoError;
+    QString m_firstErrorString;
+};
+
+class Q_LOCATION_EXPORT QGeoRouteBatchReplyPipelined : public QGeoRouteBatchReply
+{
+    Q_OBJECT
+
+public:
+    QGeoRouteBatchReplyPipelined(QGeoRoutingManagerEngine *engine,
+                                 const QList<QGeoRouteRequest> &requests,
+                                 QObject *parent = nullptr);
+
+    void abort() override;
+
+private:
+    void routeFinished(qsizetype index, QGeoRouteReply *reply);
+
+    QGeoRoutePipeline *m_pipeline = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEPIPELINE_P_H
@@ -4,6 +4,8 @@
 #include "qgeoroutereply.h"
 #include "qgeoroutereply_p.h"
 
+#include <QtCore/QTimer>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -34,6 +36,10 @@ QT_BEGIN_NAMESPACE
 
     If the operation completes successfully the results will be able to be
     accessed with routes().
+
+    If the request has a \l{QGeoRouteRequest::timeout()}{timeout}, a reply
+    that has not finished in time is aborted and finishes with a
+    CommunicationError.
 */
 
 /*!
@@ -58,11 +64,24 @@ QT_BEGIN_NAMESPACE
 
 /*!
     Constructs a route reply object based on \a request, with the specified \a parent.
+
+    If the \a request has a timeout, the reply is aborted once it has passed.
 */
 QGeoRouteReply::QGeoRouteReply(const QGeoRouteRequest &request, QObject *parent)
     : QObject(parent),
       d_ptr(new QGeoRouteReplyPrivate(request))
 {
+    if (request.timeout() > 0) {
+        QTimer::singleShot(request.timeout(), this, [this]() {
+            if (d_ptr->isFinished)
+                return;
+            setError(CommunicationError, tr("The route calculation timed out."));
+            // The backend may report the abort, or results that arrive
+            // meanwhile, those are ignored
+            d_ptr->timedOut = true;
+            abort();
+        });
+    }
 }
 
 /*!
@@ -92,6 +111,8 @@ QGeoRouteReply::~QGeoRouteReply()
 */
 void QGeoRouteReply::setFinished(bool finished)
 {
+    if (d_ptr->timedOut)
+        return;
     d_ptr->isFinished = finished;
     if (d_ptr->isFinished)
         emit this->finished();
@@ -115,6 +136,8 @@ bool QGeoRouteReply::isFinished() const
 */
 void QGeoRouteReply::setError(QGeoRouteReply::Error error, const QString &errorString)
 {
+    if (d_ptr->timedOut)
+        return;
     d_ptr->error = error;
     d_ptr->errorString = errorString;
     emit errorOccurred(error, errorString);
@@ -33,6 +33,7 @@ public:
     QGeoRouteReply::Error error = QGeoRouteReply::NoError;
     QString errorString;
     bool isFinished = false;
+    bool timedOut = false;
 
     QGeoRouteRequest request;
     QList<QGeoRoute> routes;
@@ -184,6 +184,25 @@ QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QGeoRouteRequestPrivate)
         include QGeoManeuver::instructionText().
 */
 
+/*!
+    \enum QGeoRouteRequest::Priority
+    \since 6.9
+
+    Defines how urgently the backend should handle the request, relative to
+    the other requests of the application.
+
+    \value LowPriority
+        The request is handled after the other requests, for example when
+        prefetching routes.
+
+    \value NormalPriority
+        The request is handled in the order in which it was made.
+
+    \value HighPriority
+        The request is handled before the other requests, for example when
+        the user is waiting for the route.
+*/
+
 /*!
     Constructs a request to calculate a route through the coordinates \a waypoints.
 
@@ -443,6 +462,59 @@ QDateTime QGeoRouteRequest::departureTime() const
     return d_ptr->departureTime;
 }
 
+/*!
+    Sets the time in milliseconds that the route calculation may take to
+    \a msecs.
+
+    If the QGeoRouteReply has not finished once the time has passed, it is
+    aborted and finishes with a QGeoRouteReply::CommunicationError. Any
+    results that arrive later are discarded.
+
+    The default value is 0, which means that the calculation never times out.
+
+    \since 6.9
+*/
+void QGeoRouteRequest::setTimeout(int msecs)
+{
+    d_ptr->timeout = qMax(0, msecs);
+}
+
+/*!
+    Returns the time in milliseconds that the route calculation may take.
+
+    \since 6.9
+*/
+int QGeoRouteRequest::timeout() const
+{
+    return d_ptr->timeout;
+}
+
+/*!
+    Sets the priority of the request to \a priority.
+
+    Backends that send the request over the network pass the priority on to
+    the network request. It does not affect the requests of other
+    applications.
+
+    The default value is QGeoRouteRequest::NormalPriority.
+
+    \since 6.9
+*/
+void QGeoRouteRequest::setPriority(QGeoRouteRequest::Priority priority)
+{
+    d_ptr->priority = priority;
+}
+
+/*!
+    Returns the priority of the request.
+
+    \since 6.9
+*/
+QGeoRouteRequest::Priority QGeoRouteRequest::priority() const
+{
+    return d_ptr->priority;
+}
+
 /*******************************************************************************
 *******************************************************************************/
 
@@ -455,7 +527,9 @@ bool QGeoRouteRequestPrivate::operator==(const QGeoRouteRequestPrivate &other) c
             && (featureWeights == other.featureWeights)
             && (routeOptimization == other.routeOptimization)
             && (segmentDetail == other.segmentDetail)
-            && (maneuverDetail == other.maneuverDetail));
+            && (maneuverDetail == other.maneuverDetail)
+            && (timeout == other.timeout)
+            && (priority == other.priority));
 }
 
 QT_END_NAMESPACE
@@ -72,6 +72,12 @@ public:
     };
     Q_DECLARE_FLAGS(ManeuverDetails, ManeuverDetail)
 
+    enum Priority {
+        LowPriority,
+        NormalPriority,
+        HighPriority
+    };
+
     explicit QGeoRouteRequest(const QList<QGeoCoordinate> &waypoints = QList<QGeoCoordinate>());
     QGeoRouteRequest(const QGeoCoordinate &origin,
                      const QGeoCoordinate &destination);
@@ -130,6 +136,14 @@ public:
     void setDepartureTime(const QDateTime &departureTime);
     QDateTime departureTime() const;
 
+    // defaults to 0, no timeout
+    void setTimeout(int msecs);
+    int timeout() const;
+
+    // defaults to NormalPriority
+    void setPriority(Priority priority);
+    Priority priority() const;
+
 private:
     QExplicitlySharedDataPointer<QGeoRouteRequestPrivate> d_ptr;
 
@@ -30,6 +30,21 @@ class QGeoRouteRequestPrivate : public QSharedData
 public:
     bool operator==(const QGeoRouteRequestPrivate &other) const;
 
+    // Maps priority onto the priority enum of a network request type such as
+    // QNetworkRequest. A template, so that QtLocation does not link QtNetwork.
+    template <typename NetworkRequest>
+    static typename NetworkRequest::Priority networkPriority(QGeoRouteRequest::Priority priority)
+    {
+        switch (priority) {
+        case QGeoRouteRequest::LowPriority:
+            return NetworkRequest::LowPriority;
+        case QGeoRouteRequest::HighPriority:
+            return NetworkRequest::HighPriority;
+        default:
+            return NetworkRequest::NormalPriority;
+        }
+    }
+
     QList<QGeoCoordinate> waypoints;
     QList<QGeoRectangle> excludeAreas;
     int numberAlternativeRoutes = 0;
@@ -40,6 +55,8 @@ public:
     QGeoRouteRequest::SegmentDetail segmentDetail = QGeoRouteRequest::BasicSegmentData;
     QGeoRouteRequest::ManeuverDetail maneuverDetail = QGeoRouteRequest::BasicManeuvers;
     QDateTime departureTime;
+    int timeout = 0;
+    QGeoRouteRequest::Priority priority = QGeoRouteRequest::NormalPriority;
 };
 
 QT_END_NAMESPACE
@@ -4,6 +4,8 @@
 #include "qgeoroutingmanager.h"
 #include "qgeoroutingmanager_p.h"
 #include "qgeoroutingmanagerengine.h"
+#include "qgeoroutingmanagerengine_p.h"
+#include "qgeoroutepipeline_p.h"
 
 #include <QLocale>
 
@@ -59,11 +61,23 @@ QGeoRoutingManager::QGeoRoutingManager(QGeoRoutingManagerEngine *engine, QObject
     if (d_ptr->engine) {
         d_ptr->engine->setParent(this);
 
+        // Route replies issued on behalf of a batch or matrix reply are
+        // reported through that reply only
+        const QGeoRoutingManagerEnginePrivate *engine_p =
+                QGeoRoutingManagerEnginePrivate::get(d_ptr->engine.get());
+
         connect(d_ptr->engine.get(), &QGeoRoutingManagerEngine::finished,
-                this, &QGeoRoutingManager::finished);
+                this, [this, engine_p](QGeoRouteReply *reply) {
+            if (!engine_p->pipelinedReplies.contains(reply))
+                emit finished(reply);
+        });
 
         connect(d_ptr->engine.get(), &QGeoRoutingManagerEngine::errorOccurred,
-                this, &QGeoRoutingManager::errorOccurred);
+                this, [this, engine_p](QGeoRouteReply *reply, QGeoRouteReply::Error error,
+                                       const QString &errorString) {
+            if (!engine_p->pipelinedReplies.contains(reply))
+                emit errorOccurred(reply, error, errorString);
+        });
     } else {
         qFatal("The routing manager engine that was set for this routing manager was NULL.");
     }
@@ -159,6 +173,68 @@ QGeoRouteReply *QGeoRoutingManager::updateRoute(const QGeoRoute &route, const QG
     return d_ptr->engine->updateRoute(route, position);
 }
 
+/*!
+    \since 6.9
+
+    Begins the calculation of the travel times and distances from each of
+    \a sources to each of \a destinations, using the travel mode, feature
+    weights and other options of \a request. The waypoints of \a request are
+    ignored.
+
+    A QGeoRouteMatrixReply object will be returned, whose
+    QGeoRouteMatrixReply::matrix() has one row per source and one column per
+    destination once the operation has completed. This is considerably faster
+    than calculating the routes one by one with calculateRoute() when the
+    service provider has a matrix service. Otherwise the routes are calculated
+    one by one, with several of them in flight at the same time. These route
+    replies are deleted by the matrix reply, and are not reported through
+    finished() or errorOccurred(). A pair whose route fails is unreachable.
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoRouteMatrixReply::finished()
+    or QGeoRouteMatrixReply::errorOccurred() with deleteLater().
+*/
+QGeoRouteMatrixReply *QGeoRoutingManager::calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                                               const QList<QGeoCoordinate> &destinations,
+                                                               const QGeoRouteRequest &request)
+{
+    QGeoRoutingManagerEngine *engine = d_ptr->engine.get();
+    if (sources.isEmpty() || destinations.isEmpty()) {
+        return new QGeoRouteMatrixReply(QGeoRouteReply::UnsupportedOptionError,
+                                        QLatin1String("A route matrix needs at least one source and one destination."),
+                                        engine);
+    }
+
+    const QGeoRoutingManagerEnginePrivate *engineData = QGeoRoutingManagerEnginePrivate::get(engine);
+    if (engineData->routeMatrix) {
+        if (QGeoRouteMatrixReply *reply = engineData->routeMatrix(sources, destinations, request))
+            return reply;
+    }
+    return new QGeoRouteMatrixReplyPipelined(engine, sources, destinations, request, engine);
+}
+
+/*!
+    \since 6.9
+
+    Begins the calculation of the routes specified by \a requests.
+
+    A QGeoRouteBatchReply object will be returned, which reports the result of
+    each request by its index in \a requests as soon as it is available. The
+    requests are passed to the service provider several at a time, so that the
+    whole batch takes a fraction of the time of issuing them one after the
+    other. The route replies of the requests are deleted by the batch reply,
+    and are not reported through finished() or errorOccurred().
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoRouteBatchReply::finished()
+    or QGeoRouteBatchReply::errorOccurred() with deleteLater().
+*/
+QGeoRouteBatchReply *QGeoRoutingManager::calculateRoutes(const QList<QGeoRouteRequest> &requests)
+{
+    QGeoRoutingManagerEngine *engine = d_ptr->engine.get();
+    return new QGeoRouteBatchReplyPipelined(engine, requests, engine);
+}
+
 /*!
     Returns the travel modes supported by this manager.
 */
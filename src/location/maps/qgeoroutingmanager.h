@@ -8,6 +8,8 @@
 #include <QtCore/QLocale>
 #include <QtLocation/QGeoRouteRequest>
 #include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteBatchReply>
+#include <QtLocation/QGeoRouteMatrixReply>
 
 QT_BEGIN_NAMESPACE
 
@@ -26,6 +28,10 @@ public:
 
     QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request);
     QGeoRouteReply *updateRoute(const QGeoRoute &route, const QGeoCoordinate &position);
+    QGeoRouteMatrixReply *calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                               const QList<QGeoCoordinate> &destinations,
+                                               const QGeoRouteRequest &request);
+    QGeoRouteBatchReply *calculateRoutes(const QList<QGeoRouteRequest> &requests);
 
     QGeoRouteRequest::TravelModes supportedTravelModes() const;
     QGeoRouteRequest::FeatureTypes supportedFeatureTypes() const;
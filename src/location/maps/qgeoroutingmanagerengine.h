@@ -61,6 +61,7 @@ private:
 
     friend class QGeoServiceProvider;
     friend class QGeoServiceProviderPrivate;
+    friend class QGeoRoutingManagerEnginePrivate;
 };
 
 QT_END_NAMESPACE
@@ -16,16 +16,28 @@
 //
 
 #include "qgeorouterequest.h"
+#include "qgeoroutingmanagerengine.h"
 
 #include <QMap>
+#include <QSet>
 #include <QLocale>
 #include <private/qglobal_p.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+class QGeoCoordinate;
+class QGeoRouteMatrixReply;
+
 class QGeoRoutingManagerEnginePrivate
 {
 public:
+    static QGeoRoutingManagerEnginePrivate *get(QGeoRoutingManagerEngine *engine)
+    {
+        return engine->d_ptr;
+    }
+
     QString managerName;
     int managerVersion = -1;
     QGeoRouteRequest::TravelModes supportedTravelModes;
@@ -37,6 +49,16 @@ public:
 
     QLocale locale;
     QLocale::MeasurementSystem measurementSystem = locale.measurementSystem();
+
+    // Route replies issued on behalf of a batch or matrix reply, which are
+    // not reported through QGeoRoutingManager
+    QSet<const QGeoRouteReply *> pipelinedReplies;
+
+    // Set by engines whose service provider calculates a whole route matrix
+    // at once. Returns nullptr to have the routes calculated one by one.
+    std::function<QGeoRouteMatrixReply *(const QList<QGeoCoordinate> &sources,
+                                         const QList<QGeoCoordinate> &destinations,
+                                         const QGeoRouteRequest &request)> routeMatrix;
 };
 
 QT_END_NAMESPACE
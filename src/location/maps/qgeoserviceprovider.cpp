@@ -14,11 +14,13 @@
 #include "qgeoroutingmanagerengine.h"
 #include "qplacemanagerengine.h"
 #include "qplacemanagerengine_p.h"
+#include "qplacemanagerenginecache_p.h"
 
 #include <QList>
 #include <QString>
 #include <QVariant>
 #include <QCborArray>
+#include <QCborMap>
 
 #include <QDebug>
 #include <QStringList>
@@ -28,6 +30,8 @@
 #include <QMetaEnum>
 #include <QtCore/private/qfactoryloader_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_GLOBAL_STATIC_WITH_ARGS(QFactoryLoader, loader,
@@ -222,39 +226,12 @@ QGeoServiceProvider::~QGeoServiceProvider()
     delete d_ptr;
 }
 
-/* Template for the routingFeatures(), geocodingFeatures() etc methods.
- * Ideally, the enumName would be a template parameter, but strings
- * are not a valid const expr. :( */
-template <class Flags>
-Flags QGeoServiceProviderPrivate::features(const char *enumName) const
-{
-    const QMetaObject *mo = &QGeoServiceProvider::staticMetaObject;
-    const QMetaEnum en = mo->enumerator(
-                mo->indexOfEnumerator(enumName));
-
-    /* We need the typename keyword here, or Flags::enum_type will be parsed
-     * as a non-type and lead to an error */
-    Flags ret = typename Flags::enum_type(0);
-    if (this->metaData.contains(QStringLiteral("Features"))
-            && this->metaData.value(QStringLiteral("Features")).isArray()) {
-        const QCborArray features = this->metaData.value(QStringLiteral("Features")).toArray();
-        for (const QCborValueConstRef v : features) {
-            int val = en.keyToValue(v.toString().toLatin1().constData());
-            if (v.isString() && val != -1) {
-                ret |= typename Flags::enum_type(val);
-            }
-        }
-    }
-
-    return ret;
-}
-
 /*!
     Returns the routing features supported by the geo service provider.
 */
 QGeoServiceProvider::RoutingFeatures QGeoServiceProvider::routingFeatures() const
 {
-    return d_ptr->features<RoutingFeatures>("RoutingFeatures");
+    return d_ptr->plugin.routingFeatures;
 }
 
 /*!
@@ -262,7 +239,7 @@ QGeoServiceProvider::RoutingFeatures QGeoServiceProvider::routingFeatures() cons
 */
 QGeoServiceProvider::GeocodingFeatures QGeoServiceProvider::geocodingFeatures() const
 {
-    return d_ptr->features<GeocodingFeatures>("GeocodingFeatures");
+    return d_ptr->plugin.geocodingFeatures;
 }
 
 /*!
@@ -270,7 +247,7 @@ QGeoServiceProvider::GeocodingFeatures QGeoServiceProvider::geocodingFeatures()
 */
 QGeoServiceProvider::MappingFeatures QGeoServiceProvider::mappingFeatures() const
 {
-    return d_ptr->features<MappingFeatures>("MappingFeatures");
+    return d_ptr->plugin.mappingFeatures;
 }
 
 /*!
@@ -278,7 +255,7 @@ QGeoServiceProvider::MappingFeatures QGeoServiceProvider::mappingFeatures() cons
 */
 QGeoServiceProvider::PlacesFeatures QGeoServiceProvider::placesFeatures() const
 {
-    return d_ptr->features<PlacesFeatures>("PlacesFeatures");
+    return d_ptr->plugin.placesFeatures;
 }
 
 /*!
@@ -288,7 +265,7 @@ QGeoServiceProvider::PlacesFeatures QGeoServiceProvider::placesFeatures() const
 */
 QGeoServiceProvider::NavigationFeatures QGeoServiceProvider::navigationFeatures() const
 {
-    return d_ptr->features<NavigationFeatures>("NavigationFeatures");
+    return d_ptr->plugin.navigationFeatures;
 }
 
 /* Sadly, these are necessary to figure out which of the factory->createX
@@ -313,7 +290,13 @@ template <> QGeoMappingManagerEngine *createEngine<QGeoMappingManagerEngine>(QGe
 }
 template <> QPlaceManagerEngine *createEngine<QPlaceManagerEngine>(QGeoServiceProviderPrivate *d_ptr)
 {
-    return d_ptr->factory->createPlaceManagerEngine(d_ptr->cleanedParameterMap, &(d_ptr->placeError), &(d_ptr->placeErrorString));
+    QPlaceManagerEngine *engine = d_ptr->factory->createPlaceManagerEngine(d_ptr->cleanedParameterMap, &(d_ptr->placeError), &(d_ptr->placeErrorString));
+    d_ptr->cachedPlaceEngine = nullptr;
+    if (engine && QPlaceManagerEngineCache::isEnabled(d_ptr->cleanedParameterMap)) {
+        d_ptr->cachedPlaceEngine = engine;
+        engine = new QPlaceManagerEngineCache(engine, d_ptr->cleanedParameterMap);
+    }
+    return engine;
 }
 
 /* Template for generating the code for each of the geocodingManager(),
@@ -343,10 +326,8 @@ Manager *QGeoServiceProviderPrivate::manager(QGeoServiceProvider::Error *_error,
                                                      // from now on the local error, errorString refs should be set.
 
         if (engine) {
-            engine->setManagerName(
-                        metaData.value(QStringLiteral("Provider")).toString());
-            engine->setManagerVersion(
-                        int(metaData.value(QStringLiteral("Version")).toDouble()));
+            engine->setManagerName(plugin.provider);
+            engine->setManagerVersion(plugin.version);
             manager = new Manager(engine);
         } else if (error == QGeoServiceProvider::NoError) {
             error = QGeoServiceProvider::NotSupportedError;
@@ -492,6 +473,7 @@ QPlaceManager *QGeoServiceProvider::placeManager() const
                 &(d_ptr->placeError), &(d_ptr->placeErrorString)));
         if (!d_ptr->placeManager)
             qDebug() << d_ptr->error << ", " << d_ptr->errorString;
+        d_ptr->setUpCachedPlaceEngine();
     }
     return d_ptr->placeManager.get();
 }
@@ -653,6 +635,14 @@ void QGeoServiceProvider::setQmlEngine(QQmlEngine *engine)
     parameters with unrelated service providers. Provider specific parameter
     keys must be prefixed with the provider name (e.g. \c here.app_id).
 
+    The provider independent \c places.cache parameter wraps the place manager
+    of any provider in a response cache. Identical searches and place details
+    requests that are in flight are then coalesced into one provider request,
+    and completed responses are reused for \c places.cache.ttl seconds
+    (300 by default). \c places.cache.memory_cost limits the number of cached
+    results held in memory, and setting \c places.cache.directory enables a
+    disk tier bounded to \c places.cache.disk_size bytes.
+
     \b {Important:} this will destroy any existing managers held by this
     service provider instance. You should be sure not to attempt to use any
     pointers that you have previously retrieved after calling this method.
@@ -689,7 +679,6 @@ void QGeoServiceProvider::setLocale(const QLocale &locale)
 
 QGeoServiceProviderPrivate::QGeoServiceProviderPrivate()
 {
-    metaData.insert(QStringLiteral("index"), -1);
 }
 
 QGeoServiceProviderPrivate::~QGeoServiceProviderPrivate()
@@ -706,8 +695,7 @@ void QGeoServiceProviderPrivate::unload()
     factory = nullptr;
     error = QGeoServiceProvider::NoError;
     errorString = QLatin1String("");
-    metaData = QCborMap();
-    metaData.insert(QStringLiteral("index"), -1);
+    plugin = PluginInfo();
 }
 
 /* Filter out any parameter that doesn't match any plugin */
@@ -731,47 +719,45 @@ void QGeoServiceProviderPrivate::filterParameterMap()
     }
 }
 
+/* The engine decorated by QPlaceManagerEngineCache is never given to a manager, so it
+ * gets the manager, name and version of the cache. This keeps e.g. QPlaceIcon::manager()
+ * working in the replies of the engine. */
+void QGeoServiceProviderPrivate::setUpCachedPlaceEngine()
+{
+    if (cachedPlaceEngine && placeManager) {
+        cachedPlaceEngine->setManagerName(plugin.provider);
+        cachedPlaceEngine->setManagerVersion(plugin.version);
+        cachedPlaceEngine->d_ptr->manager = placeManager.get();
+    }
+    cachedPlaceEngine = nullptr;
+}
+
 void QGeoServiceProviderPrivate::loadMeta()
 {
     factory = nullptr;
-    metaData = QCborMap();
-    metaData.insert(QStringLiteral("index"), -1);
+    plugin = PluginInfo();
     error = QGeoServiceProvider::NotSupportedError;
     errorString = QString(QLatin1String("The geoservices provider %1 is not supported.")).arg(providerName);
 
-    const QList<QCborMap> candidates = QGeoServiceProviderPrivate::plugins().values(providerName);
-
-    int versionFound = -1;
-    int idx = -1;
+    const QList<PluginInfo> candidates = QGeoServiceProviderPrivate::plugins().value(providerName);
 
-    // figure out which version of the plugin we want
+    // the candidates are sorted by version, take the first one we may use
     // (always latest unless experimental)
-    for (qsizetype i = 0; i < candidates.size(); ++i) {
-        QCborMap meta = candidates[i];
-        if (meta.contains(QStringLiteral("Version"))
-                && meta.value(QStringLiteral("Version")).isInteger()
-                && meta.contains(QStringLiteral("Experimental"))
-                && meta.value(QStringLiteral("Experimental")).isBool()) {
-            int ver = int(meta.value(QStringLiteral("Version")).toDouble());
-            if (ver > versionFound && !(!experimental && meta.value(QStringLiteral("Experimental")).toBool())) {
-                versionFound = ver;
-                idx = i;
-            }
+    for (const PluginInfo &candidate : candidates) {
+        if (candidate.version >= 0 && (experimental || !candidate.experimental)) {
+            error = QGeoServiceProvider::NoError;
+            errorString = QStringLiteral("");
+            plugin = candidate;
+            break;
         }
     }
-
-    if (idx != -1) {
-        error = QGeoServiceProvider::NoError;
-        errorString = QStringLiteral("");
-        metaData = candidates[idx];
-    }
 }
 
 void QGeoServiceProviderPrivate::loadPlugin(const QVariantMap &parameters)
 {
     Q_UNUSED(parameters);
 
-    if (int(metaData.value(QStringLiteral("index")).toDouble()) < 0) {
+    if (plugin.index < 0) {
         error = QGeoServiceProvider::NotSupportedError;
         errorString = QString(QLatin1String("The geoservices provider is not supported."));
         factory = nullptr;
@@ -781,10 +767,8 @@ void QGeoServiceProviderPrivate::loadPlugin(const QVariantMap &parameters)
     error = QGeoServiceProvider::NoError;
     errorString = QLatin1String("");
 
-    int idx = int(metaData.value(QStringLiteral("index")).toDouble());
-
     // load the actual plugin
-    factory = qobject_cast<QGeoServiceProviderFactory *>(loader()->instance(idx));
+    factory = qobject_cast<QGeoServiceProviderFactory *>(loader()->instance(plugin.index));
     if (!factory) {
         error = QGeoServiceProvider::LoaderError;
         errorString = QLatin1String("loader()->instance(idx) failed to return an instance. Set the environment variable QT_DEBUG_PLUGINS to see more details.");
@@ -793,29 +777,86 @@ void QGeoServiceProviderPrivate::loadPlugin(const QVariantMap &parameters)
     factory->setQmlEngine(qmlEngine);
 }
 
-QMultiHash<QString, QCborMap> QGeoServiceProviderPrivate::plugins(bool reload)
+QHash<QString, QList<QGeoServiceProviderPrivate::PluginInfo>>
+QGeoServiceProviderPrivate::plugins(bool reload)
 {
-    static QMultiHash<QString, QCborMap> plugins;
+    static QHash<QString, QList<PluginInfo>> plugins;
     static bool alreadyDiscovered = false;
 
     if (reload == true)
         alreadyDiscovered = false;
 
     if (!alreadyDiscovered) {
+        plugins.clear();
         loadPluginMetadata(plugins);
         alreadyDiscovered = true;
     }
     return plugins;
 }
 
-void QGeoServiceProviderPrivate::loadPluginMetadata(QMultiHash<QString, QCborMap> &list)
+/* Parses the names of the features in the plugin metadata. Ideally, the
+ * enumName would be a template parameter, but strings are not a valid
+ * const expr. :( */
+template <class Flags>
+static Flags parseFeatures(const QCborArray &features, const char *enumName)
+{
+    const QMetaObject *mo = &QGeoServiceProvider::staticMetaObject;
+    const QMetaEnum en = mo->enumerator(
+                mo->indexOfEnumerator(enumName));
+
+    /* We need the typename keyword here, or Flags::enum_type will be parsed
+     * as a non-type and lead to an error */
+    Flags ret = typename Flags::enum_type(0);
+    for (const QCborValueConstRef v : features) {
+        if (!v.isString())
+            continue;
+        int val = en.keyToValue(v.toString().toLatin1().constData());
+        if (val != -1)
+            ret |= typename Flags::enum_type(val);
+    }
+
+    return ret;
+}
+
+void QGeoServiceProviderPrivate::loadPluginMetadata(QHash<QString, QList<PluginInfo>> &list)
 {
     QFactoryLoader *l = loader();
     const QList<QPluginParsedMetaData> meta = l->metaData();
     for (qsizetype i = 0; i < meta.size(); ++i) {
-        QCborMap obj = meta.at(i).value(QtPluginMetaDataKeys::MetaData).toMap();
-        obj.insert(QStringLiteral("index"), i);
-        list.insert(obj.value(QStringLiteral("Provider")).toString(), obj);
+        const QCborMap obj = meta.at(i).value(QtPluginMetaDataKeys::MetaData).toMap();
+        PluginInfo info;
+        info.provider = obj.value(QStringLiteral("Provider")).toString();
+        info.index = int(i);
+
+        // plugins without a valid version are listed, but never loaded
+        const QCborValue version = obj.value(QStringLiteral("Version"));
+        const QCborValue experimental = obj.value(QStringLiteral("Experimental"));
+        if (version.isInteger() && experimental.isBool()) {
+            info.version = int(version.toInteger());
+            info.experimental = experimental.toBool();
+        }
+
+        const QCborArray features = obj.value(QStringLiteral("Features")).toArray();
+        info.routingFeatures = parseFeatures<QGeoServiceProvider::RoutingFeatures>(
+                    features, "RoutingFeatures");
+        info.geocodingFeatures = parseFeatures<QGeoServiceProvider::GeocodingFeatures>(
+                    features, "GeocodingFeatures");
+        info.mappingFeatures = parseFeatures<QGeoServiceProvider::MappingFeatures>(
+                    features, "MappingFeatures");
+        info.placesFeatures = parseFeatures<QGeoServiceProvider::PlacesFeatures>(
+                    features, "PlacesFeatures");
+        info.navigationFeatures = parseFeatures<QGeoServiceProvider::NavigationFeatures>(
+                    features, "NavigationFeatures");
+
+        // among plugins of the same version, the one found last is preferred
+        list[info.provider].prepend(info);
+    }
+
+    for (QList<PluginInfo> &candidates : list) {
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const PluginInfo &a, const PluginInfo &b) {
+                             return a.version > b.version;
+                         });
     }
 }
 
@@ -18,7 +18,7 @@
 #include "qgeoserviceprovider.h"
 
 #include <QHash>
-#include <QCborMap>
+#include <QList>
 #include <QLocale>
 #include <private/qglobal_p.h>
 
@@ -27,6 +27,7 @@ QT_BEGIN_NAMESPACE
 class QGeoCodingManager;
 class QGeoRoutingManager;
 class QGeoMappingManager;
+class QPlaceManagerEngine;
 
 class QGeoServiceProviderFactory;
 class QQmlEngine;
@@ -34,6 +35,20 @@ class QQmlEngine;
 class QGeoServiceProviderPrivate
 {
 public:
+    // The metadata of a plugin, parsed once when the plugins are discovered
+    struct PluginInfo
+    {
+        QString provider;
+        int index = -1;
+        int version = -1;
+        bool experimental = false;
+        QGeoServiceProvider::RoutingFeatures routingFeatures;
+        QGeoServiceProvider::GeocodingFeatures geocodingFeatures;
+        QGeoServiceProvider::MappingFeatures mappingFeatures;
+        QGeoServiceProvider::PlacesFeatures placesFeatures;
+        QGeoServiceProvider::NavigationFeatures navigationFeatures;
+    };
+
     QGeoServiceProviderPrivate();
     ~QGeoServiceProviderPrivate();
 
@@ -41,16 +56,15 @@ public:
     void loadPlugin(const QVariantMap &parameters);
     void unload();
     void filterParameterMap();
+    void setUpCachedPlaceEngine();
 
-    /* helper templates for generating the feature and manager accessors */
+    /* helper template for generating the manager accessors */
     template <class Manager, class Engine>
     Manager *manager(QGeoServiceProvider::Error *error,
                      QString *errorString);
-    template <class Flags>
-    Flags features(const char *enumName) const;
 
     QGeoServiceProviderFactory *factory = nullptr;
-    QCborMap metaData;
+    PluginInfo plugin;
 
     QVariantMap parameterMap;
     QVariantMap cleanedParameterMap;
@@ -63,6 +77,9 @@ public:
     std::unique_ptr<QPlaceManager> placeManager;
     QQmlEngine *qmlEngine = nullptr;
 
+    // The engine of the provider when it is decorated by QPlaceManagerEngineCache
+    QPlaceManagerEngine *cachedPlaceEngine = nullptr;
+
     QGeoServiceProvider::Error geocodeError = QGeoServiceProvider::NoError;
     QGeoServiceProvider::Error routingError = QGeoServiceProvider::NoError;
     QGeoServiceProvider::Error mappingError = QGeoServiceProvider::NoError;
@@ -83,8 +100,9 @@ public:
     QLocale locale;
     bool localeSet = false;
 
-    static QMultiHash<QString, QCborMap> plugins(bool reload = false);
-    static void loadPluginMetadata(QMultiHash<QString, QCborMap> &list);
+    // The plugins of each provider, the highest version first
+    static QHash<QString, QList<PluginInfo>> plugins(bool reload = false);
+    static void loadPluginMetadata(QHash<QString, QList<PluginInfo>> &list);
 };
 
 QT_END_NAMESPACE
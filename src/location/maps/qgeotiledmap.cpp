@@ -16,6 +16,10 @@
 QT_BEGIN_NAMESPACE
 #define PREFETCH_FRUSTUM_SCALE 2.0
 
+// Zoom changes closer together than this are an animation or a pinch, and
+// the zoom level has settled once it stops changing for this long
+static const int ZoomSettleTime = 150; // ms
+
 QGeoTiledMap::QGeoTiledMap(QGeoTiledMappingManagerEngine *engine, QObject *parent)
     : QGeoMap(*new QGeoTiledMapPrivate(engine), parent)
 {
@@ -29,6 +33,8 @@ QGeoTiledMap::QGeoTiledMap(QGeoTiledMappingManagerEngine *engine, QObject *paren
                      [d](const QGeoCameraCapabilities &oldCameraCapabilities) {
                        d->onCameraCapabilitiesChanged(oldCameraCapabilities);
                      });
+    QObject::connect(&d->m_zoomSettleTimer, &QTimer::timeout, this,
+                     [d]() { d->endZoomTransition(); });
 }
 
 QGeoTiledMap::QGeoTiledMap(QGeoTiledMapPrivate &dd, QGeoTiledMappingManagerEngine *engine, QObject *parent)
@@ -44,6 +50,8 @@ QGeoTiledMap::QGeoTiledMap(QGeoTiledMapPrivate &dd, QGeoTiledMappingManagerEngin
                      [d](const QGeoCameraCapabilities &oldCameraCapabilities) {
                        d->onCameraCapabilitiesChanged(oldCameraCapabilities);
                      });
+    QObject::connect(&d->m_zoomSettleTimer, &QTimer::timeout, this,
+                     [d]() { d->endZoomTransition(); });
 }
 
 QGeoTiledMap::~QGeoTiledMap()
@@ -99,11 +107,27 @@ void QGeoTiledMap::clearData()
 {
     Q_D(QGeoTiledMap);
     d->m_cache->clearAll();
+    d->m_tileRequests->clearPinnedTextures();
     d->m_mapScene->clearTexturedTiles();
     d->updateScene();
     sgNodeChanged();
 }
 
+// The tiles shown keep their textures
+void QGeoTiledMap::trimData(QAbstractGeoTileCache::TrimLevel level)
+{
+    Q_D(QGeoTiledMap);
+    if (!d->m_zoomTransition)
+        d->m_tileRequests->clearPinnedTextures();
+    d->m_cache->trim(level);
+}
+
+QGeoTileCacheStatistics QGeoTiledMap::cacheStatistics() const
+{
+    Q_D(const QGeoTiledMap);
+    return d->m_cache->statistics();
+}
+
 QGeoMap::Capabilities QGeoTiledMap::capabilities() const
 {
     return Capabilities(SupportsVisibleRegion
@@ -163,6 +187,8 @@ QGeoTiledMapPrivate::QGeoTiledMapPrivate(QGeoTiledMappingManagerEngine *engine)
     m_visibleTiles->setPluginString(pluginString);
     m_prefetchTiles->setPluginString(pluginString);
     m_mapScene->setTileSize(tileSize);
+    m_zoomSettleTimer.setSingleShot(true);
+    m_zoomSettleTimer.setInterval(ZoomSettleTime);
 }
 
 QGeoTiledMapPrivate::~QGeoTiledMapPrivate()
@@ -179,7 +205,7 @@ QGeoTiledMapPrivate::~QGeoTiledMapPrivate()
 
 void QGeoTiledMapPrivate::prefetchTiles()
 {
-    if (m_tileRequests && m_prefetchStyle != QGeoTiledMap::NoPrefetching) {
+    if (m_tileRequests && m_prefetchStyle != QGeoTiledMap::NoPrefetching && !m_zoomTransition) {
 
         QSet<QGeoTileSpec> tiles;
         QGeoCameraData camera = m_visibleTiles->cameraData();
@@ -284,6 +310,20 @@ void QGeoTiledMapPrivate::changeCameraData(const QGeoCameraData &cameraData)
         cam.setZoomLevel(izl);
     }
 
+    // Zoom changes in quick succession come from an animation or a pinch.
+    // Until the zoom settles, the levels it crosses are neither fetched nor
+    // decoded, see QGeoTileRequestManager::beginZoomTransition().
+    const double oldZoomLevel = m_visibleTiles->cameraData().zoomLevel();
+    if (cam.zoomLevel() != oldZoomLevel) {
+        if (m_zoomTransition) {
+            m_zoomSettleTimer.start();
+        } else if (m_lastZoomChange.isValid() && !m_lastZoomChange.hasExpired(ZoomSettleTime)
+                   && std::floor(cam.zoomLevel()) != std::floor(oldZoomLevel)) {
+            beginZoomTransition();
+        }
+        m_lastZoomChange.start();
+    }
+
     m_visibleTiles->setCameraData(cam);
     m_mapScene->setCameraData(cam);
 
@@ -313,6 +353,24 @@ void QGeoTiledMapPrivate::updateScene()
         emit q->sgNodeChanged();
 }
 
+void QGeoTiledMapPrivate::beginZoomTransition()
+{
+    m_zoomTransition = true;
+    m_zoomSettleTimer.start();
+    // The textures of the level the zoom starts from
+    m_tileRequests->beginZoomTransition(m_mapScene->textures());
+}
+
+void QGeoTiledMapPrivate::endZoomTransition()
+{
+    Q_Q(QGeoTiledMap);
+    m_zoomTransition = false;
+    m_tileRequests->endZoomTransition();
+    // Fetches the tiles of the level the zoom settled on
+    updateScene();
+    q->sgNodeChanged();
+}
+
 void QGeoTiledMapPrivate::setVisibleArea(const QRectF &visibleArea)
 {
     Q_Q(QGeoTiledMap);
@@ -358,6 +416,7 @@ void QGeoTiledMapPrivate::changeTileVersion(int version)
 
 void QGeoTiledMapPrivate::clearScene()
 {
+    m_tileRequests->clearPinnedTextures();
     m_mapScene->clearTexturedTiles();
     m_mapScene->setVisibleTiles(QSet<QGeoTileSpec>());
     updateScene();
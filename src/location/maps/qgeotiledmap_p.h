@@ -49,6 +49,8 @@ public:
 
     void prefetchData() override;
     void clearData() override;
+    void trimData(QAbstractGeoTileCache::TrimLevel level) override;
+    QGeoTileCacheStatistics cacheStatistics() const override;
     Capabilities capabilities() const override;
 
     void setCopyrightVisible(bool visible) override;
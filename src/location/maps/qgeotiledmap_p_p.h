@@ -14,7 +14,9 @@
 // We mean it.
 //
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
+#include <QtCore/QTimer>
 
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <QtLocation/private/qgeomap_p_p.h>
@@ -49,6 +51,7 @@ public:
     void prefetchTiles();
     QGeoMapType activeMapType() const;
     void onCameraCapabilitiesChanged(const QGeoCameraCapabilities &oldCameraCapabilities);
+    void endZoomTransition();
 
 protected:
     void changeViewportSize(const QSize& size) override;
@@ -58,6 +61,7 @@ protected:
     void clearScene();
 
     void updateScene();
+    void beginZoomTransition();
 
     void setVisibleArea(const QRectF &visibleArea) override;
     QRectF visibleArea() const override;
@@ -76,6 +80,11 @@ protected:
     int m_maxZoomLevel;
     int m_minZoomLevel;
     QGeoTiledMap::PrefetchStyle m_prefetchStyle;
+
+    // Zoom animations and pinches, see changeCameraData()
+    QTimer m_zoomSettleTimer;
+    QElapsedTimer m_lastZoomChange;
+    bool m_zoomTransition = false;
     Q_DISABLE_COPY(QGeoTiledMapPrivate)
 };
 
@@ -4,6 +4,7 @@
 #include "qgeotiledmapreply_p.h"
 #include "qgeotiledmapreply_p_p.h"
 
+#include <qdatetime.h>
 #include <qdebug.h>
 
 QT_BEGIN_NAMESPACE
@@ -200,6 +201,49 @@ void QGeoTiledMapReply::setMapImageFormat(const QString &format)
     d_ptr->mapImageFormat = format;
 }
 
+/*!
+    Returns how many milliseconds the server asked to wait before sending
+    more requests, or -1 if it did not refuse the request for being busy.
+
+    0 means that the server gave no delay, and the tile fetcher backs off
+    by itself.
+
+    \sa setRetryAfter()
+*/
+int QGeoTiledMapReply::retryAfter() const
+{
+    return d_ptr->retryAfter;
+}
+
+/*!
+    Marks the request as refused by a busy server, like HTTP status codes
+    429 (Too Many Requests) and 503 (Service Unavailable) do. \a retryAfter
+    is the value of the HTTP \c Retry-After header, either a number of
+    seconds or a date, and may be empty.
+
+    The tile fetcher then sends fewer requests at the same time, and none
+    before the delay has passed. The error still has to be set with
+    setError().
+*/
+void QGeoTiledMapReply::setRetryAfter(QByteArrayView retryAfter)
+{
+    // Never stall the map for longer than this, whatever the server says
+    constexpr qint64 maximumDelay = 5 * 60 * 1000;
+
+    qint64 delay = 0;
+    bool ok = false;
+    const qint64 seconds = retryAfter.trimmed().toLongLong(&ok);
+    if (ok) {
+        delay = seconds * 1000;
+    } else if (!retryAfter.isEmpty()) {
+        const QDateTime date = QDateTime::fromString(QString::fromLatin1(retryAfter),
+                                                     Qt::RFC2822Date);
+        if (date.isValid())
+            delay = QDateTime::currentDateTimeUtc().msecsTo(date);
+    }
+    d_ptr->retryAfter = int(qBound<qint64>(0, delay, maximumDelay));
+}
+
 /*!
     Cancels the operation immediately.
 
@@ -51,6 +51,8 @@ public:
     QByteArray mapImageData() const;
     QString mapImageFormat() const;
 
+    int retryAfter() const;
+
     virtual void abort();
 
 Q_SIGNALS:
@@ -67,6 +69,8 @@ protected:
     void setMapImageData(const QByteArray &data);
     void setMapImageFormat(const QString &format);
 
+    void setRetryAfter(QByteArrayView retryAfter);
+
 private:
     QGeoTiledMapReplyPrivate *d_ptr;
     Q_DISABLE_COPY(QGeoTiledMapReply)
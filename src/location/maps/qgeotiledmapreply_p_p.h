@@ -34,6 +34,7 @@ public:
     QGeoTileSpec spec;
     QByteArray mapImageData;
     QString mapImageFormat;
+    int retryAfter = -1;
 };
 
 QT_END_NAMESPACE
@@ -104,6 +104,12 @@ QSet<QGeoTileSpec> QGeoTiledMapScene::texturedTiles()
     return textured;
 }
 
+QList<QSharedPointer<QGeoTileTexture>> QGeoTiledMapScene::textures() const
+{
+    Q_D(const QGeoTiledMapScene);
+    return d->m_textures.values();
+}
+
 void QGeoTiledMapScene::clearTexturedTiles()
 {
     Q_D(QGeoTiledMapScene);
@@ -179,8 +185,12 @@ void QGeoTiledMapScenePrivate::addTile(const QGeoTileSpec &spec, QSharedPointer<
     if (!m_visibleTiles.contains(spec)) // Don't add the geometry if it isn't visible
         return;
 
-    if (m_textures.contains(spec))
+    const auto it = m_textures.constFind(spec);
+    if (it != m_textures.cend()) {
+        if (it.value() == texture) // e.g. the same placeholder again
+            return;
         m_updatedTextures.append(spec);
+    }
     m_textures.insert(spec, texture);
 }
 
@@ -15,6 +15,8 @@
 //
 
 #include <QObject>
+#include <QtCore/QList>
+#include <QtCore/QSharedPointer>
 #include <QtLocation/private/qlocationglobal_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -48,6 +50,7 @@ public:
     QSGNode *updateSceneGraph(QSGNode *oldNode, QQuickWindow *window);
 
     QSet<QGeoTileSpec> texturedTiles();
+    QList<QSharedPointer<QGeoTileTexture>> textures() const;
 
     void clearTexturedTiles();
 
@@ -84,6 +84,23 @@ void QGeoTileFetcher::requestNextTile()
     if (d->queue_.isEmpty())
         return;
 
+    if (!d->backoff_.hasExpired()) {
+        d->timer_.start(int(d->backoff_.remainingTime()), this);
+        d->backingOff_ = true;
+        return;
+    }
+    if (d->backingOff_) {
+        d->backingOff_ = false;
+        d->timer_.start(0, this);
+    }
+
+    // Queued tiles can still be cancelled, unlike those queued by the network
+    // stack, so only a few requests are sent ahead. finished() resumes.
+    if (d->maximumRequests_ > 0 && d->invmap_.size() >= d->requestLimit_) {
+        d->timer_.stop();
+        return;
+    }
+
     QGeoTileSpec ts = d->queue_.takeFirst();
     if (d->queue_.isEmpty())
         d->timer_.stop();
@@ -129,6 +146,9 @@ void QGeoTileFetcher::finished()
     d->invmap_.remove(spec);
 
     handleReply(reply, spec);
+
+    if (d->enabled_ && !d->queue_.isEmpty() && !d->timer_.isActive() && initialized())
+        d->timer_.start(0, this);
 }
 
 void QGeoTileFetcher::timerEvent(QTimerEvent *event)
@@ -159,6 +179,24 @@ bool QGeoTileFetcher::fetchingEnabled() const
     return true;
 }
 
+// Limits the number of tile requests in flight to count, 0 meaning no limit.
+// The limit is lowered while the servers refuse requests, and grows back to
+// count as requests succeed again.
+void QGeoTileFetcher::setMaximumConcurrentRequests(int count)
+{
+    Q_D(QGeoTileFetcher);
+    QMutexLocker ml(&d->queueMutex_);
+    d->maximumRequests_ = qMax(0, count);
+    d->requestLimit_ = d->maximumRequests_;
+    d->successes_ = 0;
+}
+
+int QGeoTileFetcher::maximumConcurrentRequests() const
+{
+    Q_D(const QGeoTileFetcher);
+    return d->maximumRequests_;
+}
+
 void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &spec)
 {
     Q_D(QGeoTileFetcher);
@@ -169,8 +207,11 @@ void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &
     }
 
     if (reply->error() == QGeoTiledMapReply::NoError) {
+        d->requestSucceeded();
         emit tileFinished(spec, reply->mapImageData(), reply->mapImageFormat());
     } else {
+        if (reply->retryAfter() >= 0)
+            d->requestThrottled(reply->retryAfter());
         emit tileError(spec, reply->errorString());
     }
 
@@ -180,4 +221,29 @@ void QGeoTileFetcher::handleReply(QGeoTiledMapReply *reply, const QGeoTileSpec &
 /*******************************************************************************
 *******************************************************************************/
 
+void QGeoTileFetcherPrivate::requestSucceeded()
+{
+    throttled_ = 0;
+    // One more request in flight after each round of successful ones
+    if (requestLimit_ < maximumRequests_ && ++successes_ >= requestLimit_) {
+        ++requestLimit_;
+        successes_ = 0;
+    }
+}
+
+void QGeoTileFetcherPrivate::requestThrottled(int retryAfter)
+{
+    // The replies of the requests sent together are throttled together,
+    // the first one is enough to halve the limit.
+    if (backoff_.hasExpired())
+        requestLimit_ = qMax(1, requestLimit_ / 2);
+    successes_ = 0;
+
+    // Without a delay from the server, back off exponentially up to a minute
+    const int delay = retryAfter > 0 ? retryAfter : qMin(500 << qMin(throttled_, 7), 60000);
+    ++throttled_;
+    if (backoff_.remainingTime() < delay)
+        backoff_.setRemainingTime(delay);
+}
+
 QT_END_NAMESPACE
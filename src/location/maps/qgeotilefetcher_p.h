@@ -56,6 +56,9 @@ protected:
     virtual bool initialized() const;
     virtual bool fetchingEnabled() const;
 
+    void setMaximumConcurrentRequests(int count);
+    int maximumConcurrentRequests() const;
+
 private:
 
     virtual QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) = 0;
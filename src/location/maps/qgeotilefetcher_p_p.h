@@ -26,6 +26,7 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QHash>
+#include <QDeadlineTimer>
 #include "qgeomaptype_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -38,12 +39,24 @@ class Q_LOCATION_EXPORT QGeoTileFetcherPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QGeoTileFetcher)
 public:
+    void requestSucceeded();
+    void requestThrottled(int retryAfter);
+
     QBasicTimer timer_;
     QMutex queueMutex_;
     QList<QGeoTileSpec> queue_;
     QHash<QGeoTileSpec, QGeoTiledMapReply *> invmap_;
     QGeoMappingManagerEngine *engine_ = nullptr;
     bool enabled_ = false;
+
+    // Requests in flight, see QGeoTileFetcher::setMaximumConcurrentRequests()
+    int maximumRequests_ = 0;
+    int requestLimit_ = 0;
+    int successes_ = 0;
+    // Set when servers are busy, see QGeoTiledMapReply::retryAfter()
+    QDeadlineTimer backoff_;
+    int throttled_ = 0;
+    bool backingOff_ = false;
 };
 
 QT_END_NAMESPACE
@@ -8,6 +8,7 @@
 
 #include <QtCore/QPointer>
 #include <QtCore/QTimer>
+#include <QtGui/QPainter>
 
 QT_BEGIN_NAMESPACE
 
@@ -24,11 +25,20 @@ public:
 
     QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > requestTiles(const QSet<QGeoTileSpec> &tiles);
     void tileError(const QGeoTileSpec &tile, const QString &errorString);
+    QSharedPointer<QGeoTileTexture> pinnedTexture(const QGeoTileSpec &tile, int levels) const;
+    QSharedPointer<QGeoTileTexture> pinnedDescendantsTexture(const QGeoTileSpec &tile, int levels);
+    void releasePinnedTextures();
 
     QHash<QGeoTileSpec, int> m_retries;
     QHash<QGeoTileSpec, QSharedPointer<RetryFuture> > m_futures;
     QSet<QGeoTileSpec> m_requested;
 
+    // Zoom transitions: the textures on screen when the zoom started to
+    // change, and the tiles that were given one of them meanwhile
+    QHash<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > m_pinned;
+    QSet<QGeoTileSpec> m_transitionTiles;
+    bool m_zoomTransition = false;
+
     void tileFetched(const QGeoTileSpec &spec);
 };
 
@@ -66,6 +76,33 @@ void QGeoTileRequestManager::tileError(const QGeoTileSpec &tile, const QString &
     d_ptr->tileError(tile, errorString);
 }
 
+// While the zoom level changes, the tiles of the levels it goes through are
+// neither fetched nor decoded. The tiles still in the texture cache, else the
+// parts of the pinned textures covering them, are shown instead. Zooming out,
+// the pinned textures are drawn scaled down into the tiles above them.
+void QGeoTileRequestManager::beginZoomTransition(const QList<QSharedPointer<QGeoTileTexture>> &pinned)
+{
+    d_ptr->m_pinned.clear();
+    for (const QSharedPointer<QGeoTileTexture> &texture : pinned) {
+        if (texture && !texture->image.isNull())
+            d_ptr->m_pinned.insert(texture->spec, texture);
+    }
+    d_ptr->m_zoomTransition = true;
+}
+
+// The tiles are requested again by the next requestTiles(). The pinned
+// textures stay, as placeholders until the tiles of the new level arrive.
+void QGeoTileRequestManager::endZoomTransition()
+{
+    d_ptr->m_zoomTransition = false;
+    d_ptr->m_transitionTiles.clear();
+}
+
+void QGeoTileRequestManager::clearPinnedTextures()
+{
+    d_ptr->m_pinned.clear();
+}
+
 QGeoTileRequestManagerPrivate::QGeoTileRequestManagerPrivate(QGeoTiledMap *map,QGeoTiledMappingManagerEngine *engine)
     : m_map(map),
       m_engine(engine)
@@ -76,9 +113,114 @@ QGeoTileRequestManagerPrivate::~QGeoTileRequestManagerPrivate()
 {
 }
 
+QSharedPointer<QGeoTileTexture> QGeoTileRequestManagerPrivate::pinnedTexture(const QGeoTileSpec &tile, int levels) const
+{
+    if (m_pinned.isEmpty())
+        return QSharedPointer<QGeoTileTexture>();
+
+    QGeoTileSpec spec = tile;
+    const int endRange = qMax(0, tile.zoom() - levels);
+    for (int z = tile.zoom(); z >= endRange; z--) {
+        const int denominator = 1 << (tile.zoom() - z);
+        spec.setZoom(z);
+        spec.setX(tile.x() / denominator);
+        spec.setY(tile.y() / denominator);
+        const auto it = m_pinned.constFind(spec);
+        if (it != m_pinned.cend())
+            return it.value();
+    }
+    return QSharedPointer<QGeoTileTexture>();
+}
+
+// Draws the pinned textures of the descendants of tile, up to levels below it,
+// into a texture for tile. Descendants that are not pinned are left
+// transparent. The texture is pinned in turn, so that zooming out further
+// draws from it, and it stays until the tile itself has arrived.
+QSharedPointer<QGeoTileTexture> QGeoTileRequestManagerPrivate::pinnedDescendantsTexture(const QGeoTileSpec &tile, int levels)
+{
+    if (m_pinned.isEmpty())
+        return QSharedPointer<QGeoTileTexture>();
+
+    for (int level = 1; level <= levels; ++level) {
+        const int tilesPerSide = 1 << level;
+        QList<std::pair<QPoint, QSharedPointer<QGeoTileTexture>>> parts;
+        QGeoTileSpec spec = tile;
+        spec.setZoom(tile.zoom() + level);
+        for (int y = 0; y < tilesPerSide; ++y) {
+            for (int x = 0; x < tilesPerSide; ++x) {
+                spec.setX(tile.x() * tilesPerSide + x);
+                spec.setY(tile.y() * tilesPerSide + y);
+                const auto it = m_pinned.constFind(spec);
+                if (it != m_pinned.cend() && !it.value()->image.isNull())
+                    parts.append({ QPoint(x, y), it.value() });
+            }
+        }
+        if (parts.isEmpty())
+            continue;
+
+        const QSize size = parts.first().second->image.size();
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        const QSizeF partSize = QSizeF(size) / tilesPerSide;
+        for (const auto &part : std::as_const(parts)) {
+            const QPointF origin(part.first.x() * partSize.width(),
+                                 part.first.y() * partSize.height());
+            painter.drawImage(QRectF(origin, partSize), part.second->image);
+        }
+        painter.end();
+
+        QSharedPointer<QGeoTileTexture> texture = QSharedPointer<QGeoTileTexture>::create();
+        texture->spec = tile;
+        texture->image = image;
+        m_pinned.insert(tile, texture);
+        return texture;
+    }
+    return QSharedPointer<QGeoTileTexture>();
+}
+
+// Once the tiles requested after a zoom transition have all arrived, or
+// have been given up on, nothing needs the pinned textures any more
+void QGeoTileRequestManagerPrivate::releasePinnedTextures()
+{
+    if (!m_zoomTransition && m_requested.isEmpty())
+        m_pinned.clear();
+}
+
 QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > QGeoTileRequestManagerPrivate::requestTiles(const QSet<QGeoTileSpec> &tiles)
 {
     QSet<QGeoTileSpec> cancelTiles = m_requested - tiles;
+
+    if (m_zoomTransition) {
+        QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > pinnedTex;
+        m_transitionTiles &= tiles;
+        for (const QGeoTileSpec &tile : tiles) {
+            if (m_requested.contains(tile) || m_transitionTiles.contains(tile))
+                continue;
+            m_transitionTiles.insert(tile);
+            QSharedPointer<QGeoTileTexture> t;
+            if (!m_engine.isNull())
+                t = m_engine->tileCache()->getTexture(tile);
+            // Any level up, a blurry tile is better than a hole
+            if (!t)
+                t = pinnedTexture(tile, tile.zoom());
+            if (!t)
+                t = pinnedDescendantsTexture(tile, 2);
+            if (t)
+                pinnedTex.insert(tile, t);
+        }
+        if (!cancelTiles.isEmpty() && !m_engine.isNull()) {
+            m_requested -= cancelTiles;
+            m_engine->updateTileRequests(m_map, QSet<QGeoTileSpec>(), cancelTiles);
+            for (const QGeoTileSpec &tile : std::as_const(cancelTiles)) {
+                m_retries.remove(tile);
+                m_futures.remove(tile);
+            }
+        }
+        return pinnedTex;
+    }
+
     QSet<QGeoTileSpec> requestTiles = tiles - m_requested;
     QSet<QGeoTileSpec> cached;
 //    int tileSize = tiles.size();
@@ -99,6 +241,14 @@ QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > QGeoTileRequestManagerPriva
                 if (!tex->image.isNull())
                     cachedTex.insert(tile, tex);
                 cached.insert(tile);
+            } else if (QSharedPointer<QGeoTileTexture> t = pinnedTexture(tile, 4)) {
+                // Still pinned since the last zoom transition, which saves
+                // decoding the tiles above
+                cachedTex.insert(tile, t);
+            } else if (QSharedPointer<QGeoTileTexture> t = pinnedDescendantsTexture(tile, 2)) {
+                // The transition zoomed out, the tiles it started from stand
+                // in until the tile arrives
+                cachedTex.insert(tile, t);
             } else {
                 // Try to use textures from lower zoom levels, but still request the proper tile
                 QGeoTileSpec spec = tile;
@@ -141,6 +291,7 @@ QMap<QGeoTileSpec, QSharedPointer<QGeoTileTexture> > QGeoTileRequestManagerPriva
         }
     }
 
+    releasePinnedTextures();
     return cachedTex;
 }
 
@@ -150,6 +301,7 @@ void QGeoTileRequestManagerPrivate::tileFetched(const QGeoTileSpec &spec)
     m_requested.remove(spec);
     m_retries.remove(spec);
     m_futures.remove(spec);
+    releasePinnedTextures();
 }
 
 // Represents a tile that needs to be retried after a certain period of time
@@ -194,6 +346,7 @@ void QGeoTileRequestManagerPrivate::tileError(const QGeoTileSpec &tile, const QS
             m_requested.remove(tile);
             m_retries.remove(tile);
             m_futures.remove(tile);
+            releasePinnedTextures();
 
         } else {
             // Exponential time backoff when retrying
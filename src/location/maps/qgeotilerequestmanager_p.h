@@ -38,6 +38,10 @@ public:
     void tileFetched(const QGeoTileSpec &spec);
     QSharedPointer<QGeoTileTexture> tileTexture(const QGeoTileSpec &spec);
 
+    void beginZoomTransition(const QList<QSharedPointer<QGeoTileTexture>> &pinned);
+    void endZoomTransition();
+    void clearPinnedTextures();
+
 private:
     std::unique_ptr<QGeoTileRequestManagerPrivate> d_ptr;
     Q_DISABLE_COPY(QGeoTileRequestManager)
@@ -0,0 +1,295 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeovectortile_p.h"
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+enum WireType {
+    VarintType = 0,
+    Fixed64Type = 1,
+    BytesType = 2,
+    Fixed32Type = 5
+};
+
+enum Command {
+    MoveTo = 1,
+    LineTo = 2,
+    ClosePath = 7
+};
+
+// Reads a protocol buffer without copying it, length delimited fields are
+// returned as views on the buffer. Once an error is met, atEnd() is true.
+class ProtobufReader
+{
+public:
+    explicit ProtobufReader(QByteArrayView data)
+        : m_data(reinterpret_cast<const uchar *>(data.data())), m_end(m_data + data.size())
+    {
+    }
+
+    bool atEnd() const { return m_error || m_data >= m_end; }
+    bool hasError() const { return m_error; }
+
+    // Reads the key of the next field
+    bool next()
+    {
+        if (atEnd())
+            return false;
+        const quint64 key = varint();
+        m_field = quint32(key >> 3);
+        m_wireType = int(key & 7);
+        return !m_error;
+    }
+    quint32 field() const { return m_field; }
+    bool is(quint32 field, WireType wireType) const
+    {
+        return m_field == field && m_wireType == wireType;
+    }
+
+    quint64 varint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64 && m_data < m_end; shift += 7) {
+            const uchar byte = *m_data++;
+            value |= quint64(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        m_error = true;
+        return 0;
+    }
+
+    QByteArrayView bytes()
+    {
+        const quint64 size = varint();
+        if (m_error || size > quint64(m_end - m_data)) {
+            m_error = true;
+            return QByteArrayView();
+        }
+        const QByteArrayView view(reinterpret_cast<const char *>(m_data), qsizetype(size));
+        m_data += size;
+        return view;
+    }
+
+    quint32 fixed32()
+    {
+        if (m_end - m_data < 4) {
+            m_error = true;
+            return 0;
+        }
+        const quint32 value = qFromLittleEndian<quint32>(m_data);
+        m_data += 4;
+        return value;
+    }
+
+    quint64 fixed64()
+    {
+        if (m_end - m_data < 8) {
+            m_error = true;
+            return 0;
+        }
+        const quint64 value = qFromLittleEndian<quint64>(m_data);
+        m_data += 8;
+        return value;
+    }
+
+    void skip()
+    {
+        switch (m_wireType) {
+        case VarintType:
+            varint();
+            break;
+        case Fixed64Type:
+            fixed64();
+            break;
+        case BytesType:
+            bytes();
+            break;
+        case Fixed32Type:
+            fixed32();
+            break;
+        default:
+            m_error = true;
+            break;
+        }
+    }
+
+private:
+    const uchar *m_data;
+    const uchar *m_end;
+    quint32 m_field = 0;
+    int m_wireType = 0;
+    bool m_error = false;
+};
+
+qint64 zigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+QGeoVectorTile::Value readValue(QByteArrayView data, bool *ok)
+{
+    QGeoVectorTile::Value value;
+    ProtobufReader reader(data);
+    while (reader.next()) {
+        if (reader.is(1, BytesType)) {
+            value.string = reader.bytes();
+            value.isString = true;
+        } else if (reader.is(2, Fixed32Type)) {
+            const quint32 bits = reader.fixed32();
+            float number;
+            std::memcpy(&number, &bits, sizeof(number));
+            value.number = number;
+        } else if (reader.is(3, Fixed64Type)) {
+            const quint64 bits = reader.fixed64();
+            std::memcpy(&value.number, &bits, sizeof(value.number));
+        } else if (reader.is(4, VarintType)) {
+            value.number = double(qint64(reader.varint()));
+        } else if (reader.is(5, VarintType)) {
+            value.number = double(reader.varint());
+        } else if (reader.is(6, VarintType)) {
+            value.number = double(zigzag(reader.varint()));
+        } else if (reader.is(7, VarintType)) {
+            value.number = reader.varint() ? 1 : 0;
+        } else {
+            reader.skip();
+        }
+    }
+    *ok = !reader.hasError();
+    return value;
+}
+
+bool readFeature(QByteArrayView data, QGeoVectorTile::Feature *feature)
+{
+    ProtobufReader reader(data);
+    while (reader.next()) {
+        if (reader.is(1, VarintType)) {
+            feature->id = reader.varint();
+        } else if (reader.is(2, BytesType)) {
+            feature->tags = reader.bytes();
+        } else if (reader.is(3, VarintType)) {
+            const quint64 type = reader.varint();
+            if (type <= QGeoVectorTile::Polygon)
+                feature->type = QGeoVectorTile::GeometryType(type);
+        } else if (reader.is(4, BytesType)) {
+            feature->geometry = reader.bytes();
+        } else {
+            reader.skip();
+        }
+    }
+    return !reader.hasError();
+}
+
+bool readLayer(QByteArrayView data, QGeoVectorTile::Layer *layer)
+{
+    ProtobufReader reader(data);
+    while (reader.next()) {
+        if (reader.is(1, BytesType)) {
+            layer->name = reader.bytes();
+        } else if (reader.is(2, BytesType)) {
+            QGeoVectorTile::Feature feature;
+            if (!readFeature(reader.bytes(), &feature))
+                return false;
+            layer->features.append(feature);
+        } else if (reader.is(3, BytesType)) {
+            layer->keys.append(reader.bytes());
+        } else if (reader.is(4, BytesType)) {
+            bool ok = false;
+            layer->values.append(readValue(reader.bytes(), &ok));
+            if (!ok)
+                return false;
+        } else if (reader.is(5, VarintType)) {
+            layer->extent = quint32(reader.varint());
+        } else {
+            reader.skip();
+        }
+    }
+    return !reader.hasError() && layer->extent > 0;
+}
+}
+
+QGeoVectorTile QGeoVectorTile::fromData(const QByteArray &data)
+{
+    QGeoVectorTile tile;
+    // The views point into the buffer shared with m_data
+    tile.m_data = data;
+    ProtobufReader reader(tile.m_data);
+    while (reader.next()) {
+        if (reader.is(3, BytesType)) {
+            Layer layer;
+            if (!readLayer(reader.bytes(), &layer))
+                return QGeoVectorTile();
+            tile.m_layers.append(layer);
+        } else {
+            reader.skip();
+        }
+    }
+    if (reader.hasError())
+        return QGeoVectorTile();
+    tile.m_valid = true;
+    return tile;
+}
+
+const QGeoVectorTile::Layer *QGeoVectorTile::layer(QByteArrayView name) const
+{
+    for (const Layer &layer : m_layers) {
+        if (layer.name == name)
+            return &layer;
+    }
+    return nullptr;
+}
+
+const QGeoVectorTile::Value *QGeoVectorTile::tag(const Layer &layer, const Feature &feature,
+                                                 qsizetype keyIndex)
+{
+    if (keyIndex < 0)
+        return nullptr;
+    ProtobufReader reader(feature.tags);
+    while (!reader.atEnd()) {
+        const quint64 key = reader.varint();
+        const quint64 value = reader.varint();
+        if (key == quint64(keyIndex))
+            return value < quint64(layer.values.size()) ? &layer.values.at(value) : nullptr;
+    }
+    return nullptr;
+}
+
+QList<QPolygonF> QGeoVectorTile::geometry(const Feature &feature)
+{
+    QList<QPolygonF> parts;
+    ProtobufReader reader(feature.geometry);
+    qint64 x = 0;
+    qint64 y = 0;
+    while (!reader.atEnd()) {
+        const quint64 command = reader.varint();
+        const int id = int(command & 7);
+        quint64 count = command >> 3;
+        if (id == MoveTo || id == LineTo) {
+            for (; count > 0 && !reader.atEnd(); --count) {
+                x += zigzag(reader.varint());
+                y += zigzag(reader.varint());
+                if (reader.hasError())
+                    break;
+                // Malformed geometries starting with a LineTo get a part too
+                if (id == MoveTo || parts.isEmpty())
+                    parts.append(QPolygonF());
+                parts.last().append(QPointF(x, y));
+            }
+        } else if (id == ClosePath) {
+            if (!parts.isEmpty() && !parts.last().isEmpty())
+                parts.last().append(parts.last().first());
+        } else {
+            break;
+        }
+    }
+    return parts;
+}
+
+QT_END_NAMESPACE
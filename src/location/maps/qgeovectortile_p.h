@@ -0,0 +1,90 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOVECTORTILE_P_H
+#define QGEOVECTORTILE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtGui/QPolygonF>
+
+QT_BEGIN_NAMESPACE
+
+// A tile in the Mapbox Vector Tile format, decoded in place: the names,
+// keys, string values, tags and geometries of the layers are views on the
+// protocol buffer, which the tile keeps alive. The geometry of a feature
+// is only decoded when asked for, so that the features that no style rule
+// draws cost nothing beyond the scan of the buffer.
+class Q_LOCATION_EXPORT QGeoVectorTile
+{
+public:
+    enum GeometryType {
+        UnknownGeometry = 0,
+        Point = 1,
+        LineString = 2,
+        Polygon = 3
+    };
+
+    struct Value
+    {
+        QByteArrayView string;
+        // Numbers and booleans, which are 0 or 1
+        double number = 0;
+        bool isString = false;
+    };
+
+    struct Feature
+    {
+        quint64 id = 0;
+        GeometryType type = UnknownGeometry;
+        // Packed pairs of indexes in the keys and values of the layer
+        QByteArrayView tags;
+        // Packed commands and zigzag encoded coordinates
+        QByteArrayView geometry;
+    };
+
+    struct Layer
+    {
+        QByteArrayView name;
+        quint32 extent = 4096;
+        QList<QByteArrayView> keys;
+        QList<Value> values;
+        QList<Feature> features;
+    };
+
+    static QGeoVectorTile fromData(const QByteArray &data);
+
+    bool isValid() const { return m_valid; }
+    const QList<Layer> &layers() const { return m_layers; }
+    const Layer *layer(QByteArrayView name) const;
+
+    // The value of the key at keyIndex in the layer, or nullptr when the
+    // feature has no such tag
+    static const Value *tag(const Layer &layer, const Feature &feature, qsizetype keyIndex);
+    // The points, lines or rings of the feature in tile coordinates, from 0
+    // to the extent of the layer. Rings are closed.
+    static QList<QPolygonF> geometry(const Feature &feature);
+
+private:
+    QByteArray m_data;
+    QList<Layer> m_layers;
+    bool m_valid = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOVECTORTILE_P_H
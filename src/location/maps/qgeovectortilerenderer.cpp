@@ -0,0 +1,164 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeovectortilerenderer_p.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+bool QGeoVectorTileRenderer::setStyle(const QByteArray &json, QString *errorString)
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        if (errorString) {
+            *errorString = error.error != QJsonParseError::NoError
+                    ? error.errorString()
+                    : QStringLiteral("The style is not a JSON object");
+        }
+        return false;
+    }
+
+    const QJsonObject style = document.object();
+    m_background = QColor::fromString(style.value(QStringLiteral("background")).toString());
+    if (!m_background.isValid())
+        m_background = Qt::transparent;
+
+    m_rules.clear();
+    const QJsonArray layers = style.value(QStringLiteral("layers")).toArray();
+    for (const QJsonValue &value : layers) {
+        const QJsonObject layer = value.toObject();
+        Rule rule;
+        rule.layer = layer.value(QStringLiteral("source-layer")).toString().toUtf8();
+        rule.fillColor = QColor::fromString(layer.value(QStringLiteral("fill-color")).toString());
+        rule.lineColor = QColor::fromString(layer.value(QStringLiteral("line-color")).toString());
+        rule.lineWidth = layer.value(QStringLiteral("line-width")).toDouble(1.0);
+        rule.minimumZoomLevel = layer.value(QStringLiteral("minzoom")).toInt(0);
+        rule.maximumZoomLevel = layer.value(QStringLiteral("maxzoom"))
+                                        .toInt(std::numeric_limits<int>::max());
+
+        const QJsonArray filter = layer.value(QStringLiteral("filter")).toArray();
+        if (filter.size() >= 3) {
+            const QString op = filter.at(0).toString();
+            if (op != QLatin1String("==") && op != QLatin1String("!=")
+                    && op != QLatin1String("in") && op != QLatin1String("!in")) {
+                continue;
+            }
+            rule.filterNegated = op.startsWith(QLatin1Char('!'));
+            rule.filterKey = filter.at(1).toString().toUtf8();
+            for (qsizetype i = 2; i < filter.size(); ++i) {
+                const QJsonValue operand = filter.at(i);
+                if (operand.isString())
+                    rule.filterStrings.append(operand.toString().toUtf8());
+                else if (operand.isBool())
+                    rule.filterNumbers.append(operand.toBool() ? 1 : 0);
+                else if (operand.isDouble())
+                    rule.filterNumbers.append(operand.toDouble());
+            }
+        }
+
+        if (rule.layer.isEmpty() || (!rule.fillColor.isValid() && !rule.lineColor.isValid()))
+            continue;
+        m_rules.append(rule);
+    }
+    return true;
+}
+
+bool QGeoVectorTileRenderer::matches(const Rule &rule, const QGeoVectorTile::Layer &layer,
+                                     const QGeoVectorTile::Feature &feature, qsizetype keyIndex)
+{
+    if (rule.filterKey.isEmpty())
+        return true;
+
+    bool equal = false;
+    if (const QGeoVectorTile::Value *value = QGeoVectorTile::tag(layer, feature, keyIndex)) {
+        if (value->isString) {
+            for (const QByteArray &string : rule.filterStrings) {
+                if (value->string == QByteArrayView(string)) {
+                    equal = true;
+                    break;
+                }
+            }
+        } else {
+            equal = rule.filterNumbers.contains(value->number);
+        }
+    }
+    return equal != rule.filterNegated;
+}
+
+QImage QGeoVectorTileRenderer::render(const QGeoVectorTile &tile, int zoomLevel,
+                                      const QSize &size, const QRectF &source) const
+{
+    if (!tile.isValid() || size.isEmpty() || source.isEmpty())
+        return QImage();
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(m_background);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    for (const Rule &rule : m_rules) {
+        if (zoomLevel < rule.minimumZoomLevel || zoomLevel > rule.maximumZoomLevel)
+            continue;
+        const QGeoVectorTile::Layer *layer = tile.layer(rule.layer);
+        if (!layer)
+            continue;
+
+        const qsizetype keyIndex = layer->keys.indexOf(QByteArrayView(rule.filterKey));
+        QPainterPath fill;
+        fill.setFillRule(Qt::WindingFill);
+        QPainterPath line;
+        for (const QGeoVectorTile::Feature &feature : layer->features) {
+            if (feature.type != QGeoVectorTile::LineString
+                    && feature.type != QGeoVectorTile::Polygon) {
+                continue;
+            }
+            if (!matches(rule, *layer, feature, keyIndex))
+                continue;
+            const bool filled = feature.type == QGeoVectorTile::Polygon && rule.fillColor.isValid();
+            const bool stroked = rule.lineColor.isValid();
+            const QList<QPolygonF> parts = QGeoVectorTile::geometry(feature);
+            for (const QPolygonF &part : parts) {
+                if (filled)
+                    fill.addPolygon(part);
+                if (stroked)
+                    line.addPolygon(part);
+            }
+        }
+
+        // Tile coordinates to pixels, the parts out of the source rectangle
+        // are clipped by the image
+        const qreal extent = layer->extent;
+        QTransform transform;
+        transform.scale(size.width() / (source.width() * extent),
+                        size.height() / (source.height() * extent));
+        transform.translate(-source.x() * extent, -source.y() * extent);
+        painter.setTransform(transform);
+
+        if (!fill.isEmpty()) {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(rule.fillColor);
+            painter.drawPath(fill);
+        }
+        if (!line.isEmpty()) {
+            QPen pen(rule.lineColor, rule.lineWidth);
+            pen.setCosmetic(true);
+            pen.setCapStyle(Qt::RoundCap);
+            pen.setJoinStyle(Qt::RoundJoin);
+            painter.setPen(pen);
+            painter.setBrush(Qt::NoBrush);
+            painter.drawPath(line);
+        }
+    }
+    painter.end();
+    return image;
+}
+
+QT_END_NAMESPACE
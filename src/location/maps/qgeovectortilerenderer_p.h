@@ -0,0 +1,80 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOVECTORTILERENDERER_P_H
+#define QGEOVECTORTILERENDERER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qgeovectortile_p.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QRectF>
+#include <QtCore/QSize>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
+
+QT_BEGIN_NAMESPACE
+
+// Rasterizes vector tiles with QPainter, following a style written in a
+// small subset of the Mapbox GL style specification:
+//
+//   { "background": "#f8f4f0",
+//     "layers": [ { "source-layer": "water", "fill-color": "#aad3df" },
+//                 { "source-layer": "transportation",
+//                   "filter": ["in", "class", "motorway", "trunk"],
+//                   "minzoom": 6, "line-color": "#e892a2", "line-width": 2 } ] }
+//
+// The layers are drawn in order. Filters compare one tag of the features
+// with "==", "!=", "in" or "!in". Line widths are in pixels and don't
+// depend on the zoom level. Points and labels are not drawn.
+//
+// Rendering only reads the renderer, so copies of it can be used from
+// other threads.
+class Q_LOCATION_EXPORT QGeoVectorTileRenderer
+{
+public:
+    bool setStyle(const QByteArray &json, QString *errorString = nullptr);
+
+    // Renders the source rectangle of the tile, in units of the tile, into
+    // an image of the given size. Overzoomed tiles are rendered from a
+    // rectangle of their ancestor, so that they are drawn sharp.
+    QImage render(const QGeoVectorTile &tile, int zoomLevel, const QSize &size,
+                  const QRectF &source = QRectF(0, 0, 1, 1)) const;
+
+private:
+    struct Rule
+    {
+        QByteArray layer;
+        QByteArray filterKey;
+        QList<QByteArray> filterStrings;
+        QList<double> filterNumbers;
+        bool filterNegated = false;
+        QColor fillColor;
+        QColor lineColor;
+        qreal lineWidth = 1;
+        int minimumZoomLevel = 0;
+        int maximumZoomLevel = 0;
+    };
+
+    static bool matches(const Rule &rule, const QGeoVectorTile::Layer &layer,
+                        const QGeoVectorTile::Feature &feature, qsizetype keyIndex);
+
+    QColor m_background = Qt::transparent;
+    QList<Rule> m_rules;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOVECTORTILERENDERER_P_H
@@ -0,0 +1,1033 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplacemanagerenginecache_p.h"
+#include "qplacesearchrequest_p.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoShape>
+
+#include <QtLocation/QPlaceAttribute>
+#include <QtLocation/QPlaceCategory>
+#include <QtLocation/QPlaceContactDetail>
+#include <QtLocation/QPlaceIcon>
+#include <QtLocation/QPlaceRatings>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSupplier>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+const quint32 CacheFileMagic = 0x51504c43; // "QPLC"
+const quint32 CacheFileVersion = 1;
+const QString CacheFileSuffix = QStringLiteral(".place");
+
+void writeCategory(QDataStream &stream, const QPlaceCategory &category)
+{
+    stream << category.categoryId() << category.name() << qint32(category.visibility());
+}
+
+QPlaceCategory readCategory(QDataStream &stream)
+{
+    QString id;
+    QString name;
+    qint32 visibility;
+    stream >> id >> name >> visibility;
+
+    QPlaceCategory category;
+    category.setCategoryId(id);
+    category.setName(name);
+    category.setVisibility(QLocation::Visibility(visibility));
+    return category;
+}
+
+void writeIcon(QDataStream &stream, const QPlaceIcon &icon)
+{
+    stream << icon.parameters();
+}
+
+QPlaceIcon readIcon(QDataStream &stream, QPlaceManager *manager)
+{
+    QVariantMap parameters;
+    stream >> parameters;
+
+    QPlaceIcon icon;
+    if (!parameters.isEmpty()) {
+        icon.setParameters(parameters);
+        icon.setManager(manager);
+    }
+    return icon;
+}
+
+void writeAddress(QDataStream &stream, const QGeoAddress &address)
+{
+    stream << (address.isTextGenerated() ? QString() : address.text())
+           << address.country() << address.countryCode() << address.state()
+           << address.county() << address.city() << address.district()
+           << address.street() << address.streetNumber() << address.postalCode();
+}
+
+QGeoAddress readAddress(QDataStream &stream)
+{
+    QString text, country, countryCode, state, county, city, district, street, streetNumber,
+            postalCode;
+    stream >> text >> country >> countryCode >> state >> county >> city >> district
+           >> street >> streetNumber >> postalCode;
+
+    QGeoAddress address;
+    address.setCountry(country);
+    address.setCountryCode(countryCode);
+    address.setState(state);
+    address.setCounty(county);
+    address.setCity(city);
+    address.setDistrict(district);
+    address.setStreet(street);
+    address.setStreetNumber(streetNumber);
+    address.setPostalCode(postalCode);
+    if (!text.isEmpty())
+        address.setText(text);
+    return address;
+}
+
+/*
+    Persists the subset of QPlace that providers fill in for search results and details.
+    Rich content (images, reviews, editorials) is fetched separately and is not stored.
+*/
+void writePlace(QDataStream &stream, const QPlace &place)
+{
+    stream << place.placeId() << place.name() << place.attribution()
+           << qint32(place.visibility()) << place.detailsFetched();
+
+    const QGeoLocation location = place.location();
+    stream << location.coordinate() << location.boundingShape();
+    writeAddress(stream, location.address());
+
+    const QList<QPlaceCategory> categories = place.categories();
+    stream << qint32(categories.size());
+    for (const QPlaceCategory &category : categories)
+        writeCategory(stream, category);
+
+    const QPlaceRatings ratings = place.ratings();
+    stream << ratings.average() << ratings.maximum() << qint32(ratings.count());
+
+    const QPlaceSupplier supplier = place.supplier();
+    stream << supplier.supplierId() << supplier.name() << supplier.url();
+
+    writeIcon(stream, place.icon());
+
+    const QStringList contactTypes = place.contactTypes();
+    stream << qint32(contactTypes.size());
+    for (const QString &type : contactTypes) {
+        const QList<QPlaceContactDetail> details = place.contactDetails(type);
+        stream << type << qint32(details.size());
+        for (const QPlaceContactDetail &detail : details)
+            stream << detail.label() << detail.value();
+    }
+
+    const QStringList attributeTypes = place.extendedAttributeTypes();
+    stream << qint32(attributeTypes.size());
+    for (const QString &type : attributeTypes) {
+        const QPlaceAttribute attribute = place.extendedAttribute(type);
+        stream << type << attribute.label() << attribute.text();
+    }
+}
+
+QPlace readPlace(QDataStream &stream, QPlaceManager *manager)
+{
+    QPlace place;
+
+    QString placeId, name, attribution;
+    qint32 visibility;
+    bool detailsFetched;
+    stream >> placeId >> name >> attribution >> visibility >> detailsFetched;
+    place.setPlaceId(placeId);
+    place.setName(name);
+    place.setAttribution(attribution);
+    place.setVisibility(QLocation::Visibility(visibility));
+    place.setDetailsFetched(detailsFetched);
+
+    QGeoCoordinate coordinate;
+    QGeoShape boundingShape;
+    stream >> coordinate >> boundingShape;
+    QGeoLocation location;
+    location.setCoordinate(coordinate);
+    location.setBoundingShape(boundingShape);
+    location.setAddress(readAddress(stream));
+    place.setLocation(location);
+
+    qint32 count;
+    stream >> count;
+    QList<QPlaceCategory> categories;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+        categories.append(readCategory(stream));
+    place.setCategories(categories);
+
+    qreal average, maximum;
+    qint32 ratingCount;
+    stream >> average >> maximum >> ratingCount;
+    QPlaceRatings ratings;
+    ratings.setAverage(average);
+    ratings.setMaximum(maximum);
+    ratings.setCount(ratingCount);
+    place.setRatings(ratings);
+
+    QString supplierId, supplierName;
+    QUrl supplierUrl;
+    stream >> supplierId >> supplierName >> supplierUrl;
+    QPlaceSupplier supplier;
+    supplier.setSupplierId(supplierId);
+    supplier.setName(supplierName);
+    supplier.setUrl(supplierUrl);
+    place.setSupplier(supplier);
+
+    place.setIcon(readIcon(stream, manager));
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString type;
+        qint32 detailCount;
+        stream >> type >> detailCount;
+        QList<QPlaceContactDetail> details;
+        for (qint32 j = 0; j < detailCount && stream.status() == QDataStream::Ok; ++j) {
+            QString label, value;
+            stream >> label >> value;
+            QPlaceContactDetail detail;
+            detail.setLabel(label);
+            detail.setValue(value);
+            details.append(detail);
+        }
+        place.setContactDetails(type, details);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString type, label, text;
+        stream >> type >> label >> text;
+        QPlaceAttribute attribute;
+        attribute.setLabel(label);
+        attribute.setText(text);
+        place.setExtendedAttribute(type, attribute);
+    }
+
+    return place;
+}
+
+void writeRequest(QDataStream &stream, const QPlaceSearchRequest &request)
+{
+    const QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+    stream << d->searchTerm << qint32(d->categories.size());
+    for (const QPlaceCategory &category : d->categories)
+        writeCategory(stream, category);
+    stream << d->searchArea << d->recommendationId << qint32(d->visibilityScope)
+           << qint32(d->relevanceHint) << qint32(d->limit) << d->searchContext
+           << d->related << qint32(d->page);
+}
+
+QPlaceSearchRequest readRequest(QDataStream &stream)
+{
+    QPlaceSearchRequest request;
+    QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+
+    qint32 count;
+    stream >> d->searchTerm >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+        d->categories.append(readCategory(stream));
+
+    qint32 visibilityScope, relevanceHint, limit, page;
+    stream >> d->searchArea >> d->recommendationId >> visibilityScope >> relevanceHint
+           >> limit >> d->searchContext >> d->related >> page;
+    d->visibilityScope = QLocation::VisibilityScope(visibilityScope);
+    d->relevanceHint = QPlaceSearchRequest::RelevanceHint(relevanceHint);
+    d->limit = limit;
+    d->page = page;
+    return request;
+}
+
+/*
+    Only plain place results and requests without a route search area can be persisted,
+    everything else stays in the memory tier.
+*/
+bool isPersistable(const QPlaceSearchRequest &request)
+{
+    return QPlaceSearchRequestPrivate::get(request)->routeSearchArea == QGeoRoute();
+}
+
+bool isPersistable(const QList<QPlaceSearchResult> &results)
+{
+    for (const QPlaceSearchResult &result : results) {
+        if (result.type() != QPlaceSearchResult::PlaceResult)
+            return false;
+    }
+    return true;
+}
+
+QString hashKey(QLatin1Char prefix, const QByteArray &data)
+{
+    return QString(prefix) + QLatin1Char('-')
+            + QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+
+} // namespace
+
+QPlaceCachedSearchReply::QPlaceCachedSearchReply(const QPlaceSearchRequest &request,
+                                                 QPlaceManagerEngineCache *parent)
+    : QPlaceSearchReply(parent)
+{
+    setRequest(request);
+}
+
+void QPlaceCachedSearchReply::complete(const QList<QPlaceSearchResult> &results,
+                                       const QPlaceSearchRequest &previousPage,
+                                       const QPlaceSearchRequest &nextPage)
+{
+    if (isFinished())
+        return;
+
+    setResults(results);
+    setPreviousPageRequest(previousPage);
+    setNextPageRequest(nextPage);
+    setFinished(true);
+    emit finished();
+}
+
+void QPlaceCachedSearchReply::fail(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    if (isFinished())
+        return;
+
+    setError(errorCode, errorString);
+    emit errorOccurred(errorCode, errorString);
+    setFinished(true);
+    emit finished();
+}
+
+QPlaceCachedDetailsReply::QPlaceCachedDetailsReply(QPlaceManagerEngineCache *parent)
+    : QPlaceDetailsReply(parent)
+{
+}
+
+void QPlaceCachedDetailsReply::complete(const QPlace &place)
+{
+    if (isFinished())
+        return;
+
+    setPlace(place);
+    setFinished(true);
+    emit finished();
+}
+
+void QPlaceCachedDetailsReply::fail(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    if (isFinished())
+        return;
+
+    setError(errorCode, errorString);
+    emit errorOccurred(errorCode, errorString);
+    setFinished(true);
+    emit finished();
+}
+
+/*
+    Constructs a caching decorator around \a engine, taking ownership of it. The following
+    \a parameters are recognized:
+
+    \list
+    \li places.cache.ttl - seconds a response stays valid, 300 by default. A value of 0
+        disables response caching and only coalesces identical in-flight requests.
+    \li places.cache.memory_cost - maximum number of cached results in memory, 1000 by default.
+    \li places.cache.directory - directory of the disk tier. The disk tier is disabled when
+        this is not set.
+    \li places.cache.disk_size - maximum size of the disk tier in bytes, 10 MiB by default.
+    \endlist
+*/
+QPlaceManagerEngineCache::QPlaceManagerEngineCache(QPlaceManagerEngine *engine,
+                                                   const QVariantMap &parameters,
+                                                   QObject *parent)
+    : QPlaceManagerEngine(parameters, parent), m_engine(engine)
+{
+    Q_ASSERT(m_engine);
+    m_engine->setParent(this);
+
+    // Provider parameters such as hosts, access tokens or languages change the responses,
+    // so they are part of every key. The cache's own parameters are not.
+    QByteArray parameterData;
+    QDataStream parameterStream(&parameterData, QIODevice::WriteOnly);
+    for (auto it = parameters.cbegin(), end = parameters.cend(); it != end; ++it) {
+        if (!it.key().startsWith(QLatin1String("places.cache")))
+            parameterStream << it.key() << it.value().toString();
+    }
+    m_parameterDigest = QCryptographicHash::hash(parameterData, QCryptographicHash::Sha1);
+
+    if (parameters.contains(QStringLiteral("places.cache.ttl")))
+        m_timeToLive = parameters.value(QStringLiteral("places.cache.ttl")).toInt();
+
+    int maxCost = 1000;
+    if (parameters.contains(QStringLiteral("places.cache.memory_cost")))
+        maxCost = parameters.value(QStringLiteral("places.cache.memory_cost")).toInt();
+    m_searchCache.setMaxCost(maxCost);
+    m_detailsCache.setMaxCost(maxCost);
+
+    if (parameters.contains(QStringLiteral("places.cache.disk_size")))
+        m_maxDiskUsage = parameters.value(QStringLiteral("places.cache.disk_size")).toLongLong();
+
+    m_directory = parameters.value(QStringLiteral("places.cache.directory")).toString();
+    if (!m_directory.isEmpty()) {
+        if (QDir::root().mkpath(m_directory))
+            loadDiskIndex();
+        else
+            m_directory.clear();
+    }
+
+    connect(m_engine, &QPlaceManagerEngine::finished,
+            this, &QPlaceManagerEngineCache::engineReplyFinished);
+    connect(m_engine, &QPlaceManagerEngine::errorOccurred,
+            this, &QPlaceManagerEngineCache::engineReplyError);
+
+    connect(m_engine, &QPlaceManagerEngine::placeAdded,
+            this, &QPlaceManagerEngine::placeAdded);
+    connect(m_engine, &QPlaceManagerEngine::placeUpdated,
+            this, &QPlaceManagerEngineCache::placeChanged);
+    connect(m_engine, &QPlaceManagerEngine::placeUpdated,
+            this, &QPlaceManagerEngine::placeUpdated);
+    connect(m_engine, &QPlaceManagerEngine::placeRemoved,
+            this, &QPlaceManagerEngineCache::placeChanged);
+    connect(m_engine, &QPlaceManagerEngine::placeRemoved,
+            this, &QPlaceManagerEngine::placeRemoved);
+
+    connect(m_engine, &QPlaceManagerEngine::categoryAdded,
+            this, &QPlaceManagerEngine::categoryAdded);
+    connect(m_engine, &QPlaceManagerEngine::categoryUpdated,
+            this, &QPlaceManagerEngine::categoryUpdated);
+    connect(m_engine, &QPlaceManagerEngine::categoryRemoved,
+            this, &QPlaceManagerEngine::categoryRemoved);
+    connect(m_engine, &QPlaceManagerEngine::dataChanged,
+            this, &QPlaceManagerEngineCache::clear);
+    connect(m_engine, &QPlaceManagerEngine::dataChanged,
+            this, &QPlaceManagerEngine::dataChanged);
+}
+
+QPlaceManagerEngineCache::~QPlaceManagerEngineCache()
+{
+}
+
+/*
+    Returns true if \a parameters request the place response cache.
+*/
+bool QPlaceManagerEngineCache::isEnabled(const QVariantMap &parameters)
+{
+    return parameters.value(QStringLiteral("places.cache"), false).toBool();
+}
+
+/*
+    Returns the decorated engine.
+*/
+QPlaceManagerEngine *QPlaceManagerEngineCache::engine() const
+{
+    return m_engine;
+}
+
+QPlaceManagerEngineCache::Statistics QPlaceManagerEngineCache::statistics() const
+{
+    return m_stats;
+}
+
+/*
+    Drops all cached responses from the memory and disk tiers. In-flight requests are not
+    affected.
+*/
+void QPlaceManagerEngineCache::clear()
+{
+    m_searchCache.clear();
+    m_detailsCache.clear();
+
+    const QList<QString> files = m_diskQueue;
+    for (const QString &fileName : files)
+        removeFromDisk(fileName);
+}
+
+QPlaceDetailsReply *QPlaceManagerEngineCache::getPlaceDetails(const QString &placeId)
+{
+    const QString key = detailsKey(placeId);
+    QPlaceCachedDetailsReply *reply = new QPlaceCachedDetailsReply(this);
+    connectCachedReply(reply);
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (DetailsEntry *entry = m_detailsCache.object(key)) {
+        if (entry->expiry > now) {
+            ++m_stats.memoryHits;
+            const QPlace place = entry->place;
+            QMetaObject::invokeMethod(reply, [reply, place]() {
+                reply->complete(place);
+            }, Qt::QueuedConnection);
+            return reply;
+        }
+        m_detailsCache.remove(key);
+    }
+
+    DetailsEntry diskEntry;
+    if (readDetailsFromDisk(key, &diskEntry)) {
+        ++m_stats.diskHits;
+        const QPlace place = diskEntry.place;
+        m_detailsCache.insert(key, new DetailsEntry(diskEntry));
+        QMetaObject::invokeMethod(reply, [reply, place]() {
+            reply->complete(place);
+        }, Qt::QueuedConnection);
+        return reply;
+    }
+
+    auto pending = m_pendingDetails.find(key);
+    if (pending != m_pendingDetails.end()) {
+        ++m_stats.coalesced;
+        pending->waiters.append(reply);
+        return reply;
+    }
+
+    ++m_stats.misses;
+    ++m_stats.upstreamRequests;
+
+    QPlaceDetailsReply *upstream = m_engine->getPlaceDetails(placeId);
+    PendingDetails &entry = m_pendingDetails[key];
+    entry.upstream = upstream;
+    entry.waiters.append(reply);
+    m_upstreamKeys.insert(upstream, key);
+
+    // keep filtering the engine's signals for the upstream reply until it is gone
+    connect(upstream, &QObject::destroyed, this, [this, upstream]() {
+        m_upstreamKeys.remove(upstream);
+    });
+    connect(upstream, &QPlaceReply::finished, this, [this, key]() {
+        upstreamDetailsFinished(key);
+    });
+    connect(upstream, &QPlaceReply::errorOccurred, this, [this, key]() {
+        upstreamDetailsFinished(key);
+    });
+    if (upstream->isFinished()) {
+        QMetaObject::invokeMethod(this, [this, key]() {
+            upstreamDetailsFinished(key);
+        }, Qt::QueuedConnection);
+    }
+
+    return reply;
+}
+
+QPlaceContentReply *QPlaceManagerEngineCache::getPlaceContent(const QPlaceContentRequest &request)
+{
+    return m_engine->getPlaceContent(request);
+}
+
+QPlaceSearchReply *QPlaceManagerEngineCache::search(const QPlaceSearchRequest &request)
+{
+    const QString key = searchKey(request);
+    QPlaceCachedSearchReply *reply = new QPlaceCachedSearchReply(request, this);
+    connectCachedReply(reply);
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (SearchEntry *entry = m_searchCache.object(key)) {
+        if (entry->expiry > now) {
+            ++m_stats.memoryHits;
+            const SearchEntry copy = *entry;
+            QMetaObject::invokeMethod(reply, [reply, copy]() {
+                reply->complete(copy.results, copy.previousPage, copy.nextPage);
+            }, Qt::QueuedConnection);
+            return reply;
+        }
+        m_searchCache.remove(key);
+    }
+
+    SearchEntry diskEntry;
+    if (readSearchFromDisk(key, &diskEntry)) {
+        ++m_stats.diskHits;
+        m_searchCache.insert(key, new SearchEntry(diskEntry), qMax(1, diskEntry.results.size()));
+        QMetaObject::invokeMethod(reply, [reply, diskEntry]() {
+            reply->complete(diskEntry.results, diskEntry.previousPage, diskEntry.nextPage);
+        }, Qt::QueuedConnection);
+        return reply;
+    }
+
+    auto pending = m_pendingSearches.find(key);
+    if (pending != m_pendingSearches.end()) {
+        ++m_stats.coalesced;
+        pending->waiters.append(reply);
+        return reply;
+    }
+
+    ++m_stats.misses;
+    ++m_stats.upstreamRequests;
+
+    QPlaceSearchReply *upstream = m_engine->search(request);
+    PendingSearch &entry = m_pendingSearches[key];
+    entry.upstream = upstream;
+    entry.waiters.append(reply);
+    m_upstreamKeys.insert(upstream, key);
+
+    // keep filtering the engine's signals for the upstream reply until it is gone
+    connect(upstream, &QObject::destroyed, this, [this, upstream]() {
+        m_upstreamKeys.remove(upstream);
+    });
+    connect(upstream, &QPlaceReply::finished, this, [this, key]() {
+        upstreamSearchFinished(key);
+    });
+    connect(upstream, &QPlaceReply::errorOccurred, this, [this, key]() {
+        upstreamSearchFinished(key);
+    });
+    if (upstream->isFinished()) {
+        QMetaObject::invokeMethod(this, [this, key]() {
+            upstreamSearchFinished(key);
+        }, Qt::QueuedConnection);
+    }
+
+    return reply;
+}
+
+QPlaceSearchSuggestionReply *QPlaceManagerEngineCache::searchSuggestions(
+        const QPlaceSearchRequest &request)
+{
+    return m_engine->searchSuggestions(request);
+}
+
+QPlaceIdReply *QPlaceManagerEngineCache::savePlace(const QPlace &place)
+{
+    return m_engine->savePlace(place);
+}
+
+QPlaceIdReply *QPlaceManagerEngineCache::removePlace(const QString &placeId)
+{
+    return m_engine->removePlace(placeId);
+}
+
+QPlaceIdReply *QPlaceManagerEngineCache::saveCategory(const QPlaceCategory &category,
+                                                      const QString &parentId)
+{
+    return m_engine->saveCategory(category, parentId);
+}
+
+QPlaceIdReply *QPlaceManagerEngineCache::removeCategory(const QString &categoryId)
+{
+    return m_engine->removeCategory(categoryId);
+}
+
+QPlaceReply *QPlaceManagerEngineCache::initializeCategories()
+{
+    return m_engine->initializeCategories();
+}
+
+QString QPlaceManagerEngineCache::parentCategoryId(const QString &categoryId) const
+{
+    return m_engine->parentCategoryId(categoryId);
+}
+
+QStringList QPlaceManagerEngineCache::childCategoryIds(const QString &categoryId) const
+{
+    return m_engine->childCategoryIds(categoryId);
+}
+
+QPlaceCategory QPlaceManagerEngineCache::category(const QString &categoryId) const
+{
+    return m_engine->category(categoryId);
+}
+
+QList<QPlaceCategory> QPlaceManagerEngineCache::childCategories(const QString &parentId) const
+{
+    return m_engine->childCategories(parentId);
+}
+
+QList<QLocale> QPlaceManagerEngineCache::locales() const
+{
+    return m_engine->locales();
+}
+
+void QPlaceManagerEngineCache::setLocales(const QList<QLocale> &locales)
+{
+    m_engine->setLocales(locales);
+}
+
+QUrl QPlaceManagerEngineCache::constructIconUrl(const QPlaceIcon &icon, const QSize &size) const
+{
+    return m_engine->constructIconUrl(icon, size);
+}
+
+QPlace QPlaceManagerEngineCache::compatiblePlace(const QPlace &original) const
+{
+    return m_engine->compatiblePlace(original);
+}
+
+QPlaceMatchReply *QPlaceManagerEngineCache::matchingPlaces(const QPlaceMatchRequest &request)
+{
+    return m_engine->matchingPlaces(request);
+}
+
+/*
+    Writes what identifies the provider behind the cache to \a stream, so that providers
+    sharing a cache directory, or versions of one provider, never see each other's responses.
+    The manager name and version are set by QGeoServiceProvider once the engine is created.
+*/
+void QPlaceManagerEngineCache::writeProviderKey(QDataStream &stream) const
+{
+    QStringList localeNames;
+    for (const QLocale &locale : m_engine->locales())
+        localeNames.append(locale.name());
+
+    stream << managerName() << qint32(managerVersion()) << m_parameterDigest << localeNames;
+}
+
+/*
+    Returns the normalised cache key of \a request. The search term is whitespace simplified
+    and case folded, categories are ordered by identifier and the provider, its parameters
+    and the engine locales are included since they affect the response.
+*/
+QString QPlaceManagerEngineCache::searchKey(const QPlaceSearchRequest &request) const
+{
+    const QPlaceSearchRequestPrivate *d = QPlaceSearchRequestPrivate::get(request);
+
+    QStringList categoryIds;
+    for (const QPlaceCategory &category : d->categories)
+        categoryIds.append(category.categoryId());
+    categoryIds.sort();
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    writeProviderKey(stream);
+    stream << d->searchTerm.simplified().toCaseFolded() << categoryIds << d->searchArea
+           << d->recommendationId << qint32(d->visibilityScope) << qint32(d->relevanceHint)
+           << qint32(d->limit) << d->searchContext << d->related << qint32(d->page);
+
+    // Route search areas have no stream operator, key on their path instead.
+    if (d->routeSearchArea != QGeoRoute())
+        stream << d->routeSearchArea.path() << d->routeSearchArea.routeId();
+
+    return hashKey(QLatin1Char('s'), data);
+}
+
+QString QPlaceManagerEngineCache::detailsKey(const QString &placeId) const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    writeProviderKey(stream);
+    stream << placeId;
+    return hashKey(QLatin1Char('d'), data);
+}
+
+void QPlaceManagerEngineCache::engineReplyFinished(QPlaceReply *reply)
+{
+    // upstream replies are private to the cache, clients see the cached reply instead
+    if (!m_upstreamKeys.contains(reply))
+        emit finished(reply);
+}
+
+void QPlaceManagerEngineCache::engineReplyError(QPlaceReply *reply, QPlaceReply::Error error,
+                                                const QString &errorString)
+{
+    if (!m_upstreamKeys.contains(reply))
+        emit errorOccurred(reply, error, errorString);
+}
+
+void QPlaceManagerEngineCache::cachedReplyFinished()
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QPlaceManagerEngineCache::cachedReplyError(QPlaceReply::Error error,
+                                                const QString &errorString)
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit errorOccurred(reply, error, errorString);
+}
+
+void QPlaceManagerEngineCache::placeChanged(const QString &placeId)
+{
+    const QString key = detailsKey(placeId);
+    m_detailsCache.remove(key);
+    removeFromDisk(diskFileName(key));
+
+    // any cached search may contain the place, drop them all
+    m_searchCache.clear();
+    const QList<QString> files = m_diskQueue;
+    for (const QString &fileName : files) {
+        if (QFileInfo(fileName).fileName().startsWith(QLatin1Char('s')))
+            removeFromDisk(fileName);
+    }
+}
+
+void QPlaceManagerEngineCache::connectCachedReply(QPlaceReply *reply)
+{
+    connect(reply, &QPlaceReply::finished,
+            this, &QPlaceManagerEngineCache::cachedReplyFinished);
+    connect(reply, &QPlaceReply::errorOccurred,
+            this, &QPlaceManagerEngineCache::cachedReplyError);
+}
+
+void QPlaceManagerEngineCache::upstreamSearchFinished(const QString &key)
+{
+    const PendingSearch pending = m_pendingSearches.take(key);
+    if (!pending.upstream)
+        return;
+
+    QPlaceSearchReply *upstream = pending.upstream;
+    upstream->deleteLater();
+
+    if (upstream->error() != QPlaceReply::NoError) {
+        for (const QPointer<QPlaceCachedSearchReply> &waiter : pending.waiters) {
+            if (waiter)
+                waiter->fail(upstream->error(), upstream->errorString());
+        }
+        return;
+    }
+
+    SearchEntry entry;
+    entry.results = upstream->results();
+    entry.previousPage = upstream->previousPageRequest();
+    entry.nextPage = upstream->nextPageRequest();
+    entry.expiry = QDateTime::currentDateTimeUtc().addSecs(m_timeToLive);
+
+    if (m_timeToLive > 0) {
+        if (isPersistable(upstream->request()) && isPersistable(entry.results))
+            writeSearchToDisk(key, entry);
+        m_searchCache.insert(key, new SearchEntry(entry), qMax(1, entry.results.size()));
+    }
+
+    for (const QPointer<QPlaceCachedSearchReply> &waiter : pending.waiters) {
+        if (waiter)
+            waiter->complete(entry.results, entry.previousPage, entry.nextPage);
+    }
+}
+
+void QPlaceManagerEngineCache::upstreamDetailsFinished(const QString &key)
+{
+    const PendingDetails pending = m_pendingDetails.take(key);
+    if (!pending.upstream)
+        return;
+
+    QPlaceDetailsReply *upstream = pending.upstream;
+    upstream->deleteLater();
+
+    if (upstream->error() != QPlaceReply::NoError) {
+        for (const QPointer<QPlaceCachedDetailsReply> &waiter : pending.waiters) {
+            if (waiter)
+                waiter->fail(upstream->error(), upstream->errorString());
+        }
+        return;
+    }
+
+    DetailsEntry entry;
+    entry.place = upstream->place();
+    entry.expiry = QDateTime::currentDateTimeUtc().addSecs(m_timeToLive);
+
+    if (m_timeToLive > 0) {
+        writeDetailsToDisk(key, entry);
+        m_detailsCache.insert(key, new DetailsEntry(entry));
+    }
+
+    for (const QPointer<QPlaceCachedDetailsReply> &waiter : pending.waiters) {
+        if (waiter)
+            waiter->complete(entry.place);
+    }
+}
+
+bool QPlaceManagerEngineCache::readSearchFromDisk(const QString &key, SearchEntry *entry)
+{
+    if (m_directory.isEmpty())
+        return false;
+
+    const QString fileName = diskFileName(key);
+    if (!m_diskSizes.contains(fileName))
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic, version;
+    stream >> magic >> version >> entry->expiry;
+    if (magic != CacheFileMagic || version != CacheFileVersion
+            || entry->expiry <= QDateTime::currentDateTimeUtc()) {
+        file.close();
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    qint32 count;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString title;
+        qreal distance;
+        bool sponsored;
+        stream >> title >> distance >> sponsored;
+
+        QPlaceResult result;
+        result.setTitle(title);
+        result.setDistance(distance);
+        result.setSponsored(sponsored);
+        result.setIcon(readIcon(stream, manager()));
+        result.setPlace(readPlace(stream, manager()));
+        entry->results.append(result);
+    }
+
+    bool hasPrevious, hasNext;
+    stream >> hasPrevious;
+    if (hasPrevious)
+        entry->previousPage = readRequest(stream);
+    stream >> hasNext;
+    if (hasNext)
+        entry->nextPage = readRequest(stream);
+
+    if (stream.status() != QDataStream::Ok) {
+        file.close();
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    return true;
+}
+
+void QPlaceManagerEngineCache::writeSearchToDisk(const QString &key, const SearchEntry &entry)
+{
+    if (m_directory.isEmpty())
+        return;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << CacheFileMagic << CacheFileVersion << entry.expiry;
+
+    stream << qint32(entry.results.size());
+    for (const QPlaceSearchResult &searchResult : entry.results) {
+        const QPlaceResult result(searchResult);
+        stream << result.title() << result.distance() << result.isSponsored();
+        writeIcon(stream, result.icon());
+        writePlace(stream, result.place());
+    }
+
+    const bool hasPrevious = entry.previousPage != QPlaceSearchRequest();
+    stream << hasPrevious;
+    if (hasPrevious)
+        writeRequest(stream, entry.previousPage);
+    const bool hasNext = entry.nextPage != QPlaceSearchRequest();
+    stream << hasNext;
+    if (hasNext)
+        writeRequest(stream, entry.nextPage);
+
+    addToDisk(diskFileName(key), data);
+}
+
+bool QPlaceManagerEngineCache::readDetailsFromDisk(const QString &key, DetailsEntry *entry)
+{
+    if (m_directory.isEmpty())
+        return false;
+
+    const QString fileName = diskFileName(key);
+    if (!m_diskSizes.contains(fileName))
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic, version;
+    stream >> magic >> version >> entry->expiry;
+    if (magic != CacheFileMagic || version != CacheFileVersion
+            || entry->expiry <= QDateTime::currentDateTimeUtc()) {
+        file.close();
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    entry->place = readPlace(stream, manager());
+    if (stream.status() != QDataStream::Ok) {
+        file.close();
+        removeFromDisk(fileName);
+        return false;
+    }
+
+    return true;
+}
+
+void QPlaceManagerEngineCache::writeDetailsToDisk(const QString &key, const DetailsEntry &entry)
+{
+    if (m_directory.isEmpty())
+        return;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << CacheFileMagic << CacheFileVersion << entry.expiry;
+    writePlace(stream, entry.place);
+
+    addToDisk(diskFileName(key), data);
+}
+
+QString QPlaceManagerEngineCache::diskFileName(const QString &key) const
+{
+    return m_directory + QLatin1Char('/') + key + CacheFileSuffix;
+}
+
+void QPlaceManagerEngineCache::loadDiskIndex()
+{
+    const QDir dir(m_directory);
+    const QFileInfoList files = dir.entryInfoList(QStringList(QStringLiteral("*.place")),
+                                                  QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QFileInfo &info : files) {
+        const QString fileName = info.absoluteFilePath();
+        m_diskQueue.append(fileName);
+        m_diskSizes.insert(fileName, info.size());
+        m_diskUsage += info.size();
+    }
+
+    while (m_diskUsage > m_maxDiskUsage && !m_diskQueue.isEmpty())
+        removeFromDisk(m_diskQueue.first());
+}
+
+void QPlaceManagerEngineCache::addToDisk(const QString &fileName, const QByteArray &data)
+{
+    if (data.size() > m_maxDiskUsage)
+        return;
+
+    removeFromDisk(fileName);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+    if (file.write(data) != data.size()) {
+        file.close();
+        file.remove();
+        return;
+    }
+    file.close();
+
+    m_diskQueue.append(fileName);
+    m_diskSizes.insert(fileName, data.size());
+    m_diskUsage += data.size();
+
+    while (m_diskUsage > m_maxDiskUsage && m_diskQueue.size() > 1)
+        removeFromDisk(m_diskQueue.first());
+}
+
+void QPlaceManagerEngineCache::removeFromDisk(const QString &fileName)
+{
+    const auto it = m_diskSizes.constFind(fileName);
+    if (it == m_diskSizes.constEnd())
+        return;
+
+    m_diskUsage -= it.value();
+    m_diskSizes.erase(it);
+    m_diskQueue.removeOne(fileName);
+    QFile::remove(fileName);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,187 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLACEMANAGERENGINECACHE_P_H
+#define QPLACEMANAGERENGINECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/QPlaceManagerEngine>
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/QPlaceSearchResult>
+#include <QtLocation/QPlace>
+
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaceManagerEngineCache;
+
+class Q_LOCATION_EXPORT QPlaceCachedSearchReply : public QPlaceSearchReply
+{
+    Q_OBJECT
+
+public:
+    QPlaceCachedSearchReply(const QPlaceSearchRequest &request, QPlaceManagerEngineCache *parent);
+
+    void complete(const QList<QPlaceSearchResult> &results,
+                  const QPlaceSearchRequest &previousPage,
+                  const QPlaceSearchRequest &nextPage);
+    void fail(QPlaceReply::Error error, const QString &errorString);
+};
+
+class Q_LOCATION_EXPORT QPlaceCachedDetailsReply : public QPlaceDetailsReply
+{
+    Q_OBJECT
+
+public:
+    explicit QPlaceCachedDetailsReply(QPlaceManagerEngineCache *parent);
+
+    void complete(const QPlace &place);
+    void fail(QPlaceReply::Error error, const QString &errorString);
+};
+
+/*
+    Decorates a provider's QPlaceManagerEngine with request coalescing and a response cache
+    for search() and getPlaceDetails(). Identical requests that are in flight share a single
+    upstream reply, completed responses are kept in a TTL bound memory tier and optionally
+    persisted to a size bound disk tier. All other operations are forwarded unchanged.
+
+    QGeoServiceProvider installs the decorator when the "places.cache" parameter is true, and
+    gives the decorated engine the manager, name and version of the decorator.
+*/
+class Q_LOCATION_EXPORT QPlaceManagerEngineCache : public QPlaceManagerEngine
+{
+    Q_OBJECT
+
+public:
+    struct Statistics
+    {
+        quint64 memoryHits = 0;
+        quint64 diskHits = 0;
+        quint64 misses = 0;
+        quint64 coalesced = 0;
+        quint64 upstreamRequests = 0;
+    };
+
+    QPlaceManagerEngineCache(QPlaceManagerEngine *engine, const QVariantMap &parameters,
+                             QObject *parent = nullptr);
+    ~QPlaceManagerEngineCache();
+
+    static bool isEnabled(const QVariantMap &parameters);
+
+    QPlaceManagerEngine *engine() const;
+    Statistics statistics() const;
+    void clear();
+
+    QPlaceDetailsReply *getPlaceDetails(const QString &placeId) override;
+    QPlaceContentReply *getPlaceContent(const QPlaceContentRequest &request) override;
+    QPlaceSearchReply *search(const QPlaceSearchRequest &request) override;
+    QPlaceSearchSuggestionReply *searchSuggestions(const QPlaceSearchRequest &request) override;
+
+    QPlaceIdReply *savePlace(const QPlace &place) override;
+    QPlaceIdReply *removePlace(const QString &placeId) override;
+    QPlaceIdReply *saveCategory(const QPlaceCategory &category, const QString &parentId) override;
+    QPlaceIdReply *removeCategory(const QString &categoryId) override;
+
+    QPlaceReply *initializeCategories() override;
+    QString parentCategoryId(const QString &categoryId) const override;
+    QStringList childCategoryIds(const QString &categoryId) const override;
+    QPlaceCategory category(const QString &categoryId) const override;
+    QList<QPlaceCategory> childCategories(const QString &parentId) const override;
+
+    QList<QLocale> locales() const override;
+    void setLocales(const QList<QLocale> &locales) override;
+
+    QUrl constructIconUrl(const QPlaceIcon &icon, const QSize &size) const override;
+    QPlace compatiblePlace(const QPlace &original) const override;
+    QPlaceMatchReply *matchingPlaces(const QPlaceMatchRequest &request) override;
+
+    QString searchKey(const QPlaceSearchRequest &request) const;
+    QString detailsKey(const QString &placeId) const;
+
+private slots:
+    void engineReplyFinished(QPlaceReply *reply);
+    void engineReplyError(QPlaceReply *reply, QPlaceReply::Error error,
+                          const QString &errorString);
+    void cachedReplyFinished();
+    void cachedReplyError(QPlaceReply::Error error, const QString &errorString);
+    void placeChanged(const QString &placeId);
+
+private:
+    struct SearchEntry
+    {
+        QList<QPlaceSearchResult> results;
+        QPlaceSearchRequest previousPage;
+        QPlaceSearchRequest nextPage;
+        QDateTime expiry;
+    };
+
+    struct DetailsEntry
+    {
+        QPlace place;
+        QDateTime expiry;
+    };
+
+    struct PendingSearch
+    {
+        QPlaceSearchReply *upstream = nullptr;
+        QList<QPointer<QPlaceCachedSearchReply>> waiters;
+    };
+
+    struct PendingDetails
+    {
+        QPlaceDetailsReply *upstream = nullptr;
+        QList<QPointer<QPlaceCachedDetailsReply>> waiters;
+    };
+
+    void writeProviderKey(QDataStream &stream) const;
+    void connectCachedReply(QPlaceReply *reply);
+    void upstreamSearchFinished(const QString &key);
+    void upstreamDetailsFinished(const QString &key);
+
+    bool readSearchFromDisk(const QString &key, SearchEntry *entry);
+    void writeSearchToDisk(const QString &key, const SearchEntry &entry);
+    bool readDetailsFromDisk(const QString &key, DetailsEntry *entry);
+    void writeDetailsToDisk(const QString &key, const DetailsEntry &entry);
+    QString diskFileName(const QString &key) const;
+    void loadDiskIndex();
+    void addToDisk(const QString &fileName, const QByteArray &data);
+    void removeFromDisk(const QString &fileName);
+
+    QPlaceManagerEngine *m_engine;
+    QCache<QString, SearchEntry> m_searchCache;
+    QCache<QString, DetailsEntry> m_detailsCache;
+    QHash<QString, PendingSearch> m_pendingSearches;
+    QHash<QString, PendingDetails> m_pendingDetails;
+    QHash<QPlaceReply *, QString> m_upstreamKeys;
+    QByteArray m_parameterDigest;
+
+    int m_timeToLive = 300;
+    QString m_directory;
+    qint64 m_maxDiskUsage = 10 * 1024 * 1024;
+    qint64 m_diskUsage = 0;
+    QList<QString> m_diskQueue; // least recently written first
+    QHash<QString, qint64> m_diskSizes;
+
+    Statistics m_stats;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEMANAGERENGINECACHE_P_H
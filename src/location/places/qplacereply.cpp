@@ -128,6 +128,8 @@ QPlaceReply::Type QPlaceReply::type() const
 */
 void QPlaceReply::setFinished(bool finished)
 {
+    if (d_ptr->timedOut)
+        return;
     d_ptr->isFinished = finished;
 }
 
@@ -139,6 +141,8 @@ void QPlaceReply::setFinished(bool finished)
 */
 void QPlaceReply::setError(QPlaceReply::Error error, const QString &errorString)
 {
+    if (d_ptr->timedOut)
+        return;
     d_ptr->error = error;
     d_ptr->errorString = errorString;
 }
@@ -24,6 +24,7 @@ class QPlaceReplyPrivate
 public:
     virtual ~QPlaceReplyPrivate(){}
     bool isFinished = false;
+    bool timedOut = false;
     QPlaceReply::Error error = QPlaceReply::NoError;
     QString errorString;
 };
@@ -6,6 +6,8 @@
 #include <QtLocation/QPlaceProposedSearchResult>
 #include <QtLocation/private/qplacereply_p.h>
 
+#include <QtCore/QTimer>
+
 QT_BEGIN_NAMESPACE
 
 class QPlaceSearchReplyPrivate : public QPlaceReplyPrivate
@@ -15,6 +17,7 @@ public:
     QPlaceSearchRequest searchRequest;
     QPlaceSearchRequest previousPageRequest;
     QPlaceSearchRequest nextPageRequest;
+    bool deadlineStarted = false;
 };
 
 /*!
@@ -107,11 +110,35 @@ QPlaceSearchRequest QPlaceSearchReply::nextPageRequest() const
 
 /*!
     Sets the search \a request used to generate this reply.
+
+    If the \a request has a \l{QPlaceSearchRequest::timeout()}{timeout}, the
+    reply finishes with a CommunicationError and is aborted once it has passed.
 */
 void QPlaceSearchReply::setRequest(const QPlaceSearchRequest &request)
 {
     Q_D(QPlaceSearchReply);
     d->searchRequest = request;
+
+    if (request.timeout() <= 0 || d->deadlineStarted)
+        return;
+    d->deadlineStarted = true;
+    QTimer::singleShot(request.timeout(), this, [this]() {
+        if (isFinished())
+            return;
+        const QString errorString = tr("The place search timed out.");
+        setError(CommunicationError, errorString);
+        setFinished(true);
+        d_func()->timedOut = true;
+        emit errorOccurred(CommunicationError, errorString);
+        emit finished();
+
+        // Engines emit the signals themselves, so whatever they report
+        // about the abort, or results that arrive meanwhile, is cut off
+        disconnect(this, &QPlaceReply::finished, nullptr, nullptr);
+        disconnect(this, &QPlaceReply::errorOccurred, nullptr, nullptr);
+        disconnect(this, &QPlaceReply::contentUpdated, nullptr, nullptr);
+        abort();
+    });
 }
 
 /*!
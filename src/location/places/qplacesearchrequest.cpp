@@ -26,6 +26,7 @@ bool QPlaceSearchRequestPrivate::operator==(const QPlaceSearchRequestPrivate &ot
            visibilityScope == other.visibilityScope &&
            relevanceHint == other.relevanceHint &&
            limit == other.limit &&
+           timeout == other.timeout &&
            searchContext == other.searchContext;
 
     // deliberately not testing related and page. comparing only the content.
@@ -34,6 +35,7 @@ bool QPlaceSearchRequestPrivate::operator==(const QPlaceSearchRequestPrivate &ot
 void QPlaceSearchRequestPrivate::clear()
 {
     limit = -1;
+    timeout = 0;
     searchTerm.clear();
     categories.clear();
     searchArea = QGeoShape();
@@ -335,6 +337,34 @@ void QPlaceSearchRequest::setLimit(int limit)
     d->limit = limit;
 }
 
+/*!
+    Returns the time in milliseconds that the search may take.
+
+    The default value is 0, which means that the search never times out.
+
+    \since 6.9
+*/
+int QPlaceSearchRequest::timeout() const
+{
+    Q_D(const QPlaceSearchRequest);
+    return d->timeout;
+}
+
+/*!
+    Sets the time in milliseconds that the search may take to \a msecs.
+
+    If the QPlaceSearchReply has not finished once the time has passed, it
+    finishes with a QPlaceReply::CommunicationError and the search is
+    aborted. Any results that arrive later are discarded.
+
+    \since 6.9
+*/
+void QPlaceSearchRequest::setTimeout(int msecs)
+{
+    Q_D(QPlaceSearchRequest);
+    d->timeout = qMax(0, msecs);
+}
+
 /*!
     Clears the search request.
 */
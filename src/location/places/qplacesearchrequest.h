@@ -66,6 +66,9 @@ public:
     int limit() const;
     void setLimit(int limit);
 
+    int timeout() const;
+    void setTimeout(int msecs);
+
     void clear();
 
 private:
@@ -44,6 +44,7 @@ public:
     QPlaceSearchRequest::RelevanceHint relevanceHint = QPlaceSearchRequest::UnspecifiedHint;
     QGeoRoute routeSearchArea;
     int limit = -1;
+    int timeout = 0;
     QVariant searchContext;
     bool related = false;
     int page = 0;
@@ -16,6 +16,7 @@
 #include <algorithm>
 
 #include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/QQuickWindow>
 
 QT_BEGIN_NAMESPACE
 
@@ -238,6 +239,62 @@ qreal QDeclarativeCircleMapItem::radius() const
   visible property of the item to false.
 */
 
+/*!
+    \qmlproperty enumeration MapCircle::backend
+
+    This property holds which backend is in use to render the circle:
+
+    \value MapCircle.Software
+        The circle is projected and triangulated on the CPU, by a Shape,
+        every time the map moves. This is the default.
+    \value MapCircle.Shader
+        The circle is triangulated once per integer zoom level, and the
+        triangles are projected by the graphics hardware. Panning, rotating,
+        tilting, and zooming within a zoom level reuse the triangles. The
+        border is drawn like a MapPolyline with the \c Shader backend. When
+        the scene graph does not render through the graphics hardware
+        abstraction, as with the \c software adaptation, or when Qt Location
+        was built without Qt Shader Tools, the Software backend is used
+        instead.
+
+    \since QtLocation 6.9
+*/
+QDeclarativeCircleMapItem::Backend QDeclarativeCircleMapItem::backend() const
+{
+    return m_backend;
+}
+
+void QDeclarativeCircleMapItem::setBackend(Backend backend)
+{
+    if (backend == m_backend)
+        return;
+    m_backend = backend;
+    updateBackend();
+    emit backendChanged();
+}
+
+/*!
+    \internal
+
+    Replaces the backend implementation if the requested backend, or the
+    ability of the window to run shaders, changed.
+*/
+void QDeclarativeCircleMapItem::updateBackend()
+{
+    Backend backend = m_backend;
+    if (backend == Shader && !QGeoMapItemMesh::isSupported(window()))
+        backend = Software;
+    if (backend == m_activeBackend)
+        return;
+
+    m_activeBackend = backend;
+    if (backend == Shader)
+        m_d.reset(new QDeclarativeCircleMapItemPrivateGPU(*this));
+    else
+        m_d.reset(new QDeclarativeCircleMapItemPrivateCPU(*this));
+    m_d->onGeoGeometryChanged();
+}
+
 /*!
     \internal
 */
@@ -253,6 +310,7 @@ void QDeclarativeCircleMapItem::updatePolish()
 {
     if (!map() || map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
         return;
+    updateBackend();
     m_d->updatePolish();
 }
 
@@ -366,7 +424,7 @@ void QDeclarativeCircleMapItemPrivate::includeOnePoleInPath(QList<QDoubleVector2
     if (crossNorthPole && crossSouthPole)
         return;
 
-    const QRectF cameraRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(p.visibleGeometry());
+    const QRectF cameraRect = p.visibleGeometryBoundingRect();
     const qreal xAtBorder = cameraRect.left();
 
     // The strategy is to order the points from left to right as they appear on the screen.
@@ -395,33 +453,106 @@ void QDeclarativeCircleMapItemPrivate::includeOnePoleInPath(QList<QDoubleVector2
     path.append(QDoubleVector2D(P1.x(), newPoleLat));
 }
 
+void QDeclarativeCircleMapItemPrivate::updateCirclePath()
+{
+    if (!m_circle.map() || m_circle.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
+        return;
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
+    const QGeoCoordinate center = m_circle.center();
+    const qreal radius = m_circle.radius();
+    const QLocation::ReferenceSurface surface = m_circle.referenceSurface();
+    const QDoubleVector2D mercatorCenter = p.geoToMapProjection(center);
+
+    // Moving the center along a parallel only moves the perimeter, and
+    // small latitude or radius changes scale it by less than the tolerance
+    const qreal latitudeChange = QLocationUtils::radians(center.latitude() - m_circlePathLatitude);
+    if (!m_circlePath.isEmpty() && surface == m_circlePathSurface
+            && qAbs(radius - m_circlePathRadius) <= PerimeterTolerance * radius
+            && qAbs(latitudeChange * std::tan(QLocationUtils::radians(center.latitude()))) <= PerimeterTolerance) {
+        const QDoubleVector2D offset = mercatorCenter - m_circlePathCenter;
+        for (QDoubleVector2D &point : m_circlePath)
+            point += offset;
+        m_circlePathCenter = mercatorCenter;
+        return;
+    }
+
+    m_circlePath.clear();
+    m_circlePathCenter = mercatorCenter;
+    m_circlePathLatitude = center.latitude();
+    m_circlePathRadius = radius;
+    m_circlePathSurface = surface;
+    if (surface == QLocation::ReferenceSurface::Map || isLocallyFlat(center, radius))
+        calculatePeripheralPointsSimple(m_circlePath, center, radius, p, CircleSamples);
+    else
+        calculatePeripheralPointsGreatCircle(m_circlePath, center, radius, p, CircleSamples);
+}
+
 int QDeclarativeCircleMapItemPrivate::crossEarthPole(const QGeoCoordinate &center, qreal distance)
 {
-    qreal poleLat = 90;
-    QGeoCoordinate northPole = QGeoCoordinate(poleLat, center.longitude());
-    QGeoCoordinate southPole = QGeoCoordinate(-poleLat, center.longitude());
-    // approximate using great circle distance
-    qreal distanceToNorthPole = center.distanceTo(northPole);
-    qreal distanceToSouthPole = center.distanceTo(southPole);
+    // The great circle distance to a pole is along the meridian
+    const qreal distanceToNorthPole = QLocationUtils::radians(90.0 - center.latitude())
+                                    * QLocationUtils::earthMeanRadius();
+    const qreal distanceToSouthPole = QLocationUtils::radians(90.0 + center.latitude())
+                                    * QLocationUtils::earthMeanRadius();
     return (distanceToNorthPole < distance? 1 : 0) +
            (distanceToSouthPole < distance? 1 : 0);
 }
 
+/*
+ * Returns the cosine and sine of the azimuths of the perimeter points. The
+ * table for CircleSamples is computed once and shared by all circles.
+ */
+QList<QDoubleVector2D> QDeclarativeCircleMapItemPrivate::unitCircle(int steps)
+{
+    const auto compute = [](int steps) {
+        QList<QDoubleVector2D> points;
+        points.reserve(steps);
+        for (int i = 0; i < steps; ++i) {
+            const qreal rad = 2 * M_PI * i / steps;
+            points << QDoubleVector2D(std::cos(rad), std::sin(rad));
+        }
+        return points;
+    };
+    if (steps == CircleSamples) {
+        static const QList<QDoubleVector2D> samples = compute(CircleSamples);
+        return samples;
+    }
+    return compute(steps);
+}
+
+/*
+ * Returns whether the circle scaled around its center in Web Mercator, as
+ * calculatePeripheralPointsSimple() computes it, is within
+ * PerimeterTolerance of the great circle perimeter. Mercator is conformal,
+ * so the difference comes from its scale changing across the circle, by
+ * about tan(latitude) * distance / R, and from the curvature of the earth,
+ * by about (distance / R)^2.
+ */
+bool QDeclarativeCircleMapItemPrivate::isLocallyFlat(const QGeoCoordinate &center, qreal distance)
+{
+    const qreal ratio = distance / QLocationUtils::earthMeanRadius();
+    const qreal tanLat = qAbs(std::tan(QLocationUtils::radians(center.latitude())));
+    return ratio * (tanLat + ratio) <= PerimeterTolerance;
+}
+
 void QDeclarativeCircleMapItemPrivate::calculatePeripheralPointsSimple(QList<QDoubleVector2D> &path,
                                       const QGeoCoordinate &center,
                                       qreal distance,
                                       const QGeoProjectionWebMercator &p,
                                       int steps)
 {
-    const double lambda = 0.0001;
+    // A unit of Web Mercator along the parallel of the center is as long
+    // as the parallel
     const QDoubleVector2D c = p.geoToMapProjection(center);
-    const double lambda_geo = center.distanceTo(p.mapProjectionToGeo(c + QDoubleVector2D(lambda, 0)));
-    const qreal mapDistance = distance * lambda / lambda_geo;
-
-    for (int i = 0; i < steps; ++i) {
-        const qreal rad = 2 * M_PI * i / steps;
-        path << c + QDoubleVector2D(cos(rad), sin(rad)) * mapDistance;
-    }
+    const qreal parallelLength = 2 * M_PI * QLocationUtils::earthMeanRadius()
+                               * std::cos(QLocationUtils::radians(center.latitude()));
+    const qreal mapDistance = distance / parallelLength;
+
+    const QList<QDoubleVector2D> unit = unitCircle(steps);
+    path.reserve(path.size() + unit.size());
+    for (const QDoubleVector2D &direction : unit)
+        path << c + direction * mapDistance;
 }
 
 void QDeclarativeCircleMapItemPrivate::calculatePeripheralPointsGreatCircle(QList<QDoubleVector2D> &path,
@@ -446,11 +577,12 @@ void QDeclarativeCircleMapItemPrivate::calculatePeripheralPointsGreatCircle(QLis
     qreal sinRatio = std::sin(ratio);
     qreal sinLatRad_x_cosRatio = sinLatRad * cosRatio;
     qreal cosLatRad_x_sinRatio = cosLatRad * sinRatio;
-    for (int i = 0; i < steps; ++i) {
-        const qreal azimuthRad = 2 * M_PI * i / steps;
+    const QList<QDoubleVector2D> unit = unitCircle(steps);
+    path.reserve(path.size() + unit.size());
+    for (const QDoubleVector2D &azimuth : unit) {
         const qreal resultLatRad = std::asin(sinLatRad_x_cosRatio
-                                 + cosLatRad_x_sinRatio * std::cos(azimuthRad));
-        const qreal resultLonRad = lonRad + std::atan2(std::sin(azimuthRad) * cosLatRad_x_sinRatio,
+                                 + cosLatRad_x_sinRatio * azimuth.x());
+        const qreal resultLonRad = lonRad + std::atan2(azimuth.y() * cosLatRad_x_sinRatio,
                                    cosRatio - sinLatRad * std::sin(resultLatRad));
         const qreal lat2 = QLocationUtils::degrees(resultLatRad);
         qreal lon2 =  QLocationUtils::degrees(resultLonRad);
@@ -505,7 +637,7 @@ void QDeclarativeCircleMapItemPrivateCPU::updatePolish()
             if (circlePath.at(i).x() > centerX)
                 circlePath[i].setX(circlePath.at(i).x() - 1.0);
         }
-        QRectF cameraRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(p.visibleGeometry());
+        QRectF cameraRect = p.visibleGeometryBoundingRect();
         const QRectF circleRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(circlePath);
         QGeoMapPolygonGeometry::MapBorderBehaviour wrappingMode = QGeoMapPolygonGeometry::DrawOnce;
         QList<QDoubleVector2D> surroundingRect;
@@ -563,4 +695,100 @@ bool QDeclarativeCircleMapItemPrivateCPU::contains(const QPointF &point) const
     return m_shape->contains(m_circle.mapToItem(m_shape, point));
 }
 
+QDeclarativeCircleMapItemPrivateGPU::QDeclarativeCircleMapItemPrivateGPU(QDeclarativeCircleMapItem &circle)
+    : QDeclarativeCircleMapItemPrivate(circle)
+{
+}
+
+QDeclarativeCircleMapItemPrivateGPU::~QDeclarativeCircleMapItemPrivateGPU()
+{
+}
+
+void QDeclarativeCircleMapItemPrivateGPU::regenerateCache()
+{
+    updateCirclePath();
+    if (!m_circle.map() || m_circle.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator
+            || !m_circle.m_circle.isValid() || m_circlePath.isEmpty()) {
+        m_mesh.setRings({});
+        return;
+    }
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
+    const QGeoCoordinate &center = m_circle.m_circle.center();
+    const qreal radius = m_circle.m_circle.radius();
+    const qreal centerX = p.geoToMapProjection(center).x();
+    QList<QDoubleVector2D> circlePath = m_circlePath;
+
+    // Same shapes as the CPU backend, but independent of the camera apart
+    // from where the one pole case is cut, as they are triangulated once
+    const int crossingPoles = m_circle.referenceSurface() == QLocation::ReferenceSurface::Globe
+            ? crossEarthPole(center, radius) : 0;
+    if (crossingPoles == 1) {
+        includeOnePoleInPath(circlePath, center, radius, p);
+        m_mesh.setRings({ circlePath });
+    } else if (crossingPoles == 2) {
+        // A world wide rectangle with the circle as a hole
+        for (QDoubleVector2D &point : circlePath) {
+            if (point.x() > centerX)
+                point.setX(point.x() - 1.0);
+        }
+        const QList<QDoubleVector2D> surroundingRect = {{centerX - 1.0, -0.1}, {centerX, -0.1},
+                                                        {centerX, 1.1}, {centerX - 1.0, 1.1}};
+        m_mesh.setRings({ surroundingRect, circlePath });
+    } else {
+        m_mesh.setRings({ QGeoMapItemMesh::unwrapped(circlePath, centerX) });
+    }
+}
+
+void QDeclarativeCircleMapItemPrivateGPU::updatePolish()
+{
+    const QGeoMap *map = m_circle.map();
+    if (m_mesh.isEmpty() || !map || !m_circle.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        m_circle.setWidth(0);
+        m_circle.setHeight(0);
+        return;
+    }
+    QScopedValueRollback<bool> rollback(m_circle.m_updatingGeometry);
+    m_circle.m_updatingGeometry = true;
+
+    // The circle is placed by the transformation, the item bounds it for
+    // hit testing
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QRectF rect = QGeoMapItemMesh::itemRect(*m_circle.quickMap(), p, m_mesh.origin(),
+                                                  m_mesh.bounds(), 0.5 * m_circle.m_border.width() + 1);
+    m_circle.setPosition(rect.topLeft());
+    m_circle.setSize(rect.size());
+    m_mesh.updateTessellation(m_circle.quickMap()->zoomLevel());
+}
+
+QSGNode *QDeclarativeCircleMapItemPrivateGPU::updateMapItemPaintNode(QSGNode *oldNode,
+                                                                     QQuickItem::UpdatePaintNodeData * /*data*/)
+{
+    const QGeoMap *map = m_circle.map();
+    if (m_mesh.isEmpty() || !map || !m_circle.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    return m_mesh.updatePaintNode(oldNode,
+                                  QGeoMapItemMesh::mapMatrix(m_circle, *m_circle.quickMap(), p, m_mesh.origin()),
+                                  m_circle.color(), m_circle.m_border.color(), m_circle.m_border.width());
+}
+
+bool QDeclarativeCircleMapItemPrivateGPU::contains(const QPointF &point) const
+{
+    const QGeoMap *map = m_circle.map();
+    if (m_mesh.isEmpty() || !map || !m_circle.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        return false;
+    }
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QPointF mapPoint = m_circle.mapToItem(m_circle.quickMap(), point);
+    const QDoubleVector2D mercator = p.itemPositionToWrappedMapProjection(QDoubleVector2D(mapPoint));
+    return m_mesh.contains(mercator - QGeoMapItemMesh::wrappedOrigin(m_mesh.origin(), p));
+}
+
 QT_END_NAMESPACE
@@ -35,8 +35,15 @@ class Q_LOCATION_EXPORT QDeclarativeCircleMapItem : public QDeclarativeGeoMapIte
     Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
     Q_PROPERTY(QDeclarativeMapLineProperties *border READ border CONSTANT)
+    Q_PROPERTY(Backend backend READ backend WRITE setBackend NOTIFY backendChanged REVISION(6, 9))
 
 public:
+    enum Backend {
+        Software = 0,
+        Shader = 1
+    };
+    Q_ENUM(Backend)
+
     explicit QDeclarativeCircleMapItem(QQuickItem *parent = nullptr);
     ~QDeclarativeCircleMapItem() override;
 
@@ -58,14 +65,19 @@ public:
     const QGeoShape &geoShape() const override;
     void setGeoShape(const QGeoShape &shape) override;
 
+    Backend backend() const;
+    void setBackend(Backend backend);
+
 Q_SIGNALS:
     void centerChanged(const QGeoCoordinate &center);
     void radiusChanged(qreal radius);
     void colorChanged(const QColor &color);
+    Q_REVISION(6, 9) void backendChanged();
 
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void updatePolish() override;
+    void updateBackend();
 
 protected Q_SLOTS:
     void markSourceDirtyAndUpdate();
@@ -80,11 +92,15 @@ private:
     QDeclarativeMapLineProperties m_border;
     QColor m_color;
     bool m_updatingGeometry;
+    Backend m_backend = Software;
+    // The backend of m_d, Software when the scene graph can't run shaders
+    Backend m_activeBackend = Software;
 
     std::unique_ptr<QDeclarativeCircleMapItemPrivate> m_d;
 
     friend class QDeclarativeCircleMapItemPrivate;
     friend class QDeclarativeCircleMapItemPrivateCPU;
+    friend class QDeclarativeCircleMapItemPrivateGPU;
 };
 
 //////////////////////////////////////////////////////////////////////
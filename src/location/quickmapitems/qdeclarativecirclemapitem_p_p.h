@@ -55,18 +55,7 @@ public:
     virtual QSGNode * updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) = 0;
     virtual bool contains(const QPointF &point) const = 0;
 
-    void updateCirclePath()
-    {
-        if (!m_circle.map() || m_circle.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
-            return;
-
-        m_circlePath.clear();
-        const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_circle.map()->geoProjection());
-        if (m_circle.referenceSurface() == QLocation::ReferenceSurface::Map)
-            calculatePeripheralPointsSimple(m_circlePath, m_circle.center(), m_circle.radius(), p, CircleSamples);
-        else
-            calculatePeripheralPointsGreatCircle(m_circlePath, m_circle.center(), m_circle.radius(), p, CircleSamples);
-    }
+    void updateCirclePath();
 
     static int crossEarthPole(const QGeoCoordinate &center, qreal distance);
 
@@ -79,8 +68,21 @@ public:
     static void calculatePeripheralPointsGreatCircle(QList<QDoubleVector2D> &path, const QGeoCoordinate &center,
                                    qreal distance, const QGeoProjectionWebMercator &p, int steps);
 
+    static QList<QDoubleVector2D> unitCircle(int steps);
+    static bool isLocallyFlat(const QGeoCoordinate &center, qreal distance);
+
+    // Relative error allowed in the perimeter, which is sub-pixel for circles
+    // of up to a thousand pixels
+    static constexpr double PerimeterTolerance = 1e-3;
+
     QDeclarativeCircleMapItem &m_circle;
     QList<QDoubleVector2D> m_circlePath;
+    // What m_circlePath was computed for. Its shape in Web Mercator only
+    // depends on the latitude of the center and on the radius.
+    QDoubleVector2D m_circlePathCenter;
+    qreal m_circlePathLatitude = qQNaN();
+    qreal m_circlePathRadius = qQNaN();
+    QLocation::ReferenceSurface m_circlePathSurface = QLocation::ReferenceSurface::Map;
 };
 
 class Q_LOCATION_EXPORT QDeclarativeCircleMapItemPrivateCPU: public QDeclarativeCircleMapItemPrivate
@@ -127,6 +129,49 @@ public:
     QDeclarativeGeoMapPainterPath *m_painterPath = nullptr;
 };
 
+// Fills the circle on the GPU, like QDeclarativePolygonMapItemPrivateGPU
+class Q_LOCATION_EXPORT QDeclarativeCircleMapItemPrivateGPU: public QDeclarativeCircleMapItemPrivate
+{
+public:
+    QDeclarativeCircleMapItemPrivateGPU(QDeclarativeCircleMapItem &circle);
+    ~QDeclarativeCircleMapItemPrivateGPU() override;
+
+    void onLinePropertiesChanged() override
+    {
+        // Border width and color are uniforms of the shaders
+        m_circle.update();
+    }
+    void markSourceDirtyAndUpdate() override
+    {
+        m_circle.polishAndUpdate();
+    }
+    void regenerateCache();
+    void onMapSet() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryChanged() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onItemGeometryChanged() override
+    {
+        onGeoGeometryChanged();
+    }
+    void afterViewportChanged() override
+    {
+        // The polish picks the tessellation for the new zoom level
+        markSourceDirtyAndUpdate();
+    }
+    void updatePolish() override;
+    QSGNode *updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) override;
+    bool contains(const QPointF &point) const override;
+
+    QGeoMapItemMesh m_mesh;
+};
+
 QT_END_NAMESPACE
 
 #endif // QDECLARATIVECIRCLEMAPITEM_P_P_H
@@ -9,6 +9,7 @@
 #include "qgeocameracapabilities_p.h"
 #include "qgeomap_p.h"
 #include "qgeoprojection_p.h"
+#include <QtCore/QtMath>
 #include <QtPositioning/QGeoCircle>
 #include <QtPositioning/QGeoRectangle>
 #include <QtPositioning/QGeoPath>
@@ -17,7 +18,9 @@
 #include <QtQuick/QSGRectangleNode>
 #include <QtQml/qqmlinfo.h>
 #include <QtQuick/private/qquickitem_p.h>
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 #ifndef M_PI
 #define M_PI 3.141592653589793238463
@@ -202,6 +205,15 @@ QDeclarativeGeoMap::~QDeclarativeGeoMap()
     for (auto mi: mapItems)
         removeMapItem_real(mi.data());
 
+    // Items still queued are no longer on this map, they polish themselves
+    const QList<QPointer<QDeclarativeGeoMapItemBase> > itemsToPolish = std::exchange(m_itemsToPolish, {});
+    for (const QPointer<QDeclarativeGeoMapItemBase> &item : itemsToPolish) {
+        if (item && item->m_mapPolishPending) {
+            item->m_mapPolishPending = false;
+            item->polish();
+        }
+    }
+
     if (m_copyrights.data())
         delete m_copyrights.data();
     m_copyrights.clear();
@@ -297,7 +309,15 @@ void QDeclarativeGeoMap::initialize()
 void QDeclarativeGeoMap::pluginReady()
 {
     QGeoServiceProvider *provider = m_plugin->sharedGeoServiceProvider();
-    m_mappingManager = provider->mappingManager();
+    QGeoMappingManager *mappingManager = provider->mappingManager();
+    if (m_mappingManager && mappingManager == m_mappingManager)
+        return;
+
+    // The Plugin attached to another provider, for example because its locale
+    // changed while other Plugins shared its provider
+    if (m_mappingManager)
+        releaseMap();
+    m_mappingManager = mappingManager;
 
     if (provider->mappingError() != QGeoServiceProvider::NoError) {
         setError(provider->mappingError(), provider->mappingErrorString());
@@ -316,10 +336,43 @@ void QDeclarativeGeoMap::pluginReady()
     } else {
         mappingManagerInitialized();
     }
+}
+
+/*!
+    \internal
+
+    Drops the map created by the current mapping manager, before the map of
+    another one is created. The map items stay on the Map and are added to
+    the new map.
+*/
+void QDeclarativeGeoMap::releaseMap()
+{
+    disconnect(m_mappingManager, nullptr, this, nullptr);
+    m_mappingManager = nullptr;
+    if (!m_map)
+        return;
 
-    // make sure this is only called once
-    disconnect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
-               this, &QDeclarativeGeoMap::pluginReady);
+    if (m_window) {
+        disconnect(m_window, &QQuickWindow::beforeSynchronizing,
+                   this, &QDeclarativeGeoMap::updateItemToWindowTransform);
+    }
+    m_map->clearMapItems();
+    for (const QPointer<QDeclarativeGeoMapItemBase> &item : std::as_const(m_mapItems)) {
+        if (item)
+            item->setMap(nullptr, nullptr);
+    }
+
+    if (m_copyrights.data())
+        delete m_copyrights.data();
+    m_copyrights.clear();
+
+    delete m_map;
+    m_mapReleased = true;
+    if (m_initialized) {
+        m_initialized = false;
+        emit mapReadyChanged(false);
+    }
+    update();
 }
 
 /*!
@@ -375,6 +428,12 @@ QSGNode *QDeclarativeGeoMap::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeDa
     root->setColor(m_color);
 
     QSGNode *content = root->childCount() ? root->firstChild() : 0;
+    // The node of a released map is of no use to the map replacing it
+    if (content && m_mapReleased) {
+        delete content;
+        content = nullptr;
+    }
+    m_mapReleased = false;
     content = m_map->updateSceneGraph(content, window());
     if (content && root->childCount() == 0)
         root->appendChildNode(content);
@@ -400,12 +459,11 @@ void QDeclarativeGeoMap::setPlugin(QDeclarativeGeoServiceProvider *plugin)
     m_plugin = plugin;
     emit pluginChanged(m_plugin);
 
-    if (m_plugin->isAttached()) {
+    // The Plugin attaches again when it moves to another provider
+    connect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
+            this, &QDeclarativeGeoMap::pluginReady);
+    if (m_plugin->isAttached())
         pluginReady();
-    } else {
-        connect(m_plugin, &QDeclarativeGeoServiceProvider::attached,
-                this, &QDeclarativeGeoMap::pluginReady);
-    }
 }
 
 /*!
@@ -428,7 +486,7 @@ void QDeclarativeGeoMap::onCameraCapabilitiesChanged(const QGeoCameraCapabilitie
 
 /*!
     \internal
-    this function will only be ever called once
+    called once for every mapping manager the map uses
 */
 void QDeclarativeGeoMap::mappingManagerInitialized()
 {
@@ -1323,6 +1381,196 @@ QPointF QDeclarativeGeoMap::fromCoordinate(const QGeoCoordinate &coordinate, boo
         return QPointF(qQNaN(), qQNaN());
 }
 
+static constexpr qreal HitTestCellSize = 64;
+// Items covering more cells are tested for every query
+static constexpr int HitTestMaximumCells = 64;
+
+static inline quint64 hitTestCell(int x, int y)
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+/*!
+    \qmlmethod list<MapItem> QtLocation::Map::itemsAt(point point, real radius)
+    \since QtLocation 6.9
+
+    Returns the visible map items that are closer than \a radius pixels to
+    \a point, relative to the map item. With the default \a radius of 0,
+    these are the items containing \a point. Items with a higher z value
+    come first.
+
+    Like \l {Item::contains}{contains()}, lines are hit along their stroke
+    and other items within their shape, rather than their bounding box.
+
+    The query uses a screen space index of the items, which is rebuilt
+    after the map or the items move, so repeated queries between two
+    camera changes are cheap.
+
+    \sa mapItems, fromCoordinate
+*/
+QList<QObject *> QDeclarativeGeoMap::itemsAt(const QPointF &point, qreal radius)
+{
+    QList<QObject *> result;
+    if (!m_map || m_mapItems.isEmpty())
+        return result;
+    radius = qMax(radius, qreal(0));
+
+    if (m_hitTestDirty)
+        updateHitTestIndex();
+
+    QList<qsizetype> candidates = m_hitTestLargeItems;
+    const int left = qFloor((point.x() - radius) / HitTestCellSize);
+    const int right = qFloor((point.x() + radius) / HitTestCellSize);
+    const int top = qFloor((point.y() - radius) / HitTestCellSize);
+    const int bottom = qFloor((point.y() + radius) / HitTestCellSize);
+    for (int x = left; x <= right; ++x) {
+        for (int y = top; y <= bottom; ++y) {
+            const auto it = m_hitTestGrid.constFind(hitTestCell(x, y));
+            if (it != m_hitTestGrid.cend())
+                candidates.append(it.value());
+        }
+    }
+    // Items spanning several cells are found more than once
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    const qreal radiusSqr = radius * radius;
+    QList<QDeclarativeGeoMapItemBase *> hits;
+    for (qsizetype i : std::as_const(candidates)) {
+        QDeclarativeGeoMapItemBase *item = m_hitTestItems.at(i).data();
+        if (!item || !item->isVisible() || item->mapItemOpacity() <= 0)
+            continue;
+        const QRectF &rect = m_hitTestRects.at(i);
+        const qreal dx = qMax(qMax(rect.left() - point.x(), point.x() - rect.right()), qreal(0));
+        const qreal dy = qMax(qMax(rect.top() - point.y(), point.y() - rect.bottom()), qreal(0));
+        if (dx * dx + dy * dy > radiusSqr)
+            continue;
+        if (item->hitTest(item->mapFromItem(this, point), radius))
+            hits.append(item);
+    }
+
+    std::stable_sort(hits.begin(), hits.end(),
+                     [](const QDeclarativeGeoMapItemBase *a, const QDeclarativeGeoMapItemBase *b) {
+        return a->z() > b->z();
+    });
+    result.reserve(hits.size());
+    for (QDeclarativeGeoMapItemBase *item : std::as_const(hits))
+        result.append(item);
+    return result;
+}
+
+/*!
+    \internal
+
+    Queues \a item to be polished on the next polish of the map. The items
+    that change within a frame, typically all of them when the camera
+    moves, are then polished in a single pass, which shares the projection
+    state of the frame, instead of being interleaved with the polish of
+    unrelated items.
+*/
+void QDeclarativeGeoMap::schedulePolish(QDeclarativeGeoMapItemBase *item)
+{
+    if (item->m_mapPolishPending)
+        return;
+    item->m_mapPolishPending = true;
+    m_itemsToPolish.append(item);
+    polish();
+}
+
+/*!
+    \internal
+
+    Takes \a item off the items waiting for the polish of the map, when it
+    leaves the map. Returns whether it was waiting.
+*/
+bool QDeclarativeGeoMap::unschedulePolish(QDeclarativeGeoMapItemBase *item)
+{
+    if (!item->m_mapPolishPending)
+        return false;
+    item->m_mapPolishPending = false;
+    m_itemsToPolish.removeAll(item);
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMap::updatePolish()
+{
+    // Items queued while polishing wait for the next polish of the map
+    const QList<QPointer<QDeclarativeGeoMapItemBase> > items = std::exchange(m_itemsToPolish, {});
+    for (const QPointer<QDeclarativeGeoMapItemBase> &i : items) {
+        QDeclarativeGeoMapItemBase *item = i.data();
+        // Already polished on demand, see updateHitTestIndex()
+        if (!item || !item->m_mapPolishPending)
+            continue;
+        item->m_mapPolishPending = false;
+        if (item->quickMap_ == this)
+            item->updatePolish();
+        else
+            item->polishAndUpdate(); // moved to another map, or removed
+    }
+}
+
+/*!
+    \internal
+
+    Marks the item bounds used by itemsAt() as outdated. Called whenever the
+    camera, the map size or the geometry of an item changes.
+*/
+void QDeclarativeGeoMap::invalidateHitTestIndex()
+{
+    m_hitTestDirty = true;
+}
+
+/*!
+    \internal
+
+    Buckets the bounding rectangles of the map items, in map coordinates,
+    into a uniform grid of HitTestCellSize pixels. Only the part of the
+    items inside the map is indexed.
+*/
+void QDeclarativeGeoMap::updateHitTestIndex()
+{
+    m_hitTestItems.clear();
+    m_hitTestRects.clear();
+    m_hitTestGrid.clear();
+    m_hitTestLargeItems.clear();
+
+    const QRectF mapRect = boundingRect();
+    for (const QPointer<QDeclarativeGeoMapItemBase> &i : std::as_const(m_mapItems)) {
+        QDeclarativeGeoMapItemBase *item = i.data();
+        if (!item)
+            continue;
+        // Items are positioned on polish, bring the stale ones up to date
+        if (item->isPolishScheduled()) {
+            item->m_mapPolishPending = false;
+            item->updatePolish();
+        }
+        const QRectF rect = item->mapRectToItem(this, item->boundingRect());
+        const int left = qFloor(qMax(rect.left(), mapRect.left()) / HitTestCellSize);
+        const int right = qFloor(qMin(rect.right(), mapRect.right()) / HitTestCellSize);
+        const int top = qFloor(qMax(rect.top(), mapRect.top()) / HitTestCellSize);
+        const int bottom = qFloor(qMin(rect.bottom(), mapRect.bottom()) / HitTestCellSize);
+        if (left > right || top > bottom)
+            continue;
+
+        const qsizetype index = m_hitTestItems.size();
+        m_hitTestItems.append(i);
+        m_hitTestRects.append(rect);
+        if ((right - left + 1) * (bottom - top + 1) > HitTestMaximumCells) {
+            m_hitTestLargeItems.append(index);
+            continue;
+        }
+        for (int x = left; x <= right; ++x) {
+            for (int y = top; y <= bottom; ++y)
+                m_hitTestGrid[hitTestCell(x, y)].append(index);
+        }
+    }
+    // Polishing the items above reported their geometry changes
+    m_hitTestDirty = false;
+}
+
 /*!
     \qmlmethod void QtLocation::Map::pan(int dx, int dy)
 
@@ -1373,6 +1621,57 @@ void QDeclarativeGeoMap::clearData()
         m_map->clearData();
 }
 
+/*!
+    \qmlmethod void QtLocation::Map::trimData(enumeration level)
+    \since QtLocation 6.9
+
+    Releases map data kept in memory by the currently selected plugin, for
+    instance when the system is running low on memory. The tiles shown
+    remain, and the released data is loaded again as needed.
+
+    \value Map.TrimTextures
+        (default) Releases the decoded tiles that are not shown.
+    \value Map.TrimMemory
+        Also releases the tiles cached in memory. Only the cached files
+        remain.
+
+    \sa clearData(), cacheStatistics()
+*/
+void QDeclarativeGeoMap::trimData(TrimLevel level)
+{
+    if (m_map)
+        m_map->trimData(QAbstractGeoTileCache::TrimLevel(level));
+}
+
+/*!
+    \qmlmethod object QtLocation::Map::cacheStatistics()
+    \since QtLocation 6.9
+
+    Returns statistics of the tile cache of the currently selected plugin,
+    which the maps using the plugin share. The object has the properties:
+
+    \list
+    \li \c texture, \c memory and \c disk: the tiers of the cache, each
+        with the number of \c hits, \c misses and \c evictions, the number
+        of \c tiles held, and their \c usage and \c maxUsage, in bytes
+        unless the plugin counts tiles instead.
+    \li \c decodeTimes and \c diskReadTimes: histograms of the times taken
+        to decode tiles and to read them from disk. Each has the \c count
+        and the \c total time, in milliseconds, the counts of the
+        \c buckets, and the \c limits of the buckets, in milliseconds. The
+        last bucket counts the times above the last limit.
+    \endlist
+
+    Maps without a tile cache return empty tiers.
+
+    \sa trimData()
+*/
+QVariantMap QDeclarativeGeoMap::cacheStatistics() const
+{
+    return m_map ? m_map->cacheStatistics().toVariantMap()
+                 : QGeoTileCacheStatistics().toVariantMap();
+}
+
 /*!
     \qmlmethod void QtLocation::Map::fitViewportToGeoShape(geoShape, margins)
 
@@ -1540,6 +1839,7 @@ void QDeclarativeGeoMap::onCameraDataChanged(const QGeoCameraData &cameraData)
     bool zoomHasChanged = cameraData.zoomLevel() != m_cameraData.zoomLevel();
 
     m_cameraData = cameraData;
+    invalidateHitTestIndex();
     // polish map items
     for (const QPointer<QDeclarativeGeoMapItemBase> &i: std::as_const(m_mapItems)) {
         if (i)
@@ -1603,17 +1903,19 @@ QList<QObject *> QDeclarativeGeoMap::mapItems()
 void QDeclarativeGeoMap::addMapItem(QDeclarativeGeoMapItemBase *item)
 {
     if (addMapItem_real(item))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::addMapItem_real(QDeclarativeGeoMapItemBase *item)
 {
-    if (!item || item->quickMap())
+    if (!item || item->quickMap() || mapItemSlot(item) >= 0)
         return false;
     // If the item comes from a MapItemGroup, do not reparent it.
     if (!qobject_cast<QDeclarativeGeoMapItemGroup *>(item->parentItem()))
         item->setParentItem(this);
+    m_mapItemSlots.insert(item, m_mapItems.size());
     m_mapItems.append(item);
+    invalidateHitTestIndex();
     if (m_map) {
         item->setMap(this, m_map);
         m_map->addMapItem(item);
@@ -1633,26 +1935,139 @@ bool QDeclarativeGeoMap::addMapItem_real(QDeclarativeGeoMapItemBase *item)
 void QDeclarativeGeoMap::removeMapItem(QDeclarativeGeoMapItemBase *ptr)
 {
     if (removeMapItem_real(ptr))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::removeMapItem_real(QDeclarativeGeoMapItemBase *ptr)
 {
     if (!ptr)
         return false;
-    QPointer<QDeclarativeGeoMapItemBase> item(ptr);
-    if (!m_mapItems.contains(item))
+    const qsizetype slot = mapItemSlot(ptr);
+    if (slot < 0)
         return false;
+    m_mapItemSlots.remove(ptr);
+    releaseMapItemSlot(slot);
+    invalidateHitTestIndex();
     if (m_map)
         m_map->removeMapItem(ptr);
-    if (item->parentItem() == this)
-        item->setParentItem(0);
-    item->setMap(0, 0);
-    // these can be optimized for perf, as we already check the 'contains' above
-    m_mapItems.removeOne(item);
+    if (ptr->parentItem() == this)
+        ptr->setParentItem(0);
+    ptr->setMap(0, 0);
     return true;
 }
 
+/*!
+    \internal
+
+    Returns the slot of \a item in m_mapItems, or -1 if the item isn't on
+    the map. Entries left behind by items destroyed before the map was
+    initialized point to a slot that no longer holds them, and are ignored.
+*/
+qsizetype QDeclarativeGeoMap::mapItemSlot(QDeclarativeGeoMapItemBase *item) const
+{
+    const auto it = m_mapItemSlots.constFind(item);
+    if (it == m_mapItemSlots.cend() || it.value() >= m_mapItems.size()
+            || m_mapItems.at(it.value()) != item) {
+        return -1;
+    }
+    return it.value();
+}
+
+/*!
+    \internal
+
+    Removes \a slot from m_mapItems in constant time, by moving the last
+    item into it.
+*/
+void QDeclarativeGeoMap::releaseMapItemSlot(qsizetype slot)
+{
+    const qsizetype last = m_mapItems.size() - 1;
+    if (slot != last) {
+        m_mapItems[slot] = m_mapItems.at(last);
+        if (QDeclarativeGeoMapItemBase *moved = m_mapItems.at(slot).data())
+            m_mapItemSlots[moved] = slot;
+    }
+    m_mapItems.removeLast();
+}
+
+/*!
+    \qmlmethod void QtLocation::Map::addMapItems(list<MapItem> items)
+
+    Adds the given \a items to the Map. The list can contain map items, as
+    well as \l MapItemGroup and \l MapItemView objects. Objects already on
+    the map are skipped. Unlike calling \l addMapItem for every item, the
+    \l mapItems property is notified only once.
+
+    \sa mapItems, removeMapItems, addMapItem
+
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoMap::addMapItems(const QVariantList &items)
+{
+    beginMapItemsChange();
+    for (const QVariant &i : items) {
+        if (addMapChild(i.value<QObject *>()))
+            notifyMapItemsChanged();
+    }
+    endMapItemsChange();
+}
+
+/*!
+    \qmlmethod void QtLocation::Map::removeMapItems(list<MapItem> items)
+
+    Removes the given \a items from the Map. The list can contain map items,
+    as well as \l MapItemGroup and \l MapItemView objects. Objects which are
+    not on the map are skipped. Unlike calling \l removeMapItem for every
+    item, the \l mapItems property is notified only once.
+
+    \sa mapItems, addMapItems, removeMapItem, clearMapItems
+
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoMap::removeMapItems(const QVariantList &items)
+{
+    beginMapItemsChange();
+    for (const QVariant &i : items) {
+        if (removeMapChild(i.value<QObject *>()))
+            notifyMapItemsChanged();
+    }
+    endMapItemsChange();
+}
+
+/*!
+    \internal
+
+    Defers the mapItemsChanged() notifications until the matching
+    endMapItemsChange(), where at most one is emitted. Calls can be nested.
+*/
+void QDeclarativeGeoMap::beginMapItemsChange()
+{
+    ++m_mapItemsChangeDepth;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMap::endMapItemsChange()
+{
+    Q_ASSERT(m_mapItemsChangeDepth > 0);
+    if (--m_mapItemsChangeDepth == 0 && m_mapItemsChangePending) {
+        m_mapItemsChangePending = false;
+        emit mapItemsChanged();
+    }
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMap::notifyMapItemsChanged()
+{
+    if (m_mapItemsChangeDepth > 0)
+        m_mapItemsChangePending = true;
+    else
+        emit mapItemsChanged();
+}
+
 /*!
     \qmlmethod void QtLocation::Map::clearMapItems()
 
@@ -1682,11 +2097,18 @@ void QDeclarativeGeoMap::clearMapItems()
         }
     }
 
-    while (!m_mapItems.isEmpty())
-        removed += removeMapItem_real(m_mapItems.first());
+    // Removing from the back doesn't move any item between slots
+    while (!m_mapItems.isEmpty()) {
+        QDeclarativeGeoMapItemBase *item = m_mapItems.last().data();
+        if (item)
+            removed += removeMapItem_real(item);
+        else
+            m_mapItems.removeLast(); // destroyed before the map was initialized
+    }
+    m_mapItemSlots.clear();
 
     if (removed)
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 /*!
@@ -1702,7 +2124,7 @@ void QDeclarativeGeoMap::clearMapItems()
 void QDeclarativeGeoMap::addMapItemGroup(QDeclarativeGeoMapItemGroup *itemGroup)
 {
     if (addMapItemGroup_real(itemGroup))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::addMapItemGroup_real(QDeclarativeGeoMapItemGroup *itemGroup)
@@ -1738,7 +2160,7 @@ bool QDeclarativeGeoMap::addMapItemGroup_real(QDeclarativeGeoMapItemGroup *itemG
 void QDeclarativeGeoMap::removeMapItemGroup(QDeclarativeGeoMapItemGroup *itemGroup)
 {
     if (removeMapItemGroup_real(itemGroup))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::removeMapItemGroup_real(QDeclarativeGeoMapItemGroup *itemGroup)
@@ -1773,7 +2195,7 @@ bool QDeclarativeGeoMap::removeMapItemGroup_real(QDeclarativeGeoMapItemGroup *it
 void QDeclarativeGeoMap::removeMapItemView(QDeclarativeGeoMapItemView *itemView)
 {
     if (removeMapItemView_real(itemView))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::removeMapItemView_real(QDeclarativeGeoMapItemView *itemView)
@@ -1820,7 +2242,7 @@ void QDeclarativeGeoMap::onSGNodeChanged()
 void QDeclarativeGeoMap::addMapItemView(QDeclarativeGeoMapItemView *itemView)
 {
     if (addMapItemView_real(itemView))
-        emit mapItemsChanged();
+        notifyMapItemsChanged();
 }
 
 bool QDeclarativeGeoMap::addMapItemView_real(QDeclarativeGeoMapItemView *itemView)
@@ -1873,6 +2295,7 @@ QGeoMapType QDeclarativeGeoMap::activeMapType() const
 void QDeclarativeGeoMap::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     QQuickItem::geometryChange(newGeometry, oldGeometry);
+    invalidateHitTestIndex();
 
     if (!m_map || newGeometry.size().isEmpty())
         return;
@@ -1976,6 +2399,18 @@ void QDeclarativeGeoMap::fitViewportToMapItemsRefine(const QList<QPointer<QDecla
     if (mapItems.size() == 0)
         return;
 
+    const bool webMercator =
+            m_map->geoProjection().projectionType() == QGeoProjection::ProjectionWebMercator;
+    if (refine && webMercator) {
+        // Fit the geographic bounds of the items first. Only MapQuickItems, whose size on
+        // the screen does not follow the zoom level, need to be refined on the screen.
+        bool haveQuickItem = false;
+        fitViewportToMapItemBounds(mapItems, onlyVisible, &haveQuickItem);
+        if (haveQuickItem)
+            fitViewportToMapItemsRefine(mapItems, false, onlyVisible);
+        return;
+    }
+
     double minX = qInf();
     double maxX = -qInf();
     double minY = qInf();
@@ -2002,16 +2437,13 @@ void QDeclarativeGeoMap::fitViewportToMapItemsRefine(const QList<QPointer<QDecla
                 haveQuickItem = true;
                 continue;
         }
-        // Force map items to update immediately. Needed to ensure correct item size and positions
-        // when recursively calling this function.
-        // TODO: See if we really need updatePolish on delegated items, in particular
-        // in relation to
-        // a) fitViewportToMapItems
-        // b) presence of MouseArea
-        //
-        // This is also legacy code. It must be updated to not operate on screen sizes.
-        if (item->isPolishScheduled())
+        // Force quick items to update immediately. Needed to ensure correct item size and
+        // positions when recursively calling this function. The other items are fitted
+        // through their geographic bounds, which don't depend on the polish.
+        if (quickItem && item->isPolishScheduled()) {
+           item->m_mapPolishPending = false;
            item->updatePolish();
+        }
 
         if (quickItem && quickItem->matrix_ && !quickItem->matrix_->m_matrix.isIdentity()) {
             // TODO: recalculate the center/zoom level so that the item becomes projectable again
@@ -2025,12 +2457,29 @@ void QDeclarativeGeoMap::fitViewportToMapItemsRefine(const QList<QPointer<QDecla
             topLeftY = transformedPosition.y();
             bottomRightX = topLeftX + brect.width();
             bottomRightY = topLeftY + brect.height();
+        } else if (webMercator && !quickItem) {
+            const QGeoProjectionWebMercator &p =
+                    static_cast<const QGeoProjectionWebMercator &>(m_map->geoProjection());
+            QDoubleVector2D topLeft;
+            QDoubleVector2D bottomRight;
+            if (!item->mercatorBounds(&topLeft, &bottomRight))
+                continue;
+            const QDoubleVector2D topLeftPos =
+                    p.wrappedMapProjectionToItemPosition(p.wrapMapProjection(topLeft));
+            const QDoubleVector2D bottomRightPos =
+                    p.wrappedMapProjectionToItemPosition(p.wrapMapProjection(bottomRight));
+            topLeftX = topLeftPos.x();
+            topLeftY = topLeftPos.y();
+            bottomRightX = bottomRightPos.x();
+            bottomRightY = bottomRightPos.y();
         } else {
             QGeoRectangle brect = item->geoShape().boundingGeoRectangle();
-            topLeftX = fromCoordinate(brect.topLeft(), false).x();
-            topLeftY = fromCoordinate(brect.topLeft(), false).y();
-            bottomRightX = fromCoordinate(brect.bottomRight(), false).x();
-            bottomRightY = fromCoordinate(brect.bottomRight(), false).y();
+            const QPointF topLeft = fromCoordinate(brect.topLeft(), false);
+            const QPointF bottomRight = fromCoordinate(brect.bottomRight(), false);
+            topLeftX = topLeft.x();
+            topLeftY = topLeft.y();
+            bottomRightX = bottomRight.x();
+            bottomRightY = bottomRight.y();
         }
 
         minX = qMin(minX, topLeftX);
@@ -2076,4 +2525,64 @@ void QDeclarativeGeoMap::fitViewportToMapItemsRefine(const QList<QPointer<QDecla
         fitViewportToMapItemsRefine(mapItems, false, onlyVisible);
 }
 
+/*!
+    \internal
+
+    Fits the viewport to the union of the Web Mercator bounds of \a mapItems,
+    computed without projecting the items on the screen nor polishing them.
+    MapQuickItems are skipped, and \a haveQuickItem tells whether there was
+    one. Returns whether there was any item to fit.
+*/
+bool QDeclarativeGeoMap::fitViewportToMapItemBounds(const QList<QPointer<QDeclarativeGeoMapItemBase> > &mapItems,
+                                                    bool onlyVisible,
+                                                    bool *haveQuickItem)
+{
+    const QGeoProjectionWebMercator &p =
+            static_cast<const QGeoProjectionWebMercator &>(m_map->geoProjection());
+    const double centerX = p.geoToMapProjection(m_cameraData.center()).x();
+
+    double minX = qInf();
+    double maxX = -qInf();
+    double minY = qInf();
+    double maxY = -qInf();
+    for (const QPointer<QDeclarativeGeoMapItemBase> &i : mapItems) {
+        QDeclarativeGeoMapItemBase *item = i.data();
+        if (!item || (onlyVisible && (!item->isVisible() || item->mapItemOpacity() <= 0.0)))
+            continue;
+        if (qobject_cast<QDeclarativeGeoMapQuickItem *>(item)) {
+            *haveQuickItem = true;
+            continue;
+        }
+
+        QDoubleVector2D topLeft;
+        QDoubleVector2D bottomRight;
+        if (!item->mercatorBounds(&topLeft, &bottomRight))
+            continue;
+        // Use the copy of the item nearest to the center, as it is shown on the screen
+        const double shift = std::round(centerX - (topLeft.x() + bottomRight.x()) * 0.5);
+        minX = qMin(minX, topLeft.x() + shift);
+        maxX = qMax(maxX, bottomRight.x() + shift);
+        minY = qMin(minY, topLeft.y());
+        maxY = qMax(maxY, bottomRight.y());
+    }
+
+    if (minX > maxX)
+        return false;
+
+    // position camera to the center of bounding box
+    QDoubleVector2D center((minX + maxX) * 0.5, (minY + maxY) * 0.5);
+    center.setX(center.x() - std::floor(center.x()));
+    setProperty("center", QVariant::fromValue(p.mapProjectionToGeo(center)));
+
+    // adjust zoom, in the same way as for the screen bounding box of the items
+    const double worldSize = p.mapWidth() * std::exp2(zoomLevel() - std::floor(zoomLevel()));
+    const double zoomRatio = qMax((maxX - minX) * worldSize / width(),
+                                  (maxY - minY) * worldSize / height());
+    if (zoomRatio > 0.0 && qIsFinite(zoomRatio)) {
+        const qreal newZoom = std::floor(qMax(minimumZoomLevel(), zoomLevel() - std::log2(zoomRatio)));
+        setProperty("zoomLevel", QVariant::fromValue(newZoom));
+    }
+    return true;
+}
+
 QT_END_NAMESPACE
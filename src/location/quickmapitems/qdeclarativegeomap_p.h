@@ -22,6 +22,7 @@
 #include <QtLocation/private/qgeocameradata_p.h>
 #include <QtLocation/private/qgeocameracapabilities_p.h>
 #include <QtQuick/QQuickItem>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QPointer>
 #include <QtGui/QColor>
@@ -72,6 +73,11 @@ class Q_LOCATION_EXPORT QDeclarativeGeoMap : public QQuickItem
     Q_INTERFACES(QQmlParserStatus)
 
 public:
+    enum TrimLevel {
+        TrimTextures = QAbstractGeoTileCache::TrimTextures,
+        TrimMemory = QAbstractGeoTileCache::TrimMemory
+    };
+    Q_ENUM(TrimLevel)
 
     explicit QDeclarativeGeoMap(QQuickItem *parent = nullptr);
     ~QDeclarativeGeoMap();
@@ -140,10 +146,13 @@ public:
     Q_INVOKABLE void addMapItemView(QDeclarativeGeoMapItemView *itemView);
 
     Q_INVOKABLE void clearMapItems();
+    Q_REVISION(6, 9) Q_INVOKABLE void addMapItems(const QVariantList &items);
+    Q_REVISION(6, 9) Q_INVOKABLE void removeMapItems(const QVariantList &items);
     QList<QObject *> mapItems();
 
     Q_INVOKABLE QGeoCoordinate toCoordinate(const QPointF &position, bool clipToViewPort = true) const;
     Q_INVOKABLE QPointF fromCoordinate(const QGeoCoordinate &coordinate, bool clipToViewPort = true) const;
+    Q_REVISION(6, 9) Q_INVOKABLE QList<QObject *> itemsAt(const QPointF &point, qreal radius = 0);
 
 //    QQuickGeoMapGestureArea *gesture();
 
@@ -152,6 +161,8 @@ public:
     Q_INVOKABLE void pan(int dx, int dy);
     Q_INVOKABLE void prefetchData(); // optional hint for prefetch
     Q_INVOKABLE void clearData();
+    Q_REVISION(6, 9) Q_INVOKABLE void trimData(TrimLevel level = TrimTextures);
+    Q_REVISION(6, 9) Q_INVOKABLE QVariantMap cacheStatistics() const;
     Q_REVISION(13) Q_INVOKABLE void fitViewportToGeoShape(const QGeoShape &shape, QVariant margins);
     void fitViewportToGeoShape(const QGeoShape &shape, const QMargins &borders = QMargins(10, 10, 10, 10));
 
@@ -191,6 +202,7 @@ Q_SIGNALS:
 protected:
     void componentComplete() override;
     QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
+    void updatePolish() override;
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
 
     void setError(QGeoServiceProvider::Error error, const QString &errorString);
@@ -206,6 +218,13 @@ protected:
     bool removeMapItemGroup_real(QDeclarativeGeoMapItemGroup *itemGroup);
     bool addMapItemView_real(QDeclarativeGeoMapItemView *itemView);
     bool removeMapItemView_real(QDeclarativeGeoMapItemView *itemView);
+    void beginMapItemsChange();
+    void endMapItemsChange();
+    void notifyMapItemsChanged();
+    void invalidateHitTestIndex();
+    void updateHitTestIndex();
+    void schedulePolish(QDeclarativeGeoMapItemBase *item);
+    bool unschedulePolish(QDeclarativeGeoMapItemBase *item);
     void updateItemToWindowTransform();
     void onSGNodeChanged();
 
@@ -220,7 +239,11 @@ private Q_SLOTS:
 private:
     void setupMapView(QDeclarativeGeoMapItemView *view);
     void populateMap();
+    void releaseMap();
     void fitViewportToMapItemsRefine(const QList<QPointer<QDeclarativeGeoMapItemBase> > &mapItems, bool refine, bool onlyVisible);
+    bool fitViewportToMapItemBounds(const QList<QPointer<QDeclarativeGeoMapItemBase> > &mapItems, bool onlyVisible, bool *haveQuickItem);
+    qsizetype mapItemSlot(QDeclarativeGeoMapItemBase *item) const;
+    void releaseMapItemSlot(qsizetype slot);
     void attachCopyrightNotice(bool initialVisibility);
     void detachCopyrightNotice(bool currentVisibility);
     QMargins mapMargins() const;
@@ -235,6 +258,19 @@ private:
     QPointer<QGeoMap> m_map;
     QPointer<QDeclarativeGeoMapCopyrightNotice> m_copyrights;
     QList<QPointer<QDeclarativeGeoMapItemBase> > m_mapItems;
+    // The slot of every item in m_mapItems, for constant time lookup and removal
+    QHash<QDeclarativeGeoMapItemBase *, qsizetype> m_mapItemSlots;
+    int m_mapItemsChangeDepth = 0;
+    bool m_mapItemsChangePending = false;
+    // Screen space index of the map items for itemsAt(), rebuilt on the
+    // first query after the items move
+    QList<QPointer<QDeclarativeGeoMapItemBase> > m_hitTestItems;
+    QList<QRectF> m_hitTestRects;
+    QHash<quint64, QList<qsizetype> > m_hitTestGrid;
+    QList<qsizetype> m_hitTestLargeItems;
+    bool m_hitTestDirty = true;
+    // Items to polish on the next polish of the map
+    QList<QPointer<QDeclarativeGeoMapItemBase> > m_itemsToPolish;
     QList<QPointer<QDeclarativeGeoMapItemGroup> > m_mapItemGroups;
     QString m_errorString;
     QGeoServiceProvider::Error m_error = QGeoServiceProvider::NoError;
@@ -247,6 +283,7 @@ private:
     double m_maximumViewportLatitude = 0.0;
     double m_minimumViewportLatitude = 0.0;
     bool m_initialized = false;
+    bool m_mapReleased = false;
     bool m_sgNodeHasChanged = false;
     QGeoCameraCapabilities m_cameraCapabilities;
     qreal m_minimumZoomLevel = Q_QNAN;
@@ -270,6 +307,7 @@ private:
 
 
     friend class QDeclarativeGeoMapItem;
+    friend class QDeclarativeGeoMapItemBase;
     friend class QDeclarativeGeoMapItemView;
     friend class QDeclarativeGeoMapCopyrightNotice;
     Q_DISABLE_COPY(QDeclarativeGeoMap)
@@ -4,12 +4,14 @@
 #include "qdeclarativegeomapitembase_p.h"
 #include "qgeocameradata_p.h"
 
+#include <QtCore/QtMath>
 #include <QtQml/QQmlInfo>
 #include <QtQuick/QSGOpacityNode>
 
 #include <QtQuick/private/qquickmousearea_p.h>
 #include <QtQuick/private/qquickitem_p.h>
 #include <QtPositioning/private/qdoublevector2d_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
 #include <QtLocation/private/qgeomap_p.h>
 #include <QtLocation/private/qgeoprojection_p.h>
 
@@ -70,8 +72,13 @@ void QDeclarativeGeoMapItemBase::setMap(QDeclarativeGeoMap *quickMap, QGeoMap *m
     if (quickMap && quickMap_)
         return; // don't allow association to more than one map
 
+    // A polish queued on the previous map would never happen
+    const bool polishPending = quickMap_ && quickMap_->unschedulePolish(this);
+
     quickMap_ = quickMap;
     map_ = map;
+    if (polishPending)
+        polishAndUpdate();
 
     if (map_ && quickMap_) {
         // For performance reasons we're not connecting map_'s and quickMap_'s signals to this.
@@ -295,14 +302,92 @@ void QDeclarativeGeoMapItemBase::setParentGroup(QDeclarativeGeoMapItemGroup &par
     }
 }
 
+/*!
+    \internal
+
+    Stores the Web Mercator projection of the corners of the bounding box of
+    geoShape() in \a topLeft and \a bottomRight, and returns whether the
+    shape is valid. When the box crosses the antimeridian, the x coordinate
+    of \a bottomRight is beyond 1.0.
+
+    This does not depend on the map camera nor requires the item to be
+    polished. The projection is cached until the bounding box changes,
+    which is cheap to detect as the shapes keep their bounding box.
+*/
+bool QDeclarativeGeoMapItemBase::mercatorBounds(QDoubleVector2D *topLeft,
+                                                QDoubleVector2D *bottomRight) const
+{
+    const QGeoRectangle bounds = geoShape().boundingGeoRectangle();
+    if (!bounds.isValid())
+        return false;
+
+    if (bounds != m_mercatorBoundsShape) {
+        m_mercatorBoundsShape = bounds;
+        m_mercatorTopLeft = QWebMercator::coordToMercator(bounds.topLeft());
+        m_mercatorBottomRight = QWebMercator::coordToMercator(bounds.bottomRight());
+        if (m_mercatorBottomRight.x() < m_mercatorTopLeft.x()) // crossing the dateline
+            m_mercatorBottomRight.setX(m_mercatorBottomRight.x() + 1.0);
+    }
+    *topLeft = m_mercatorTopLeft;
+    *bottomRight = m_mercatorBottomRight;
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns whether the item is closer than \a radius to \a point, in item
+    coordinates. Map::itemsAt() calls this for the items whose bounding
+    rectangle is close enough.
+
+    The default implementation tests contains() at \a point and, for a
+    positive \a radius, at eight points around it. Items that can do
+    better, like the ones measuring the distance to their outline,
+    reimplement it.
+*/
+bool QDeclarativeGeoMapItemBase::hitTest(const QPointF &point, qreal radius) const
+{
+    if (contains(point))
+        return true;
+    if (radius <= 0)
+        return false;
+    for (int i = 0; i < 8; ++i) {
+        const qreal angle = i * M_PI / 4;
+        if (contains(point + QPointF(qCos(angle), qSin(angle)) * radius))
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapItemBase::geometryChange(const QRectF &newGeometry,
+                                                const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (quickMap_)
+        quickMap_->invalidateHitTestIndex();
+}
+
 bool QDeclarativeGeoMapItemBase::isPolishScheduled() const
 {
-    return QQuickItemPrivate::get(this)->polishScheduled;
+    return m_mapPolishPending || QQuickItemPrivate::get(this)->polishScheduled;
 }
 
+/*!
+    \internal
+
+    Schedules a polish and a repaint of the item. Items on a map are
+    polished by the map, together with the other items that changed in the
+    same frame, rather than each on its own.
+*/
 void QDeclarativeGeoMapItemBase::polishAndUpdate()
 {
-    polish();
+    if (quickMap_)
+        quickMap_->schedulePolish(this);
+    else
+        polish();
     update();
 }
 
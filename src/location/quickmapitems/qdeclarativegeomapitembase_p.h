@@ -19,6 +19,8 @@
 
 #include <QtQuick/QQuickItem>
 #include <QtPositioning/QGeoShape>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qdoublevector2d_p.h>
 
 #include <QtLocation/qlocation.h>
 #include <QtLocation/private/qdeclarativegeomap_p.h>
@@ -68,6 +70,8 @@ public:
     QGeoMap *map() const { return map_; }
     virtual const QGeoShape &geoShape() const = 0;
     virtual void setGeoShape(const QGeoShape &shape) = 0;
+    bool mercatorBounds(QDoubleVector2D *topLeft, QDoubleVector2D *bottomRight) const;
+    virtual bool hitTest(const QPointF &point, qreal radius) const;
 
     bool autoFadeIn() const;
     void setAutoFadeIn(bool fadeIn);
@@ -119,6 +123,7 @@ protected Q_SLOTS:
 protected:
     float zoomLevelOpacity() const;
     bool isPolishScheduled() const;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
 
     QGeoMap::ItemType m_itemType = QGeoMap::NoItem;
 
@@ -139,6 +144,13 @@ private:
     bool m_autoFadeIn = true;
     QLocation::ReferenceSurface m_referenceSurface = QLocation::ReferenceSurface::Map;
     int m_lodThreshold = 0;
+    // Queued on the map, which polishes its items in a single pass
+    bool m_mapPolishPending = false;
+
+    // The bounding box of geoShape() the cached Web Mercator bounds belong to
+    mutable QGeoRectangle m_mercatorBoundsShape;
+    mutable QDoubleVector2D m_mercatorTopLeft;
+    mutable QDoubleVector2D m_mercatorBottomRight;
 
     friend class QDeclarativeGeoMap;
     friend class QDeclarativeGeoMapItemView;
@@ -10,6 +10,11 @@
 #include <QtQml/QQmlContext>
 #include <QtQuick/private/qquickanimation_p.h>
 #include <QtQml/QQmlListProperty>
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qlocationutils_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +61,29 @@ QT_BEGIN_NAMESPACE
     \since QtLocation 5.12
 */
 
+namespace {
+// Fraction of the visible region added on each side of it, within which
+// delegates are kept instantiated when virtualization is enabled
+constexpr double VirtualizationMargin = 0.25;
+
+// Number of updates a released delegate is kept in the reuse pool
+constexpr int MaximumPoolTime = 2;
+
+bool longitudesOverlap(double left1, double right1, double left2, double right2)
+{
+    // Ranges crossing the antimeridian are split in two
+    if (left1 > right1) {
+        return longitudesOverlap(left1, 180.0, left2, right2)
+                || longitudesOverlap(-180.0, right1, left2, right2);
+    }
+    if (left2 > right2) {
+        return longitudesOverlap(left1, right1, left2, 180.0)
+                || longitudesOverlap(left1, right1, -180.0, right2);
+    }
+    return left1 <= right2 && left2 <= right1;
+}
+} // anonymous namespace
+
 QDeclarativeGeoMapItemView::QDeclarativeGeoMapItemView(QQuickItem *parent)
     : QDeclarativeGeoMapItemGroup(parent)
 {
@@ -129,12 +157,17 @@ void QDeclarativeGeoMapItemView::createdItem(int index, QObject * /*object*/)
         // Falling into case 1. or 3. Returning early to prevent double referencing the delegate instance.
         return;
     }
+    // The row left the visible region while its delegate was incubating
+    if (m_virtualization && !m_rowWanted.value(index))
+        return;
 
     QQuickItem *item = qobject_cast<QQuickItem *>(m_delegateModel->object(index, m_incubationMode));
-    if (item)
+    if (item) {
         addDelegateToMap(item, index, true);
-    else
+        scheduleFitViewport();
+    } else {
         qWarning() << "QQmlDelegateModel:: object called in createdItem for " << index << " produced a null item";
+    }
 }
 
 void QDeclarativeGeoMapItemView::modelUpdated(const QQmlChangeSet &changeSet, bool reset)
@@ -142,6 +175,10 @@ void QDeclarativeGeoMapItemView::modelUpdated(const QQmlChangeSet &changeSet, bo
     if (!m_map) // everything will be done in instantiateAllItems. Removal is done by declarativegeomap.
         return;
 
+    // Notify the map items change once for the whole change set
+    QDeclarativeGeoMap *map = m_map;
+    map->beginMapItemsChange();
+
     // move changes are expressed as one remove + one insert, with the same moveId.
     // For simplicity, they will be treated as remove + insert.
     // Changes will be also ignored, as they represent only data changes, not layout changes
@@ -156,20 +193,43 @@ void QDeclarativeGeoMapItemView::modelUpdated(const QQmlChangeSet &changeSet, bo
 
         for (auto rit = mapRemoves.rbegin(); rit != mapRemoves.rend(); ++rit) {
             const QQmlChangeSet::Change &c = removes.at(rit->second);
-            for (auto idx = c.end() - 1; idx >= c.start(); --idx)
+            for (auto idx = c.end() - 1; idx >= c.start(); --idx) {
                 removeDelegateFromMap(idx);
+                if (m_virtualization) {
+                    m_rowBounds.removeAt(idx);
+                    m_rowWanted.removeAt(idx);
+                }
+            }
         }
     }
 
-    QScopedValueRollback createBlocker(m_creatingObject, true);
-    for (const QQmlChangeSet::Change &c: changeSet.inserts()) {
-        for (auto idx = c.start(); idx < c.end(); idx++) {
-            QObject *delegateInstance = m_delegateModel->object(idx, m_incubationMode);
-            addDelegateToMap(qobject_cast<QQuickItem *>(delegateInstance), idx);
+    if (m_virtualization) {
+        // Delegates are only created by updateVirtualItems(), for the rows
+        // falling inside the visible region
+        for (const QQmlChangeSet::Change &c: changeSet.inserts()) {
+            for (auto idx = c.start(); idx < c.end(); idx++) {
+                m_instantiatedItems.insert(idx, nullptr);
+                m_rowBounds.insert(idx, rowBounds(idx));
+                m_rowWanted.insert(idx, false);
+            }
+        }
+        for (const QQmlChangeSet::Change &c: changeSet.changes()) {
+            for (auto idx = c.start(); idx < c.end(); idx++)
+                m_rowBounds[idx] = rowBounds(idx);
+        }
+        updateVirtualItems();
+    } else {
+        QScopedValueRollback createBlocker(m_creatingObject, true);
+        for (const QQmlChangeSet::Change &c: changeSet.inserts()) {
+            for (auto idx = c.start(); idx < c.end(); idx++) {
+                QObject *delegateInstance = m_delegateModel->object(idx, m_incubationMode);
+                addDelegateToMap(qobject_cast<QQuickItem *>(delegateInstance), idx);
+            }
         }
     }
 
-    fitViewport();
+    map->endMapItemsChange();
+    scheduleFitViewport();
 }
 
 /*!
@@ -246,10 +306,25 @@ void QDeclarativeGeoMapItemView::setAutoFitViewport(const bool &fit)
 */
 void QDeclarativeGeoMapItemView::fitViewport()
 {
-
+    m_fitViewportPending = false;
     if (!m_map || !m_map->mapReady() || !m_fitViewport)
         return;
 
+    if (m_virtualization) {
+        // Most delegates do not exist, fit the geographic roles of all rows instead
+        QGeoRectangle bounds;
+        for (const RowBounds &rowBounds : std::as_const(m_rowBounds)) {
+            if (!rowBounds.isValid())
+                continue;
+            const QGeoRectangle rect(QGeoCoordinate(rowBounds.top, rowBounds.left),
+                                     QGeoCoordinate(rowBounds.bottom, rowBounds.right));
+            bounds = bounds.isValid() ? bounds.united(rect) : rect;
+        }
+        if (bounds.isValid())
+            m_map->fitViewportToGeoShape(bounds);
+        return;
+    }
+
     if (m_map->mapItems().size() > 0)
         m_map->fitViewportToMapItems();
 }
@@ -262,6 +337,12 @@ void QDeclarativeGeoMapItemView::setMap(QDeclarativeGeoMap *map)
     if (!map || m_map) // changing map on the fly not supported
         return;
     m_map = map;
+    connect(m_map, &QDeclarativeGeoMap::visibleRegionChanged,
+            this, &QDeclarativeGeoMapItemView::scheduleVirtualUpdate, Qt::UniqueConnection);
+    connect(m_map, &QQuickItem::widthChanged,
+            this, &QDeclarativeGeoMapItemView::scheduleVirtualUpdate, Qt::UniqueConnection);
+    connect(m_map, &QQuickItem::heightChanged,
+            this, &QDeclarativeGeoMapItemView::scheduleVirtualUpdate, Qt::UniqueConnection);
     instantiateAllItems();
 }
 
@@ -275,8 +356,13 @@ void QDeclarativeGeoMapItemView::removeInstantiatedItems(bool transition)
 
     // with transition = false removeInstantiatedItems aborts ongoing exit transitions //QTBUG-69195
     // Backward as removeItemFromMap modifies m_instantiatedItems
+    QDeclarativeGeoMap *map = m_map;
+    map->beginMapItemsChange();
     for (qsizetype i = m_instantiatedItems.size() -1; i >= 0 ; i--)
         removeDelegateFromMap(i, transition);
+    map->endMapItemsChange();
+    m_rowBounds.clear();
+    m_rowWanted.clear();
 }
 
 /*!
@@ -290,14 +376,29 @@ void QDeclarativeGeoMapItemView::instantiateAllItems()
     if (!m_componentCompleted || !m_map || !m_delegate || m_itemModel.isNull() || !m_instantiatedItems.isEmpty())
         return;
 
+    if (m_virtualization) {
+        const int count = m_delegateModel->count();
+        m_instantiatedItems.fill(nullptr, count);
+        m_rowWanted.fill(false, count);
+        m_rowBounds.reserve(count);
+        for (int i = 0; i < count; i++)
+            m_rowBounds.append(rowBounds(i));
+        updateVirtualItems();
+        scheduleFitViewport();
+        return;
+    }
+
     // If here, m_delegateModel may contain data, but QQmlInstanceModel::object for each row hasn't been called yet.
     QScopedValueRollback createBlocker(m_creatingObject, true);
+    QDeclarativeGeoMap *map = m_map;
+    map->beginMapItemsChange();
     for (qsizetype i = 0; i < m_delegateModel->count(); i++) {
         QObject *delegateInstance = m_delegateModel->object(i, m_incubationMode);
         addDelegateToMap(qobject_cast<QQuickItem *>(delegateInstance), i);
     }
+    map->endMapItemsChange();
 
-    fitViewport();
+    scheduleFitViewport();
 }
 
 void QDeclarativeGeoMapItemView::setIncubateDelegates(bool useIncubators)
@@ -315,18 +416,223 @@ bool QDeclarativeGeoMapItemView::incubateDelegates() const
     return m_incubationMode == QQmlIncubator::Asynchronous;
 }
 
+/*!
+    \qmlproperty bool QtLocation::MapItemView::virtualization
+
+    This property controls whether delegates are only instantiated for the
+    rows of the model that lie within, or close to, the visible region of the
+    map. The geographic extent of a row is read from the role named by
+    \l geoRole.
+
+    As the map is panned and zoomed, the delegates of rows leaving the
+    visible region are removed from the map and kept for reuse, in the same
+    way as \l{ListView::reuseItems}{ListView} reuses its delegates. A reused
+    delegate keeps its state, so any state not bound to the model data has to
+    be reset in the \c{ListView.onReused} handler. Rows without a valid
+    geographic role always have their delegate instantiated.
+
+    With virtualization enabled, \l mapItems only holds the instantiated
+    delegates, and \l autoFitViewport fits the geographic roles of all rows.
+
+    Enabling virtualization is recommended for models with many thousands of
+    rows, of which only a small subset is visible at any time.
+
+    Defaults to false.
+
+    \sa geoRole
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoMapItemView::setVirtualization(bool virtualization)
+{
+    if (m_virtualization == virtualization)
+        return;
+
+    removeInstantiatedItems(false);
+    m_virtualization = virtualization;
+    instantiateAllItems();
+    emit virtualizationChanged();
+}
+
+bool QDeclarativeGeoMapItemView::virtualization() const
+{
+    return m_virtualization;
+}
+
+/*!
+    \qmlproperty string QtLocation::MapItemView::geoRole
+
+    This property holds the name of the model role providing the geographic
+    extent of each row when \l virtualization is enabled. The role may hold
+    a \l coordinate or a \l geoShape.
+
+    \sa virtualization
+    \since QtLocation 6.9
+*/
+void QDeclarativeGeoMapItemView::setGeoRole(const QString &role)
+{
+    if (m_geoRole == role)
+        return;
+
+    m_geoRole = role;
+    if (m_virtualization) {
+        removeInstantiatedItems(false);
+        instantiateAllItems();
+    }
+    emit geoRoleChanged();
+}
+
+QString QDeclarativeGeoMapItemView::geoRole() const
+{
+    return m_geoRole;
+}
+
 QList<QQuickItem *> QDeclarativeGeoMapItemView::mapItems()
 {
-    return m_instantiatedItems;
+    if (!m_virtualization)
+        return m_instantiatedItems;
+
+    QList<QQuickItem *> items;
+    for (QQuickItem *item : std::as_const(m_instantiatedItems)) {
+        if (item)
+            items.append(item);
+    }
+    return items;
+}
+
+/*!
+    \internal
+
+    Returns the geographic bounds of the geoRole of \a row.
+*/
+QDeclarativeGeoMapItemView::RowBounds QDeclarativeGeoMapItemView::rowBounds(int row) const
+{
+    RowBounds bounds;
+    if (m_geoRole.isEmpty())
+        return bounds;
+
+    const QVariant value = m_delegateModel->variantValue(row, m_geoRole);
+    const QMetaType type = value.metaType();
+    if (type == QMetaType::fromType<QGeoCoordinate>()) {
+        const QGeoCoordinate coordinate = value.value<QGeoCoordinate>();
+        if (coordinate.isValid()) {
+            bounds.top = bounds.bottom = coordinate.latitude();
+            bounds.left = bounds.right = coordinate.longitude();
+        }
+        return bounds;
+    }
+
+    QGeoShape shape;
+    if (type == QMetaType::fromType<QGeoShape>())
+        shape = value.value<QGeoShape>();
+    else if (type == QMetaType::fromType<QGeoRectangle>())
+        shape = value.value<QGeoRectangle>();
+    else if (type == QMetaType::fromType<QGeoCircle>())
+        shape = value.value<QGeoCircle>();
+    else if (type == QMetaType::fromType<QGeoPath>())
+        shape = value.value<QGeoPath>();
+    else if (type == QMetaType::fromType<QGeoPolygon>())
+        shape = value.value<QGeoPolygon>();
+
+    const QGeoRectangle rect = shape.boundingGeoRectangle();
+    if (rect.isValid()) {
+        bounds.top = rect.topLeft().latitude();
+        bounds.left = rect.topLeft().longitude();
+        bounds.bottom = rect.bottomRight().latitude();
+        bounds.right = rect.bottomRight().longitude();
+    }
+    return bounds;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapItemView::scheduleFitViewport()
+{
+    if (!m_fitViewport || m_fitViewportPending)
+        return;
+
+    // Delegates are added one by one while incubating, fit once they have settled
+    m_fitViewportPending = true;
+    QMetaObject::invokeMethod(this, &QDeclarativeGeoMapItemView::fitViewport,
+                              Qt::QueuedConnection);
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapItemView::scheduleVirtualUpdate()
+{
+    if (!m_virtualization || m_virtualUpdatePending)
+        return;
+
+    // Camera changes come in bursts while panning, update once per burst
+    m_virtualUpdatePending = true;
+    QMetaObject::invokeMethod(this, &QDeclarativeGeoMapItemView::updateVirtualItems,
+                              Qt::QueuedConnection);
+}
+
+/*!
+    \internal
+
+    Instantiates the delegates of the rows inside the visible region expanded
+    by VirtualizationMargin, and releases the others for reuse.
+*/
+void QDeclarativeGeoMapItemView::updateVirtualItems()
+{
+    m_virtualUpdatePending = false;
+    if (!m_virtualization || !m_map || !m_map->mapReady())
+        return;
+
+    const QGeoRectangle visible = m_map->visibleRegion().boundingGeoRectangle();
+    if (!visible.isValid())
+        return;
+
+    const double height = visible.height();
+    const double width = visible.width();
+    const double top = qMin(90.0, visible.topLeft().latitude() + height * VirtualizationMargin);
+    const double bottom = qMax(-90.0, visible.bottomRight().latitude() - height * VirtualizationMargin);
+    double left = -180.0;
+    double right = 180.0;
+    if (width * (1.0 + 2.0 * VirtualizationMargin) < 360.0) {
+        left = QLocationUtils::wrapLong(visible.topLeft().longitude() - width * VirtualizationMargin);
+        right = QLocationUtils::wrapLong(visible.bottomRight().longitude() + width * VirtualizationMargin);
+    }
+
+    QScopedValueRollback createBlocker(m_creatingObject, true);
+    QDeclarativeGeoMap *map = m_map;
+    map->beginMapItemsChange();
+    for (qsizetype row = 0; row < m_instantiatedItems.size(); ++row) {
+        const RowBounds &bounds = m_rowBounds.at(row);
+        const bool wanted = !bounds.isValid()
+                || (bounds.bottom <= top && bounds.top >= bottom
+                    && longitudesOverlap(bounds.left, bounds.right, left, right));
+        if (wanted == m_rowWanted.at(row))
+            continue;
+
+        m_rowWanted[row] = wanted;
+        if (wanted) {
+            QObject *delegateInstance = m_delegateModel->object(row, m_incubationMode);
+            addDelegateToMap(qobject_cast<QQuickItem *>(delegateInstance), row, true);
+        } else if (QQuickItem *item = m_instantiatedItems.at(row)) {
+            m_instantiatedItems[row] = nullptr;
+            disposeDelegate(item, QQmlInstanceModel::Reusable);
+        } else {
+            m_delegateModel->cancel(row);
+        }
+    }
+    map->endMapItemsChange();
+
+    m_delegateModel->drainReusableItemsPool(MaximumPoolTime);
 }
 
-QQmlInstanceModel::ReleaseFlags QDeclarativeGeoMapItemView::disposeDelegate(QQuickItem *item)
+QQmlInstanceModel::ReleaseFlags QDeclarativeGeoMapItemView::disposeDelegate(QQuickItem *item,
+        QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     disconnect(item, 0, this, 0);
     removeDelegateFromMap(item);
     item->setParentItem(nullptr);   // Needed because
     item->setParent(nullptr);       // m_delegateModel->release(item) does not destroy the item most of the times!!
-    QQmlInstanceModel::ReleaseFlags releaseStatus = m_delegateModel->release(item);
+    QQmlInstanceModel::ReleaseFlags releaseStatus = m_delegateModel->release(item, reusableFlag);
     return releaseStatus;
 }
 
@@ -19,6 +19,7 @@
 #include <QtLocation/private/qlocationglobal_p.h>
 #include <map>
 #include <QtCore/QModelIndex>
+#include <QtCore/qnumeric.h>
 #include <QtQml/QQmlParserStatus>
 #include <QtQml/QQmlIncubator>
 #include <QtQml/qqml.h>
@@ -52,6 +53,8 @@ class Q_LOCATION_EXPORT QDeclarativeGeoMapItemView : public QDeclarativeGeoMapIt
     Q_PROPERTY(QQuickTransition *remove MEMBER m_exit REVISION(5, 12))
     Q_PROPERTY(QList<QQuickItem *> mapItems READ mapItems REVISION(5, 12))
     Q_PROPERTY(bool incubateDelegates READ incubateDelegates WRITE setIncubateDelegates NOTIFY incubateDelegatesChanged REVISION(5, 12))
+    Q_PROPERTY(bool virtualization READ virtualization WRITE setVirtualization NOTIFY virtualizationChanged REVISION(6, 9))
+    Q_PROPERTY(QString geoRole READ geoRole WRITE setGeoRole NOTIFY geoRoleChanged REVISION(6, 9))
 
 public:
     explicit QDeclarativeGeoMapItemView(QQuickItem *parent = nullptr);
@@ -73,6 +76,12 @@ public:
     void setIncubateDelegates(bool useIncubators);
     bool incubateDelegates() const;
 
+    void setVirtualization(bool virtualization);
+    bool virtualization() const;
+
+    void setGeoRole(const QString &role);
+    QString geoRole() const;
+
     QList<QQuickItem *> mapItems();
 
     // From QQmlParserStatus
@@ -84,6 +93,8 @@ Q_SIGNALS:
     void delegateChanged();
     void autoFitViewportChanged();
     void incubateDelegatesChanged();
+    Q_REVISION(6, 9) void virtualizationChanged();
+    Q_REVISION(6, 9) void geoRoleChanged();
 
 private Q_SLOTS:
     void destroyingItem(QObject *object);
@@ -91,14 +102,30 @@ private Q_SLOTS:
     void createdItem(int index, QObject *object);
     void modelUpdated(const QQmlChangeSet &changeSet, bool reset);
     void exitTransitionFinished();
+    void scheduleVirtualUpdate();
 
 private:
+    // Geographic bounds of a model row, NaN when the row has no geographic role
+    struct RowBounds
+    {
+        double top = qQNaN();
+        double left = qQNaN();
+        double bottom = qQNaN();
+        double right = qQNaN();
+
+        bool isValid() const { return !qIsNaN(top); }
+    };
+
     void fitViewport();
+    void scheduleFitViewport();
+    void updateVirtualItems();
+    RowBounds rowBounds(int row) const;
     void removeDelegateFromMap(int index, bool transition = true);
     void removeDelegateFromMap(QQuickItem *o);
     void transitionItemOut(QQuickItem *o);
     void terminateExitTransition(QQuickItem *o);
-    QQmlInstanceModel::ReleaseFlags disposeDelegate(QQuickItem *item);
+    QQmlInstanceModel::ReleaseFlags disposeDelegate(QQuickItem *item,
+            QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
 
     void insertInstantiatedItem(int index, QQuickItem *o, bool createdItem);
     void addItemToMap(QDeclarativeGeoMapItemBase *item, int index, bool createdItem);
@@ -113,11 +140,19 @@ private:
     QDeclarativeGeoMap *m_map = nullptr;
     QList<QQuickItem *> m_instantiatedItems;
     bool m_fitViewport = false;
+    bool m_fitViewportPending = false;
     bool m_creatingObject = false;
     QQmlDelegateModel *m_delegateModel = nullptr;
     QQuickTransition *m_enter = nullptr;
     QQuickTransition *m_exit = nullptr;
 
+    // Only used with virtualization, parallel to m_instantiatedItems
+    QList<RowBounds> m_rowBounds;
+    QList<bool> m_rowWanted;
+    QString m_geoRole;
+    bool m_virtualization = false;
+    bool m_virtualUpdatePending = false;
+
     friend class QDeclarativeGeoMap;
     friend class QDeclarativeGeoMapItemBase;
     friend class QDeclarativeGeoMapItemTransitionManager;
@@ -0,0 +1,513 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qdeclarativegeomapmarkerlayer_p.h"
+
+#include <QtQml/qqmlinfo.h>
+#include <QtQml/QQmlFile>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/QSGTexture>
+#include <QtQuick/QSGTextureMaterial>
+#include <QtLocation/private/qdeclarativegeomap_p.h>
+#include <QtLocation/private/qgeomap_p.h>
+#include <QtLocation/private/qgeoprojection_p.h>
+#include <QtPositioning/private/qwebmercator_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype MapMarkerLayer
+    \nativetype QDeclarativeGeoMapMarkerLayer
+    \inqmlmodule QtLocation
+    \ingroup qml-QtLocation5-maps
+    \since QtLocation 6.9
+
+    \brief The MapMarkerLayer type displays a large number of icons on a Map.
+
+    The MapMarkerLayer type draws one icon for every row of \l model, at the
+    coordinate held by the \l coordinateRole of the row. The icons are taken
+    from a single image, the atlas given by \l source, which is divided into
+    cells of \l iconSize pixels in row-major order. The \l iconRole of a row
+    selects the cell drawn for it.
+
+    Like a MapQuickItem without a zoom level, the icons keep their size on
+    the screen, and the point \l anchorPoint of an icon lines up with its
+    coordinate.
+
+    \section2 Performance
+
+    All the markers of a MapMarkerLayer are projected in a single pass when
+    the map moves, and drawn by a single scene graph node with one texture.
+    Unlike a MapItemView instantiating a MapQuickItem per row, no QML object
+    is created per marker, which makes the type suitable for tens of
+    thousands of markers. The markers can't be styled individually or
+    receive input, a MapItemView should be used when that is needed.
+
+    \section2 Example Usage
+
+    \code
+    MapMarkerLayer {
+        model: stationsModel
+        coordinateRole: "position"
+        iconRole: "kind"
+        source: "qrc:/icons/stations.png"
+        iconSize: Qt.size(32, 32)
+        anchorPoint: Qt.point(16, 32)
+    }
+    \endcode
+*/
+
+namespace {
+
+class MarkerNode : public QSGGeometryNode
+{
+public:
+    MarkerNode()
+        : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0, 0,
+                     QSGGeometry::UnsignedIntType)
+    {
+        m_geometry.setDrawingMode(QSGGeometry::DrawTriangles);
+        setGeometry(&m_geometry);
+        setMaterial(&m_material);
+    }
+
+    void setTexture(QSGTexture *texture)
+    {
+        m_texture.reset(texture);
+        m_texture->setFiltering(QSGTexture::Linear);
+        m_material.setTexture(m_texture.get());
+        markDirty(DirtyMaterial);
+    }
+
+    QSGTexture *texture() const
+    {
+        return m_texture.get();
+    }
+
+    QSGGeometry m_geometry;
+
+private:
+    QSGTextureMaterial m_material;
+    std::unique_ptr<QSGTexture> m_texture;
+};
+
+} // anonymous namespace
+
+QDeclarativeGeoMapMarkerLayer::QDeclarativeGeoMapMarkerLayer(QQuickItem *parent)
+    : QDeclarativeGeoMapItemBase(parent)
+{
+    m_itemType = QGeoMap::NoItem;
+    setFlag(ItemHasContents, true);
+}
+
+QDeclarativeGeoMapMarkerLayer::~QDeclarativeGeoMapMarkerLayer() {}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapMarkerLayer::setMap(QDeclarativeGeoMap *quickMap, QGeoMap *map)
+{
+    QDeclarativeGeoMapItemBase::setMap(quickMap, map);
+    if (map && quickMap) {
+        connect(map, &QGeoMap::cameraDataChanged,
+                this, &QDeclarativeGeoMapMarkerLayer::polishAndUpdate);
+        polishAndUpdate();
+    }
+}
+
+/*!
+    \qmlproperty model MapMarkerLayer::model
+
+    This property holds the model providing the markers.
+*/
+void QDeclarativeGeoMapMarkerLayer::setModel(QAbstractItemModel *model)
+{
+    if (m_model == model)
+        return;
+
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+
+    m_model = model;
+
+    if (m_model) {
+        connect(m_model, &QAbstractItemModel::modelReset,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QAbstractItemModel::layoutChanged,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QAbstractItemModel::rowsInserted,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QAbstractItemModel::rowsRemoved,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QAbstractItemModel::rowsMoved,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QAbstractItemModel::dataChanged,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+        connect(m_model, &QObject::destroyed,
+                this, &QDeclarativeGeoMapMarkerLayer::markersChanged);
+    }
+
+    markersChanged();
+    emit modelChanged();
+}
+
+QAbstractItemModel *QDeclarativeGeoMapMarkerLayer::model() const
+{
+    return m_model;
+}
+
+/*!
+    \qmlproperty string MapMarkerLayer::coordinateRole
+
+    This property holds the name of the model role holding the coordinate of
+    a marker. The default value is \c "coordinate".
+*/
+void QDeclarativeGeoMapMarkerLayer::setCoordinateRole(const QString &role)
+{
+    if (m_coordinateRole == role)
+        return;
+
+    m_coordinateRole = role;
+    markersChanged();
+    emit coordinateRoleChanged();
+}
+
+QString QDeclarativeGeoMapMarkerLayer::coordinateRole() const
+{
+    return m_coordinateRole;
+}
+
+/*!
+    \qmlproperty string MapMarkerLayer::iconRole
+
+    This property holds the name of the model role holding the index of the
+    icon of a marker in the atlas. When the property is empty, which is the
+    default, every marker uses the first icon.
+*/
+void QDeclarativeGeoMapMarkerLayer::setIconRole(const QString &role)
+{
+    if (m_iconRole == role)
+        return;
+
+    m_iconRole = role;
+    markersChanged();
+    emit iconRoleChanged();
+}
+
+QString QDeclarativeGeoMapMarkerLayer::iconRole() const
+{
+    return m_iconRole;
+}
+
+/*!
+    \qmlproperty url MapMarkerLayer::source
+
+    This property holds the URL of the image holding the icons. Only local
+    files and resources are supported.
+*/
+void QDeclarativeGeoMapMarkerLayer::setSource(const QUrl &source)
+{
+    if (m_source == source)
+        return;
+
+    m_source = source;
+    m_atlas = QImage();
+    if (!m_source.isEmpty()) {
+        const QString path = QQmlFile::urlToLocalFileOrQrc(m_source);
+        if (path.isEmpty() || !m_atlas.load(path))
+            qmlWarning(this) << "Unable to load marker atlas" << m_source;
+    }
+    m_atlasChanged = true;
+    polishAndUpdate();
+    emit sourceChanged();
+}
+
+QUrl QDeclarativeGeoMapMarkerLayer::source() const
+{
+    return m_source;
+}
+
+/*!
+    \qmlproperty size MapMarkerLayer::iconSize
+
+    This property holds the size of an icon in the atlas, in pixels. When the
+    size is empty, which is the default, the whole atlas is a single icon.
+*/
+void QDeclarativeGeoMapMarkerLayer::setIconSize(const QSize &size)
+{
+    if (m_iconSize == size)
+        return;
+
+    m_iconSize = size;
+    polishAndUpdate();
+    emit iconSizeChanged();
+}
+
+QSize QDeclarativeGeoMapMarkerLayer::iconSize() const
+{
+    return m_iconSize;
+}
+
+/*!
+    \qmlproperty point MapMarkerLayer::anchorPoint
+
+    This property determines which point of an icon is lined up with the
+    coordinate of its marker. The default value is the top-left corner of
+    the icon.
+*/
+void QDeclarativeGeoMapMarkerLayer::setAnchorPoint(const QPointF &anchorPoint)
+{
+    if (m_anchorPoint == anchorPoint)
+        return;
+
+    m_anchorPoint = anchorPoint;
+    polishAndUpdate();
+    emit anchorPointChanged();
+}
+
+QPointF QDeclarativeGeoMapMarkerLayer::anchorPoint() const
+{
+    return m_anchorPoint;
+}
+
+/*!
+    \qmlproperty int MapMarkerLayer::count
+
+    This property holds the number of markers with a valid coordinate.
+*/
+int QDeclarativeGeoMapMarkerLayer::count() const
+{
+    return int(m_mercator.size());
+}
+
+/*!
+    \internal
+*/
+const QGeoShape &QDeclarativeGeoMapMarkerLayer::geoShape() const
+{
+    return m_geoShape;
+}
+
+/*!
+    \internal
+
+    The shape of the layer is derived from the model.
+*/
+void QDeclarativeGeoMapMarkerLayer::setGeoShape(const QGeoShape &shape)
+{
+    Q_UNUSED(shape);
+}
+
+/*!
+    \internal
+
+    The layer covers the whole map, but only its markers can be hit.
+*/
+bool QDeclarativeGeoMapMarkerLayer::contains(const QPointF &point) const
+{
+    return hitTest(point, 0);
+}
+
+/*!
+    \internal
+*/
+bool QDeclarativeGeoMapMarkerLayer::hitTest(const QPointF &point, qreal radius) const
+{
+    const qreal radiusSqr = radius * radius;
+    for (qsizetype i = 0; i + 3 < m_vertices.size(); i += 4) {
+        const QSGGeometry::TexturedPoint2D &topLeft = m_vertices.at(i);
+        const QSGGeometry::TexturedPoint2D &bottomRight = m_vertices.at(i + 3);
+        const qreal dx = qMax(qMax(topLeft.x - point.x(), point.x() - bottomRight.x), qreal(0));
+        const qreal dy = qMax(qMax(topLeft.y - point.y(), point.y() - bottomRight.y), qreal(0));
+        if (dx * dx + dy * dy <= radiusSqr)
+            return true;
+    }
+    return false;
+}
+
+void QDeclarativeGeoMapMarkerLayer::markersChanged()
+{
+    m_markersDirty = true;
+    polishAndUpdate();
+}
+
+void QDeclarativeGeoMapMarkerLayer::loadMarkers()
+{
+    m_markersDirty = false;
+    const qsizetype oldCount = m_mercator.size();
+    m_mercator.clear();
+    m_icons.clear();
+    m_geoShape = QGeoRectangle();
+
+    if (m_model) {
+        const QHash<int, QByteArray> roles = m_model->roleNames();
+        const int coordinateRole = roles.key(m_coordinateRole.toUtf8(), -1);
+        const int iconRole = m_iconRole.isEmpty() ? -1 : roles.key(m_iconRole.toUtf8(), -1);
+        if (coordinateRole < 0 && m_model->rowCount() > 0)
+            qmlWarning(this) << "Model has no role named" << m_coordinateRole;
+
+        if (coordinateRole >= 0) {
+            const int rows = m_model->rowCount();
+            m_mercator.reserve(rows);
+            m_icons.reserve(rows);
+            double minLat = 90.0, maxLat = -90.0, minLon = 180.0, maxLon = -180.0;
+            for (int row = 0; row < rows; ++row) {
+                const QModelIndex index = m_model->index(row, 0);
+                const QGeoCoordinate coordinate = index.data(coordinateRole).value<QGeoCoordinate>();
+                if (!coordinate.isValid())
+                    continue;
+                m_mercator.append(QWebMercator::coordToMercator(coordinate));
+                m_icons.append(iconRole < 0 ? 0 : index.data(iconRole).toInt());
+                minLat = qMin(minLat, coordinate.latitude());
+                maxLat = qMax(maxLat, coordinate.latitude());
+                minLon = qMin(minLon, coordinate.longitude());
+                maxLon = qMax(maxLon, coordinate.longitude());
+            }
+            if (!m_mercator.isEmpty()) {
+                m_geoShape = QGeoRectangle(QGeoCoordinate(maxLat, minLon),
+                                           QGeoCoordinate(minLat, maxLon));
+            }
+        }
+    }
+
+    if (oldCount != m_mercator.size())
+        emit countChanged();
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapMarkerLayer::updatePolish()
+{
+    if (m_markersDirty)
+        loadMarkers();
+
+    m_vertices.clear();
+    if (!quickMap() || !map())
+        return;
+
+    // The layer covers the map, so that item and map coordinates match
+    setPosition(QPointF(0, 0));
+    setSize(quickMap()->size());
+
+    if (m_mercator.isEmpty() || m_atlas.isNull())
+        return;
+
+    const QSizeF icon = m_iconSize.isEmpty() ? QSizeF(m_atlas.size()) : QSizeF(m_iconSize);
+    const int columns = qMax(1, int(m_atlas.width() / icon.width()));
+    const int cells = columns * qMax(1, int(m_atlas.height() / icon.height()));
+    const qreal cellWidth = icon.width() / m_atlas.width();
+    const qreal cellHeight = icon.height() / m_atlas.height();
+    const QRectF bounds(QPointF(0, 0), size());
+
+    const QGeoProjection &projection = map()->geoProjection();
+    const bool webMercator = projection.projectionType() == QGeoProjection::ProjectionWebMercator;
+    const QGeoProjectionWebMercator *p = webMercator
+            ? static_cast<const QGeoProjectionWebMercator *>(&projection)
+            : nullptr;
+
+    m_vertices.reserve(m_mercator.size() * 4);
+    for (qsizetype i = 0; i < m_mercator.size(); ++i) {
+        QPointF topLeft;
+        if (p) {
+            const QDoubleVector2D wrapped = p->wrapMapProjection(m_mercator.at(i));
+            if (!p->isProjectable(wrapped))
+                continue;
+            topLeft = p->wrappedMapProjectionToItemPosition(wrapped).toPointF();
+        } else {
+            const QDoubleVector2D pos = projection.coordinateToItemPosition(
+                    QWebMercator::mercatorToCoord(m_mercator.at(i)), false);
+            if (qIsNaN(pos.x()))
+                continue;
+            topLeft = pos.toPointF();
+        }
+        topLeft -= m_anchorPoint;
+
+        const QRectF quad(topLeft, icon);
+        if (!bounds.intersects(quad))
+            continue;
+
+        const int cell = qBound(0, m_icons.at(i), cells - 1);
+        const float u0 = float((cell % columns) * cellWidth);
+        const float v0 = float((cell / columns) * cellHeight);
+        const float u1 = float(u0 + cellWidth);
+        const float v1 = float(v0 + cellHeight);
+        const float x0 = float(quad.left());
+        const float y0 = float(quad.top());
+        const float x1 = float(quad.right());
+        const float y1 = float(quad.bottom());
+        const qsizetype first = m_vertices.size();
+        m_vertices.resize(first + 4);
+        m_vertices[first].set(x0, y0, u0, v0);
+        m_vertices[first + 1].set(x1, y0, u1, v0);
+        m_vertices[first + 2].set(x0, y1, u0, v1);
+        m_vertices[first + 3].set(x1, y1, u1, v1);
+    }
+}
+
+/*!
+    \internal
+*/
+QSGNode *QDeclarativeGeoMapMarkerLayer::updateMapItemPaintNode(QSGNode *oldNode,
+                                                               UpdatePaintNodeData *)
+{
+    MarkerNode *node = static_cast<MarkerNode *>(oldNode);
+    if (m_vertices.isEmpty() || m_atlas.isNull() || !window()) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new MarkerNode;
+        m_atlasChanged = true;
+    }
+    if (m_atlasChanged) {
+        node->setTexture(window()->createTextureFromImage(m_atlas));
+        m_atlasChanged = false;
+    }
+
+    // The texture may be placed in a larger atlas by the scene graph
+    const QRectF subRect = node->texture()->normalizedTextureSubRect();
+    const qsizetype markers = m_vertices.size() / 4;
+    QSGGeometry &geometry = node->m_geometry;
+    geometry.allocate(int(m_vertices.size()), int(markers * 6));
+
+    QSGGeometry::TexturedPoint2D *vertices = geometry.vertexDataAsTexturedPoint2D();
+    for (qsizetype i = 0; i < m_vertices.size(); ++i) {
+        const QSGGeometry::TexturedPoint2D &v = m_vertices.at(i);
+        vertices[i].set(v.x, v.y,
+                        float(subRect.x() + v.tx * subRect.width()),
+                        float(subRect.y() + v.ty * subRect.height()));
+    }
+
+    quint32 *indices = geometry.indexDataAsUInt();
+    for (qsizetype i = 0; i < markers; ++i) {
+        const quint32 first = quint32(i * 4);
+        indices[0] = first;
+        indices[1] = first + 1;
+        indices[2] = first + 2;
+        indices[3] = first + 2;
+        indices[4] = first + 1;
+        indices[5] = first + 3;
+        indices += 6;
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+/*!
+    \internal
+*/
+void QDeclarativeGeoMapMarkerLayer::afterViewportChanged(const QGeoMapViewportChangeEvent &event)
+{
+    if (event.mapSize.width() <= 0 || event.mapSize.height() <= 0)
+        return;
+
+    polishAndUpdate();
+}
+
+QT_END_NAMESPACE
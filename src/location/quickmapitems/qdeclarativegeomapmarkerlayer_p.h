@@ -0,0 +1,118 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDECLARATIVEGEOMAPMARKERLAYER_P_H
+#define QDECLARATIVEGEOMAPMARKERLAYER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+#include <QtLocation/private/qdeclarativegeomapitembase_p.h>
+
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QPointer>
+#include <QtCore/QUrl>
+#include <QtGui/QImage>
+#include <QtPositioning/QGeoRectangle>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+#include <QtQuick/QSGGeometry>
+
+QT_BEGIN_NAMESPACE
+
+class Q_LOCATION_EXPORT QDeclarativeGeoMapMarkerLayer : public QDeclarativeGeoMapItemBase
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(MapMarkerLayer)
+    QML_ADDED_IN_VERSION(6, 9)
+
+    Q_PROPERTY(QAbstractItemModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QString coordinateRole READ coordinateRole WRITE setCoordinateRole NOTIFY coordinateRoleChanged)
+    Q_PROPERTY(QString iconRole READ iconRole WRITE setIconRole NOTIFY iconRoleChanged)
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QSize iconSize READ iconSize WRITE setIconSize NOTIFY iconSizeChanged)
+    Q_PROPERTY(QPointF anchorPoint READ anchorPoint WRITE setAnchorPoint NOTIFY anchorPointChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    explicit QDeclarativeGeoMapMarkerLayer(QQuickItem *parent = nullptr);
+    ~QDeclarativeGeoMapMarkerLayer();
+
+    void setMap(QDeclarativeGeoMap *quickMap, QGeoMap *map) override;
+
+    void setModel(QAbstractItemModel *model);
+    QAbstractItemModel *model() const;
+
+    void setCoordinateRole(const QString &role);
+    QString coordinateRole() const;
+
+    void setIconRole(const QString &role);
+    QString iconRole() const;
+
+    void setSource(const QUrl &source);
+    QUrl source() const;
+
+    void setIconSize(const QSize &size);
+    QSize iconSize() const;
+
+    void setAnchorPoint(const QPointF &anchorPoint);
+    QPointF anchorPoint() const;
+
+    int count() const;
+
+    const QGeoShape &geoShape() const override;
+    void setGeoShape(const QGeoShape &shape) override;
+    bool contains(const QPointF &point) const override;
+    bool hitTest(const QPointF &point, qreal radius) const override;
+
+    QSGNode *updateMapItemPaintNode(QSGNode *, UpdatePaintNodeData *) override;
+
+Q_SIGNALS:
+    void modelChanged();
+    void coordinateRoleChanged();
+    void iconRoleChanged();
+    void sourceChanged();
+    void iconSizeChanged();
+    void anchorPointChanged();
+    void countChanged();
+
+protected:
+    void updatePolish() override;
+
+protected Q_SLOTS:
+    void afterViewportChanged(const QGeoMapViewportChangeEvent &event) override;
+
+private:
+    void markersChanged();
+    void loadMarkers();
+
+    QPointer<QAbstractItemModel> m_model;
+    QString m_coordinateRole = QStringLiteral("coordinate");
+    QString m_iconRole;
+    QUrl m_source;
+    QImage m_atlas;
+    bool m_atlasChanged = false;
+    QSize m_iconSize;
+    QPointF m_anchorPoint;
+
+    // Web Mercator positions and icon of every marker, read from the model
+    QList<QDoubleVector2D> m_mercator;
+    QList<int> m_icons;
+    QGeoRectangle m_geoShape;
+    bool m_markersDirty = true;
+
+    // Four vertices per visible marker, recomputed whenever the camera moves
+    QList<QSGGeometry::TexturedPoint2D> m_vertices;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDECLARATIVEGEOMAPMARKERLAYER_P_H
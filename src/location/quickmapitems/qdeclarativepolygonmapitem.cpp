@@ -15,6 +15,7 @@
 #include <QtPositioning/private/qclipperutils_p.h>
 #include <QtPositioning/private/qgeopolygon_p.h>
 #include <QtPositioning/private/qwebmercator_p.h>
+#include <QtQuick/QQuickWindow>
 
 QT_BEGIN_NAMESPACE
 
@@ -121,7 +122,7 @@ void QGeoMapPolygonGeometry::updateSourcePoints(const QGeoMap &map,
     const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(map.geoProjection());
     srcPath_ = QPainterPath();
     srcOrigin_ = p.mapProjectionToGeo(QDoubleVector2D(0.0, 0.0)); //avoid warning of NaN values if function is returned early
-    const QRectF cameraRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(p.visibleGeometry());
+    const QRectF cameraRect = p.visibleGeometryBoundingRect();
 
     QList<QList<QDoubleVector2D>> paths;
 
@@ -370,6 +371,97 @@ bool QDeclarativePolygonMapItemPrivateCPU::contains(const QPointF &point) const
     return m_shape->contains(m_poly.mapToItem(m_shape, point));
 }
 
+QDeclarativePolygonMapItemPrivateGPU::QDeclarativePolygonMapItemPrivateGPU(QDeclarativePolygonMapItem &polygon)
+    : QDeclarativePolygonMapItemPrivate(polygon)
+{
+}
+
+QDeclarativePolygonMapItemPrivateGPU::~QDeclarativePolygonMapItemPrivateGPU()
+{
+}
+
+void QDeclarativePolygonMapItemPrivateGPU::regenerateCache()
+{
+    if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        m_mesh.setRings({});
+        return;
+    }
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
+    const bool globe = m_poly.referenceSurface() == QLocation::ReferenceSurface::Globe;
+
+    QList<QList<QDoubleVector2D>> rings;
+    rings.reserve(m_poly.m_geopoly.holesCount() + 1);
+    for (int i = -1; i < m_poly.m_geopoly.holesCount(); ++i) {
+        const QList<QGeoCoordinate> path = i < 0 ? m_poly.m_geopoly.perimeter()
+                                                 : m_poly.m_geopoly.holePath(i);
+        const QList<QGeoCoordinate> realPath = globe
+                ? QDeclarativeGeoMapItemUtils::greaterCirclePath(path, QDeclarativeGeoMapItemUtils::ClosedPath)
+                : path;
+        QList<QDoubleVector2D> ring;
+        ring.reserve(realPath.size());
+        for (const QGeoCoordinate &c : realPath)
+            ring << p.geoToMapProjection(c);
+        if (ring.isEmpty())
+            continue;
+        // Holes stay in the same world as the perimeter
+        const double referenceX = rings.isEmpty() ? ring.first().x() : rings.first().first().x();
+        rings << QGeoMapItemMesh::unwrapped(ring, referenceX);
+    }
+    m_mesh.setRings(rings);
+}
+
+void QDeclarativePolygonMapItemPrivateGPU::updatePolish()
+{
+    const QGeoMap *map = m_poly.map();
+    if (m_mesh.isEmpty() || !map || !m_poly.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        m_poly.setWidth(0);
+        m_poly.setHeight(0);
+        return;
+    }
+    QScopedValueRollback<bool> rollback(m_poly.m_updatingGeometry);
+    m_poly.m_updatingGeometry = true;
+
+    // The polygon is placed by the transformation, the item bounds it for
+    // hit testing
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QRectF rect = QGeoMapItemMesh::itemRect(*m_poly.quickMap(), p, m_mesh.origin(),
+                                                  m_mesh.bounds(), 0.5 * m_poly.m_border.width() + 1);
+    m_poly.setPosition(rect.topLeft());
+    m_poly.setSize(rect.size());
+    m_mesh.updateTessellation(m_poly.quickMap()->zoomLevel());
+}
+
+QSGNode *QDeclarativePolygonMapItemPrivateGPU::updateMapItemPaintNode(QSGNode *oldNode,
+                                                                      QQuickItem::UpdatePaintNodeData * /*data*/)
+{
+    const QGeoMap *map = m_poly.map();
+    if (m_mesh.isEmpty() || !map || !m_poly.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    return m_mesh.updatePaintNode(oldNode,
+                                  QGeoMapItemMesh::mapMatrix(m_poly, *m_poly.quickMap(), p, m_mesh.origin()),
+                                  m_poly.color(), m_poly.m_border.color(), m_poly.m_border.width());
+}
+
+bool QDeclarativePolygonMapItemPrivateGPU::contains(const QPointF &point) const
+{
+    const QGeoMap *map = m_poly.map();
+    if (m_mesh.isEmpty() || !map || !m_poly.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        return false;
+    }
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QPointF mapPoint = m_poly.mapToItem(m_poly.quickMap(), point);
+    const QDoubleVector2D mercator = p.itemPositionToWrappedMapProjection(QDoubleVector2D(mapPoint));
+    return m_mesh.contains(mercator - QGeoMapItemMesh::wrappedOrigin(m_mesh.origin(), p));
+}
+
 /*
  * QDeclarativePolygonMapItem Implementation
  */
@@ -514,6 +606,62 @@ void QDeclarativePolygonMapItem::setColor(const QColor &color)
     emit colorChanged(m_color);
 }
 
+/*!
+    \qmlproperty enumeration MapPolygon::backend
+
+    This property holds which backend is in use to render the polygon:
+
+    \value MapPolygon.Software
+        The polygon is projected and triangulated on the CPU, by a Shape,
+        every time the map moves. This is the default.
+    \value MapPolygon.Shader
+        The polygon is triangulated once per integer zoom level, and the
+        triangles are projected by the graphics hardware. Panning, rotating,
+        tilting, and zooming within a zoom level reuse the triangles, which
+        suits large or detailed polygons. The border is drawn like a
+        MapPolyline with the \c Shader backend. When the scene graph does
+        not render through the graphics hardware abstraction, as with the
+        \c software adaptation, or when Qt Location was built without Qt
+        Shader Tools, the Software backend is used instead.
+
+    \since QtLocation 6.9
+*/
+QDeclarativePolygonMapItem::Backend QDeclarativePolygonMapItem::backend() const
+{
+    return m_backend;
+}
+
+void QDeclarativePolygonMapItem::setBackend(Backend backend)
+{
+    if (backend == m_backend)
+        return;
+    m_backend = backend;
+    updateBackend();
+    emit backendChanged();
+}
+
+/*!
+    \internal
+
+    Replaces the backend implementation if the requested backend, or the
+    ability of the window to run shaders, changed.
+*/
+void QDeclarativePolygonMapItem::updateBackend()
+{
+    Backend backend = m_backend;
+    if (backend == Shader && !QGeoMapItemMesh::isSupported(window()))
+        backend = Software;
+    if (backend == m_activeBackend)
+        return;
+
+    m_activeBackend = backend;
+    if (backend == Shader)
+        m_d.reset(new QDeclarativePolygonMapItemPrivateGPU(*this));
+    else
+        m_d.reset(new QDeclarativePolygonMapItemPrivateCPU(*this));
+    m_d->onGeoGeometryChanged();
+}
+
 /*!
     \internal
 */
@@ -529,6 +677,7 @@ void QDeclarativePolygonMapItem::updatePolish()
 {
     if (!map() || map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
         return;
+    updateBackend();
     m_d->updatePolish();
 }
 
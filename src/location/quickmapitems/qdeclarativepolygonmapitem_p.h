@@ -32,8 +32,15 @@ class Q_LOCATION_EXPORT QDeclarativePolygonMapItem : public QDeclarativeGeoMapIt
     Q_PROPERTY(QList<QGeoCoordinate> path READ path WRITE setPath NOTIFY pathChanged)
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
     Q_PROPERTY(QDeclarativeMapLineProperties *border READ border CONSTANT)
+    Q_PROPERTY(Backend backend READ backend WRITE setBackend NOTIFY backendChanged REVISION(6, 9))
 
 public:
+    enum Backend {
+        Software = 0,
+        Shader = 1
+    };
+    Q_ENUM(Backend)
+
     explicit QDeclarativePolygonMapItem(QQuickItem *parent = nullptr);
     ~QDeclarativePolygonMapItem() override;
 
@@ -56,9 +63,13 @@ public:
     const QGeoShape &geoShape() const override;
     void setGeoShape(const QGeoShape &shape) override;
 
+    Backend backend() const;
+    void setBackend(Backend backend);
+
 Q_SIGNALS:
     void pathChanged();
     void colorChanged(const QColor &color);
+    Q_REVISION(6, 9) void backendChanged();
 
 protected Q_SLOTS:
     void markSourceDirtyAndUpdate();
@@ -68,6 +79,7 @@ protected Q_SLOTS:
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void updatePolish() override;
+    void updateBackend();
 
 #ifdef QT_LOCATION_DEBUG
 public:
@@ -76,11 +88,15 @@ public:
     QDeclarativeMapLineProperties m_border;
     QColor m_color;
     bool m_updatingGeometry;
+    Backend m_backend = Software;
+    // The backend of m_d, Software when the scene graph can't run shaders
+    Backend m_activeBackend = Software;
 
     std::unique_ptr<QDeclarativePolygonMapItemPrivate> m_d;
 
     friend class QDeclarativePolygonMapItemPrivate;
     friend class QDeclarativePolygonMapItemPrivateCPU;
+    friend class QDeclarativePolygonMapItemPrivateGPU;
 };
 
 QT_END_NAMESPACE
@@ -27,6 +27,7 @@
 #include <QtLocation/private/qgeomapitemgeometry_p.h>
 #include <QtLocation/private/qdeclarativepolygonmapitem_p.h>
 #include <QtLocation/private/qdeclarativepolylinemapitem_p_p.h>
+#include <QtLocation/private/qgeomapitemmesh_p.h>
 
 #include <QtPositioning/private/qdoublevector2d_p.h>
 
@@ -184,6 +185,55 @@ public:
     QDeclarativeGeoMapPainterPath *m_painterPath = nullptr;
 };
 
+// Fills the polygon on the GPU: the projected rings are triangulated once
+// per zoom level, and the camera only changes the transformation of the
+// triangles
+class Q_LOCATION_EXPORT QDeclarativePolygonMapItemPrivateGPU: public QDeclarativePolygonMapItemPrivate
+{
+public:
+    QDeclarativePolygonMapItemPrivateGPU(QDeclarativePolygonMapItem &polygon);
+    ~QDeclarativePolygonMapItemPrivateGPU() override;
+
+    void onLinePropertiesChanged() override
+    {
+        // Border width and color are uniforms of the shaders
+        m_poly.update();
+    }
+    void markSourceDirtyAndUpdate() override
+    {
+        m_poly.polishAndUpdate();
+    }
+    void regenerateCache();
+    void afterViewportChanged() override
+    {
+        // The polish picks the tessellation for the new zoom level
+        markSourceDirtyAndUpdate();
+    }
+    void onMapSet() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryChanged() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryUpdated() override
+    {
+        onGeoGeometryChanged();
+    }
+    void onItemGeometryChanged() override
+    {
+        onGeoGeometryChanged();
+    }
+    void updatePolish() override;
+    QSGNode *updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) override;
+    bool contains(const QPointF &point) const override;
+
+    QGeoMapItemMesh m_mesh;
+};
+
 QT_END_NAMESPACE
 
 #endif // QDECLARATIVEPOLYGONMAPITEM_P_P_H
@@ -15,6 +15,9 @@
 #include <QtPositioning/private/qclipperutils_p.h>
 #include <QtPositioning/private/qgeopath_p.h>
 #include <QtLocation/private/qgeomap_p.h>
+#include <QtLocation/private/qgeoprojection_p.h>
+#include <QtLocation/private/qgeomapitemmesh_p.h>
+#include <QtQuick/QQuickWindow>
 
 #include <array>
 
@@ -329,7 +332,7 @@ void QGeoMapPolylineGeometry::updateSourcePoints(const QGeoMap &map,
     //1 The bounding rectangle of the polygon and camera view are compared to determine if the polygon is visible
     //  The viewport is periodic in x-direction in the interval [-1; 1].
     //  The polygon (maybe) has to be ploted periodically too by shifting it by -1 or +1;
-    const QRectF cameraRect = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(p.visibleGeometry());
+    const QRectF cameraRect = p.visibleGeometryBoundingRect();
     QRectF itemRect;
     for (const auto &path : wrappedPaths)
         itemRect |= QDeclarativeGeoMapItemUtils::boundingRectangleFromList(path).adjusted(-1e-6, -1e-6, 2e-6, 2e-6); //TODO: Maybe use linewidth?
@@ -451,6 +454,7 @@ void QDeclarativePolylineMapItemPrivateCPU::updateCache()
 
 void QDeclarativePolylineMapItemPrivateCPU::updatePolish()
 {
+    m_segmentGridDirty = true;
     if (m_poly.m_geopath.path().length() < 2) { // Possibly cleared
         m_geometry.clear();
         m_poly.setWidth(0);
@@ -499,6 +503,11 @@ QSGNode *QDeclarativePolylineMapItemPrivateCPU::updateMapItemPaintNode(QSGNode *
 }
 
 bool QDeclarativePolylineMapItemPrivateCPU::contains(const QPointF &point) const
+{
+    return hitTest(point, 0);
+}
+
+bool QDeclarativePolylineMapItemPrivateCPU::hitTest(const QPointF &point, qreal radius) const
 {
     // With Shapes, do not just call
     // m_shape->contains(m_poly.mapToItem(m_shape, point)) because that can
@@ -507,15 +516,226 @@ bool QDeclarativePolylineMapItemPrivateCPU::contains(const QPointF &point) const
     const QPainterPath &path = m_geometry.srcPath_;
     const double &lineWidth = m_poly.m_line.width();
     const QPointF p = m_poly.mapToItem(m_shape, point) - QPointF(lineWidth, lineWidth) * 0.5;
+    const double maxDistance = 0.5 * lineWidth + radius;
+    const double maxDistanceSqr = maxDistance * maxDistance;
+
+    if (path.elementCount() <= SegmentGridThreshold) {
+        for (int i = 1; i < path.elementCount(); i++) {
+            if (segmentHit(i, p, maxDistanceSqr))
+                return true;
+        }
+        return false;
+    }
+
+    if (m_segmentGridDirty)
+        updateSegmentGrid();
+
+    for (int i : std::as_const(m_longSegments)) {
+        if (segmentHit(i, p, maxDistanceSqr))
+            return true;
+    }
+
+    const QRectF area = QRectF(p - QPointF(maxDistance, maxDistance),
+                               QSizeF(2 * maxDistance, 2 * maxDistance))
+                                .intersected(m_segmentGridBounds);
+    if (area.isNull())
+        return false;
+    const int left = int((area.left() - m_segmentGridBounds.left()) / m_segmentCellSize);
+    const int right = int((area.right() - m_segmentGridBounds.left()) / m_segmentCellSize);
+    const int top = int((area.top() - m_segmentGridBounds.top()) / m_segmentCellSize);
+    const int bottom = int((area.bottom() - m_segmentGridBounds.top()) / m_segmentCellSize);
+    for (int x = left; x <= right; ++x) {
+        for (int y = top; y <= bottom; ++y) {
+            const auto it = m_segmentGrid.constFind((quint64(x) << 32) | quint32(y));
+            if (it == m_segmentGrid.cend())
+                continue;
+            for (int i : it.value()) {
+                if (segmentHit(i, p, maxDistanceSqr))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Whether the segment ending at element i of the path is closer than
+// sqrt(maxDistanceSqr) to p
+bool QDeclarativePolylineMapItemPrivateCPU::segmentHit(int i, const QPointF &p,
+                                                       double maxDistanceSqr) const
+{
+    const QPainterPath &path = m_geometry.srcPath_;
+    if (path.elementAt(i).type == QPainterPath::MoveToElement)
+        return false;
+    const double dsqr = QDeclarativeGeoMapItemUtils::distanceSqrPointLine(p.x(), p.y(),
+                            path.elementAt(i - 1).x, path.elementAt(i - 1).y,
+                            path.elementAt(i).x, path.elementAt(i).y);
+    return dsqr < maxDistanceSqr;
+}
+
+void QDeclarativePolylineMapItemPrivateCPU::updateSegmentGrid() const
+{
+    m_segmentGridDirty = false;
+    m_segmentGrid.clear();
+    m_longSegments.clear();
+
+    const QPainterPath &path = m_geometry.srcPath_;
+    m_segmentGridBounds = path.controlPointRect();
+    m_segmentCellSize = qMax(qMax(m_segmentGridBounds.width(), m_segmentGridBounds.height())
+                                     / SegmentGridResolution, 1.0);
+    // Keep the points on the right and bottom edges inside the last cell
+    m_segmentGridBounds.adjust(0, 0, m_segmentCellSize * 0.5, m_segmentCellSize * 0.5);
 
     for (int i = 1; i < path.elementCount(); i++) {
         if (path.elementAt(i).type == QPainterPath::MoveToElement)
             continue;
-        const double dsqr = QDeclarativeGeoMapItemUtils::distanceSqrPointLine(p.x(), p.y(),
-                                path.elementAt(i - 1).x, path.elementAt(i - 1).y,
-                                path.elementAt(i).x, path.elementAt(i).y);
-        if (dsqr < 0.25 * lineWidth * lineWidth)
-            return true;
+        const QPainterPath::Element &a = path.elementAt(i - 1);
+        const QPainterPath::Element &b = path.elementAt(i);
+        const int left = int((qMin(a.x, b.x) - m_segmentGridBounds.left()) / m_segmentCellSize);
+        const int right = int((qMax(a.x, b.x) - m_segmentGridBounds.left()) / m_segmentCellSize);
+        const int top = int((qMin(a.y, b.y) - m_segmentGridBounds.top()) / m_segmentCellSize);
+        const int bottom = int((qMax(a.y, b.y) - m_segmentGridBounds.top()) / m_segmentCellSize);
+        if ((right - left + 1) * (bottom - top + 1) > SegmentGridMaximumCells) {
+            m_longSegments.append(i);
+            continue;
+        }
+        for (int x = left; x <= right; ++x) {
+            for (int y = top; y <= bottom; ++y)
+                m_segmentGrid[(quint64(x) << 32) | quint32(y)].append(i);
+        }
+    }
+}
+
+QDeclarativePolylineMapItemPrivateGPU::QDeclarativePolylineMapItemPrivateGPU(QDeclarativePolylineMapItem &poly)
+    : QDeclarativePolylineMapItemPrivate(poly)
+{
+}
+
+QDeclarativePolylineMapItemPrivateGPU::~QDeclarativePolylineMapItemPrivateGPU()
+{
+}
+
+void QDeclarativePolylineMapItemPrivateGPU::regenerateCache()
+{
+    m_path.clear();
+    m_pathBounds = QRectF();
+    m_verticesDirty = true;
+    if (!m_poly.map() || m_poly.map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
+        return;
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator&>(m_poly.map()->geoProjection());
+    const QList<QGeoCoordinate> path = m_poly.referenceSurface() == QLocation::ReferenceSurface::Globe
+            ? QDeclarativeGeoMapItemUtils::greaterCirclePath(m_poly.m_geopath.path())
+            : m_poly.m_geopath.path();
+    if (path.size() < 2)
+        return;
+
+    // Walk around the antimeridian when that is shorter, like the CPU backend
+    m_path.reserve(path.size());
+    for (const QGeoCoordinate &c : path) {
+        QDoubleVector2D point = p.geoToMapProjection(c);
+        if (!m_path.isEmpty()) {
+            if (point.x() > m_path.last().x() + 0.5)
+                point.setX(point.x() - 1.0);
+            else if (point.x() < m_path.last().x() - 0.5)
+                point.setX(point.x() + 1.0);
+        }
+        m_path.append(point);
+    }
+
+    // Keep the vertices small, they are uploaded in single precision
+    const QRectF bounds = QDeclarativeGeoMapItemUtils::boundingRectangleFromList(m_path);
+    m_origin = QDoubleVector2D(bounds.center());
+    m_pathBounds = bounds.translated(-bounds.center());
+    for (QDoubleVector2D &point : m_path)
+        point -= m_origin;
+}
+
+void QDeclarativePolylineMapItemPrivateGPU::updatePolish()
+{
+    const QGeoMap *map = m_poly.map();
+    if (m_path.isEmpty() || !map || !m_poly.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        m_poly.setWidth(0);
+        m_poly.setHeight(0);
+        return;
+    }
+    QScopedValueRollback<bool> rollback(m_poly.m_updatingGeometry);
+    m_poly.m_updatingGeometry = true;
+
+    // The line is placed by the shaders, the item bounds it for hit testing
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QRectF rect = QGeoMapItemMesh::itemRect(*m_poly.quickMap(), p, m_origin, m_pathBounds,
+                                                  0.5 * m_poly.m_line.width() + 1);
+    m_poly.setPosition(rect.topLeft());
+    m_poly.setSize(rect.size());
+}
+
+QSGNode *QDeclarativePolylineMapItemPrivateGPU::updateMapItemPaintNode(QSGNode *oldNode,
+                                                                       QQuickItem::UpdatePaintNodeData * /*data*/)
+{
+    QGeoMapLineNode *node = static_cast<QGeoMapLineNode *>(oldNode);
+    const QGeoMap *map = m_poly.map();
+    if (m_path.isEmpty() || !map || !m_poly.quickMap() || m_poly.m_line.width() <= 0
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new QGeoMapLineNode;
+        m_verticesDirty = true;
+    }
+    if (m_verticesDirty) {
+        m_verticesDirty = false;
+        node->setPaths({ m_path });
+    }
+
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    node->setLine(QGeoMapItemMesh::mapMatrix(m_poly, *m_poly.quickMap(), p, m_origin),
+                  m_poly.m_line.color(), m_poly.m_line.width());
+    return node;
+}
+
+bool QDeclarativePolylineMapItemPrivateGPU::contains(const QPointF &point) const
+{
+    return hitTest(point, 0);
+}
+
+bool QDeclarativePolylineMapItemPrivateGPU::hitTest(const QPointF &point, qreal radius) const
+{
+    const QGeoMap *map = m_poly.map();
+    if (m_path.isEmpty() || !map || !m_poly.quickMap()
+            || map->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator) {
+        return false;
+    }
+
+    // The item bounds the stroke
+    const QRectF bounds = m_poly.boundingRect().adjusted(-radius, -radius, radius, radius);
+    if (!bounds.contains(point))
+        return false;
+
+    // Nothing is cached in screen space, project the path like the shaders
+    const QGeoProjectionWebMercator &p = static_cast<const QGeoProjectionWebMercator &>(map->geoProjection());
+    const QDoubleVector2D origin = QGeoMapItemMesh::wrappedOrigin(m_origin, p);
+    const QPointF mapPoint = m_poly.mapToItem(m_poly.quickMap(), point);
+    const double maxDistance = 0.5 * m_poly.m_line.width() + radius;
+    const double maxDistanceSqr = maxDistance * maxDistance;
+
+    QDoubleVector2D previous;
+    bool previousProjectable = false;
+    for (const QDoubleVector2D &vertex : m_path) {
+        const QDoubleVector2D wrapped = origin + vertex;
+        const bool projectable = p.isProjectable(wrapped);
+        const QDoubleVector2D current = projectable ? p.wrappedMapProjectionToItemPosition(wrapped)
+                                                    : QDoubleVector2D();
+        if (projectable && previousProjectable) {
+            const double dsqr = QDeclarativeGeoMapItemUtils::distanceSqrPointLine(
+                        mapPoint.x(), mapPoint.y(),
+                        previous.x(), previous.y(), current.x(), current.y());
+            if (dsqr < maxDistanceSqr)
+                return true;
+        }
+        previous = current;
+        previousProjectable = projectable;
     }
     return false;
 }
@@ -775,6 +995,62 @@ QDeclarativeMapLineProperties *QDeclarativePolylineMapItem::line()
     return &m_line;
 }
 
+/*!
+    \qmlproperty enumeration MapPolyline::backend
+
+    This property holds which backend is in use to render the polyline:
+
+    \value MapPolyline.Software
+        The path is projected and triangulated on the CPU, by a Shape,
+        every time the map moves. This is the default.
+    \value MapPolyline.Shader
+        The Web Mercator coordinates of the path are uploaded once, and the
+        projection and the stroking are done by shaders. Panning or zooming
+        the map only updates a transformation, which suits long lines and
+        routes. Joins and caps are round, and line segments overlap at the
+        joins, which shows with translucent colors. When the scene graph
+        does not render through the graphics hardware abstraction, as with
+        the \c software adaptation, or when Qt Location was built without
+        Qt Shader Tools, the Software backend is used instead.
+
+    \since QtLocation 6.9
+*/
+QDeclarativePolylineMapItem::Backend QDeclarativePolylineMapItem::backend() const
+{
+    return m_backend;
+}
+
+void QDeclarativePolylineMapItem::setBackend(Backend backend)
+{
+    if (backend == m_backend)
+        return;
+    m_backend = backend;
+    updateBackend();
+    emit backendChanged();
+}
+
+/*!
+    \internal
+
+    Replaces the backend implementation if the requested backend, or the
+    ability of the window to run shaders, changed.
+*/
+void QDeclarativePolylineMapItem::updateBackend()
+{
+    Backend backend = m_backend;
+    if (backend == Shader && !QGeoMapItemMesh::isSupported(window()))
+        backend = Software;
+    if (backend == m_activeBackend)
+        return;
+
+    m_activeBackend = backend;
+    if (backend == Shader)
+        m_d.reset(new QDeclarativePolylineMapItemPrivateGPU(*this));
+    else
+        m_d.reset(new QDeclarativePolylineMapItemPrivateCPU(*this));
+    m_d->onGeoGeometryChanged();
+}
+
 /*!
     \internal
 */
@@ -820,6 +1096,7 @@ void QDeclarativePolylineMapItem::updatePolish()
 {
     if (!map() || map()->geoProjection().projectionType() != QGeoProjection::ProjectionWebMercator)
         return;
+    updateBackend();
     m_d->updatePolish();
 }
 
@@ -836,6 +1113,14 @@ bool QDeclarativePolylineMapItem::contains(const QPointF &point) const
     return m_d->contains(point);
 }
 
+/*!
+    \internal
+*/
+bool QDeclarativePolylineMapItem::hitTest(const QPointF &point, qreal radius) const
+{
+    return m_d->hitTest(point, radius);
+}
+
 const QGeoShape &QDeclarativePolylineMapItem::geoShape() const
 {
     return m_geopath;
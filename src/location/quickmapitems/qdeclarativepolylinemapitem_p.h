@@ -62,8 +62,15 @@ class Q_LOCATION_EXPORT QDeclarativePolylineMapItem : public QDeclarativeGeoMapI
 
     Q_PROPERTY(QList<QGeoCoordinate> path READ path WRITE setPath NOTIFY pathChanged)
     Q_PROPERTY(QDeclarativeMapLineProperties *line READ line CONSTANT)
+    Q_PROPERTY(Backend backend READ backend WRITE setBackend NOTIFY backendChanged REVISION(6, 9))
 
 public:
+    enum Backend {
+        Software = 0,
+        Shader = 1
+    };
+    Q_ENUM(Backend)
+
     explicit QDeclarativePolylineMapItem(QQuickItem *parent = nullptr);
     ~QDeclarativePolylineMapItem();
 
@@ -85,13 +92,18 @@ public:
     Q_INVOKABLE void setPath(const QGeoPath &path);
 
     bool contains(const QPointF &point) const override;
+    bool hitTest(const QPointF &point, qreal radius) const override;
     const QGeoShape &geoShape() const override;
     void setGeoShape(const QGeoShape &shape) override;
 
     QDeclarativeMapLineProperties *line();
 
+    Backend backend() const;
+    void setBackend(Backend backend);
+
 Q_SIGNALS:
     void pathChanged();
+    Q_REVISION(6, 9) void backendChanged();
 
 protected Q_SLOTS:
     void updateAfterLinePropertiesChanged();
@@ -101,6 +113,7 @@ protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
     void setPathFromGeoList(const QList<QGeoCoordinate> &path);
     void updatePolish() override;
+    void updateBackend();
 
 #ifdef QT_LOCATION_DEBUG
 public:
@@ -109,11 +122,15 @@ public:
     QDeclarativeMapLineProperties m_line;
 
     bool m_updatingGeometry = false;
+    Backend m_backend = Software;
+    // The backend of m_d, Software when the scene graph can't run shaders
+    Backend m_activeBackend = Software;
 
     std::unique_ptr<QDeclarativePolylineMapItemPrivate> m_d;
 
     friend class QDeclarativePolylineMapItemPrivate;
     friend class QDeclarativePolylineMapItemPrivateCPU;
+    friend class QDeclarativePolylineMapItemPrivateGPU;
 };
 
 QT_END_NAMESPACE
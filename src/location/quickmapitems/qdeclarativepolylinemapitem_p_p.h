@@ -16,6 +16,7 @@
 // We mean it.
 //
 
+#include <QtCore/QHash>
 #include <QtCore/QScopedValueRollback>
 #include <QSGGeometryNode>
 #include <QSGFlatColorMaterial>
@@ -62,6 +63,7 @@ public:
     virtual void afterViewportChanged() = 0;
     virtual QSGNode * updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) = 0;
     virtual bool contains(const QPointF &point) const = 0;
+    virtual bool hitTest(const QPointF &point, qreal radius) const = 0;
 
     QDeclarativePolylineMapItem &m_poly;
 };
@@ -111,12 +113,87 @@ public:
     void updatePolish() override;
     QSGNode *updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData * /*data*/) override;
     bool contains(const QPointF &point) const override;
+    bool hitTest(const QPointF &point, qreal radius) const override;
 
     QList<QDoubleVector2D> m_geopathProjected;
     QGeoMapPolylineGeometry m_geometry;
     QQuickShape *m_shape = nullptr;
     QQuickShapePath *m_shapePath = nullptr;
     QDeclarativeGeoMapPainterPath *m_painterPath = nullptr;
+
+private:
+    // Below this many segments, hit testing just walks the path
+    static constexpr int SegmentGridThreshold = 64;
+    // Number of cells along the longest side of the path
+    static constexpr int SegmentGridResolution = 128;
+    // Segments spanning more cells are tested for every point
+    static constexpr int SegmentGridMaximumCells = 16;
+
+    void updateSegmentGrid() const;
+    bool segmentHit(int i, const QPointF &p, double maxDistanceSqr) const;
+
+    // The segments of m_geometry.srcPath_, bucketed into a uniform grid,
+    // built on the first hit test after the path changes
+    mutable QHash<quint64, QList<int>> m_segmentGrid;
+    mutable QList<int> m_longSegments;
+    mutable QRectF m_segmentGridBounds;
+    mutable qreal m_segmentCellSize = 0;
+    mutable bool m_segmentGridDirty = true;
+};
+
+// Strokes the line on the GPU: the projected path is uploaded once, and
+// the camera only changes the transformation passed to the shaders
+class Q_LOCATION_EXPORT QDeclarativePolylineMapItemPrivateGPU: public QDeclarativePolylineMapItemPrivate
+{
+public:
+    QDeclarativePolylineMapItemPrivateGPU(QDeclarativePolylineMapItem &poly);
+    ~QDeclarativePolylineMapItemPrivateGPU() override;
+
+    void onLinePropertiesChanged() override
+    {
+        // Width and color are uniforms of the shaders
+        m_poly.update();
+    }
+    void markSourceDirtyAndUpdate() override
+    {
+        m_poly.polishAndUpdate();
+    }
+    void regenerateCache();
+    void afterViewportChanged() override
+    {
+        // The polish only keeps the item over the map
+        markSourceDirtyAndUpdate();
+    }
+    void onMapSet() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryChanged() override
+    {
+        regenerateCache();
+        markSourceDirtyAndUpdate();
+    }
+    void onGeoGeometryUpdated() override
+    {
+        onGeoGeometryChanged();
+    }
+    void onItemGeometryChanged() override
+    {
+        onGeoGeometryChanged();
+    }
+    void updatePolish() override;
+    QSGNode *updateMapItemPaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *data) override;
+    bool contains(const QPointF &point) const override;
+    bool hitTest(const QPointF &point, qreal radius) const override;
+
+    // The Web Mercator path, unwrapped across the antimeridian and
+    // relative to m_origin, the center of its bounding box
+    QList<QDoubleVector2D> m_path;
+    QDoubleVector2D m_origin;
+    // The bounding box of m_path
+    QRectF m_pathBounds;
+    bool m_verticesDirty = true;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,516 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeomapitemmesh_p.h"
+#include "qdeclarativegeomapitemutils_p.h"
+
+#include <QtCore/QFile>
+#include <QtGui/QPainterPath>
+#include <QtGui/private/qtriangulator_p.h>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGFlatColorMaterial>
+#include <QtQuick/QSGMaterialShader>
+#include <QtQuick/QSGRendererInterface>
+#include <QtQuick/QSGTransformNode>
+#include <QtLocation/private/qgeoprojection_p.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// A segment of a line is a quad of four of these, see shaders/polyline.vert
+struct LineVertex
+{
+    float startX;
+    float startY;
+    float endX;
+    float endY;
+    float end;
+    float side;
+};
+
+const QSGGeometry::AttributeSet &lineAttributes()
+{
+    static const QSGGeometry::Attribute attributes[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(2, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::UnknownAttribute)
+    };
+    static const QSGGeometry::AttributeSet attributeSet = {
+        3, sizeof(LineVertex), attributes
+    };
+    return attributeSet;
+}
+
+class LineShader : public QSGMaterialShader
+{
+public:
+    LineShader()
+    {
+        setShaderFileName(VertexStage,
+                          QStringLiteral(":/qt-project.org/location/shaders/polyline.vert.qsb"));
+        setShaderFileName(FragmentStage,
+                          QStringLiteral(":/qt-project.org/location/shaders/polyline.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial,
+                           QSGMaterial *oldMaterial) override
+    {
+        Q_UNUSED(oldMaterial);
+        // std140 layout of the uniform block of the shaders
+        QByteArray *buf = state.uniformData();
+        Q_ASSERT(buf->size() >= 152);
+        char *data = buf->data();
+        if (state.isMatrixDirty()) {
+            const QMatrix4x4 m = state.combinedMatrix();
+            memcpy(data, m.constData(), 64);
+        }
+        const QGeoMapLineMaterial *material = static_cast<QGeoMapLineMaterial *>(newMaterial);
+        memcpy(data + 64, material->m_mapMatrix.constData(), 64);
+        const QColor &c = material->m_color;
+        const float color[4] = { float(c.redF() * c.alphaF()), float(c.greenF() * c.alphaF()),
+                                 float(c.blueF() * c.alphaF()), float(c.alphaF()) };
+        memcpy(data + 128, color, 16);
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            memcpy(data + 144, &opacity, 4);
+        }
+        memcpy(data + 148, &material->m_lineWidth, 4);
+        return true;
+    }
+};
+
+// The fill, drawn through a transformation from the zoom level it was
+// triangulated at to the item, and the outline
+class MeshNode : public QSGNode
+{
+public:
+    MeshNode()
+        : m_fillGeometry(QSGGeometry::defaultAttributes_Point2D(), 0, 0,
+                         QSGGeometry::UnsignedIntType)
+    {
+        m_fillGeometry.setDrawingMode(QSGGeometry::DrawTriangles);
+        m_fillGeometry.setVertexDataPattern(QSGGeometry::StaticPattern);
+        m_fillGeometry.setIndexDataPattern(QSGGeometry::StaticPattern);
+        m_fillMaterial.setFlag(QSGMaterial::RequiresFullMatrix);
+        m_fillNode.setGeometry(&m_fillGeometry);
+        m_fillNode.setMaterial(&m_fillMaterial);
+
+        m_transformNode.appendChildNode(&m_fillNode);
+        m_fillNode.setFlag(QSGNode::OwnedByParent, false);
+        appendChildNode(&m_transformNode);
+        m_transformNode.setFlag(QSGNode::OwnedByParent, false);
+    }
+
+    ~MeshNode() override
+    {
+        removeAllChildNodes();
+        m_transformNode.removeAllChildNodes();
+    }
+
+    void setLineVisible(bool visible)
+    {
+        if (visible && !m_lineNode.parent()) {
+            appendChildNode(&m_lineNode);
+            m_lineNode.setFlag(QSGNode::OwnedByParent, false);
+        } else if (!visible && m_lineNode.parent()) {
+            removeChildNode(&m_lineNode);
+        }
+    }
+
+    QSGTransformNode m_transformNode;
+    QSGGeometryNode m_fillNode;
+    QSGGeometry m_fillGeometry;
+    QSGFlatColorMaterial m_fillMaterial;
+    QGeoMapLineNode m_lineNode;
+};
+
+} // anonymous namespace
+
+QGeoMapLineMaterial::QGeoMapLineMaterial()
+{
+    // The line is extruded in item coordinates, which rules out batching
+    setFlag(Blending | RequiresFullMatrix);
+}
+
+QSGMaterialType *QGeoMapLineMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader *QGeoMapLineMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new LineShader;
+}
+
+int QGeoMapLineMaterial::compare(const QSGMaterial *other) const
+{
+    const QGeoMapLineMaterial *o = static_cast<const QGeoMapLineMaterial *>(other);
+    if (m_color != o->m_color)
+        return m_color.rgba() < o->m_color.rgba() ? -1 : 1;
+    if (m_lineWidth != o->m_lineWidth)
+        return m_lineWidth < o->m_lineWidth ? -1 : 1;
+    return memcmp(m_mapMatrix.constData(), o->m_mapMatrix.constData(), 16 * sizeof(float));
+}
+
+QGeoMapLineNode::QGeoMapLineNode()
+    : m_geometry(lineAttributes(), 0, 0, QSGGeometry::UnsignedIntType)
+{
+    m_geometry.setDrawingMode(QSGGeometry::DrawTriangles);
+    m_geometry.setVertexDataPattern(QSGGeometry::StaticPattern);
+    m_geometry.setIndexDataPattern(QSGGeometry::StaticPattern);
+    setGeometry(&m_geometry);
+    setMaterial(&m_material);
+}
+
+// Uploads the segments of paths, relative to the origin of the matrix
+void QGeoMapLineNode::setPaths(const QList<QList<QDoubleVector2D>> &paths)
+{
+    qsizetype segments = 0;
+    for (const QList<QDoubleVector2D> &path : paths)
+        segments += qMax(path.size() - 1, qsizetype(0));
+    m_geometry.allocate(int(segments * 4), int(segments * 6));
+
+    LineVertex *vertices = static_cast<LineVertex *>(m_geometry.vertexData());
+    quint32 *indices = m_geometry.indexDataAsUInt();
+    quint32 first = 0;
+    for (const QList<QDoubleVector2D> &path : paths) {
+        for (qsizetype i = 1; i < path.size(); ++i) {
+            const float startX = float(path.at(i - 1).x());
+            const float startY = float(path.at(i - 1).y());
+            const float endX = float(path.at(i).x());
+            const float endY = float(path.at(i).y());
+            vertices[0] = { startX, startY, endX, endY, 0.0f, -1.0f };
+            vertices[1] = { startX, startY, endX, endY, 0.0f, 1.0f };
+            vertices[2] = { startX, startY, endX, endY, 1.0f, -1.0f };
+            vertices[3] = { startX, startY, endX, endY, 1.0f, 1.0f };
+            vertices += 4;
+
+            indices[0] = first;
+            indices[1] = first + 1;
+            indices[2] = first + 2;
+            indices[3] = first + 2;
+            indices[4] = first + 1;
+            indices[5] = first + 3;
+            indices += 6;
+            first += 4;
+        }
+    }
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+void QGeoMapLineNode::setLine(const QMatrix4x4 &mapMatrix, const QColor &color, qreal width)
+{
+    m_material.m_mapMatrix = mapMatrix;
+    m_material.m_color = color;
+    m_material.m_lineWidth = float(width);
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+/*!
+    \internal
+
+    Sets the Web Mercator \a rings, unwrapped across the antimeridian.
+    Their vertices are stored relative to the center of their bounding box,
+    to be uploaded in single precision.
+*/
+void QGeoMapItemMesh::setRings(const QList<QList<QDoubleVector2D>> &rings)
+{
+    m_rings.clear();
+    m_bounds = QRectF();
+    m_tessellations.clear();
+    m_fillDirty = true;
+    m_lineDirty = true;
+
+    QRectF bounds;
+    for (const QList<QDoubleVector2D> &ring : rings) {
+        if (ring.size() >= 3)
+            bounds |= QDeclarativeGeoMapItemUtils::boundingRectangleFromList(ring);
+    }
+    m_origin = QDoubleVector2D(bounds.center());
+    m_bounds = bounds.translated(-bounds.center());
+    for (const QList<QDoubleVector2D> &ring : rings) {
+        if (ring.size() < 3)
+            continue;
+        QList<QDoubleVector2D> relative;
+        relative.reserve(ring.size() + 1);
+        for (const QDoubleVector2D &point : ring)
+            relative.append(point - m_origin);
+        if (relative.first() != relative.last())
+            relative.append(relative.first()); // closes the outline
+        m_rings.append(relative);
+    }
+
+    // Keep the pixel coordinates at the zoom band within 2^24
+    const double extent = qMax(bounds.width(), bounds.height()) * 0.5;
+    m_maximumZoomBand = extent > 0
+            ? qBound(0, int(std::floor(std::log2((1 << 24) / (256.0 * extent)))), 30)
+            : 30;
+}
+
+/*!
+    \internal
+
+    Makes sure the fill is triangulated for the zoom band of \a zoomLevel,
+    reusing a cached tessellation when possible. Called on polish.
+*/
+void QGeoMapItemMesh::updateTessellation(double zoomLevel)
+{
+    if (m_rings.isEmpty())
+        return;
+    const int zoomBand = qMin(qMax(int(std::floor(zoomLevel)), 0), m_maximumZoomBand);
+    if (!m_tessellations.isEmpty() && m_tessellations.first().zoomBand == zoomBand)
+        return;
+
+    m_fillDirty = true;
+    for (qsizetype i = 1; i < m_tessellations.size(); ++i) {
+        if (m_tessellations.at(i).zoomBand == zoomBand) {
+            m_tessellations.move(i, 0);
+            return;
+        }
+    }
+    m_tessellations.prepend(tessellate(zoomBand));
+    if (m_tessellations.size() > MaximumTessellations)
+        m_tessellations.removeLast();
+}
+
+// Triangulates the rings in pixels at zoomBand, leaving out the vertices
+// closer than a quarter pixel to the previous one
+QGeoMapItemMesh::Tessellation QGeoMapItemMesh::tessellate(int zoomBand) const
+{
+    const double scale = 256.0 * std::exp2(zoomBand);
+    QPainterPath path;
+    path.setFillRule(Qt::OddEvenFill);
+    for (const QList<QDoubleVector2D> &ring : m_rings) {
+        QDoubleVector2D last = ring.first() * scale;
+        path.moveTo(last.toPointF());
+        for (qsizetype i = 1; i < ring.size(); ++i) {
+            const QDoubleVector2D point = ring.at(i) * scale;
+            if ((point - last).manhattanLength() < 0.25)
+                continue;
+            path.lineTo(point.toPointF());
+            last = point;
+        }
+        path.closeSubpath();
+    }
+
+    Tessellation result;
+    result.zoomBand = zoomBand;
+    const QTriangleSet triangles = qTriangulate(path);
+    result.vertices.resize(triangles.vertices.size() / 2);
+    for (qsizetype i = 0; i < result.vertices.size(); ++i) {
+        result.vertices[i].set(float(triangles.vertices.at(2 * i)),
+                               float(triangles.vertices.at(2 * i + 1)));
+    }
+    result.indices.resize(triangles.indices.size());
+    if (triangles.indices.type() == QVertexIndexVector::UnsignedInt) {
+        const quint32 *indices = static_cast<const quint32 *>(triangles.indices.data());
+        std::copy(indices, indices + triangles.indices.size(), result.indices.begin());
+    } else {
+        const quint16 *indices = static_cast<const quint16 *>(triangles.indices.data());
+        std::copy(indices, indices + triangles.indices.size(), result.indices.begin());
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns whether the Web Mercator \a point, relative to origin(), is
+    inside the rings, with the odd-even rule.
+*/
+bool QGeoMapItemMesh::contains(const QDoubleVector2D &point) const
+{
+    bool inside = false;
+    for (const QList<QDoubleVector2D> &ring : m_rings) {
+        for (qsizetype i = 1; i < ring.size(); ++i) {
+            const QDoubleVector2D &a = ring.at(i - 1);
+            const QDoubleVector2D &b = ring.at(i);
+            if ((a.y() > point.y()) != (b.y() > point.y())
+                    && point.x() < a.x() + (point.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y())) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+/*!
+    \internal
+
+    Updates \a oldNode, which must have been created by this function,
+    to draw the rings with \a mapMatrix, as returned by mapMatrix().
+    Only the matrices change unless the rings or the tessellation did.
+*/
+QSGNode *QGeoMapItemMesh::updatePaintNode(QSGNode *oldNode, const QMatrix4x4 &mapMatrix,
+                                          const QColor &color, const QColor &borderColor,
+                                          qreal borderWidth)
+{
+    MeshNode *node = static_cast<MeshNode *>(oldNode);
+    if (m_rings.isEmpty() || m_tessellations.isEmpty()) {
+        delete node;
+        return nullptr;
+    }
+    if (!node) {
+        node = new MeshNode;
+        m_fillDirty = true;
+        m_lineDirty = true;
+    }
+
+    const Tessellation &tessellation = m_tessellations.first();
+    if (m_fillDirty) {
+        m_fillDirty = false;
+        QSGGeometry &geometry = node->m_fillGeometry;
+        geometry.allocate(int(tessellation.vertices.size()), int(tessellation.indices.size()));
+        std::copy(tessellation.vertices.cbegin(), tessellation.vertices.cend(),
+                  geometry.vertexDataAsPoint2D());
+        std::copy(tessellation.indices.cbegin(), tessellation.indices.cend(),
+                  geometry.indexDataAsUInt());
+        node->m_fillNode.markDirty(QSGNode::DirtyGeometry);
+    }
+    if (node->m_fillMaterial.color() != color) {
+        node->m_fillMaterial.setColor(color);
+        node->m_fillNode.markDirty(QSGNode::DirtyMaterial);
+    }
+    QMatrix4x4 fillMatrix = mapMatrix;
+    const float scale = float(1.0 / (256.0 * std::exp2(tessellation.zoomBand)));
+    fillMatrix.scale(scale, scale);
+    node->m_transformNode.setMatrix(fillMatrix);
+
+    const bool hasBorder = borderColor.alpha() != 0 && borderWidth > 0;
+    node->setLineVisible(hasBorder);
+    if (hasBorder) {
+        if (m_lineDirty) {
+            m_lineDirty = false;
+            node->m_lineNode.setPaths(m_rings);
+        }
+        node->m_lineNode.setLine(mapMatrix, borderColor, borderWidth);
+    }
+    return node;
+}
+
+/*!
+    \internal
+
+    Returns \a ring with its points moved by whole worlds, so that
+    consecutive points, and the first point and \a referenceX, are less
+    than half a world apart. This walks across the antimeridian like the
+    CPU backends of the map items do.
+*/
+QList<QDoubleVector2D> QGeoMapItemMesh::unwrapped(const QList<QDoubleVector2D> &ring,
+                                                  double referenceX)
+{
+    QList<QDoubleVector2D> result;
+    result.reserve(ring.size());
+    double previousX = referenceX;
+    for (QDoubleVector2D point : ring) {
+        point.setX(point.x() + std::round(previousX - point.x()));
+        previousX = point.x();
+        result.append(point);
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns whether the Shader backends of the map items can render in
+    \a window. The shaders are only built when Qt Shader Tools is
+    available, and only the scene graph adaptations based on the graphics
+    hardware abstraction run custom materials. A null \a window, before the
+    item is shown, only checks the shaders.
+*/
+bool QGeoMapItemMesh::isSupported(const QQuickWindow *window)
+{
+    static const bool shadersBuilt =
+            QFile::exists(QStringLiteral(":/qt-project.org/location/shaders/polyline.vert.qsb"));
+    if (!shadersBuilt)
+        return false;
+    return !window
+            || QSGRendererInterface::isApiRhiBased(window->rendererInterface()->graphicsApi());
+}
+
+/*!
+    \internal
+
+    Returns the copy of \a origin, around the world, closest to the camera.
+*/
+QDoubleVector2D QGeoMapItemMesh::wrappedOrigin(const QDoubleVector2D &origin,
+                                               const QGeoProjectionWebMercator &p)
+{
+    const double centerX = p.centerMercator().x();
+    if (origin.x() - centerX > 0.5)
+        return origin - QDoubleVector2D(1.0, 0.0);
+    if (centerX - origin.x() > 0.5)
+        return origin + QDoubleVector2D(1.0, 0.0);
+    return origin;
+}
+
+/*!
+    \internal
+
+    Returns the transformation from Web Mercator coordinates relative to
+    \a origin to the coordinates of \a item, on \a map.
+*/
+QMatrix4x4 QGeoMapItemMesh::mapMatrix(const QQuickItem &item, const QQuickItem &map,
+                                      const QGeoProjectionWebMercator &p,
+                                      const QDoubleVector2D &origin)
+{
+    // From the origin to the camera center in double precision, then
+    // through the projection centered on the camera
+    const QDoubleVector3D center = p.centerMercator();
+    const QDoubleVector2D offset = wrappedOrigin(origin, p) - QDoubleVector2D(center.x(), center.y());
+    QMatrix4x4 matrix;
+    matrix.translate(QVector3D(item.mapFromItem(&map, QPointF(0, 0))));
+    matrix *= p.projectionTransformation_centered();
+    matrix.translate(float(offset.x()), float(offset.y()));
+    return matrix;
+}
+
+/*!
+    \internal
+
+    Returns the rectangle of \a map covered by the Web Mercator \a bounds,
+    relative to \a origin, grown by \a margin pixels. The items drawn by
+    the shaders are sized to it, so that the map only hit tests them where
+    they are. When part of the bounds is behind the camera, the whole map
+    is returned.
+*/
+QRectF QGeoMapItemMesh::itemRect(const QQuickItem &map, const QGeoProjectionWebMercator &p,
+                                 const QDoubleVector2D &origin, const QRectF &bounds,
+                                 qreal margin)
+{
+    const QRectF mapRect(QPointF(0, 0), map.size());
+    const QDoubleVector2D wrapped = wrappedOrigin(origin, p);
+    const QPointF corners[] = { bounds.topLeft(), bounds.topRight(),
+                                bounds.bottomLeft(), bounds.bottomRight() };
+    // QRectF::united() would skip the empty rectangles of straight lines
+    qreal left = qInf();
+    qreal top = qInf();
+    qreal right = -qInf();
+    qreal bottom = -qInf();
+    for (const QPointF &corner : corners) {
+        const QDoubleVector2D point = wrapped + QDoubleVector2D(corner);
+        if (!p.isProjectable(point))
+            return mapRect;
+        const QDoubleVector2D itemPoint = p.wrappedMapProjectionToItemPosition(point);
+        left = qMin(left, itemPoint.x());
+        top = qMin(top, itemPoint.y());
+        right = qMax(right, itemPoint.x());
+        bottom = qMax(bottom, itemPoint.y());
+    }
+    return QRectF(QPointF(left, top), QPointF(right, bottom))
+            .adjusted(-margin, -margin, margin, margin)
+            .intersected(mapRect);
+}
+
+QT_END_NAMESPACE
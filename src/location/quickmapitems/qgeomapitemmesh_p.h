@@ -0,0 +1,124 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOMAPITEMMESH_P_H
+#define QGEOMAPITEMMESH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtLocation/private/qlocationglobal_p.h>
+
+#include <QtCore/QList>
+#include <QtCore/QRectF>
+#include <QtGui/QColor>
+#include <QtGui/QMatrix4x4>
+#include <QtQuick/QSGGeometry>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/QSGMaterial>
+#include <QtPositioning/private/qdoublevector2d_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickItem;
+class QQuickWindow;
+class QGeoProjectionWebMercator;
+
+class Q_LOCATION_EXPORT QGeoMapLineMaterial : public QSGMaterial
+{
+public:
+    QGeoMapLineMaterial();
+
+    QSGMaterialType *type() const override;
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial *other) const override;
+
+    QMatrix4x4 m_mapMatrix;
+    QColor m_color;
+    float m_lineWidth = 1.0f;
+};
+
+// Strokes paths given in Web Mercator coordinates on the GPU, see
+// shaders/polyline.vert. The vertices are only uploaded when the paths
+// change, the camera only changes the matrix set with setLine().
+class Q_LOCATION_EXPORT QGeoMapLineNode : public QSGGeometryNode
+{
+public:
+    QGeoMapLineNode();
+
+    void setPaths(const QList<QList<QDoubleVector2D>> &paths);
+    void setLine(const QMatrix4x4 &mapMatrix, const QColor &color, qreal width);
+
+private:
+    QSGGeometry m_geometry;
+    QGeoMapLineMaterial m_material;
+};
+
+// The fill and the outline of a set of Web Mercator rings, like a polygon
+// and its holes. The fill is triangulated at the integer zoom level below
+// the camera, and drawn scaled, so that panning, rotating, tilting and
+// zooming within the zoom level reuse the triangles.
+class Q_LOCATION_EXPORT QGeoMapItemMesh
+{
+public:
+    void setRings(const QList<QList<QDoubleVector2D>> &rings);
+    bool isEmpty() const { return m_rings.isEmpty(); }
+    QDoubleVector2D origin() const { return m_origin; }
+    QRectF bounds() const { return m_bounds; }
+
+    void updateTessellation(double zoomLevel);
+    bool contains(const QDoubleVector2D &point) const;
+
+    QSGNode *updatePaintNode(QSGNode *oldNode, const QMatrix4x4 &mapMatrix,
+                             const QColor &color, const QColor &borderColor,
+                             qreal borderWidth);
+
+    static bool isSupported(const QQuickWindow *window);
+    static QList<QDoubleVector2D> unwrapped(const QList<QDoubleVector2D> &ring,
+                                            double referenceX);
+    static QDoubleVector2D wrappedOrigin(const QDoubleVector2D &origin,
+                                         const QGeoProjectionWebMercator &p);
+    static QMatrix4x4 mapMatrix(const QQuickItem &item, const QQuickItem &map,
+                                const QGeoProjectionWebMercator &p,
+                                const QDoubleVector2D &origin);
+    static QRectF itemRect(const QQuickItem &map, const QGeoProjectionWebMercator &p,
+                           const QDoubleVector2D &origin, const QRectF &bounds,
+                           qreal margin);
+
+private:
+    struct Tessellation
+    {
+        int zoomBand = 0;
+        QList<QSGGeometry::Point2D> vertices;
+        QList<quint32> indices;
+    };
+
+    // Tessellations kept for zooming back and forth across a zoom level
+    static constexpr int MaximumTessellations = 3;
+
+    Tessellation tessellate(int zoomBand) const;
+
+    // Relative to m_origin, the center of their bounding box
+    QList<QList<QDoubleVector2D>> m_rings;
+    QDoubleVector2D m_origin;
+    // Of the rings, relative to m_origin
+    QRectF m_bounds;
+    // The triangulator works in fixed point, which limits the zoom level
+    int m_maximumZoomBand = 0;
+    // Most recently used first
+    QList<Tessellation> m_tessellations;
+    bool m_fillDirty = true;
+    bool m_lineDirty = true;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOMAPITEMMESH_P_H
@@ -0,0 +1,28 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#version 440
+
+layout(location = 0) in vec2 lineCoord;
+layout(location = 1) in float segmentLength;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    mat4 mapMatrix;
+    vec4 color;
+    float qt_Opacity;
+    float lineWidth;
+} ubuf;
+
+void main()
+{
+    // Distance to the segment, which rounds the caps and the joins
+    float along = lineCoord.x - clamp(lineCoord.x, 0.0, segmentLength);
+    float distance = length(vec2(along, lineCoord.y));
+    float coverage = clamp(0.5 * ubuf.lineWidth + 0.5 - distance, 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+    fragColor = ubuf.color * (ubuf.qt_Opacity * coverage);
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#version 440
+
+// Every segment of the line is drawn as a quad, extruded here from the Web
+// Mercator coordinates of its end points, relative to the origin of the path.
+layout(location = 0) in vec2 segmentStart;
+layout(location = 1) in vec2 segmentEnd;
+// x: 0 at the start of the segment, 1 at its end; y: -1 or 1, the side of the line
+layout(location = 2) in vec2 corner;
+
+// Position in the quad in pixels: along the segment, and across it
+layout(location = 0) out vec2 lineCoord;
+layout(location = 1) out float segmentLength;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    // Maps the path to item coordinates, updated when the camera moves
+    mat4 mapMatrix;
+    vec4 color;
+    float qt_Opacity;
+    float lineWidth;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    vec4 start = ubuf.mapMatrix * vec4(segmentStart, 0.0, 1.0);
+    vec4 end = ubuf.mapMatrix * vec4(segmentEnd, 0.0, 1.0);
+    if (start.w <= 0.0 || end.w <= 0.0) {
+        // Behind the camera, drop the segment
+        lineCoord = vec2(0.0);
+        segmentLength = 0.0;
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    vec2 a = start.xy / start.w;
+    vec2 b = end.xy / end.w;
+    float len = length(b - a);
+    vec2 direction = len > 0.0 ? (b - a) / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-direction.y, direction.x);
+
+    // Half a pixel more than the stroke, for antialiasing, and the round
+    // caps closing the joins with the neighbouring segments
+    float extent = 0.5 * ubuf.lineWidth + 0.5;
+    float outward = corner.x * 2.0 - 1.0;
+    vec2 pos = mix(a, b, corner.x) + direction * outward * extent + normal * corner.y * extent;
+
+    lineCoord = vec2(corner.x * len + outward * extent, corner.y * extent);
+    segmentLength = len;
+    gl_Position = ubuf.qt_Matrix * vec4(pos, 0.0, 1.0);
+}
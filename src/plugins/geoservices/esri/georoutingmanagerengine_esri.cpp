@@ -4,6 +4,8 @@
 #include "georoutingmanagerengine_esri.h"
 #include "georoutereply_esri.h"
 
+#include <QtLocation/private/qgeorouterequest_p.h>
+
 #include <QUrlQuery>
 
 QT_BEGIN_NAMESPACE
@@ -63,6 +65,8 @@ QGeoRouteReply *GeoRoutingManagerEngineEsri::calculateRoute(const QGeoRouteReque
 
     url.setQuery(query);
     networkRequest.setUrl(url);
+    networkRequest.setPriority(
+            QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
 
     QNetworkReply *reply = m_networkManager->get(networkRequest);
     GeoRouteReplyEsri *routeReply = new GeoRouteReplyEsri(reply, request, this);
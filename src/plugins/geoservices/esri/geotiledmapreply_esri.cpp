@@ -61,10 +61,14 @@ void GeoTiledMapReplyEsri::networkReplyError(QNetworkReply::NetworkError error)
 {
     QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
     reply->deleteLater();
-    if (error == QNetworkReply::OperationCanceledError)
+    if (error == QNetworkReply::OperationCanceledError) {
         setFinished(true);
-    else
-        setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
+        return;
+    }
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 503) // the tile fetcher backs off
+        setRetryAfter(reply->rawHeader("Retry-After"));
+    setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
 }
 
 QT_END_NAMESPACE
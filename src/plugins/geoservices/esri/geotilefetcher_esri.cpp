@@ -16,12 +16,16 @@ GeoTileFetcherEsri::GeoTileFetcherEsri(QGeoTiledMappingManagerEngine *parent) :
     QGeoTileFetcher(parent), m_networkManager(new QNetworkAccessManager(this)),
     m_userAgent(QByteArrayLiteral("Qt Location based application"))
 {
+    // Keeps six HTTP/1.1 connections or an HTTP/2 one busy, while the rest
+    // of the queue can still be cancelled when the map moves
+    setMaximumConcurrentRequests(8);
 }
 
 QGeoTiledMapReply *GeoTileFetcherEsri::getTileImage(const QGeoTileSpec &spec)
 {
     QNetworkRequest request;
     request.setHeader(QNetworkRequest::UserAgentHeader, userAgent());
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
 
     GeoTiledMappingManagerEngineEsri *engine = qobject_cast<GeoTiledMappingManagerEngineEsri *>(
           parent());
@@ -41,8 +41,12 @@ void QGeoMapReplyMapbox::networkReplyError(QNetworkReply::NetworkError error)
 {
     QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
     reply->deleteLater();
-    if (error == QNetworkReply::OperationCanceledError)
+    if (error == QNetworkReply::OperationCanceledError) {
         setFinished(true);
-    else
-        setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
+        return;
+    }
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 503) // the tile fetcher backs off
+        setRetryAfter(reply->rawHeader("Retry-After"));
+    setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
 }
@@ -0,0 +1,29 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEMATRIXREPLYMAPBOX_H
+#define QGEOROUTEMATRIXREPLYMAPBOX_H
+
+#include <QtNetwork/QNetworkReply>
+#include <QtLocation/QGeoRouteMatrixReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteMatrixReplyMapbox : public QGeoRouteMatrixReply
+{
+    Q_OBJECT
+
+public:
+    QGeoRouteMatrixReplyMapbox(QNetworkReply *reply, const QList<QGeoCoordinate> &sources,
+                               const QList<QGeoCoordinate> &destinations,
+                               const QGeoRouteRequest &request, QObject *parent = nullptr);
+    ~QGeoRouteMatrixReplyMapbox();
+
+private Q_SLOTS:
+    void networkReplyFinished();
+    void networkReplyError(QNetworkReply::NetworkError error);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEMATRIXREPLYMAPBOX_H
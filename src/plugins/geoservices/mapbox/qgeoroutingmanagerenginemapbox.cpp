@@ -4,8 +4,11 @@
 
 #include "qgeoroutingmanagerenginemapbox.h"
 #include "qgeoroutereplymapbox.h"
+#include "qgeoroutematrixreplymapbox.h"
 #include "qmapboxcommon.h"
 #include <QtLocation/private/qgeorouteparserosrmv5_p.h>
+#include <QtLocation/private/qgeorouterequest_p.h>
+#include <QtLocation/private/qgeoroutingmanagerengine_p.h>
 #include <QtLocation/qgeoroutesegment.h>
 #include <QtLocation/qgeomaneuver.h>
 
@@ -211,6 +214,12 @@ QGeoRoutingManagerEngineMapbox::QGeoRoutingManagerEngineMapbox(const QVariantMap
     }
     m_routeParser = parser;
 
+    QGeoRoutingManagerEnginePrivate::get(this)->routeMatrix =
+            [this](const QList<QGeoCoordinate> &sources, const QList<QGeoCoordinate> &destinations,
+                   const QGeoRouteRequest &request) {
+        return calculateRouteMatrix(sources, destinations, request);
+    };
+
     *error = QGeoServiceProvider::NoError;
     errorString->clear();
 }
@@ -224,26 +233,11 @@ QGeoRouteReply* QGeoRoutingManagerEngineMapbox::calculateRoute(const QGeoRouteRe
     QNetworkRequest networkRequest;
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
 
-    QString url = mapboxDirectionsApiPath;
-
-    QGeoRouteRequest::TravelModes travelModes = request.travelModes();
-    if (travelModes.testFlag(QGeoRouteRequest::PedestrianTravel)) {
-        url += QStringLiteral("walking/");
-    } else if (travelModes.testFlag(QGeoRouteRequest::BicycleTravel)) {
-        url += QStringLiteral("cycling/");
-    } else if (travelModes.testFlag(QGeoRouteRequest::CarTravel)) {
-        const QList<QGeoRouteRequest::FeatureType> &featureTypes = request.featureTypes();
-        int trafficFeatureIdx = featureTypes.indexOf(QGeoRouteRequest::TrafficFeature);
-        QGeoRouteRequest::FeatureWeight trafficWeight = request.featureWeight(QGeoRouteRequest::TrafficFeature);
-        if (trafficFeatureIdx >= 0 &&
-           (trafficWeight == QGeoRouteRequest::AvoidFeatureWeight || trafficWeight == QGeoRouteRequest::DisallowFeatureWeight)) {
-            url += QStringLiteral("driving-traffic/");
-        } else {
-            url += QStringLiteral("driving/");
-        }
-    }
+    QString url = mapboxDirectionsApiPath + profile(request);
 
     networkRequest.setUrl(m_routeParser->requestUrl(request, url));
+    networkRequest.setPriority(
+            QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
 
     QNetworkReply *reply = m_networkManager->get(networkRequest);
 
@@ -257,6 +251,61 @@ QGeoRouteReply* QGeoRoutingManagerEngineMapbox::calculateRoute(const QGeoRouteRe
     return routeReply;
 }
 
+QGeoRouteMatrixReply *QGeoRoutingManagerEngineMapbox::calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                                                           const QList<QGeoCoordinate> &destinations,
+                                                                           const QGeoRouteRequest &request)
+{
+    const QString travelProfile = profile(request);
+
+    // Larger matrices are rejected by the Matrix API, so they are calculated
+    // route by route instead, by QGeoRoutingManager
+    const qsizetype maximumCoordinates =
+            travelProfile == QLatin1String("driving-traffic/") ? 10 : 25;
+    if (sources.isEmpty() || destinations.isEmpty()
+            || sources.size() + destinations.size() > maximumCoordinates) {
+        return nullptr;
+    }
+
+    QUrl url = m_routeParser->matrixRequestUrl(sources, destinations, request,
+                                               mapboxMatrixApiPath + travelProfile);
+    if (!url.isValid())
+        return nullptr;
+    if (!m_accessToken.isEmpty()) {
+        QUrlQuery query(url);
+        query.addQueryItem(QLatin1String("access_token"), m_accessToken);
+        url.setQuery(query);
+    }
+
+    QNetworkRequest networkRequest;
+    networkRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    networkRequest.setUrl(url);
+    networkRequest.setPriority(
+            QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
+
+    QNetworkReply *reply = m_networkManager->get(networkRequest);
+    return new QGeoRouteMatrixReplyMapbox(reply, sources, destinations, request, this);
+}
+
+QString QGeoRoutingManagerEngineMapbox::profile(const QGeoRouteRequest &request)
+{
+    QGeoRouteRequest::TravelModes travelModes = request.travelModes();
+    if (travelModes.testFlag(QGeoRouteRequest::PedestrianTravel))
+        return QStringLiteral("walking/");
+    if (travelModes.testFlag(QGeoRouteRequest::BicycleTravel))
+        return QStringLiteral("cycling/");
+    if (travelModes.testFlag(QGeoRouteRequest::CarTravel)) {
+        const QList<QGeoRouteRequest::FeatureType> &featureTypes = request.featureTypes();
+        int trafficFeatureIdx = featureTypes.indexOf(QGeoRouteRequest::TrafficFeature);
+        QGeoRouteRequest::FeatureWeight trafficWeight = request.featureWeight(QGeoRouteRequest::TrafficFeature);
+        if (trafficFeatureIdx >= 0 &&
+           (trafficWeight == QGeoRouteRequest::AvoidFeatureWeight || trafficWeight == QGeoRouteRequest::DisallowFeatureWeight)) {
+            return QStringLiteral("driving-traffic/");
+        }
+        return QStringLiteral("driving/");
+    }
+    return QString();
+}
+
 const QGeoRouteParser *QGeoRoutingManagerEngineMapbox::routeParser() const
 {
     return m_routeParser;
@@ -12,6 +12,7 @@ QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
 class QGeoRouteParser;
+class QGeoRouteMatrixReply;
 
 class QGeoRoutingManagerEngineMapbox : public QGeoRoutingManagerEngine
 {
@@ -31,6 +32,11 @@ private Q_SLOTS:
     void replyError(QGeoRouteReply::Error errorCode, const QString &errorString);
 
 private:
+    QGeoRouteMatrixReply *calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                               const QList<QGeoCoordinate> &destinations,
+                                               const QGeoRouteRequest &request);
+    static QString profile(const QGeoRouteRequest &request);
+
     QNetworkAccessManager *m_networkManager;
     QByteArray m_userAgent;
     QString m_accessToken;
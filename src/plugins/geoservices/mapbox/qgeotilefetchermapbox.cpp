@@ -22,6 +22,9 @@ QGeoTileFetcherMapbox::QGeoTileFetcherMapbox(int scaleFactor, QGeoTiledMappingMa
     m_accessToken("")
 {
     m_scaleFactor = qBound(1, scaleFactor, 2);
+    // Enough to keep the HTTP/2 connection busy, while the rest of the
+    // queue can still be cancelled when the map moves
+    setMaximumConcurrentRequests(16);
 }
 
 void QGeoTileFetcherMapbox::setUserAgent(const QByteArray &userAgent)
@@ -55,6 +58,7 @@ QGeoTiledMapReply *QGeoTileFetcherMapbox::getTileImage(const QGeoTileSpec &spec)
 {
     QNetworkRequest request;
     request.setRawHeader("User-Agent", m_userAgent);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
 
     request.setUrl(QUrl(mapboxTilesApiPath +
                         ((spec.mapId() >= m_mapIds.size()) ? QStringLiteral("mapbox.streets") : m_mapIds[spec.mapId() - 1]) + QLatin1Char('/') +
@@ -19,6 +19,9 @@ static const QString mapboxGeocodingEnterpriseApiPath = QStringLiteral("https://
 // https://www.mapbox.com/api-documentation/#directions
 static const QString mapboxDirectionsApiPath = QStringLiteral("https://api.mapbox.com/directions/v5/mapbox/");
 
+// https://docs.mapbox.com/api/navigation/matrix/
+static const QString mapboxMatrixApiPath = QStringLiteral("https://api.mapbox.com/directions-matrix/v1/mapbox/");
+
 static const QByteArray mapboxDefaultUserAgent = QByteArrayLiteral("Qt Location based application");
 
 static const qreal mapboxDefaultRadius = 50000;
@@ -330,12 +330,15 @@ bool parseLocation(const QJsonObject &obj, const QGeoShape &bounds, QGeoLocation
     return true;
 }
 
-void parseDocument(const QJsonDocument &doc, const QGeoShape &bounds, QList<QGeoLocation> *locs)
+void parseDocument(const QJsonDocument &doc, const QGeoShape &bounds, QList<QGeoLocation> *locs,
+                   const std::atomic_bool *cancelled)
 {
     QJsonArray view = doc.object().value("Response").toObject().value("View").toArray();
     for (const QJsonValueRef viewElement : view) {
         QJsonArray result = viewElement.toObject().value("Result").toArray();
         for (const QJsonValueRef resultElement : result) {
+            if (cancelled && *cancelled)
+                return;
             QGeoLocation location;
             if (parseLocation(resultElement.toObject().value("Location").toObject(), bounds, &location)) {
                 locs->append(location);
@@ -351,6 +354,13 @@ void QGeoCodeJsonParser::setBounds(const QGeoShape &bounds)
     m_bounds = bounds;
 }
 
+// Set by the reply when it is aborted or destroyed, the parsing then stops
+// without reporting results or errors
+void QGeoCodeJsonParser::setCancellationFlag(const std::shared_ptr<std::atomic_bool> &cancelled)
+{
+    m_cancelled = cancelled;
+}
+
 void QGeoCodeJsonParser::parse(const QByteArray &data)
 {
     m_data = data;
@@ -362,14 +372,17 @@ void QGeoCodeJsonParser::run()
     // parse the document.
     QJsonParseError perror;
     m_document = QJsonDocument::fromJson(m_data, &perror);
+    if (m_cancelled && *m_cancelled)
+        return;
     if (perror.error != QJsonParseError::NoError) {
         m_errorString = perror.errorString();
     } else {
         // ensure that the response is valid and contains the information we need.
         if (checkDocument(m_document, &m_errorString)) {
             // extract the location results from the response.
-            parseDocument(m_document, m_bounds, &m_results);
-            emit results(m_results);
+            parseDocument(m_document, m_bounds, &m_results, m_cancelled.get());
+            if (!m_cancelled || !*m_cancelled)
+                emit results(m_results);
             return;
         }
     }
@@ -14,6 +14,9 @@
 #include <QtCore/QString>
 #include <QtCore/QList>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QGeoCodeJsonParser : public QObject, public QRunnable
@@ -22,6 +25,7 @@ class QGeoCodeJsonParser : public QObject, public QRunnable
 
 public:
     void setBounds(const QGeoShape &bounds);
+    void setCancellationFlag(const std::shared_ptr<std::atomic_bool> &cancelled);
     void parse(const QByteArray &data);
     void run() override;
 
@@ -35,6 +39,7 @@ private:
     QGeoShape m_bounds;
     QList<QGeoLocation> m_results;
     QString m_errorString;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
 };
 
 QT_END_NAMESPACE
@@ -20,7 +20,8 @@ QT_BEGIN_NAMESPACE
 QGeoCodeReplyNokia::QGeoCodeReplyNokia(QNetworkReply *reply, int limit, int offset,
                                        const QGeoShape &viewport, bool manualBoundsRequired,
                                        QObject *parent)
-:   QGeoCodeReply(parent), m_parsing(false), m_manualBoundsRequired(manualBoundsRequired)
+:   QGeoCodeReply(parent), m_parsing(false), m_manualBoundsRequired(manualBoundsRequired),
+    m_cancelled(std::make_shared<std::atomic_bool>(false))
 {
     if (!reply) {
         setError(UnknownError, QStringLiteral("Null reply"));
@@ -33,7 +34,7 @@ QGeoCodeReplyNokia::QGeoCodeReplyNokia(QNetworkReply *reply, int limit, int offs
     connect(reply, &QNetworkReply::errorOccurred,
             this, &QGeoCodeReplyNokia::networkError);
     connect(this, &QGeoCodeReply::aborted, reply, &QNetworkReply::abort);
-    connect(this, &QGeoCodeReply::aborted, [this](){ m_parsing = false; });
+    connect(this, &QGeoCodeReply::aborted, [this](){ m_parsing = false; *m_cancelled = true; });
     connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
 
 
@@ -44,6 +45,7 @@ QGeoCodeReplyNokia::QGeoCodeReplyNokia(QNetworkReply *reply, int limit, int offs
 
 QGeoCodeReplyNokia::~QGeoCodeReplyNokia()
 {
+    *m_cancelled = true;
 }
 
 void QGeoCodeReplyNokia::networkFinished()
@@ -57,6 +59,7 @@ void QGeoCodeReplyNokia::networkFinished()
     QGeoCodeJsonParser *parser = new QGeoCodeJsonParser; // QRunnable, autoDelete = true.
     if (m_manualBoundsRequired)
         parser->setBounds(viewport());
+    parser->setCancellationFlag(m_cancelled);
     connect(parser, &QGeoCodeJsonParser::results, this, &QGeoCodeReplyNokia::appendResults);
     connect(parser, &QGeoCodeJsonParser::errorOccurred, this, &QGeoCodeReplyNokia::parseError);
 
@@ -7,6 +7,9 @@
 #include <qgeocodereply.h>
 #include <QNetworkReply>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QGeoCodeReplyNokia : public QGeoCodeReply
@@ -26,6 +29,7 @@ private Q_SLOTS:
 private:
     bool m_parsing;
     bool m_manualBoundsRequired;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
 };
 
 QT_END_NAMESPACE
@@ -16,7 +16,8 @@ QT_BEGIN_NAMESPACE
 QGeoRouteReplyNokia::QGeoRouteReplyNokia(const QGeoRouteRequest &request,
                                          const QList<QNetworkReply *> &replies,
                                          QObject *parent)
-:   QGeoRouteReply(request, parent), m_parsers(0)
+:   QGeoRouteReply(request, parent), m_parsers(0),
+    m_cancelled(std::make_shared<std::atomic_bool>(false))
 {
     qRegisterMetaType<QList<QGeoRoute> >();
 
@@ -36,11 +37,12 @@ QGeoRouteReplyNokia::QGeoRouteReplyNokia(const QGeoRouteRequest &request,
     if (failure)
         setError(UnknownError, QStringLiteral("Null reply"));
     else
-        connect(this, &QGeoRouteReply::aborted, [this](){ m_parsers = 0; });
+        connect(this, &QGeoRouteReply::aborted, [this](){ m_parsers = 0; *m_cancelled = true; });
 }
 
 QGeoRouteReplyNokia::~QGeoRouteReplyNokia()
 {
+    *m_cancelled = true;
 }
 
 void QGeoRouteReplyNokia::networkFinished()
@@ -54,6 +56,7 @@ void QGeoRouteReplyNokia::networkFinished()
     }
 
     QGeoRouteXmlParser *parser = new QGeoRouteXmlParser(request());
+    parser->setCancellationFlag(m_cancelled);
     connect(parser, &QGeoRouteXmlParser::results,
             this, &QGeoRouteReplyNokia::appendResults);
     connect(parser, &QGeoRouteXmlParser::errorOccurred,
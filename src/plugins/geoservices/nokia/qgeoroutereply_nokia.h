@@ -7,6 +7,9 @@
 #include <qgeoroutereply.h>
 #include <QNetworkReply>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QGeoRouteXmlParser;
@@ -27,6 +30,7 @@ private Q_SLOTS:
 
 private:
     int m_parsers;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
 };
 
 QT_END_NAMESPACE
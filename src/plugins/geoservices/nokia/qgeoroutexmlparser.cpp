@@ -32,6 +32,13 @@ QGeoRouteXmlParser::~QGeoRouteXmlParser()
 {
 }
 
+// Set by the reply when it is aborted or destroyed, the parsing then stops
+// without reporting results or errors
+void QGeoRouteXmlParser::setCancellationFlag(const std::shared_ptr<std::atomic_bool> &cancelled)
+{
+    m_cancelled = cancelled;
+}
+
 void QGeoRouteXmlParser::parse(const QByteArray &data)
 {
     m_data = data;
@@ -46,15 +53,27 @@ void QGeoRouteXmlParser::run()
 {
     m_reader = new QXmlStreamReader(m_data);
 
-    if (!parseRootElement())
-        emit errorOccurred(m_reader->errorString());
-    else
-        emit results(m_results);
+    const bool parsed = parseRootElement();
+    if (!m_cancelled || !*m_cancelled) {
+        if (!parsed)
+            emit errorOccurred(m_reader->errorString());
+        else
+            emit results(m_results);
+    }
 
     delete m_reader;
     m_reader = 0;
 }
 
+bool QGeoRouteXmlParser::isCancelled()
+{
+    if (!m_cancelled || !*m_cancelled)
+        return false;
+    if (!m_reader->hasError())
+        m_reader->raiseError(QStringLiteral("The parsing was cancelled."));
+    return true;
+}
+
 bool QGeoRouteXmlParser::parseRootElement()
 {
     if (!m_reader->readNextStartElement()) {
@@ -89,7 +108,7 @@ bool QGeoRouteXmlParser::parseRootElement()
         }
     }
 
-    while (m_reader->readNextStartElement() && !m_reader->hasError()) {
+    while (!isCancelled() && m_reader->readNextStartElement() && !m_reader->hasError()) {
         if (m_reader->name() == QLatin1String("Route")) {
             QGeoRoute route;
             route.setRequest(m_request);
@@ -169,7 +188,7 @@ bool QGeoRouteXmlParser::parseLeg(int legIndex)
     QList<QGeoRouteSegmentContainer> links;
     while (!(m_reader->tokenType() == QXmlStreamReader::EndElement
              && m_reader->name() == QStringLiteral("Leg")) &&
-           !m_reader->hasError()) {
+           !m_reader->hasError() && !isCancelled()) {
         if (m_reader->tokenType() == QXmlStreamReader::StartElement) {
             if (m_reader->name() == QStringLiteral("Maneuver")) {
                 if (!parseManeuver(maneuvers))
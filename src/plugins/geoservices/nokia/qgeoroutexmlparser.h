@@ -14,6 +14,9 @@
 #include <QtLocation/QGeoManeuver>
 #include <QtLocation/qgeoroute.h>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QXmlStreamReader;
@@ -67,6 +70,7 @@ public:
     QGeoRouteXmlParser(const QGeoRouteRequest &request);
     ~QGeoRouteXmlParser();
 
+    void setCancellationFlag(const std::shared_ptr<std::atomic_bool> &cancelled);
     void parse(const QByteArray &data);
     void run() override;
 
@@ -75,6 +79,7 @@ signals:
     void errorOccurred(const QString &errorString);
 
 private:
+    bool isCancelled();
     bool parseRootElement();
     bool parseRoute(QGeoRoute *route);
     //bool parseWaypoint(QGeoRoute *route);
@@ -93,6 +98,7 @@ private:
     QGeoRouteRequest m_request;
     QByteArray m_data;
     QXmlStreamReader *m_reader;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
 
     QList<QGeoRoute> m_results;
     QList<QGeoRoute> m_legs;
@@ -11,6 +11,7 @@
 #include <QUrl>
 #include <QLocale>
 #include <QtPositioning/QGeoRectangle>
+#include <QtLocation/private/qgeorouterequest_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -84,8 +85,12 @@ QGeoRouteReply *QGeoRoutingManagerEngineNokia::calculateRoute(const QGeoRouteReq
     }
 
     QList<QNetworkReply*> replies;
-    for (const QString &reqString : reqStrings)
-        replies.append(m_networkManager->get(QNetworkRequest(QUrl(reqString))));
+    for (const QString &reqString : reqStrings) {
+        QNetworkRequest networkRequest{QUrl(reqString)};
+        networkRequest.setPriority(
+                QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
+        replies.append(m_networkManager->get(networkRequest));
+    }
 
     QGeoRouteReplyNokia *reply = new QGeoRouteReplyNokia(request, replies, this);
 
@@ -0,0 +1,1041 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeocodeindexoffline.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QMap>
+#include <QtCore/QSaveFile>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QtMath>
+
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+#include <QtPositioning/QGeoRectangle>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+using QOfflineIndex::align;
+using QOfflineIndex::append;
+using QOfflineIndex::fits;
+using QOfflineIndex::get;
+using QOfflineIndex::LocalProjection;
+using QOfflineIndex::MetersPerDegree;
+using QOfflineIndex::segmentDistance;
+using QOfflineIndex::put;
+
+namespace
+{
+const char IndexMagic[8] = { 'Q', 'G', 'C', 'I', 'D', 'X', '0', '1' };
+const quint32 IndexVersion = 1;
+
+// 2^16 columns and rows, cells are about 300 m high and at most 600 m wide
+const int GridBits = 16;
+const int GridSize = 1 << GridBits;
+
+const int HeaderSize = 128;
+const int RecordSize = 56;
+const int VertexSize = 8;
+const int CellRecordSize = 12;
+const int EntrySize = 8;
+const int NodeSize = 16;
+const int EdgeSize = 8;
+
+const quint32 NoSegment = 0xffffffff;
+
+// reverse geocoding prefers an address point over a closer street by up to this distance,
+// since house addresses are usually set back from the center line of their street
+const double PointPreference = 30.0;
+
+/*
+    The header is a fixed 128 byte block, all values little endian:
+
+    0   magic           8 bytes
+    8   version         u32
+    12  recordCount     u32
+    16  cellCount       u32
+    20  nodeCount       u32
+    24  edgeCount       u32
+    28  reserved        u32
+    32  recordOffset    u64     recordCount x { i32 lat*1e7, i32 lon*1e7, u32 first vertex,
+                                                u32 vertex count, 9 x u32 address fields,
+                                                u32 reserved }
+    40  vertexOffset    u64     { i32 lat*1e7, i32 lon*1e7 }
+    48  vertexCount     u64
+    56  cellOffset      u64     cellCount x { u32 morton key, u32 first entry, u32 count }
+    64  entryOffset     u64     { u32 record, u32 segment or 0xffffffff for address points }
+    72  entryCount      u64
+    80  nodeOffset      u64     nodeCount x { u32 first edge, u32 edges, u32 first posting,
+                                              u32 postings }, node 0 is the root
+    88  edgeOffset      u64     edgeCount x { u32 byte, u32 node }, sorted by byte per node
+    96  postingOffset   u64     u32 record numbers
+    104 postingCount    u64
+    112 stringOffset    u64     null terminated UTF-8 strings, offset 0 is the empty string
+    120 stringSize      u64
+*/
+
+enum AddressField {
+    StreetNumberField,
+    StreetField,
+    PostalCodeField,
+    DistrictField,
+    CityField,
+    CountyField,
+    StateField,
+    CountryField,
+    CountryCodeField,
+    AddressFieldCount
+};
+
+QString addressField(const QGeoAddress &address, int field)
+{
+    switch (field) {
+    case StreetNumberField:
+        return address.streetNumber();
+    case StreetField:
+        return address.street();
+    case PostalCodeField:
+        return address.postalCode();
+    case DistrictField:
+        return address.district();
+    case CityField:
+        return address.city();
+    case CountyField:
+        return address.county();
+    case StateField:
+        return address.state();
+    case CountryField:
+        return address.country();
+    case CountryCodeField:
+        return address.countryCode();
+    }
+    return QString();
+}
+
+void setAddressField(QGeoAddress *address, int field, const QString &value)
+{
+    switch (field) {
+    case StreetNumberField:
+        address->setStreetNumber(value);
+        break;
+    case StreetField:
+        address->setStreet(value);
+        break;
+    case PostalCodeField:
+        address->setPostalCode(value);
+        break;
+    case DistrictField:
+        address->setDistrict(value);
+        break;
+    case CityField:
+        address->setCity(value);
+        break;
+    case CountyField:
+        address->setCounty(value);
+        break;
+    case StateField:
+        address->setState(value);
+        break;
+    case CountryField:
+        address->setCountry(value);
+        break;
+    case CountryCodeField:
+        address->setCountryCode(value);
+        break;
+    }
+}
+
+// property and column names read for each address field, OSM addr:* tags first
+const char *const FieldKeys[AddressFieldCount][4] = {
+    { "addr:housenumber", "housenumber", "street_number", "number" },
+    { "addr:street", "street", nullptr, nullptr },
+    { "addr:postcode", "postcode", "postal_code", "zip" },
+    { "addr:suburb", "addr:district", "district", "suburb" },
+    { "addr:city", "city", nullptr, nullptr },
+    { "addr:county", "county", nullptr, nullptr },
+    { "addr:state", "state", "region", nullptr },
+    { "country", nullptr, nullptr, nullptr },
+    { "addr:country", "country_code", nullptr, nullptr }
+};
+
+QGeoAddress addressFromProperties(const QVariantMap &properties)
+{
+    QGeoAddress address;
+    for (int field = 0; field < AddressFieldCount; ++field) {
+        for (const char *key : FieldKeys[field]) {
+            if (!key)
+                break;
+            const QString value = properties.value(QLatin1String(key)).toString().trimmed();
+            if (!value.isEmpty()) {
+                setAddressField(&address, field, value);
+                break;
+            }
+        }
+    }
+    return address;
+}
+
+bool hasAddressFields(const QGeoAddress &address)
+{
+    for (int field = 0; field < AddressFieldCount; ++field) {
+        if (!addressField(address, field).isEmpty())
+            return true;
+    }
+    return false;
+}
+
+struct Abbreviation
+{
+    const char *abbreviation;
+    const char *expansion;
+};
+
+const Abbreviation Abbreviations[] = {
+    { "av", "avenue" },
+    { "ave", "avenue" },
+    { "blvd", "boulevard" },
+    { "cres", "crescent" },
+    { "ct", "court" },
+    { "dr", "drive" },
+    { "hwy", "highway" },
+    { "ln", "lane" },
+    { "pde", "parade" },
+    { "pl", "place" },
+    { "rd", "road" },
+    { "sq", "square" },
+    { "st", "street" },
+    { "str", "strasse" },
+    { "tce", "terrace" }
+};
+
+QString expand(const QString &token)
+{
+    for (const Abbreviation &abbreviation : Abbreviations) {
+        if (token == QLatin1String(abbreviation.abbreviation))
+            return QString::fromLatin1(abbreviation.expansion);
+    }
+    // German compound street names, "hauptstr" for "hauptstrasse"
+    if (token.size() > 4 && token.endsWith(QLatin1String("str")))
+        return token + QLatin1String("asse");
+    return token;
+}
+
+int gridX(double longitude)
+{
+    return qBound(0, int(std::floor((longitude + 180.0) / 360.0 * GridSize)), GridSize - 1);
+}
+
+int gridY(double latitude)
+{
+    return qBound(0, int(std::floor((latitude + 90.0) / 180.0 * GridSize)), GridSize - 1);
+}
+
+quint32 cellKey(int x, int y)
+{
+    return QOfflineIndex::morton(quint32(x), quint32(y), GridBits);
+}
+
+qint32 fixed(double degrees)
+{
+    return qint32(qRound(degrees * 1e7));
+}
+
+QGeoCoordinate featureCoordinate(const QString &type, const QVariant &data)
+{
+    if (type == QLatin1String("Point"))
+        return data.value<QGeoCircle>().center();
+    if (type == QLatin1String("Polygon"))
+        return data.value<QGeoPolygon>().center();
+    return QGeoCoordinate();
+}
+
+// Splits one CSV record, reading further lines while a quoted field is open.
+QStringList readCsvRecord(QIODevice *device, QChar separator)
+{
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    bool any = false;
+    while (!device->atEnd()) {
+        const QString line = QString::fromUtf8(device->readLine()).remove(QLatin1Char('\r'));
+        any = true;
+        for (qsizetype i = 0; i < line.size(); ++i) {
+            const QChar c = line.at(i);
+            if (quoted) {
+                if (c == QLatin1Char('"')) {
+                    if (i + 1 < line.size() && line.at(i + 1) == QLatin1Char('"'))
+                        field.append(line.at(++i));
+                    else
+                        quoted = false;
+                } else {
+                    field.append(c);
+                }
+            } else if (c == QLatin1Char('"')) {
+                quoted = true;
+            } else if (c == separator) {
+                fields.append(field);
+                field.clear();
+            } else if (c != QLatin1Char('\n')) {
+                field.append(c);
+            }
+        }
+        if (!quoted)
+            break;
+    }
+    if (any)
+        fields.append(field);
+    return fields;
+}
+} // namespace
+
+void QGeoCodeIndexOfflineBuilder::addAddress(const QGeoCodeOfflineAddress &address)
+{
+    if (address.coordinate.isValid() || !address.path.isEmpty())
+        m_addresses.append(address);
+}
+
+/*
+    Imports the addresses of \a importedGeoJson, as returned by QGeoJson::importGeoJson().
+    Points and polygons, for example buildings, become address points when they carry
+    address properties, either OSM addr:* tags or plain keys such as "street" and
+    "housenumber". Line strings with a "name" and a "highway" property become streets.
+
+    Returns the number of imported addresses.
+*/
+int QGeoCodeIndexOfflineBuilder::addGeoJson(const QVariantList &importedGeoJson)
+{
+    const qsizetype before = m_addresses.size();
+    for (const QVariant &item : importedGeoJson) {
+        const QVariantMap map = item.toMap();
+        const QString type = map.value(QStringLiteral("type")).toString();
+        if (type == QLatin1String("FeatureCollection")
+                || type == QLatin1String("GeometryCollection")) {
+            addGeoJson(map.value(QStringLiteral("data")).toList());
+        } else {
+            addFeature(map);
+        }
+    }
+    return int(m_addresses.size() - before);
+}
+
+void QGeoCodeIndexOfflineBuilder::addFeature(const QVariantMap &feature)
+{
+    const QString type = feature.value(QStringLiteral("type")).toString();
+    const QVariant data = feature.value(QStringLiteral("data"));
+    const QVariantMap properties = feature.value(QStringLiteral("properties")).toMap();
+
+    QGeoCodeOfflineAddress address;
+    address.address = addressFromProperties(properties);
+
+    if (type == QLatin1String("LineString")) {
+        const QString name = properties.value(QStringLiteral("name")).toString();
+        if (name.isEmpty() || !properties.contains(QStringLiteral("highway")))
+            return;
+        if (address.address.street().isEmpty())
+            address.address.setStreet(name);
+        address.path = data.value<QGeoPath>().path();
+        if (address.path.size() < 2)
+            return;
+        address.coordinate = address.path.at(address.path.size() / 2);
+    } else {
+        address.coordinate = featureCoordinate(type, data);
+        if (!address.coordinate.isValid() || !hasAddressFields(address.address))
+            return;
+    }
+
+    addAddress(address);
+}
+
+/*
+    Imports address points from the CSV data read from \a device. The first line names the
+    columns, "lat" or "latitude" and "lon", "lng" or "longitude" are required, the address
+    columns use the same names as the GeoJSON properties. Fields are separated by commas,
+    or by semicolons if the header holds no comma.
+
+    Returns the number of imported addresses, or -1 if the header is unusable.
+*/
+int QGeoCodeIndexOfflineBuilder::addCsv(QIODevice *device, QString *errorString)
+{
+    const QString header = QString::fromUtf8(device->peek(4096)).section(QLatin1Char('\n'), 0, 0);
+    const QChar separator = header.contains(QLatin1Char(',')) || !header.contains(QLatin1Char(';'))
+            ? QLatin1Char(',') : QLatin1Char(';');
+
+    QStringList columns = readCsvRecord(device, separator);
+    for (QString &column : columns)
+        column = column.trimmed().toLower();
+
+    const auto column = [&columns](std::initializer_list<const char *> names) -> qsizetype {
+        for (const char *name : names) {
+            const qsizetype index = columns.indexOf(QLatin1String(name));
+            if (index >= 0)
+                return index;
+        }
+        return -1;
+    };
+    const qsizetype latitudeColumn = column({ "lat", "latitude" });
+    const qsizetype longitudeColumn = column({ "lon", "lng", "longitude" });
+    if (latitudeColumn < 0 || longitudeColumn < 0) {
+        if (errorString)
+            *errorString = QStringLiteral("The CSV header has no latitude or longitude column");
+        return -1;
+    }
+
+    const qsizetype before = m_addresses.size();
+    while (!device->atEnd()) {
+        const QStringList fields = readCsvRecord(device, separator);
+        if (fields.size() != columns.size())
+            continue;
+
+        bool latitudeOk = false;
+        bool longitudeOk = false;
+        QGeoCodeOfflineAddress address;
+        address.coordinate = QGeoCoordinate(fields.at(latitudeColumn).toDouble(&latitudeOk),
+                                            fields.at(longitudeColumn).toDouble(&longitudeOk));
+        if (!latitudeOk || !longitudeOk || !address.coordinate.isValid())
+            continue;
+
+        QVariantMap properties;
+        for (qsizetype i = 0; i < columns.size(); ++i)
+            properties.insert(columns.at(i), fields.at(i));
+        address.address = addressFromProperties(properties);
+        if (hasAddressFields(address.address))
+            addAddress(address);
+    }
+    return int(m_addresses.size() - before);
+}
+
+qsizetype QGeoCodeIndexOfflineBuilder::size() const
+{
+    return m_addresses.size();
+}
+
+QByteArray QGeoCodeIndexOfflineBuilder::build() const
+{
+    const quint32 recordCount = quint32(m_addresses.size());
+
+    QByteArray strings(1, '\0');
+    QHash<QByteArray, quint32> sharedStrings;
+    const auto addString = [&](const QString &text) -> quint32 {
+        const QByteArray utf8 = text.toUtf8();
+        if (utf8.isEmpty())
+            return 0;
+        const auto it = sharedStrings.constFind(utf8);
+        if (it != sharedStrings.constEnd())
+            return it.value();
+        const quint32 offset = quint32(strings.size());
+        strings.append(utf8);
+        strings.append('\0');
+        sharedStrings.insert(utf8, offset);
+        return offset;
+    };
+
+    QByteArray records;
+    records.reserve(qsizetype(recordCount) * RecordSize);
+    QByteArray vertices;
+    quint64 vertexCount = 0;
+    QMap<QByteArray, QList<quint32>> tokens;
+    QList<std::pair<quint32, std::pair<quint32, quint32>>> entries;
+
+    for (quint32 record = 0; record < recordCount; ++record) {
+        const QGeoCodeOfflineAddress &address = m_addresses.at(record);
+
+        append<qint32>(records, fixed(address.coordinate.latitude()));
+        append<qint32>(records, fixed(address.coordinate.longitude()));
+        append<quint32>(records, address.path.isEmpty() ? 0 : quint32(vertexCount));
+        append<quint32>(records, quint32(address.path.size()));
+        for (int field = 0; field < AddressFieldCount; ++field)
+            append<quint32>(records, addString(addressField(address.address, field)));
+        append<quint32>(records, 0);
+
+        for (int field = 0; field < AddressFieldCount; ++field) {
+            const QStringList words = QGeoCodeIndexOffline::normalize(
+                        addressField(address.address, field));
+            for (const QString &word : words) {
+                QList<quint32> &postings = tokens[word.toUtf8()];
+                if (postings.isEmpty() || postings.last() != record)
+                    postings.append(record);
+            }
+        }
+
+        if (address.path.isEmpty()) {
+            const quint32 cell = cellKey(gridX(address.coordinate.longitude()),
+                                         gridY(address.coordinate.latitude()));
+            entries.append(std::make_pair(cell, std::make_pair(record, NoSegment)));
+            continue;
+        }
+
+        for (const QGeoCoordinate &vertex : address.path) {
+            append<qint32>(vertices, fixed(vertex.latitude()));
+            append<qint32>(vertices, fixed(vertex.longitude()));
+        }
+
+        // register every segment in the cells it crosses, sampled at half a cell
+        for (qsizetype i = 0; i + 1 < address.path.size(); ++i) {
+            const QGeoCoordinate &a = address.path.at(i);
+            const QGeoCoordinate &b = address.path.at(i + 1);
+            const double ax = (a.longitude() + 180.0) / 360.0 * GridSize;
+            const double ay = (a.latitude() + 90.0) / 180.0 * GridSize;
+            double bx = (b.longitude() + 180.0) / 360.0 * GridSize;
+            const double by = (b.latitude() + 90.0) / 180.0 * GridSize;
+            if (std::abs(bx - ax) > GridSize / 2)
+                bx = ax; // crosses the antimeridian, only register the start cell
+            const int steps = int(std::ceil(qMax(std::abs(bx - ax), std::abs(by - ay)) * 2)) + 1;
+            for (int step = 0; step <= steps; ++step) {
+                const double t = double(step) / steps;
+                const int x = qBound(0, int(std::floor(ax + (bx - ax) * t)), GridSize - 1);
+                const int y = qBound(0, int(std::floor(ay + (by - ay) * t)), GridSize - 1);
+                entries.append(std::make_pair(cellKey(x, y),
+                                              std::make_pair(record, quint32(vertexCount + i))));
+            }
+        }
+        vertexCount += quint64(address.path.size());
+    }
+
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    QByteArray cells;
+    QByteArray entryTable;
+    quint32 cellCount = 0;
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        if (i == 0 || entries.at(i).first != entries.at(i - 1).first) {
+            append<quint32>(cells, entries.at(i).first);
+            append<quint32>(cells, quint32(i));
+            append<quint32>(cells, 0);
+            ++cellCount;
+        }
+        const qsizetype countOffset = cells.size() - 4;
+        put<quint32>(cells, countOffset,
+                     get<quint32>(reinterpret_cast<const uchar *>(cells.constData()) + countOffset)
+                     + 1);
+        append<quint32>(entryTable, entries.at(i).second.first);
+        append<quint32>(entryTable, entries.at(i).second.second);
+    }
+
+    // Build the token trie. Tokens arrive in byte order, so a new edge is always the last
+    // one of its node, and every node keeps its edges sorted.
+    struct TrieNode
+    {
+        QList<std::pair<uchar, quint32>> edges;
+        const QList<quint32> *postings = nullptr;
+    };
+    std::vector<TrieNode> trie(1);
+    for (auto it = tokens.cbegin(), end = tokens.cend(); it != end; ++it) {
+        quint32 node = 0;
+        for (const char c : it.key()) {
+            const uchar label = uchar(c);
+            const QList<std::pair<uchar, quint32>> &edges = trie[node].edges;
+            if (!edges.isEmpty() && edges.last().first == label) {
+                node = edges.last().second;
+            } else {
+                const quint32 child = quint32(trie.size());
+                trie[node].edges.append(std::make_pair(label, child));
+                trie.emplace_back();
+                node = child;
+            }
+        }
+        trie[node].postings = &it.value();
+    }
+
+    QByteArray nodes;
+    QByteArray edges;
+    QByteArray postings;
+    quint32 edgeCount = 0;
+    quint64 postingCount = 0;
+    for (const TrieNode &node : trie) {
+        append<quint32>(nodes, edgeCount);
+        append<quint32>(nodes, quint32(node.edges.size()));
+        append<quint32>(nodes, quint32(postingCount));
+        append<quint32>(nodes, node.postings ? quint32(node.postings->size()) : 0);
+        for (const auto &edge : node.edges) {
+            append<quint32>(edges, edge.first);
+            append<quint32>(edges, edge.second);
+        }
+        edgeCount += quint32(node.edges.size());
+        if (node.postings) {
+            for (quint32 record : *node.postings)
+                append<quint32>(postings, record);
+            postingCount += quint64(node.postings->size());
+        }
+    }
+
+    QByteArray index(HeaderSize, '\0');
+    memcpy(index.data(), IndexMagic, sizeof(IndexMagic));
+    put<quint32>(index, 8, IndexVersion);
+    put<quint32>(index, 12, recordCount);
+    put<quint32>(index, 16, cellCount);
+    put<quint32>(index, 20, quint32(trie.size()));
+    put<quint32>(index, 24, edgeCount);
+
+    const auto section = [&index](int offsetField, const QByteArray &data) {
+        put<quint64>(index, offsetField, quint64(index.size()));
+        index.append(data);
+        align(index);
+    };
+    section(32, records);
+    section(40, vertices);
+    put<quint64>(index, 48, vertexCount);
+    section(56, cells);
+    section(64, entryTable);
+    put<quint64>(index, 72, quint64(entries.size()));
+    section(80, nodes);
+    section(88, edges);
+    section(96, postings);
+    put<quint64>(index, 104, postingCount);
+    put<quint64>(index, 112, quint64(index.size()));
+    put<quint64>(index, 120, quint64(strings.size()));
+    index.append(strings);
+
+    return index;
+}
+
+bool QGeoCodeIndexOfflineBuilder::write(const QString &fileName, QString *errorString) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    file.write(build());
+    if (!file.commit()) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QGeoCodeIndexOffline::QGeoCodeIndexOffline()
+{
+}
+
+QGeoCodeIndexOffline::~QGeoCodeIndexOffline()
+{
+    close();
+}
+
+/*
+    Memory maps the index file \a fileName. The file stays mapped, and therefore open,
+    for the lifetime of the index.
+*/
+bool QGeoCodeIndexOffline::open(const QString &fileName, QString *errorString)
+{
+    close();
+    if (!m_file.open(fileName, errorString))
+        return false;
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/*
+    Uses the in-memory index \a data, as produced by QGeoCodeIndexOfflineBuilder::build().
+*/
+bool QGeoCodeIndexOffline::setData(const QByteArray &data, QString *errorString)
+{
+    close();
+    m_file.setData(data);
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool QGeoCodeIndexOffline::isValid() const
+{
+    return m_data != nullptr;
+}
+
+bool QGeoCodeIndexOffline::load(const uchar *data, qint64 size, QString *errorString)
+{
+    const auto fail = [errorString](const char *message) {
+        if (errorString)
+            *errorString = QString::fromLatin1(message);
+        return false;
+    };
+
+    if (size < HeaderSize || memcmp(data, IndexMagic, sizeof(IndexMagic)) != 0)
+        return fail("Not an address index file");
+    if (get<quint32>(data + 8) != IndexVersion)
+        return fail("Unsupported address index version");
+
+    m_recordCount = get<quint32>(data + 12);
+    m_cellCount = get<quint32>(data + 16);
+    m_nodeCount = get<quint32>(data + 20);
+    m_edgeCount = get<quint32>(data + 24);
+    const quint64 recordOffset = get<quint64>(data + 32);
+    const quint64 vertexOffset = get<quint64>(data + 40);
+    m_vertexCount = get<quint64>(data + 48);
+    const quint64 cellOffset = get<quint64>(data + 56);
+    const quint64 entryOffset = get<quint64>(data + 64);
+    m_entryCount = get<quint64>(data + 72);
+    const quint64 nodeOffset = get<quint64>(data + 80);
+    const quint64 edgeOffset = get<quint64>(data + 88);
+    const quint64 postingOffset = get<quint64>(data + 96);
+    m_postingCount = get<quint64>(data + 104);
+    const quint64 stringOffset = get<quint64>(data + 112);
+    m_stringSize = get<quint64>(data + 120);
+
+    const quint64 fileSize = quint64(size);
+    if (!fits(fileSize, recordOffset, m_recordCount, RecordSize)
+            || !fits(fileSize, vertexOffset, m_vertexCount, VertexSize)
+            || !fits(fileSize, cellOffset, m_cellCount, CellRecordSize)
+            || !fits(fileSize, entryOffset, m_entryCount, EntrySize)
+            || !fits(fileSize, nodeOffset, m_nodeCount, NodeSize)
+            || !fits(fileSize, edgeOffset, m_edgeCount, EdgeSize)
+            || !fits(fileSize, postingOffset, m_postingCount, 4)
+            || !fits(fileSize, stringOffset, m_stringSize, 1)
+            || m_nodeCount == 0
+            || m_stringSize == 0 || data[stringOffset + m_stringSize - 1] != '\0') {
+        return fail("Truncated address index file");
+    }
+
+    m_data = data;
+    m_records = data + recordOffset;
+    m_vertices = data + vertexOffset;
+    m_cells = data + cellOffset;
+    m_entries = data + entryOffset;
+    m_nodes = data + nodeOffset;
+    m_edges = data + edgeOffset;
+    m_postings = data + postingOffset;
+    m_strings = data + stringOffset;
+    return true;
+}
+
+void QGeoCodeIndexOffline::close()
+{
+    m_file.close();
+    m_data = nullptr;
+    m_recordCount = 0;
+    m_cellCount = 0;
+    m_nodeCount = 0;
+    m_edgeCount = 0;
+    m_vertexCount = 0;
+    m_entryCount = 0;
+    m_postingCount = 0;
+    m_stringSize = 0;
+}
+
+quint32 QGeoCodeIndexOffline::count() const
+{
+    return m_recordCount;
+}
+
+QGeoAddress QGeoCodeIndexOffline::address(quint32 index) const
+{
+    QGeoAddress address;
+    if (index >= m_recordCount)
+        return address;
+
+    const uchar *record = m_records + qsizetype(index) * RecordSize;
+    for (int field = 0; field < AddressFieldCount; ++field)
+        setAddressField(&address, field, text(record, field));
+    return address;
+}
+
+QGeoCoordinate QGeoCodeIndexOffline::coordinate(quint32 index) const
+{
+    if (index >= m_recordCount)
+        return QGeoCoordinate();
+    const uchar *record = m_records + qsizetype(index) * RecordSize;
+    return QGeoCoordinate(get<qint32>(record) / 1e7, get<qint32>(record + 4) / 1e7);
+}
+
+QList<QGeoCoordinate> QGeoCodeIndexOffline::path(quint32 index) const
+{
+    QList<QGeoCoordinate> path;
+    if (index >= m_recordCount)
+        return path;
+
+    const uchar *record = m_records + qsizetype(index) * RecordSize;
+    const quint64 first = get<quint32>(record + 8);
+    const quint32 count = get<quint32>(record + 12);
+    if (first + count > m_vertexCount)
+        return path;
+
+    path.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        const uchar *vertex = m_vertices + qsizetype(first + i) * VertexSize;
+        path.append(QGeoCoordinate(get<qint32>(vertex) / 1e7, get<qint32>(vertex + 4) / 1e7));
+    }
+    return path;
+}
+
+QGeoLocation QGeoCodeIndexOffline::location(quint32 index) const
+{
+    QGeoLocation location;
+    location.setAddress(address(index));
+    location.setCoordinate(coordinate(index));
+    const QList<QGeoCoordinate> vertices = path(index);
+    if (!vertices.isEmpty())
+        location.setBoundingShape(QGeoPath(vertices).boundingGeoRectangle());
+    return location;
+}
+
+/*
+    Returns the sorted record numbers containing \a token, which must already be
+    normalized.
+*/
+QList<quint32> QGeoCodeIndexOffline::matchingToken(const QString &token) const
+{
+    const qint64 node = findNode(token.toUtf8());
+    if (node < 0)
+        return QList<quint32>();
+    return postings(quint32(node));
+}
+
+/*
+    Returns the sorted record numbers containing a token that starts with \a prefix,
+    which must already be normalized. Stops once at least \a limit records were collected,
+    a negative \a limit collects all of them.
+*/
+QList<quint32> QGeoCodeIndexOffline::matchingPrefix(const QString &prefix, qsizetype limit) const
+{
+    QList<quint32> result;
+    const qint64 node = findNode(prefix.toUtf8());
+    if (node >= 0)
+        collectPostings(quint32(node), limit, &result);
+    return result;
+}
+
+/*
+    Returns the record of the address closest to \a coordinate within \a maximumDistance
+    meters, or -1. Address points win over streets unless a street is more than
+    PointPreference meters closer. \a nearestCoordinate is set to the address point, or to
+    the closest point of the street.
+*/
+qint64 QGeoCodeIndexOffline::nearest(const QGeoCoordinate &coordinate, double maximumDistance,
+                                     QGeoCoordinate *nearestCoordinate) const
+{
+    if (!isValid() || !coordinate.isValid() || m_cellCount == 0)
+        return -1;
+
+    const LocalProjection projection(coordinate);
+    const double cellHeight = 180.0 / GridSize * MetersPerDegree;
+    const double cellWidth = 360.0 / GridSize * projection.xScale;
+    const double cellSize = qMax(qMin(cellHeight, cellWidth), 1.0);
+    const int maximumRing = qMin(int(std::ceil(maximumDistance / cellSize)) + 1, 64);
+
+    const int cx = gridX(coordinate.longitude());
+    const int cy = gridY(coordinate.latitude());
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    qint64 bestPoint = -1;
+    double bestPointDistance = infinity;
+    qint64 bestWay = -1;
+    double bestWayDistance = infinity;
+    double bestWayX = 0;
+    double bestWayY = 0;
+
+    for (int ring = 0; ring <= maximumRing; ++ring) {
+        // everything in this ring is at least this far away
+        const double ringDistance = (ring - 1) * cellSize;
+        if (ringDistance > maximumDistance
+                || ringDistance > qMin(bestPointDistance, bestWayDistance + PointPreference)) {
+            break;
+        }
+
+        for (int dy = -ring; dy <= ring; ++dy) {
+            const int y = cy + dy;
+            if (y < 0 || y >= GridSize)
+                continue;
+            const int step = (dy == -ring || dy == ring) ? 1 : 2 * ring;
+            for (int dx = -ring; dx <= ring; dx += qMax(step, 1)) {
+                const int x = (cx + dx + GridSize) % GridSize;
+                const quint32 key = cellKey(x, y);
+
+                quint32 low = 0;
+                quint32 high = m_cellCount;
+                while (low < high) {
+                    const quint32 mid = low + (high - low) / 2;
+                    if (get<quint32>(m_cells + qsizetype(mid) * CellRecordSize) < key)
+                        low = mid + 1;
+                    else
+                        high = mid;
+                }
+                if (low >= m_cellCount
+                        || get<quint32>(m_cells + qsizetype(low) * CellRecordSize) != key) {
+                    continue;
+                }
+
+                const uchar *cell = m_cells + qsizetype(low) * CellRecordSize;
+                const quint64 first = get<quint32>(cell + 4);
+                const quint64 count = get<quint32>(cell + 8);
+                for (quint64 i = first; i < first + count && i < m_entryCount; ++i) {
+                    const uchar *entry = m_entries + qsizetype(i) * EntrySize;
+                    const quint32 record = get<quint32>(entry);
+                    const quint32 segment = get<quint32>(entry + 4);
+                    if (record >= m_recordCount)
+                        continue;
+
+                    if (segment == NoSegment) {
+                        const uchar *data = m_records + qsizetype(record) * RecordSize;
+                        double px, py;
+                        projection.project(get<qint32>(data), get<qint32>(data + 4), &px, &py);
+                        const double distance = std::hypot(px, py);
+                        if (distance < bestPointDistance) {
+                            bestPointDistance = distance;
+                            bestPoint = record;
+                        }
+                    } else if (segment + 1ull < m_vertexCount) {
+                        const uchar *a = m_vertices + qsizetype(segment) * VertexSize;
+                        const uchar *b = a + VertexSize;
+                        double ax, ay, bx, by, px, py;
+                        projection.project(get<qint32>(a), get<qint32>(a + 4), &ax, &ay);
+                        projection.project(get<qint32>(b), get<qint32>(b + 4), &bx, &by);
+                        const double distance = segmentDistance(ax, ay, bx, by, &px, &py);
+                        if (distance < bestWayDistance) {
+                            bestWayDistance = distance;
+                            bestWay = record;
+                            bestWayX = px;
+                            bestWayY = py;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestPoint >= 0 && bestPointDistance <= maximumDistance
+            && bestPointDistance <= bestWayDistance + PointPreference) {
+        if (nearestCoordinate)
+            *nearestCoordinate = coordinate(quint32(bestPoint));
+        return bestPoint;
+    }
+    if (bestWay >= 0 && bestWayDistance <= maximumDistance) {
+        if (nearestCoordinate)
+            *nearestCoordinate = projection.unproject(bestWayX, bestWayY);
+        return bestWay;
+    }
+    return -1;
+}
+
+/*
+    Splits \a text into the tokens stored in the index: words are case folded, stripped of
+    diacritics, and common street type abbreviations are expanded unless
+    \a expandAbbreviations is false.
+*/
+QStringList QGeoCodeIndexOffline::normalize(const QString &text, bool expandAbbreviations)
+{
+    QStringList tokens;
+    const QString folded = text.normalized(QString::NormalizationForm_KD).toCaseFolded();
+    QString token;
+    for (qsizetype i = 0; i <= folded.size(); ++i) {
+        const QChar c = i < folded.size() ? folded.at(i) : QChar(QChar::Space);
+        if (c.isMark())
+            continue;
+        if (c.isLetterOrNumber()) {
+            token.append(c);
+        } else if (!token.isEmpty()) {
+            tokens.append(expandAbbreviations ? expand(token) : token);
+            token.clear();
+        }
+    }
+    return tokens;
+}
+
+qint64 QGeoCodeIndexOffline::findNode(const QByteArray &token) const
+{
+    if (!isValid())
+        return -1;
+
+    quint32 node = 0;
+    for (const char c : token) {
+        const uchar *record = m_nodes + qsizetype(node) * NodeSize;
+        quint32 low = get<quint32>(record);
+        quint32 high = low + get<quint32>(record + 4);
+        if (high > m_edgeCount)
+            return -1;
+        while (low < high) {
+            const quint32 mid = low + (high - low) / 2;
+            if (get<quint32>(m_edges + qsizetype(mid) * EdgeSize) < uchar(c))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        const quint32 last = get<quint32>(record) + get<quint32>(record + 4);
+        if (low >= last || get<quint32>(m_edges + qsizetype(low) * EdgeSize) != uchar(c))
+            return -1;
+        node = get<quint32>(m_edges + qsizetype(low) * EdgeSize + 4);
+        if (node >= m_nodeCount)
+            return -1;
+    }
+    return node;
+}
+
+QList<quint32> QGeoCodeIndexOffline::postings(quint32 node) const
+{
+    QList<quint32> result;
+    const uchar *record = m_nodes + qsizetype(node) * NodeSize;
+    const quint64 first = get<quint32>(record + 8);
+    const quint32 count = get<quint32>(record + 12);
+    if (first + count > m_postingCount)
+        return result;
+
+    result.resize(count);
+    const uchar *posting = m_postings + qsizetype(first) * 4;
+    for (quint32 i = 0; i < count; ++i)
+        result[i] = get<quint32>(posting + qsizetype(i) * 4);
+    return result;
+}
+
+void QGeoCodeIndexOffline::collectPostings(quint32 node, qsizetype limit,
+                                           QList<quint32> *result) const
+{
+    QVarLengthArray<quint32, 64> stack;
+    stack.append(node);
+    while (!stack.isEmpty()) {
+        const quint32 current = stack.takeLast();
+        const QList<quint32> matches = postings(current);
+        if (!matches.isEmpty()) {
+            QList<quint32> united;
+            united.reserve(result->size() + matches.size());
+            std::set_union(result->cbegin(), result->cend(), matches.cbegin(), matches.cend(),
+                           std::back_inserter(united));
+            *result = united;
+            if (limit >= 0 && result->size() >= limit)
+                return;
+        }
+
+        const uchar *record = m_nodes + qsizetype(current) * NodeSize;
+        const quint32 first = get<quint32>(record);
+        const quint32 count = get<quint32>(record + 4);
+        // push in reverse so that shorter completions in byte order are visited first
+        for (quint32 i = count; i > 0; --i) {
+            const quint32 edge = first + i - 1;
+            if (edge >= m_edgeCount)
+                continue;
+            const quint32 child = get<quint32>(m_edges + qsizetype(edge) * EdgeSize + 4);
+            if (child < m_nodeCount)
+                stack.append(child);
+        }
+    }
+}
+
+const char *QGeoCodeIndexOffline::string(quint32 offset) const
+{
+    if (offset >= m_stringSize)
+        return "";
+    return reinterpret_cast<const char *>(m_strings + offset);
+}
+
+QString QGeoCodeIndexOffline::text(const uchar *record, int field) const
+{
+    return QString::fromUtf8(string(get<quint32>(record + 16 + 4 * field)));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,114 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCODEINDEXOFFLINE_H
+#define QGEOCODEINDEXOFFLINE_H
+
+#include "qofflineindex.h"
+
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoLocation>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+/*
+    An address point, or a street when path holds the vertices of its way.
+*/
+struct QGeoCodeOfflineAddress
+{
+    QGeoAddress address;
+    QGeoCoordinate coordinate;
+    QList<QGeoCoordinate> path;
+};
+
+/*
+    Collects addresses and serializes them into the binary index format read by
+    QGeoCodeIndexOffline.
+
+    Forward lookups use a byte trie over the normalized address tokens, each terminal node
+    owning a sorted posting list of record numbers, so that both exact and prefix lookups
+    are a walk from the root. Reverse lookups use a fine grid of roughly 300 m cells, each
+    listing the address points inside it and the streets crossing it.
+*/
+class QGeoCodeIndexOfflineBuilder
+{
+public:
+    void addAddress(const QGeoCodeOfflineAddress &address);
+    int addGeoJson(const QVariantList &importedGeoJson);
+    int addCsv(QIODevice *device, QString *errorString = nullptr);
+
+    qsizetype size() const;
+    QByteArray build() const;
+    bool write(const QString &fileName, QString *errorString = nullptr) const;
+
+private:
+    void addFeature(const QVariantMap &feature);
+
+    QList<QGeoCodeOfflineAddress> m_addresses;
+};
+
+class QGeoCodeIndexOffline
+{
+public:
+    QGeoCodeIndexOffline();
+    ~QGeoCodeIndexOffline();
+
+    bool open(const QString &fileName, QString *errorString = nullptr);
+    bool setData(const QByteArray &data, QString *errorString = nullptr);
+    bool isValid() const;
+
+    quint32 count() const;
+    QGeoAddress address(quint32 index) const;
+    QGeoCoordinate coordinate(quint32 index) const;
+    QList<QGeoCoordinate> path(quint32 index) const;
+    QGeoLocation location(quint32 index) const;
+
+    QList<quint32> matchingToken(const QString &token) const;
+    QList<quint32> matchingPrefix(const QString &prefix, qsizetype limit) const;
+    qint64 nearest(const QGeoCoordinate &coordinate, double maximumDistance,
+                   QGeoCoordinate *nearestCoordinate = nullptr) const;
+
+    static QStringList normalize(const QString &text, bool expandAbbreviations = true);
+
+private:
+    Q_DISABLE_COPY(QGeoCodeIndexOffline)
+
+    bool load(const uchar *data, qint64 size, QString *errorString);
+    void close();
+
+    qint64 findNode(const QByteArray &token) const;
+    QList<quint32> postings(quint32 node) const;
+    void collectPostings(quint32 node, qsizetype limit, QList<quint32> *result) const;
+    const char *string(quint32 offset) const;
+    QString text(const uchar *record, int field) const;
+
+    QOfflineIndexData m_file;
+    const uchar *m_data = nullptr;
+
+    quint32 m_recordCount = 0;
+    quint32 m_cellCount = 0;
+    quint32 m_nodeCount = 0;
+    quint32 m_edgeCount = 0;
+    quint64 m_vertexCount = 0;
+    quint64 m_entryCount = 0;
+    quint64 m_postingCount = 0;
+    quint64 m_stringSize = 0;
+    const uchar *m_records = nullptr;
+    const uchar *m_vertices = nullptr;
+    const uchar *m_cells = nullptr;
+    const uchar *m_entries = nullptr;
+    const uchar *m_nodes = nullptr;
+    const uchar *m_edges = nullptr;
+    const uchar *m_postings = nullptr;
+    const uchar *m_strings = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODEINDEXOFFLINE_H
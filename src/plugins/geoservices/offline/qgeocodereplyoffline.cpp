@@ -0,0 +1,47 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeocodereplyoffline.h"
+
+QT_BEGIN_NAMESPACE
+
+QGeoCodeReplyOffline::QGeoCodeReplyOffline(QObject *parent)
+:   QGeoCodeReply(parent)
+{
+}
+
+QGeoCodeReplyOffline::~QGeoCodeReplyOffline()
+{
+}
+
+void QGeoCodeReplyOffline::setLocations(const QList<QGeoLocation> &locations)
+{
+    QGeoCodeReply::setLocations(locations);
+}
+
+void QGeoCodeReplyOffline::setLimit(qsizetype limit)
+{
+    QGeoCodeReply::setLimit(limit);
+}
+
+void QGeoCodeReplyOffline::setOffset(qsizetype offset)
+{
+    QGeoCodeReply::setOffset(offset);
+}
+
+/*
+    The reply is answered synchronously from the local index, but finished() is only
+    emitted from the event loop so that callers can connect to the reply first.
+*/
+void QGeoCodeReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QGeoCodeReplyOffline::emitFinished()
+{
+    // QGeoCodeReply::setFinished() emits finished() itself
+    setFinished(true);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,32 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCODEREPLYOFFLINE_H
+#define QGEOCODEREPLYOFFLINE_H
+
+#include <QtLocation/QGeoCodeReply>
+#include <QtPositioning/QGeoLocation>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodeReplyOffline : public QGeoCodeReply
+{
+    Q_OBJECT
+
+public:
+    explicit QGeoCodeReplyOffline(QObject *parent = nullptr);
+    ~QGeoCodeReplyOffline();
+
+    void setLocations(const QList<QGeoLocation> &locations);
+    void setLimit(qsizetype limit);
+    void setOffset(qsizetype offset);
+
+    void finishLater();
+
+private Q_SLOTS:
+    void emitFinished();
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODEREPLYOFFLINE_H
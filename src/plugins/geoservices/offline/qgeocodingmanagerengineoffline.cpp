@@ -0,0 +1,257 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeocodingmanagerengineoffline.h"
+#include "qgeocodereplyoffline.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSet>
+
+#include <QtLocation/private/qgeojson_p.h>
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+// candidate sets larger than this are returned in index order instead of being ranked
+const qsizetype MaxRankedCandidates = 1000;
+// prefix completion of the last token stops after this many records
+const qsizetype MaxCompletedRecords = 10000;
+
+QStringList addressTokens(const QGeoAddress &address)
+{
+    const QString fields[] = {
+        address.streetNumber(), address.street(), address.postalCode(), address.district(),
+        address.city(), address.county(), address.state(), address.country(),
+        address.countryCode()
+    };
+
+    QStringList tokens;
+    for (const QString &field : fields)
+        tokens += QGeoCodeIndexOffline::normalize(field);
+    if (tokens.isEmpty())
+        tokens = QGeoCodeIndexOffline::normalize(address.text());
+    return tokens;
+}
+
+QList<quint32> intersect(const QList<quint32> &a, const QList<quint32> &b)
+{
+    QList<quint32> result;
+    result.reserve(qMin(a.size(), b.size()));
+    std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+
+QList<quint32> unite(const QList<quint32> &a, const QList<quint32> &b)
+{
+    QList<quint32> result;
+    result.reserve(a.size() + b.size());
+    std::set_union(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+}
+
+QGeoCodingManagerEngineOffline::QGeoCodingManagerEngineOffline(const QVariantMap &parameters,
+                                                               QGeoServiceProvider::Error *error,
+                                                               QString *errorString)
+:   QGeoCodingManagerEngine(parameters)
+{
+    if (parameters.contains(QStringLiteral("offline.geocoding.reverse_distance"))
+            && parameters.value(QStringLiteral("offline.geocoding.reverse_distance")).canConvert<double>())
+        m_reverseDistance = parameters.value(QStringLiteral("offline.geocoding.reverse_distance")).toDouble();
+
+    const QString indexFile = parameters.value(QStringLiteral("offline.geocoding.index")).toString();
+    const QString geoJsonFile = parameters.value(QStringLiteral("offline.geocoding.geojson")).toString();
+
+    if (indexFile.isEmpty() && geoJsonFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = tr("Either offline.geocoding.index or offline.geocoding.geojson is required");
+        return;
+    }
+
+    if (!geoJsonFile.isEmpty()) {
+        QFile file(geoJsonFile);
+        if (!file.open(QIODevice::ReadOnly)) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = file.errorString();
+            return;
+        }
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (document.isNull()) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = parseError.errorString();
+            return;
+        }
+
+        QGeoCodeIndexOfflineBuilder builder;
+        builder.addGeoJson(QGeoJson::importGeoJson(document));
+
+        // the built index is stored in offline.geocoding.index when given, so later
+        // runs can map it directly
+        bool ok;
+        if (indexFile.isEmpty())
+            ok = m_index.setData(builder.build(), errorString);
+        else
+            ok = builder.write(indexFile, errorString) && m_index.open(indexFile, errorString);
+        if (!ok) {
+            *error = QGeoServiceProvider::LoaderError;
+            return;
+        }
+    } else if (!m_index.open(indexFile, errorString)) {
+        *error = QGeoServiceProvider::LoaderError;
+        return;
+    }
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QGeoCodingManagerEngineOffline::~QGeoCodingManagerEngineOffline()
+{
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::geocode(const QGeoAddress &address,
+                                                       const QGeoShape &bounds)
+{
+    return lookup(addressTokens(address), QString(), -1, 0, bounds);
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::geocode(const QString &address, int limit,
+                                                       int offset, const QGeoShape &bounds)
+{
+    // complete the last word unless the user already typed past it, using the word as
+    // typed since "str" may be the start of "street" rather than the abbreviation
+    QString completion;
+    if (!address.isEmpty() && address.back().isLetterOrNumber()) {
+        const QStringList typed = QGeoCodeIndexOffline::normalize(address, false);
+        if (!typed.isEmpty())
+            completion = typed.last();
+    }
+    return lookup(QGeoCodeIndexOffline::normalize(address), completion, limit, offset, bounds);
+}
+
+QGeoCodeReply *QGeoCodingManagerEngineOffline::reverseGeocode(const QGeoCoordinate &coordinate,
+                                                              const QGeoShape &bounds)
+{
+    QGeoCodeReplyOffline *reply = new QGeoCodeReplyOffline(this);
+    connect(reply, &QGeoCodeReplyOffline::finished,
+            this, &QGeoCodingManagerEngineOffline::replyFinished);
+    connect(reply, &QGeoCodeReplyOffline::errorOccurred,
+            this, &QGeoCodingManagerEngineOffline::replyError);
+
+    QGeoCoordinate nearestCoordinate;
+    const qint64 record = m_index.nearest(coordinate, m_reverseDistance, &nearestCoordinate);
+    if (record >= 0 && (!bounds.isValid() || bounds.contains(nearestCoordinate))) {
+        QGeoLocation location = m_index.location(quint32(record));
+        location.setCoordinate(nearestCoordinate);
+        reply->setLocations({ location });
+    }
+
+    reply->finishLater();
+    return reply;
+}
+
+void QGeoCodingManagerEngineOffline::replyFinished()
+{
+    QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QGeoCodingManagerEngineOffline::replyError(QGeoCodeReply::Error errorCode,
+                                                const QString &errorString)
+{
+    QGeoCodeReply *reply = qobject_cast<QGeoCodeReply *>(sender());
+    if (reply)
+        emit errorOccurred(reply, errorCode, errorString);
+}
+
+/*
+    Returns the addresses holding every token, ordered by the number of their tokens
+    missing from the query, so that "main street" lists the street before the houses
+    on it and "12 main street" lists that house first.
+*/
+QGeoCodeReply *QGeoCodingManagerEngineOffline::lookup(const QStringList &tokens,
+                                                      const QString &completion, int limit,
+                                                      int offset, const QGeoShape &bounds)
+{
+    QGeoCodeReplyOffline *reply = new QGeoCodeReplyOffline(this);
+    connect(reply, &QGeoCodeReplyOffline::finished,
+            this, &QGeoCodingManagerEngineOffline::replyFinished);
+    connect(reply, &QGeoCodeReplyOffline::errorOccurred,
+            this, &QGeoCodingManagerEngineOffline::replyError);
+    reply->setLimit(limit);
+    reply->setOffset(offset);
+
+    QList<quint32> matches = candidates(tokens, completion);
+    if (bounds.isValid()) {
+        matches.erase(std::remove_if(matches.begin(), matches.end(), [&](quint32 index) {
+                          return !bounds.contains(m_index.coordinate(index));
+                      }), matches.end());
+    }
+
+    if (matches.size() <= MaxRankedCandidates) {
+        const QSet<QString> queryTokens(tokens.cbegin(), tokens.cend());
+        QList<std::pair<int, quint32>> ranked;
+        ranked.reserve(matches.size());
+        for (quint32 index : std::as_const(matches)) {
+            const QGeoAddress address = m_index.address(index);
+            int extra = 0;
+            for (const QString &token : addressTokens(address))
+                extra += queryTokens.contains(token) ? 0 : 1;
+            ranked.append(std::make_pair(extra, index));
+        }
+        std::stable_sort(ranked.begin(), ranked.end());
+        for (qsizetype i = 0; i < ranked.size(); ++i)
+            matches[i] = ranked.at(i).second;
+    }
+
+    const qsizetype first = qBound(qsizetype(0), qsizetype(offset), matches.size());
+    const qsizetype last = limit < 0 ? matches.size() : qMin(first + limit, matches.size());
+    QList<QGeoLocation> locations;
+    locations.reserve(last - first);
+    for (qsizetype i = first; i < last; ++i)
+        locations.append(m_index.location(matches.at(i)));
+    reply->setLocations(locations);
+
+    reply->finishLater();
+    return reply;
+}
+
+/*
+    Returns the sorted records holding every token. If \a completion is set, the last token
+    also matches any word starting with it.
+*/
+QList<quint32> QGeoCodingManagerEngineOffline::candidates(const QStringList &tokens,
+                                                          const QString &completion) const
+{
+    if (tokens.isEmpty())
+        return QList<quint32>();
+
+    QList<QList<quint32>> postings;
+    postings.reserve(tokens.size());
+    for (qsizetype i = 0; i < tokens.size(); ++i) {
+        const bool last = i == tokens.size() - 1;
+        QList<quint32> matches = m_index.matchingToken(tokens.at(i));
+        if (last && !completion.isEmpty() && matches.size() < MaxCompletedRecords)
+            matches = unite(matches, m_index.matchingPrefix(completion, MaxCompletedRecords));
+        if (matches.isEmpty())
+            return matches;
+        postings.append(matches);
+    }
+
+    // intersect the rarest tokens first, keeping the intermediate results small
+    std::sort(postings.begin(), postings.end(),
+              [](const QList<quint32> &a, const QList<quint32> &b) { return a.size() < b.size(); });
+    QList<quint32> result = postings.first();
+    for (qsizetype i = 1; i < postings.size() && !result.isEmpty(); ++i)
+        result = intersect(result, postings.at(i));
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,45 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOCODINGMANAGERENGINEOFFLINE_H
+#define QGEOCODINGMANAGERENGINEOFFLINE_H
+
+#include "qgeocodeindexoffline.h"
+
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoCodingManagerEngine>
+#include <QtLocation/QGeoCodeReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoCodingManagerEngineOffline : public QGeoCodingManagerEngine
+{
+    Q_OBJECT
+
+public:
+    QGeoCodingManagerEngineOffline(const QVariantMap &parameters,
+                                   QGeoServiceProvider::Error *error, QString *errorString);
+    ~QGeoCodingManagerEngineOffline();
+
+    QGeoCodeReply *geocode(const QGeoAddress &address, const QGeoShape &bounds) override;
+    QGeoCodeReply *geocode(const QString &address, int limit, int offset,
+                           const QGeoShape &bounds) override;
+    QGeoCodeReply *reverseGeocode(const QGeoCoordinate &coordinate,
+                                  const QGeoShape &bounds) override;
+
+private Q_SLOTS:
+    void replyFinished();
+    void replyError(QGeoCodeReply::Error errorCode, const QString &errorString);
+
+private:
+    QGeoCodeReply *lookup(const QStringList &tokens, const QString &completion, int limit,
+                          int offset, const QGeoShape &bounds);
+    QList<quint32> candidates(const QStringList &tokens, const QString &completion) const;
+
+    QGeoCodeIndexOffline m_index;
+    double m_reverseDistance = 200.0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOCODINGMANAGERENGINEOFFLINE_H
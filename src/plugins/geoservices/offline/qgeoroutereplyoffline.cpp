@@ -0,0 +1,49 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutereplyoffline.h"
+
+QT_BEGIN_NAMESPACE
+
+QGeoRouteReplyOffline::QGeoRouteReplyOffline(const QGeoRouteRequest &request, QObject *parent)
+:   QGeoRouteReply(request, parent)
+{
+}
+
+QGeoRouteReplyOffline::~QGeoRouteReplyOffline()
+{
+}
+
+void QGeoRouteReplyOffline::setRoutes(const QList<QGeoRoute> &routes)
+{
+    QGeoRouteReply::setRoutes(routes);
+}
+
+/*
+    Routes are computed synchronously from the local graph, but finished() is only
+    emitted from the event loop so that callers can connect to the reply first.
+*/
+void QGeoRouteReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QGeoRouteReplyOffline::failLater(QGeoRouteReply::Error errorCode, const QString &errorString)
+{
+    m_errorCode = errorCode;
+    m_errorString = errorString;
+    QMetaObject::invokeMethod(this, "emitError", Qt::QueuedConnection);
+}
+
+void QGeoRouteReplyOffline::emitFinished()
+{
+    // QGeoRouteReply::setFinished() emits finished() itself
+    setFinished(true);
+}
+
+void QGeoRouteReplyOffline::emitError()
+{
+    setError(m_errorCode, m_errorString);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,35 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTEREPLYOFFLINE_H
+#define QGEOROUTEREPLYOFFLINE_H
+
+#include <QtLocation/QGeoRouteReply>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRouteReplyOffline : public QGeoRouteReply
+{
+    Q_OBJECT
+
+public:
+    explicit QGeoRouteReplyOffline(const QGeoRouteRequest &request, QObject *parent = nullptr);
+    ~QGeoRouteReplyOffline();
+
+    void setRoutes(const QList<QGeoRoute> &routes);
+
+    void finishLater();
+    void failLater(QGeoRouteReply::Error errorCode, const QString &errorString);
+
+private Q_SLOTS:
+    void emitFinished();
+    void emitError();
+
+private:
+    QGeoRouteReply::Error m_errorCode = QGeoRouteReply::NoError;
+    QString m_errorString;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTEREPLYOFFLINE_H
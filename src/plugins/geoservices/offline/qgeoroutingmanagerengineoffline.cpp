@@ -0,0 +1,538 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutingmanagerengineoffline.h"
+#include "qgeoroutereplyoffline.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include <QtLocation/QGeoManeuver>
+#include <QtLocation/private/qgeojson_p.h>
+#include <QtLocation/private/qgeoroutesegment_p.h>
+#include <QtPositioning/QGeoPath>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+// an alternative may cost at most this much more than the best route
+const double MaxAlternativeStretch = 1.5;
+// and share at most this fraction of its length with any route already returned
+const double MaxAlternativeOverlap = 0.75;
+// each attempt makes the edges of the previous candidate this much more expensive
+const double AlternativePenalty = 1.4;
+const int MaxAlternativeAttempts = 4;
+
+const double PreferFactor = 0.7;
+const double AvoidFactor = 4.0;
+
+const struct
+{
+    QGeoRouteRequest::FeatureType type;
+    int feature;
+} Features[] = {
+    { QGeoRouteRequest::TollFeature, 0 },
+    { QGeoRouteRequest::HighwayFeature, 1 },
+    { QGeoRouteRequest::FerryFeature, 2 },
+    { QGeoRouteRequest::TunnelFeature, 3 },
+    { QGeoRouteRequest::DirtRoadFeature, 4 }
+};
+
+QHash<quint32, double> edgeLengths(const QRouteIndexOffline::Path &path)
+{
+    QHash<quint32, double> lengths;
+    for (const QRouteIndexOffline::Piece &piece : path.pieces) {
+        // skip the empty pieces of waypoints lying on a node
+        if (piece.end != piece.begin)
+            lengths[piece.edge] += std::abs(piece.end - piece.begin);
+    }
+    return lengths;
+}
+
+// the azimuth of the first step along \a path that actually moves
+double initialAzimuth(const QList<QGeoCoordinate> &path)
+{
+    for (qsizetype i = 1; i < path.size(); ++i) {
+        if (path.at(i) != path.first())
+            return path.first().azimuthTo(path.at(i));
+    }
+    return 0.0;
+}
+
+double finalAzimuth(const QList<QGeoCoordinate> &path)
+{
+    for (qsizetype i = path.size() - 2; i >= 0; --i) {
+        if (path.at(i) != path.last())
+            return path.at(i).azimuthTo(path.last());
+    }
+    return 0.0;
+}
+
+QString compassDirection(double azimuth)
+{
+    const QString directions[] = {
+        QGeoRoutingManagerEngineOffline::tr("north"),
+        QGeoRoutingManagerEngineOffline::tr("northeast"),
+        QGeoRoutingManagerEngineOffline::tr("east"),
+        QGeoRoutingManagerEngineOffline::tr("southeast"),
+        QGeoRoutingManagerEngineOffline::tr("south"),
+        QGeoRoutingManagerEngineOffline::tr("southwest"),
+        QGeoRoutingManagerEngineOffline::tr("west"),
+        QGeoRoutingManagerEngineOffline::tr("northwest")
+    };
+    return directions[int(std::floor(std::fmod(azimuth + 22.5 + 360.0, 360.0) / 45.0)) % 8];
+}
+
+// turn angles in degrees, positive to the right
+QGeoManeuver::InstructionDirection turnDirection(double angle)
+{
+    const double magnitude = std::abs(angle);
+    const bool right = angle > 0;
+    if (magnitude < 15.0)
+        return QGeoManeuver::DirectionForward;
+    if (magnitude < 40.0)
+        return right ? QGeoManeuver::DirectionLightRight : QGeoManeuver::DirectionLightLeft;
+    if (magnitude < 110.0)
+        return right ? QGeoManeuver::DirectionRight : QGeoManeuver::DirectionLeft;
+    if (magnitude < 170.0)
+        return right ? QGeoManeuver::DirectionHardRight : QGeoManeuver::DirectionHardLeft;
+    return right ? QGeoManeuver::DirectionUTurnRight : QGeoManeuver::DirectionUTurnLeft;
+}
+
+QString turnInstruction(QGeoManeuver::InstructionDirection direction, const QString &name)
+{
+    using Engine = QGeoRoutingManagerEngineOffline;
+    const bool named = !name.isEmpty();
+    switch (direction) {
+    case QGeoManeuver::DirectionLightRight:
+        return named ? Engine::tr("Turn slightly right onto %1").arg(name)
+                     : Engine::tr("Turn slightly right");
+    case QGeoManeuver::DirectionRight:
+        return named ? Engine::tr("Turn right onto %1").arg(name) : Engine::tr("Turn right");
+    case QGeoManeuver::DirectionHardRight:
+        return named ? Engine::tr("Turn sharp right onto %1").arg(name)
+                     : Engine::tr("Turn sharp right");
+    case QGeoManeuver::DirectionLightLeft:
+        return named ? Engine::tr("Turn slightly left onto %1").arg(name)
+                     : Engine::tr("Turn slightly left");
+    case QGeoManeuver::DirectionLeft:
+        return named ? Engine::tr("Turn left onto %1").arg(name) : Engine::tr("Turn left");
+    case QGeoManeuver::DirectionHardLeft:
+        return named ? Engine::tr("Turn sharp left onto %1").arg(name)
+                     : Engine::tr("Turn sharp left");
+    case QGeoManeuver::DirectionUTurnRight:
+    case QGeoManeuver::DirectionUTurnLeft:
+        return named ? Engine::tr("Make a U-turn onto %1").arg(name) : Engine::tr("Make a U-turn");
+    default:
+        return named ? Engine::tr("Continue onto %1").arg(name) : Engine::tr("Continue");
+    }
+}
+}
+
+QGeoRoutingManagerEngineOffline::QGeoRoutingManagerEngineOffline(const QVariantMap &parameters,
+                                                                 QGeoServiceProvider::Error *error,
+                                                                 QString *errorString)
+:   QGeoRoutingManagerEngine(parameters)
+{
+    if (parameters.contains(QStringLiteral("offline.routing.snap_distance"))
+            && parameters.value(QStringLiteral("offline.routing.snap_distance")).canConvert<double>())
+        m_snapDistance = parameters.value(QStringLiteral("offline.routing.snap_distance")).toDouble();
+
+    const QString indexFile = parameters.value(QStringLiteral("offline.routing.index")).toString();
+    const QString geoJsonFile = parameters.value(QStringLiteral("offline.routing.geojson")).toString();
+
+    if (indexFile.isEmpty() && geoJsonFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = tr("Either offline.routing.index or offline.routing.geojson is required");
+        return;
+    }
+
+    if (!geoJsonFile.isEmpty()) {
+        QFile file(geoJsonFile);
+        if (!file.open(QIODevice::ReadOnly)) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = file.errorString();
+            return;
+        }
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (document.isNull()) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = parseError.errorString();
+            return;
+        }
+
+        QRouteIndexOfflineBuilder builder;
+        builder.addGeoJson(QGeoJson::importGeoJson(document));
+
+        // contracting the graph is expensive, so the result is stored in
+        // offline.routing.index when given
+        bool ok;
+        if (indexFile.isEmpty())
+            ok = m_index.setData(builder.build(), errorString);
+        else
+            ok = builder.write(indexFile, errorString) && m_index.open(indexFile, errorString);
+        if (!ok) {
+            *error = QGeoServiceProvider::LoaderError;
+            return;
+        }
+    } else if (!m_index.open(indexFile, errorString)) {
+        *error = QGeoServiceProvider::LoaderError;
+        return;
+    }
+
+    setSupportedTravelModes(QGeoRouteRequest::CarTravel | QGeoRouteRequest::PedestrianTravel
+                            | QGeoRouteRequest::BicycleTravel);
+    QGeoRouteRequest::FeatureTypes featureTypes;
+    for (const auto &feature : Features)
+        featureTypes |= feature.type;
+    setSupportedFeatureTypes(featureTypes);
+    setSupportedFeatureWeights(QGeoRouteRequest::NeutralFeatureWeight
+                               | QGeoRouteRequest::PreferFeatureWeight
+                               | QGeoRouteRequest::AvoidFeatureWeight
+                               | QGeoRouteRequest::DisallowFeatureWeight);
+    setSupportedRouteOptimizations(QGeoRouteRequest::ShortestRoute
+                                   | QGeoRouteRequest::FastestRoute);
+    setSupportedSegmentDetails(QGeoRouteRequest::BasicSegmentData);
+    setSupportedManeuverDetails(QGeoRouteRequest::BasicManeuvers);
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QGeoRoutingManagerEngineOffline::~QGeoRoutingManagerEngineOffline()
+{
+}
+
+/*
+    Routes are answered from the contraction hierarchy unless the request changes the
+    cost of edges, through feature weights, excluded areas, the shortest route or
+    alternatives, which are searched on the plain road graph instead.
+*/
+QGeoRouteReply *QGeoRoutingManagerEngineOffline::calculateRoute(const QGeoRouteRequest &request)
+{
+    QGeoRouteReplyOffline *reply = new QGeoRouteReplyOffline(request, this);
+    connect(reply, &QGeoRouteReplyOffline::finished,
+            this, &QGeoRoutingManagerEngineOffline::replyFinished);
+    connect(reply, &QGeoRouteReplyOffline::errorOccurred,
+            this, &QGeoRoutingManagerEngineOffline::replyError);
+
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    if (waypoints.size() < 2) {
+        reply->failLater(QGeoRouteReply::UnsupportedOptionError,
+                         tr("At least two waypoints are required"));
+        return reply;
+    }
+
+    QGeoRouteRequest::TravelMode travelMode;
+    QRouteIndexOffline::Profile profile;
+    if (request.travelModes() & QGeoRouteRequest::CarTravel) {
+        travelMode = QGeoRouteRequest::CarTravel;
+        profile = QRouteIndexOffline::CarProfile;
+    } else if (request.travelModes() & QGeoRouteRequest::PedestrianTravel) {
+        travelMode = QGeoRouteRequest::PedestrianTravel;
+        profile = QRouteIndexOffline::PedestrianProfile;
+    } else if (request.travelModes() & QGeoRouteRequest::BicycleTravel) {
+        travelMode = QGeoRouteRequest::BicycleTravel;
+        profile = QRouteIndexOffline::BicycleProfile;
+    } else {
+        reply->failLater(QGeoRouteReply::UnsupportedOptionError,
+                         tr("Unsupported travel mode"));
+        return reply;
+    }
+
+    QRouteIndexOffline::Weighting weighting;
+    weighting.shortest = request.routeOptimization() == QGeoRouteRequest::ShortestRoute;
+    weighting.excludedAreas = request.excludeAreas();
+    const QList<QGeoRouteRequest::FeatureType> featureTypes = request.featureTypes();
+    for (QGeoRouteRequest::FeatureType type : featureTypes) {
+        const QGeoRouteRequest::FeatureWeight weight = request.featureWeight(type);
+        if (weight == QGeoRouteRequest::NeutralFeatureWeight)
+            continue;
+        const auto feature = std::find_if(std::begin(Features), std::end(Features),
+                                          [type](const auto &feature) { return feature.type == type; });
+        if (feature == std::end(Features) || weight == QGeoRouteRequest::RequireFeatureWeight) {
+            reply->failLater(QGeoRouteReply::UnsupportedOptionError,
+                             tr("Unsupported feature weight"));
+            return reply;
+        }
+        double &factor = weighting.featureFactors[feature->feature];
+        if (weight == QGeoRouteRequest::PreferFeatureWeight)
+            factor = PreferFactor;
+        else if (weight == QGeoRouteRequest::AvoidFeatureWeight)
+            factor = AvoidFactor;
+        else if (weight == QGeoRouteRequest::DisallowFeatureWeight)
+            factor = std::numeric_limits<double>::infinity();
+    }
+
+    QList<QRouteIndexOffline::Position> positions;
+    positions.reserve(waypoints.size());
+    for (qsizetype i = 0; i < waypoints.size(); ++i) {
+        const QRouteIndexOffline::Position position =
+                m_index.snap(waypoints.at(i), profile, m_snapDistance);
+        if (!position.isValid()) {
+            reply->failLater(QGeoRouteReply::UnknownError,
+                             tr("No road within %1 m of waypoint %2").arg(m_snapDistance).arg(i + 1));
+            return reply;
+        }
+        positions.append(position);
+    }
+
+    QList<QRouteIndexOffline::Path> legs;
+    legs.reserve(positions.size() - 1);
+    for (qsizetype i = 1; i < positions.size(); ++i) {
+        const QRouteIndexOffline::Path leg =
+                m_index.route(positions.at(i - 1), positions.at(i), profile, weighting);
+        if (!leg.isValid()) {
+            // the destination cannot be reached, which is an answer rather than an error
+            reply->finishLater();
+            return reply;
+        }
+        legs.append(leg);
+    }
+
+    QList<QGeoRoute> routes;
+    routes.append(route(request, travelMode, profile, legs));
+    if (legs.size() == 1 && request.numberAlternativeRoutes() > 0) {
+        const QList<QRouteIndexOffline::Path> paths =
+                alternatives(positions.first(), positions.last(), profile, weighting,
+                             legs.first(), request.numberAlternativeRoutes());
+        for (const QRouteIndexOffline::Path &path : paths)
+            routes.append(route(request, travelMode, profile, { path }));
+    }
+    reply->setRoutes(routes);
+
+    reply->finishLater();
+    return reply;
+}
+
+void QGeoRoutingManagerEngineOffline::replyFinished()
+{
+    QGeoRouteReply *reply = qobject_cast<QGeoRouteReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QGeoRoutingManagerEngineOffline::replyError(QGeoRouteReply::Error errorCode,
+                                                 const QString &errorString)
+{
+    QGeoRouteReply *reply = qobject_cast<QGeoRouteReply *>(sender());
+    if (reply)
+        emit errorOccurred(reply, errorCode, errorString);
+}
+
+/*
+    Returns up to \a count alternatives to \a best using the penalty method: the edges of
+    each candidate are made more expensive and the search is repeated, keeping candidates
+    that are not much slower than \a best and differ enough from every route found so far.
+*/
+QList<QRouteIndexOffline::Path> QGeoRoutingManagerEngineOffline::alternatives(
+        const QRouteIndexOffline::Position &from, const QRouteIndexOffline::Position &to,
+        QRouteIndexOffline::Profile profile, const QRouteIndexOffline::Weighting &weighting,
+        const QRouteIndexOffline::Path &best, int count) const
+{
+    QList<QRouteIndexOffline::Path> result;
+    QList<QHash<quint32, double>> accepted = { edgeLengths(best) };
+    QHash<quint32, double> previous = accepted.first();
+    QRouteIndexOffline::Weighting penalized = weighting;
+
+    for (int attempt = 0; attempt < count * MaxAlternativeAttempts && result.size() < count;
+         ++attempt) {
+        for (auto it = previous.cbegin(); it != previous.cend(); ++it)
+            penalized.penalties[it.key()] = penalized.penalties.value(it.key(), 1.0) * AlternativePenalty;
+
+        QRouteIndexOffline::Path candidate = m_index.route(from, to, profile, penalized);
+        if (!candidate.isValid())
+            break;
+        double cost = 0.0;
+        for (const QRouteIndexOffline::Piece &piece : std::as_const(candidate.pieces))
+            cost += m_index.cost(piece, profile, weighting);
+        // penalties only grow, so later candidates would be even slower
+        if (cost > best.cost * MaxAlternativeStretch)
+            break;
+
+        const QHash<quint32, double> lengths = edgeLengths(candidate);
+        double length = 0.0;
+        for (double pieceLength : lengths)
+            length += pieceLength;
+        bool distinct = true;
+        for (const QHash<quint32, double> &other : std::as_const(accepted)) {
+            double shared = 0.0;
+            for (auto it = lengths.cbegin(); it != lengths.cend(); ++it)
+                shared += qMin(it.value(), other.value(it.key(), 0.0));
+            if (length <= 0.0 || shared / length >= MaxAlternativeOverlap) {
+                distinct = false;
+                break;
+            }
+        }
+        previous = lengths;
+        if (distinct) {
+            candidate.cost = cost;
+            result.append(candidate);
+            accepted.append(lengths);
+        }
+    }
+    return result;
+}
+
+QGeoRoute QGeoRoutingManagerEngineOffline::route(const QGeoRouteRequest &request,
+                                                 QGeoRouteRequest::TravelMode travelMode,
+                                                 QRouteIndexOffline::Profile profile,
+                                                 const QList<QRouteIndexOffline::Path> &legs) const
+{
+    const QList<QGeoCoordinate> waypoints = request.waypoints();
+    QGeoRoute route;
+    QList<QGeoRoute> routeLegs;
+    QList<QGeoRouteSegment> segments;
+    qreal distance = 0.0;
+    int travelTime = 0;
+
+    for (qsizetype legIndex = 0; legIndex < legs.size(); ++legIndex) {
+        QList<QGeoRouteSegment> legSegments = this->segments(legs.at(legIndex), profile);
+        qreal legDistance = 0.0;
+        int legTravelTime = 0;
+        QList<QGeoCoordinate> path;
+        for (const QGeoRouteSegment &segment : std::as_const(legSegments)) {
+            legDistance += segment.distance();
+            legTravelTime += segment.travelTime();
+            path.append(segment.path());
+        }
+
+        // the arrival carries the waypoint, as in the routes of the online providers
+        QGeoManeuver arrival;
+        const bool last = legIndex == legs.size() - 1;
+        arrival.setDirection(QGeoManeuver::NoDirection);
+        arrival.setInstructionText(last ? tr("Arrive at your destination")
+                                        : tr("Arrive at waypoint %1").arg(legIndex + 1));
+        if (!path.isEmpty())
+            arrival.setPosition(path.last());
+        if (legIndex + 1 < waypoints.size())
+            arrival.setWaypoint(waypoints.at(legIndex + 1));
+        arrival.setDistanceToNextInstruction(0.0);
+        arrival.setTimeToNextInstruction(0);
+        QGeoRouteSegment arrivalSegment;
+        if (!path.isEmpty())
+            arrivalSegment.setPath({ path.last() });
+        arrivalSegment.setManeuver(arrival);
+        QGeoRouteSegmentPrivate::get(arrivalSegment)->setLegLastSegment(true);
+        legSegments.append(arrivalSegment);
+
+        QGeoRoute routeLeg;
+        routeLeg.setLegIndex(int(legIndex));
+        routeLeg.setOverallRoute(route);
+        routeLeg.setDistance(legDistance);
+        routeLeg.setTravelTime(legTravelTime);
+        routeLeg.setTravelMode(travelMode);
+        if (!path.isEmpty()) {
+            routeLeg.setPath(path);
+            routeLeg.setBounds(QGeoPath(path).boundingGeoRectangle());
+            routeLeg.setFirstRouteSegment(legSegments.first());
+        }
+        routeLegs.append(routeLeg);
+
+        distance += legDistance;
+        travelTime += legTravelTime;
+        segments.append(legSegments);
+    }
+
+    QList<QGeoCoordinate> path;
+    for (const QGeoRouteSegment &segment : std::as_const(segments)) {
+        const QList<QGeoCoordinate> segmentPath = segment.path();
+        for (const QGeoCoordinate &coordinate : segmentPath) {
+            if (path.isEmpty() || path.last() != coordinate)
+                path.append(coordinate);
+        }
+    }
+
+    for (qsizetype i = segments.size() - 1; i > 0; --i)
+        segments[i - 1].setNextRouteSegment(segments[i]);
+
+    route.setRequest(request);
+    route.setTravelMode(travelMode);
+    route.setDistance(distance);
+    route.setTravelTime(travelTime);
+    if (!path.isEmpty()) {
+        route.setPath(path);
+        route.setBounds(QGeoPath(path).boundingGeoRectangle());
+        route.setFirstRouteSegment(segments.first());
+    }
+    route.setRouteLegs(routeLegs);
+    return route;
+}
+
+/*
+    Splits \a leg into segments wherever the road name changes, each starting with the
+    maneuver onto that road.
+*/
+QList<QGeoRouteSegment> QGeoRoutingManagerEngineOffline::segments(
+        const QRouteIndexOffline::Path &leg, QRouteIndexOffline::Profile profile) const
+{
+    struct Stretch
+    {
+        QString name;
+        QList<QGeoCoordinate> path;
+        double distance = 0.0;
+        double travelTime = 0.0;
+    };
+
+    QList<Stretch> stretches;
+    for (const QRouteIndexOffline::Piece &piece : leg.pieces) {
+        const double length = std::abs(piece.end - piece.begin);
+        // keep one piece when the waypoints coincide, so that the leg has a position
+        if (length <= 0.0 && (!stretches.isEmpty() || &piece != &leg.pieces.constLast()))
+            continue;
+        const QString name = m_index.edgeName(piece.edge);
+        if (stretches.isEmpty() || stretches.last().name != name)
+            stretches.append({ name, {}, 0.0, 0.0 });
+
+        Stretch &stretch = stretches.last();
+        const QList<QGeoCoordinate> geometry = m_index.geometry(piece);
+        for (const QGeoCoordinate &coordinate : geometry) {
+            if (stretch.path.isEmpty() || stretch.path.last() != coordinate)
+                stretch.path.append(coordinate);
+        }
+        stretch.distance += length;
+        stretch.travelTime += m_index.travelTime(piece, profile);
+    }
+
+    QList<QGeoRouteSegment> result;
+    result.reserve(stretches.size());
+    for (qsizetype i = 0; i < stretches.size(); ++i) {
+        const Stretch &stretch = stretches.at(i);
+        QGeoManeuver maneuver;
+        maneuver.setPosition(stretch.path.isEmpty() ? QGeoCoordinate() : stretch.path.first());
+        if (i == 0) {
+            const QString heading = compassDirection(initialAzimuth(stretch.path));
+            maneuver.setDirection(QGeoManeuver::DirectionForward);
+            maneuver.setInstructionText(stretch.name.isEmpty()
+                                        ? tr("Head %1").arg(heading)
+                                        : tr("Head %1 on %2").arg(heading, stretch.name));
+        } else {
+            // the previous stretch ends where this one starts
+            const double incoming = finalAzimuth(stretches.at(i - 1).path);
+            const double outgoing = initialAzimuth(stretch.path);
+            const double angle = std::remainder(outgoing - incoming, 360.0);
+            const QGeoManeuver::InstructionDirection direction = turnDirection(angle);
+            maneuver.setDirection(direction);
+            maneuver.setInstructionText(turnInstruction(direction, stretch.name));
+        }
+        maneuver.setDistanceToNextInstruction(stretch.distance);
+        maneuver.setTimeToNextInstruction(qRound(stretch.travelTime));
+
+        QGeoRouteSegment segment;
+        segment.setPath(stretch.path);
+        segment.setDistance(stretch.distance);
+        segment.setTravelTime(qRound(stretch.travelTime));
+        segment.setManeuver(maneuver);
+        result.append(segment);
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
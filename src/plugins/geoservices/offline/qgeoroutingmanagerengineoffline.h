@@ -0,0 +1,50 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOROUTINGMANAGERENGINEOFFLINE_H
+#define QGEOROUTINGMANAGERENGINEOFFLINE_H
+
+#include "qrouteindexoffline.h"
+
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QGeoRoutingManagerEngine>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteSegment>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoRoutingManagerEngineOffline : public QGeoRoutingManagerEngine
+{
+    Q_OBJECT
+
+public:
+    QGeoRoutingManagerEngineOffline(const QVariantMap &parameters,
+                                    QGeoServiceProvider::Error *error, QString *errorString);
+    ~QGeoRoutingManagerEngineOffline();
+
+    QGeoRouteReply *calculateRoute(const QGeoRouteRequest &request) override;
+
+private Q_SLOTS:
+    void replyFinished();
+    void replyError(QGeoRouteReply::Error errorCode, const QString &errorString);
+
+private:
+    QList<QRouteIndexOffline::Path> alternatives(const QRouteIndexOffline::Position &from,
+                                                 const QRouteIndexOffline::Position &to,
+                                                 QRouteIndexOffline::Profile profile,
+                                                 const QRouteIndexOffline::Weighting &weighting,
+                                                 const QRouteIndexOffline::Path &best,
+                                                 int count) const;
+    QGeoRoute route(const QGeoRouteRequest &request, QGeoRouteRequest::TravelMode travelMode,
+                    QRouteIndexOffline::Profile profile,
+                    const QList<QRouteIndexOffline::Path> &legs) const;
+    QList<QGeoRouteSegment> segments(const QRouteIndexOffline::Path &leg,
+                                     QRouteIndexOffline::Profile profile) const;
+
+    QRouteIndexOffline m_index;
+    double m_snapDistance = 1000.0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGEOROUTINGMANAGERENGINEOFFLINE_H
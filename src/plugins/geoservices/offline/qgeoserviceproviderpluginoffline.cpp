@@ -0,0 +1,39 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoserviceproviderpluginoffline.h"
+#include "qgeocodingmanagerengineoffline.h"
+#include "qgeoroutingmanagerengineoffline.h"
+#include "qplacemanagerengineoffline.h"
+
+QT_BEGIN_NAMESPACE
+
+QGeoCodingManagerEngine *QGeoServiceProviderFactoryOffline::createGeocodingManagerEngine(
+    const QVariantMap &parameters, QGeoServiceProvider::Error *error, QString *errorString) const
+{
+    return new QGeoCodingManagerEngineOffline(parameters, error, errorString);
+}
+
+QGeoMappingManagerEngine *QGeoServiceProviderFactoryOffline::createMappingManagerEngine(
+    const QVariantMap &parameters, QGeoServiceProvider::Error *error, QString *errorString) const
+{
+    Q_UNUSED(parameters);
+    Q_UNUSED(error);
+    Q_UNUSED(errorString);
+
+    return nullptr;
+}
+
+QGeoRoutingManagerEngine *QGeoServiceProviderFactoryOffline::createRoutingManagerEngine(
+    const QVariantMap &parameters, QGeoServiceProvider::Error *error, QString *errorString) const
+{
+    return new QGeoRoutingManagerEngineOffline(parameters, error, errorString);
+}
+
+QPlaceManagerEngine *QGeoServiceProviderFactoryOffline::createPlaceManagerEngine(
+    const QVariantMap &parameters, QGeoServiceProvider::Error *error, QString *errorString) const
+{
+    return new QPlaceManagerEngineOffline(parameters, error, errorString);
+}
+
+QT_END_NAMESPACE
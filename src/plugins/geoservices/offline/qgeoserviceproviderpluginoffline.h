@@ -0,0 +1,36 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QGEOSERVICEPROVIDER_OFFLINE_H
+#define QGEOSERVICEPROVIDER_OFFLINE_H
+
+#include <QtCore/QObject>
+#include <QtLocation/QGeoServiceProviderFactory>
+
+QT_BEGIN_NAMESPACE
+
+class QGeoServiceProviderFactoryOffline: public QObject, public QGeoServiceProviderFactory
+{
+    Q_OBJECT
+    Q_INTERFACES(QGeoServiceProviderFactory)
+    Q_PLUGIN_METADATA(IID "org.qt-project.qt.geoservice.serviceproviderfactory/6.0"
+                      FILE "offline_plugin.json")
+
+public:
+    QGeoCodingManagerEngine *createGeocodingManagerEngine(const QVariantMap &parameters,
+                                                          QGeoServiceProvider::Error *error,
+                                                          QString *errorString) const override;
+    QGeoMappingManagerEngine *createMappingManagerEngine(const QVariantMap &parameters,
+                                                         QGeoServiceProvider::Error *error,
+                                                         QString *errorString) const override;
+    QGeoRoutingManagerEngine *createRoutingManagerEngine(const QVariantMap &parameters,
+                                                         QGeoServiceProvider::Error *error,
+                                                         QString *errorString) const override;
+    QPlaceManagerEngine *createPlaceManagerEngine(const QVariantMap &parameters,
+                                                  QGeoServiceProvider::Error *error,
+                                                  QString *errorString) const override;
+};
+
+QT_END_NAMESPACE
+
+#endif
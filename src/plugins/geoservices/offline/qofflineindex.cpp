@@ -0,0 +1,67 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qofflineindex.h"
+
+QT_BEGIN_NAMESPACE
+
+QOfflineIndexData::QOfflineIndexData()
+{
+}
+
+QOfflineIndexData::~QOfflineIndexData()
+{
+    close();
+}
+
+/*
+    Memory maps \a fileName. The file stays mapped, and therefore open, until close() is
+    called or the data is destroyed.
+*/
+bool QOfflineIndexData::open(const QString &fileName, QString *errorString)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (errorString)
+            *errorString = m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    const uchar *data = m_file.map(0, size);
+    if (!data) {
+        if (errorString)
+            *errorString = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+void QOfflineIndexData::setData(const QByteArray &data)
+{
+    close();
+
+    m_buffer = data;
+    m_data = reinterpret_cast<const uchar *>(m_buffer.constData());
+    m_size = m_buffer.size();
+}
+
+void QOfflineIndexData::close()
+{
+    if (m_file.isOpen()) {
+        if (m_data)
+            m_file.unmap(const_cast<uchar *>(m_data));
+        m_file.close();
+    }
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+QT_END_NAMESPACE
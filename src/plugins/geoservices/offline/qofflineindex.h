@@ -0,0 +1,155 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QOFFLINEINDEX_H
+#define QOFFLINEINDEX_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+#include <QtCore/QtMath>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Helpers shared by the binary index formats of the offline plugin. All formats store
+    little endian values in 8 byte aligned sections, and are read in place from a memory
+    mapped file or from a buffer.
+*/
+namespace QOfflineIndex
+{
+template <typename T>
+inline void append(QByteArray &data, T value)
+{
+    const T le = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char *>(&le), sizeof(T));
+}
+
+template <typename T>
+inline void put(QByteArray &data, qsizetype offset, T value)
+{
+    qToLittleEndian(value, data.data() + offset);
+}
+
+template <typename T>
+inline T get(const uchar *data)
+{
+    return qFromLittleEndian<T>(data);
+}
+
+inline void align(QByteArray &data)
+{
+    while (data.size() % 8)
+        data.append('\0');
+}
+
+// Whether count items of itemSize bytes at offset are within size bytes. The offsets and
+// counts are read from the files, so offset + count * itemSize could wrap around.
+inline bool fits(quint64 size, quint64 offset, quint64 count, quint64 itemSize)
+{
+    return offset <= size && count <= (size - offset) / itemSize;
+}
+
+inline quint32 morton(quint32 x, quint32 y, int bits)
+{
+    quint32 key = 0;
+    for (int i = 0; i < bits; ++i) {
+        key |= ((x >> i) & 1u) << (2 * i);
+        key |= ((y >> i) & 1u) << (2 * i + 1);
+    }
+    return key;
+}
+
+inline void demorton(quint32 key, int bits, int *x, int *y)
+{
+    *x = 0;
+    *y = 0;
+    for (int i = 0; i < bits; ++i) {
+        *x |= int((key >> (2 * i)) & 1u) << i;
+        *y |= int((key >> (2 * i + 1)) & 1u) << i;
+    }
+}
+
+const double MetersPerDegree = 6371008.8 * M_PI / 180.0;
+
+inline double wrapLongitude(double degrees)
+{
+    while (degrees > 180.0)
+        degrees -= 360.0;
+    while (degrees < -180.0)
+        degrees += 360.0;
+    return degrees;
+}
+
+// Planar coordinates in meters in a local equirectangular projection around an origin,
+// accurate enough over the few kilometers that nearest neighbour lookups look at.
+struct LocalProjection
+{
+    explicit LocalProjection(const QGeoCoordinate &origin)
+        : latitude(origin.latitude()), longitude(origin.longitude()),
+          xScale(MetersPerDegree * std::cos(qDegreesToRadians(origin.latitude())))
+    {
+    }
+
+    void project(qint32 lat, qint32 lon, double *x, double *y) const
+    {
+        *x = wrapLongitude(lon / 1e7 - longitude) * xScale;
+        *y = (lat / 1e7 - latitude) * MetersPerDegree;
+    }
+
+    QGeoCoordinate unproject(double x, double y) const
+    {
+        return QGeoCoordinate(latitude + y / MetersPerDegree,
+                              wrapLongitude(longitude + (xScale > 0 ? x / xScale : 0.0)));
+    }
+
+    double latitude;
+    double longitude;
+    double xScale;
+};
+
+// distance from the origin to the segment a-b, and the closest point of the segment
+inline double segmentDistance(double ax, double ay, double bx, double by, double *px, double *py)
+{
+    const double dx = bx - ax;
+    const double dy = by - ay;
+    const double length = dx * dx + dy * dy;
+    double t = length > 0 ? -(ax * dx + ay * dy) / length : 0.0;
+    t = qBound(0.0, t, 1.0);
+    *px = ax + t * dx;
+    *py = ay + t * dy;
+    return std::hypot(*px, *py);
+}
+}
+
+/*
+    Holds the bytes of an index, either a read only mapping of a file or an in-memory copy.
+*/
+class QOfflineIndexData
+{
+public:
+    QOfflineIndexData();
+    ~QOfflineIndexData();
+
+    bool open(const QString &fileName, QString *errorString = nullptr);
+    void setData(const QByteArray &data);
+    void close();
+
+    const uchar *data() const { return m_data; }
+    qint64 size() const { return m_size; }
+
+private:
+    Q_DISABLE_COPY(QOfflineIndexData)
+
+    QFile m_file;
+    QByteArray m_buffer;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOFFLINEINDEX_H
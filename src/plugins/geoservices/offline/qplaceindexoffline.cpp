@@ -0,0 +1,740 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplaceindexoffline.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QSaveFile>
+
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoPath>
+#include <QtPositioning/QGeoPolygon>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+using QOfflineIndex::align;
+using QOfflineIndex::append;
+using QOfflineIndex::fits;
+using QOfflineIndex::get;
+using QOfflineIndex::put;
+
+namespace
+{
+const char IndexMagic[8] = { 'Q', 'P', 'L', 'I', 'D', 'X', '0', '1' };
+const quint32 IndexVersion = 1;
+
+const int GridBits = 12;
+const int GridSize = 1 << GridBits;
+// enumerate the cells of a query box directly up to this many cells, scan the cell table otherwise
+const int MaxEnumeratedCells = 4096;
+
+const int HeaderSize = 96;
+const int PoiRecordSize = 24;
+const int CellRecordSize = 12;
+const int TokenRecordSize = 16;
+const int IdRecordSize = 8;
+
+const char CategoryTokenPrefix = '\x01';
+
+/*
+    The header is a fixed 96 byte block, all values little endian:
+
+    0   magic           8 bytes
+    8   version         u32
+    12  poiCount        u32
+    16  cellCount       u32
+    20  tokenCount      u32
+    24  idCount         u32
+    28  reserved        u32
+    32  poiOffset       u64     poiCount x { i32 lat*1e7, i32 lon*1e7, u32 id, u32 name,
+                                             u32 categories, u32 address }
+    40  cellOffset      u64     cellCount x { u32 morton key, u32 first record, u32 count }
+    48  tokenOffset     u64     tokenCount x { u32 token, u32 postings, u64 first posting }
+    56  postingOffset   u64     u32 record numbers
+    64  postingCount    u64
+    72  idOffset        u64     idCount x { u32 id, u32 record }, sorted by id
+    80  stringOffset    u64     null terminated UTF-8 strings, offset 0 is the empty string
+    88  stringSize      u64
+*/
+
+int gridX(double longitude)
+{
+    return qBound(0, int(std::floor((longitude + 180.0) / 360.0 * GridSize)), GridSize - 1);
+}
+
+int gridY(double latitude)
+{
+    return qBound(0, int(std::floor((latitude + 90.0) / 180.0 * GridSize)), GridSize - 1);
+}
+
+quint32 morton(quint32 x, quint32 y)
+{
+    return QOfflineIndex::morton(x, y, GridBits);
+}
+
+void demorton(quint32 key, int *x, int *y)
+{
+    QOfflineIndex::demorton(key, GridBits, x, y);
+}
+
+quint32 cellKey(const QGeoCoordinate &coordinate)
+{
+    return morton(gridX(coordinate.longitude()), gridY(coordinate.latitude()));
+}
+
+void addPosting(QList<quint32> &postings, quint32 record)
+{
+    if (postings.isEmpty() || postings.last() != record)
+        postings.append(record);
+}
+
+QGeoCoordinate featureCoordinate(const QVariantMap &feature)
+{
+    const QString type = feature.value(QStringLiteral("type")).toString();
+    const QVariant data = feature.value(QStringLiteral("data"));
+    if (type == QLatin1String("Point"))
+        return data.value<QGeoCircle>().center();
+    if (type == QLatin1String("Polygon"))
+        return data.value<QGeoPolygon>().center();
+    if (type == QLatin1String("LineString"))
+        return data.value<QGeoPath>().center();
+    return QGeoCoordinate();
+}
+
+// OSM tag keys that are turned into "key=value" categories, matching the osm plugin
+const char *const CategoryTagKeys[] = {
+    "aeroway", "amenity", "building", "highway", "historic", "landuse", "leisure",
+    "man_made", "natural", "place", "railway", "shop", "tourism", "waterway"
+};
+
+} // namespace
+
+void QPlaceIndexOfflineBuilder::addPoi(const QPlaceOfflinePoi &poi)
+{
+    if (poi.coordinate.isValid())
+        m_pois.append(poi);
+}
+
+/*
+    Imports the points of interest of \a importedGeoJson, as returned by
+    QGeoJson::importGeoJson(). Point features are used as is, polygons and line strings
+    are represented by their center. The feature id or the "id" property becomes the place
+    id, "name" and "address" are indexed for full text search. Categories are read from the
+    "categories" property, either an array or a ';' separated string, and from OSM tags such
+    as "amenity" which become "amenity=value" categories.
+
+    Returns the number of imported points of interest.
+*/
+int QPlaceIndexOfflineBuilder::addGeoJson(const QVariantList &importedGeoJson)
+{
+    const qsizetype before = m_pois.size();
+    for (const QVariant &item : importedGeoJson) {
+        const QVariantMap map = item.toMap();
+        const QString type = map.value(QStringLiteral("type")).toString();
+        if (type == QLatin1String("FeatureCollection")
+                || type == QLatin1String("GeometryCollection")) {
+            addGeoJson(map.value(QStringLiteral("data")).toList());
+        } else {
+            addFeature(map);
+        }
+    }
+    return int(m_pois.size() - before);
+}
+
+void QPlaceIndexOfflineBuilder::addFeature(const QVariantMap &feature)
+{
+    QPlaceOfflinePoi poi;
+    poi.coordinate = featureCoordinate(feature);
+    if (!poi.coordinate.isValid())
+        return;
+
+    const QVariantMap properties = feature.value(QStringLiteral("properties")).toMap();
+    poi.placeId = feature.value(QStringLiteral("id")).toString();
+    if (poi.placeId.isEmpty())
+        poi.placeId = properties.value(QStringLiteral("id")).toString();
+    poi.name = properties.value(QStringLiteral("name")).toString();
+    poi.address = properties.value(QStringLiteral("address")).toString();
+
+    const QVariant categories = properties.value(QStringLiteral("categories"));
+    if (categories.typeId() == QMetaType::QVariantList || categories.typeId() == QMetaType::QStringList)
+        poi.categoryIds = categories.toStringList();
+    else if (!categories.toString().isEmpty())
+        poi.categoryIds = categories.toString().split(QLatin1Char(';'), Qt::SkipEmptyParts);
+
+    for (const char *key : CategoryTagKeys) {
+        const QString value = properties.value(QLatin1String(key)).toString();
+        if (!value.isEmpty())
+            poi.categoryIds.append(QString::fromLatin1(key) + QLatin1Char('=') + value);
+    }
+
+    addPoi(poi);
+}
+
+qsizetype QPlaceIndexOfflineBuilder::size() const
+{
+    return m_pois.size();
+}
+
+QByteArray QPlaceIndexOfflineBuilder::build() const
+{
+    const quint32 poiCount = quint32(m_pois.size());
+
+    // order the records along the Morton curve so that every cell is a contiguous range
+    QList<std::pair<quint32, quint32>> order;
+    order.reserve(poiCount);
+    for (quint32 i = 0; i < poiCount; ++i)
+        order.append(std::make_pair(cellKey(m_pois.at(i).coordinate), i));
+    std::sort(order.begin(), order.end());
+
+    QByteArray strings(1, '\0');
+    QHash<QByteArray, quint32> sharedStrings;
+    const auto addString = [&strings](const QByteArray &utf8) -> quint32 {
+        if (utf8.isEmpty())
+            return 0;
+        const quint32 offset = quint32(strings.size());
+        strings.append(utf8);
+        strings.append('\0');
+        return offset;
+    };
+    const auto addSharedString = [&](const QByteArray &utf8) -> quint32 {
+        const auto it = sharedStrings.constFind(utf8);
+        if (it != sharedStrings.constEnd())
+            return it.value();
+        const quint32 offset = addString(utf8);
+        sharedStrings.insert(utf8, offset);
+        return offset;
+    };
+
+    QByteArray pois;
+    pois.reserve(qsizetype(poiCount) * PoiRecordSize);
+    QByteArray cells;
+    quint32 cellCount = 0;
+    QMap<QByteArray, QList<quint32>> tokens;
+    QList<std::pair<QByteArray, quint32>> ids;
+
+    quint32 currentCell = 0;
+    qsizetype currentCellRecord = -1;
+    for (quint32 record = 0; record < poiCount; ++record) {
+        const quint32 cell = order.at(record).first;
+        const QPlaceOfflinePoi &poi = m_pois.at(order.at(record).second);
+
+        if (currentCellRecord < 0 || cell != currentCell) {
+            currentCell = cell;
+            currentCellRecord = cells.size();
+            append<quint32>(cells, cell);
+            append<quint32>(cells, record);
+            append<quint32>(cells, 0);
+            ++cellCount;
+        }
+        put<quint32>(cells, currentCellRecord + 8,
+                     get<quint32>(reinterpret_cast<const uchar *>(cells.constData())
+                                  + currentCellRecord + 8) + 1);
+
+        const QByteArray id = poi.placeId.toUtf8();
+        const quint32 idOffset = addString(id);
+        if (!id.isEmpty())
+            ids.append(std::make_pair(id, record));
+
+        append<qint32>(pois, qint32(qRound(poi.coordinate.latitude() * 1e7)));
+        append<qint32>(pois, qint32(qRound(poi.coordinate.longitude() * 1e7)));
+        append<quint32>(pois, idOffset);
+        append<quint32>(pois, addString(poi.name.toUtf8()));
+        append<quint32>(pois, addSharedString(poi.categoryIds.join(QLatin1Char(';')).toUtf8()));
+        append<quint32>(pois, addString(poi.address.toUtf8()));
+
+        const QStringList words = QPlaceIndexOffline::tokenize(poi.name + QLatin1Char(' ')
+                                                               + poi.address);
+        for (const QString &word : words)
+            addPosting(tokens[word.toUtf8()], record);
+
+        for (const QString &categoryId : poi.categoryIds) {
+            addPosting(tokens[CategoryTokenPrefix + categoryId.toUtf8()], record);
+            const QString parent = categoryId.section(QLatin1Char('='), 0, 0);
+            if (parent != categoryId)
+                addPosting(tokens[CategoryTokenPrefix + parent.toUtf8()], record);
+        }
+    }
+
+    std::sort(ids.begin(), ids.end());
+
+    QByteArray tokenTable;
+    QByteArray postings;
+    quint64 postingCount = 0;
+    for (auto it = tokens.cbegin(), end = tokens.cend(); it != end; ++it) {
+        append<quint32>(tokenTable, addSharedString(it.key()));
+        append<quint32>(tokenTable, quint32(it.value().size()));
+        append<quint64>(tokenTable, postingCount);
+        for (quint32 record : it.value())
+            append<quint32>(postings, record);
+        postingCount += quint64(it.value().size());
+    }
+
+    QByteArray idTable;
+    for (const auto &id : std::as_const(ids)) {
+        // share the id string already referenced by the record
+        const uchar *record = reinterpret_cast<const uchar *>(pois.constData())
+                + qsizetype(id.second) * PoiRecordSize;
+        append<quint32>(idTable, get<quint32>(record + 8));
+        append<quint32>(idTable, id.second);
+    }
+
+    QByteArray index(HeaderSize, '\0');
+    memcpy(index.data(), IndexMagic, sizeof(IndexMagic));
+    put<quint32>(index, 8, IndexVersion);
+    put<quint32>(index, 12, poiCount);
+    put<quint32>(index, 16, cellCount);
+    put<quint32>(index, 20, quint32(tokens.size()));
+    put<quint32>(index, 24, quint32(ids.size()));
+
+    put<quint64>(index, 32, quint64(index.size()));
+    index.append(pois);
+    align(index);
+    put<quint64>(index, 40, quint64(index.size()));
+    index.append(cells);
+    align(index);
+    put<quint64>(index, 48, quint64(index.size()));
+    index.append(tokenTable);
+    align(index);
+    put<quint64>(index, 56, quint64(index.size()));
+    put<quint64>(index, 64, postingCount);
+    index.append(postings);
+    align(index);
+    put<quint64>(index, 72, quint64(index.size()));
+    index.append(idTable);
+    align(index);
+    put<quint64>(index, 80, quint64(index.size()));
+    put<quint64>(index, 88, quint64(strings.size()));
+    index.append(strings);
+
+    return index;
+}
+
+bool QPlaceIndexOfflineBuilder::write(const QString &fileName, QString *errorString) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    file.write(build());
+    if (!file.commit()) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QPlaceIndexOffline::QPlaceIndexOffline()
+{
+}
+
+QPlaceIndexOffline::~QPlaceIndexOffline()
+{
+    close();
+}
+
+/*
+    Memory maps the index file \a fileName. The file stays mapped, and therefore open,
+    for the lifetime of the index.
+*/
+bool QPlaceIndexOffline::open(const QString &fileName, QString *errorString)
+{
+    close();
+    if (!m_file.open(fileName, errorString))
+        return false;
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/*
+    Uses the in-memory index \a data, as produced by QPlaceIndexOfflineBuilder::build().
+*/
+bool QPlaceIndexOffline::setData(const QByteArray &data, QString *errorString)
+{
+    close();
+    m_file.setData(data);
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool QPlaceIndexOffline::isValid() const
+{
+    return m_data != nullptr;
+}
+
+bool QPlaceIndexOffline::load(const uchar *data, qint64 size, QString *errorString)
+{
+    const auto fail = [errorString](const char *message) {
+        if (errorString)
+            *errorString = QString::fromLatin1(message);
+        return false;
+    };
+
+    if (size < HeaderSize || memcmp(data, IndexMagic, sizeof(IndexMagic)) != 0)
+        return fail("Not a places index file");
+    if (get<quint32>(data + 8) != IndexVersion)
+        return fail("Unsupported places index version");
+
+    m_poiCount = get<quint32>(data + 12);
+    m_cellCount = get<quint32>(data + 16);
+    m_tokenCount = get<quint32>(data + 20);
+    const quint32 idCount = get<quint32>(data + 24);
+    const quint64 poiOffset = get<quint64>(data + 32);
+    const quint64 cellOffset = get<quint64>(data + 40);
+    const quint64 tokenOffset = get<quint64>(data + 48);
+    const quint64 postingOffset = get<quint64>(data + 56);
+    m_postingCount = get<quint64>(data + 64);
+    const quint64 idOffset = get<quint64>(data + 72);
+    const quint64 stringOffset = get<quint64>(data + 80);
+    m_stringSize = get<quint64>(data + 88);
+
+    const quint64 fileSize = quint64(size);
+    if (!fits(fileSize, poiOffset, m_poiCount, PoiRecordSize)
+            || !fits(fileSize, cellOffset, m_cellCount, CellRecordSize)
+            || !fits(fileSize, tokenOffset, m_tokenCount, TokenRecordSize)
+            || !fits(fileSize, postingOffset, m_postingCount, 4)
+            || !fits(fileSize, idOffset, idCount, IdRecordSize)
+            || !fits(fileSize, stringOffset, m_stringSize, 1)
+            || m_stringSize == 0 || data[stringOffset + m_stringSize - 1] != '\0') {
+        return fail("Truncated places index file");
+    }
+
+    m_data = data;
+    m_size = size;
+    m_pois = data + poiOffset;
+    m_cells = data + cellOffset;
+    m_tokens = data + tokenOffset;
+    m_postings = data + postingOffset;
+    m_ids = data + idOffset;
+    m_idCount = idCount;
+    m_strings = data + stringOffset;
+    return true;
+}
+
+void QPlaceIndexOffline::close()
+{
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+    m_poiCount = 0;
+    m_cellCount = 0;
+    m_tokenCount = 0;
+    m_idCount = 0;
+    m_postingCount = 0;
+    m_stringSize = 0;
+}
+
+quint32 QPlaceIndexOffline::count() const
+{
+    return m_poiCount;
+}
+
+QPlaceOfflinePoi QPlaceIndexOffline::poi(quint32 index) const
+{
+    QPlaceOfflinePoi poi;
+    if (index >= m_poiCount)
+        return poi;
+
+    const uchar *record = m_pois + qsizetype(index) * PoiRecordSize;
+    poi.coordinate = coordinate(index);
+    const quint32 id = get<quint32>(record + 8);
+    poi.placeId = id ? QString::fromUtf8(string(id)) : QString::number(index);
+    poi.name = QString::fromUtf8(string(get<quint32>(record + 12)));
+    poi.categoryIds = QString::fromUtf8(string(get<quint32>(record + 16)))
+                          .split(QLatin1Char(';'), Qt::SkipEmptyParts);
+    poi.address = QString::fromUtf8(string(get<quint32>(record + 20)));
+    return poi;
+}
+
+QGeoCoordinate QPlaceIndexOffline::coordinate(quint32 index) const
+{
+    if (index >= m_poiCount)
+        return QGeoCoordinate();
+    const uchar *record = m_pois + qsizetype(index) * PoiRecordSize;
+    return QGeoCoordinate(get<qint32>(record) / 1e7, get<qint32>(record + 4) / 1e7);
+}
+
+QString QPlaceIndexOffline::name(quint32 index) const
+{
+    if (index >= m_poiCount)
+        return QString();
+    const uchar *record = m_pois + qsizetype(index) * PoiRecordSize;
+    return QString::fromUtf8(string(get<quint32>(record + 12)));
+}
+
+/*
+    Returns the sorted record numbers of all points of interest inside \a box. Boxes crossing
+    the antimeridian are handled as two boxes.
+*/
+QList<quint32> QPlaceIndexOffline::withinBox(const QGeoRectangle &box) const
+{
+    QList<quint32> result;
+    if (!isValid() || !box.isValid())
+        return result;
+
+    const double left = box.topLeft().longitude();
+    const double right = box.bottomRight().longitude();
+    if (left > right) {
+        appendBox(QGeoRectangle(box.topLeft(),
+                                QGeoCoordinate(box.bottomRight().latitude(), 180.0)), &result);
+        appendBox(QGeoRectangle(QGeoCoordinate(box.topLeft().latitude(), -180.0),
+                                box.bottomRight()), &result);
+    } else {
+        appendBox(box, &result);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void QPlaceIndexOffline::appendBox(const QGeoRectangle &box, QList<quint32> *result) const
+{
+    const int x0 = gridX(box.topLeft().longitude());
+    const int x1 = gridX(box.bottomRight().longitude());
+    const int y0 = gridY(box.bottomRight().latitude());
+    const int y1 = gridY(box.topLeft().latitude());
+
+    if (qint64(x1 - x0 + 1) * qint64(y1 - y0 + 1) <= MaxEnumeratedCells) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                const quint32 key = morton(quint32(x), quint32(y));
+                quint32 low = 0;
+                quint32 high = m_cellCount;
+                while (low < high) {
+                    const quint32 mid = low + (high - low) / 2;
+                    if (get<quint32>(m_cells + qsizetype(mid) * CellRecordSize) < key)
+                        low = mid + 1;
+                    else
+                        high = mid;
+                }
+                if (low < m_cellCount
+                        && get<quint32>(m_cells + qsizetype(low) * CellRecordSize) == key) {
+                    appendCell(low, box, result);
+                }
+            }
+        }
+    } else {
+        for (quint32 cell = 0; cell < m_cellCount; ++cell) {
+            int x, y;
+            demorton(get<quint32>(m_cells + qsizetype(cell) * CellRecordSize), &x, &y);
+            if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+                appendCell(cell, box, result);
+        }
+    }
+}
+
+void QPlaceIndexOffline::appendCell(quint32 cell, const QGeoRectangle &box,
+                                    QList<quint32> *result) const
+{
+    const uchar *record = m_cells + qsizetype(cell) * CellRecordSize;
+    const quint32 first = get<quint32>(record + 4);
+    const quint32 count = get<quint32>(record + 8);
+
+    const qint32 top = qint32(qRound(box.topLeft().latitude() * 1e7));
+    const qint32 bottom = qint32(qRound(box.bottomRight().latitude() * 1e7));
+    const qint32 left = qint32(qRound(box.topLeft().longitude() * 1e7));
+    const qint32 right = qint32(qRound(box.bottomRight().longitude() * 1e7));
+
+    for (quint32 i = first; i < first + count && i < m_poiCount; ++i) {
+        const uchar *poi = m_pois + qsizetype(i) * PoiRecordSize;
+        const qint32 lat = get<qint32>(poi);
+        const qint32 lon = get<qint32>(poi + 4);
+        if (lat >= bottom && lat <= top && lon >= left && lon <= right)
+            result->append(i);
+    }
+}
+
+/*
+    Returns the sorted record numbers of all points of interest containing the word \a token.
+*/
+QList<quint32> QPlaceIndexOffline::matchingToken(const QString &token) const
+{
+    const QByteArray utf8 = token.toCaseFolded().toUtf8();
+    const qint64 index = lowerBoundToken(utf8);
+    if (index < m_tokenCount && tokenAt(index) == utf8)
+        return postings(index);
+    return QList<quint32>();
+}
+
+/*
+    Returns the sorted record numbers of points of interest containing a word that starts
+    with \a prefix. Stops adding words once at least \a limit records were collected,
+    a negative \a limit collects all of them.
+*/
+QList<quint32> QPlaceIndexOffline::matchingPrefix(const QString &prefix, qsizetype limit) const
+{
+    QList<quint32> result;
+    const QByteArray utf8 = prefix.toCaseFolded().toUtf8();
+    if (utf8.isEmpty())
+        return result;
+
+    for (qint64 index = lowerBoundToken(utf8); index < m_tokenCount; ++index) {
+        if (!tokenAt(index).startsWith(utf8))
+            break;
+        result = unite(result, postings(index));
+        if (limit >= 0 && result.size() >= limit)
+            break;
+    }
+    return result;
+}
+
+QList<quint32> QPlaceIndexOffline::inCategory(const QString &categoryId) const
+{
+    const QByteArray token = CategoryTokenPrefix + categoryId.toUtf8();
+    const qint64 index = lowerBoundToken(token);
+    if (index < m_tokenCount && tokenAt(index) == token)
+        return postings(index);
+    return QList<quint32>();
+}
+
+/*
+    Returns the record number of \a placeId or -1. Points of interest imported without an
+    id are identified by their record number.
+*/
+qint64 QPlaceIndexOffline::find(const QString &placeId) const
+{
+    if (!isValid())
+        return -1;
+
+    const QByteArray utf8 = placeId.toUtf8();
+    quint32 low = 0;
+    quint32 high = m_idCount;
+    while (low < high) {
+        const quint32 mid = low + (high - low) / 2;
+        if (qstrcmp(string(get<quint32>(m_ids + qsizetype(mid) * IdRecordSize)), utf8.constData()) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low < m_idCount
+            && qstrcmp(string(get<quint32>(m_ids + qsizetype(low) * IdRecordSize)), utf8.constData()) == 0) {
+        const quint32 record = get<quint32>(m_ids + qsizetype(low) * IdRecordSize + 4);
+        return record < m_poiCount ? qint64(record) : -1;
+    }
+
+    bool ok = false;
+    const quint32 record = placeId.toUInt(&ok);
+    if (ok && record < m_poiCount && get<quint32>(m_pois + qsizetype(record) * PoiRecordSize + 8) == 0)
+        return record;
+    return -1;
+}
+
+QStringList QPlaceIndexOffline::categoryIds() const
+{
+    QStringList result;
+    const QByteArray prefix(1, CategoryTokenPrefix);
+    for (qint64 index = lowerBoundToken(prefix); index < m_tokenCount; ++index) {
+        const QByteArray token = tokenAt(index);
+        if (!token.startsWith(prefix))
+            break;
+        result.append(QString::fromUtf8(token.mid(1)));
+    }
+    return result;
+}
+
+/*
+    Splits \a text into case folded words.
+*/
+QStringList QPlaceIndexOffline::tokenize(const QString &text)
+{
+    QStringList tokens;
+    const QString folded = text.toCaseFolded();
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= folded.size(); ++i) {
+        const bool wordChar = i < folded.size() && folded.at(i).isLetterOrNumber();
+        if (wordChar && start < 0) {
+            start = i;
+        } else if (!wordChar && start >= 0) {
+            tokens.append(folded.mid(start, i - start));
+            start = -1;
+        }
+    }
+    return tokens;
+}
+
+QList<quint32> QPlaceIndexOffline::intersect(const QList<quint32> &a, const QList<quint32> &b)
+{
+    QList<quint32> result;
+    result.reserve(qMin(a.size(), b.size()));
+    std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+
+QList<quint32> QPlaceIndexOffline::unite(const QList<quint32> &a, const QList<quint32> &b)
+{
+    if (a.isEmpty())
+        return b;
+    if (b.isEmpty())
+        return a;
+
+    QList<quint32> result;
+    result.reserve(a.size() + b.size());
+    std::set_union(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+
+qint64 QPlaceIndexOffline::lowerBoundToken(const QByteArray &token) const
+{
+    quint32 low = 0;
+    quint32 high = m_tokenCount;
+    while (low < high) {
+        const quint32 mid = low + (high - low) / 2;
+        if (qstrcmp(string(get<quint32>(m_tokens + qsizetype(mid) * TokenRecordSize)),
+                    token.constData()) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+QByteArray QPlaceIndexOffline::tokenAt(qint64 index) const
+{
+    return QByteArray(string(get<quint32>(m_tokens + qsizetype(index) * TokenRecordSize)));
+}
+
+QList<quint32> QPlaceIndexOffline::postings(qint64 tokenIndex) const
+{
+    const uchar *record = m_tokens + qsizetype(tokenIndex) * TokenRecordSize;
+    const quint32 count = get<quint32>(record + 4);
+    const quint64 first = get<quint64>(record + 8);
+
+    QList<quint32> result;
+    if (!fits(m_postingCount, first, count, 1))
+        return result;
+
+    // Record numbers out of range come from a corrupt index, and are left out
+    result.reserve(count);
+    const uchar *posting = m_postings + qsizetype(first) * 4;
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 record = get<quint32>(posting + qsizetype(i) * 4);
+        if (record < m_poiCount)
+            result.append(record);
+    }
+    return result;
+}
+
+const char *QPlaceIndexOffline::string(quint32 offset) const
+{
+    if (offset >= m_stringSize)
+        return "";
+    return reinterpret_cast<const char *>(m_strings + offset);
+}
+
+QT_END_NAMESPACE
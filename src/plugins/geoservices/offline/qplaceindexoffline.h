@@ -0,0 +1,113 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLACEINDEXOFFLINE_H
+#define QPLACEINDEXOFFLINE_H
+
+#include "qofflineindex.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+
+QT_BEGIN_NAMESPACE
+
+struct QPlaceOfflinePoi
+{
+    QString placeId;
+    QString name;
+    QGeoCoordinate coordinate;
+    QStringList categoryIds;
+    QString address;
+};
+
+/*
+    Collects points of interest and serializes them into the binary index format read by
+    QPlaceIndexOffline. Points are ordered along a Morton curve over a fixed lat/lon grid,
+    so each grid cell maps to one contiguous range of records.
+
+    Case folded words of the name and address, and category ids prefixed with \\x01
+    (including the "key" parent of "key=value" ids) share a single sorted token table, each
+    with a sorted posting list of record numbers. Place ids are kept in a separate sorted
+    table for details lookups.
+*/
+class QPlaceIndexOfflineBuilder
+{
+public:
+    void addPoi(const QPlaceOfflinePoi &poi);
+    int addGeoJson(const QVariantList &importedGeoJson);
+
+    qsizetype size() const;
+    QByteArray build() const;
+    bool write(const QString &fileName, QString *errorString = nullptr) const;
+
+private:
+    void addFeature(const QVariantMap &feature);
+
+    QList<QPlaceOfflinePoi> m_pois;
+};
+
+class QPlaceIndexOffline
+{
+public:
+    QPlaceIndexOffline();
+    ~QPlaceIndexOffline();
+
+    bool open(const QString &fileName, QString *errorString = nullptr);
+    bool setData(const QByteArray &data, QString *errorString = nullptr);
+    bool isValid() const;
+
+    quint32 count() const;
+    QPlaceOfflinePoi poi(quint32 index) const;
+    QGeoCoordinate coordinate(quint32 index) const;
+    QString name(quint32 index) const;
+
+    QList<quint32> withinBox(const QGeoRectangle &box) const;
+    QList<quint32> matchingToken(const QString &token) const;
+    QList<quint32> matchingPrefix(const QString &prefix, qsizetype limit) const;
+    QList<quint32> inCategory(const QString &categoryId) const;
+    qint64 find(const QString &placeId) const;
+    QStringList categoryIds() const;
+
+    static QStringList tokenize(const QString &text);
+    static QList<quint32> intersect(const QList<quint32> &a, const QList<quint32> &b);
+    static QList<quint32> unite(const QList<quint32> &a, const QList<quint32> &b);
+
+private:
+    Q_DISABLE_COPY(QPlaceIndexOffline)
+
+    bool load(const uchar *data, qint64 size, QString *errorString);
+    void close();
+
+    qint64 lowerBoundToken(const QByteArray &token) const;
+    QByteArray tokenAt(qint64 index) const;
+    QList<quint32> postings(qint64 tokenIndex) const;
+    const char *string(quint32 offset) const;
+    void appendCell(quint32 cell, const QGeoRectangle &box, QList<quint32> *result) const;
+    void appendBox(const QGeoRectangle &box, QList<quint32> *result) const;
+
+    QOfflineIndexData m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+
+    quint32 m_poiCount = 0;
+    quint32 m_cellCount = 0;
+    quint32 m_tokenCount = 0;
+    quint32 m_idCount = 0;
+    const uchar *m_pois = nullptr;
+    const uchar *m_cells = nullptr;
+    const uchar *m_tokens = nullptr;
+    const uchar *m_postings = nullptr;
+    const uchar *m_ids = nullptr;
+    const uchar *m_strings = nullptr;
+    quint64 m_postingCount = 0;
+    quint64 m_stringSize = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEINDEXOFFLINE_H
@@ -0,0 +1,400 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplacemanagerengineoffline.h"
+#include "qplacerepliesoffline.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QLocale>
+#include <QtCore/QSet>
+#include <QtCore/QtMath>
+
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+
+#include <QtLocation/QPlace>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/private/qgeojson_p.h>
+#include <QtLocation/private/qplacesearchrequest_p.h>
+
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+const int MaxSuggestions = 10;
+
+QString categoryName(const QString &categoryId)
+{
+    QString name = categoryId.section(QLatin1Char('='), -1);
+    name.replace(QLatin1Char('_'), QLatin1Char(' '));
+    if (!name.isEmpty())
+        name[0] = name.at(0).toUpper();
+    return name;
+}
+
+// Squared equirectangular distance, only used to order candidates.
+double approximateDistance(const QGeoCoordinate &from, const QGeoCoordinate &to)
+{
+    const double x = (to.longitude() - from.longitude())
+            * std::cos(qDegreesToRadians((from.latitude() + to.latitude()) / 2.0));
+    const double y = to.latitude() - from.latitude();
+    return x * x + y * y;
+}
+}
+
+QPlaceManagerEngineOffline::QPlaceManagerEngineOffline(const QVariantMap &parameters,
+                                                       QGeoServiceProvider::Error *error,
+                                                       QString *errorString)
+:   QPlaceManagerEngine(parameters)
+{
+    if (parameters.contains(QStringLiteral("offline.places.page_size"))
+            && parameters.value(QStringLiteral("offline.places.page_size")).canConvert<int>())
+        m_pageSize = qMax(1, parameters.value(QStringLiteral("offline.places.page_size")).toInt());
+
+    const QString indexFile = parameters.value(QStringLiteral("offline.places.index")).toString();
+    const QString geoJsonFile = parameters.value(QStringLiteral("offline.places.geojson")).toString();
+
+    if (indexFile.isEmpty() && geoJsonFile.isEmpty()) {
+        *error = QGeoServiceProvider::MissingRequiredParameterError;
+        *errorString = tr("Either offline.places.index or offline.places.geojson is required");
+        return;
+    }
+
+    if (!geoJsonFile.isEmpty()) {
+        QFile file(geoJsonFile);
+        if (!file.open(QIODevice::ReadOnly)) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = file.errorString();
+            return;
+        }
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (document.isNull()) {
+            *error = QGeoServiceProvider::LoaderError;
+            *errorString = parseError.errorString();
+            return;
+        }
+
+        QPlaceIndexOfflineBuilder builder;
+        builder.addGeoJson(QGeoJson::importGeoJson(document));
+
+        // the built index is stored in offline.places.index when given, so later
+        // runs can map it directly
+        bool ok;
+        if (indexFile.isEmpty())
+            ok = m_index.setData(builder.build(), errorString);
+        else
+            ok = builder.write(indexFile, errorString) && m_index.open(indexFile, errorString);
+        if (!ok) {
+            *error = QGeoServiceProvider::LoaderError;
+            return;
+        }
+    } else if (!m_index.open(indexFile, errorString)) {
+        *error = QGeoServiceProvider::LoaderError;
+        return;
+    }
+
+    *error = QGeoServiceProvider::NoError;
+    errorString->clear();
+}
+
+QPlaceManagerEngineOffline::~QPlaceManagerEngineOffline()
+{
+}
+
+QPlaceDetailsReply *QPlaceManagerEngineOffline::getPlaceDetails(const QString &placeId)
+{
+    QPlaceDetailsReplyOffline *reply = new QPlaceDetailsReplyOffline(this);
+    connect(reply, &QPlaceDetailsReplyOffline::finished,
+            this, &QPlaceManagerEngineOffline::replyFinished);
+    connect(reply, &QPlaceDetailsReplyOffline::errorOccurred,
+            this, &QPlaceManagerEngineOffline::replyError);
+
+    const qint64 index = m_index.find(placeId);
+    if (index < 0) {
+        reply->failLater(QPlaceReply::PlaceDoesNotExistError,
+                         tr("Place %1 does not exist").arg(placeId));
+    } else {
+        reply->setPlace(place(quint32(index)));
+        reply->finishLater();
+    }
+    return reply;
+}
+
+QPlaceSearchReply *QPlaceManagerEngineOffline::search(const QPlaceSearchRequest &request)
+{
+    bool unsupported = false;
+
+    // Only public visibility supported
+    unsupported |= request.visibilityScope() != QLocation::UnspecifiedVisibility &&
+                   request.visibilityScope() != QLocation::PublicVisibility;
+    unsupported |= !request.recommendationId().isEmpty();
+    unsupported |= request.searchTerm().isEmpty() && request.categories().isEmpty()
+                   && !request.searchArea().isValid();
+
+    if (unsupported)
+        return QPlaceManagerEngine::search(request);
+
+    QList<quint32> matches = candidates(request);
+
+    const int limit = request.limit() > 0 ? request.limit() : m_pageSize;
+    const int page = qMax(0, QPlaceSearchRequestPrivate::get(request)->page);
+    const qsizetype offset = qMin(qsizetype(page) * limit, matches.size());
+    const qsizetype end = qMin(offset + limit, matches.size());
+
+    const QGeoCoordinate center = request.searchArea().center();
+    if (request.relevanceHint() == QPlaceSearchRequest::LexicalPlaceNameHint) {
+        QList<std::pair<QString, quint32>> named;
+        named.reserve(matches.size());
+        for (quint32 index : std::as_const(matches))
+            named.append(std::make_pair(m_index.name(index), index));
+        std::partial_sort(named.begin(), named.begin() + end, named.end());
+        for (qsizetype i = 0; i < end; ++i)
+            matches[i] = named.at(i).second;
+    } else if (center.isValid()) {
+        QList<std::pair<double, quint32>> distances;
+        distances.reserve(matches.size());
+        for (quint32 index : std::as_const(matches))
+            distances.append(std::make_pair(approximateDistance(center, m_index.coordinate(index)),
+                                            index));
+        std::partial_sort(distances.begin(), distances.begin() + end, distances.end());
+        for (qsizetype i = 0; i < end; ++i)
+            matches[i] = distances.at(i).second;
+    }
+
+    QList<QPlaceSearchResult> results;
+    results.reserve(end - offset);
+    for (qsizetype i = offset; i < end; ++i) {
+        QPlaceResult result;
+        result.setPlace(place(matches.at(i)));
+        result.setTitle(result.place().name());
+        if (center.isValid())
+            result.setDistance(center.distanceTo(result.place().location().coordinate()));
+        results.append(result);
+    }
+
+    QPlaceSearchReplyOffline *reply = new QPlaceSearchReplyOffline(request, this);
+    connect(reply, &QPlaceSearchReplyOffline::finished,
+            this, &QPlaceManagerEngineOffline::replyFinished);
+    connect(reply, &QPlaceSearchReplyOffline::errorOccurred,
+            this, &QPlaceManagerEngineOffline::replyError);
+    reply->setResults(results);
+
+    if (offset > 0) {
+        QPlaceSearchRequest r = request;
+        QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(r);
+        rpimpl->related = true;
+        rpimpl->page = page - 1;
+        reply->setPreviousPageRequest(r);
+    }
+
+    if (end < matches.size()) {
+        QPlaceSearchRequest r = request;
+        QPlaceSearchRequestPrivate *rpimpl = QPlaceSearchRequestPrivate::get(r);
+        rpimpl->related = true;
+        rpimpl->page = page + 1;
+        reply->setNextPageRequest(r);
+    }
+
+    reply->finishLater();
+    return reply;
+}
+
+QPlaceSearchSuggestionReply *QPlaceManagerEngineOffline::searchSuggestions(
+        const QPlaceSearchRequest &request)
+{
+    QPlaceSearchSuggestionReplyOffline *reply = new QPlaceSearchSuggestionReplyOffline(this);
+    connect(reply, &QPlaceSearchSuggestionReplyOffline::finished,
+            this, &QPlaceManagerEngineOffline::replyFinished);
+    connect(reply, &QPlaceSearchSuggestionReplyOffline::errorOccurred,
+            this, &QPlaceManagerEngineOffline::replyError);
+
+    // complete the last word of the search term, the preceding words must match exactly
+    const QStringList words = QPlaceIndexOffline::tokenize(request.searchTerm());
+    QStringList suggestions;
+    if (!words.isEmpty() && !request.searchTerm().back().isSpace()) {
+        QList<quint32> matches = m_index.matchingPrefix(words.last(), MaxSuggestions * 4);
+        for (qsizetype i = 0; i < words.size() - 1 && !matches.isEmpty(); ++i)
+            matches = QPlaceIndexOffline::intersect(matches, m_index.matchingToken(words.at(i)));
+
+        const QGeoShape area = request.searchArea();
+        QSet<QString> seen;
+        for (quint32 index : std::as_const(matches)) {
+            if (area.isValid() && !area.contains(m_index.coordinate(index)))
+                continue;
+            const QString name = m_index.name(index);
+            if (name.isEmpty() || seen.contains(name))
+                continue;
+            seen.insert(name);
+            suggestions.append(name);
+            if (suggestions.size() == MaxSuggestions)
+                break;
+        }
+    }
+
+    reply->setSuggestions(suggestions);
+    reply->finishLater();
+    return reply;
+}
+
+QPlaceReply *QPlaceManagerEngineOffline::initializeCategories()
+{
+    // the category tree is fixed by the index, build it once
+    if (m_categories.isEmpty()) {
+        const QStringList categoryIds = m_index.categoryIds();
+        for (const QString &categoryId : categoryIds) {
+            const QString parentId = categoryId.contains(QLatin1Char('='))
+                    ? categoryId.section(QLatin1Char('='), 0, 0)
+                    : QString();
+
+            QPlaceCategory category;
+            category.setCategoryId(categoryId);
+            category.setName(categoryName(categoryId));
+            category.setVisibility(QLocation::PublicVisibility);
+            m_categories.insert(categoryId, category);
+            m_subcategories[parentId].append(categoryId);
+        }
+    }
+
+    QPlaceCategoriesReplyOffline *reply = new QPlaceCategoriesReplyOffline(this);
+    connect(reply, &QPlaceCategoriesReplyOffline::finished,
+            this, &QPlaceManagerEngineOffline::replyFinished);
+    connect(reply, &QPlaceCategoriesReplyOffline::errorOccurred,
+            this, &QPlaceManagerEngineOffline::replyError);
+    reply->finishLater();
+    return reply;
+}
+
+QString QPlaceManagerEngineOffline::parentCategoryId(const QString &categoryId) const
+{
+    if (!categoryId.contains(QLatin1Char('=')))
+        return QString();
+    return categoryId.section(QLatin1Char('='), 0, 0);
+}
+
+QStringList QPlaceManagerEngineOffline::childCategoryIds(const QString &categoryId) const
+{
+    return m_subcategories.value(categoryId);
+}
+
+QPlaceCategory QPlaceManagerEngineOffline::category(const QString &categoryId) const
+{
+    return m_categories.value(categoryId);
+}
+
+QList<QPlaceCategory> QPlaceManagerEngineOffline::childCategories(const QString &parentId) const
+{
+    QList<QPlaceCategory> categories;
+    for (const QString &id : m_subcategories.value(parentId))
+        categories.append(m_categories.value(id));
+    return categories;
+}
+
+QList<QLocale> QPlaceManagerEngineOffline::locales() const
+{
+    return m_locales;
+}
+
+void QPlaceManagerEngineOffline::setLocales(const QList<QLocale> &locales)
+{
+    m_locales = locales;
+}
+
+void QPlaceManagerEngineOffline::replyFinished()
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit finished(reply);
+}
+
+void QPlaceManagerEngineOffline::replyError(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    QPlaceReply *reply = qobject_cast<QPlaceReply *>(sender());
+    if (reply)
+        emit errorOccurred(reply, errorCode, errorString);
+}
+
+/*
+    Returns the sorted record numbers matching all words of the search term, any of the
+    requested categories and the search area. The posting lists are intersected first,
+    the search area is only tested against the remaining candidates.
+*/
+QList<quint32> QPlaceManagerEngineOffline::candidates(const QPlaceSearchRequest &request) const
+{
+    QList<quint32> result;
+    bool constrained = false;
+
+    const QStringList words = QPlaceIndexOffline::tokenize(request.searchTerm());
+    for (const QString &word : words) {
+        const QList<quint32> matches = m_index.matchingToken(word);
+        result = constrained ? QPlaceIndexOffline::intersect(result, matches) : matches;
+        constrained = true;
+        if (result.isEmpty())
+            return result;
+    }
+    if (!request.searchTerm().isEmpty() && words.isEmpty())
+        return result;
+
+    if (!request.categories().isEmpty()) {
+        QList<quint32> inCategories;
+        for (const QPlaceCategory &category : request.categories())
+            inCategories = QPlaceIndexOffline::unite(inCategories,
+                                                     m_index.inCategory(category.categoryId()));
+        result = constrained ? QPlaceIndexOffline::intersect(result, inCategories) : inCategories;
+        constrained = true;
+    }
+
+    const QGeoShape area = request.searchArea();
+    if (!area.isValid())
+        return result;
+
+    if (!constrained) {
+        result = m_index.withinBox(area.boundingGeoRectangle());
+        if (area.type() == QGeoShape::RectangleType)
+            return result;
+    }
+
+    result.erase(std::remove_if(result.begin(), result.end(), [&](quint32 index) {
+                     return !area.contains(m_index.coordinate(index));
+                 }), result.end());
+    return result;
+}
+
+QPlace QPlaceManagerEngineOffline::place(quint32 index) const
+{
+    const QPlaceOfflinePoi poi = m_index.poi(index);
+
+    QGeoAddress address;
+    address.setText(poi.address);
+
+    QGeoLocation location;
+    location.setCoordinate(poi.coordinate);
+    location.setAddress(address);
+
+    QList<QPlaceCategory> categories;
+    for (const QString &categoryId : poi.categoryIds) {
+        QPlaceCategory category = m_categories.value(categoryId);
+        if (category.categoryId().isEmpty()) {
+            category.setCategoryId(categoryId);
+            category.setName(categoryName(categoryId));
+        }
+        categories.append(category);
+    }
+
+    QPlace place;
+    place.setPlaceId(poi.placeId);
+    place.setName(poi.name);
+    place.setLocation(location);
+    place.setCategories(categories);
+    place.setVisibility(QLocation::PublicVisibility);
+    place.setDetailsFetched(true);
+    return place;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,57 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLACEMANAGERENGINEOFFLINE_H
+#define QPLACEMANAGERENGINEOFFLINE_H
+
+#include "qplaceindexoffline.h"
+
+#include <QtCore/QHash>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QPlaceCategory>
+#include <QtLocation/QPlaceManagerEngine>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaceManagerEngineOffline : public QPlaceManagerEngine
+{
+    Q_OBJECT
+
+public:
+    QPlaceManagerEngineOffline(const QVariantMap &parameters, QGeoServiceProvider::Error *error,
+                               QString *errorString);
+    ~QPlaceManagerEngineOffline();
+
+    QPlaceDetailsReply *getPlaceDetails(const QString &placeId) override;
+    QPlaceSearchReply *search(const QPlaceSearchRequest &request) override;
+    QPlaceSearchSuggestionReply *searchSuggestions(const QPlaceSearchRequest &request) override;
+
+    QPlaceReply *initializeCategories() override;
+    QString parentCategoryId(const QString &categoryId) const override;
+    QStringList childCategoryIds(const QString &categoryId) const override;
+    QPlaceCategory category(const QString &categoryId) const override;
+
+    QList<QPlaceCategory> childCategories(const QString &parentId) const override;
+
+    QList<QLocale> locales() const override;
+    void setLocales(const QList<QLocale> &locales) override;
+
+private slots:
+    void replyFinished();
+    void replyError(QPlaceReply::Error errorCode, const QString &errorString);
+
+private:
+    QList<quint32> candidates(const QPlaceSearchRequest &request) const;
+    QPlace place(quint32 index) const;
+
+    QPlaceIndexOffline m_index;
+    QList<QLocale> m_locales;
+    int m_pageSize = 20;
+
+    QHash<QString, QPlaceCategory> m_categories;
+    QHash<QString, QStringList> m_subcategories;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEMANAGERENGINEOFFLINE_H
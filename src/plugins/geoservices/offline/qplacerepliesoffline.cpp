@@ -0,0 +1,134 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplacerepliesoffline.h"
+
+#include <QtLocation/QPlace>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/QPlaceSearchResult>
+
+QT_BEGIN_NAMESPACE
+
+QPlaceSearchReplyOffline::QPlaceSearchReplyOffline(const QPlaceSearchRequest &request,
+                                                   QObject *parent)
+:   QPlaceSearchReply(parent)
+{
+    setRequest(request);
+}
+
+QPlaceSearchReplyOffline::~QPlaceSearchReplyOffline()
+{
+}
+
+void QPlaceSearchReplyOffline::setResults(const QList<QPlaceSearchResult> &results)
+{
+    QPlaceSearchReply::setResults(results);
+}
+
+void QPlaceSearchReplyOffline::setPreviousPageRequest(const QPlaceSearchRequest &previous)
+{
+    QPlaceSearchReply::setPreviousPageRequest(previous);
+}
+
+void QPlaceSearchReplyOffline::setNextPageRequest(const QPlaceSearchRequest &next)
+{
+    QPlaceSearchReply::setNextPageRequest(next);
+}
+
+void QPlaceSearchReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QPlaceSearchReplyOffline::emitFinished()
+{
+    setFinished(true);
+    emit finished();
+}
+
+QPlaceDetailsReplyOffline::QPlaceDetailsReplyOffline(QObject *parent)
+:   QPlaceDetailsReply(parent)
+{
+}
+
+QPlaceDetailsReplyOffline::~QPlaceDetailsReplyOffline()
+{
+}
+
+void QPlaceDetailsReplyOffline::setPlace(const QPlace &place)
+{
+    QPlaceDetailsReply::setPlace(place);
+}
+
+void QPlaceDetailsReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QPlaceDetailsReplyOffline::failLater(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    QMetaObject::invokeMethod(this, "emitError", Qt::QueuedConnection,
+                              Q_ARG(QPlaceReply::Error, errorCode),
+                              Q_ARG(QString, errorString));
+}
+
+void QPlaceDetailsReplyOffline::emitFinished()
+{
+    setFinished(true);
+    emit finished();
+}
+
+void QPlaceDetailsReplyOffline::emitError(QPlaceReply::Error errorCode, const QString &errorString)
+{
+    setError(errorCode, errorString);
+    emit errorOccurred(errorCode, errorString);
+    setFinished(true);
+    emit finished();
+}
+
+QPlaceSearchSuggestionReplyOffline::QPlaceSearchSuggestionReplyOffline(QObject *parent)
+:   QPlaceSearchSuggestionReply(parent)
+{
+}
+
+QPlaceSearchSuggestionReplyOffline::~QPlaceSearchSuggestionReplyOffline()
+{
+}
+
+void QPlaceSearchSuggestionReplyOffline::setSuggestions(const QStringList &suggestions)
+{
+    QPlaceSearchSuggestionReply::setSuggestions(suggestions);
+}
+
+void QPlaceSearchSuggestionReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QPlaceSearchSuggestionReplyOffline::emitFinished()
+{
+    setFinished(true);
+    emit finished();
+}
+
+QPlaceCategoriesReplyOffline::QPlaceCategoriesReplyOffline(QObject *parent)
+:   QPlaceReply(parent)
+{
+}
+
+QPlaceCategoriesReplyOffline::~QPlaceCategoriesReplyOffline()
+{
+}
+
+void QPlaceCategoriesReplyOffline::finishLater()
+{
+    QMetaObject::invokeMethod(this, "emitFinished", Qt::QueuedConnection);
+}
+
+void QPlaceCategoriesReplyOffline::emitFinished()
+{
+    setFinished(true);
+    emit finished();
+}
+
+QT_END_NAMESPACE
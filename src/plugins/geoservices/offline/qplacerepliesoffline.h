@@ -0,0 +1,86 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLACEREPLIESOFFLINE_H
+#define QPLACEREPLIESOFFLINE_H
+
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchSuggestionReply>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The offline replies are answered synchronously from the local index, but finished() is
+    only emitted from the event loop so that callers can connect to the reply first.
+*/
+
+class QPlaceSearchReplyOffline : public QPlaceSearchReply
+{
+    Q_OBJECT
+
+public:
+    QPlaceSearchReplyOffline(const QPlaceSearchRequest &request, QObject *parent = nullptr);
+    ~QPlaceSearchReplyOffline();
+
+    void setResults(const QList<QPlaceSearchResult> &results);
+    void setPreviousPageRequest(const QPlaceSearchRequest &previous);
+    void setNextPageRequest(const QPlaceSearchRequest &next);
+
+    void finishLater();
+
+private slots:
+    void emitFinished();
+};
+
+class QPlaceDetailsReplyOffline : public QPlaceDetailsReply
+{
+    Q_OBJECT
+
+public:
+    explicit QPlaceDetailsReplyOffline(QObject *parent = nullptr);
+    ~QPlaceDetailsReplyOffline();
+
+    void setPlace(const QPlace &place);
+
+    void finishLater();
+    void failLater(QPlaceReply::Error errorCode, const QString &errorString);
+
+private slots:
+    void emitFinished();
+    void emitError(QPlaceReply::Error errorCode, const QString &errorString);
+};
+
+class QPlaceSearchSuggestionReplyOffline : public QPlaceSearchSuggestionReply
+{
+    Q_OBJECT
+
+public:
+    explicit QPlaceSearchSuggestionReplyOffline(QObject *parent = nullptr);
+    ~QPlaceSearchSuggestionReplyOffline();
+
+    void setSuggestions(const QStringList &suggestions);
+
+    void finishLater();
+
+private slots:
+    void emitFinished();
+};
+
+class QPlaceCategoriesReplyOffline : public QPlaceReply
+{
+    Q_OBJECT
+
+public:
+    explicit QPlaceCategoriesReplyOffline(QObject *parent = nullptr);
+    ~QPlaceCategoriesReplyOffline();
+
+    void finishLater();
+
+private slots:
+    void emitFinished();
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLACEREPLIESOFFLINE_H
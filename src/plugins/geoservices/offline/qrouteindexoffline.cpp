@@ -0,0 +1,1819 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qrouteindexoffline.h"
+
+#include <QtCore/QSaveFile>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QtMath>
+
+#include <QtPositioning/QGeoPath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+using QOfflineIndex::align;
+using QOfflineIndex::append;
+using QOfflineIndex::fits;
+using QOfflineIndex::get;
+using QOfflineIndex::LocalProjection;
+using QOfflineIndex::MetersPerDegree;
+using QOfflineIndex::put;
+using QOfflineIndex::segmentDistance;
+
+namespace
+{
+const char IndexMagic[8] = { 'Q', 'R', 'T', 'I', 'D', 'X', '0', '1' };
+const quint32 IndexVersion = 1;
+
+// 2^16 columns and rows, cells are about 300 m high and at most 600 m wide
+const int GridBits = 16;
+const int GridSize = 1 << GridBits;
+
+const int HeaderSize = 128 + QRouteIndexOffline::ProfileCount * 16;
+const int NodeSize = 8;
+const int ArcSize = 8;
+const int EdgeSize = 32;
+const int VertexSize = 8;
+const int CellRecordSize = 12;
+const int EntrySize = 8;
+const int HierarchyArcSize = 20;
+
+const quint32 NoArc = 0xffffffff;
+const quint32 NoNode = 0xffffffff;
+const quint32 ReversedArc = 0x80000000;
+
+// witness searches give up after settling this many nodes and add the shortcut instead,
+// which keeps contraction fast at the price of a few unnecessary shortcuts
+const int WitnessSettleLimit = 500;
+
+const double EarthRadius = 6371008.8;
+const double Infinity = std::numeric_limits<double>::infinity();
+
+/*
+    The header is a fixed 176 byte block, all values little endian:
+
+    0   magic           8 bytes
+    8   version         u32
+    12  nodeCount       u32
+    16  edgeCount       u32
+    20  cellCount       u32
+    24  maximumSpeeds   3 x u8, km/h of the fastest edge of each profile
+    27  reserved        5 bytes
+    32  nodeOffset      u64     nodeCount x { i32 lat*1e7, i32 lon*1e7 }
+    40  arcIndexOffset  u64     (nodeCount + 1) x u32 first arc of each node
+    48  arcOffset       u64     { u32 target node, u32 edge, bit 31 set when the arc runs
+                                  against the vertex order of the edge }
+    56  arcCount        u64
+    64  edgeOffset      u64     edgeCount x { u32 from node, u32 to node, u32 first vertex,
+                                              u32 vertex count, u32 length in decimeters,
+                                              u32 name, u8 access, u8 features,
+                                              3 x u8 speed in km/h, 3 bytes reserved }
+    72  vertexOffset    u64     { i32 lat*1e7, i32 lon*1e7 }
+    80  vertexCount     u64
+    88  cellOffset      u64     cellCount x { u32 morton key, u32 first entry, u32 count }
+    96  entryOffset     u64     { u32 edge, u32 segment of the edge }
+    104 entryCount      u64
+    112 stringOffset    u64     null terminated UTF-8 strings, offset 0 is the empty string
+    120 stringSize      u64
+    128 hierarchies     3 x { u64 offset, u64 arcCount }, for the car, bicycle and
+                        pedestrian profiles
+
+    Each hierarchy holds (nodeCount + 1) x u32 indexes of the arcs leading up from each
+    node, the same for the arcs leading down to each node, both 8 byte aligned, and then
+    arcCount x { u32 from, u32 to, u32 weight in deciseconds, u32 first, u32 second }.
+    Shortcuts refer to the two hierarchy arcs they replace, original arcs have second set
+    to 0xffffffff and first set to the road graph arc.
+*/
+
+// access bits of an edge, forward meaning in the order of its vertices
+enum Access {
+    CarForward = 0x01,
+    CarBackward = 0x02,
+    BicycleForward = 0x04,
+    BicycleBackward = 0x08,
+    PedestrianForward = 0x10,
+    PedestrianBackward = 0x20,
+    ForwardAccess = CarForward | BicycleForward | PedestrianForward,
+    BackwardAccess = CarBackward | BicycleBackward | PedestrianBackward
+};
+
+quint8 accessBit(int profile, bool forward)
+{
+    return quint8(1 << (2 * profile + (forward ? 0 : 1)));
+}
+
+struct RoadClass
+{
+    const char *highway;
+    quint8 speeds[QRouteIndexOffline::ProfileCount];
+    quint8 features;
+};
+
+// default speeds in km/h for cars, bicycles and pedestrians, 0 where not allowed
+const RoadClass RoadClasses[] = {
+    { "motorway", { 110, 0, 0 }, QRouteIndexOffline::HighwayEdge },
+    { "motorway_link", { 60, 0, 0 }, QRouteIndexOffline::HighwayEdge },
+    { "trunk", { 90, 16, 5 }, QRouteIndexOffline::HighwayEdge },
+    { "trunk_link", { 50, 16, 5 }, QRouteIndexOffline::HighwayEdge },
+    { "primary", { 70, 16, 5 }, 0 },
+    { "primary_link", { 40, 16, 5 }, 0 },
+    { "secondary", { 60, 16, 5 }, 0 },
+    { "secondary_link", { 40, 16, 5 }, 0 },
+    { "tertiary", { 50, 16, 5 }, 0 },
+    { "tertiary_link", { 30, 16, 5 }, 0 },
+    { "unclassified", { 40, 16, 5 }, 0 },
+    { "residential", { 30, 16, 5 }, 0 },
+    { "road", { 30, 16, 5 }, 0 },
+    { "living_street", { 10, 12, 5 }, 0 },
+    { "service", { 15, 14, 5 }, 0 },
+    { "track", { 15, 12, 5 }, QRouteIndexOffline::UnpavedEdge },
+    { "cycleway", { 0, 18, 5 }, 0 },
+    { "path", { 0, 12, 5 }, 0 },
+    { "footway", { 0, 6, 5 }, 0 },
+    { "pedestrian", { 0, 6, 5 }, 0 },
+    { "bridleway", { 0, 0, 5 }, 0 },
+    { "steps", { 0, 0, 2 }, 0 }
+};
+
+const quint8 FerrySpeed = 20;
+// speeds used when a tag allows a mode on a road class that does not allow it by default
+const quint8 FallbackSpeeds[QRouteIndexOffline::ProfileCount] = { 20, 12, 5 };
+
+// returns -1 when the first of \a keys present in \a tags denies access, 1 when it allows
+// access and 0 when none of them is set
+int accessTag(const QVariantMap &tags, std::initializer_list<const char *> keys)
+{
+    for (const char *key : keys) {
+        const QString value = tags.value(QLatin1String(key)).toString();
+        if (value.isEmpty())
+            continue;
+        if (value == QLatin1String("no") || value == QLatin1String("private")
+                || value == QLatin1String("agricultural") || value == QLatin1String("forestry")
+                || value == QLatin1String("dismount")) {
+            return -1;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+bool isYes(const QString &value)
+{
+    return value == QLatin1String("yes") || value == QLatin1String("true")
+            || value == QLatin1String("1");
+}
+
+// the leading number of a maxspeed tag in km/h, or 0
+int maximumSpeed(const QString &value)
+{
+    qsizetype digits = 0;
+    while (digits < value.size() && value.at(digits).isDigit())
+        ++digits;
+    const int speed = QStringView(value).left(digits).toInt();
+    if (value.contains(QLatin1String("mph")))
+        return qRound(speed * 1.609344);
+    return speed;
+}
+
+qint32 fixed(double degrees)
+{
+    return qint32(qRound(degrees * 1e7));
+}
+
+quint64 vertexKey(qint32 latitude, qint32 longitude)
+{
+    return (quint64(quint32(latitude)) << 32) | quint32(longitude);
+}
+
+// great circle distance in meters, used both for edge lengths and for the A* estimate so
+// that the estimate never exceeds the length of a path
+double distance(qint32 lat1, qint32 lon1, qint32 lat2, qint32 lon2)
+{
+    const double phi1 = qDegreesToRadians(lat1 / 1e7);
+    const double phi2 = qDegreesToRadians(lat2 / 1e7);
+    const double deltaPhi = phi2 - phi1;
+    const double deltaLambda = qDegreesToRadians(
+                QOfflineIndex::wrapLongitude(lon2 / 1e7 - lon1 / 1e7));
+    const double a = std::sin(deltaPhi / 2) * std::sin(deltaPhi / 2)
+            + std::cos(phi1) * std::cos(phi2)
+            * std::sin(deltaLambda / 2) * std::sin(deltaLambda / 2);
+    return 2.0 * EarthRadius * std::asin(qMin(1.0, std::sqrt(a)));
+}
+
+// travel time in deciseconds of \a length decimeters at \a speed km/h
+quint32 edgeTravelTime(quint32 length, int speed)
+{
+    return quint32(qBound(qint64(1), qRound64(length * 3.6 / speed), qint64(0x7fffffff)));
+}
+
+int gridX(double longitude)
+{
+    return qBound(0, int(std::floor((longitude + 180.0) / 360.0 * GridSize)), GridSize - 1);
+}
+
+int gridY(double latitude)
+{
+    return qBound(0, int(std::floor((latitude + 90.0) / 180.0 * GridSize)), GridSize - 1);
+}
+
+quint32 cellKey(int x, int y)
+{
+    return QOfflineIndex::morton(quint32(x), quint32(y), GridBits);
+}
+
+qsizetype alignedSize(quint64 size)
+{
+    return qsizetype((size + 7) & ~quint64(7));
+}
+
+// Liang-Barsky clipping of the segment against the rectangle, in degrees
+bool segmentIntersects(const QGeoRectangle &rectangle, double lat1, double lon1,
+                       double lat2, double lon2)
+{
+    const double left = rectangle.topLeft().longitude();
+    const double right = rectangle.bottomRight().longitude();
+    const double top = rectangle.topLeft().latitude();
+    const double bottom = rectangle.bottomRight().latitude();
+    if (left > right) {
+        // crosses the antimeridian, only test the end points
+        return rectangle.contains(QGeoCoordinate(lat1, lon1))
+                || rectangle.contains(QGeoCoordinate(lat2, lon2));
+    }
+
+    const double dx = lon2 - lon1;
+    const double dy = lat2 - lat1;
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { lon1 - left, right - lon1, lat1 - bottom, top - lat1 };
+    double t0 = 0.0;
+    double t1 = 1.0;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0)
+                return false;
+            continue;
+        }
+        const double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+            if (t > t1)
+                return false;
+            t0 = qMax(t0, t);
+        } else {
+            if (t < t0)
+                return false;
+            t1 = qMin(t1, t);
+        }
+    }
+    return true;
+}
+
+/*
+    Contracts the graph of one profile. Nodes are contracted in order of the number of
+    shortcuts their removal adds minus the arcs it removes, with a bias towards spreading
+    contraction evenly, and priorities are updated lazily.
+*/
+class ContractionHierarchy
+{
+public:
+    explicit ContractionHierarchy(quint32 nodeCount)
+        : m_out(nodeCount), m_in(nodeCount), m_up(nodeCount), m_down(nodeCount),
+          m_contracted(nodeCount, false), m_contractedNeighbours(nodeCount, 0),
+          m_level(nodeCount, 0), m_distance(nodeCount, std::numeric_limits<quint64>::max())
+    {
+    }
+
+    void addArc(quint32 from, quint32 to, quint32 weight, quint32 graphArc)
+    {
+        if (from == to)
+            return;
+        for (quint32 index : m_out[from]) {
+            Arc &arc = m_arcs[index];
+            if (arc.to == to) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.first = graphArc;
+                }
+                return;
+            }
+        }
+        insertArc({ from, to, weight, graphArc, NoArc });
+    }
+
+    void contract()
+    {
+        const quint32 nodeCount = quint32(m_out.size());
+        using Entry = std::pair<int, quint32>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::vector<int> priorities(nodeCount);
+        for (quint32 node = 0; node < nodeCount; ++node) {
+            priorities[node] = priority(node);
+            queue.push(std::make_pair(priorities[node], node));
+        }
+
+        std::vector<quint32> neighbours;
+        while (!queue.empty()) {
+            const Entry entry = queue.top();
+            queue.pop();
+            const quint32 node = entry.second;
+            if (m_contracted[node] || entry.first != priorities[node])
+                continue;
+
+            // lazy update, the priority may have grown since it was queued
+            const int current = priority(node);
+            if (current > entry.first && !queue.empty() && current > queue.top().first) {
+                priorities[node] = current;
+                queue.push(std::make_pair(current, node));
+                continue;
+            }
+
+            process(node, true);
+            m_contracted[node] = true;
+
+            neighbours.clear();
+            for (quint32 index : m_in[node]) {
+                const quint32 from = m_arcs[index].from;
+                removeFrom(m_out[from], index);
+                m_down[node].push_back(index);
+                neighbours.push_back(from);
+            }
+            for (quint32 index : m_out[node]) {
+                const quint32 to = m_arcs[index].to;
+                removeFrom(m_in[to], index);
+                m_up[node].push_back(index);
+                neighbours.push_back(to);
+            }
+            std::vector<quint32>().swap(m_in[node]);
+            std::vector<quint32>().swap(m_out[node]);
+
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (quint32 neighbour : neighbours) {
+                ++m_contractedNeighbours[neighbour];
+                m_level[neighbour] = qMax(m_level[neighbour], m_level[node] + 1);
+                priorities[neighbour] = priority(neighbour);
+                queue.push(std::make_pair(priorities[neighbour], neighbour));
+            }
+        }
+    }
+
+    // the up and down arc indexes followed by the arcs, see the format description
+    QByteArray serialize(quint64 *arcCount) const
+    {
+        const quint32 nodeCount = quint32(m_out.size());
+        std::vector<quint32> renumbered(m_arcs.size(), NoArc);
+        QByteArray upIndex;
+        QByteArray downIndex;
+        quint32 next = 0;
+        for (quint32 node = 0; node < nodeCount; ++node) {
+            append<quint32>(upIndex, next);
+            for (quint32 index : m_up[node])
+                renumbered[index] = next++;
+        }
+        append<quint32>(upIndex, next);
+        for (quint32 node = 0; node < nodeCount; ++node) {
+            append<quint32>(downIndex, next);
+            for (quint32 index : m_down[node])
+                renumbered[index] = next++;
+        }
+        append<quint32>(downIndex, next);
+
+        QByteArray data = upIndex;
+        align(data);
+        data.append(downIndex);
+        align(data);
+        data.reserve(data.size() + qsizetype(next) * HierarchyArcSize);
+        const auto appendArcs = [&](const std::vector<std::vector<quint32>> &lists) {
+            for (const std::vector<quint32> &list : lists) {
+                for (quint32 index : list) {
+                    const Arc &arc = m_arcs[index];
+                    append<quint32>(data, arc.from);
+                    append<quint32>(data, arc.to);
+                    append<quint32>(data, arc.weight);
+                    if (arc.second == NoArc) {
+                        append<quint32>(data, arc.first);
+                        append<quint32>(data, NoArc);
+                    } else {
+                        append<quint32>(data, renumbered[arc.first]);
+                        append<quint32>(data, renumbered[arc.second]);
+                    }
+                }
+            }
+        };
+        appendArcs(m_up);
+        appendArcs(m_down);
+        *arcCount = next;
+        return data;
+    }
+
+private:
+    struct Arc
+    {
+        quint32 from;
+        quint32 to;
+        quint32 weight;
+        quint32 first;
+        quint32 second;
+    };
+
+    void insertArc(const Arc &arc)
+    {
+        const quint32 index = quint32(m_arcs.size());
+        m_arcs.push_back(arc);
+        m_out[arc.from].push_back(index);
+        m_in[arc.to].push_back(index);
+    }
+
+    static void removeFrom(std::vector<quint32> &list, quint32 index)
+    {
+        const auto it = std::find(list.begin(), list.end(), index);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+
+    void addShortcut(quint32 from, quint32 to, quint32 weight, quint32 first, quint32 second)
+    {
+        for (quint32 index : m_out[from]) {
+            if (m_arcs[index].to != to)
+                continue;
+            if (m_arcs[index].weight <= weight)
+                return;
+            // the replaced arc never makes it into the hierarchy
+            removeFrom(m_out[from], index);
+            removeFrom(m_in[to], index);
+            break;
+        }
+        insertArc({ from, to, weight, first, second });
+    }
+
+    int priority(quint32 node)
+    {
+        const int shortcuts = process(node, false);
+        const int removed = int(m_in[node].size() + m_out[node].size());
+        return 2 * (shortcuts - removed) + m_contractedNeighbours[node] + m_level[node];
+    }
+
+    // Returns the number of shortcuts contracting \a node needs, and adds them if \a apply
+    // is set.
+    int process(quint32 node, bool apply)
+    {
+        int shortcuts = 0;
+        for (qsizetype i = 0; i < qsizetype(m_in[node].size()); ++i) {
+            const quint32 incoming = m_in[node][i];
+            const quint32 source = m_arcs[incoming].from;
+            const quint64 incomingWeight = m_arcs[incoming].weight;
+
+            quint64 maximum = 0;
+            for (quint32 outgoing : m_out[node]) {
+                if (m_arcs[outgoing].to != source)
+                    maximum = qMax(maximum, incomingWeight + m_arcs[outgoing].weight);
+            }
+            if (maximum == 0)
+                continue;
+
+            witnessSearch(source, node, maximum);
+            for (qsizetype j = 0; j < qsizetype(m_out[node].size()); ++j) {
+                const quint32 outgoing = m_out[node][j];
+                const quint32 target = m_arcs[outgoing].to;
+                if (target == source)
+                    continue;
+                const quint64 via = incomingWeight + m_arcs[outgoing].weight;
+                if (m_distance[target] <= via)
+                    continue;
+                ++shortcuts;
+                if (apply) {
+                    addShortcut(source, target, quint32(qMin(via, quint64(0x7fffffff))),
+                                incoming, outgoing);
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    // Dijkstra from \a source avoiding \a excluded, up to \a maximum or the settle limit.
+    // Distances left in m_distance are lengths of real paths, so they are valid witnesses
+    // even if the search stopped early.
+    void witnessSearch(quint32 source, quint32 excluded, quint64 maximum)
+    {
+        for (quint32 node : m_touched)
+            m_distance[node] = std::numeric_limits<quint64>::max();
+        m_touched.clear();
+
+        using Entry = std::pair<quint64, quint32>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        m_distance[source] = 0;
+        m_touched.push_back(source);
+        queue.push(std::make_pair(0, source));
+
+        int settled = 0;
+        while (!queue.empty()) {
+            const Entry entry = queue.top();
+            queue.pop();
+            if (entry.first > m_distance[entry.second])
+                continue;
+            if (entry.first > maximum || ++settled > WitnessSettleLimit)
+                break;
+            for (quint32 index : m_out[entry.second]) {
+                const Arc &arc = m_arcs[index];
+                if (arc.to == excluded)
+                    continue;
+                const quint64 distance = entry.first + arc.weight;
+                if (distance < m_distance[arc.to]) {
+                    if (m_distance[arc.to] == std::numeric_limits<quint64>::max())
+                        m_touched.push_back(arc.to);
+                    m_distance[arc.to] = distance;
+                    queue.push(std::make_pair(distance, arc.to));
+                }
+            }
+        }
+    }
+
+    std::vector<Arc> m_arcs;
+    std::vector<std::vector<quint32>> m_out;
+    std::vector<std::vector<quint32>> m_in;
+    std::vector<std::vector<quint32>> m_up;
+    std::vector<std::vector<quint32>> m_down;
+    std::vector<bool> m_contracted;
+    std::vector<int> m_contractedNeighbours;
+    std::vector<int> m_level;
+    std::vector<quint64> m_distance;
+    std::vector<quint32> m_touched;
+};
+}
+
+/*
+    Adds the way along \a path with the Open Street Map \a tags, such as highway, oneway,
+    maxspeed, access and name. Returns false if the way cannot be used by any profile.
+*/
+bool QRouteIndexOfflineBuilder::addWay(const QList<QGeoCoordinate> &path, const QVariantMap &tags)
+{
+    if (path.size() < 2)
+        return false;
+
+    const QString highway = tags.value(QStringLiteral("highway")).toString();
+    const bool ferry = tags.value(QStringLiteral("route")).toString() == QLatin1String("ferry");
+
+    quint8 speeds[QRouteIndexOffline::ProfileCount] = {};
+    quint8 features = 0;
+    if (ferry) {
+        std::fill(std::begin(speeds), std::end(speeds), FerrySpeed);
+        features |= QRouteIndexOffline::FerryEdge;
+    } else {
+        const auto roadClass = std::find_if(std::begin(RoadClasses), std::end(RoadClasses),
+                                            [&highway](const RoadClass &candidate) {
+            return highway == QLatin1String(candidate.highway);
+        });
+        if (roadClass == std::end(RoadClasses))
+            return false;
+        std::copy(std::begin(roadClass->speeds), std::end(roadClass->speeds), speeds);
+        features |= roadClass->features;
+    }
+
+    const int access[QRouteIndexOffline::ProfileCount] = {
+        accessTag(tags, { "motorcar", "motor_vehicle", "vehicle", "access" }),
+        accessTag(tags, { "bicycle", "vehicle", "access" }),
+        accessTag(tags, { "foot", "access" })
+    };
+    for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile) {
+        if (access[profile] < 0)
+            speeds[profile] = 0;
+        else if (access[profile] > 0 && speeds[profile] == 0)
+            speeds[profile] = FallbackSpeeds[profile];
+    }
+    const int limit = maximumSpeed(tags.value(QStringLiteral("maxspeed")).toString());
+    if (limit > 0 && speeds[QRouteIndexOffline::CarProfile] > 0 && !ferry)
+        speeds[QRouteIndexOffline::CarProfile] = quint8(qBound(5, limit, 130));
+
+    const QString oneway = tags.value(QStringLiteral("oneway")).toString();
+    const QString junction = tags.value(QStringLiteral("junction")).toString();
+    const bool roundabout = junction == QLatin1String("roundabout")
+            || junction == QLatin1String("circular");
+    int direction = 0;
+    if (isYes(oneway))
+        direction = 1;
+    else if (oneway == QLatin1String("-1") || oneway == QLatin1String("reverse"))
+        direction = -1;
+    else if (oneway != QLatin1String("no") && (highway == QLatin1String("motorway") || roundabout))
+        direction = 1;
+    const bool bicycleContraflow =
+            tags.value(QStringLiteral("oneway:bicycle")).toString() == QLatin1String("no")
+            || tags.value(QStringLiteral("cycleway")).toString().startsWith(QLatin1String("opposite"));
+    const int directions[QRouteIndexOffline::ProfileCount] = {
+        direction, bicycleContraflow ? 0 : direction, 0
+    };
+
+    quint8 accessBits = 0;
+    for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile) {
+        if (speeds[profile] == 0)
+            continue;
+        if (directions[profile] >= 0)
+            accessBits |= accessBit(profile, true);
+        if (directions[profile] <= 0)
+            accessBits |= accessBit(profile, false);
+    }
+    if (accessBits == 0)
+        return false;
+
+    if (isYes(tags.value(QStringLiteral("toll")).toString()))
+        features |= QRouteIndexOffline::TollEdge;
+    const QString tunnel = tags.value(QStringLiteral("tunnel")).toString();
+    if (!tunnel.isEmpty() && tunnel != QLatin1String("no"))
+        features |= QRouteIndexOffline::TunnelEdge;
+    static const char *const UnpavedSurfaces[] = {
+        "unpaved", "dirt", "gravel", "fine_gravel", "ground", "earth", "grass", "mud", "sand",
+        "compacted"
+    };
+    const QString surface = tags.value(QStringLiteral("surface")).toString();
+    for (const char *unpaved : UnpavedSurfaces) {
+        if (surface == QLatin1String(unpaved))
+            features |= QRouteIndexOffline::UnpavedEdge;
+    }
+    if (roundabout)
+        features |= QRouteIndexOffline::RoundaboutEdge;
+
+    for (const QGeoCoordinate &coordinate : path) {
+        if (!coordinate.isValid())
+            return false;
+    }
+
+    QString name = tags.value(QStringLiteral("name")).toString();
+    if (name.isEmpty())
+        name = tags.value(QStringLiteral("ref")).toString();
+    quint32 nameIndex = 0;
+    if (!name.isEmpty()) {
+        const auto it = m_nameIndex.constFind(name);
+        if (it != m_nameIndex.constEnd()) {
+            nameIndex = it.value();
+        } else {
+            m_names.append(name);
+            nameIndex = quint32(m_names.size());
+            m_nameIndex.insert(name, nameIndex);
+        }
+    }
+
+    Way way;
+    way.firstVertex = quint32(m_vertices.size() / 2);
+    way.vertexCount = quint32(path.size());
+    way.name = nameIndex;
+    way.access = accessBits;
+    way.features = features;
+    std::copy(std::begin(speeds), std::end(speeds), way.speeds);
+    for (const QGeoCoordinate &coordinate : path) {
+        m_vertices.push_back(fixed(coordinate.latitude()));
+        m_vertices.push_back(fixed(coordinate.longitude()));
+    }
+    m_ways.push_back(way);
+    return true;
+}
+
+/*
+    Adds the line strings of the imported GeoJSON that carry a highway property, or are
+    ferry routes. Ways are connected where they share a vertex. Returns the number of
+    ways added.
+*/
+int QRouteIndexOfflineBuilder::addGeoJson(const QVariantList &importedGeoJson)
+{
+    int count = 0;
+    for (const QVariant &item : importedGeoJson) {
+        const QVariantMap map = item.toMap();
+        const QString type = map.value(QStringLiteral("type")).toString();
+        if (type == QLatin1String("FeatureCollection")
+                || type == QLatin1String("GeometryCollection")) {
+            count += addGeoJson(map.value(QStringLiteral("data")).toList());
+        } else {
+            count += addFeature(map);
+        }
+    }
+    return count;
+}
+
+int QRouteIndexOfflineBuilder::addFeature(const QVariantMap &feature)
+{
+    const QString type = feature.value(QStringLiteral("type")).toString();
+    const QVariant data = feature.value(QStringLiteral("data"));
+    const QVariantMap properties = feature.value(QStringLiteral("properties")).toMap();
+
+    if (type == QLatin1String("LineString"))
+        return addWay(data.value<QGeoPath>().path(), properties) ? 1 : 0;
+
+    int count = 0;
+    if (type == QLatin1String("MultiLineString")) {
+        const QVariantList lines = data.toList();
+        for (const QVariant &line : lines) {
+            if (addWay(line.toMap().value(QStringLiteral("data")).value<QGeoPath>().path(),
+                       properties)) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+qsizetype QRouteIndexOfflineBuilder::size() const
+{
+    return qsizetype(m_ways.size());
+}
+
+QByteArray QRouteIndexOfflineBuilder::build() const
+{
+    // Vertices shared by several ways, or ending one, become nodes. End points are
+    // counted twice so that a single occurrence is enough.
+    std::vector<quint64> keys;
+    keys.reserve(m_vertices.size() / 2 + 2 * m_ways.size());
+    for (const Way &way : m_ways) {
+        for (quint32 i = 0; i < way.vertexCount; ++i) {
+            const qsizetype vertex = 2 * qsizetype(way.firstVertex + i);
+            keys.push_back(vertexKey(m_vertices[vertex], m_vertices[vertex + 1]));
+            if (i == 0 || i + 1 == way.vertexCount)
+                keys.push_back(keys.back());
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<quint64> nodeKeys;
+    for (size_t i = 0; i + 1 < keys.size(); ++i) {
+        if (keys[i] == keys[i + 1] && (nodeKeys.empty() || nodeKeys.back() != keys[i]))
+            nodeKeys.push_back(keys[i]);
+    }
+    std::vector<quint64>().swap(keys);
+    const quint32 nodeCount = quint32(nodeKeys.size());
+
+    // store nodes along a Morton curve, so that a search touches few pages of the file
+    std::vector<std::pair<quint32, quint32>> order(nodeCount);
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        const qint32 latitude = qint32(nodeKeys[i] >> 32);
+        const qint32 longitude = qint32(quint32(nodeKeys[i]));
+        const quint32 x = quint32(gridX(longitude / 1e7));
+        const quint32 y = quint32(gridY(latitude / 1e7));
+        order[i] = std::make_pair(QOfflineIndex::morton(x, y, GridBits), i);
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<quint32> nodeIds(nodeCount);
+    QByteArray nodes;
+    nodes.reserve(qsizetype(nodeCount) * NodeSize);
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        const quint64 key = nodeKeys[order[i].second];
+        nodeIds[order[i].second] = i;
+        append<qint32>(nodes, qint32(key >> 32));
+        append<qint32>(nodes, qint32(quint32(key)));
+    }
+    std::vector<std::pair<quint32, quint32>>().swap(order);
+
+    const auto nodeId = [&](qint32 latitude, qint32 longitude) -> quint32 {
+        const quint64 key = vertexKey(latitude, longitude);
+        const auto it = std::lower_bound(nodeKeys.cbegin(), nodeKeys.cend(), key);
+        if (it == nodeKeys.cend() || *it != key)
+            return NoNode;
+        return nodeIds[size_t(it - nodeKeys.cbegin())];
+    };
+
+    // split the ways into edges at the nodes
+    struct Edge
+    {
+        quint32 from;
+        quint32 to;
+        quint32 firstVertex;
+        quint32 vertexCount;
+        quint32 length;
+        const Way *way;
+    };
+    std::vector<Edge> edges;
+    QByteArray vertices;
+    quint64 vertexCount = 0;
+    quint8 maximumSpeeds[QRouteIndexOffline::ProfileCount] = {};
+    for (const Way &way : m_ways) {
+        for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile)
+            maximumSpeeds[profile] = qMax(maximumSpeeds[profile], way.speeds[profile]);
+
+        const qint32 *vertex = m_vertices.data() + 2 * qsizetype(way.firstVertex);
+        quint32 start = 0;
+        double length = 0.0;
+        for (quint32 i = 1; i < way.vertexCount; ++i) {
+            length += distance(vertex[2 * i - 2], vertex[2 * i - 1], vertex[2 * i], vertex[2 * i + 1]);
+            const quint32 node = nodeId(vertex[2 * i], vertex[2 * i + 1]);
+            if (node == NoNode)
+                continue;
+
+            Edge edge;
+            edge.from = nodeId(vertex[2 * start], vertex[2 * start + 1]);
+            edge.to = node;
+            edge.firstVertex = quint32(vertexCount);
+            edge.vertexCount = i - start + 1;
+            edge.length = quint32(qMin(qRound64(length * 10.0), qint64(0xffffffff)));
+            edge.way = &way;
+            edges.push_back(edge);
+            for (quint32 j = start; j <= i; ++j) {
+                append<qint32>(vertices, vertex[2 * j]);
+                append<qint32>(vertices, vertex[2 * j + 1]);
+            }
+            vertexCount += edge.vertexCount;
+            start = i;
+            length = 0.0;
+        }
+    }
+    std::vector<quint64>().swap(nodeKeys);
+    std::vector<quint32>().swap(nodeIds);
+    const quint32 edgeCount = quint32(edges.size());
+
+    QByteArray strings(1, '\0');
+    std::vector<quint32> nameOffsets(size_t(m_names.size()) + 1, 0);
+    for (qsizetype i = 0; i < m_names.size(); ++i) {
+        nameOffsets[size_t(i) + 1] = quint32(strings.size());
+        strings.append(m_names.at(i).toUtf8());
+        strings.append('\0');
+    }
+
+    QByteArray edgeTable;
+    edgeTable.reserve(qsizetype(edgeCount) * EdgeSize);
+    for (const Edge &edge : edges) {
+        append<quint32>(edgeTable, edge.from);
+        append<quint32>(edgeTable, edge.to);
+        append<quint32>(edgeTable, edge.firstVertex);
+        append<quint32>(edgeTable, edge.vertexCount);
+        append<quint32>(edgeTable, edge.length);
+        append<quint32>(edgeTable, nameOffsets[edge.way->name]);
+        append<quint8>(edgeTable, edge.way->access);
+        append<quint8>(edgeTable, edge.way->features);
+        for (quint8 speed : edge.way->speeds)
+            append<quint8>(edgeTable, speed);
+        edgeTable.append(3, '\0');
+    }
+
+    // the road graph, both directions of each edge as far as any profile may use them
+    std::vector<quint32> arcIndex(size_t(nodeCount) + 1, 0);
+    for (const Edge &edge : edges) {
+        if (edge.way->access & ForwardAccess)
+            ++arcIndex[edge.from + 1];
+        if (edge.way->access & BackwardAccess)
+            ++arcIndex[edge.to + 1];
+    }
+    for (quint32 node = 0; node < nodeCount; ++node)
+        arcIndex[node + 1] += arcIndex[node];
+    const quint64 arcCount = arcIndex[nodeCount];
+    std::vector<std::pair<quint32, quint32>> arcs(arcCount);
+    {
+        std::vector<quint32> next(arcIndex.cbegin(), arcIndex.cend() - 1);
+        for (quint32 index = 0; index < edgeCount; ++index) {
+            const Edge &edge = edges[index];
+            if (edge.way->access & ForwardAccess)
+                arcs[next[edge.from]++] = std::make_pair(edge.to, index);
+            if (edge.way->access & BackwardAccess)
+                arcs[next[edge.to]++] = std::make_pair(edge.from, index | ReversedArc);
+        }
+    }
+    QByteArray arcIndexTable;
+    arcIndexTable.reserve(qsizetype(arcIndex.size()) * 4);
+    for (quint32 first : arcIndex)
+        append<quint32>(arcIndexTable, first);
+    QByteArray arcTable;
+    arcTable.reserve(qsizetype(arcCount) * ArcSize);
+    for (const auto &arc : arcs) {
+        append<quint32>(arcTable, arc.first);
+        append<quint32>(arcTable, arc.second);
+    }
+
+    QByteArray hierarchies[QRouteIndexOffline::ProfileCount];
+    quint64 hierarchyArcCounts[QRouteIndexOffline::ProfileCount] = {};
+    for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile) {
+        ContractionHierarchy hierarchy(nodeCount);
+        for (quint32 node = 0; node < nodeCount; ++node) {
+            for (quint32 index = arcIndex[node]; index < arcIndex[node + 1]; ++index) {
+                const Edge &edge = edges[arcs[index].second & ~ReversedArc];
+                const bool forward = !(arcs[index].second & ReversedArc);
+                const quint8 speed = edge.way->speeds[profile];
+                if (speed == 0 || !(edge.way->access & accessBit(profile, forward)))
+                    continue;
+                hierarchy.addArc(node, arcs[index].first, edgeTravelTime(edge.length, speed), index);
+            }
+        }
+        hierarchy.contract();
+        hierarchies[profile] = hierarchy.serialize(&hierarchyArcCounts[profile]);
+    }
+
+    // register every edge segment in the cells it crosses, sampled at half a cell
+    std::vector<std::pair<quint32, std::pair<quint32, quint32>>> entries;
+    const uchar *vertexData = reinterpret_cast<const uchar *>(vertices.constData());
+    for (quint32 index = 0; index < edgeCount; ++index) {
+        const Edge &edge = edges[index];
+        for (quint32 segment = 0; segment + 1 < edge.vertexCount; ++segment) {
+            const uchar *a = vertexData + qsizetype(edge.firstVertex + segment) * VertexSize;
+            const uchar *b = a + VertexSize;
+            const double ax = (get<qint32>(a + 4) / 1e7 + 180.0) / 360.0 * GridSize;
+            const double ay = (get<qint32>(a) / 1e7 + 90.0) / 180.0 * GridSize;
+            double bx = (get<qint32>(b + 4) / 1e7 + 180.0) / 360.0 * GridSize;
+            const double by = (get<qint32>(b) / 1e7 + 90.0) / 180.0 * GridSize;
+            if (std::abs(bx - ax) > GridSize / 2)
+                bx = ax; // crosses the antimeridian, only register the start cell
+            const int steps = int(std::ceil(qMax(std::abs(bx - ax), std::abs(by - ay)) * 2)) + 1;
+            for (int step = 0; step <= steps; ++step) {
+                const double t = double(step) / steps;
+                const int x = qBound(0, int(std::floor(ax + (bx - ax) * t)), GridSize - 1);
+                const int y = qBound(0, int(std::floor(ay + (by - ay) * t)), GridSize - 1);
+                entries.push_back(std::make_pair(cellKey(x, y), std::make_pair(index, segment)));
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    QByteArray cells;
+    QByteArray entryTable;
+    entryTable.reserve(qsizetype(entries.size()) * EntrySize);
+    quint32 cellCount = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i == 0 || entries[i].first != entries[i - 1].first) {
+            append<quint32>(cells, entries[i].first);
+            append<quint32>(cells, quint32(i));
+            append<quint32>(cells, 0);
+            ++cellCount;
+        }
+        const qsizetype countOffset = cells.size() - 4;
+        put<quint32>(cells, countOffset,
+                     get<quint32>(reinterpret_cast<const uchar *>(cells.constData()) + countOffset)
+                     + 1);
+        append<quint32>(entryTable, entries[i].second.first);
+        append<quint32>(entryTable, entries[i].second.second);
+    }
+
+    QByteArray index(HeaderSize, '\0');
+    memcpy(index.data(), IndexMagic, sizeof(IndexMagic));
+    put<quint32>(index, 8, IndexVersion);
+    put<quint32>(index, 12, nodeCount);
+    put<quint32>(index, 16, edgeCount);
+    put<quint32>(index, 20, cellCount);
+    for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile)
+        index[24 + profile] = char(maximumSpeeds[profile]);
+
+    const auto section = [&index](int offsetField, const QByteArray &data) {
+        put<quint64>(index, offsetField, quint64(index.size()));
+        index.append(data);
+        align(index);
+    };
+    section(32, nodes);
+    section(40, arcIndexTable);
+    section(48, arcTable);
+    put<quint64>(index, 56, arcCount);
+    section(64, edgeTable);
+    section(72, vertices);
+    put<quint64>(index, 80, vertexCount);
+    section(88, cells);
+    section(96, entryTable);
+    put<quint64>(index, 104, quint64(entries.size()));
+    section(112, strings);
+    put<quint64>(index, 120, quint64(strings.size()));
+    for (int profile = 0; profile < QRouteIndexOffline::ProfileCount; ++profile) {
+        section(128 + profile * 16, hierarchies[profile]);
+        put<quint64>(index, 136 + profile * 16, hierarchyArcCounts[profile]);
+    }
+
+    return index;
+}
+
+bool QRouteIndexOfflineBuilder::write(const QString &fileName, QString *errorString) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    file.write(build());
+    if (!file.commit()) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+/*
+    Returns true if the weighting does not change the costs the hierarchies were built
+    with, so that a query can use them.
+*/
+bool QRouteIndexOffline::Weighting::isDefault() const
+{
+    if (shortest || !excludedAreas.isEmpty() || !penalties.isEmpty())
+        return false;
+    return std::all_of(std::begin(featureFactors), std::end(featureFactors),
+                       [](double factor) { return factor == 1.0; });
+}
+
+QRouteIndexOffline::QRouteIndexOffline()
+{
+}
+
+QRouteIndexOffline::~QRouteIndexOffline()
+{
+    close();
+}
+
+/*
+    Memory maps the index file \a fileName. The file stays mapped, and therefore open,
+    for the lifetime of the index.
+*/
+bool QRouteIndexOffline::open(const QString &fileName, QString *errorString)
+{
+    close();
+    if (!m_file.open(fileName, errorString))
+        return false;
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/*
+    Uses the in-memory index \a data, as produced by QRouteIndexOfflineBuilder::build().
+*/
+bool QRouteIndexOffline::setData(const QByteArray &data, QString *errorString)
+{
+    close();
+    m_file.setData(data);
+    if (!load(m_file.data(), m_file.size(), errorString)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool QRouteIndexOffline::isValid() const
+{
+    return m_data != nullptr;
+}
+
+bool QRouteIndexOffline::load(const uchar *data, qint64 size, QString *errorString)
+{
+    const auto fail = [errorString](const char *message) {
+        if (errorString)
+            *errorString = QString::fromLatin1(message);
+        return false;
+    };
+
+    if (size < HeaderSize || memcmp(data, IndexMagic, sizeof(IndexMagic)) != 0)
+        return fail("Not a routing index file");
+    if (get<quint32>(data + 8) != IndexVersion)
+        return fail("Unsupported routing index version");
+
+    m_nodeCount = get<quint32>(data + 12);
+    m_edgeCount = get<quint32>(data + 16);
+    m_cellCount = get<quint32>(data + 20);
+    for (int profile = 0; profile < ProfileCount; ++profile)
+        m_maximumSpeeds[profile] = data[24 + profile];
+    const quint64 nodeOffset = get<quint64>(data + 32);
+    const quint64 arcIndexOffset = get<quint64>(data + 40);
+    const quint64 arcOffset = get<quint64>(data + 48);
+    m_arcCount = get<quint64>(data + 56);
+    const quint64 edgeOffset = get<quint64>(data + 64);
+    const quint64 vertexOffset = get<quint64>(data + 72);
+    m_vertexCount = get<quint64>(data + 80);
+    const quint64 cellOffset = get<quint64>(data + 88);
+    const quint64 entryOffset = get<quint64>(data + 96);
+    m_entryCount = get<quint64>(data + 104);
+    const quint64 stringOffset = get<quint64>(data + 112);
+    m_stringSize = get<quint64>(data + 120);
+
+    const quint64 fileSize = quint64(size);
+    const quint64 indexSize = alignedSize((quint64(m_nodeCount) + 1) * 4);
+    if (!fits(fileSize, nodeOffset, m_nodeCount, NodeSize)
+            || !fits(fileSize, arcIndexOffset, indexSize, 1)
+            || !fits(fileSize, arcOffset, m_arcCount, ArcSize)
+            || !fits(fileSize, edgeOffset, m_edgeCount, EdgeSize)
+            || !fits(fileSize, vertexOffset, m_vertexCount, VertexSize)
+            || !fits(fileSize, cellOffset, m_cellCount, CellRecordSize)
+            || !fits(fileSize, entryOffset, m_entryCount, EntrySize)
+            || !fits(fileSize, stringOffset, m_stringSize, 1)
+            || m_stringSize == 0 || data[stringOffset + m_stringSize - 1] != '\0'
+            || get<quint32>(data + arcIndexOffset + quint64(m_nodeCount) * 4) != m_arcCount) {
+        return fail("Truncated routing index file");
+    }
+
+    for (int profile = 0; profile < ProfileCount; ++profile) {
+        const quint64 offset = get<quint64>(data + 128 + profile * 16);
+        const quint64 arcCount = get<quint64>(data + 136 + profile * 16);
+        if (!fits(fileSize, offset, 2, indexSize)
+                || !fits(fileSize, offset + 2 * indexSize, arcCount, HierarchyArcSize)) {
+            return fail("Truncated routing index file");
+        }
+        Hierarchy &hierarchy = m_hierarchies[profile];
+        hierarchy.arcCount = arcCount;
+        hierarchy.upIndex = data + offset;
+        hierarchy.downIndex = hierarchy.upIndex + indexSize;
+        hierarchy.arcs = hierarchy.downIndex + indexSize;
+        if (get<quint32>(hierarchy.downIndex + quint64(m_nodeCount) * 4) != arcCount)
+            return fail("Truncated routing index file");
+    }
+
+    m_data = data;
+    m_nodes = data + nodeOffset;
+    m_arcIndex = data + arcIndexOffset;
+    m_arcs = data + arcOffset;
+    m_edges = data + edgeOffset;
+    m_vertices = data + vertexOffset;
+    m_cells = data + cellOffset;
+    m_entries = data + entryOffset;
+    m_strings = data + stringOffset;
+    return true;
+}
+
+void QRouteIndexOffline::close()
+{
+    m_file.close();
+    m_data = nullptr;
+    m_nodeCount = 0;
+    m_edgeCount = 0;
+    m_cellCount = 0;
+    m_arcCount = 0;
+    m_vertexCount = 0;
+    m_entryCount = 0;
+    m_stringSize = 0;
+    for (Hierarchy &hierarchy : m_hierarchies)
+        hierarchy = Hierarchy();
+}
+
+quint32 QRouteIndexOffline::nodeCount() const
+{
+    return m_nodeCount;
+}
+
+quint32 QRouteIndexOffline::edgeCount() const
+{
+    return m_edgeCount;
+}
+
+const uchar *QRouteIndexOffline::edge(quint32 index) const
+{
+    return m_edges + qsizetype(index) * EdgeSize;
+}
+
+double QRouteIndexOffline::edgeLength(quint32 edge) const
+{
+    if (edge >= m_edgeCount)
+        return 0.0;
+    return get<quint32>(this->edge(edge) + 16) / 10.0;
+}
+
+QString QRouteIndexOffline::edgeName(quint32 edge) const
+{
+    if (edge >= m_edgeCount)
+        return QString();
+    const quint32 offset = get<quint32>(this->edge(edge) + 20);
+    if (offset >= m_stringSize)
+        return QString();
+    return QString::fromUtf8(reinterpret_cast<const char *>(m_strings + offset));
+}
+
+quint8 QRouteIndexOffline::edgeFeatures(quint32 edge) const
+{
+    if (edge >= m_edgeCount)
+        return 0;
+    return this->edge(edge)[25];
+}
+
+bool QRouteIndexOffline::isAccessible(quint32 edge, bool forward, Profile profile) const
+{
+    const uchar *record = this->edge(edge);
+    return (record[24] & accessBit(profile, forward)) && record[26 + profile] > 0;
+}
+
+/*
+    Returns the cost of travelling the whole edge in deciseconds, or in meters for the
+    shortest route, or infinity if the edge cannot be travelled in that direction.
+    Without a \a weighting this is the weight the hierarchies were built with.
+*/
+double QRouteIndexOffline::edgeCost(quint32 edge, bool forward, Profile profile,
+                                    const Weighting *weighting,
+                                    QHash<quint32, bool> *excluded) const
+{
+    if (!isAccessible(edge, forward, profile))
+        return Infinity;
+
+    const uchar *record = this->edge(edge);
+    const quint32 length = get<quint32>(record + 16);
+    if (!weighting)
+        return edgeTravelTime(length, record[26 + profile]);
+
+    double cost = weighting->shortest ? length / 10.0 : edgeTravelTime(length, record[26 + profile]);
+    const quint8 features = record[25];
+    for (int feature = 0; feature < EdgeFeatureCount; ++feature) {
+        if (features & (1 << feature))
+            cost *= weighting->featureFactors[feature];
+    }
+    if (!qIsFinite(cost))
+        return Infinity;
+    cost *= weighting->penalties.value(edge, 1.0);
+
+    if (!weighting->excludedAreas.isEmpty()) {
+        auto it = excluded->find(edge);
+        if (it == excluded->end()) {
+            bool inside = false;
+            const quint64 first = get<quint32>(record + 8);
+            const quint32 count = get<quint32>(record + 12);
+            if (first + count <= m_vertexCount) {
+                const uchar *vertex = m_vertices + qsizetype(first) * VertexSize;
+                for (quint32 i = 0; i + 1 < count && !inside; ++i, vertex += VertexSize) {
+                    for (const QGeoRectangle &area : weighting->excludedAreas) {
+                        if (segmentIntersects(area, get<qint32>(vertex) / 1e7,
+                                              get<qint32>(vertex + 4) / 1e7,
+                                              get<qint32>(vertex + VertexSize) / 1e7,
+                                              get<qint32>(vertex + VertexSize + 4) / 1e7)) {
+                            inside = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            it = excluded->insert(edge, inside);
+        }
+        if (it.value())
+            return Infinity;
+    }
+    return cost;
+}
+
+/*
+    Returns the vertices of \a piece in travel order, starting and ending with the points
+    at its offsets.
+*/
+QList<QGeoCoordinate> QRouteIndexOffline::geometry(const Piece &piece) const
+{
+    QList<QGeoCoordinate> result;
+    if (!isValid() || piece.edge >= m_edgeCount)
+        return result;
+
+    const uchar *record = edge(piece.edge);
+    const quint64 first = get<quint32>(record + 8);
+    const quint32 count = get<quint32>(record + 12);
+    if (count < 2 || first + count > m_vertexCount)
+        return result;
+
+    const double low = qMin(piece.begin, piece.end);
+    const double high = qMax(piece.begin, piece.end);
+    const auto interpolate = [](const uchar *a, const uchar *b, double t) {
+        t = qBound(0.0, t, 1.0);
+        const double latitude = get<qint32>(a) / 1e7;
+        const double longitude = get<qint32>(a + 4) / 1e7;
+        const double deltaLongitude = QOfflineIndex::wrapLongitude(
+                    get<qint32>(b + 4) / 1e7 - longitude);
+        return QGeoCoordinate(latitude + (get<qint32>(b) / 1e7 - latitude) * t,
+                              QOfflineIndex::wrapLongitude(longitude + deltaLongitude * t));
+    };
+
+    double position = 0.0;
+    const uchar *vertex = m_vertices + qsizetype(first) * VertexSize;
+    for (quint32 i = 0; i + 1 < count; ++i, vertex += VertexSize) {
+        const uchar *next = vertex + VertexSize;
+        const double length = distance(get<qint32>(vertex), get<qint32>(vertex + 4),
+                                       get<qint32>(next), get<qint32>(next + 4));
+        const double end = position + length;
+        if (result.isEmpty() && end >= low)
+            result.append(interpolate(vertex, next, length > 0 ? (low - position) / length : 0.0));
+        if (!result.isEmpty()) {
+            if (end < high || (i + 2 == count && high >= end)) {
+                result.append(interpolate(vertex, next, 1.0));
+            } else {
+                result.append(interpolate(vertex, next,
+                                          length > 0 ? (high - position) / length : 1.0));
+                break;
+            }
+        }
+        position = end;
+    }
+    if (result.isEmpty()) {
+        // the offsets lie past the rounded length of the edge, at its last vertex
+        const uchar *last = m_vertices + qsizetype(first + count - 1) * VertexSize;
+        result.append(interpolate(last, last, 0.0));
+        result.append(result.first());
+    }
+
+    if (piece.end < piece.begin)
+        std::reverse(result.begin(), result.end());
+    return result;
+}
+
+/*
+    Returns the time in seconds it takes to travel \a piece.
+*/
+double QRouteIndexOffline::travelTime(const Piece &piece, Profile profile) const
+{
+    if (piece.edge >= m_edgeCount)
+        return 0.0;
+    const uchar *record = edge(piece.edge);
+    const quint32 length = get<quint32>(record + 16);
+    const quint8 speed = record[26 + profile];
+    if (length == 0 || speed == 0)
+        return 0.0;
+    const double fraction = qMin(std::abs(piece.end - piece.begin) / (length / 10.0), 1.0);
+    return fraction * edgeTravelTime(length, speed) / 10.0;
+}
+
+double QRouteIndexOffline::cost(const Piece &piece, Profile profile,
+                                const Weighting &weighting) const
+{
+    if (piece.edge >= m_edgeCount)
+        return 0.0;
+    const double length = edgeLength(piece.edge);
+    if (length <= 0.0)
+        return 0.0;
+    QHash<quint32, bool> excluded;
+    const double edgeCost = this->edgeCost(piece.edge, piece.end >= piece.begin, profile,
+                                           &weighting, &excluded);
+    return qMin(std::abs(piece.end - piece.begin) / length, 1.0) * edgeCost;
+}
+
+/*
+    Returns the point closest to \a coordinate, within \a maximumDistance meters, on an
+    edge that \a profile can travel in at least one direction.
+*/
+QRouteIndexOffline::Position QRouteIndexOffline::snap(const QGeoCoordinate &coordinate,
+                                                      Profile profile,
+                                                      double maximumDistance) const
+{
+    Position position;
+    if (!isValid() || !coordinate.isValid() || m_cellCount == 0)
+        return position;
+
+    const LocalProjection projection(coordinate);
+    const double cellHeight = 180.0 / GridSize * MetersPerDegree;
+    const double cellWidth = 360.0 / GridSize * projection.xScale;
+    const double cellSize = qMax(qMin(cellHeight, cellWidth), 1.0);
+    const int maximumRing = qMin(int(std::ceil(maximumDistance / cellSize)) + 1, 64);
+
+    const int cx = gridX(coordinate.longitude());
+    const int cy = gridY(coordinate.latitude());
+
+    double bestDistance = Infinity;
+    quint32 bestEdge = NoEdge;
+    quint32 bestSegment = 0;
+    double bestT = 0.0;
+    double bestX = 0.0;
+    double bestY = 0.0;
+
+    for (int ring = 0; ring <= maximumRing; ++ring) {
+        // everything in this ring is at least this far away
+        const double ringDistance = (ring - 1) * cellSize;
+        if (ringDistance > maximumDistance || ringDistance > bestDistance)
+            break;
+
+        for (int dy = -ring; dy <= ring; ++dy) {
+            const int y = cy + dy;
+            if (y < 0 || y >= GridSize)
+                continue;
+            const int step = (dy == -ring || dy == ring) ? 1 : 2 * ring;
+            for (int dx = -ring; dx <= ring; dx += qMax(step, 1)) {
+                const int x = (cx + dx + GridSize) % GridSize;
+                const quint32 key = cellKey(x, y);
+
+                quint32 low = 0;
+                quint32 high = m_cellCount;
+                while (low < high) {
+                    const quint32 mid = low + (high - low) / 2;
+                    if (get<quint32>(m_cells + qsizetype(mid) * CellRecordSize) < key)
+                        low = mid + 1;
+                    else
+                        high = mid;
+                }
+                if (low >= m_cellCount
+                        || get<quint32>(m_cells + qsizetype(low) * CellRecordSize) != key) {
+                    continue;
+                }
+
+                const uchar *cell = m_cells + qsizetype(low) * CellRecordSize;
+                const quint64 first = get<quint32>(cell + 4);
+                const quint64 count = get<quint32>(cell + 8);
+                for (quint64 i = first; i < first + count && i < m_entryCount; ++i) {
+                    const uchar *entry = m_entries + qsizetype(i) * EntrySize;
+                    const quint32 edgeIndex = get<quint32>(entry);
+                    const quint32 segment = get<quint32>(entry + 4);
+                    if (edgeIndex >= m_edgeCount)
+                        continue;
+                    if (!isAccessible(edgeIndex, true, profile)
+                            && !isAccessible(edgeIndex, false, profile)) {
+                        continue;
+                    }
+                    const uchar *record = edge(edgeIndex);
+                    const quint64 vertex = quint64(get<quint32>(record + 8)) + segment;
+                    if (segment + 1 >= get<quint32>(record + 12) || vertex + 1 >= m_vertexCount)
+                        continue;
+
+                    const uchar *a = m_vertices + qsizetype(vertex) * VertexSize;
+                    const uchar *b = a + VertexSize;
+                    double ax, ay, bx, by, px, py;
+                    projection.project(get<qint32>(a), get<qint32>(a + 4), &ax, &ay);
+                    projection.project(get<qint32>(b), get<qint32>(b + 4), &bx, &by);
+                    const double distance = segmentDistance(ax, ay, bx, by, &px, &py);
+                    if (distance < bestDistance) {
+                        const double length = std::hypot(bx - ax, by - ay);
+                        bestDistance = distance;
+                        bestEdge = edgeIndex;
+                        bestSegment = segment;
+                        bestT = length > 0 ? std::hypot(px - ax, py - ay) / length : 0.0;
+                        bestX = px;
+                        bestY = py;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestEdge == NoEdge || bestDistance > maximumDistance)
+        return position;
+
+    const uchar *record = edge(bestEdge);
+    const uchar *vertex = m_vertices + qsizetype(get<quint32>(record + 8)) * VertexSize;
+    double offset = 0.0;
+    for (quint32 i = 0; i <= bestSegment; ++i, vertex += VertexSize) {
+        const uchar *next = vertex + VertexSize;
+        const double length = distance(get<qint32>(vertex), get<qint32>(vertex + 4),
+                                       get<qint32>(next), get<qint32>(next + 4));
+        offset += i == bestSegment ? bestT * length : length;
+    }
+
+    position.edge = bestEdge;
+    position.offset = qMin(offset, edgeLength(bestEdge));
+    position.coordinate = projection.unproject(bestX, bestY);
+    return position;
+}
+
+/*
+    Returns the nodes at the ends of the edge of \a position with the cost of reaching
+    them from it, or of reaching it from them if \a source is false.
+*/
+QList<QRouteIndexOffline::Endpoint> QRouteIndexOffline::endpoints(
+        const Position &position, bool source, Profile profile, const Weighting *weighting,
+        QHash<quint32, bool> *excluded) const
+{
+    QList<Endpoint> result;
+    const uchar *record = edge(position.edge);
+    const quint32 from = get<quint32>(record);
+    const quint32 to = get<quint32>(record + 4);
+    const double length = edgeLength(position.edge);
+    const double offset = qBound(0.0, position.offset, length);
+    const double ahead = length > 0 ? (length - offset) / length : 0.0;
+    const double behind = length > 0 ? offset / length : 0.0;
+
+    // a position on a node reaches it for free, whatever the direction of the edge
+    const double forward = edgeCost(position.edge, true, profile, weighting, excluded);
+    const double backward = edgeCost(position.edge, false, profile, weighting, excluded);
+    const bool atFrom = behind <= 0.0;
+    const bool atTo = ahead <= 0.0;
+    if (source) {
+        if (qIsFinite(forward) || atTo)
+            result.append({ to, atTo ? 0.0 : forward * ahead, { position.edge, offset, length } });
+        if (qIsFinite(backward) || atFrom)
+            result.append({ from, atFrom ? 0.0 : backward * behind, { position.edge, offset, 0.0 } });
+    } else {
+        if (qIsFinite(forward) || atFrom)
+            result.append({ from, atFrom ? 0.0 : forward * behind, { position.edge, 0.0, offset } });
+        if (qIsFinite(backward) || atTo)
+            result.append({ to, atTo ? 0.0 : backward * ahead, { position.edge, length, offset } });
+    }
+    return result;
+}
+
+// the cost of going from \a from to \a to along their edge, if both are on the same one
+double QRouteIndexOffline::directCost(const Position &from, const Position &to, Profile profile,
+                                      const Weighting *weighting,
+                                      QHash<quint32, bool> *excluded) const
+{
+    if (from.edge != to.edge)
+        return Infinity;
+    const double length = edgeLength(from.edge);
+    const double fraction = length > 0 ? std::abs(to.offset - from.offset) / length : 0.0;
+    const double cost = edgeCost(from.edge, to.offset >= from.offset, profile, weighting,
+                                 excluded);
+    return qIsFinite(cost) ? cost * fraction : Infinity;
+}
+
+QRouteIndexOffline::Piece QRouteIndexOffline::arcPiece(quint32 arc) const
+{
+    const quint32 value = get<quint32>(m_arcs + qsizetype(arc) * ArcSize + 4);
+    const quint32 edge = value & ~ReversedArc;
+    const double length = edgeLength(edge);
+    if (value & ReversedArc)
+        return { edge, length, 0.0 };
+    return { edge, 0.0, length };
+}
+
+// appends the road graph arcs making up the hierarchy arc \a arc
+void QRouteIndexOffline::unpack(Profile profile, quint32 arc, QList<Piece> *pieces) const
+{
+    const Hierarchy &hierarchy = m_hierarchies[profile];
+    QVarLengthArray<quint32, 64> stack;
+    stack.append(arc);
+    while (!stack.isEmpty()) {
+        const quint32 index = stack.takeLast();
+        if (index >= hierarchy.arcCount)
+            continue;
+        const uchar *record = hierarchy.arcs + qsizetype(index) * HierarchyArcSize;
+        const quint32 first = get<quint32>(record + 12);
+        const quint32 second = get<quint32>(record + 16);
+        if (second == NoArc) {
+            if (first < m_arcCount)
+                pieces->append(arcPiece(first));
+        } else {
+            stack.append(second);
+            stack.append(first);
+        }
+    }
+}
+
+/*
+    Returns the fastest path between \a from and \a to for \a profile, found by a
+    bidirectional search that only climbs the contraction hierarchy.
+*/
+QRouteIndexOffline::Path QRouteIndexOffline::route(const Position &from, const Position &to,
+                                                   Profile profile) const
+{
+    Path path;
+    if (!isValid() || from.edge >= m_edgeCount || to.edge >= m_edgeCount)
+        return path;
+
+    const Hierarchy &hierarchy = m_hierarchies[profile];
+    const QList<Endpoint> ends[2] = {
+        endpoints(from, true, profile, nullptr, nullptr),
+        endpoints(to, false, profile, nullptr, nullptr)
+    };
+
+    struct Label
+    {
+        double distance;
+        quint32 arc;
+        bool settled;
+    };
+    using Entry = std::pair<double, quint32>;
+    QHash<quint32, Label> labels[2];
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queues[2];
+    for (int side = 0; side < 2; ++side) {
+        for (const Endpoint &end : ends[side]) {
+            const auto it = labels[side].constFind(end.node);
+            if (it == labels[side].cend() || end.cost < it->distance) {
+                labels[side].insert(end.node, { end.cost, NoArc, false });
+                queues[side].push(std::make_pair(end.cost, end.node));
+            }
+        }
+    }
+
+    double best = directCost(from, to, profile, nullptr, nullptr);
+    quint32 meeting = NoNode;
+    while (true) {
+        const double tops[2] = {
+            queues[0].empty() ? Infinity : queues[0].top().first,
+            queues[1].empty() ? Infinity : queues[1].top().first
+        };
+        if (qMin(tops[0], tops[1]) >= best)
+            break;
+        const int side = tops[0] <= tops[1] ? 0 : 1;
+        const Entry entry = queues[side].top();
+        queues[side].pop();
+
+        const quint32 node = entry.second;
+        auto it = labels[side].find(node);
+        if (it->settled || entry.first > it->distance)
+            continue;
+        it->settled = true;
+
+        const auto other = labels[1 - side].constFind(node);
+        if (other != labels[1 - side].cend() && entry.first + other->distance < best) {
+            best = entry.first + other->distance;
+            meeting = node;
+        }
+
+        const uchar *index = side == 0 ? hierarchy.upIndex : hierarchy.downIndex;
+        const quint32 first = get<quint32>(index + qsizetype(node) * 4);
+        const quint32 last = qMin(quint64(get<quint32>(index + qsizetype(node) * 4 + 4)),
+                                  hierarchy.arcCount);
+        for (quint32 arc = first; arc < last; ++arc) {
+            const uchar *record = hierarchy.arcs + qsizetype(arc) * HierarchyArcSize;
+            const quint32 next = get<quint32>(side == 0 ? record + 4 : record);
+            if (next >= m_nodeCount)
+                continue;
+            const double distance = entry.first + get<quint32>(record + 8);
+            auto label = labels[side].find(next);
+            if (label == labels[side].end()) {
+                labels[side].insert(next, { distance, arc, false });
+            } else if (!label->settled && distance < label->distance) {
+                label->distance = distance;
+                label->arc = arc;
+            } else {
+                continue;
+            }
+            queues[side].push(std::make_pair(distance, next));
+        }
+    }
+
+    if (!qIsFinite(best))
+        return path;
+
+    if (meeting == NoNode) {
+        path.pieces.append({ from.edge, from.offset, to.offset });
+        path.cost = best;
+        return path;
+    }
+
+    // the forward search tree leads from the meeting node back to a source endpoint, the
+    // backward search tree leads on to a target endpoint
+    QList<quint32> upArcs;
+    quint32 node = meeting;
+    for (quint32 arc; (arc = labels[0].value(node).arc) != NoArc; ) {
+        upArcs.prepend(arc);
+        node = get<quint32>(hierarchy.arcs + qsizetype(arc) * HierarchyArcSize);
+    }
+    const quint32 sourceNode = node;
+
+    QList<quint32> downArcs;
+    node = meeting;
+    for (quint32 arc; (arc = labels[1].value(node).arc) != NoArc; ) {
+        downArcs.append(arc);
+        node = get<quint32>(hierarchy.arcs + qsizetype(arc) * HierarchyArcSize + 4);
+    }
+    const quint32 targetNode = node;
+
+    const auto cheapest = [](const QList<Endpoint> &ends, quint32 node) {
+        const Endpoint *result = nullptr;
+        for (const Endpoint &end : ends) {
+            if (end.node == node && (!result || end.cost < result->cost))
+                result = &end;
+        }
+        return result;
+    };
+    const Endpoint *source = cheapest(ends[0], sourceNode);
+    const Endpoint *target = cheapest(ends[1], targetNode);
+    if (!source || !target)
+        return path;
+
+    path.pieces.append(source->piece);
+    for (quint32 arc : std::as_const(upArcs))
+        unpack(profile, arc, &path.pieces);
+    for (quint32 arc : std::as_const(downArcs))
+        unpack(profile, arc, &path.pieces);
+    path.pieces.append(target->piece);
+    path.cost = best;
+    return path;
+}
+
+/*
+    Returns the cheapest path between \a from and \a to under \a weighting, found by an A*
+    search on the road graph. This is much slower than the hierarchy on long routes, and
+    is only used for queries that change the costs of edges.
+*/
+QRouteIndexOffline::Path QRouteIndexOffline::route(const Position &from, const Position &to,
+                                                   Profile profile,
+                                                   const Weighting &weighting) const
+{
+    if (weighting.isDefault())
+        return route(from, to, profile);
+
+    Path path;
+    if (!isValid() || from.edge >= m_edgeCount || to.edge >= m_edgeCount)
+        return path;
+
+    QHash<quint32, bool> excluded;
+    const QList<Endpoint> sources = endpoints(from, true, profile, &weighting, &excluded);
+    const QList<Endpoint> targets = endpoints(to, false, profile, &weighting, &excluded);
+
+    // the estimate must not exceed the real cost, so it assumes the fastest speed and
+    // the largest discount any edge can get
+    double factor = 1.0;
+    for (double featureFactor : weighting.featureFactors)
+        factor = qMin(factor, featureFactor);
+    for (double penalty : weighting.penalties)
+        factor = qMin(factor, penalty);
+    const quint8 maximumSpeed = m_maximumSpeeds[profile];
+    double costPerMeter = 0.0;
+    if (weighting.shortest)
+        costPerMeter = factor;
+    else if (maximumSpeed > 0)
+        costPerMeter = factor * 36.0 / maximumSpeed;
+    const qint32 targetLatitude = fixed(to.coordinate.isValid() ? to.coordinate.latitude() : 0.0);
+    const qint32 targetLongitude = fixed(to.coordinate.isValid() ? to.coordinate.longitude() : 0.0);
+    const auto estimate = [&](quint32 node) {
+        if (costPerMeter <= 0.0 || !to.coordinate.isValid())
+            return 0.0;
+        const uchar *record = m_nodes + qsizetype(node) * NodeSize;
+        return distance(get<qint32>(record), get<qint32>(record + 4),
+                        targetLatitude, targetLongitude) * costPerMeter;
+    };
+
+    struct Label
+    {
+        double distance;
+        double estimate;
+        quint32 arc;
+        quint32 parent;
+        bool settled;
+    };
+    using Entry = std::pair<double, quint32>;
+    QHash<quint32, Label> labels;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (const Endpoint &source : sources) {
+        const auto it = labels.constFind(source.node);
+        if (it == labels.cend() || source.cost < it->distance) {
+            const double total = source.cost + estimate(source.node);
+            labels.insert(source.node, { source.cost, total, NoArc, NoNode, false });
+            queue.push(std::make_pair(total, source.node));
+        }
+    }
+    QHash<quint32, const Endpoint *> targetEnds;
+    for (const Endpoint &target : targets) {
+        const Endpoint *&end = targetEnds[target.node];
+        if (!end || target.cost < end->cost)
+            end = &target;
+    }
+
+    double best = directCost(from, to, profile, &weighting, &excluded);
+    quint32 bestNode = NoNode;
+    while (!queue.empty()) {
+        const Entry entry = queue.top();
+        queue.pop();
+        if (entry.first >= best)
+            break;
+
+        const quint32 node = entry.second;
+        auto it = labels.find(node);
+        if (it->settled || entry.first > it->estimate)
+            continue;
+        it->settled = true;
+        const double current = it->distance;
+
+        const auto target = targetEnds.constFind(node);
+        if (target != targetEnds.cend() && current + target.value()->cost < best) {
+            best = current + target.value()->cost;
+            bestNode = node;
+        }
+
+        const quint32 first = get<quint32>(m_arcIndex + qsizetype(node) * 4);
+        const quint32 last = qMin(quint64(get<quint32>(m_arcIndex + qsizetype(node) * 4 + 4)),
+                                  m_arcCount);
+        for (quint32 arc = first; arc < last; ++arc) {
+            const uchar *record = m_arcs + qsizetype(arc) * ArcSize;
+            const quint32 next = get<quint32>(record);
+            const quint32 value = get<quint32>(record + 4);
+            const quint32 edge = value & ~ReversedArc;
+            if (next >= m_nodeCount || edge >= m_edgeCount)
+                continue;
+            const double cost = edgeCost(edge, !(value & ReversedArc), profile, &weighting,
+                                         &excluded);
+            if (!qIsFinite(cost))
+                continue;
+            const double distance = current + cost;
+            auto label = labels.find(next);
+            if (label == labels.end()) {
+                label = labels.insert(next, { distance, distance + estimate(next), arc, node,
+                                              false });
+            } else if (!label->settled && distance < label->distance) {
+                label->estimate = distance + (label->estimate - label->distance);
+                label->distance = distance;
+                label->arc = arc;
+                label->parent = node;
+            } else {
+                continue;
+            }
+            queue.push(std::make_pair(label->estimate, next));
+        }
+    }
+
+    if (!qIsFinite(best))
+        return path;
+
+    if (bestNode == NoNode) {
+        path.pieces.append({ from.edge, from.offset, to.offset });
+        path.cost = best;
+        return path;
+    }
+
+    QList<Piece> pieces;
+    quint32 node = bestNode;
+    while (true) {
+        const Label label = labels.value(node);
+        if (label.arc == NoArc)
+            break;
+        pieces.prepend(arcPiece(label.arc));
+        node = label.parent;
+    }
+
+    const Endpoint *source = nullptr;
+    for (const Endpoint &end : sources) {
+        if (end.node == node && (!source || end.cost < source->cost))
+            source = &end;
+    }
+    if (!source)
+        return path;
+
+    path.pieces.append(source->piece);
+    path.pieces.append(pieces);
+    path.pieces.append(targetEnds.value(bestNode)->piece);
+    path.cost = best;
+    return path;
+}
+
+QT_END_NAMESPACE
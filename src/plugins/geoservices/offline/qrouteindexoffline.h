@@ -0,0 +1,200 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QROUTEINDEXOFFLINE_H
+#define QROUTEINDEXOFFLINE_H
+
+#include "qofflineindex.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoRectangle>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Collects road geometries and serializes them into the road graph read by
+    QRouteIndexOffline.
+
+    Ways are split into edges at the vertices they share with other ways. For each of the
+    car, bicycle and pedestrian profiles the builder then contracts the graph into a
+    contraction hierarchy: nodes are removed one by one, cheapest first, and shortcuts are
+    added wherever a removed node lay on the only shortest path between two neighbours.
+    A query then only ever climbs the hierarchy from both ends, which settles a few
+    hundred nodes even on country sized graphs.
+*/
+class QRouteIndexOfflineBuilder
+{
+public:
+    bool addWay(const QList<QGeoCoordinate> &path, const QVariantMap &tags);
+    int addGeoJson(const QVariantList &importedGeoJson);
+
+    qsizetype size() const;
+    QByteArray build() const;
+    bool write(const QString &fileName, QString *errorString = nullptr) const;
+
+private:
+    struct Way
+    {
+        quint32 firstVertex;
+        quint32 vertexCount;
+        quint32 name;
+        quint8 access;
+        quint8 features;
+        quint8 speeds[3];
+    };
+
+    int addFeature(const QVariantMap &feature);
+
+    std::vector<Way> m_ways;
+    std::vector<qint32> m_vertices;
+    QStringList m_names;
+    QHash<QString, quint32> m_nameIndex;
+};
+
+class QRouteIndexOffline
+{
+public:
+    enum Profile {
+        CarProfile,
+        BicycleProfile,
+        PedestrianProfile,
+        ProfileCount
+    };
+
+    enum EdgeFeature {
+        TollEdge = 0x01,
+        HighwayEdge = 0x02,
+        FerryEdge = 0x04,
+        TunnelEdge = 0x08,
+        UnpavedEdge = 0x10,
+        RoundaboutEdge = 0x20,
+        EdgeFeatureCount = 6
+    };
+
+    static const quint32 NoEdge = 0xffffffff;
+
+    // a point on an edge, offset meters from the edge's first vertex
+    struct Position
+    {
+        quint32 edge = NoEdge;
+        double offset = 0.0;
+        QGeoCoordinate coordinate;
+
+        bool isValid() const { return edge != NoEdge; }
+    };
+
+    // the part of an edge between two offsets, with end < begin when the edge is
+    // travelled against the direction of its vertices
+    struct Piece
+    {
+        quint32 edge;
+        double begin;
+        double end;
+    };
+
+    struct Path
+    {
+        QList<Piece> pieces;
+        double cost = -1.0;
+
+        bool isValid() const { return cost >= 0.0; }
+    };
+
+    // Costs of a query that the hierarchy cannot answer, which is then searched on the
+    // plain road graph. Factors multiply the cost of edges, infinity forbids them.
+    struct Weighting
+    {
+        bool shortest = false;
+        double featureFactors[EdgeFeatureCount] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+        QList<QGeoRectangle> excludedAreas;
+        QHash<quint32, double> penalties;
+
+        bool isDefault() const;
+    };
+
+    QRouteIndexOffline();
+    ~QRouteIndexOffline();
+
+    bool open(const QString &fileName, QString *errorString = nullptr);
+    bool setData(const QByteArray &data, QString *errorString = nullptr);
+    bool isValid() const;
+
+    quint32 nodeCount() const;
+    quint32 edgeCount() const;
+
+    double edgeLength(quint32 edge) const;
+    QString edgeName(quint32 edge) const;
+    quint8 edgeFeatures(quint32 edge) const;
+    QList<QGeoCoordinate> geometry(const Piece &piece) const;
+    double travelTime(const Piece &piece, Profile profile) const;
+    double cost(const Piece &piece, Profile profile, const Weighting &weighting) const;
+
+    Position snap(const QGeoCoordinate &coordinate, Profile profile,
+                  double maximumDistance) const;
+    Path route(const Position &from, const Position &to, Profile profile) const;
+    Path route(const Position &from, const Position &to, Profile profile,
+               const Weighting &weighting) const;
+
+private:
+    Q_DISABLE_COPY(QRouteIndexOffline)
+
+    struct Endpoint
+    {
+        quint32 node;
+        double cost;
+        Piece piece;
+    };
+
+    bool load(const uchar *data, qint64 size, QString *errorString);
+    void close();
+
+    const uchar *edge(quint32 index) const;
+    bool isAccessible(quint32 edge, bool forward, Profile profile) const;
+    double edgeCost(quint32 edge, bool forward, Profile profile, const Weighting *weighting,
+                    QHash<quint32, bool> *excluded) const;
+    QList<Endpoint> endpoints(const Position &position, bool source, Profile profile,
+                              const Weighting *weighting, QHash<quint32, bool> *excluded) const;
+    double directCost(const Position &from, const Position &to, Profile profile,
+                      const Weighting *weighting, QHash<quint32, bool> *excluded) const;
+    Piece arcPiece(quint32 arc) const;
+    void unpack(Profile profile, quint32 arc, QList<Piece> *pieces) const;
+
+    QOfflineIndexData m_file;
+    const uchar *m_data = nullptr;
+
+    quint32 m_nodeCount = 0;
+    quint32 m_edgeCount = 0;
+    quint32 m_cellCount = 0;
+    quint64 m_arcCount = 0;
+    quint64 m_vertexCount = 0;
+    quint64 m_entryCount = 0;
+    quint64 m_stringSize = 0;
+    quint8 m_maximumSpeeds[ProfileCount] = {};
+    const uchar *m_nodes = nullptr;
+    const uchar *m_arcIndex = nullptr;
+    const uchar *m_arcs = nullptr;
+    const uchar *m_edges = nullptr;
+    const uchar *m_vertices = nullptr;
+    const uchar *m_cells = nullptr;
+    const uchar *m_entries = nullptr;
+    const uchar *m_strings = nullptr;
+
+    struct Hierarchy
+    {
+        quint64 arcCount = 0;
+        const uchar *upIndex = nullptr;
+        const uchar *downIndex = nullptr;
+        const uchar *arcs = nullptr;
+    };
+    Hierarchy m_hierarchies[ProfileCount];
+};
+
+QT_END_NAMESPACE
+
+#endif // QROUTEINDEXOFFLINE_H
@@ -3,13 +3,51 @@
 
 #include "qgeofiletilecacheosm.h"
 #include <QtLocation/private/qgeotilespec_p.h>
+#include <QtLocation/private/qgeovectortile_p.h>
+#include <QCryptographicHash>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QPair>
 #include <QDateTime>
+#include <QPointer>
 
 QT_BEGIN_NAMESPACE
 
+static const QLatin1StringView validatorsSuffix(".meta");
+
+// Tiles are stored once per content, see addToContentCache()
+static const QLatin1StringView aliasSuffix(".alias");
+static const QLatin1StringView contentDirectory("content");
+
+// Servers answering no-cache or max-age=0 would otherwise be asked again
+// every time the tile comes into view.
+static const int minimumFreshness = 60; // seconds
+
+// A revalidation that has not completed by then is made again
+static const int revalidationTimeout = 60000; // milliseconds
+
+// For the OpenMapTiles schema, used unless osm.mapping.custom.style is set
+static const char defaultVectorStyle[] = R"({
+    "background": "#f8f4f0",
+    "layers": [
+        { "source-layer": "landcover", "filter": ["in", "class", "wood", "forest"], "fill-color": "#d8e8c8" },
+        { "source-layer": "landcover", "filter": ["==", "class", "grass"], "fill-color": "#e6efd8" },
+        { "source-layer": "landuse", "filter": ["==", "class", "residential"], "fill-color": "#ece7e1" },
+        { "source-layer": "park", "fill-color": "#d8e8c8" },
+        { "source-layer": "water", "fill-color": "#aad3df" },
+        { "source-layer": "waterway", "line-color": "#aad3df", "line-width": 1.5 },
+        { "source-layer": "building", "minzoom": 14, "fill-color": "#dfdbd7", "line-color": "#d1cbc5" },
+        { "source-layer": "boundary", "filter": ["==", "admin_level", 2], "line-color": "#9e9cab", "line-width": 1.5 },
+        { "source-layer": "transportation", "filter": ["==", "class", "rail"], "minzoom": 10, "line-color": "#bbbbbb" },
+        { "source-layer": "transportation", "filter": ["in", "class", "minor", "service", "track"], "minzoom": 13, "line-color": "#ffffff", "line-width": 2 },
+        { "source-layer": "transportation", "filter": ["in", "class", "secondary", "tertiary"], "minzoom": 9, "line-color": "#f7fabf", "line-width": 2.5 },
+        { "source-layer": "transportation", "filter": ["in", "class", "primary", "trunk"], "minzoom": 6, "line-color": "#fcd6a4", "line-width": 3 },
+        { "source-layer": "transportation", "filter": ["==", "class", "motorway"], "minzoom": 4, "line-color": "#e892a2", "line-width": 3 }
+    ]
+})";
+
 QGeoFileTileCacheOsm::QGeoFileTileCacheOsm(const QList<QGeoTileProviderOsm *> &providers,
                                            const QString &offlineDirectory,
                                            const QString &directory, QObject *parent)
@@ -30,20 +68,235 @@ QGeoFileTileCacheOsm::QGeoFileTileCacheOsm(const QList<QGeoTileProviderOsm *> &p
         connect(providers[i], &QGeoTileProviderOsm::resolutionFinished, this, &QGeoFileTileCacheOsm::onProviderResolutionFinished);
         connect(providers[i], &QGeoTileProviderOsm::resolutionError, this, &QGeoFileTileCacheOsm::onProviderResolutionFinished);
     }
+    m_vectorRenderer.setStyle(QByteArray::fromRawData(defaultVectorStyle, sizeof(defaultVectorStyle) - 1));
 }
 
 QGeoFileTileCacheOsm::~QGeoFileTileCacheOsm()
 {
+    // The rendered tiles are added to this cache
+    m_renderPool.clear();
+    m_renderPool.waitForDone();
 }
 
 QSharedPointer<QGeoTileTexture> QGeoFileTileCacheOsm::get(const QGeoTileSpec &spec)
 {
+    const QGeoTileSpec source = sourceTile(spec);
     QSharedPointer<QGeoTileTexture> tt = getFromMemory(spec);
+    if (!tt) {
+        if ((tt = getFromOfflineStorage(spec)))
+            return tt;
+        tt = source == spec ? getFromDisk(spec) : getOverzoomed(spec, source);
+    }
+    // Expired tiles are still shown while they are being revalidated
     if (tt)
-        return tt;
-    if ((tt = getFromOfflineStorage(spec)))
-        return tt;
-    return getFromDisk(spec);
+        revalidateIfStale(source);
+    return tt;
+}
+
+void QGeoFileTileCacheOsm::insert(const QGeoTileSpec &spec,
+                                  const QByteArray &bytes,
+                                  const QString &format,
+                                  QAbstractGeoTileCache::CacheAreas areas)
+{
+    // Overzoomed vector tiles were downloaded as their ancestor
+    const QGeoTileSpec source = sourceTile(spec);
+    const bool revalidated = m_revalidating.remove(source);
+
+    if (bytes.isEmpty()) {
+        // 304 Not Modified, see QGeoMapReplyOsm. Touching the file keeps
+        // clearObsoleteTiles() from finding the tile older than its provider.
+        if (!isTileCached(source))
+            return;
+        QString fileName = tileSpecToFilename(source, format, directory_);
+        if (QFile::exists(fileName + aliasSuffix))
+            fileName += aliasSuffix;
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadWrite))
+            file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        writeValidators(source, format);
+        return;
+    }
+
+    if (areas & QAbstractGeoTileCache::DiskCache) {
+        addToContentCache(source, bytes, format);
+        writeValidators(source, format);
+    }
+    QGeoFileTileCache::insert(source, bytes, format, areas & ~QAbstractGeoTileCache::DiskCache);
+
+    if (revalidated) {
+        if (QGeoTileProviderOsm::isVectorFormat(format)) {
+            // The reply rendered spec again, but not the overzoomed tiles
+            // drawn from the same data
+            const QList<QGeoTileSpec> keys = textureCache_.keys();
+            for (const QGeoTileSpec &k : keys) {
+                if (k != spec && sourceTile(k) == source) {
+                    textureCache_.remove(k);
+                    emit tileDataUpdated(k);
+                }
+            }
+        } else {
+            // The old content may be on screen, and cached as a texture
+            textureCache_.remove(spec);
+        }
+        emit tileDataUpdated(spec);
+    }
+}
+
+void QGeoFileTileCacheOsm::clearAll()
+{
+    QGeoFileTileCache::clearAll(); // also removes the alias files
+    m_contentUsers.clear();
+    QDir dir(directory_);
+    QDir(dir.filePath(contentDirectory)).removeRecursively();
+    dir.mkpath(contentDirectory);
+}
+
+void QGeoFileTileCacheOsm::clearMapId(int mapId)
+{
+    // The base class drops the disk cache entries without going through
+    // removeTileFile(), which would leave the alias files, and the content
+    // only they refer to, behind
+    const QList<QGeoTileSpec> keys = diskCache_.keys();
+    for (const QGeoTileSpec &k : keys) {
+        if (k.mapId() != mapId)
+            continue;
+        const QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(k);
+        if (td)
+            td->cache = nullptr; // the files are removed once, below
+        diskCache_.remove(k, true);
+        if (td)
+            removeTileFile(td.data());
+    }
+    for (auto it = m_validators.begin(); it != m_validators.end();) {
+        if (it.key().mapId() == mapId)
+            it = m_validators.erase(it);
+        else
+            ++it;
+    }
+    // The memory and texture caches, and tile files not loaded
+    QGeoFileTileCache::clearMapId(mapId);
+}
+
+QGeoTileValidatorsOsm QGeoFileTileCacheOsm::validators(const QGeoTileSpec &spec) const
+{
+    // Only worth sending if the tile they validate is still there
+    const auto it = m_validators.constFind(sourceTile(spec));
+    if (it == m_validators.cend() || !isTileCached(spec))
+        return QGeoTileValidatorsOsm();
+    return *it;
+}
+
+void QGeoFileTileCacheOsm::setValidators(const QGeoTileSpec &spec, const QGeoTileValidatorsOsm &validators)
+{
+    QGeoTileValidatorsOsm &v = m_validators[sourceTile(spec)];
+    v = validators;
+    if (v.expires.isValid())
+        v.expires = qMax(v.expires, QDateTime::currentDateTimeUtc().addSecs(minimumFreshness));
+}
+
+void QGeoFileTileCacheOsm::abortRevalidation(const QGeoTileSpec &spec)
+{
+    const QGeoTileSpec source = sourceTile(spec);
+    if (!m_revalidating.remove(source))
+        return;
+    // Try again later rather than on the next lookup
+    const auto it = m_validators.find(source);
+    if (it != m_validators.end())
+        it->expires = QDateTime::currentDateTimeUtc().addSecs(minimumFreshness);
+}
+
+bool QGeoFileTileCacheOsm::isTileCached(const QGeoTileSpec &spec) const
+{
+    return !diskCache_.object(sourceTile(spec)).isNull();
+}
+
+bool QGeoFileTileCacheOsm::setVectorStyle(const QByteArray &json, QString *errorString)
+{
+    return m_vectorRenderer.setStyle(json, errorString);
+}
+
+// Renders a vector tile on a worker thread. Back on the thread of the cache,
+// the image is added to the texture cache, and done is called with whether
+// the tile could be decoded, unless context has been destroyed meanwhile.
+void QGeoFileTileCacheOsm::renderVectorTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                            QObject *context, std::function<void(bool)> done)
+{
+    m_renderPool.start([this, spec, bytes, renderer = m_vectorRenderer,
+                        size = vectorTileSize(spec), rect = vectorTileRect(spec),
+                        context = QPointer<QObject>(context), done = std::move(done)]() mutable {
+        QElapsedTimer timer;
+        timer.start();
+        const QImage image = renderer.render(QGeoVectorTile::fromData(bytes), spec.zoom(), size, rect);
+        const qint64 renderTime = timer.nsecsElapsed() / 1000;
+        QMetaObject::invokeMethod(this, [this, spec, image, renderTime, context = std::move(context),
+                                         done = std::move(done)] {
+            decodeTimes_.add(renderTime);
+            if (!image.isNull())
+                addToTextureCache(spec, image);
+            if (context)
+                done(!image.isNull());
+        }, Qt::QueuedConnection);
+    });
+}
+
+void QGeoFileTileCacheOsm::revalidateIfStale(const QGeoTileSpec &spec)
+{
+    const auto it = m_validators.constFind(spec);
+    if (it == m_validators.cend() || !it->expires.isValid()
+            || it->expires > QDateTime::currentDateTimeUtc()) {
+        return;
+    }
+    const auto pending = m_revalidating.constFind(spec);
+    if (pending != m_revalidating.cend() && !pending->hasExpired())
+        return;
+    m_revalidating.insert(spec, QDeadlineTimer(revalidationTimeout));
+    emit tileExpired(spec);
+}
+
+void QGeoFileTileCacheOsm::loadValidators(const QDir &dir, const QStringList &files)
+{
+    const QSet<QString> fileSet(files.cbegin(), files.cend());
+    for (const QString &fileName : files) {
+        if (!fileName.endsWith(validatorsSuffix))
+            continue;
+        const QString tileFileName = fileName.chopped(validatorsSuffix.size());
+        const QGeoTileSpec spec = filenameToTileSpec(tileFileName);
+        if (spec.zoom() == -1)
+            continue;
+        if (!fileSet.contains(tileFileName)
+                && !fileSet.contains(tileFileName + aliasSuffix)) { // the tile has been evicted
+            QFile::remove(dir.filePath(fileName));
+            continue;
+        }
+
+        QFile file(dir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        if (lines.size() < 3)
+            continue;
+        QGeoTileValidatorsOsm &validators = m_validators[spec];
+        validators.etag = lines.at(0);
+        validators.lastModified = lines.at(1);
+        validators.expires = QDateTime::fromString(QString::fromLatin1(lines.at(2)), Qt::ISODate);
+    }
+}
+
+void QGeoFileTileCacheOsm::writeValidators(const QGeoTileSpec &spec, const QString &format) const
+{
+    const QString fileName = tileSpecToFilename(spec, format, directory_) + validatorsSuffix;
+    const QGeoTileValidatorsOsm validators = m_validators.value(spec);
+    if (validators.isEmpty()) {
+        QFile::remove(fileName);
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+    file.write(validators.etag + '\n'
+               + validators.lastModified + '\n'
+               + validators.expires.toUTC().toString(Qt::ISODate).toLatin1() + '\n');
 }
 
 void QGeoFileTileCacheOsm::onProviderResolutionFinished(const QGeoTileProviderOsm *provider)
@@ -95,11 +348,13 @@ void QGeoFileTileCacheOsm::init()
     formats << QLatin1String("*.*");
     QStringList files = dir.entryList(formats, QDir::Files);
 
-    for (const QString &tileFileName : files) {
+    for (const QString &fileName : files) {
+        const QString tileFileName = fileName.endsWith(aliasSuffix)
+                ? fileName.chopped(aliasSuffix.size()) : fileName;
         QGeoTileSpec spec = filenameToTileSpec(tileFileName);
         if (spec.zoom() == -1)
             continue;
-        QFileInfo fi(dir.filePath(tileFileName));
+        QFileInfo fi(dir.filePath(fileName));
         if (fi.lastModified() > m_maxMapIdTimestamps[spec.mapId()])
             m_maxMapIdTimestamps[spec.mapId()] = fi.lastModified();
     }
@@ -107,6 +362,10 @@ void QGeoFileTileCacheOsm::init()
     // Base class ::init()
     QGeoFileTileCache::init();
 
+    dir.mkpath(contentDirectory);
+    removeUnusedContent(loadAliases(dir, files));
+    loadValidators(dir, files);
+
     for (QGeoTileProviderOsm * p: m_providers)
         clearObsoleteTiles(p);
 }
@@ -131,16 +390,180 @@ QSharedPointer<QGeoTileTexture> QGeoFileTileCacheOsm::getFromOfflineStorage(cons
     QByteArray bytes = file.readAll();
     file.close();
 
-    QImage image;
-    if (!image.loadFromData(bytes)) {
+    const QString format = QFileInfo(file.fileName()).suffix();
+    const QImage image = decodeTileImage(spec, bytes, format);
+    if (image.isNull()) {
         handleError(spec, QLatin1String("Problem with tile image"));
         return QSharedPointer<QGeoTileTexture>();
     }
 
-    addToMemoryCache(spec, bytes, QString());
+    addToMemoryCache(spec, bytes, format);
     return addToTextureCache(spec, image);
 }
 
+// Draws an overzoomed vector tile from the part of its cached ancestor it covers
+QSharedPointer<QGeoTileTexture> QGeoFileTileCacheOsm::getOverzoomed(const QGeoTileSpec &spec,
+                                                                    const QGeoTileSpec &source)
+{
+    QString format;
+    const QByteArray bytes = getDataFromCache(source, &format);
+    if (bytes.isEmpty())
+        return QSharedPointer<QGeoTileTexture>();
+
+    const QImage image = decodeTileImage(spec, bytes, format);
+    if (image.isNull()) {
+        handleError(spec, QLatin1String("Problem with tile image"));
+        return QSharedPointer<QGeoTileTexture>();
+    }
+    return addToTextureCache(spec, image);
+}
+
+// Map types and providers using the same server get the same tiles. Their
+// content is stored once, in a file of the content directory named after
+// its hash, and each tile has an alias file, <tile file>.alias, holding the
+// name of its content file. The disk cache entries of the tiles point to the
+// content files, which are removed with their last tile.
+void QGeoFileTileCacheOsm::addToContentCache(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                             const QString &format)
+{
+    const QString tileFileName = tileSpecToFilename(spec, format, directory_);
+    if (tileFileName.isEmpty())
+        return;
+
+    const QString contentName = QString::fromLatin1(
+            QCryptographicHash::hash(bytes, QCryptographicHash::Sha1).toHex())
+            + QLatin1Char('.') + format;
+    const QString contentFile = QDir(QDir(directory_).filePath(contentDirectory))
+                                        .filePath(contentName);
+    if (!m_contentUsers.contains(contentFile)) {
+        QFile file(contentFile);
+        if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size()) {
+            file.remove();
+            return;
+        }
+    }
+    // Before inserting: the entry replaced may use the same content
+    ++m_contentUsers[contentFile];
+
+    QSharedPointer<QGeoCachedTileDisk> td(new QGeoCachedTileDisk);
+    td->spec = spec;
+    td->filename = contentFile;
+    td->cache = this;
+    const int cost = costStrategyDisk_ == ByteSize ? int(bytes.size()) : 1;
+    if (!diskCache_.insert(spec, td, cost)) {
+        td->cache = nullptr; // the alias file belongs to the entry still cached, if any
+        if (releaseContent(contentFile))
+            QFile::remove(contentFile);
+        return;
+    }
+
+    QFile alias(tileFileName + aliasSuffix);
+    if (alias.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        alias.write(contentName.toLatin1());
+}
+
+// Returns whether no tile uses the content file anymore
+bool QGeoFileTileCacheOsm::releaseContent(const QString &contentFile)
+{
+    const auto it = m_contentUsers.find(contentFile);
+    if (it == m_contentUsers.end() || --*it > 0)
+        return false;
+    m_contentUsers.erase(it);
+    return true;
+}
+
+void QGeoFileTileCacheOsm::removeTileFile(QGeoCachedTileDisk *td)
+{
+    if (!m_contentUsers.contains(td->filename)) { // stored before content addressing
+        QGeoFileTileCache::removeTileFile(td);
+        return;
+    }
+    const QString format = QFileInfo(td->filename).suffix();
+    QFile::remove(tileSpecToFilename(td->spec, format, directory_) + aliasSuffix);
+    if (releaseContent(td->filename))
+        QFile::remove(td->filename);
+}
+
+// Returns the names of the content files the alias files refer to, including
+// those of tiles not loaded, e.g. of another map id or resolution
+QSet<QString> QGeoFileTileCacheOsm::loadAliases(const QDir &dir, const QStringList &files, int mapId)
+{
+    QSet<QString> contentNames;
+    const QDir contents(dir.filePath(contentDirectory));
+    for (const QString &fileName : files) {
+        if (!fileName.endsWith(aliasSuffix))
+            continue;
+        QFile file(dir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        const QString contentName = QString::fromLatin1(file.readAll().trimmed());
+        file.close();
+        const QString contentFile = contents.filePath(contentName);
+        if (contentName.isEmpty() || contentName.contains(QLatin1Char('/'))
+                || !QFile::exists(contentFile)) {
+            QFile::remove(dir.filePath(fileName));
+            continue;
+        }
+        contentNames.insert(contentName);
+
+        const QGeoTileSpec spec = filenameToTileSpec(fileName.chopped(aliasSuffix.size()));
+        if (spec.zoom() == -1 || (mapId != -1 && spec.mapId() != mapId))
+            continue;
+        ++m_contentUsers[contentFile];
+        addToDiskCache(spec, contentFile);
+    }
+    return contentNames;
+}
+
+// Content left behind by a crash, or whose tiles have been removed while
+// the cache was not running
+void QGeoFileTileCacheOsm::removeUnusedContent(const QSet<QString> &contentNames)
+{
+    QDir contents(QDir(directory_).filePath(contentDirectory));
+    const QStringList files = contents.entryList(QDir::Files);
+    for (const QString &fileName : files) {
+        if (!contentNames.contains(fileName))
+            contents.remove(fileName);
+    }
+}
+
+QImage QGeoFileTileCacheOsm::decodeTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                                        const QString &format) const
+{
+    if (!QGeoTileProviderOsm::isVectorFormat(format))
+        return QGeoFileTileCache::decodeTile(spec, bytes, format);
+    return m_vectorRenderer.render(QGeoVectorTile::fromData(bytes), spec.zoom(),
+                                   vectorTileSize(spec), vectorTileRect(spec));
+}
+
+QGeoTileSpec QGeoFileTileCacheOsm::sourceTile(const QGeoTileSpec &spec) const
+{
+    const int providerId = spec.mapId() - 1;
+    if (providerId < 0 || providerId >= m_providers.size())
+        return spec;
+    return m_providers[providerId]->sourceTile(spec);
+}
+
+QSize QGeoFileTileCacheOsm::vectorTileSize(const QGeoTileSpec &spec) const
+{
+    const int providerId = spec.mapId() - 1;
+    const bool highDpi = providerId >= 0 && providerId < m_providers.size()
+            && m_providers[providerId]->isHighDpi();
+    return highDpi ? QSize(512, 512) : QSize(256, 256);
+}
+
+// The part of the source tile covered by spec, in units of the source tile
+QRectF QGeoFileTileCacheOsm::vectorTileRect(const QGeoTileSpec &spec) const
+{
+    const QGeoTileSpec source = sourceTile(spec);
+    const int levels = spec.zoom() - source.zoom();
+    if (levels <= 0)
+        return QRectF(0, 0, 1, 1);
+    const qreal size = 1.0 / (1 << levels);
+    return QRectF((spec.x() - (source.x() << levels)) * size,
+                  (spec.y() - (source.y() << levels)) * size, size, size);
+}
+
 void QGeoFileTileCacheOsm::dropTiles(int mapId)
 {
     QList<QGeoTileSpec> keys;
@@ -155,9 +578,14 @@ void QGeoFileTileCacheOsm::dropTiles(int mapId)
             memoryCache_.remove(k);
 
     keys = diskCache_.keys();
-    for (const QGeoTileSpec &k : keys)
-        if (k.mapId() == mapId)
-            diskCache_.remove(k);
+    for (const QGeoTileSpec &k : keys) {
+        if (k.mapId() != mapId)
+            continue;
+        // The files are kept, they are loaded again
+        if (const QSharedPointer<QGeoCachedTileDisk> td = diskCache_.object(k))
+            releaseContent(td->filename);
+        diskCache_.remove(k);
+    }
 }
 
 void QGeoFileTileCacheOsm::loadTiles(int mapId)
@@ -175,6 +603,7 @@ void QGeoFileTileCacheOsm::loadTiles(int mapId)
         QString filename = dir.filePath(files.at(i));
         addToDiskCache(spec, filename);
     }
+    loadAliases(dir, files, mapId);
 }
 
 QString QGeoFileTileCacheOsm::tileSpecToFilename(const QGeoTileSpec &spec, const QString &format, const QString &directory) const
@@ -268,8 +697,13 @@ void QGeoFileTileCacheOsm::clearObsoleteTiles(const QGeoTileProviderOsm *p)
             if (m_maxMapIdTimestamps[p->mapType().mapId()].isValid() &&  // there are tiles in the cache
                 p->timestamp() > m_maxMapIdTimestamps[p->mapType().mapId()]) { // and they are older than the provider
                 qInfo() << "provider for " << p->mapType().name() << " timestamp: " << p->timestamp()
-                        << " -- data last modified: " << m_maxMapIdTimestamps[p->mapType().mapId()] << ". Clearing.";
-                clearMapId(p->mapType().mapId());
+                        << " -- data last modified: " << m_maxMapIdTimestamps[p->mapType().mapId()] << ". Revalidating.";
+                // Keep showing the tiles, each one is revalidated the next time it is used
+                const QDateTime now = QDateTime::currentDateTimeUtc();
+                const QList<QGeoTileSpec> keys = diskCache_.keys();
+                for (const QGeoTileSpec &k : keys)
+                    if (k.mapId() == p->mapType().mapId())
+                        m_validators[k].expires = now;
                 m_maxMapIdTimestamps[p->mapType().mapId()] = p->timestamp(); // don't do it again.
             }
         } else {
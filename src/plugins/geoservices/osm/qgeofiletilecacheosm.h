@@ -6,12 +6,32 @@
 
 #include "qgeotileproviderosm.h"
 #include <QtLocation/private/qgeofiletilecache_p.h>
+#include <QtLocation/private/qgeovectortilerenderer_p.h>
 #include <QHash>
+#include <QSet>
+#include <QThreadPool>
 #include <qatomic.h>
+#include <QDateTime>
+#include <QDeadlineTimer>
 #include <QDir>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
+// HTTP cache validators of a tile, stored next to it in <tile file>.meta
+struct QGeoTileValidatorsOsm
+{
+    QByteArray etag;
+    QByteArray lastModified;
+    QDateTime expires; // invalid if the server did not say how long the tile is fresh
+
+    bool isEmpty() const
+    {
+        return etag.isEmpty() && lastModified.isEmpty() && !expires.isValid();
+    }
+};
+
 class QGeoFileTileCacheOsm : public QGeoFileTileCache
 {
     Q_OBJECT
@@ -22,9 +42,26 @@ public:
     ~QGeoFileTileCacheOsm();
 
     QSharedPointer<QGeoTileTexture> get(const QGeoTileSpec &spec) override;
+    void clearAll() override;
+    void clearMapId(int mapId) override;
+    void insert(const QGeoTileSpec &spec,
+                const QByteArray &bytes,
+                const QString &format,
+                QAbstractGeoTileCache::CacheAreas areas = QAbstractGeoTileCache::AllCaches) override;
+
+    QGeoTileValidatorsOsm validators(const QGeoTileSpec &spec) const;
+    void setValidators(const QGeoTileSpec &spec, const QGeoTileValidatorsOsm &validators);
+    void abortRevalidation(const QGeoTileSpec &spec);
+    bool isTileCached(const QGeoTileSpec &spec) const;
+
+    bool setVectorStyle(const QByteArray &json, QString *errorString = nullptr);
+    void renderVectorTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                          QObject *context, std::function<void(bool)> done);
 
 Q_SIGNALS:
     void mapDataUpdated(int mapId);
+    void tileExpired(const QGeoTileSpec &spec);
+    void tileDataUpdated(const QGeoTileSpec &spec);
 
 protected Q_SLOTS:
     void onProviderResolutionFinished(const QGeoTileProviderOsm *provider);
@@ -35,17 +72,38 @@ protected:
     inline QString tileSpecToFilename(const QGeoTileSpec &spec, const QString &format, int providerId) const;
     QString tileSpecToFilename(const QGeoTileSpec &spec, const QString &format, const QString &directory) const override;
     QGeoTileSpec filenameToTileSpec(const QString &filename) const override;
+    QImage decodeTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                      const QString &format) const override;
+    void removeTileFile(QGeoCachedTileDisk *td) override;
+    void addToContentCache(const QGeoTileSpec &spec, const QByteArray &bytes, const QString &format);
+    bool releaseContent(const QString &contentFile);
+    QSet<QString> loadAliases(const QDir &dir, const QStringList &files, int mapId = -1);
+    void removeUnusedContent(const QSet<QString> &contentNames);
     QSharedPointer<QGeoTileTexture> getFromOfflineStorage(const QGeoTileSpec &spec);
+    QSharedPointer<QGeoTileTexture> getOverzoomed(const QGeoTileSpec &spec, const QGeoTileSpec &source);
+    QGeoTileSpec sourceTile(const QGeoTileSpec &spec) const;
+    QSize vectorTileSize(const QGeoTileSpec &spec) const;
+    QRectF vectorTileRect(const QGeoTileSpec &spec) const;
     void dropTiles(int mapId);
     void loadTiles(int mapId);
 
     void clearObsoleteTiles(const QGeoTileProviderOsm *p);
+    void revalidateIfStale(const QGeoTileSpec &spec);
+    void loadValidators(const QDir &dir, const QStringList &files);
+    void writeValidators(const QGeoTileSpec &spec, const QString &format) const;
 
     QDir m_offlineDirectory;
     bool m_offlineData;
     QList<QGeoTileProviderOsm *> m_providers;
     QList<bool> m_highDpi;
     QList<QDateTime> m_maxMapIdTimestamps;
+    QHash<QGeoTileSpec, QGeoTileValidatorsOsm> m_validators;
+    // Given up on when the deadline passes, e.g. when the request was dropped
+    // from the queue of the tile fetcher before being sent
+    QHash<QGeoTileSpec, QDeadlineTimer> m_revalidating;
+    QHash<QString, int> m_contentUsers; // tiles using each file of the content directory
+    QGeoVectorTileRenderer m_vectorRenderer;
+    QThreadPool m_renderPool;
 };
 
 QT_END_NAMESPACE
@@ -2,41 +2,161 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qgeomapreplyosm.h"
+#include "qgeofiletilecacheosm.h"
 
 #include <QtLocation/private/qgeotilespec_p.h>
 
+static const char usersProperty[] = "_q_tileUsers";
+static const char dataProperty[] = "_q_tileData";
+
+// Reads the data once for all the tiles sharing the reply, they get the same
+// implicitly shared buffer
+static QByteArray replyData(QNetworkReply *reply)
+{
+    const QVariant data = reply->property(dataProperty);
+    if (data.isValid())
+        return data.toByteArray();
+    const QByteArray bytes = reply->readAll();
+    if (reply->property(usersProperty).toInt() > 1)
+        reply->setProperty(dataProperty, bytes);
+    return bytes;
+}
+
+static QGeoTileValidatorsOsm tileValidators(const QNetworkReply *reply)
+{
+    QGeoTileValidatorsOsm validators;
+    validators.etag = reply->rawHeader("ETag");
+    validators.lastModified = reply->rawHeader("Last-Modified");
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QList<QByteArray> cacheControl = reply->rawHeader("Cache-Control").split(',');
+    for (const QByteArray &d : cacheControl) {
+        const QByteArray directive = d.trimmed().toLower();
+        if (directive == "no-cache" || directive == "no-store") {
+            validators.expires = now;
+            return validators;
+        }
+        if (directive.startsWith("max-age=")) {
+            bool ok = false;
+            const qint64 maxAge = directive.mid(8).toLongLong(&ok);
+            if (ok) {
+                const qint64 age = reply->rawHeader("Age").toLongLong(); // 0 if absent
+                validators.expires = now.addSecs(qMax<qint64>(0, maxAge - age));
+                return validators;
+            }
+        }
+    }
+
+    const QByteArray expires = reply->rawHeader("Expires");
+    if (!expires.isEmpty()) {
+        validators.expires = QDateTime::fromString(QString::fromLatin1(expires), Qt::RFC2822Date);
+        if (!validators.expires.isValid()) // e.g. "0", which means already expired
+            validators.expires = now;
+    }
+    return validators;
+}
+
 QGeoMapReplyOsm::QGeoMapReplyOsm(QNetworkReply *reply,
                                  const QGeoTileSpec &spec,
                                  const QString &imageFormat,
+                                 QGeoFileTileCacheOsm *cache,
                                  QObject *parent)
-:   QGeoTiledMapReply(spec, parent)
+:   QGeoTiledMapReply(spec, parent), m_reply(reply), m_cache(cache)
 {
     if (!reply) {
         setError(UnknownError, QStringLiteral("Null reply"));
         return;
     }
+    // Tiles with the same address share the network reply, see
+    // QGeoTileFetcherOsm. It is aborted once none of them waits for it.
+    reply->setProperty(usersProperty, reply->property(usersProperty).toInt() + 1);
     connect(reply, &QNetworkReply::finished,
             this, &QGeoMapReplyOsm::networkReplyFinished);
     connect(reply, &QNetworkReply::errorOccurred,
             this, &QGeoMapReplyOsm::networkReplyError);
-    connect(this, &QGeoTiledMapReply::aborted, reply, &QNetworkReply::abort);
-    connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
+    connect(this, &QGeoTiledMapReply::aborted, this, &QGeoMapReplyOsm::releaseNetworkReply);
+    // A cancelled revalidation gets no reply, the cache has to be told
+    connect(this, &QGeoTiledMapReply::aborted, this, [this]() {
+        if (m_cache)
+            m_cache->abortRevalidation(tileSpec());
+    });
     setMapImageFormat(imageFormat);
 }
 
 QGeoMapReplyOsm::~QGeoMapReplyOsm()
 {
+    releaseNetworkReply();
 }
 
-void QGeoMapReplyOsm::networkReplyFinished()
+void QGeoMapReplyOsm::releaseNetworkReply()
 {
-    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    if (!m_reply)
+        return;
+    QNetworkReply *reply = m_reply;
+    m_reply = nullptr;
+    reply->disconnect(this);
+    const int users = reply->property(usersProperty).toInt() - 1;
+    reply->setProperty(usersProperty, users);
+    if (users > 0)
+        return;
+    if (!reply->isFinished())
+        reply->abort();
     reply->deleteLater();
+}
 
-    if (reply->error() != QNetworkReply::NoError) // Already handled in networkReplyError
+void QGeoMapReplyOsm::networkReplyFinished()
+{
+    const QPointer<QNetworkReply> reply = m_reply;
+    if (!reply || reply->error() != QNetworkReply::NoError) // Already handled in networkReplyError
         return;
 
-    QByteArray a = reply->readAll();
+    const bool notModified =
+            reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+    if (m_cache) {
+        QGeoTileValidatorsOsm validators = tileValidators(reply);
+        if (notModified) {
+            // A 304 only has to repeat the validators that changed
+            const QGeoTileValidatorsOsm cached = m_cache->validators(tileSpec());
+            if (validators.etag.isEmpty())
+                validators.etag = cached.etag;
+            if (validators.lastModified.isEmpty())
+                validators.lastModified = cached.lastModified;
+        }
+        m_cache->setValidators(tileSpec(), validators);
+    }
+
+    QByteArray a = replyData(reply);
+    releaseNetworkReply();
+
+    if (notModified) {
+        if (!m_cache || !m_cache->isTileCached(tileSpec())) {
+            if (m_cache)
+                m_cache->abortRevalidation(tileSpec());
+            setError(QGeoTiledMapReply::CommunicationError,
+                     QStringLiteral("Revalidated tile is no longer cached"));
+            return;
+        }
+        // Finishing without data only refreshes the cached tile,
+        // see QGeoFileTileCacheOsm::insert()
+        setFinished(true);
+        return;
+    }
+
+    if (m_cache && QGeoTileProviderOsm::isVectorFormat(mapImageFormat())) {
+        // Rendered on a worker thread. The reply finishes once the tile is
+        // in the texture cache, so that the map only has to upload it.
+        m_cache->renderVectorTile(tileSpec(), a, this, [this, a](bool ok) {
+            if (isFinished()) // aborted meanwhile
+                return;
+            if (!ok) {
+                setError(QGeoTiledMapReply::ParseError, QStringLiteral("Invalid vector tile"));
+                return;
+            }
+            setMapImageData(a);
+            setFinished(true);
+        });
+        return;
+    }
 
     setMapImageData(a);
     setFinished(true);
@@ -44,11 +164,19 @@ void QGeoMapReplyOsm::networkReplyFinished()
 
 void QGeoMapReplyOsm::networkReplyError(QNetworkReply::NetworkError error)
 {
-    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
-    reply->deleteLater();
-    if (error == QNetworkReply::OperationCanceledError)
+    const QPointer<QNetworkReply> reply = m_reply;
+    if (!reply)
+        return;
+    if (m_cache)
+        m_cache->abortRevalidation(tileSpec());
+    if (error == QNetworkReply::OperationCanceledError) {
         setFinished(true);
-    else
-        setError(QGeoTiledMapReply::CommunicationError, reply->errorString());
-
+        return;
+    }
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 503) // the tile fetcher backs off
+        setRetryAfter(reply->rawHeader("Retry-After"));
+    const QString errorString = reply->errorString();
+    releaseNetworkReply();
+    setError(QGeoTiledMapReply::CommunicationError, errorString);
 }
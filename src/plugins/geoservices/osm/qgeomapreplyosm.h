@@ -4,23 +4,31 @@
 #ifndef QGEOMAPREPLYOSM_H
 #define QGEOMAPREPLYOSM_H
 
+#include <QtCore/QPointer>
 #include <QtNetwork/QNetworkReply>
 #include <QtLocation/private/qgeotiledmapreply_p.h>
 
 QT_BEGIN_NAMESPACE
 
+class QGeoFileTileCacheOsm;
+
 class QGeoMapReplyOsm : public QGeoTiledMapReply
 {
     Q_OBJECT
 
 public:
     QGeoMapReplyOsm(QNetworkReply *reply, const QGeoTileSpec &spec, const QString &imageFormat,
-                    QObject *parent = nullptr);
+                    QGeoFileTileCacheOsm *cache, QObject *parent = nullptr);
     ~QGeoMapReplyOsm();
 
 private Q_SLOTS:
     void networkReplyFinished();
     void networkReplyError(QNetworkReply::NetworkError error);
+    void releaseNetworkReply();
+
+private:
+    QPointer<QNetworkReply> m_reply;
+    QPointer<QGeoFileTileCacheOsm> m_cache;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,69 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qgeoroutematrixreplyosm.h"
+#include "qgeoroutingmanagerengineosm.h"
+#include <QtLocation/private/qgeorouteparser_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QGeoRouteMatrixReplyOsm::QGeoRouteMatrixReplyOsm(QNetworkReply *reply,
+                                                 const QList<QGeoCoordinate> &sources,
+                                                 const QList<QGeoCoordinate> &destinations,
+                                                 const QGeoRouteRequest &request, QObject *parent)
+:   QGeoRouteMatrixReply(sources, destinations, request, parent)
+{
+    if (!reply) {
+        setError(QGeoRouteReply::UnknownError, QStringLiteral("Null reply"));
+        return;
+    }
+    connect(reply, &QNetworkReply::finished,
+            this, &QGeoRouteMatrixReplyOsm::networkReplyFinished);
+    connect(reply, &QNetworkReply::errorOccurred,
+            this, &QGeoRouteMatrixReplyOsm::networkReplyError);
+    connect(this, &QGeoRouteMatrixReply::aborted, reply, &QNetworkReply::abort);
+    connect(this, &QObject::destroyed, reply, &QObject::deleteLater);
+}
+
+QGeoRouteMatrixReplyOsm::~QGeoRouteMatrixReplyOsm()
+{
+}
+
+void QGeoRouteMatrixReplyOsm::networkReplyFinished()
+{
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError)
+        return;
+
+    QGeoRoutingManagerEngineOsm *engine = qobject_cast<QGeoRoutingManagerEngineOsm *>(parent());
+    const QGeoRouteParser *parser = engine->routeParser();
+
+    QGeoRouteMatrix matrix;
+    QString errorString;
+    QGeoRouteReply::Error error = parser->parseMatrixReply(matrix, errorString, reply->readAll());
+    if (error == QGeoRouteReply::NoError
+            && (matrix.rowCount() != sources().size()
+                || matrix.columnCount() != destinations().size())) {
+        error = QGeoRouteReply::ParseError;
+        errorString = QStringLiteral("The size of the matrix does not match the request");
+    }
+
+    if (error == QGeoRouteReply::NoError) {
+        setMatrix(matrix);
+        setFinished(true);
+    } else {
+        setError(error, errorString);
+    }
+}
+
+void QGeoRouteMatrixReplyOsm::networkReplyError(QNetworkReply::NetworkError error)
+{
+    Q_UNUSED(error);
+    QNetworkReply *reply = static_cast<QNetworkReply *>(sender());
+    reply->deleteLater();
+    setError(QGeoRouteReply::CommunicationError, reply->errorString());
+}
+
+QT_END_NAMESPACE
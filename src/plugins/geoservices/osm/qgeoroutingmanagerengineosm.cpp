@@ -3,8 +3,11 @@
 
 #include "qgeoroutingmanagerengineosm.h"
 #include "qgeoroutereplyosm.h"
+#include "qgeoroutematrixreplyosm.h"
 #include "qgeorouteparserosrmv4_p.h"
 #include "QtLocation/private/qgeorouteparserosrmv5_p.h"
+#include "QtLocation/private/qgeorouterequest_p.h"
+#include "QtLocation/private/qgeoroutingmanagerengine_p.h"
 
 #include <QtCore/QUrlQuery>
 
@@ -26,6 +29,14 @@ QGeoRoutingManagerEngineOsm::QGeoRoutingManagerEngineOsm(const QVariantMap &para
         m_urlPrefix = QStringLiteral("http://router.project-osrm.org/route/v1/driving/");
         // for v4 it was "http://router.project-osrm.org/viaroute"
 
+    // The table service lives next to the route service of the same server
+    if (parameters.contains(QStringLiteral("osm.routing.table_host"))) {
+        m_tableUrlPrefix = parameters.value(QStringLiteral("osm.routing.table_host")).toString();
+    } else if (m_urlPrefix.contains(QLatin1String("/route/v1/"))) {
+        m_tableUrlPrefix = m_urlPrefix;
+        m_tableUrlPrefix.replace(QLatin1String("/route/v1/"), QLatin1String("/table/v1/"));
+    }
+
     if (parameters.contains(QStringLiteral("osm.routing.apiversion"))
             && (parameters.value(QStringLiteral("osm.routing.apiversion")).toString().toLatin1() == QByteArray("v4")))
         m_routeParser = new QGeoRouteParserOsrmV4(this);
@@ -39,6 +50,12 @@ QGeoRoutingManagerEngineOsm::QGeoRoutingManagerEngineOsm(const QVariantMap &para
             m_routeParser->setTrafficSide(QGeoRouteParser::LeftHandTraffic);
     }
 
+    QGeoRoutingManagerEnginePrivate::get(this)->routeMatrix =
+            [this](const QList<QGeoCoordinate> &sources, const QList<QGeoCoordinate> &destinations,
+                   const QGeoRouteRequest &request) {
+        return calculateRouteMatrix(sources, destinations, request);
+    };
+
     *error = QGeoServiceProvider::NoError;
     errorString->clear();
 }
@@ -53,6 +70,8 @@ QGeoRouteReply* QGeoRoutingManagerEngineOsm::calculateRoute(const QGeoRouteReque
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
 
     networkRequest.setUrl(routeParser()->requestUrl(request, m_urlPrefix));
+    networkRequest.setPriority(
+            QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
 
     QNetworkReply *reply = m_networkManager->get(networkRequest);
 
@@ -66,6 +85,28 @@ QGeoRouteReply* QGeoRoutingManagerEngineOsm::calculateRoute(const QGeoRouteReque
     return routeReply;
 }
 
+QGeoRouteMatrixReply *QGeoRoutingManagerEngineOsm::calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                                                        const QList<QGeoCoordinate> &destinations,
+                                                                        const QGeoRouteRequest &request)
+{
+    // OSRM v4 servers and custom servers without a known table service are
+    // asked route by route, by QGeoRoutingManager
+    const QUrl url = m_tableUrlPrefix.isEmpty()
+            ? QUrl()
+            : routeParser()->matrixRequestUrl(sources, destinations, request, m_tableUrlPrefix);
+    if (!url.isValid() || sources.isEmpty() || destinations.isEmpty())
+        return nullptr;
+
+    QNetworkRequest networkRequest;
+    networkRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    networkRequest.setUrl(url);
+    networkRequest.setPriority(
+            QGeoRouteRequestPrivate::networkPriority<QNetworkRequest>(request.priority()));
+
+    QNetworkReply *reply = m_networkManager->get(networkRequest);
+    return new QGeoRouteMatrixReplyOsm(reply, sources, destinations, request, this);
+}
+
 const QGeoRouteParser *QGeoRoutingManagerEngineOsm::routeParser() const
 {
     return m_routeParser;
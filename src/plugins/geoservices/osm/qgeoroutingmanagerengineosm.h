@@ -11,6 +11,7 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QGeoRouteMatrixReply;
 
 class QGeoRoutingManagerEngineOsm : public QGeoRoutingManagerEngine
 {
@@ -30,10 +31,14 @@ private Q_SLOTS:
     void replyError(QGeoRouteReply::Error errorCode, const QString &errorString);
 
 private:
+    QGeoRouteMatrixReply *calculateRouteMatrix(const QList<QGeoCoordinate> &sources,
+                                               const QList<QGeoCoordinate> &destinations,
+                                               const QGeoRouteRequest &request);
     QNetworkAccessManager *m_networkManager;
     QGeoRouteParser *m_routeParser;
     QByteArray m_userAgent;
     QString m_urlPrefix;
+    QString m_tableUrlPrefix;
 };
 
 QT_END_NAMESPACE
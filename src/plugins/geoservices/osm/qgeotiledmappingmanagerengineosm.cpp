@@ -11,6 +11,7 @@
 #include <QtLocation/private/qgeotiledmap_p.h>
 #include <QtLocation/private/qgeofiletilecache_p.h>
 
+#include <QtCore/QFile>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkDiskCache>
 
@@ -187,13 +188,23 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
 
         if (!tmsServer.contains("%x"))
              tmsServer += QStringLiteral("%z/%x/%y.png");
+        // Mapbox Vector Tiles are rendered by the plugin
+        const QString tilePath = tmsServer.section(QLatin1Char('?'), 0, 0);
+        const QString format = tilePath.endsWith(QLatin1String(".pbf")) || tilePath.endsWith(QLatin1String(".mvt"))
+                ? tilePath.right(3) : QStringLiteral("png");
+        int maximumZoomLevel = 19;
+        if (parameters.contains(QStringLiteral("osm.mapping.custom.maximumzoomlevel")))
+            maximumZoomLevel = parameters.value(QStringLiteral("osm.mapping.custom.maximumzoomlevel")).toInt();
         m_providers.push_back(
             new QGeoTileProviderOsm( nmCached,
                 QGeoMapType(QGeoMapType::CustomMap, tr("Custom URL Map"), tr("Custom url map view set via urlprefix parameter"), false, false, 8, pluginName, cameraCaps),
                 { new TileProvider(tmsServer,
-                    QStringLiteral("png"),
+                    format,
                     mapCopyright,
-                    dataCopyright) }, cameraCaps
+                    dataCopyright,
+                    false,
+                    0,
+                    maximumZoomLevel) }, cameraCaps
                 ));
 
         m_providers.last()->disableRedirection();
@@ -280,6 +291,16 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
     }
 
 
+    if (parameters.contains(QStringLiteral("osm.mapping.custom.style"))) {
+        const QString styleFile = parameters.value(QStringLiteral("osm.mapping.custom.style")).toString();
+        QFile file(styleFile.startsWith(QLatin1String("qrc:")) ? styleFile.mid(3) : styleFile);
+        QString styleError;
+        if (!file.open(QIODevice::ReadOnly))
+            qWarning() << "Unable to open the vector tile style" << styleFile;
+        else if (!tileCache->setVectorStyle(file.readAll(), &styleError))
+            qWarning() << "Invalid vector tile style" << styleFile << styleError;
+    }
+
     setTileCache(tileCache);
 
 
@@ -289,8 +310,15 @@ QGeoTiledMappingManagerEngineOsm::QGeoTiledMappingManagerEngineOsm(const QVarian
         const QByteArray ua = parameters.value(QStringLiteral("osm.useragent")).toString().toLatin1();
         tileFetcher->setUserAgent(ua);
     }
+    tileFetcher->setTileCache(tileCache);
     setTileFetcher(tileFetcher);
 
+    // Expired tiles are fetched again in the background, they stay on screen meanwhile
+    connect(tileCache, &QGeoFileTileCacheOsm::tileExpired, tileFetcher,
+            [tileFetcher](const QGeoTileSpec &spec) {
+                tileFetcher->updateTileRequests(QSet<QGeoTileSpec>{ spec }, QSet<QGeoTileSpec>());
+            }, Qt::QueuedConnection);
+
     /* PREFETCHING */
     if (parameters.contains(QStringLiteral("osm.mapping.prefetching_style"))) {
         const QString prefetchingMode = parameters.value(QStringLiteral("osm.mapping.prefetching_style")).toString();
@@ -315,6 +343,8 @@ QGeoMap *QGeoTiledMappingManagerEngineOsm::createMap()
     QGeoTiledMap *map = new QGeoTiledMapOsm(this);
     connect(qobject_cast<QGeoFileTileCacheOsm *>(tileCache()), &QGeoFileTileCacheOsm::mapDataUpdated
             , map, &QGeoTiledMap::clearScene);
+    connect(qobject_cast<QGeoFileTileCacheOsm *>(tileCache()), &QGeoFileTileCacheOsm::tileDataUpdated,
+            map, &QGeoTiledMap::updateTile);
     map->setPrefetchStyle(m_prefetchStyle);
     return map;
 }
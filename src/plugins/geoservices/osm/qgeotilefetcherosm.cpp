@@ -3,8 +3,10 @@
 
 #include "qgeotilefetcherosm.h"
 #include "qgeomapreplyosm.h"
+#include "qgeofiletilecacheosm.h"
 
 #include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
 #include <QtLocation/private/qgeotilespec_p.h>
 #include <QtLocation/private/qgeotilefetcher_p_p.h>
@@ -12,6 +14,10 @@
 
 QT_BEGIN_NAMESPACE
 
+// Per host: keeps six HTTP/1.1 connections or an HTTP/2 one busy, while the
+// rest of the queue can still be cancelled when the map moves
+static const int requestsPerHost = 8;
+
 static bool providersResolved(const QList<QGeoTileProviderOsm *> &providers)
 {
     for (const QGeoTileProviderOsm *provider : providers)
@@ -60,6 +66,7 @@ QGeoTileFetcherOsm::QGeoTileFetcherOsm(const QList<QGeoTileProviderOsm *> &provi
             provider->resolveProvider();
         }
     }
+    updateMaximumConcurrentRequests();
     if (m_ready)
         readyUpdated();
 }
@@ -69,6 +76,12 @@ void QGeoTileFetcherOsm::setUserAgent(const QByteArray &userAgent)
     m_userAgent = userAgent;
 }
 
+// Cached tiles are requested conditionally, with the validators stored by the cache
+void QGeoTileFetcherOsm::setTileCache(QGeoFileTileCacheOsm *cache)
+{
+    m_tileCache = cache;
+}
+
 bool QGeoTileFetcherOsm::initialized() const
 {
     if (!m_ready) {
@@ -81,6 +94,7 @@ bool QGeoTileFetcherOsm::initialized() const
 
 void QGeoTileFetcherOsm::onProviderResolutionFinished(const QGeoTileProviderOsm *provider)
 {
+    updateMaximumConcurrentRequests();
     if ((m_ready = providersResolved(m_providers))) {
         qWarning("QGeoTileFetcherOsm: all providers resolved");
         readyUpdated();
@@ -90,6 +104,7 @@ void QGeoTileFetcherOsm::onProviderResolutionFinished(const QGeoTileProviderOsm
 
 void QGeoTileFetcherOsm::onProviderResolutionError(const QGeoTileProviderOsm *provider)
 {
+    updateMaximumConcurrentRequests();
     if ((m_ready = providersResolved(m_providers))) {
         qWarning("QGeoTileFetcherOsm: all providers resolved");
         readyUpdated();
@@ -117,15 +132,42 @@ QGeoTiledMapReply *QGeoTileFetcherOsm::getTileImage(const QGeoTileSpec &spec)
     }
     id -= 1; // TODO: make OSM map ids start from 0.
 
-    if (spec.zoom() > m_providers[id]->maximumZoomLevel() || spec.zoom() < m_providers[id]->minimumZoomLevel())
+    // Overzoomed vector tiles are drawn from their ancestor, see QGeoFileTileCacheOsm
+    const QGeoTileSpec source = m_providers[id]->sourceTile(spec);
+    if (source.zoom() > m_providers[id]->maximumZoomLevel() || source.zoom() < m_providers[id]->minimumZoomLevel())
         return nullptr;
 
-    const QUrl url = m_providers[id]->tileAddress(spec.x(), spec.y(), spec.zoom());
+    const QUrl url = m_providers[id]->tileAddress(source.x(), source.y(), source.zoom());
     QNetworkRequest request;
     request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
     request.setUrl(url);
-    QNetworkReply *reply = m_nm->get(request);
-    return new QGeoMapReplyOsm(reply, spec, m_providers[id]->format());
+    if (m_tileCache) {
+        const QGeoTileValidatorsOsm validators = m_tileCache->validators(spec);
+        if (!validators.etag.isEmpty())
+            request.setRawHeader("If-None-Match", validators.etag);
+        if (!validators.lastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", validators.lastModified);
+    }
+    const bool conditional = request.hasRawHeader("If-None-Match")
+            || request.hasRawHeader("If-Modified-Since");
+
+    // Map types and providers using the same server ask for the same
+    // address, and share one download. Conditional requests only validate
+    // the tile they were made for, so they are not shared.
+    QNetworkReply *reply = conditional ? nullptr : m_pendingReplies.value(url).data();
+    if (!reply || reply->isFinished()) {
+        reply = m_nm->get(request);
+        if (!conditional) {
+            m_pendingReplies.insert(url, reply);
+            connect(reply, &QNetworkReply::finished, this, [this, url, reply] {
+                const auto it = m_pendingReplies.constFind(url);
+                if (it != m_pendingReplies.cend() && it->data() == reply)
+                    m_pendingReplies.erase(it);
+            });
+        }
+    }
+    return new QGeoMapReplyOsm(reply, spec, m_providers[id]->format(), m_tileCache);
 }
 
 void QGeoTileFetcherOsm::readyUpdated()
@@ -133,4 +175,13 @@ void QGeoTileFetcherOsm::readyUpdated()
     updateTileRequests(QSet<QGeoTileSpec>(), QSet<QGeoTileSpec>());
 }
 
+void QGeoTileFetcherOsm::updateMaximumConcurrentRequests()
+{
+    int hosts = 1;
+    for (const QGeoTileProviderOsm *provider : std::as_const(m_providers))
+        hosts = qMax(hosts, provider->hostCount());
+    if (maximumConcurrentRequests() != hosts * requestsPerHost)
+        setMaximumConcurrentRequests(hosts * requestsPerHost);
+}
+
 QT_END_NAMESPACE
@@ -6,11 +6,16 @@
 
 #include "qgeotileproviderosm.h"
 #include <QtLocation/private/qgeotilefetcher_p.h>
+#include <QHash>
 #include <QList>
+#include <QPointer>
+#include <QUrl>
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QNetworkReply;
+class QGeoFileTileCacheOsm;
 class QGeoMappingManagerEngine;
 class QGeoTileFetcherOsmPrivate;
 
@@ -26,6 +31,7 @@ public:
                        QGeoMappingManagerEngine *parent);
 
     void setUserAgent(const QByteArray &userAgent);
+    void setTileCache(QGeoFileTileCacheOsm *cache);
 
 Q_SIGNALS:
     void providerDataUpdated(const QGeoTileProviderOsm *provider);
@@ -41,10 +47,13 @@ protected Q_SLOTS:
 private:
     QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override;
     void readyUpdated();
+    void updateMaximumConcurrentRequests();
 
     QByteArray m_userAgent;
     QList<QGeoTileProviderOsm *> m_providers;
     QNetworkAccessManager *m_nm;
+    QHash<QUrl, QPointer<QNetworkReply>> m_pendingReplies;
+    QPointer<QGeoFileTileCacheOsm> m_tileCache;
     bool m_ready;
 };
 
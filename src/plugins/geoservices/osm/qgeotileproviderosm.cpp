@@ -100,6 +100,29 @@ int QGeoTileProviderOsm::maximumZoomLevel() const
     return m_provider->maximumZoomLevel();
 }
 
+bool QGeoTileProviderOsm::isVector() const
+{
+    return isVectorFormat(format());
+}
+
+// Mapbox Vector Tiles, rendered by the plugin
+bool QGeoTileProviderOsm::isVectorFormat(const QString &format)
+{
+    return format == QLatin1String("pbf") || format == QLatin1String("mvt");
+}
+
+// The tile downloaded for spec. Vector tiles beyond the last zoom level of
+// the server are rendered from the part of their ancestor at that level.
+QGeoTileSpec QGeoTileProviderOsm::sourceTile(const QGeoTileSpec &spec) const
+{
+    const int maximumZoom = maximumZoomLevel();
+    if (spec.zoom() <= maximumZoom || !isVector())
+        return spec;
+    const int levels = spec.zoom() - maximumZoom;
+    return QGeoTileSpec(spec.plugin(), spec.mapId(), maximumZoom,
+                        spec.x() >> levels, spec.y() >> levels, spec.version());
+}
+
 bool QGeoTileProviderOsm::isHighDpi() const
 {
     if (!m_provider)
@@ -119,6 +142,13 @@ QGeoCameraCapabilities QGeoTileProviderOsm::cameraCapabilities() const
     return m_cameraCapabilities;
 }
 
+int QGeoTileProviderOsm::hostCount() const
+{
+    if (m_status != Resolved || !m_provider)
+        return 1;
+    return m_provider->hostCount();
+}
+
 const QGeoMapType &QGeoTileProviderOsm::mapType() const
 {
     return m_mapType;
@@ -217,7 +247,10 @@ void QGeoTileProviderOsm::updateCameraCapabilities()
 {
     // Set proper min/max ZoomLevel coming from the json, if available.
     m_cameraCapabilities.setMinimumZoomLevel(minimumZoomLevel());
-    m_cameraCapabilities.setMaximumZoomLevel(maximumZoomLevel());
+    // Vector tiles are drawn from their ancestors beyond the last zoom level
+    // of the server, up to the zoom levels of the other maps
+    if (!isVector())
+        m_cameraCapabilities.setMaximumZoomLevel(maximumZoomLevel());
 
     m_mapType = QGeoMapType(m_mapType.style(), m_mapType.name(), m_mapType.description(), m_mapType.mobile(),
                             m_mapType.night(), m_mapType.mapId(), m_mapType.pluginName(), m_cameraCapabilities,
@@ -386,9 +419,11 @@ void TileProvider::onNetworkReplyFinished()
      * respectively.
      *
      * UrlTemplate is required, and is the tile url template, with %x, %y and %z as
-     * placeholders for the actual parameters.
-     * Example:
+     * placeholders for the actual parameters. It can contain a list of alternatives in
+     * braces, typically subdomains, to spread the requests over several hosts.
+     * Examples:
      * http://localhost:8080/maps/%z/%x/%y.png
+     * https://{a,b,c}.tile.example.org/%z/%x/%y.png
      *
      * ImageFormat is required, and is the format of the tile.
      * Examples:
@@ -498,6 +533,15 @@ void TileProvider::setupProvider()
     if (m_maximumZoomLevel < 0 || m_maximumZoomLevel > 30 ||  m_maximumZoomLevel < m_minimumZoomLevel)
         return;
 
+    m_hostGroup.clear();
+    m_hosts.clear();
+    const qsizetype groupStart = m_urlTemplate.indexOf(QLatin1Char('{'));
+    const qsizetype groupEnd = m_urlTemplate.indexOf(QLatin1Char('}'), groupStart);
+    if (groupStart >= 0 && groupEnd > groupStart + 1) {
+        m_hostGroup = m_urlTemplate.mid(groupStart, groupEnd - groupStart + 1);
+        m_hosts = m_urlTemplate.mid(groupStart + 1, groupEnd - groupStart - 1).split(QLatin1Char(','));
+    }
+
     // Currently supporting only %x, %y and &z
     int offset[3];
     offset[0] = m_urlTemplate.indexOf(QLatin1String("%x"));
@@ -600,6 +644,11 @@ bool TileProvider::isHTTPS() const
     return m_urlTemplate.startsWith(QStringLiteral("https"));
 }
 
+int TileProvider::hostCount() const
+{
+    return qMax(1, int(m_hosts.size()));
+}
+
 void TileProvider::setStyleCopyRight(const QString &copyright)
 {
     m_copyRightStyle = copyright;
@@ -623,6 +672,9 @@ QUrl TileProvider::tileAddress(int x, int y, int z) const
     url += paramsSep[1];
     url += QString::number(params[paramsLUT[2]]);
     url += m_urlSuffix;
+    // Neighbouring tiles go to different hosts, a given tile always to the same
+    if (!m_hosts.isEmpty())
+        url.replace(m_hostGroup, m_hosts.at((uint(x) + uint(y)) % uint(m_hosts.size())));
     return QUrl(url);
 }
 
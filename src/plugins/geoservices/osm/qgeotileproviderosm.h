@@ -6,8 +6,10 @@
 
 #include <QtLocation/private/qgeomaptype_p.h>
 #include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
 #include <QtCore/QUrl>
 #include <QtCore/QList>
+#include <QtCore/QStringList>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
 #include <QtCore/QPointer>
@@ -61,6 +63,7 @@ public:
     inline const QDateTime &timestamp() const;
     inline bool isHighDpi() const;
     inline bool isHTTPS() const;
+    inline int hostCount() const;
     QUrl tileAddress(int x, int y, int z) const;
 
     // Optional properties, not needed to construct a provider
@@ -77,6 +80,8 @@ public:
     QString m_copyRightStyle;
     QString m_urlPrefix;
     QString m_urlSuffix;
+    QString m_hostGroup; // {a,b,c} in the template, replaced by one of m_hosts
+    QStringList m_hosts;
     int m_minimumZoomLevel;
     int m_maximumZoomLevel;
     QDateTime m_timestamp;
@@ -121,12 +126,17 @@ public:
     int minimumZoomLevel() const;
     int maximumZoomLevel() const;
     bool isHighDpi() const;
+    int hostCount() const;
+    bool isVector() const;
+    QGeoTileSpec sourceTile(const QGeoTileSpec &spec) const;
     const QGeoMapType &mapType() const;
     bool isValid() const;
     bool isResolved() const;
     QDateTime timestamp() const;
     QGeoCameraCapabilities cameraCapabilities() const;
 
+    static bool isVectorFormat(const QString &format);
+
 Q_SIGNALS:
     void resolutionFinished(const QGeoTileProviderOsm *provider);
     void resolutionError(const QGeoTileProviderOsm *provider);
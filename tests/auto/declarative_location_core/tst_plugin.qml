@@ -22,6 +22,30 @@ Item {
         }
     SignalSpy {id: invalidAttachedSpy; target: invalidPlugin; signalName: "attached"}
 
+    Plugin {
+        id: sharedPlugin1
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+        PluginParameter { name: "supported"; value: true }
+    }
+    Plugin {
+        id: sharedPlugin2
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+        PluginParameter { name: "supported"; value: true }
+    }
+    Plugin {
+        id: sharedPlugin3
+        name: "qmlgeo.test.plugin"
+        allowExperimental: true
+        PluginParameter { name: "supported"; value: true }
+        PluginParameter { name: "finishRequestImmediately"; value: true }
+    }
+    SignalSpy {id: sharedAttachedSpy1; target: sharedPlugin1; signalName: "attached"}
+    SignalSpy {id: sharedAttachedSpy2; target: sharedPlugin2; signalName: "attached"}
+    Place { id: sharedPlace; name: "Shared place" }
+    Place { id: sharedReadPlace }
+
     Plugin {
         id: requiredPlugin
         allowExperimental: true
@@ -109,6 +133,53 @@ Item {
             verify(!testPlugin.supportsPlaces(Plugin.RemovePlaceFeature))
         }
 
+        function test_shared() {
+            verify(sharedPlugin1.isAttached)
+            verify(sharedPlugin2.isAttached)
+            sharedAttachedSpy1.clear()
+            sharedAttachedSpy2.clear()
+
+            // the test plugin keeps the saved places in its place manager
+            // engine, one per provider
+            sharedPlace.plugin = sharedPlugin1
+            sharedPlace.save()
+            tryCompare(sharedPlace, "status", Place.Ready)
+            verify(sharedPlace.placeId !== "")
+
+            // the same provider, so the same engine, for the same parameters
+            sharedReadPlace.plugin = sharedPlugin2
+            sharedReadPlace.placeId = sharedPlace.placeId
+            sharedReadPlace.getDetails()
+            tryCompare(sharedReadPlace, "status", Place.Ready)
+            compare(sharedReadPlace.name, "Shared place")
+
+            // another provider for other parameters
+            sharedReadPlace.plugin = sharedPlugin3
+            sharedReadPlace.placeId = sharedPlace.placeId
+            sharedReadPlace.getDetails()
+            tryCompare(sharedReadPlace, "status", Place.Error)
+
+            // the provider shared with sharedPlugin2 is left alone
+            sharedPlugin1.locales = "fr_FR"
+            compare(sharedAttachedSpy1.count, 1)
+            compare(sharedAttachedSpy2.count, 0)
+            verify(sharedPlugin1.supportsMapping())
+            verify(sharedPlugin2.supportsMapping())
+            sharedReadPlace.plugin = sharedPlugin1
+            sharedReadPlace.placeId = sharedPlace.placeId
+            sharedReadPlace.getDetails()
+            tryCompare(sharedReadPlace, "status", Place.Error)
+            sharedReadPlace.plugin = sharedPlugin2
+            sharedReadPlace.placeId = sharedPlace.placeId
+            sharedReadPlace.getDetails()
+            tryCompare(sharedReadPlace, "status", Place.Ready)
+
+            // a provider used by a single Plugin is changed in place
+            sharedPlugin1.locales = "de_DE"
+            compare(sharedAttachedSpy1.count, 1)
+            verify(sharedPlugin1.supportsMapping())
+        }
+
         function test_locale() {
             compare(osmPlugin.locales, [Qt.locale().name]);
 
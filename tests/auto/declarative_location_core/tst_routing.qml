@@ -153,6 +153,8 @@ Item {
             compare (emptyQuery.waypoints.length, 0, "Waypoints")
             compare (emptyQuery.excludedAreas.length, 0, "excluded areas")
             compare (emptyQuery.featureTypes.length, 0, "Feature types")
+            compare (emptyQuery.timeout, 0, "Timeout")
+            compare (emptyQuery.priority, RouteQuery.NormalPriority, "Priority")
         }
 
         RouteQuery {
@@ -193,6 +195,7 @@ Item {
         SignalSpy {id: numberAlterNativeRoutesSpy; target: emptyQuery; signalName: "numberAlternativeRoutesChanged"}
         SignalSpy {id: routeOptimizationsSpy; target: emptyQuery; signalName: "routeOptimizationsChanged"}
         SignalSpy {id: queryDetailsChangedSpy; target: emptyQuery; signalName: "queryDetailsChanged"}
+        SignalSpy {id: prioritySpy; target: emptyQuery; signalName: "priorityChanged"}
         function test_model_setters() {
             // Autoupdate
             compare(autoUpdateSpy.count, 0)
@@ -409,6 +412,18 @@ Item {
             compare(queryDetailsChangedSpy.count, 1)
             compare(emptyQuery.numberAlternativeRoutes, 2)
 
+            // Priority, which does not change the query details
+            queryDetailsChangedSpy.clear()
+            compare(prioritySpy.count, 0)
+            emptyQuery.priority = RouteQuery.HighPriority
+            compare(prioritySpy.count, 1)
+            compare(queryDetailsChangedSpy.count, 0)
+            compare(emptyQuery.priority, RouteQuery.HighPriority)
+            emptyQuery.priority = RouteQuery.HighPriority
+            compare(prioritySpy.count, 1)
+            emptyQuery.priority = RouteQuery.NormalPriority
+            compare(prioritySpy.count, 2)
+
             // Route optimization
             queryDetailsChangedSpy.clear()
             compare(routeOptimizationsSpy.count, 0)
@@ -116,6 +116,26 @@ Item {
     }
     SignalSpy { id: visibleAreaSpy; target: mapVisibleArea; signalName: 'visibleAreaChanged'}
     SignalSpy { id: visibleAreaUnsupportedSpy; target: mapVisibleAreaUnsupported; signalName: 'visibleAreaChanged'}
+    SignalSpy { id: sharedMapReadySpy; signalName: 'mapReadyChanged'}
+
+    Component {
+        id: sharedPluginComponent
+        Plugin {
+            name: "qmlgeo.test.plugin"
+            allowExperimental: true
+            PluginParameter { name: "extraMapTypeName"; value: "SharedPluginMapType" }
+        }
+    }
+    Component {
+        id: sharedPluginMapComponent
+        Map {
+            width: 100; height: 100
+            MapCircle {
+                center: QtPositioning.coordinate(10, 11)
+                radius: 1000
+            }
+        }
+    }
 
     TestCase {
         when: windowShown && allMapsReady
@@ -651,5 +671,38 @@ Item {
             tryCompare(visibleAreaSpy, "count", 1)
             verify(mapVisibleAreaUnsupported.visibleArea, Qt.rect(0,0,256,256))
         }
+
+        function test_shared_plugin_reconfigured()
+        {
+            // Two identical Plugins share one provider. Changing the locale of
+            // one moves it to a provider of its own, and the Map using it must
+            // follow before the other Plugin releases the shared provider.
+            var usedPlugin = createTemporaryObject(sharedPluginComponent, this)
+            var otherPlugin = createTemporaryObject(sharedPluginComponent, this)
+            verify(usedPlugin.isAttached)
+            verify(otherPlugin.isAttached)
+
+            var sharedMap = createTemporaryObject(sharedPluginMapComponent, this,
+                                                  { plugin: usedPlugin })
+            tryCompare(sharedMap, "mapReady", true)
+            compare(sharedMap.mapItems.length, 1)
+
+            sharedMapReadySpy.target = sharedMap
+            sharedMapReadySpy.clear()
+            usedPlugin.locales = "fr_FR"
+            tryCompare(sharedMapReadySpy, "count", 2)
+            verify(sharedMap.mapReady)
+            compare(sharedMap.mapItems.length, 1)
+
+            otherPlugin.destroy()
+            wait(0)
+
+            compare(sharedMap.supportedMapTypes.length, 5)
+            sharedMap.zoomLevel = 4
+            sharedMap.center = coordinate2
+            compare(sharedMap.zoomLevel, 4)
+            compare(sharedMap.center, coordinate2)
+            wait(50)
+        }
     }
 }
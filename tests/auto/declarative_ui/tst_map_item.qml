@@ -196,6 +196,8 @@ Item {
             SignalSpy {id: preMapRouteLineColorChanged; target: parent.line; signalName: "colorChanged"}
         }
     }
+    SignalSpy { id: mapItemsChangedSpy; target: map; signalName: "mapItemsChanged" }
+
     TestCase {
         name: "MapItems"
         when: windowShown && map.mapReady
@@ -395,6 +397,136 @@ Item {
             compare(map.mapItems.length, numItemsOnMap + 3)
         }
 
+        function test_add_remove_map_items()
+        {
+            var numItemsOnMap = map.mapItems.length
+            mapItemsChangedSpy.clear()
+            map.addMapItems([extMapCircle, extMapQuickItem])
+            compare(map.mapItems.length, numItemsOnMap + 2)
+            compare(mapItemsChangedSpy.count, 1)
+            // items already on the map are skipped
+            map.addMapItems([extMapCircle])
+            compare(map.mapItems.length, numItemsOnMap + 2)
+            compare(mapItemsChangedSpy.count, 1)
+            map.removeMapItem(extMapCircle)
+            compare(map.mapItems.length, numItemsOnMap + 1)
+            compare(mapItemsChangedSpy.count, 2)
+            map.removeMapItems([extMapCircle, extMapQuickItem])
+            compare(map.mapItems.length, numItemsOnMap)
+            compare(mapItemsChangedSpy.count, 3)
+            // nothing left to remove
+            map.removeMapItems([extMapCircle, extMapQuickItem])
+            compare(mapItemsChangedSpy.count, 3)
+        }
+
+        function test_items_at()
+        {
+            var center = map.center
+            map.center = QtPositioning.coordinate(20, 19)
+            verify(LocationTestHelper.waitForPolished(map))
+            var point = map.fromCoordinate(QtPositioning.coordinate(20, 19))
+            verify(map.itemsAt(point).indexOf(preMapPolyline) >= 0)
+            // both segments head west of the vertex
+            var east = Qt.point(point.x + 40, point.y)
+            compare(map.itemsAt(east).indexOf(preMapPolyline), -1)
+            verify(map.itemsAt(east, 45).indexOf(preMapPolyline) >= 0)
+            // hidden items are not hit
+            preMapPolyline.visible = false
+            compare(map.itemsAt(point).indexOf(preMapPolyline), -1)
+            preMapPolyline.visible = true
+            map.center = center
+        }
+
+        function test_polyline_backend()
+        {
+            compare(preMapPolyline.backend, MapPolyline.Software)
+            var center = map.center
+            map.center = QtPositioning.coordinate(20, 19)
+            preMapPolyline.backend = MapPolyline.Shader
+            compare(preMapPolyline.backend, MapPolyline.Shader)
+            verify(LocationTestHelper.waitForPolished(map))
+            // only the line is hit
+            var point = map.fromCoordinate(QtPositioning.coordinate(20, 19))
+            verify(map.itemsAt(point).indexOf(preMapPolyline) >= 0)
+            var east = Qt.point(point.x + 40, point.y)
+            compare(map.itemsAt(east).indexOf(preMapPolyline), -1)
+            verify(map.itemsAt(east, 45).indexOf(preMapPolyline) >= 0)
+            // the item bounds the line, instead of covering the map
+            var zoomLevel = map.zoomLevel
+            map.zoomLevel = 3
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(preMapPolyline.width > 0 && preMapPolyline.width < map.width)
+            verify(preMapPolyline.height > 0 && preMapPolyline.height < map.height)
+            map.zoomLevel = zoomLevel
+            verify(LocationTestHelper.waitForPolished(map))
+            preMapPolyline.backend = MapPolyline.Software
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(map.itemsAt(point).indexOf(preMapPolyline) >= 0)
+            map.center = center
+        }
+
+        function test_polygon_backend()
+        {
+            compare(preMapPolygon.backend, MapPolygon.Software)
+            var center = map.center
+            var zoomLevel = map.zoomLevel
+            map.center = QtPositioning.coordinate(20, 8)
+            preMapPolygon.backend = MapPolygon.Shader
+            compare(preMapPolygon.backend, MapPolygon.Shader)
+            verify(LocationTestHelper.waitForPolished(map))
+            // only the fill is hit
+            var inside = map.fromCoordinate(QtPositioning.coordinate(20, 7))
+            var outside = map.fromCoordinate(QtPositioning.coordinate(20, 12))
+            verify(map.itemsAt(inside).indexOf(preMapPolygon) >= 0)
+            compare(map.itemsAt(outside).indexOf(preMapPolygon), -1)
+            // zooming in and back reuses or rebuilds the tessellation
+            map.zoomLevel = zoomLevel + 2.5
+            verify(LocationTestHelper.waitForPolished(map))
+            inside = map.fromCoordinate(QtPositioning.coordinate(20, 7))
+            verify(map.itemsAt(inside).indexOf(preMapPolygon) >= 0)
+            // the item bounds the polygon, instead of covering the map
+            map.zoomLevel = 3
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(preMapPolygon.width > 0 && preMapPolygon.width < map.width)
+            verify(preMapPolygon.height > 0 && preMapPolygon.height < map.height)
+            map.zoomLevel = zoomLevel
+            verify(LocationTestHelper.waitForPolished(map))
+            preMapPolygon.backend = MapPolygon.Software
+            verify(LocationTestHelper.waitForPolished(map))
+            inside = map.fromCoordinate(QtPositioning.coordinate(20, 7))
+            verify(map.itemsAt(inside).indexOf(preMapPolygon) >= 0)
+            map.center = center
+        }
+
+        function test_circle_perimeter()
+        {
+            map.center = preMapCircle.center
+            verify(LocationTestHelper.waitForPolished(map))
+            var width = preMapCircle.width
+            var height = preMapCircle.height
+            verify(width > 0)
+            // moving along a parallel keeps the size
+            preMapCircle.center = QtPositioning.coordinate(10, 31)
+            map.center = preMapCircle.center
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(fuzzy_compare(preMapCircle.width, width, 1))
+            verify(fuzzy_compare(preMapCircle.height, height, 1))
+            // further north, the same radius is larger on the map
+            preMapCircle.center = QtPositioning.coordinate(60, 31)
+            map.center = preMapCircle.center
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(preMapCircle.width > 1.5 * width)
+            var northWidth = preMapCircle.width
+            // a small great circle is the scaled circle
+            preMapCircle.referenceSurface = QtLocation.ReferenceSurface.Globe
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(fuzzy_compare(preMapCircle.width, northWidth, 1))
+            preMapCircle.radius = 2000000
+            verify(LocationTestHelper.waitForPolished(map))
+            verify(preMapCircle.height > 0)
+            preMapCircle.referenceSurface = QtLocation.ReferenceSurface.Map
+        }
+
         function test_drag()
         {
             // basic drags, drag rectangle
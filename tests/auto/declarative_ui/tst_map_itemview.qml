@@ -20,6 +20,7 @@ Item {
                                 && mapForView.mapReady
                                 && mapForTestingListModel.mapReady
                                 && mapForTestingRouteModel.mapReady
+                                && mapForTestingVirtualization.mapReady
 
     MapItemView {
         id: routeItemViewExtra
@@ -274,6 +275,36 @@ Item {
         }
     }
 
+    Map {
+        id: mapForTestingVirtualization
+
+        property int mapItemsLength: mapItems.length
+
+        center: mapDefaultCenter
+        plugin: testPlugin
+        anchors.fill: parent
+        zoomLevel: 2
+
+        MapItemView {
+            id: virtualItemView
+            virtualization: true
+            geoRole: "position"
+            incubateDelegates: false
+            add: null
+            remove: null
+            model: ListModel {
+                id: virtualListModel
+                dynamicRoles: true
+            }
+            delegate: Component {
+                MapCircle {
+                    radius: 1000
+                    center: position
+                }
+            }
+        }
+    }
+
     TestCase {
         name: "MapItem"
         when: windowShown && allMapsReady
@@ -484,6 +515,36 @@ Item {
             tryCompare(mapForTestingListModel, "mapItemsLength", 3)
         }
 
+        function test_virtualization() {
+            compare(mapForTestingVirtualization.mapItems.length, 0) // precondition
+            virtualListModel.append({ "position": QtPositioning.coordinate(10, 30) })
+            virtualListModel.append({ "position": QtPositioning.coordinate(12, 32) })
+            virtualListModel.append({ "position": QtPositioning.coordinate(8, 28) })
+            virtualListModel.append({ "position": QtPositioning.coordinate(10, -150) })
+            virtualListModel.append({ "position": QtPositioning.coordinate(10, 170) })
+            // only the rows around the center have a delegate
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 3)
+            compare(virtualItemView.mapItems.length, 3)
+
+            // the delegates follow the camera, across the antimeridian
+            mapForTestingVirtualization.center = QtPositioning.coordinate(10, -150)
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 2)
+            mapForTestingVirtualization.center = mapDefaultCenter
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 3)
+
+            // moving a row updates its delegate
+            virtualListModel.setProperty(0, "position", QtPositioning.coordinate(10, -150))
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 2)
+
+            virtualItemView.virtualization = false
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 5)
+            virtualItemView.virtualization = true
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 2)
+
+            virtualListModel.clear()
+            tryCompare(mapForTestingVirtualization, "mapItemsLength", 0)
+        }
+
         function test_routemodel() {
             testModel.reset();
             mapItemsChangedSpy.clear()
@@ -0,0 +1,82 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+import QtTest
+import QtPositioning
+import QtLocation
+
+Item {
+    id: page
+    x: 0; y: 0;
+    width: 240
+    height: 240
+    Plugin { id: testPlugin; name : "qmlgeo.test.plugin"; allowExperimental: true }
+
+    ListModel {
+        id: markerModel
+        ListElement { icon: 0 }
+    }
+
+    Map {
+        id: map
+        width: 240
+        height: 240
+        plugin: testPlugin
+        center: QtPositioning.coordinate(0, 0)
+        zoomLevel: 3
+
+        MapMarkerLayer {
+            id: layer
+            model: markerModel
+            iconRole: "icon"
+            SignalSpy { id: countSpy; target: parent; signalName: "countChanged" }
+        }
+    }
+
+    TestCase {
+        name: "MapMarkerLayer"
+        when: windowShown
+
+        function init() {
+            markerModel.clear()
+            countSpy.clear()
+        }
+
+        function test_count() {
+            markerModel.append({ coordinate: QtPositioning.coordinate(10, 10), icon: 0 })
+            markerModel.append({ coordinate: QtPositioning.coordinate(-10, 20), icon: 1 })
+            tryCompare(layer, "count", 2)
+            markerModel.append({ coordinate: QtPositioning.coordinate(), icon: 1 })
+            markerModel.append({ coordinate: QtPositioning.coordinate(5, -30), icon: 1 })
+            // Rows without a valid coordinate are not drawn
+            tryCompare(layer, "count", 3)
+            markerModel.remove(0)
+            tryCompare(layer, "count", 2)
+            markerModel.clear()
+            tryCompare(layer, "count", 0)
+        }
+
+        function test_coordinate_role() {
+            markerModel.append({ coordinate: QtPositioning.coordinate(10, 10),
+                                 position: QtPositioning.coordinate(10, 10), icon: 0 })
+            tryCompare(layer, "count", 1)
+            layer.coordinateRole = "missing"
+            tryCompare(layer, "count", 0)
+            layer.coordinateRole = "position"
+            tryCompare(layer, "count", 1)
+            layer.coordinateRole = "coordinate"
+        }
+
+        function test_fit_viewport() {
+            markerModel.append({ coordinate: QtPositioning.coordinate(20, 40), icon: 0 })
+            markerModel.append({ coordinate: QtPositioning.coordinate(30, 60), icon: 0 })
+            tryCompare(layer, "count", 2)
+            map.fitViewportToMapItems([layer])
+            verify(map.center.latitude > 20 && map.center.latitude < 30)
+            verify(map.center.longitude > 40 && map.center.longitude < 60)
+            map.center = QtPositioning.coordinate(0, 0)
+            map.zoomLevel = 3
+        }
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtLocation/private/qgeoclusterindex_p.h>
+
+#include <QtPositioning/QGeoRectangle>
+#include <QtTest/QtTest>
+
+#include <algorithm>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoClusterIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void clusters();
+    void leaves();
+    void expansionZoomLevel();
+    void antimeridian();
+    void invalidCoordinates();
+
+private:
+    static QGeoRectangle world();
+    static QList<QGeoCoordinate> points();
+};
+
+QGeoRectangle tst_QGeoClusterIndex::world()
+{
+    return QGeoRectangle(QGeoCoordinate(85.0, -180.0), QGeoCoordinate(-85.0, 180.0));
+}
+
+// three points a few hundred meters apart in one town, and one far away
+QList<QGeoCoordinate> tst_QGeoClusterIndex::points()
+{
+    return { QGeoCoordinate(50.0, 10.0), QGeoCoordinate(50.001, 10.001),
+             QGeoCoordinate(50.002, 10.0), QGeoCoordinate(40.0, -3.0) };
+}
+
+void tst_QGeoClusterIndex::empty()
+{
+    QGeoClusterIndex index;
+    QVERIFY(index.clusters(world(), 5).isEmpty());
+
+    index.load({});
+    QCOMPARE(index.pointCount(), qsizetype(0));
+    QVERIFY(index.clusters(world(), 5).isEmpty());
+    QVERIFY(index.leaves(0).isEmpty());
+}
+
+void tst_QGeoClusterIndex::clusters()
+{
+    QGeoClusterIndex index;
+    index.load(points());
+    QCOMPARE(index.pointCount(), qsizetype(4));
+
+    QList<QGeoClusterIndex::Cluster> clusters = index.clusters(world(), 5);
+    QCOMPARE(clusters.size(), qsizetype(2));
+    std::sort(clusters.begin(), clusters.end(), [](const auto &a, const auto &b) {
+        return a.count < b.count;
+    });
+    QVERIFY(!clusters.at(0).isCluster());
+    QCOMPARE(clusters.at(0).id, qint64(3));
+    QCOMPARE(clusters.at(0).coordinate, QGeoCoordinate(40.0, -3.0));
+    QVERIFY(clusters.at(1).isCluster());
+    QCOMPARE(clusters.at(1).count, qsizetype(3));
+    QVERIFY(clusters.at(1).id >= index.pointCount());
+    QVERIFY(qAbs(clusters.at(1).coordinate.latitude() - 50.001) < 0.001);
+    QVERIFY(qAbs(clusters.at(1).coordinate.longitude() - 10.0) < 0.001);
+
+    // above the maximum zoom level, every point is on its own
+    clusters = index.clusters(world(), index.maximumZoomLevel() + 1);
+    QCOMPARE(clusters.size(), qsizetype(4));
+    for (const QGeoClusterIndex::Cluster &cluster : std::as_const(clusters))
+        QVERIFY(!cluster.isCluster());
+
+    // only the region is searched
+    clusters = index.clusters(QGeoRectangle(QGeoCoordinate(45.0, -10.0),
+                                            QGeoCoordinate(35.0, 0.0)), 5);
+    QCOMPARE(clusters.size(), qsizetype(1));
+    QCOMPARE(clusters.at(0).id, qint64(3));
+
+    // a larger radius merges everything at a low zoom level
+    index.setRadius(2000.0);
+    index.load(points());
+    clusters = index.clusters(world(), 2);
+    QCOMPARE(clusters.size(), qsizetype(1));
+    QCOMPARE(clusters.at(0).count, qsizetype(4));
+
+    // unless more points are required
+    index.setRadius(60.0);
+    index.setMinimumPoints(4);
+    index.load(points());
+    QCOMPARE(index.clusters(world(), 5).size(), qsizetype(4));
+}
+
+void tst_QGeoClusterIndex::leaves()
+{
+    QGeoClusterIndex index;
+    index.load(points());
+
+    const QList<QGeoClusterIndex::Cluster> clusters = index.clusters(world(), 3);
+    for (const QGeoClusterIndex::Cluster &cluster : clusters) {
+        QList<qsizetype> leaves = index.leaves(cluster.id);
+        std::sort(leaves.begin(), leaves.end());
+        if (cluster.isCluster()) {
+            QCOMPARE(leaves, QList<qsizetype>({ 0, 1, 2 }));
+
+            qsizetype count = 0;
+            const QList<QGeoClusterIndex::Cluster> children = index.children(cluster.id);
+            QVERIFY(!children.isEmpty());
+            for (const QGeoClusterIndex::Cluster &child : children)
+                count += child.count;
+            QCOMPARE(count, cluster.count);
+        } else {
+            QCOMPARE(leaves, QList<qsizetype>({ 3 }));
+            QVERIFY(index.children(cluster.id).isEmpty());
+        }
+    }
+}
+
+void tst_QGeoClusterIndex::expansionZoomLevel()
+{
+    QGeoClusterIndex index;
+    index.load(points());
+
+    const QGeoRectangle town(QGeoCoordinate(51.0, 9.0), QGeoCoordinate(49.0, 11.0));
+    const QList<QGeoClusterIndex::Cluster> clusters = index.clusters(town, 5);
+    QCOMPARE(clusters.size(), qsizetype(1));
+    QCOMPARE(index.expansionZoomLevel(3), -1);
+
+    const int zoomLevel = index.expansionZoomLevel(clusters.first().id);
+    QVERIFY(zoomLevel > 5);
+    QVERIFY(zoomLevel <= index.maximumZoomLevel() + 1);
+    QCOMPARE(index.clusters(town, zoomLevel - 1).size(), qsizetype(1));
+    QVERIFY(index.clusters(town, zoomLevel).size() > 1);
+}
+
+void tst_QGeoClusterIndex::antimeridian()
+{
+    QGeoClusterIndex index;
+    index.load({ QGeoCoordinate(0.0, 179.5), QGeoCoordinate(0.0, -179.5),
+                 QGeoCoordinate(0.0, 0.0) });
+
+    const QGeoRectangle region(QGeoCoordinate(1.0, 179.0), QGeoCoordinate(-1.0, -179.0));
+    QList<QGeoClusterIndex::Cluster> clusters = index.clusters(region, 10);
+    std::sort(clusters.begin(), clusters.end(), [](const auto &a, const auto &b) {
+        return a.id < b.id;
+    });
+    QCOMPARE(clusters.size(), qsizetype(2));
+    QCOMPARE(clusters.at(0).id, qint64(0));
+    QCOMPARE(clusters.at(1).id, qint64(1));
+}
+
+void tst_QGeoClusterIndex::invalidCoordinates()
+{
+    QGeoClusterIndex index;
+    index.load({ QGeoCoordinate(10.0, 10.0), QGeoCoordinate(), QGeoCoordinate(-10.0, -10.0) });
+    QCOMPARE(index.pointCount(), qsizetype(3));
+
+    QList<QGeoClusterIndex::Cluster> clusters = index.clusters(world(), 10);
+    std::sort(clusters.begin(), clusters.end(), [](const auto &a, const auto &b) {
+        return a.id < b.id;
+    });
+    QCOMPARE(clusters.size(), qsizetype(2));
+    QCOMPARE(clusters.at(0).id, qint64(0));
+    QCOMPARE(clusters.at(1).id, qint64(2));
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoClusterIndex)
+
+#include "tst_qgeoclusterindex.moc"
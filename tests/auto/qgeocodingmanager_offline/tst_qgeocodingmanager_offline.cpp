@@ -0,0 +1,257 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QBuffer>
+#include <QtTest/QtTest>
+
+#include <QtLocation/QGeoCodeReply>
+#include <QtLocation/QGeoCodingManager>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtPositioning/QGeoAddress>
+#include <QtPositioning/QGeoLocation>
+#include <QtPositioning/QGeoRectangle>
+
+#include "qgeocodeindexoffline.h"
+
+QT_USE_NAMESPACE
+
+class tst_QGeocodingManagerOffline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void normalize_data();
+    void normalize();
+    void csvImport();
+    void prefixLookup();
+
+    void missingParameters();
+    void geocodeText();
+    void geocodeCompletion();
+    void geocodeAddress();
+    void geocodeBoundsAndPaging();
+    void reverseGeocodeAddressPoint();
+    void reverseGeocodeStreet();
+    void reverseGeocodeTooFar();
+
+private:
+    QList<QGeoLocation> waitForLocations(QGeoCodeReply *reply);
+
+    QGeoServiceProvider *m_provider = nullptr;
+    QGeoCodingManager *m_manager = nullptr;
+};
+
+void tst_QGeocodingManagerOffline::initTestCase()
+{
+    const QString geoJson = QFINDTESTDATA("addresses.json");
+    QVERIFY(!geoJson.isEmpty());
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.geocoding.geojson"), geoJson);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    m_manager = m_provider->geocodingManager();
+    QVERIFY2(m_manager, qPrintable(m_provider->geocodingErrorString()));
+}
+
+void tst_QGeocodingManagerOffline::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+void tst_QGeocodingManagerOffline::normalize_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QStringList>("tokens");
+
+    QTest::newRow("case") << QStringLiteral("12 MAIN Street")
+                          << QStringList({ QStringLiteral("12"), QStringLiteral("main"),
+                                           QStringLiteral("street") });
+    QTest::newRow("abbreviation") << QStringLiteral("12 Main St.")
+                                  << QStringList({ QStringLiteral("12"), QStringLiteral("main"),
+                                                   QStringLiteral("street") });
+    QTest::newRow("diacritics") << QStringLiteral("Rue de l'Église")
+                                << QStringList({ QStringLiteral("rue"), QStringLiteral("de"),
+                                                 QStringLiteral("l"), QStringLiteral("eglise") });
+    QTest::newRow("sharp s") << QStringLiteral("Hauptstraße")
+                             << QStringList(QStringLiteral("hauptstrasse"));
+    QTest::newRow("compound") << QStringLiteral("Hauptstr.")
+                              << QStringList(QStringLiteral("hauptstrasse"));
+}
+
+void tst_QGeocodingManagerOffline::normalize()
+{
+    QFETCH(QString, text);
+    QFETCH(QStringList, tokens);
+    QCOMPARE(QGeoCodeIndexOffline::normalize(text), tokens);
+}
+
+void tst_QGeocodingManagerOffline::csvImport()
+{
+    QFile file(QFINDTESTDATA("addresses.csv"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QGeoCodeIndexOfflineBuilder builder;
+    QCOMPARE(builder.addCsv(&file), 2);
+
+    QGeoCodeIndexOffline index;
+    QVERIFY(index.setData(builder.build()));
+    QCOMPARE(index.count(), 2u);
+    QCOMPARE(index.matchingToken(QStringLiteral("hauptstrasse")).size(), 2);
+    QCOMPARE(index.matchingToken(QStringLiteral("munchen")).size(), 2);
+    QCOMPARE(index.matchingToken(QStringLiteral("2a")).size(), 1);
+    QCOMPARE(index.address(1).city(), QStringLiteral("München"));
+    QCOMPARE(index.coordinate(1), QGeoCoordinate(48.1372, 11.5752));
+
+    QBuffer noCoordinates;
+    noCoordinates.setData("street,city\nMain Street,Springfield\n");
+    QVERIFY(noCoordinates.open(QIODevice::ReadOnly));
+    QString errorString;
+    QCOMPARE(builder.addCsv(&noCoordinates, &errorString), -1);
+    QVERIFY(!errorString.isEmpty());
+}
+
+void tst_QGeocodingManagerOffline::prefixLookup()
+{
+    QGeoCodeIndexOfflineBuilder builder;
+    const char *const streets[] = { "Main Street", "Mainway", "Maple Road", "Market Lane" };
+    for (const char *street : streets) {
+        QGeoCodeOfflineAddress address;
+        address.address.setStreet(QString::fromLatin1(street));
+        address.coordinate = QGeoCoordinate(10.0, 10.0);
+        builder.addAddress(address);
+    }
+
+    QGeoCodeIndexOffline index;
+    QVERIFY(index.setData(builder.build()));
+    QCOMPARE(index.matchingPrefix(QStringLiteral("ma"), -1), QList<quint32>({ 0, 1, 2, 3 }));
+    QCOMPARE(index.matchingPrefix(QStringLiteral("mai"), -1), QList<quint32>({ 0, 1 }));
+    QCOMPARE(index.matchingPrefix(QStringLiteral("main"), -1), QList<quint32>({ 0, 1 }));
+    QCOMPARE(index.matchingToken(QStringLiteral("main")), QList<quint32>({ 0 }));
+    QVERIFY(index.matchingPrefix(QStringLiteral("x"), -1).isEmpty());
+    QVERIFY(index.matchingToken(QStringLiteral("mai")).isEmpty());
+}
+
+void tst_QGeocodingManagerOffline::missingParameters()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.geocodingManager());
+    QCOMPARE(provider.geocodingError(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_QGeocodingManagerOffline::geocodeText()
+{
+    QList<QGeoLocation> locations = waitForLocations(m_manager->geocode(QStringLiteral("12 main st")));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().streetNumber(), QStringLiteral("12"));
+    QCOMPARE(locations.first().address().postalCode(), QStringLiteral("4000"));
+    QCOMPARE(locations.first().coordinate(), QGeoCoordinate(-27.0, 153.0));
+
+    // the street itself ranks before the houses on it
+    locations = waitForLocations(m_manager->geocode(QStringLiteral("Main Street")));
+    QCOMPARE(locations.size(), 3);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("Main Street"));
+    QVERIFY(locations.first().address().streetNumber().isEmpty());
+    QVERIFY(locations.first().boundingShape().isValid());
+
+    locations = waitForLocations(m_manager->geocode(QStringLiteral("nowhere street ")));
+    QVERIFY(locations.isEmpty());
+}
+
+void tst_QGeocodingManagerOffline::geocodeCompletion()
+{
+    // "str" is completed to "street" even though it is also an abbreviation
+    QList<QGeoLocation> locations = waitForLocations(m_manager->geocode(QStringLiteral("14 main str")));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().streetNumber(), QStringLiteral("14"));
+
+    locations = waitForLocations(m_manager->geocode(QStringLiteral("oak av")));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("Oak Avenue"));
+
+    // a trailing space means the last word is complete
+    locations = waitForLocations(m_manager->geocode(QStringLiteral("spring ")));
+    QVERIFY(locations.isEmpty());
+}
+
+void tst_QGeocodingManagerOffline::geocodeAddress()
+{
+    QGeoAddress address;
+    address.setStreet(QStringLiteral("Oak Ave"));
+    address.setCity(QStringLiteral("SPRINGFIELD"));
+    const QList<QGeoLocation> locations = waitForLocations(m_manager->geocode(address));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().streetNumber(), QStringLiteral("3"));
+    QCOMPARE(locations.first().coordinate(), QGeoCoordinate(-27.01, 153.01));
+}
+
+void tst_QGeocodingManagerOffline::geocodeBoundsAndPaging()
+{
+    QList<QGeoLocation> locations = waitForLocations(m_manager->geocode(QStringLiteral("springfield")));
+    QCOMPARE(locations.size(), 3);
+
+    const QGeoRectangle oak(QGeoCoordinate(-27.005, 153.005), QGeoCoordinate(-27.015, 153.015));
+    locations = waitForLocations(m_manager->geocode(QStringLiteral("springfield"), -1, 0, oak));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("Oak Avenue"));
+
+    QGeoCodeReply *reply = m_manager->geocode(QStringLiteral("springfield"), 2, 2);
+    QCOMPARE(reply->limit(), 2);
+    QCOMPARE(reply->offset(), 2);
+    QCOMPARE(waitForLocations(reply).size(), 1);
+}
+
+void tst_QGeocodingManagerOffline::reverseGeocodeAddressPoint()
+{
+    // the house is preferred over the slightly farther street
+    const QList<QGeoLocation> locations = waitForLocations(
+                m_manager->reverseGeocode(QGeoCoordinate(-27.00005, 153.0001)));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().streetNumber(), QStringLiteral("12"));
+    QCOMPARE(locations.first().coordinate(), QGeoCoordinate(-27.0, 153.0));
+}
+
+void tst_QGeocodingManagerOffline::reverseGeocodeStreet()
+{
+    const QList<QGeoLocation> locations = waitForLocations(
+                m_manager->reverseGeocode(QGeoCoordinate(-27.0040, 153.0004)));
+    QCOMPARE(locations.size(), 1);
+    QCOMPARE(locations.first().address().street(), QStringLiteral("Main Street"));
+    QVERIFY(locations.first().address().streetNumber().isEmpty());
+    QVERIFY(locations.first().coordinate().distanceTo(QGeoCoordinate(-27.0040, 153.0003)) < 1.0);
+}
+
+void tst_QGeocodingManagerOffline::reverseGeocodeTooFar()
+{
+    QVERIFY(waitForLocations(m_manager->reverseGeocode(QGeoCoordinate(-27.1, 153.0))).isEmpty());
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.geocoding.geojson"), QFINDTESTDATA("addresses.json"));
+    parameters.insert(QStringLiteral("offline.geocoding.reverse_distance"), 5.0);
+    QGeoServiceProvider provider(QStringLiteral("offline"), parameters);
+    QVERIFY(provider.geocodingManager());
+    QVERIFY(waitForLocations(provider.geocodingManager()->reverseGeocode(
+                                 QGeoCoordinate(-27.00005, 153.0001))).isEmpty());
+}
+
+QList<QGeoLocation> tst_QGeocodingManagerOffline::waitForLocations(QGeoCodeReply *reply)
+{
+    QList<QGeoLocation> locations;
+    if (!reply)
+        return locations;
+
+    // offline replies must never finish before the caller could connect to them
+    if (!reply->isFinished()) {
+        QSignalSpy finishedSpy(reply, &QGeoCodeReply::finished);
+        if (finishedSpy.wait() && reply->error() == QGeoCodeReply::NoError)
+            locations = reply->locations();
+    }
+    delete reply;
+    return locations;
+}
+
+QTEST_GUILESS_MAIN(tst_QGeocodingManagerOffline)
+
+#include "tst_qgeocodingmanager_offline.moc"
@@ -0,0 +1,103 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtLocation/QGeoRouteMatrix>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoRouteMatrix : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructor();
+    void values();
+    void outOfRange();
+    void implicitSharing();
+    void comparison();
+};
+
+void tst_QGeoRouteMatrix::constructor()
+{
+    QGeoRouteMatrix empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.rowCount(), 0);
+    QCOMPARE(empty.columnCount(), 0);
+
+    QGeoRouteMatrix matrix(2, 3);
+    QVERIFY(!matrix.isEmpty());
+    QCOMPARE(matrix.rowCount(), 2);
+    QCOMPARE(matrix.columnCount(), 3);
+    QCOMPARE(matrix.travelTimes(), QList<int>(6, -1));
+    for (qsizetype row = 0; row < 2; ++row) {
+        for (qsizetype column = 0; column < 3; ++column) {
+            QVERIFY(!matrix.isReachable(row, column));
+            QVERIFY(qIsNaN(matrix.distance(row, column)));
+        }
+    }
+
+    QVERIFY(QGeoRouteMatrix(0, 3).isEmpty());
+}
+
+void tst_QGeoRouteMatrix::values()
+{
+    QGeoRouteMatrix matrix(2, 2);
+    matrix.setTravelTime(0, 1, 120);
+    matrix.setDistance(0, 1, 1500.5);
+    matrix.setTravelTime(1, 0, 60);
+
+    QVERIFY(matrix.isReachable(0, 1));
+    QCOMPARE(matrix.travelTime(0, 1), 120);
+    QCOMPARE(matrix.distance(0, 1), 1500.5);
+    QVERIFY(matrix.isReachable(1, 0));
+    QVERIFY(qIsNaN(matrix.distance(1, 0)));
+    QCOMPARE(matrix.travelTimes(), QList<int>({ -1, 120, 60, -1 }));
+    QCOMPARE(matrix.distances().at(1), 1500.5);
+
+    matrix.setTravelTime(0, 1, -5);
+    QVERIFY(!matrix.isReachable(0, 1));
+    QCOMPARE(matrix.travelTime(0, 1), -1);
+}
+
+void tst_QGeoRouteMatrix::outOfRange()
+{
+    const QGeoRouteMatrix matrix(1, 1);
+    QCOMPARE(matrix.travelTime(1, 0), -1);
+    QCOMPARE(matrix.travelTime(0, -1), -1);
+    QVERIFY(qIsNaN(matrix.distance(0, 1)));
+    QVERIFY(!matrix.isReachable(2, 2));
+}
+
+void tst_QGeoRouteMatrix::implicitSharing()
+{
+    QGeoRouteMatrix matrix(1, 2);
+    matrix.setTravelTime(0, 0, 10);
+
+    QGeoRouteMatrix copy(matrix);
+    copy.setTravelTime(0, 0, 20);
+    QCOMPARE(matrix.travelTime(0, 0), 10);
+    QCOMPARE(copy.travelTime(0, 0), 20);
+
+    copy = matrix;
+    QCOMPARE(copy.travelTime(0, 0), 10);
+}
+
+void tst_QGeoRouteMatrix::comparison()
+{
+    QGeoRouteMatrix lhs(2, 1);
+    QGeoRouteMatrix rhs(2, 1);
+    // unknown distances are equal to each other
+    QVERIFY(lhs == rhs);
+
+    lhs.setDistance(1, 0, 25.0);
+    QVERIFY(lhs != rhs);
+    rhs.setDistance(1, 0, 25.0);
+    QVERIFY(lhs == rhs);
+
+    QVERIFY(QGeoRouteMatrix(2, 1) != QGeoRouteMatrix(1, 2));
+}
+
+QTEST_APPLESS_MAIN(tst_QGeoRouteMatrix)
+
+#include "tst_qgeoroutematrix.moc"
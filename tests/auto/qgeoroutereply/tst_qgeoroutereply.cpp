@@ -214,4 +214,35 @@ void tst_QGeoRouteReply::request()
     delete rr;
 }
 
-QTEST_APPLESS_MAIN(tst_QGeoRouteReply);
+void tst_QGeoRouteReply::timeout()
+{
+    QGeoRouteRequest request(*qgeorouterequest);
+    request.setTimeout(50);
+    SubRouteReply rr(request);
+    QSignalSpy errorSpy(&rr, &QGeoRouteReply::errorOccurred);
+    QSignalSpy finishedSpy(&rr, &QGeoRouteReply::finished);
+    QSignalSpy abortedSpy(&rr, &QGeoRouteReply::aborted);
+
+    QTRY_COMPARE(errorSpy.size(), 1);
+    QVERIFY(rr.isFinished());
+    QCOMPARE(rr.error(), QGeoRouteReply::CommunicationError);
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(abortedSpy.size(), 1);
+
+    // What the backend reports afterwards is ignored
+    rr.callSetError(QGeoRouteReply::ParseError, QStringLiteral("Late error"));
+    rr.callSetFinished(true);
+    QCOMPARE(rr.error(), QGeoRouteReply::CommunicationError);
+    QCOMPARE(errorSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+
+    // A reply that finishes in time is not aborted
+    SubRouteReply finishedReply(request);
+    QSignalSpy finishedAbortedSpy(&finishedReply, &QGeoRouteReply::aborted);
+    finishedReply.callSetFinished(true);
+    QTest::qWait(100);
+    QCOMPARE(finishedAbortedSpy.size(), 0);
+    QCOMPARE(finishedReply.error(), QGeoRouteReply::NoError);
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoRouteReply);
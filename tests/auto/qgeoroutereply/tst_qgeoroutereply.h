@@ -48,6 +48,7 @@ private slots:
     void error();
     void error_data();
     void request();
+    void timeout();
     //End Unit Test for QGeoRouteReply
 
 
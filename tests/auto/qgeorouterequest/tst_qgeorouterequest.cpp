@@ -272,4 +272,25 @@ void tst_QGeoRouteRequest::departureTime()
     QCOMPARE(qgeorouterequest.departureTime(), departureTime);
 }
 
+void tst_QGeoRouteRequest::timeoutAndPriority()
+{
+    QGeoRouteRequest qgeorouterequest;
+    QCOMPARE(qgeorouterequest.timeout(), 0);
+    QCOMPARE(qgeorouterequest.priority(), QGeoRouteRequest::NormalPriority);
+
+    qgeorouterequest.setTimeout(-10);
+    QCOMPARE(qgeorouterequest.timeout(), 0);
+
+    QGeoRouteRequest other = qgeorouterequest;
+    qgeorouterequest.setTimeout(2000);
+    qgeorouterequest.setPriority(QGeoRouteRequest::HighPriority);
+    QCOMPARE(qgeorouterequest.timeout(), 2000);
+    QCOMPARE(qgeorouterequest.priority(), QGeoRouteRequest::HighPriority);
+    QVERIFY(qgeorouterequest != other);
+
+    other.setTimeout(2000);
+    other.setPriority(QGeoRouteRequest::HighPriority);
+    QCOMPARE(qgeorouterequest, other);
+}
+
 QTEST_APPLESS_MAIN(tst_QGeoRouteRequest);
@@ -43,6 +43,7 @@ private Q_SLOTS:
     void featureWeight_data();
     void departureTime();
     void departureTime_data();
+    void timeoutAndPriority();
     //End Unit Test for QGeoRouteRequest
 };
 
@@ -0,0 +1,449 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+#include <QtLocation/QGeoManeuver>
+#include <QtLocation/QGeoRouteBatchReply>
+#include <QtLocation/QGeoRouteMatrixReply>
+#include <QtLocation/QGeoRouteReply>
+#include <QtLocation/QGeoRouteSegment>
+#include <QtLocation/QGeoRoutingManager>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/private/qgeojson_p.h>
+#include <QtPositioning/QGeoRectangle>
+
+#include "qrouteindexoffline.h"
+
+QT_USE_NAMESPACE
+
+// the roads in roads.json: Main Street runs from west to east, the one way toll roads
+// Ring Road and North Road lead from west to east through north, and the footway
+// Park Path from west to east through south
+static const QGeoCoordinate West(10.0, 10.0);
+static const QGeoCoordinate North(10.01, 10.01);
+static const QGeoCoordinate East(10.0, 10.02);
+static const QGeoCoordinate South(9.995, 10.01);
+
+class tst_QGeoRoutingManagerOffline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void buildGraph();
+    void hierarchyMatchesGraph();
+
+    void missingParameters();
+    void unsupportedRequests();
+    void fastestRoute();
+    void preferredFeature();
+    void excludeAreas();
+    void alternativeRoutes();
+    void routeLegs();
+    void travelModes();
+    void snapDistance();
+    void routeMatrix();
+    void unreachableMatrix();
+    void batchRoutes();
+
+private:
+    QList<QGeoRoute> waitForRoutes(QGeoRouteReply *reply,
+                                   QGeoRouteReply::Error *error = nullptr);
+    static QList<QGeoRouteSegment> segments(const QGeoRoute &route);
+
+    QGeoServiceProvider *m_provider = nullptr;
+    QGeoRoutingManager *m_manager = nullptr;
+};
+
+void tst_QGeoRoutingManagerOffline::initTestCase()
+{
+    const QString geoJson = QFINDTESTDATA("roads.json");
+    QVERIFY(!geoJson.isEmpty());
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.routing.geojson"), geoJson);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    m_manager = m_provider->routingManager();
+    QVERIFY2(m_manager, qPrintable(m_provider->routingErrorString()));
+}
+
+void tst_QGeoRoutingManagerOffline::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+void tst_QGeoRoutingManagerOffline::buildGraph()
+{
+    QFile file(QFINDTESTDATA("roads.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    // the stream and the town hall are not roads
+    QRouteIndexOfflineBuilder builder;
+    QCOMPARE(builder.addGeoJson(QGeoJson::importGeoJson(QJsonDocument::fromJson(file.readAll()))), 4);
+
+    const QByteArray data = builder.build();
+    QRouteIndexOffline index;
+    QVERIFY(index.setData(data));
+    // west, north and east are shared, the middle vertices of Main Street and Park Path
+    // are not
+    QCOMPARE(index.nodeCount(), 3u);
+    QCOMPARE(index.edgeCount(), 4u);
+
+    const QRouteIndexOffline::Position position =
+            index.snap(QGeoCoordinate(10.0001, 10.005), QRouteIndexOffline::CarProfile, 100.0);
+    QVERIFY(position.isValid());
+    QCOMPARE(index.edgeName(position.edge), QStringLiteral("Main Street"));
+    QVERIFY(qAbs(position.offset - West.distanceTo(QGeoCoordinate(10.0, 10.005))) < 1.0);
+    QVERIFY(position.coordinate.distanceTo(QGeoCoordinate(10.0, 10.005)) < 0.1);
+
+    QVERIFY(!index.setData(QByteArray("QRTIDX01")));
+
+    // a vertex count whose size in bytes wraps around to the real one
+    QByteArray wrapped = data;
+    const quint64 vertexCount =
+            QOfflineIndex::get<quint64>(reinterpret_cast<const uchar *>(data.constData()) + 80);
+    QOfflineIndex::put<quint64>(wrapped, 80, vertexCount + (Q_UINT64_C(1) << 61));
+    QVERIFY(!QRouteIndexOffline().setData(wrapped));
+}
+
+/*
+    Routes through the hierarchy must cost exactly as much as routes found on the plain
+    graph, and unpack into a continuous path.
+*/
+void tst_QGeoRoutingManagerOffline::hierarchyMatchesGraph()
+{
+    const int size = 15;
+    const double spacing = 0.002;
+    const char *const maximumSpeeds[] = { "20", "30", "50", "70" };
+    QRandomGenerator random(7);
+
+    QRouteIndexOfflineBuilder builder;
+    const auto addStreet = [&](int x1, int y1, int x2, int y2) {
+        QVariantMap tags;
+        tags.insert(QStringLiteral("highway"), QStringLiteral("residential"));
+        tags.insert(QStringLiteral("maxspeed"),
+                    QString::fromLatin1(maximumSpeeds[random.bounded(4)]));
+        if (random.bounded(4) == 0)
+            tags.insert(QStringLiteral("oneway"), QStringLiteral("yes"));
+        QVERIFY(builder.addWay({ QGeoCoordinate(y1 * spacing, x1 * spacing),
+                                 QGeoCoordinate(y2 * spacing, x2 * spacing) }, tags));
+    };
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if (x + 1 < size)
+                addStreet(x, y, x + 1, y);
+            if (y + 1 < size)
+                addStreet(x, y, x, y + 1);
+        }
+    }
+
+    QRouteIndexOffline index;
+    QVERIFY(index.setData(builder.build()));
+    QCOMPARE(index.nodeCount(), quint32(size * size));
+
+    // any weighting that is not the default one is searched on the plain graph
+    QRouteIndexOffline::Weighting plain;
+    plain.penalties.insert(QRouteIndexOffline::NoEdge - 1, 1.0);
+
+    int found = 0;
+    for (int i = 0; i < 100; ++i) {
+        const QGeoCoordinate from(random.bounded(size * 10) * spacing / 10,
+                                  random.bounded(size * 10) * spacing / 10);
+        const QGeoCoordinate to(random.bounded(size * 10) * spacing / 10,
+                                random.bounded(size * 10) * spacing / 10);
+        const QRouteIndexOffline::Position source =
+                index.snap(from, QRouteIndexOffline::CarProfile, 1000.0);
+        const QRouteIndexOffline::Position target =
+                index.snap(to, QRouteIndexOffline::CarProfile, 1000.0);
+        QVERIFY(source.isValid() && target.isValid());
+
+        const QRouteIndexOffline::Path hierarchy =
+                index.route(source, target, QRouteIndexOffline::CarProfile);
+        const QRouteIndexOffline::Path graph =
+                index.route(source, target, QRouteIndexOffline::CarProfile, plain);
+        QCOMPARE(hierarchy.isValid(), graph.isValid());
+        if (!hierarchy.isValid())
+            continue;
+        ++found;
+        QVERIFY2(qAbs(hierarchy.cost - graph.cost) < 1e-6,
+                 qPrintable(QStringLiteral("%1 != %2").arg(hierarchy.cost).arg(graph.cost)));
+
+        double travelTime = 0.0;
+        QGeoCoordinate last = source.coordinate;
+        for (const QRouteIndexOffline::Piece &piece : hierarchy.pieces) {
+            travelTime += index.travelTime(piece, QRouteIndexOffline::CarProfile);
+            const QList<QGeoCoordinate> geometry = index.geometry(piece);
+            QVERIFY(!geometry.isEmpty());
+            QVERIFY(geometry.first().distanceTo(last) < 0.5);
+            last = geometry.last();
+        }
+        QVERIFY(last.distanceTo(target.coordinate) < 0.5);
+        QVERIFY(qAbs(travelTime - hierarchy.cost / 10.0) < 1e-6);
+    }
+    QVERIFY(found > 50);
+}
+
+void tst_QGeoRoutingManagerOffline::missingParameters()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.routingManager());
+    QCOMPARE(provider.routingError(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_QGeoRoutingManagerOffline::unsupportedRequests()
+{
+    QGeoRouteReply::Error error;
+    QVERIFY(waitForRoutes(m_manager->calculateRoute(QGeoRouteRequest({ West })), &error).isEmpty());
+    QCOMPARE(error, QGeoRouteReply::UnsupportedOptionError);
+
+    QGeoRouteRequest request({ West, East });
+    request.setTravelModes(QGeoRouteRequest::TruckTravel);
+    QVERIFY(waitForRoutes(m_manager->calculateRoute(request), &error).isEmpty());
+    QCOMPARE(error, QGeoRouteReply::UnsupportedOptionError);
+
+    request.setTravelModes(QGeoRouteRequest::CarTravel);
+    request.setFeatureWeight(QGeoRouteRequest::ParksFeature, QGeoRouteRequest::AvoidFeatureWeight);
+    QVERIFY(waitForRoutes(m_manager->calculateRoute(request), &error).isEmpty());
+    QCOMPARE(error, QGeoRouteReply::UnsupportedOptionError);
+}
+
+void tst_QGeoRoutingManagerOffline::fastestRoute()
+{
+    const QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(QGeoRouteRequest({ West, East })));
+    QCOMPARE(routes.size(), 1);
+
+    // Main Street at 60 km/h beats the longer toll roads at 70 km/h
+    const QGeoRoute route = routes.first();
+    QCOMPARE(route.travelMode(), QGeoRouteRequest::CarTravel);
+    QVERIFY(qAbs(route.distance() - West.distanceTo(East)) < 5.0);
+    QVERIFY(qAbs(route.travelTime() - 131) <= 1);
+    QVERIFY(route.path().first().distanceTo(West) < 0.1);
+    QVERIFY(route.path().last().distanceTo(East) < 0.1);
+    QVERIFY(route.bounds().contains(QGeoCoordinate(10.0, 10.01)));
+
+    const QList<QGeoRouteSegment> routeSegments = segments(route);
+    QCOMPARE(routeSegments.size(), 2);
+    QCOMPARE(routeSegments.at(0).maneuver().direction(), QGeoManeuver::DirectionForward);
+    QCOMPARE(routeSegments.at(0).maneuver().instructionText(),
+             QStringLiteral("Head east on Main Street"));
+    QCOMPARE(routeSegments.at(0).distance(), route.distance());
+    QVERIFY(routeSegments.at(1).isLegLastSegment());
+    QCOMPARE(routeSegments.at(1).maneuver().waypoint(), East);
+}
+
+void tst_QGeoRoutingManagerOffline::preferredFeature()
+{
+    QGeoRouteRequest request({ West, East });
+    request.setFeatureWeight(QGeoRouteRequest::TollFeature, QGeoRouteRequest::PreferFeatureWeight);
+    const QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(request));
+    QCOMPARE(routes.size(), 1);
+
+    const QList<QGeoRouteSegment> routeSegments = segments(routes.first());
+    QCOMPARE(routeSegments.size(), 3);
+    QCOMPARE(routeSegments.at(0).maneuver().instructionText(),
+             QStringLiteral("Head northeast on Ring Road"));
+    QCOMPARE(routeSegments.at(1).maneuver().direction(), QGeoManeuver::DirectionRight);
+    QCOMPARE(routeSegments.at(1).maneuver().instructionText(),
+             QStringLiteral("Turn right onto North Road"));
+    QVERIFY(routeSegments.at(1).maneuver().position().distanceTo(North) < 0.1);
+}
+
+void tst_QGeoRoutingManagerOffline::excludeAreas()
+{
+    const QGeoRectangle mainStreet(QGeoCoordinate(10.001, 10.009), QGeoCoordinate(9.999, 10.011));
+    QGeoRouteRequest request({ West, East });
+    request.setExcludeAreas({ mainStreet });
+    QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(request));
+    QCOMPARE(routes.size(), 1);
+    QVERIFY(qAbs(routes.first().distance() - West.distanceTo(North) - North.distanceTo(East)) < 5.0);
+
+    // the toll roads are one way, so there is no way back
+    request.setWaypoints({ East, West });
+    QGeoRouteReply::Error error;
+    routes = waitForRoutes(m_manager->calculateRoute(request), &error);
+    QCOMPARE(error, QGeoRouteReply::NoError);
+    QVERIFY(routes.isEmpty());
+}
+
+void tst_QGeoRoutingManagerOffline::alternativeRoutes()
+{
+    QGeoRouteRequest request({ West, East });
+    request.setNumberAlternativeRoutes(2);
+    const QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(request));
+    QCOMPARE(routes.size(), 2);
+    QVERIFY(qAbs(routes.at(0).distance() - West.distanceTo(East)) < 5.0);
+    QVERIFY(qAbs(routes.at(1).distance() - West.distanceTo(North) - North.distanceTo(East)) < 5.0);
+    QVERIFY(routes.at(1).travelTime() > routes.at(0).travelTime());
+}
+
+void tst_QGeoRoutingManagerOffline::routeLegs()
+{
+    const QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(QGeoRouteRequest({ West, North, East })));
+    QCOMPARE(routes.size(), 1);
+
+    const QList<QGeoRoute> legs = routes.first().routeLegs();
+    QCOMPARE(legs.size(), 2);
+    QCOMPARE(legs.at(0).legIndex(), 0);
+    QCOMPARE(legs.at(1).legIndex(), 1);
+    QCOMPARE(legs.at(0).distance() + legs.at(1).distance(), routes.first().distance());
+
+    QList<QGeoCoordinate> waypoints;
+    const QList<QGeoRouteSegment> routeSegments = segments(routes.first());
+    for (const QGeoRouteSegment &segment : routeSegments) {
+        if (segment.isLegLastSegment())
+            waypoints.append(segment.maneuver().waypoint());
+    }
+    QCOMPARE(waypoints, QList<QGeoCoordinate>({ North, East }));
+}
+
+void tst_QGeoRoutingManagerOffline::travelModes()
+{
+    QGeoRouteRequest request({ West, South });
+    request.setTravelModes(QGeoRouteRequest::PedestrianTravel);
+    QList<QGeoRoute> routes = waitForRoutes(m_manager->calculateRoute(request));
+    QCOMPARE(routes.size(), 1);
+    QCOMPARE(routes.first().travelMode(), QGeoRouteRequest::PedestrianTravel);
+    QVERIFY(qAbs(routes.first().distance() - West.distanceTo(South)) < 5.0);
+
+    // cars cannot use the footway, so the destination is the closest point on Main Street
+    request.setTravelModes(QGeoRouteRequest::CarTravel);
+    routes = waitForRoutes(m_manager->calculateRoute(request));
+    QCOMPARE(routes.size(), 1);
+    QVERIFY(qAbs(routes.first().distance() - West.distanceTo(QGeoCoordinate(10.0, 10.01))) < 5.0);
+}
+
+void tst_QGeoRoutingManagerOffline::snapDistance()
+{
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.routing.geojson"), QFINDTESTDATA("roads.json"));
+    parameters.insert(QStringLiteral("offline.routing.snap_distance"), 100.0);
+    QGeoServiceProvider provider(QStringLiteral("offline"), parameters);
+    QVERIFY(provider.routingManager());
+
+    QGeoRouteReply::Error error;
+    QVERIFY(waitForRoutes(provider.routingManager()->calculateRoute(QGeoRouteRequest({ West, South })),
+                          &error).isEmpty());
+    QCOMPARE(error, QGeoRouteReply::UnknownError);
+}
+
+void tst_QGeoRoutingManagerOffline::routeMatrix()
+{
+    QSignalSpy managerSpy(m_manager, &QGeoRoutingManager::finished);
+    std::unique_ptr<QGeoRouteMatrixReply> reply(
+            m_manager->calculateRouteMatrix({ West, East }, { East, North, West },
+                                            QGeoRouteRequest()));
+    QVERIFY(reply);
+    QVERIFY(!reply->isFinished());
+    QSignalSpy finishedSpy(reply.get(), &QGeoRouteMatrixReply::finished);
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(reply->error(), QGeoRouteReply::NoError);
+
+    const QGeoRouteMatrix matrix = reply->matrix();
+    QCOMPARE(matrix.rowCount(), 2);
+    QCOMPARE(matrix.columnCount(), 3);
+
+    // Main Street both ways, and nothing to travel between equal coordinates
+    QVERIFY(qAbs(matrix.travelTime(0, 0) - 131) <= 1);
+    QVERIFY(qAbs(matrix.distance(0, 0) - West.distanceTo(East)) < 5.0);
+    QVERIFY(qAbs(matrix.travelTime(1, 2) - 131) <= 1);
+    QCOMPARE(matrix.travelTime(0, 2), 0);
+    QCOMPARE(matrix.travelTime(1, 0), 0);
+    QVERIFY(matrix.isReachable(0, 1));
+    QVERIFY(matrix.isReachable(1, 1));
+
+    // the routes of the matrix are not reported as routes of the manager
+    QCOMPARE(managerSpy.size(), 0);
+}
+
+void tst_QGeoRoutingManagerOffline::unreachableMatrix()
+{
+    const QGeoRectangle mainStreet(QGeoCoordinate(10.001, 10.009), QGeoCoordinate(9.999, 10.011));
+    QGeoRouteRequest request;
+    request.setExcludeAreas({ mainStreet });
+
+    std::unique_ptr<QGeoRouteMatrixReply> reply(
+            m_manager->calculateRouteMatrix({ West, East }, { East, West }, request));
+    QSignalSpy finishedSpy(reply.get(), &QGeoRouteMatrixReply::finished);
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(reply->error(), QGeoRouteReply::NoError);
+
+    const QGeoRouteMatrix matrix = reply->matrix();
+    QVERIFY(matrix.isReachable(0, 0));
+    QVERIFY(!matrix.isReachable(1, 1));
+    QCOMPARE(matrix.travelTime(1, 1), -1);
+    QVERIFY(qIsNaN(matrix.distance(1, 1)));
+
+    reply.reset(m_manager->calculateRouteMatrix({}, { East }, request));
+    QVERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QGeoRouteReply::UnsupportedOptionError);
+}
+
+void tst_QGeoRoutingManagerOffline::batchRoutes()
+{
+    // more requests than are kept in flight at once
+    QList<QGeoRouteRequest> requests(20, QGeoRouteRequest({ West, East }));
+    requests[1] = QGeoRouteRequest({ West });
+    requests[2] = QGeoRouteRequest({ West, North, East });
+
+    QSignalSpy managerSpy(m_manager, &QGeoRoutingManager::finished);
+    std::unique_ptr<QGeoRouteBatchReply> reply(m_manager->calculateRoutes(requests));
+    QVERIFY(reply);
+    QCOMPARE(reply->count(), requests.size());
+    QSignalSpy requestSpy(reply.get(), &QGeoRouteBatchReply::requestFinished);
+    QSignalSpy finishedSpy(reply.get(), &QGeoRouteBatchReply::finished);
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(reply->error(), QGeoRouteReply::NoError);
+    QCOMPARE(requestSpy.size(), requests.size());
+
+    QCOMPARE(reply->requestError(1), QGeoRouteReply::UnsupportedOptionError);
+    QVERIFY(reply->routes(1).isEmpty());
+    QCOMPARE(reply->routes(2).size(), 1);
+    QCOMPARE(reply->routes(2).first().routeLegs().size(), 2);
+    for (qsizetype i = 3; i < requests.size(); ++i) {
+        QCOMPARE(reply->requestError(i), QGeoRouteReply::NoError);
+        QCOMPARE(reply->routes(i).size(), 1);
+        QCOMPARE(reply->routes(i).first().travelTime(), reply->routes(0).first().travelTime());
+    }
+    QCOMPARE(managerSpy.size(), 0);
+}
+
+QList<QGeoRoute> tst_QGeoRoutingManagerOffline::waitForRoutes(QGeoRouteReply *reply,
+                                                             QGeoRouteReply::Error *error)
+{
+    QList<QGeoRoute> routes;
+    if (error)
+        *error = QGeoRouteReply::UnknownError;
+    if (!reply)
+        return routes;
+
+    // offline replies must never finish before the caller could connect to them
+    if (!reply->isFinished()) {
+        QSignalSpy finishedSpy(reply, &QGeoRouteReply::finished);
+        if (finishedSpy.wait()) {
+            if (error)
+                *error = reply->error();
+            routes = reply->routes();
+        }
+    }
+    delete reply;
+    return routes;
+}
+
+QList<QGeoRouteSegment> tst_QGeoRoutingManagerOffline::segments(const QGeoRoute &route)
+{
+    QList<QGeoRouteSegment> result;
+    for (QGeoRouteSegment segment = route.firstRouteSegment(); segment.isValid();
+         segment = segment.nextRouteSegment()) {
+        result.append(segment);
+    }
+    return result;
+}
+
+QTEST_GUILESS_MAIN(tst_QGeoRoutingManagerOffline)
+
+#include "tst_qgeoroutingmanager_offline.moc"
@@ -46,6 +46,7 @@ private Q_SLOTS:
     void initTestCase();
     void fetchTiles();
     void fetchTiles_data();
+    void cacheStatistics();
 
 private:
     std::unique_ptr<QGeoServiceProvider> m_provider;
@@ -176,6 +177,36 @@ void tst_QGeoTiledMap::fetchTiles_data()
     QTest::newRow("zoomLevel: 4.6 ,visible count: 4 : prefetch count: 4") << 4.6 << 4 << 4 + 4  + 4 << QGeoTiledMap::PrefetchTwoNeighbourLayers << 5;
 }
 
+void tst_QGeoTiledMap::cacheStatistics()
+{
+    QGeoCameraData camera;
+    camera.setCenter(QWebMercator::mercatorToCoord(QDoubleVector2D(0.5, 0.5)));
+    camera.setZoomLevel(2);
+    m_map->clearData();
+    m_tilesCounter->m_tiles.clear();
+    m_map->setCameraData(camera);
+    waitForFetch(4);
+    QTRY_VERIFY(m_map->cacheStatistics().texture.tiles >= 4);
+
+    QGeoTileCacheStatistics statistics = m_map->cacheStatistics();
+    QVERIFY(statistics.texture.usage > 0);
+    QVERIFY(statistics.memory.tiles >= 4);
+    QVERIFY(statistics.disk.tiles >= 4);
+    QVERIFY(statistics.decodeTimes.count() >= 4);
+    QVERIFY(statistics.toVariantMap().value("memory").toMap().value("tiles").toInt() >= 4);
+
+    // The textures are released, the scene keeps those it shows
+    m_map->trimData(QAbstractGeoTileCache::TrimTextures);
+    statistics = m_map->cacheStatistics();
+    QCOMPARE(statistics.texture.tiles, 0);
+    QVERIFY(statistics.memory.tiles >= 4);
+
+    m_map->trimData(QAbstractGeoTileCache::TrimMemory);
+    statistics = m_map->cacheStatistics();
+    QCOMPARE(statistics.memory.tiles, 0);
+    QVERIFY(statistics.disk.tiles >= 4);
+}
+
 void tst_QGeoTiledMap::waitForFetch(int count)
 {
     int timeout = 0;
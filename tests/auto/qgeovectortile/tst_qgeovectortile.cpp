@@ -0,0 +1,225 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtLocation/private/qgeovectortile_p.h>
+#include <QtLocation/private/qgeovectortilerenderer_p.h>
+
+#include <QtTest/QtTest>
+
+QT_USE_NAMESPACE
+
+class tst_QGeoVectorTile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode();
+    void invalid();
+    void render();
+    void overzoom();
+    void zoomLevels();
+};
+
+namespace
+{
+void writeVarint(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+void writeBytes(QByteArray &out, int field, const QByteArray &bytes)
+{
+    writeVarint(out, quint64(field) << 3 | 2);
+    writeVarint(out, bytes.size());
+    out.append(bytes);
+}
+
+void writeNumber(QByteArray &out, int field, quint64 value)
+{
+    writeVarint(out, quint64(field) << 3);
+    writeVarint(out, value);
+}
+
+quint32 command(int id, int count)
+{
+    return quint32(id) | quint32(count) << 3;
+}
+
+quint32 zigzag(qint32 value)
+{
+    return (quint32(value) << 1) ^ quint32(value >> 31);
+}
+
+QByteArray packed(const QList<quint32> &values)
+{
+    QByteArray out;
+    for (quint32 value : values)
+        writeVarint(out, value);
+    return out;
+}
+
+QByteArray feature(int type, const QList<quint32> &tags, const QList<quint32> &geometry)
+{
+    QByteArray out;
+    writeBytes(out, 2, packed(tags));
+    writeNumber(out, 3, type);
+    writeBytes(out, 4, packed(geometry));
+    return out;
+}
+
+QByteArray stringValue(const QByteArray &string)
+{
+    QByteArray out;
+    writeBytes(out, 1, string);
+    return out;
+}
+
+// A lake over the left half of the tile, a motorway across its middle and a
+// path across its upper quarter
+QByteArray testTile()
+{
+    QByteArray water;
+    writeBytes(water, 1, "water");
+    writeBytes(water, 2, feature(3, { 0, 0 },
+                                 { command(1, 1), zigzag(0), zigzag(0),
+                                   command(2, 3), zigzag(2048), zigzag(0),
+                                   zigzag(0), zigzag(4096), zigzag(-2048), zigzag(0),
+                                   command(7, 1) }));
+    writeBytes(water, 3, "class");
+    writeBytes(water, 4, stringValue("lake"));
+    writeNumber(water, 5, 4096);
+
+    QByteArray transportation;
+    writeBytes(transportation, 1, "transportation");
+    writeBytes(transportation, 2, feature(2, { 0, 0 },
+                                          { command(1, 1), zigzag(0), zigzag(2048),
+                                            command(2, 1), zigzag(4096), zigzag(0) }));
+    writeBytes(transportation, 2, feature(2, { 0, 1 },
+                                          { command(1, 1), zigzag(0), zigzag(1024),
+                                            command(2, 1), zigzag(4096), zigzag(0) }));
+    writeBytes(transportation, 3, "class");
+    writeBytes(transportation, 4, stringValue("motorway"));
+    writeBytes(transportation, 4, stringValue("path"));
+    writeNumber(transportation, 5, 4096);
+
+    QByteArray tile;
+    writeBytes(tile, 3, water);
+    writeBytes(tile, 3, transportation);
+    return tile;
+}
+
+const char testStyle[] = R"({
+    "background": "#ffffff",
+    "layers": [
+        { "source-layer": "water", "fill-color": "#0000ff" },
+        { "source-layer": "transportation", "filter": ["==", "class", "motorway"],
+          "minzoom": 4, "line-color": "#ff0000", "line-width": 4 }
+    ]
+})";
+
+QColor pixel(const QImage &image, int x, int y)
+{
+    return QColor(image.pixel(x, y));
+}
+}
+
+void tst_QGeoVectorTile::decode()
+{
+    const QGeoVectorTile tile = QGeoVectorTile::fromData(testTile());
+    QVERIFY(tile.isValid());
+    QCOMPARE(tile.layers().size(), 2);
+    QVERIFY(!tile.layer("roads"));
+
+    const QGeoVectorTile::Layer *water = tile.layer("water");
+    QVERIFY(water);
+    QCOMPARE(water->extent, 4096u);
+    QCOMPARE(water->features.size(), 1);
+
+    const QGeoVectorTile::Feature &lake = water->features.first();
+    QCOMPARE(lake.type, QGeoVectorTile::Polygon);
+    const QGeoVectorTile::Value *value = QGeoVectorTile::tag(*water, lake, 0);
+    QVERIFY(value);
+    QVERIFY(value->isString);
+    QCOMPARE(value->string, QByteArrayView("lake"));
+    QVERIFY(!QGeoVectorTile::tag(*water, lake, 1));
+
+    const QList<QPolygonF> rings = QGeoVectorTile::geometry(lake);
+    QCOMPARE(rings.size(), 1);
+    QCOMPARE(rings.first(), QPolygonF({ QPointF(0, 0), QPointF(2048, 0), QPointF(2048, 4096),
+                                        QPointF(0, 4096), QPointF(0, 0) }));
+
+    const QGeoVectorTile::Layer *transportation = tile.layer("transportation");
+    QVERIFY(transportation);
+    QCOMPARE(transportation->features.size(), 2);
+    const QGeoVectorTile::Feature &path = transportation->features.at(1);
+    QCOMPARE(path.type, QGeoVectorTile::LineString);
+    QCOMPARE(QGeoVectorTile::tag(*transportation, path, 0)->string, QByteArrayView("path"));
+    QCOMPARE(QGeoVectorTile::geometry(path),
+             QList<QPolygonF>{ QPolygonF({ QPointF(0, 1024), QPointF(4096, 1024) }) });
+}
+
+void tst_QGeoVectorTile::invalid()
+{
+    QVERIFY(QGeoVectorTile::fromData(QByteArray()).isValid());
+
+    // A layer longer than the tile
+    QVERIFY(!QGeoVectorTile::fromData(QByteArray("\x1a\x7f\x0a", 3)).isValid());
+    // A truncated varint
+    QVERIFY(!QGeoVectorTile::fromData(QByteArray("\x18\xff", 2)).isValid());
+    // A truncated tile
+    QVERIFY(!QGeoVectorTile::fromData(testTile().chopped(5)).isValid());
+
+    QGeoVectorTileRenderer renderer;
+    QVERIFY(!renderer.setStyle("[ 1, 2"));
+    QVERIFY(renderer.render(QGeoVectorTile(), 10, QSize(256, 256)).isNull());
+}
+
+void tst_QGeoVectorTile::render()
+{
+    QGeoVectorTileRenderer renderer;
+    QVERIFY(renderer.setStyle(testStyle));
+    const QImage image = renderer.render(QGeoVectorTile::fromData(testTile()), 10, QSize(256, 256));
+    QCOMPARE(image.size(), QSize(256, 256));
+
+    QCOMPARE(pixel(image, 64, 64), QColor(Qt::blue));
+    QCOMPARE(pixel(image, 192, 192), QColor(Qt::white));
+    QCOMPARE(pixel(image, 64, 128), QColor(Qt::red));
+    QCOMPARE(pixel(image, 192, 128), QColor(Qt::red));
+    QCOMPARE(pixel(image, 192, 134), QColor(Qt::white));
+    // The path is filtered out
+    QCOMPARE(pixel(image, 192, 64), QColor(Qt::white));
+}
+
+void tst_QGeoVectorTile::overzoom()
+{
+    QGeoVectorTileRenderer renderer;
+    QVERIFY(renderer.setStyle(testStyle));
+    // The center of the tile, one zoom level further
+    const QImage image = renderer.render(QGeoVectorTile::fromData(testTile()), 11,
+                                         QSize(256, 256), QRectF(0.25, 0.25, 0.5, 0.5));
+
+    QCOMPARE(pixel(image, 64, 64), QColor(Qt::blue));
+    QCOMPARE(pixel(image, 124, 64), QColor(Qt::blue));
+    QCOMPARE(pixel(image, 132, 64), QColor(Qt::white));
+    QCOMPARE(pixel(image, 192, 128), QColor(Qt::red));
+    // Lines keep their width in pixels
+    QCOMPARE(pixel(image, 192, 134), QColor(Qt::white));
+}
+
+void tst_QGeoVectorTile::zoomLevels()
+{
+    QGeoVectorTileRenderer renderer;
+    QVERIFY(renderer.setStyle(testStyle));
+    const QImage image = renderer.render(QGeoVectorTile::fromData(testTile()), 3, QSize(256, 256));
+
+    QCOMPARE(pixel(image, 64, 64), QColor(Qt::blue));
+    QCOMPARE(pixel(image, 192, 128), QColor(Qt::white));
+}
+
+QTEST_MAIN(tst_QGeoVectorTile)
+
+#include "tst_qgeovectortile.moc"
@@ -0,0 +1,289 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <QtLocation/QGeoServiceProvider>
+#include <QtLocation/QPlaceCategory>
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceManager>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/QPlaceSearchSuggestionReply>
+#include <QtPositioning/QGeoCircle>
+
+QT_USE_NAMESPACE
+
+class tst_QPlaceManagerOffline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void missingParameters();
+    void prebuiltIndex();
+    void searchTerm();
+    void searchArea();
+    void categories();
+    void paging();
+    void lexicalOrder();
+    void details();
+    void suggestions();
+    void categoryTree();
+
+private:
+    static bool waitForReply(QPlaceReply *reply);
+    QStringList search(const QPlaceSearchRequest &request, QPlaceSearchReply **pagedReply = nullptr);
+
+    QGeoServiceProvider *m_provider = nullptr;
+    QPlaceManager *m_manager = nullptr;
+    QString m_geoJson;
+    QTemporaryDir m_dir;
+};
+
+static const QGeoCircle brisbane(QGeoCoordinate(-27.4700, 153.0250), 2000);
+
+void tst_QPlaceManagerOffline::initTestCase()
+{
+    m_geoJson = QFINDTESTDATA("places.json");
+    QVERIFY(!m_geoJson.isEmpty());
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.places.geojson"), m_geoJson);
+    m_provider = new QGeoServiceProvider(QStringLiteral("offline"), parameters);
+    QCOMPARE(m_provider->error(), QGeoServiceProvider::NoError);
+    m_manager = m_provider->placeManager();
+    QVERIFY(m_manager);
+}
+
+void tst_QPlaceManagerOffline::cleanupTestCase()
+{
+    delete m_provider;
+}
+
+void tst_QPlaceManagerOffline::missingParameters()
+{
+    QGeoServiceProvider provider(QStringLiteral("offline"));
+    QVERIFY(!provider.placeManager());
+    QCOMPARE(provider.placesError(), QGeoServiceProvider::MissingRequiredParameterError);
+}
+
+void tst_QPlaceManagerOffline::prebuiltIndex()
+{
+    QVERIFY(m_dir.isValid());
+    const QString indexFile = m_dir.filePath(QStringLiteral("places.idx"));
+
+    {
+        QVariantMap parameters;
+        parameters.insert(QStringLiteral("offline.places.geojson"), m_geoJson);
+        parameters.insert(QStringLiteral("offline.places.index"), indexFile);
+        QGeoServiceProvider provider(QStringLiteral("offline"), parameters);
+        QVERIFY(provider.placeManager());
+    }
+    QVERIFY(QFile::exists(indexFile));
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("offline.places.index"), indexFile);
+    QGeoServiceProvider provider(QStringLiteral("offline"), parameters);
+    QVERIFY(provider.placeManager());
+
+    QPlaceDetailsReply *reply = provider.placeManager()->getPlaceDetails(QStringLiteral("museum"));
+    QVERIFY(waitForReply(reply));
+    QCOMPARE(reply->place().name(), QStringLiteral("Queensland Museum"));
+    delete reply;
+}
+
+void tst_QPlaceManagerOffline::searchTerm()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("cafe"));
+    QStringList ids = search(request);
+    ids.sort();
+    QCOMPARE(ids, QStringList({ QStringLiteral("cafe-central"), QStringLiteral("cafe-river"),
+                                QStringLiteral("harbour-cafe") }));
+
+    request.setSearchTerm(QStringLiteral("CENTRAL cafe"));
+    QCOMPARE(search(request), QStringList(QStringLiteral("cafe-central")));
+
+    request.setSearchTerm(QStringLiteral("queen street"));
+    ids = search(request);
+    ids.sort();
+    QCOMPARE(ids, QStringList({ QStringLiteral("cafe-central"),
+                                QStringLiteral("central-pharmacy") }));
+
+    request.setSearchTerm(QStringLiteral("nowhere"));
+    QVERIFY(search(request).isEmpty());
+}
+
+void tst_QPlaceManagerOffline::searchArea()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("cafe"));
+    request.setSearchArea(brisbane);
+    // ordered by distance to the center of the search area
+    QCOMPARE(search(request), QStringList({ QStringLiteral("cafe-central"),
+                                            QStringLiteral("cafe-river") }));
+
+    QPlaceSearchRequest browse;
+    browse.setSearchArea(brisbane);
+    QCOMPARE(search(browse), QStringList({ QStringLiteral("central-pharmacy"),
+                                           QStringLiteral("cafe-central"),
+                                           QStringLiteral("cafe-river"),
+                                           QStringLiteral("museum") }));
+}
+
+void tst_QPlaceManagerOffline::categories()
+{
+    QPlaceCategory cafe;
+    cafe.setCategoryId(QStringLiteral("amenity=cafe"));
+    QPlaceSearchRequest request;
+    request.setCategory(cafe);
+    QStringList ids = search(request);
+    ids.sort();
+    QCOMPARE(ids, QStringList({ QStringLiteral("cafe-central"), QStringLiteral("cafe-river"),
+                                QStringLiteral("harbour-cafe") }));
+
+    // a parent category matches all of its children
+    QPlaceCategory amenity;
+    amenity.setCategoryId(QStringLiteral("amenity"));
+    request.setCategory(amenity);
+    request.setSearchArea(brisbane);
+    QCOMPARE(search(request).size(), 3);
+
+    QPlaceCategory museum;
+    museum.setCategoryId(QStringLiteral("tourism=museum"));
+    request.setCategories({ cafe, museum });
+    request.setSearchTerm(QStringLiteral("queen"));
+    QCOMPARE(search(request), QStringList(QStringLiteral("cafe-central")));
+}
+
+void tst_QPlaceManagerOffline::paging()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("cafe"));
+    request.setSearchArea(brisbane);
+    request.setLimit(1);
+
+    QPlaceSearchReply *reply = nullptr;
+    QCOMPARE(search(request, &reply), QStringList(QStringLiteral("cafe-central")));
+    QCOMPARE(reply->previousPageRequest(), QPlaceSearchRequest());
+    const QPlaceSearchRequest next = reply->nextPageRequest();
+    QVERIFY(next != QPlaceSearchRequest());
+    delete reply;
+
+    QCOMPARE(search(next, &reply), QStringList(QStringLiteral("cafe-river")));
+    QVERIFY(reply->previousPageRequest() != QPlaceSearchRequest());
+    QCOMPARE(reply->nextPageRequest(), QPlaceSearchRequest());
+    delete reply;
+}
+
+void tst_QPlaceManagerOffline::lexicalOrder()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("cafe"));
+    request.setSearchArea(brisbane);
+    request.setRelevanceHint(QPlaceSearchRequest::LexicalPlaceNameHint);
+    QCOMPARE(search(request), QStringList({ QStringLiteral("cafe-central"),
+                                            QStringLiteral("cafe-river") }));
+
+    request.setSearchTerm(QStringLiteral("central"));
+    QCOMPARE(search(request), QStringList({ QStringLiteral("cafe-central"),
+                                            QStringLiteral("central-pharmacy") }));
+}
+
+void tst_QPlaceManagerOffline::details()
+{
+    QPlaceDetailsReply *reply = m_manager->getPlaceDetails(QStringLiteral("cafe-river"));
+    QVERIFY(waitForReply(reply));
+    QCOMPARE(reply->error(), QPlaceReply::NoError);
+    QCOMPARE(reply->place().name(), QStringLiteral("River Cafe"));
+    QCOMPARE(reply->place().location().address().text(), QStringLiteral("20 Eagle Street"));
+    QCOMPARE(reply->place().location().coordinate(), QGeoCoordinate(-27.4750, 153.0300));
+    QCOMPARE(reply->place().categories().size(), 1);
+    QCOMPARE(reply->place().categories().first().categoryId(), QStringLiteral("amenity=cafe"));
+    delete reply;
+
+    reply = m_manager->getPlaceDetails(QStringLiteral("unknown"));
+    QVERIFY(waitForReply(reply));
+    QCOMPARE(reply->error(), QPlaceReply::PlaceDoesNotExistError);
+    delete reply;
+}
+
+void tst_QPlaceManagerOffline::suggestions()
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(QStringLiteral("cen"));
+    QPlaceSearchSuggestionReply *reply = m_manager->searchSuggestions(request);
+    QVERIFY(waitForReply(reply));
+    QStringList suggestions = reply->suggestions();
+    suggestions.sort();
+    QCOMPARE(suggestions, QStringList({ QStringLiteral("Cafe Central"),
+                                        QStringLiteral("Central Pharmacy") }));
+    delete reply;
+
+    request.setSearchTerm(QStringLiteral("river ca"));
+    reply = m_manager->searchSuggestions(request);
+    QVERIFY(waitForReply(reply));
+    QCOMPARE(reply->suggestions(), QStringList(QStringLiteral("River Cafe")));
+    delete reply;
+}
+
+void tst_QPlaceManagerOffline::categoryTree()
+{
+    QPlaceReply *reply = m_manager->initializeCategories();
+    QVERIFY(waitForReply(reply));
+    delete reply;
+
+    const QStringList topLevel = m_manager->childCategoryIds();
+    QVERIFY(topLevel.contains(QStringLiteral("amenity")));
+    QVERIFY(topLevel.contains(QStringLiteral("tourism")));
+    QVERIFY(topLevel.contains(QStringLiteral("waterfront")));
+
+    QStringList amenities = m_manager->childCategoryIds(QStringLiteral("amenity"));
+    amenities.sort();
+    QCOMPARE(amenities, QStringList({ QStringLiteral("amenity=cafe"),
+                                      QStringLiteral("amenity=pharmacy") }));
+    QCOMPARE(m_manager->parentCategoryId(QStringLiteral("amenity=cafe")),
+             QStringLiteral("amenity"));
+    QCOMPARE(m_manager->category(QStringLiteral("amenity=cafe")).name(), QStringLiteral("Cafe"));
+}
+
+bool tst_QPlaceManagerOffline::waitForReply(QPlaceReply *reply)
+{
+    if (!reply)
+        return false;
+    // offline replies must never finish before the caller could connect to them
+    if (reply->isFinished())
+        return false;
+    QSignalSpy finishedSpy(reply, &QPlaceReply::finished);
+    return finishedSpy.wait() && finishedSpy.size() == 1;
+}
+
+QStringList tst_QPlaceManagerOffline::search(const QPlaceSearchRequest &request,
+                                              QPlaceSearchReply **pagedReply)
+{
+    QStringList ids;
+    QPlaceSearchReply *reply = m_manager->search(request);
+    if (!waitForReply(reply) || reply->error() != QPlaceReply::NoError) {
+        delete reply;
+        return ids;
+    }
+
+    const QList<QPlaceSearchResult> results = reply->results();
+    for (const QPlaceSearchResult &result : results)
+        ids.append(QPlaceResult(result).place().placeId());
+
+    if (pagedReply)
+        *pagedReply = reply;
+    else
+        delete reply;
+    return ids;
+}
+
+QTEST_GUILESS_MAIN(tst_QPlaceManagerOffline)
+
+#include "tst_qplacemanager_offline.moc"
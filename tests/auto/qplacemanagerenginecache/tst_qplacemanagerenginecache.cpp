@@ -0,0 +1,360 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
+
+#include <QtPositioning/QGeoCircle>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtPositioning/QGeoLocation>
+
+#include <QtLocation/QPlaceDetailsReply>
+#include <QtLocation/QPlaceResult>
+#include <QtLocation/QPlaceSearchReply>
+#include <QtLocation/QPlaceSearchRequest>
+#include <QtLocation/private/qplacemanagerenginecache_p.h>
+
+QT_USE_NAMESPACE
+
+class TestSearchReply : public QPlaceSearchReply
+{
+    Q_OBJECT
+
+public:
+    TestSearchReply(const QPlaceSearchRequest &request, bool fail, QObject *parent)
+        : QPlaceSearchReply(parent)
+    {
+        setRequest(request);
+        QMetaObject::invokeMethod(this, [this, request, fail]() {
+            if (fail) {
+                setError(QPlaceReply::CommunicationError, QStringLiteral("offline"));
+                emit errorOccurred(error(), errorString());
+            } else {
+                QPlace place;
+                place.setPlaceId(QStringLiteral("id-") + request.searchTerm());
+                place.setName(request.searchTerm());
+                QGeoLocation location;
+                location.setCoordinate(QGeoCoordinate(10, 20));
+                place.setLocation(location);
+
+                QPlaceResult result;
+                result.setTitle(place.name());
+                result.setDistance(42);
+                result.setPlace(place);
+                setResults(QList<QPlaceSearchResult>() << result);
+            }
+            setFinished(true);
+            emit finished();
+        }, Qt::QueuedConnection);
+    }
+};
+
+class TestDetailsReply : public QPlaceDetailsReply
+{
+    Q_OBJECT
+
+public:
+    TestDetailsReply(const QString &placeId, QObject *parent)
+        : QPlaceDetailsReply(parent)
+    {
+        QMetaObject::invokeMethod(this, [this, placeId]() {
+            QPlace place;
+            place.setPlaceId(placeId);
+            place.setName(QStringLiteral("details"));
+            place.setDetailsFetched(true);
+            setPlace(place);
+            setFinished(true);
+            emit finished();
+        }, Qt::QueuedConnection);
+    }
+};
+
+class CountingPlaceEngine : public QPlaceManagerEngine
+{
+    Q_OBJECT
+
+public:
+    CountingPlaceEngine() : QPlaceManagerEngine(QVariantMap()) {}
+
+    QPlaceSearchReply *search(const QPlaceSearchRequest &request) override
+    {
+        ++searchCount;
+        return new TestSearchReply(request, fail, this);
+    }
+
+    QPlaceDetailsReply *getPlaceDetails(const QString &placeId) override
+    {
+        ++detailsCount;
+        return new TestDetailsReply(placeId, this);
+    }
+
+    void notifyPlaceUpdated(const QString &placeId) { emit placeUpdated(placeId); }
+
+    int searchCount = 0;
+    int detailsCount = 0;
+    bool fail = false;
+};
+
+class tst_QPlaceManagerEngineCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void enabled();
+    void coalesceInFlightSearches();
+    void memoryHit();
+    void normalisedKey();
+    void providerParametersInKey();
+    void differentRequests();
+    void errorNotCached();
+    void zeroTimeToLive();
+    void detailsCoalescing();
+    void placeUpdatedInvalidates();
+    void diskTier();
+
+private:
+    static QPlaceSearchRequest request(const QString &term);
+};
+
+QPlaceSearchRequest tst_QPlaceManagerEngineCache::request(const QString &term)
+{
+    QPlaceSearchRequest request;
+    request.setSearchTerm(term);
+    request.setSearchArea(QGeoCircle(QGeoCoordinate(10, 20), 1000));
+    request.setLimit(10);
+    return request;
+}
+
+void tst_QPlaceManagerEngineCache::enabled()
+{
+    QVERIFY(!QPlaceManagerEngineCache::isEnabled(QVariantMap()));
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("places.cache"), true);
+    QVERIFY(QPlaceManagerEngineCache::isEnabled(parameters));
+}
+
+void tst_QPlaceManagerEngineCache::coalesceInFlightSearches()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+    QSignalSpy finishedSpy(&cache, &QPlaceManagerEngine::finished);
+
+    QPlaceSearchReply *first = cache.search(request(QStringLiteral("pizza")));
+    QPlaceSearchReply *second = cache.search(request(QStringLiteral("pizza")));
+    QVERIFY(first != second);
+    QCOMPARE(engine->searchCount, 1);
+
+    QTRY_VERIFY(first->isFinished());
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(first->results().size(), 1);
+    QCOMPARE(second->results(), first->results());
+    QCOMPARE(first->request(), request(QStringLiteral("pizza")));
+
+    // the upstream reply must not leak out of the cache
+    QTRY_COMPARE(finishedSpy.size(), 2);
+    QCOMPARE(cache.statistics().upstreamRequests, quint64(1));
+    QCOMPARE(cache.statistics().coalesced, quint64(1));
+
+    delete first;
+    delete second;
+}
+
+void tst_QPlaceManagerEngineCache::memoryHit()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+
+    QPlaceSearchReply *first = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(first->isFinished());
+
+    QPlaceSearchReply *second = cache.search(request(QStringLiteral("pizza")));
+    // cached replies still finish asynchronously
+    QVERIFY(!second->isFinished());
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(second->results(), first->results());
+    QCOMPARE(engine->searchCount, 1);
+    QCOMPARE(cache.statistics().memoryHits, quint64(1));
+    QCOMPARE(cache.statistics().misses, quint64(1));
+
+    delete first;
+    delete second;
+}
+
+void tst_QPlaceManagerEngineCache::normalisedKey()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+
+    QCOMPARE(cache.searchKey(request(QStringLiteral("  Pizza   Place "))),
+             cache.searchKey(request(QStringLiteral("pizza place"))));
+    QVERIFY(cache.searchKey(request(QStringLiteral("pizza")))
+            != cache.searchKey(request(QStringLiteral("pasta"))));
+
+    QPlaceSearchRequest paged = request(QStringLiteral("pizza"));
+    paged.setLimit(20);
+    QVERIFY(cache.searchKey(paged) != cache.searchKey(request(QStringLiteral("pizza"))));
+
+    QVERIFY(cache.detailsKey(QStringLiteral("a")) != cache.detailsKey(QStringLiteral("b")));
+}
+
+void tst_QPlaceManagerEngineCache::providerParametersInKey()
+{
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("test.host"), QStringLiteral("one.example.com"));
+    QPlaceManagerEngineCache first(new CountingPlaceEngine, parameters);
+
+    parameters.insert(QStringLiteral("test.host"), QStringLiteral("two.example.com"));
+    QPlaceManagerEngineCache second(new CountingPlaceEngine, parameters);
+    QVERIFY(first.searchKey(request(QStringLiteral("pizza")))
+            != second.searchKey(request(QStringLiteral("pizza"))));
+    QVERIFY(first.detailsKey(QStringLiteral("a")) != second.detailsKey(QStringLiteral("a")));
+
+    // the parameters of the cache itself do not change the responses
+    parameters.insert(QStringLiteral("places.cache.ttl"), 60);
+    QPlaceManagerEngineCache third(new CountingPlaceEngine, parameters);
+    QCOMPARE(third.searchKey(request(QStringLiteral("pizza"))),
+             second.searchKey(request(QStringLiteral("pizza"))));
+}
+
+void tst_QPlaceManagerEngineCache::differentRequests()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+
+    QPlaceSearchReply *first = cache.search(request(QStringLiteral("pizza")));
+    QPlaceSearchReply *second = cache.search(request(QStringLiteral("pasta")));
+    QCOMPARE(engine->searchCount, 2);
+
+    QTRY_VERIFY(first->isFinished() && second->isFinished());
+    QVERIFY(first->results() != second->results());
+
+    delete first;
+    delete second;
+}
+
+void tst_QPlaceManagerEngineCache::errorNotCached()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    engine->fail = true;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+    QSignalSpy errorSpy(&cache, &QPlaceManagerEngine::errorOccurred);
+
+    QPlaceSearchReply *first = cache.search(request(QStringLiteral("pizza")));
+    QPlaceSearchReply *second = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(first->isFinished() && second->isFinished());
+    QCOMPARE(first->error(), QPlaceReply::CommunicationError);
+    QCOMPARE(second->error(), QPlaceReply::CommunicationError);
+    QCOMPARE(errorSpy.size(), 2);
+
+    engine->fail = false;
+    QPlaceSearchReply *third = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(third->isFinished());
+    QCOMPARE(third->error(), QPlaceReply::NoError);
+    QCOMPARE(engine->searchCount, 2);
+
+    delete first;
+    delete second;
+    delete third;
+}
+
+void tst_QPlaceManagerEngineCache::zeroTimeToLive()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("places.cache.ttl"), 0);
+    QPlaceManagerEngineCache cache(engine, parameters);
+
+    QPlaceSearchReply *first = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(first->isFinished());
+    QPlaceSearchReply *second = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(engine->searchCount, 2);
+
+    delete first;
+    delete second;
+}
+
+void tst_QPlaceManagerEngineCache::detailsCoalescing()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+
+    QPlaceDetailsReply *first = cache.getPlaceDetails(QStringLiteral("p1"));
+    QPlaceDetailsReply *second = cache.getPlaceDetails(QStringLiteral("p1"));
+    QTRY_VERIFY(first->isFinished() && second->isFinished());
+    QCOMPARE(engine->detailsCount, 1);
+    QCOMPARE(first->place().placeId(), QStringLiteral("p1"));
+    QCOMPARE(second->place(), first->place());
+
+    QPlaceDetailsReply *third = cache.getPlaceDetails(QStringLiteral("p1"));
+    QTRY_VERIFY(third->isFinished());
+    QCOMPARE(engine->detailsCount, 1);
+
+    delete first;
+    delete second;
+    delete third;
+}
+
+void tst_QPlaceManagerEngineCache::placeUpdatedInvalidates()
+{
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, QVariantMap());
+    QSignalSpy updatedSpy(&cache, &QPlaceManagerEngine::placeUpdated);
+
+    QPlaceDetailsReply *first = cache.getPlaceDetails(QStringLiteral("p1"));
+    QTRY_VERIFY(first->isFinished());
+
+    engine->notifyPlaceUpdated(QStringLiteral("p1"));
+    QCOMPARE(updatedSpy.size(), 1);
+
+    QPlaceDetailsReply *second = cache.getPlaceDetails(QStringLiteral("p1"));
+    QTRY_VERIFY(second->isFinished());
+    QCOMPARE(engine->detailsCount, 2);
+
+    delete first;
+    delete second;
+}
+
+void tst_QPlaceManagerEngineCache::diskTier()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QVariantMap parameters;
+    parameters.insert(QStringLiteral("places.cache.directory"), dir.path());
+
+    QList<QPlaceSearchResult> results;
+    {
+        CountingPlaceEngine *engine = new CountingPlaceEngine;
+        QPlaceManagerEngineCache cache(engine, parameters);
+        QPlaceSearchReply *reply = cache.search(request(QStringLiteral("pizza")));
+        QTRY_VERIFY(reply->isFinished());
+        results = reply->results();
+        delete reply;
+    }
+
+    CountingPlaceEngine *engine = new CountingPlaceEngine;
+    QPlaceManagerEngineCache cache(engine, parameters);
+    QPlaceSearchReply *reply = cache.search(request(QStringLiteral("pizza")));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(engine->searchCount, 0);
+    QCOMPARE(cache.statistics().diskHits, quint64(1));
+    QCOMPARE(reply->results().size(), 1);
+
+    const QPlaceResult cached(reply->results().first());
+    const QPlaceResult original(results.first());
+    QCOMPARE(cached.title(), original.title());
+    QCOMPARE(cached.distance(), original.distance());
+    QCOMPARE(cached.place().placeId(), original.place().placeId());
+    QCOMPARE(cached.place().location().coordinate(), original.place().location().coordinate());
+    delete reply;
+
+    cache.clear();
+    QVERIFY(QDir(dir.path()).entryList(QDir::Files).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_QPlaceManagerEngineCache)
+
+#include "tst_qplacemanagerenginecache.moc"
@@ -27,6 +27,17 @@ public:
     void setRequest(const QPlaceSearchRequest &request) {
         QPlaceSearchReply::setRequest(request);
     }
+
+    void finish() {
+        setFinished(true);
+        emit finished();
+    }
+
+    void fail(QPlaceReply::Error error, const QString &errorString) {
+        setError(error, errorString);
+        emit errorOccurred(error, errorString);
+        finish();
+    }
 };
 
 class tst_QPlaceSearchReply : public QObject
@@ -41,6 +52,7 @@ private Q_SLOTS:
     void typeTest();
     void requestTest();
     void resultsTest();
+    void timeoutTest();
 };
 
 tst_QPlaceSearchReply::tst_QPlaceSearchReply()
@@ -106,6 +118,39 @@ void tst_QPlaceSearchReply::resultsTest()
     delete reply;
 }
 
-QTEST_APPLESS_MAIN(tst_QPlaceSearchReply)
+void tst_QPlaceSearchReply::timeoutTest()
+{
+    QPlaceSearchRequest request;
+    request.setTimeout(50);
+
+    TestSearchReply reply;
+    QSignalSpy errorSpy(&reply, &QPlaceReply::errorOccurred);
+    QSignalSpy finishedSpy(&reply, &QPlaceReply::finished);
+    QSignalSpy abortedSpy(&reply, &QPlaceReply::aborted);
+    reply.setRequest(request);
+
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QVERIFY(reply.isFinished());
+    QCOMPARE(reply.error(), QPlaceReply::CommunicationError);
+    QCOMPARE(errorSpy.size(), 1);
+    QCOMPARE(abortedSpy.size(), 1);
+
+    // What the backend reports afterwards is ignored
+    reply.fail(QPlaceReply::ParseError, QStringLiteral("Late error"));
+    QCOMPARE(reply.error(), QPlaceReply::CommunicationError);
+    QCOMPARE(errorSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+
+    // A reply that finishes in time is not aborted
+    TestSearchReply finishedReply;
+    QSignalSpy finishedAbortedSpy(&finishedReply, &QPlaceReply::aborted);
+    finishedReply.setRequest(request);
+    finishedReply.finish();
+    QTest::qWait(100);
+    QCOMPARE(finishedAbortedSpy.size(), 0);
+    QCOMPARE(finishedReply.error(), QPlaceReply::NoError);
+}
+
+QTEST_GUILESS_MAIN(tst_QPlaceSearchReply)
 
 #include "tst_qplacesearchreply.moc"
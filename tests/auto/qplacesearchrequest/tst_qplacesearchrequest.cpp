@@ -27,6 +27,7 @@ private Q_SLOTS:
     void visibilityScopeTest();
     void relevanceHintTest();
     void searchContextTest();
+    void timeoutTest();
     void operatorsTest();
     void clearTest();
 };
@@ -159,6 +160,21 @@ void tst_QPlaceSearchRequest::searchContextTest()
     QCOMPARE(request.searchContext().value<QUrl>(), QUrl(QStringLiteral("http://www.example.com/")));
 }
 
+void tst_QPlaceSearchRequest::timeoutTest()
+{
+    QPlaceSearchRequest request;
+    QCOMPARE(request.timeout(), 0);
+    request.setTimeout(-10);
+    QCOMPARE(request.timeout(), 0);
+
+    QPlaceSearchRequest other = request;
+    request.setTimeout(2000);
+    QCOMPARE(request.timeout(), 2000);
+    QVERIFY(request != other);
+    other.setTimeout(2000);
+    QVERIFY(request == other);
+}
+
 void tst_QPlaceSearchRequest::operatorsTest()
 {
     QPlaceSearchRequest testObj;
@@ -231,12 +247,14 @@ void tst_QPlaceSearchRequest::clearTest()
     category.setName("Fast Food");
     req.setCategory(category);
     req.setLimit(100);
+    req.setTimeout(500);
 
     req.clear();
     QVERIFY(req.searchTerm().isEmpty());
     QVERIFY(req.searchArea() == QGeoShape());
     QVERIFY(req.categories().isEmpty());
     QVERIFY(req.limit() == -1);
+    QCOMPARE(req.timeout(), 0);
 }
 
 QTEST_APPLESS_MAIN(tst_QPlaceSearchRequest)
@@ -0,0 +1,120 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/qmath.h>
+#include <QtPositioning/QGeoRectangle>
+#include <QtTest/QtTest>
+
+#include <QtLocation/private/qgeoclusterindex_p.h>
+
+#include <cmath>
+
+QT_USE_NAMESPACE
+
+/*
+    Measures the clustering of points spread around a few hundred hot spots
+    over Europe, as vehicles gather in cities. build() measures loading the
+    points into the index, which is done again whenever the model changes.
+    query() measures the lookup of the clusters of a 1280 x 800 pixels
+    viewport, which is done for every frame in which the map moves.
+*/
+class tst_MapClustering : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void build_data();
+    void build();
+    void query_data();
+    void query();
+};
+
+namespace
+{
+QList<QGeoCoordinate> makePoints(int count)
+{
+    QRandomGenerator random(42);
+    QList<QGeoCoordinate> hotSpots;
+    for (int i = 0; i < 300; ++i)
+        hotSpots.append(QGeoCoordinate(36.0 + random.bounded(24.0), -9.0 + random.bounded(38.0)));
+
+    QList<QGeoCoordinate> points;
+    points.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QGeoCoordinate &hotSpot = hotSpots.at(random.bounded(int(hotSpots.size())));
+        const double distance = std::pow(random.generateDouble(), 2.0) * 50000.0;
+        points.append(hotSpot.atDistanceAndAzimuth(distance, random.bounded(360.0)));
+    }
+    return points;
+}
+
+// The region covered by a viewport of the given size, at a zoom level of a
+// world TileSize * 2^zoomLevel pixels wide
+QGeoRectangle viewport(const QGeoCoordinate &center, int zoomLevel, int width, int height)
+{
+    const double degreesPerPixel = 360.0 / (256.0 * std::ldexp(1.0, zoomLevel));
+    const double halfWidth = qMin(180.0, width * degreesPerPixel / 2.0);
+    const double halfHeight = height * degreesPerPixel / 2.0 / std::cos(qDegreesToRadians(center.latitude()));
+    return QGeoRectangle(QGeoCoordinate(qMin(90.0, center.latitude() + halfHeight),
+                                        center.longitude() - halfWidth),
+                         QGeoCoordinate(qMax(-90.0, center.latitude() - halfHeight),
+                                        center.longitude() + halfWidth));
+}
+}
+
+void tst_MapClustering::build_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("50k") << 50000;
+    QTest::newRow("500k") << 500000;
+}
+
+void tst_MapClustering::build()
+{
+    QFETCH(int, count);
+    const QList<QGeoCoordinate> points = makePoints(count);
+    QGeoClusterIndex index;
+    QBENCHMARK {
+        index.load(points);
+    }
+    QCOMPARE(index.pointCount(), qsizetype(count));
+}
+
+void tst_MapClustering::query_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("zoomLevel");
+    QTest::newRow("50k, zoom 4") << 50000 << 4;
+    QTest::newRow("50k, zoom 8") << 50000 << 8;
+    QTest::newRow("50k, zoom 14") << 50000 << 14;
+    QTest::newRow("500k, zoom 4") << 500000 << 4;
+    QTest::newRow("500k, zoom 8") << 500000 << 8;
+    QTest::newRow("500k, zoom 14") << 500000 << 14;
+}
+
+void tst_MapClustering::query()
+{
+    QFETCH(int, count);
+    QFETCH(int, zoomLevel);
+    const QList<QGeoCoordinate> points = makePoints(count);
+    QGeoClusterIndex index;
+    index.load(points);
+
+    // pan over the hot spots, as a user following vehicles would
+    QList<QGeoRectangle> frames;
+    for (int i = 0; i < 64; ++i)
+        frames.append(viewport(points.at(i * (count / 64)), zoomLevel, 1280, 800));
+
+    int i = 0;
+    qsizetype clusters = 0;
+    QBENCHMARK {
+        clusters += index.clusters(frames.at(i % frames.size()), zoomLevel).size();
+        ++i;
+    }
+    QVERIFY(clusters > 0);
+}
+
+QTEST_GUILESS_MAIN(tst_MapClustering)
+
+#include "tst_mapclustering.moc"
@@ -97,7 +97,9 @@ int main(int argc, char *argv[])
                                          "qrc:/circles.qml",
                                          "qrc:/rectangles.qml",
                                          "qrc:/polylines.qml",
-                                         "qrc:/polygons.qml"
+                                         "qrc:/polygons.qml",
+                                         "qrc:/markers_quickitems.qml",
+                                         "qrc:/markers_layer.qml"
                                      });
     w->show();
     w->runScripts();
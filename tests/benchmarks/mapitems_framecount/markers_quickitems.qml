@@ -0,0 +1,61 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+import QtLocation
+import QtPositioning
+
+Map {
+    width: 1024
+    height: 1024
+
+    property double lonPos: 30
+    center: QtPositioning.coordinate(0, lonPos)
+
+    NumberAnimation on lonPos
+    {
+        loops: Animation.Infinite
+        from: -180
+        to: 180
+        duration: 30000
+    }
+
+    id: map
+    plugin: Plugin {
+        name: "osm"
+    }
+    zoomLevel: 1
+    copyrightsVisible: false
+
+    ListModel {
+        id: markerModel
+        property int gridSize: 100
+        Component.onCompleted: {
+            for (let i = 0; i < gridSize * gridSize; ++i) {
+                append({
+                    coordinate: QtPositioning.coordinate(
+                        -80 + 160 * (Math.floor(i / gridSize) + 0.5) / gridSize,
+                        -180 + 360 * (i % gridSize + 0.5) / gridSize),
+                    icon: i % 2
+                })
+            }
+        }
+    }
+
+    MapItemView {
+        model: markerModel
+        delegate: MapQuickItem {
+            coordinate: model.coordinate
+            anchorPoint: Qt.point(16, 16)
+            autoFadeIn: false
+            sourceItem: Image {
+                source: "marker_atlas.png"
+                sourceClipRect: Qt.rect(model.icon * 32, 0, 32, 32)
+            }
+        }
+    }
+
+    Keys.onPressed: (event)=> {
+        Qt.quit()
+    }
+}
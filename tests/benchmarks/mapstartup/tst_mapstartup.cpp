@@ -0,0 +1,113 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryDir>
+#include <QtLocation/QGeoServiceProvider>
+#include <QtQuick/QQuickView>
+#include <QtTest/QtTest>
+
+QT_USE_NAMESPACE
+
+/*
+    Measures the time from loading a Map with the osm plugin to its first
+    frame, which includes the discovery of the geoservices plugins, and the
+    time taken to find a service provider by name or by its features, as the
+    Plugin QML type does.
+
+    The first frame is only measured once, as the plugins are discovered once
+    per process.
+*/
+class tst_MapStartup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firstFrame();
+    void findProvider_data();
+    void findProvider();
+};
+
+namespace
+{
+const char mapQml[] = R"(
+import QtQuick
+import QtLocation
+import QtPositioning
+
+Map {
+    width: 512
+    height: 512
+    center: QtPositioning.coordinate(60.17, 24.94)
+    zoomLevel: 10
+    plugin: Plugin {
+        name: "osm"
+        PluginParameter { name: "osm.mapping.providersrepository.disabled"; value: true }
+        PluginParameter { name: "osm.mapping.cache.directory"; value: "%1" }
+    }
+}
+)";
+}
+
+void tst_MapStartup::firstFrame()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString fileName = directory.filePath(QStringLiteral("map.qml"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QString::fromLatin1(mapQml).arg(directory.filePath(QStringLiteral("cache"))).toUtf8());
+    file.close();
+
+    QQuickView view;
+    QSignalSpy frames(&view, &QQuickWindow::frameSwapped);
+    QElapsedTimer timer;
+    timer.start();
+    view.setSource(QUrl::fromLocalFile(fileName));
+    QCOMPARE(view.status(), QQuickView::Ready);
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view))
+        QSKIP("The window could not be exposed");
+    QTRY_VERIFY(frames.size() > 0);
+
+    QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+void tst_MapStartup::findProvider_data()
+{
+    QTest::addColumn<bool>("byFeatures");
+
+    QTest::newRow("name") << false;
+    QTest::newRow("features") << true;
+}
+
+void tst_MapStartup::findProvider()
+{
+    QFETCH(bool, byFeatures);
+
+    QString found;
+    QBENCHMARK {
+        found.clear();
+        if (byFeatures) {
+            const QStringList providers = QGeoServiceProvider::availableServiceProviders();
+            for (const QString &name : providers) {
+                QGeoServiceProvider provider(name);
+                if (provider.mappingFeatures().testFlag(QGeoServiceProvider::OnlineMappingFeature)
+                        && provider.geocodingFeatures().testFlag(
+                                QGeoServiceProvider::OnlineGeocodingFeature)) {
+                    found = name;
+                    break;
+                }
+            }
+        } else {
+            QGeoServiceProvider provider(QStringLiteral("osm"));
+            if (provider.mappingFeatures() != QGeoServiceProvider::NoMappingFeatures)
+                found = QStringLiteral("osm");
+        }
+    }
+    QVERIFY(!found.isEmpty());
+}
+
+QTEST_MAIN(tst_MapStartup)
+
+#include "tst_mapstartup.moc"
@@ -0,0 +1,188 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "qplaceindexoffline.h"
+
+QT_USE_NAMESPACE
+
+/*
+    Measures the offline places index on a synthetic data set. The number of points of
+    interest defaults to one million and can be raised with QT_PLACESOFFLINE_POI_COUNT,
+    e.g. to 10000000 for the full size data set. Each benchmark iteration is a single
+    query, so the queries per second are the inverse of the reported time.
+*/
+class tst_PlacesOffline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void build();
+    void open();
+    void searchTerm();
+    void searchTermInBox();
+    void category();
+    void box();
+    void prefix();
+    void find();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_fileName;
+    QPlaceIndexOffline m_index;
+    QList<QGeoRectangle> m_boxes;
+};
+
+namespace
+{
+const char *const Words[] = {
+    "cafe", "bakery", "pharmacy", "garden", "market", "station", "library", "museum",
+    "corner", "central", "north", "south", "river", "park", "hotel", "bistro"
+};
+const char *const Categories[] = {
+    "amenity=cafe", "amenity=restaurant", "amenity=pharmacy", "shop=bakery",
+    "shop=supermarket", "tourism=museum", "tourism=hotel", "leisure=park"
+};
+
+qsizetype poiCount()
+{
+    bool ok = false;
+    const qsizetype count = qEnvironmentVariableIntValue("QT_PLACESOFFLINE_POI_COUNT", &ok);
+    return ok && count > 0 ? count : 1000000;
+}
+
+QPlaceIndexOfflineBuilder makeBuilder(qsizetype count)
+{
+    QRandomGenerator random(42);
+    QPlaceIndexOfflineBuilder builder;
+    for (qsizetype i = 0; i < count; ++i) {
+        QPlaceOfflinePoi poi;
+        poi.placeId = QString::number(i);
+        // clustered around a handful of cities, like real POI data
+        const int city = random.bounded(16);
+        poi.coordinate = QGeoCoordinate(-40.0 + city * 5.0 + random.bounded(1.0),
+                                        -150.0 + city * 18.0 + random.bounded(1.0));
+        poi.name = QString::fromLatin1(Words[random.bounded(16)]) + QLatin1Char(' ')
+                + QString::fromLatin1(Words[random.bounded(16)]) + QLatin1Char(' ')
+                + QString::number(random.bounded(1000));
+        poi.categoryIds.append(QString::fromLatin1(Categories[random.bounded(8)]));
+        builder.addPoi(poi);
+    }
+    return builder;
+}
+}
+
+void tst_PlacesOffline::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_fileName = m_dir.filePath(QStringLiteral("places.idx"));
+
+    QString errorString;
+    QVERIFY2(makeBuilder(poiCount()).write(m_fileName, &errorString), qPrintable(errorString));
+    QVERIFY2(m_index.open(m_fileName, &errorString), qPrintable(errorString));
+    QCOMPARE(qsizetype(m_index.count()), poiCount());
+
+    // city sized boxes of about 10 x 10 km
+    QRandomGenerator random(7);
+    for (int i = 0; i < 256; ++i) {
+        const int city = random.bounded(16);
+        const QGeoCoordinate topLeft(-39.1 + city * 5.0 - random.bounded(0.8),
+                                     -150.0 + city * 18.0 + random.bounded(0.8));
+        m_boxes.append(QGeoRectangle(topLeft, QGeoCoordinate(topLeft.latitude() - 0.09,
+                                                             topLeft.longitude() + 0.12)));
+    }
+}
+
+void tst_PlacesOffline::build()
+{
+    const QPlaceIndexOfflineBuilder builder = makeBuilder(qMin(poiCount(), qsizetype(100000)));
+    QByteArray data;
+    QBENCHMARK {
+        data = builder.build();
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+void tst_PlacesOffline::open()
+{
+    QBENCHMARK {
+        QPlaceIndexOffline index;
+        QVERIFY(index.open(m_fileName));
+    }
+}
+
+void tst_PlacesOffline::searchTerm()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QList<quint32> result = QPlaceIndexOffline::intersect(
+                    m_index.matchingToken(QString::fromLatin1(Words[i % 16])),
+                    m_index.matchingToken(QString::number(i % 1000)));
+        QVERIFY(!result.isEmpty());
+        ++i;
+    }
+}
+
+void tst_PlacesOffline::searchTermInBox()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QGeoRectangle &box = m_boxes.at(i % m_boxes.size());
+        QList<quint32> result = m_index.matchingToken(QString::fromLatin1(Words[i % 16]));
+        result.erase(std::remove_if(result.begin(), result.end(), [&](quint32 index) {
+                         return !box.contains(m_index.coordinate(index));
+                     }), result.end());
+        ++i;
+    }
+}
+
+void tst_PlacesOffline::category()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QList<quint32> result = QPlaceIndexOffline::intersect(
+                    m_index.inCategory(QString::fromLatin1(Categories[i % 8])),
+                    m_index.withinBox(m_boxes.at(i % m_boxes.size())));
+        ++i;
+    }
+}
+
+void tst_PlacesOffline::box()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QList<quint32> result = m_index.withinBox(m_boxes.at(i % m_boxes.size()));
+        QVERIFY(!result.isEmpty());
+        ++i;
+    }
+}
+
+void tst_PlacesOffline::prefix()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QString word = QString::fromLatin1(Words[i % 16]);
+        const QList<quint32> result = m_index.matchingPrefix(word.left(2), 40);
+        QVERIFY(!result.isEmpty());
+        ++i;
+    }
+}
+
+void tst_PlacesOffline::find()
+{
+    int i = 0;
+    const int count = int(m_index.count());
+    QBENCHMARK {
+        QVERIFY(m_index.find(QString::number((i * 7919) % count)) >= 0);
+        ++i;
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_PlacesOffline)
+
+#include "tst_placesoffline.moc"
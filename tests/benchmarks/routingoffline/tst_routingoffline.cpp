@@ -0,0 +1,172 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "qrouteindexoffline.h"
+
+QT_USE_NAMESPACE
+
+/*
+    Measures the offline routing index on a synthetic road grid with residential streets,
+    a primary road every tenth line and a motorway every fiftieth. The grid has 500 x 500
+    nodes by default, and QT_ROUTINGOFFLINE_GRID_SIZE sets its side, e.g. to 2500 for a
+    country sized graph of six million nodes. Each benchmark iteration is a single query
+    between random points of the grid, so the queries per second are the inverse of the
+    reported time.
+*/
+class tst_RoutingOffline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void build();
+    void open();
+    void snap();
+    void hierarchyQuery();
+    void graphQuery();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_fileName;
+    QRouteIndexOffline m_index;
+    QList<std::pair<QRouteIndexOffline::Position, QRouteIndexOffline::Position>> m_queries;
+};
+
+namespace
+{
+const double Spacing = 0.001;
+
+int gridSize()
+{
+    bool ok = false;
+    const int size = qEnvironmentVariableIntValue("QT_ROUTINGOFFLINE_GRID_SIZE", &ok);
+    return ok && size > 1 ? size : 500;
+}
+
+QGeoCoordinate gridCoordinate(int x, int y)
+{
+    return QGeoCoordinate(40.0 + y * Spacing, 5.0 + x * Spacing);
+}
+
+QVariantMap lineTags(int line, QRandomGenerator *random)
+{
+    QVariantMap tags;
+    if (line % 50 == 0) {
+        tags.insert(QStringLiteral("highway"), QStringLiteral("motorway"));
+        tags.insert(QStringLiteral("oneway"), QStringLiteral("no"));
+    } else if (line % 10 == 0) {
+        tags.insert(QStringLiteral("highway"), QStringLiteral("primary"));
+    } else {
+        tags.insert(QStringLiteral("highway"), QStringLiteral("residential"));
+        if (random->bounded(10) == 0)
+            tags.insert(QStringLiteral("oneway"), QStringLiteral("yes"));
+    }
+    return tags;
+}
+
+// every row and column is a single way through all of its intersections
+QRouteIndexOfflineBuilder makeBuilder(int size)
+{
+    QRandomGenerator random(42);
+    QRouteIndexOfflineBuilder builder;
+    QList<QGeoCoordinate> path;
+    for (int line = 0; line < size; ++line) {
+        path.clear();
+        for (int i = 0; i < size; ++i)
+            path.append(gridCoordinate(i, line));
+        builder.addWay(path, lineTags(line, &random));
+
+        path.clear();
+        for (int i = 0; i < size; ++i)
+            path.append(gridCoordinate(line, i));
+        builder.addWay(path, lineTags(line, &random));
+    }
+    return builder;
+}
+}
+
+void tst_RoutingOffline::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_fileName = m_dir.filePath(QStringLiteral("roads.idx"));
+
+    const int size = gridSize();
+    QString errorString;
+    QVERIFY2(makeBuilder(size).write(m_fileName, &errorString), qPrintable(errorString));
+    QVERIFY2(m_index.open(m_fileName, &errorString), qPrintable(errorString));
+    QCOMPARE(m_index.nodeCount(), quint32(size * size));
+
+    QRandomGenerator random(7);
+    while (m_queries.size() < 256) {
+        const QGeoCoordinate from = gridCoordinate(random.bounded(size), random.bounded(size));
+        const QGeoCoordinate to = gridCoordinate(random.bounded(size), random.bounded(size));
+        m_queries.append(std::make_pair(
+                m_index.snap(from, QRouteIndexOffline::CarProfile, 100.0),
+                m_index.snap(to, QRouteIndexOffline::CarProfile, 100.0)));
+    }
+}
+
+void tst_RoutingOffline::build()
+{
+    const QRouteIndexOfflineBuilder builder = makeBuilder(qMin(gridSize(), 100));
+    QByteArray data;
+    QBENCHMARK {
+        data = builder.build();
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+void tst_RoutingOffline::open()
+{
+    QBENCHMARK {
+        QRouteIndexOffline index;
+        QVERIFY(index.open(m_fileName));
+    }
+}
+
+void tst_RoutingOffline::snap()
+{
+    int i = 0;
+    QBENCHMARK {
+        const QGeoCoordinate coordinate = m_queries.at(i % m_queries.size()).first.coordinate;
+        QVERIFY(m_index.snap(coordinate, QRouteIndexOffline::CarProfile, 100.0).isValid());
+        ++i;
+    }
+}
+
+void tst_RoutingOffline::hierarchyQuery()
+{
+    int i = 0;
+    QBENCHMARK {
+        const auto &query = m_queries.at(i % m_queries.size());
+        const QRouteIndexOffline::Path path =
+                m_index.route(query.first, query.second, QRouteIndexOffline::CarProfile);
+        QVERIFY(path.isValid());
+        ++i;
+    }
+}
+
+// the same queries avoiding motorways, which cannot use the hierarchy
+void tst_RoutingOffline::graphQuery()
+{
+    QRouteIndexOffline::Weighting weighting;
+    weighting.featureFactors[1] = 4.0;
+
+    int i = 0;
+    QBENCHMARK {
+        const auto &query = m_queries.at(i % m_queries.size());
+        const QRouteIndexOffline::Path path =
+                m_index.route(query.first, query.second, QRouteIndexOffline::CarProfile, weighting);
+        QVERIFY(path.isValid());
+        ++i;
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_RoutingOffline)
+
+#include "tst_routingoffline.moc"
@@ -0,0 +1,145 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+#include <QtTest/QtTest>
+
+#include <QtLocation/private/qgeofiletilecache_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+#include <cstdlib>
+
+QT_USE_NAMESPACE
+
+/*
+    Counts the heap allocations made, and the bytes allocated, while 64
+    downloaded tiles are added to the tile cache and then looked up, as the
+    map does when they arrive. The memory rows decode the tiles from the
+    memory cache, the disk rows read them from the disk cache first.
+
+    Allocations are counted by replacing malloc(), which is only done with
+    glibc.
+*/
+class tst_TileAllocations : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndGet_data();
+    void insertAndGet();
+};
+
+namespace
+{
+bool counting = false;
+qint64 allocations = 0;
+qint64 allocatedBytes = 0;
+
+void count(size_t size)
+{
+    if (counting) {
+        ++allocations;
+        allocatedBytes += qint64(size);
+    }
+}
+
+// Semi-transparent, so that it is decoded as ARGB32 and converted for the
+// textures, as the tiles of most servers are
+QByteArray tileImage()
+{
+    QImage image(256, 256, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qRgba(x, y, 128, 200));
+    }
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return bytes;
+}
+
+class TileCache : public QGeoFileTileCache
+{
+public:
+    using QGeoFileTileCache::QGeoFileTileCache;
+    using QGeoFileTileCache::init;
+};
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+
+void *malloc(size_t size)
+{
+    count(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+    count(n * size);
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    count(size);
+    return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+void tst_TileAllocations::insertAndGet_data()
+{
+    QTest::addColumn<bool>("memoryCache");
+    QTest::addColumn<bool>("countBytes");
+
+    QTest::newRow("memory, allocations") << true << false;
+    QTest::newRow("memory, bytes") << true << true;
+    QTest::newRow("disk, allocations") << false << false;
+    QTest::newRow("disk, bytes") << false << true;
+}
+
+void tst_TileAllocations::insertAndGet()
+{
+#if !defined(__GLIBC__)
+    QSKIP("Allocations are only counted with glibc");
+#endif
+    QFETCH(bool, memoryCache);
+    QFETCH(bool, countBytes);
+
+    QTemporaryDir cacheDirectory;
+    QVERIFY(cacheDirectory.isValid());
+    TileCache cache(cacheDirectory.path());
+    cache.init();
+    const QByteArray tile = tileImage();
+    const QAbstractGeoTileCache::CacheAreas areas = memoryCache
+            ? QAbstractGeoTileCache::AllCaches
+            : QAbstractGeoTileCache::DiskCache;
+
+    allocations = 0;
+    allocatedBytes = 0;
+    int textures = 0;
+    counting = true;
+    for (int i = 0; i < 64; ++i) {
+        const QGeoTileSpec spec(QStringLiteral("bench"), 1, 10, i % 8, i / 8);
+        cache.insert(spec, tile, QStringLiteral("png"), areas);
+        if (cache.get(spec))
+            ++textures;
+    }
+    counting = false;
+    QCOMPARE(textures, 64);
+
+    QTest::setBenchmarkResult(countBytes ? allocatedBytes : allocations,
+                              countBytes ? QTest::BytesAllocated : QTest::Events);
+}
+
+QTEST_MAIN(tst_TileAllocations)
+
+#include "tst_tileallocations.moc"
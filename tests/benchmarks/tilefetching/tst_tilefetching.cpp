@@ -0,0 +1,204 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtTest/QtTest>
+
+#include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeomappingmanagerengine_p.h>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+#include <QtLocation/private/qgeotilefetcher_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+#include <memory>
+
+QT_USE_NAMESPACE
+
+/*
+    Measures how long it takes to fetch the 256 tiles of a large viewport
+    from local tile servers, each listening on its own port like the a, b
+    and c subdomains of a tile provider. The servers answer after a delay,
+    as remote ones do, so that the number of requests in flight matters.
+    The busy rows have every tenth request refused with 503 Service
+    Unavailable, and show the cost of backing off.
+*/
+class tst_TileFetching : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fetch_data();
+    void fetch();
+};
+
+namespace
+{
+class TileServer : public QTcpServer
+{
+public:
+    TileServer(int latency, int busyEvery)
+        : m_latency(latency), m_busyEvery(busyEvery), m_tile(1024, 'x')
+    {
+        connect(this, &QTcpServer::newConnection, this, [this] {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [this, socket] { read(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+private:
+    void read(QTcpSocket *socket)
+    {
+        QByteArray &pending = m_pending[socket];
+        pending += socket->readAll();
+        qsizetype end;
+        while ((end = pending.indexOf("\r\n\r\n")) >= 0) {
+            pending.remove(0, end + 4);
+            const bool busy = m_busyEvery > 0 && ++m_requests % m_busyEvery == 0;
+            QTimer::singleShot(m_latency, socket, [this, socket, busy] {
+                if (busy) {
+                    socket->write("HTTP/1.1 503 Service Unavailable\r\n"
+                                  "Retry-After: 0\r\nContent-Length: 0\r\n\r\n");
+                } else {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Type: image/png\r\n"
+                                  "Content-Length: " + QByteArray::number(m_tile.size())
+                                  + "\r\n\r\n" + m_tile);
+                }
+            });
+        }
+    }
+
+    int m_latency;
+    int m_busyEvery;
+    int m_requests = 0;
+    QByteArray m_tile;
+    QHash<QTcpSocket *, QByteArray> m_pending;
+};
+
+class TileReply : public QGeoTiledMapReply
+{
+public:
+    TileReply(QNetworkReply *reply, const QGeoTileSpec &spec)
+        : QGeoTiledMapReply(spec)
+    {
+        connect(reply, &QNetworkReply::finished, this, [this, reply] {
+            reply->deleteLater();
+            if (reply->error() != QNetworkReply::NoError) {
+                const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+                if (status == 429 || status == 503)
+                    setRetryAfter(reply->rawHeader("Retry-After"));
+                setError(CommunicationError, reply->errorString());
+                return;
+            }
+            setMapImageData(reply->readAll());
+            setMapImageFormat(QStringLiteral("png"));
+            setFinished(true);
+        });
+    }
+};
+
+class TileFetcher : public QGeoTileFetcher
+{
+public:
+    TileFetcher(const QList<quint16> &ports, int maximumRequests, QGeoMappingManagerEngine *engine)
+        : QGeoTileFetcher(engine), m_ports(ports)
+    {
+        setMaximumConcurrentRequests(maximumRequests);
+    }
+
+private:
+    QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override
+    {
+        const quint16 port = m_ports.at((spec.x() + spec.y()) % m_ports.size());
+        QNetworkRequest request(QUrl(QStringLiteral("http://127.0.0.1:%1/%2/%3/%4.png")
+                                     .arg(port).arg(spec.zoom()).arg(spec.x()).arg(spec.y())));
+        request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+        return new TileReply(m_network.get(request), spec);
+    }
+
+    QList<quint16> m_ports;
+    QNetworkAccessManager m_network;
+};
+
+class MappingEngine : public QGeoMappingManagerEngine
+{
+public:
+    MappingEngine()
+    {
+        QGeoCameraCapabilities capabilities;
+        capabilities.setMinimumZoomLevel(0);
+        capabilities.setMaximumZoomLevel(20);
+        setCameraCapabilities(capabilities);
+    }
+
+    QGeoMap *createMap() override { return nullptr; }
+};
+}
+
+void tst_TileFetching::fetch_data()
+{
+    QTest::addColumn<int>("hosts");
+    QTest::addColumn<int>("maximumRequests");
+    QTest::addColumn<int>("busyEvery");
+
+    QTest::newRow("1 host, unlimited") << 1 << 0 << 0;
+    QTest::newRow("1 host, 8 in flight") << 1 << 8 << 0;
+    QTest::newRow("3 hosts, unlimited") << 3 << 0 << 0;
+    QTest::newRow("3 hosts, 24 in flight") << 3 << 24 << 0;
+    QTest::newRow("3 hosts, 24 in flight, busy") << 3 << 24 << 10;
+}
+
+void tst_TileFetching::fetch()
+{
+    QFETCH(int, hosts);
+    QFETCH(int, maximumRequests);
+    QFETCH(int, busyEvery);
+
+    std::vector<std::unique_ptr<TileServer>> servers;
+    QList<quint16> ports;
+    for (int i = 0; i < hosts; ++i) {
+        servers.push_back(std::make_unique<TileServer>(20, busyEvery));
+        QVERIFY(servers.back()->listen(QHostAddress::LocalHost));
+        ports.append(servers.back()->serverPort());
+    }
+
+    MappingEngine engine;
+    TileFetcher *fetcher = new TileFetcher(ports, maximumRequests, &engine);
+
+    QSet<QGeoTileSpec> tiles;
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            tiles.insert(QGeoTileSpec(QStringLiteral("bench"), 1, 8, x, y));
+
+    int fetched = 0;
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    connect(fetcher, &QGeoTileFetcher::tileFinished, &loop, [&] {
+        if (++fetched == tiles.size())
+            loop.quit();
+    });
+    // Retried right away, like QGeoTileRequestManager does after a while
+    connect(fetcher, &QGeoTileFetcher::tileError, &loop, [fetcher](const QGeoTileSpec &spec) {
+        fetcher->updateTileRequests(QSet<QGeoTileSpec>{ spec }, QSet<QGeoTileSpec>());
+    });
+
+    QBENCHMARK {
+        fetched = 0;
+        fetcher->updateTileRequests(tiles, QSet<QGeoTileSpec>());
+        timeout.start(60000);
+        loop.exec();
+        QCOMPARE(fetched, int(tiles.size()));
+    }
+}
+
+QTEST_MAIN(tst_TileFetching)
+
+#include "tst_tilefetching.moc"
@@ -0,0 +1,218 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+#include <QtTest/QtTest>
+
+#include <QtLocation/private/qgeocameracapabilities_p.h>
+#include <QtLocation/private/qgeocameradata_p.h>
+#include <QtLocation/private/qgeofiletilecache_p.h>
+#include <QtLocation/private/qgeomaptype_p.h>
+#include <QtLocation/private/qgeotiledmap_p.h>
+#include <QtLocation/private/qgeotiledmap_p_p.h>
+#include <QtLocation/private/qgeotiledmapscene_p.h>
+#include <QtLocation/private/qgeotiledmappingmanagerengine_p.h>
+#include <QtLocation/private/qgeotiledmapreply_p.h>
+#include <QtLocation/private/qgeotilefetcher_p.h>
+#include <QtLocation/private/qgeotilespec_p.h>
+
+#include <memory>
+
+QT_USE_NAMESPACE
+
+/*
+    Counts the tiles requested from the tile fetcher, and the tiles decoded
+    by the tile cache, while the map zooms in from level 3 to 17 or out from
+    level 17 to 3. An animation changes the zoom level every frame, while
+    steps change it once the tiles of the previous level have been fetched.
+    The visible tiles left without a texture are counted after every frame.
+*/
+class tst_ZoomTransition : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void zoom_data();
+    void zoom();
+};
+
+namespace
+{
+enum Measure { Requests, Decodes, Untextured };
+
+int requests = 0;
+int decodes = 0;
+
+QByteArray tileImage()
+{
+    QImage image(256, 256, QImage::Format_RGB32);
+    image.fill(Qt::gray);
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return bytes;
+}
+
+class TileReply : public QGeoTiledMapReply
+{
+public:
+    TileReply(const QGeoTileSpec &spec, const QByteArray &bytes)
+        : QGeoTiledMapReply(spec)
+    {
+        setMapImageData(bytes);
+        setMapImageFormat(QStringLiteral("png"));
+        setFinished(true);
+    }
+};
+
+class TileFetcher : public QGeoTileFetcher
+{
+public:
+    explicit TileFetcher(QGeoMappingManagerEngine *engine)
+        : QGeoTileFetcher(engine), m_tile(tileImage())
+    {
+    }
+
+private:
+    QGeoTiledMapReply *getTileImage(const QGeoTileSpec &spec) override
+    {
+        ++requests;
+        return new TileReply(spec, m_tile);
+    }
+
+    QByteArray m_tile;
+};
+
+class TileCache : public QGeoFileTileCache
+{
+public:
+    using QGeoFileTileCache::QGeoFileTileCache;
+
+protected:
+    QImage decodeTile(const QGeoTileSpec &spec, const QByteArray &bytes,
+                      const QString &format) const override
+    {
+        ++decodes;
+        return QGeoFileTileCache::decodeTile(spec, bytes, format);
+    }
+};
+
+class MappingEngine : public QGeoTiledMappingManagerEngine
+{
+public:
+    explicit MappingEngine(const QString &cacheDirectory)
+    {
+        QGeoCameraCapabilities capabilities;
+        capabilities.setMinimumZoomLevel(0);
+        capabilities.setMaximumZoomLevel(20);
+        capabilities.setTileSize(256);
+        setCameraCapabilities(capabilities);
+        setTileSize(QSize(256, 256));
+        setSupportedMapTypes({ QGeoMapType(QGeoMapType::StreetMap, QStringLiteral("Street"),
+                                           QStringLiteral("Street"), false, false, 1,
+                                           "bench", capabilities) });
+        setTileFetcher(new TileFetcher(this));
+        setTileCache(new TileCache(cacheDirectory));
+    }
+
+    QGeoMap *createMap() override;
+};
+
+class TiledMapPrivate : public QGeoTiledMapPrivate
+{
+public:
+    using QGeoTiledMapPrivate::QGeoTiledMapPrivate;
+
+    int untexturedTiles() const
+    {
+        return int((m_mapScene->visibleTiles() - m_mapScene->texturedTiles()).size());
+    }
+};
+
+class TiledMap : public QGeoTiledMap
+{
+public:
+    explicit TiledMap(QGeoTiledMappingManagerEngine *engine)
+        : QGeoTiledMap(*new TiledMapPrivate(engine), engine, nullptr)
+    {
+    }
+
+    int untexturedTiles() const
+    {
+        return static_cast<const TiledMapPrivate *>(d_ptr.data())->untexturedTiles();
+    }
+};
+
+QGeoMap *MappingEngine::createMap()
+{
+    return new TiledMap(this);
+}
+}
+
+void tst_ZoomTransition::zoom_data()
+{
+    QTest::addColumn<double>("fromZoomLevel");
+    QTest::addColumn<double>("toZoomLevel");
+    QTest::addColumn<int>("frameInterval");
+    QTest::addColumn<double>("zoomStep");
+    QTest::addColumn<int>("measure");
+
+    QTest::newRow("animation, requests") << 3.0 << 17.0 << 16 << 0.1 << int(Requests);
+    QTest::newRow("animation, decodes") << 3.0 << 17.0 << 16 << 0.1 << int(Decodes);
+    QTest::newRow("animation, untextured") << 3.0 << 17.0 << 16 << 0.1 << int(Untextured);
+    QTest::newRow("steps, requests") << 3.0 << 17.0 << 300 << 1.0 << int(Requests);
+    QTest::newRow("steps, decodes") << 3.0 << 17.0 << 300 << 1.0 << int(Decodes);
+    QTest::newRow("animation out, requests") << 17.0 << 3.0 << 16 << 0.1 << int(Requests);
+    QTest::newRow("animation out, decodes") << 17.0 << 3.0 << 16 << 0.1 << int(Decodes);
+    QTest::newRow("animation out, untextured") << 17.0 << 3.0 << 16 << 0.1 << int(Untextured);
+    QTest::newRow("steps out, requests") << 17.0 << 3.0 << 300 << 1.0 << int(Requests);
+    QTest::newRow("steps out, decodes") << 17.0 << 3.0 << 300 << 1.0 << int(Decodes);
+}
+
+void tst_ZoomTransition::zoom()
+{
+    QFETCH(double, fromZoomLevel);
+    QFETCH(double, toZoomLevel);
+    QFETCH(int, frameInterval);
+    QFETCH(double, zoomStep);
+    QFETCH(int, measure);
+
+    QTemporaryDir cacheDirectory;
+    QVERIFY(cacheDirectory.isValid());
+    MappingEngine engine(cacheDirectory.path());
+    std::unique_ptr<QGeoMap> map(engine.createMap());
+    TiledMap *tiledMap = static_cast<TiledMap *>(map.get());
+    map->setViewportSize(QSize(1024, 768));
+    map->setActiveMapType(engine.supportedMapTypes().first());
+
+    QGeoCameraData camera;
+    camera.setCenter(QGeoCoordinate(60.17, 24.94));
+    camera.setZoomLevel(fromZoomLevel);
+    map->setCameraData(camera);
+    QTRY_COMPARE(tiledMap->untexturedTiles(), 0);
+
+    requests = 0;
+    decodes = 0;
+    int untextured = 0;
+    const int frames = qRound(qAbs(toZoomLevel - fromZoomLevel) / zoomStep);
+    const double direction = toZoomLevel > fromZoomLevel ? 1.0 : -1.0;
+    for (int frame = 1; frame <= frames; ++frame) {
+        camera.setZoomLevel(frame == frames ? toZoomLevel
+                                            : fromZoomLevel + direction * frame * zoomStep);
+        map->setCameraData(camera);
+        QTest::qWait(frameInterval);
+        untextured += tiledMap->untexturedTiles();
+    }
+    // Whichever way the zoom went, the map is not left blank
+    QTRY_COMPARE(tiledMap->untexturedTiles(), 0);
+
+    const int result = measure == Requests ? requests : measure == Decodes ? decodes : untextured;
+    QTest::setBenchmarkResult(result, QTest::Events);
+}
+
+QTEST_MAIN(tst_ZoomTransition)
+
+#include "tst_zoomtransition.moc"
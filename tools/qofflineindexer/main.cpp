@@ -0,0 +1,193 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+
+#include <QtLocation/private/qgeojson_p.h>
+
+#include "qgeocodeindexoffline.h"
+#include "qplaceindexoffline.h"
+#include "qrouteindexoffline.h"
+
+#include <cstdio>
+
+QT_USE_NAMESPACE
+
+/*
+    Builds the index files read by the offline geoservices plugin from GeoJSON and, for
+    addresses, CSV extracts.
+*/
+
+static void printError(const QString &message)
+{
+    fprintf(stderr, "qofflineindexer: %s\n", qPrintable(message));
+}
+
+static bool readGeoJson(const QString &fileName, QVariantList *features)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        printError(QStringLiteral("%1: %2").arg(fileName, file.errorString()));
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (document.isNull()) {
+        printError(QStringLiteral("%1: %2").arg(fileName, parseError.errorString()));
+        return false;
+    }
+
+    *features = QGeoJson::importGeoJson(document);
+    return true;
+}
+
+static bool isCsv(const QString &fileName)
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    return suffix == QLatin1String("csv") || suffix == QLatin1String("txt");
+}
+
+static int buildPlaces(const QStringList &inputs, const QString &output)
+{
+    QPlaceIndexOfflineBuilder builder;
+    for (const QString &input : inputs) {
+        if (isCsv(input)) {
+            printError(QStringLiteral("%1: places are only imported from GeoJSON").arg(input));
+            return 1;
+        }
+        QVariantList features;
+        if (!readGeoJson(input, &features))
+            return 1;
+        const int count = builder.addGeoJson(features);
+        printf("%s: %d places\n", qPrintable(input), count);
+    }
+
+    QString errorString;
+    if (!builder.write(output, &errorString)) {
+        printError(QStringLiteral("%1: %2").arg(output, errorString));
+        return 1;
+    }
+    return 0;
+}
+
+static int buildAddresses(const QStringList &inputs, const QString &output)
+{
+    QGeoCodeIndexOfflineBuilder builder;
+    for (const QString &input : inputs) {
+        int count;
+        if (isCsv(input)) {
+            QFile file(input);
+            if (!file.open(QIODevice::ReadOnly)) {
+                printError(QStringLiteral("%1: %2").arg(input, file.errorString()));
+                return 1;
+            }
+            QString errorString;
+            count = builder.addCsv(&file, &errorString);
+            if (count < 0) {
+                printError(QStringLiteral("%1: %2").arg(input, errorString));
+                return 1;
+            }
+        } else {
+            QVariantList features;
+            if (!readGeoJson(input, &features))
+                return 1;
+            count = builder.addGeoJson(features);
+        }
+        printf("%s: %d addresses\n", qPrintable(input), count);
+    }
+
+    QString errorString;
+    if (!builder.write(output, &errorString)) {
+        printError(QStringLiteral("%1: %2").arg(output, errorString));
+        return 1;
+    }
+    return 0;
+}
+
+static int buildRouting(const QStringList &inputs, const QString &output)
+{
+    QRouteIndexOfflineBuilder builder;
+    for (const QString &input : inputs) {
+        if (isCsv(input)) {
+            printError(QStringLiteral("%1: roads are only imported from GeoJSON").arg(input));
+            return 1;
+        }
+        QVariantList features;
+        if (!readGeoJson(input, &features))
+            return 1;
+        const int count = builder.addGeoJson(features);
+        printf("%s: %d ways\n", qPrintable(input), count);
+    }
+
+    QString errorString;
+    if (!builder.write(output, &errorString)) {
+        printError(QStringLiteral("%1: %2").arg(output, errorString));
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qofflineindexer"));
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Builds index files for the offline geoservices plugin.\n\n"
+            "Types:\n"
+            "  places     points of interest from GeoJSON, for offline.places.index\n"
+            "  addresses  address points and streets from GeoJSON or CSV,\n"
+            "             for offline.geocoding.index\n"
+            "  routing    roads from GeoJSON line strings with OpenStreetMap tags,\n"
+            "             for offline.routing.index"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption typeOption({ QStringLiteral("t"), QStringLiteral("type") },
+                                        QStringLiteral("The index <type> to build."),
+                                        QStringLiteral("type"));
+    const QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output") },
+                                          QStringLiteral("Write the index to <file>."),
+                                          QStringLiteral("file"));
+    parser.addOption(typeOption);
+    parser.addOption(outputOption);
+    parser.addPositionalArgument(QStringLiteral("inputs"),
+                                 QStringLiteral("GeoJSON or CSV files to import."),
+                                 QStringLiteral("inputs..."));
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    const QString output = parser.value(outputOption);
+    if (inputs.isEmpty() || output.isEmpty()) {
+        printError(QStringLiteral("an output file and at least one input file are required"));
+        parser.showHelp(1);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString type = parser.value(typeOption);
+    int result;
+    if (type == QLatin1String("places")) {
+        result = buildPlaces(inputs, output);
+    } else if (type == QLatin1String("addresses")) {
+        result = buildAddresses(inputs, output);
+    } else if (type == QLatin1String("routing")) {
+        result = buildRouting(inputs, output);
+    } else {
+        printError(QStringLiteral("unknown index type \"%1\"").arg(type));
+        return 1;
+    }
+
+    if (result == 0)
+        printf("wrote %s in %lld ms\n", qPrintable(output), timer.elapsed());
+    return result;
+}